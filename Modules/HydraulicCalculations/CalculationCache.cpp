@@ -0,0 +1,647 @@
+#include "CalculationCache.h"
+#include "PipeCatalogue.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace HydraulicCalc {
+
+namespace {
+
+// Fichier d'une entrée : "TCHC", version (u16), réservé (u16), clé (u64 + octets),
+// longueur de boucle (f64), nombre de tronçons (u32), résultats des tronçons
+constexpr char FileMagic[4] = {'T', 'C', 'H', 'C'};
+constexpr std::uint16_t FileVersion = 1;
+
+template <class T>
+void put(std::string& buffer, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    buffer.append(bytes, sizeof(T));
+}
+
+void putString(std::string& buffer, const std::string& text) {
+    put<std::uint32_t>(buffer, static_cast<std::uint32_t>(text.size()));
+    buffer.append(text);
+}
+
+// Lecture bornée : toute lecture hors limites rend l'entrée invalide
+class Cursor {
+public:
+    Cursor(const char* data, std::size_t size) : data(data), size(size), position(0) {}
+
+    template <class T>
+    T get() {
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, data + position, sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+
+    const char* take(std::size_t bytes) {
+        require(bytes);
+        const char* start = data + position;
+        position += bytes;
+        return start;
+    }
+
+    void require(std::size_t bytes) const {
+        if (size - position < bytes) {
+            throw std::runtime_error("Entrée du cache de calcul tronquée");
+        }
+    }
+
+private:
+    const char* data;
+    std::size_t size;
+    std::size_t position;
+};
+
+void encodeDetails(std::string& buffer, const CalculationDetails& details) {
+    put<double>(buffer, details.totalFixtureFlowRate);
+    put<std::int32_t>(buffer, details.totalFixtures);
+    put<double>(buffer, details.simultaneityCoeff);
+    put<double>(buffer, details.crossSection);
+    put<double>(buffer, details.reynolds);
+    put<std::uint8_t>(buffer, details.isLaminar ? 1 : 0);
+    put<double>(buffer, details.lambda);
+    put<std::uint8_t>(buffer, static_cast<std::uint8_t>(details.frictionModel));
+    put<double>(buffer, details.roughness);
+    put<double>(buffer, details.relativeRoughness);
+    put<double>(buffer, details.linearPressureDrop);
+    put<double>(buffer, details.singularPressureDrop);
+    put<double>(buffer, details.heightPressureDrop);
+    put<double>(buffer, details.r1);
+    put<double>(buffer, details.r2);
+    put<double>(buffer, details.thermalResistanceInsul);
+    put<double>(buffer, details.thermalResistanceExt);
+    put<double>(buffer, details.heatLossPerMeter);
+    put<double>(buffer, details.temperatureDrop);
+}
+
+void decodeDetails(Cursor& cursor, CalculationDetails& details) {
+    details.totalFixtureFlowRate = cursor.get<double>();
+    details.totalFixtures = cursor.get<std::int32_t>();
+    details.simultaneityCoeff = cursor.get<double>();
+    details.crossSection = cursor.get<double>();
+    details.reynolds = cursor.get<double>();
+    details.isLaminar = cursor.get<std::uint8_t>() != 0;
+    details.lambda = cursor.get<double>();
+    details.frictionModel = static_cast<FrictionModel>(cursor.get<std::uint8_t>());
+    details.roughness = cursor.get<double>();
+    details.relativeRoughness = cursor.get<double>();
+    details.linearPressureDrop = cursor.get<double>();
+    details.singularPressureDrop = cursor.get<double>();
+    details.heightPressureDrop = cursor.get<double>();
+    details.r1 = cursor.get<double>();
+    details.r2 = cursor.get<double>();
+    details.thermalResistanceInsul = cursor.get<double>();
+    details.thermalResistanceExt = cursor.get<double>();
+    details.heatLossPerMeter = cursor.get<double>();
+    details.temperatureDrop = cursor.get<double>();
+}
+
+std::string versionDirectoryName() {
+    return "v" + std::to_string(PipeCalculator::Version);
+}
+
+} // namespace
+
+CalculationCache::CalculationCache()
+    : memoryLimit(DefaultMemoryLimit)
+    , memoryBytes(0)
+    , diskLimit(DefaultDiskLimit)
+    , diskBytes(0)
+{
+}
+
+CalculationCache& CalculationCache::instance()
+{
+    static CalculationCache cache;
+    return cache;
+}
+
+void CalculationCache::setMemoryLimit(std::size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    memoryLimit = bytes;
+    evict();
+}
+
+void CalculationCache::setDiskLimit(std::uintmax_t bytes)
+{
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        diskLimit = bytes;
+        directory = diskDirectory;
+    }
+    if (!directory.empty()) {
+        trimDisk(directory);
+    }
+}
+
+void CalculationCache::setDiskDirectory(const std::string& directory)
+{
+    if (directory.empty()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        diskDirectory.clear();
+        diskBytes = 0;
+        return;
+    }
+
+    // ÉTAPE 1: Sous-dossier de la version courante, ceux des autres versions sont périmés
+    const std::filesystem::path root = std::filesystem::u8path(directory);
+    const std::filesystem::path current = root / versionDirectoryName();
+    std::error_code error;
+    std::filesystem::create_directories(current, error);
+    if (error) {
+        throw std::runtime_error("Impossible de créer le dossier du cache de calcul : " + directory);
+    }
+    for (const auto& item : std::filesystem::directory_iterator(root, error)) {
+        const std::string name = item.path().filename().u8string();
+        if (item.is_directory(error) && name.size() > 1 && name[0] == 'v' && name != versionDirectoryName()) {
+            std::error_code ignored;
+            std::filesystem::remove_all(item.path(), ignored);
+        }
+    }
+
+    // ÉTAPE 2: Taille actuelle du dossier
+    std::uintmax_t total = 0;
+    for (const auto& item : std::filesystem::directory_iterator(current, error)) {
+        std::error_code sizeError;
+        const std::uintmax_t size = item.file_size(sizeError);
+        if (!sizeError) {
+            total += size;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        diskDirectory = current.u8string();
+        diskBytes = total;
+    }
+    trimDisk(current.u8string());
+}
+
+bool CalculationCache::lookup(NetworkCalculationParameters& networkParams)
+{
+    std::vector<std::size_t> order;
+    const std::string key = canonicalKey(networkParams, order);
+    const std::uint64_t hash = fingerprint(key);
+
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (EntryPtr entry = findInMemory(hash, key)) {
+            ++counters.memoryHits;
+            apply(*entry, order, networkParams);
+            return true;
+        }
+        directory = diskDirectory;
+    }
+
+    if (!directory.empty()) {
+        if (EntryPtr entry = readFromDisk(directory, hash, key)) {
+            apply(*entry, order, networkParams);
+            std::lock_guard<std::mutex> lock(mutex);
+            ++counters.diskHits;
+            insertInMemory(hash, std::move(entry));
+            return true;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ++counters.misses;
+    return false;
+}
+
+void CalculationCache::store(const NetworkCalculationParameters& networkParams)
+{
+    auto entry = std::make_shared<Entry>();
+    std::vector<std::size_t> order;
+    entry->key = canonicalKey(networkParams, order);
+    entry->loopLength = networkParams.loopLength;
+    entry->segments.reserve(order.size());
+    for (std::size_t index : order) {
+        const NetworkSegment& segment = networkParams.segments[index];
+        entry->segments.push_back(SegmentEntry{segment.result, segment.inletPressure, segment.outletPressure});
+    }
+    const std::uint64_t hash = fingerprint(entry->key);
+
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        insertInMemory(hash, entry);
+        directory = diskDirectory;
+    }
+
+    if (!directory.empty()) {
+        const std::uintmax_t written = writeToDisk(directory, hash, *entry);
+        bool overLimit = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (directory == diskDirectory) {
+                diskBytes += written;
+                overLimit = diskBytes > diskLimit;
+            }
+        }
+        if (overLimit) {
+            trimDisk(directory);
+        }
+    }
+}
+
+void CalculationCache::clear()
+{
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        recent.clear();
+        entries.clear();
+        memoryBytes = 0;
+        counters = CacheStatistics();
+        directory = diskDirectory;
+        diskBytes = 0;
+    }
+
+    if (!directory.empty()) {
+        std::error_code error;
+        for (const auto& item : std::filesystem::directory_iterator(std::filesystem::u8path(directory), error)) {
+            std::error_code ignored;
+            std::filesystem::remove(item.path(), ignored);
+        }
+    }
+}
+
+CacheStatistics CalculationCache::statistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    CacheStatistics result = counters;
+    result.entries = entries.size();
+    result.bytes = memoryBytes;
+    return result;
+}
+
+// ===== CLÉ CANONIQUE =====
+
+std::string CalculationCache::canonicalKey(const NetworkCalculationParameters& networkParams,
+                                           std::vector<std::size_t>& order)
+{
+    const auto& segments = networkParams.segments;
+    std::string key;
+    key.reserve(96 + segments.size() * 64);
+
+    // ÉTAPE 1: Version et paramètres généraux (loopLength exclue : résultat du calcul)
+    put<std::uint32_t>(key, PipeCalculator::Version);
+    put<std::uint8_t>(key, static_cast<std::uint8_t>(networkParams.networkType));
+    put<std::uint8_t>(key, static_cast<std::uint8_t>(networkParams.material));
+    put<std::uint8_t>(key, static_cast<std::uint8_t>(networkParams.frictionModel));
+    put<std::uint8_t>(key, networkParams.temperatureDependentProperties ? 1 : 0);
+    put<double>(key, networkParams.supplyPressure);
+    put<double>(key, networkParams.requiredPressure);
+    put<double>(key, networkParams.ambientTemperature);
+    put<double>(key, networkParams.waterTemperature);
+    put<double>(key, networkParams.insulationThickness);
+
+    // ÉTAPE 2: Catalogues lus par le calcul (série active du matériau, débits unitaires)
+    const PipeSeries& series = PipeCatalogue::instance().getSeries(networkParams.material);
+    put<double>(key, series.roughness);
+    put<std::uint32_t>(key, static_cast<std::uint32_t>(series.sizes.size()));
+    for (const auto& size : series.sizes) {
+        put<std::int32_t>(key, size.nominalDiameter);
+        put<double>(key, size.internalDiameter);
+    }
+    for (double flowRate : FixtureCatalogue::instance().getFlowRates()) {
+        put<double>(key, flowRate);
+    }
+
+    // ÉTAPE 3: Tronçons dans l'ordre des identifiants (indépendant de l'ordre de saisie)
+    order.resize(segments.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&segments](std::size_t a, std::size_t b) {
+        return segments[a].id < segments[b].id;
+    });
+
+    put<std::uint32_t>(key, static_cast<std::uint32_t>(segments.size()));
+    std::vector<Fixture> fixtures;
+    for (std::size_t index : order) {
+        const NetworkSegment& segment = segments[index];
+        putString(key, segment.id);
+        putString(key, segment.parentId);
+        put<double>(key, segment.length);
+        put<double>(key, segment.heightDifference);
+        put<std::uint8_t>(key, segment.hasReturnLine ? 1 : 0);
+
+        fixtures = segment.fixtures;
+        std::sort(fixtures.begin(), fixtures.end(), [](const Fixture& a, const Fixture& b) {
+            return a.type != b.type ? a.type < b.type : a.quantity < b.quantity;
+        });
+        put<std::uint32_t>(key, static_cast<std::uint32_t>(fixtures.size()));
+        for (const auto& fixture : fixtures) {
+            put<std::uint8_t>(key, static_cast<std::uint8_t>(fixture.type));
+            put<std::int32_t>(key, fixture.quantity);
+        }
+    }
+    return key;
+}
+
+std::uint64_t CalculationCache::fingerprint(const std::string& key)
+{
+    // FNV-1a 64 bits
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::size_t CalculationCache::entrySize(const Entry& entry)
+{
+    return sizeof(Entry) + entry.key.capacity() + entry.segments.capacity() * sizeof(SegmentEntry);
+}
+
+// ===== NIVEAU MÉMOIRE =====
+
+CalculationCache::EntryPtr CalculationCache::findInMemory(std::uint64_t hash, const std::string& key)
+{
+    auto it = entries.find(hash);
+    if (it == entries.end() || it->second->second->key != key) {
+        return nullptr;
+    }
+    recent.splice(recent.begin(), recent, it->second);
+    return it->second->second;
+}
+
+void CalculationCache::insertInMemory(std::uint64_t hash, EntryPtr entry)
+{
+    auto it = entries.find(hash);
+    if (it != entries.end()) {
+        memoryBytes -= entrySize(*it->second->second);
+        recent.erase(it->second);
+        entries.erase(it);
+    }
+    const std::size_t size = entrySize(*entry);
+    if (size > memoryLimit) {
+        return;  // Plus grande que la mémoire allouée : niveau disque seulement
+    }
+    recent.emplace_front(hash, std::move(entry));
+    entries[hash] = recent.begin();
+    memoryBytes += size;
+    evict();
+}
+
+void CalculationCache::evict()
+{
+    // Retrait des entrées les moins récemment utilisées
+    while (memoryBytes > memoryLimit && !recent.empty()) {
+        memoryBytes -= entrySize(*recent.back().second);
+        entries.erase(recent.back().first);
+        recent.pop_back();
+        ++counters.evictions;
+    }
+}
+
+// ===== NIVEAU DISQUE =====
+
+std::string CalculationCache::encodeEntry(const Entry& entry)
+{
+    std::string buffer(FileMagic, sizeof(FileMagic));
+    put<std::uint16_t>(buffer, FileVersion);
+    put<std::uint16_t>(buffer, 0);
+    put<std::uint64_t>(buffer, entry.key.size());
+    buffer.append(entry.key);
+    put<double>(buffer, entry.loopLength);
+    put<std::uint32_t>(buffer, static_cast<std::uint32_t>(entry.segments.size()));
+
+    for (const auto& segment : entry.segments) {
+        const PipeSegmentResult& result = segment.result;
+        put<double>(buffer, result.flowRate);
+        put<double>(buffer, result.velocity);
+        put<double>(buffer, result.pressureDrop);
+        put<std::int32_t>(buffer, result.nominalDiameter);
+        put<double>(buffer, result.actualDiameter);
+        put<std::uint8_t>(buffer, result.hasReturn ? 1 : 0);
+        put<double>(buffer, result.returnFlowRate);
+        put<double>(buffer, result.returnVelocity);
+        put<std::int32_t>(buffer, result.returnNominalDiameter);
+        put<double>(buffer, result.returnActualDiameter);
+        put<double>(buffer, result.heatLoss);
+        put<double>(buffer, result.returnTemperature);
+        put<double>(buffer, result.inletTemperature);
+        put<double>(buffer, result.outletTemperature);
+        put<double>(buffer, result.returnInletTemperature);
+        put<double>(buffer, result.returnOutletTemperature);
+        put<double>(buffer, segment.inletPressure);
+        put<double>(buffer, segment.outletPressure);
+
+        put<double>(buffer, result.diagnostics.getAvailablePressure());
+        put<std::uint8_t>(buffer, static_cast<std::uint8_t>(result.diagnostics.end() - result.diagnostics.begin()));
+        for (const auto& diagnostic : result.diagnostics) {
+            put<std::uint8_t>(buffer, static_cast<std::uint8_t>(diagnostic.code));
+            put<double>(buffer, diagnostic.value);
+            put<double>(buffer, diagnostic.limit);
+        }
+
+        encodeDetails(buffer, result.details);
+    }
+    return buffer;
+}
+
+CalculationCache::EntryPtr CalculationCache::decodeEntry(const std::string& data, const std::string& key)
+{
+    Cursor cursor(data.data(), data.size());
+    if (std::memcmp(cursor.take(sizeof(FileMagic)), FileMagic, sizeof(FileMagic)) != 0
+        || cursor.get<std::uint16_t>() != FileVersion) {
+        return nullptr;
+    }
+    cursor.get<std::uint16_t>();
+
+    // Clé comparée avant tout décodage : une autre entrée de même empreinte n'est pas lue
+    const std::uint64_t keySize = cursor.get<std::uint64_t>();
+    if (keySize != key.size() || std::memcmp(cursor.take(key.size()), key.data(), key.size()) != 0) {
+        return nullptr;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->key = key;
+    entry->loopLength = cursor.get<double>();
+
+    const std::uint32_t segmentCount = cursor.get<std::uint32_t>();
+    cursor.require(segmentCount);  // Au moins un octet par tronçon : borne l'allocation
+    entry->segments.resize(segmentCount);
+    for (auto& segment : entry->segments) {
+        PipeSegmentResult& result = segment.result;
+        result.flowRate = cursor.get<double>();
+        result.velocity = cursor.get<double>();
+        result.pressureDrop = cursor.get<double>();
+        result.nominalDiameter = cursor.get<std::int32_t>();
+        result.actualDiameter = cursor.get<double>();
+        result.hasReturn = cursor.get<std::uint8_t>() != 0;
+        result.returnFlowRate = cursor.get<double>();
+        result.returnVelocity = cursor.get<double>();
+        result.returnNominalDiameter = cursor.get<std::int32_t>();
+        result.returnActualDiameter = cursor.get<double>();
+        result.heatLoss = cursor.get<double>();
+        result.returnTemperature = cursor.get<double>();
+        result.inletTemperature = cursor.get<double>();
+        result.outletTemperature = cursor.get<double>();
+        result.returnInletTemperature = cursor.get<double>();
+        result.returnOutletTemperature = cursor.get<double>();
+        segment.inletPressure = cursor.get<double>();
+        segment.outletPressure = cursor.get<double>();
+
+        result.diagnostics.setAvailablePressure(cursor.get<double>());
+        const std::uint8_t diagnosticCount = cursor.get<std::uint8_t>();
+        for (std::uint8_t i = 0; i < diagnosticCount; ++i) {
+            const std::uint8_t code = cursor.get<std::uint8_t>();
+            const double value = cursor.get<double>();
+            const double limit = cursor.get<double>();
+            if (code >= DiagnosticCodeCount) {
+                return nullptr;
+            }
+            result.diagnostics.set(static_cast<DiagnosticCode>(code), value, limit);
+        }
+
+        decodeDetails(cursor, result.details);
+    }
+    return entry;
+}
+
+std::string CalculationCache::filePath(const std::string& directory, std::uint64_t hash)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string name(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        name[static_cast<std::size_t>(i)] = digits[hash & 0xF];
+        hash >>= 4;
+    }
+    return (std::filesystem::u8path(directory) / (name + ".tchc")).u8string();
+}
+
+CalculationCache::EntryPtr CalculationCache::readFromDisk(const std::string& directory, std::uint64_t hash,
+                                                          const std::string& key)
+{
+    const std::filesystem::path path = std::filesystem::u8path(filePath(directory, hash));
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return nullptr;
+    }
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    EntryPtr entry;
+    try {
+        entry = decodeEntry(data, key);
+    } catch (const std::exception&) {
+        entry = nullptr;  // Fichier tronqué : traité comme absent
+    }
+    if (!entry) {
+        return nullptr;
+    }
+
+    // Date de dernière utilisation pour le nettoyage (trimDisk)
+    std::error_code ignored;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ignored);
+    return entry;
+}
+
+std::uintmax_t CalculationCache::writeToDisk(const std::string& directory, std::uint64_t hash, const Entry& entry)
+{
+    static std::atomic<unsigned> writeCounter(0);
+
+    // Fichier temporaire propre à l'écriture puis remplacement : jamais d'entrée à moitié écrite
+    const std::string buffer = encodeEntry(entry);
+    const std::filesystem::path target = std::filesystem::u8path(filePath(directory, hash));
+    std::filesystem::path temporary = target;
+    temporary += "." + std::to_string(writeCounter++) + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return 0;
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.flush();
+        if (!out) {
+            out.close();
+            std::error_code ignored;
+            std::filesystem::remove(temporary, ignored);
+            return 0;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, target, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        return 0;
+    }
+    return buffer.size();
+}
+
+void CalculationCache::trimDisk(const std::string& directory)
+{
+    std::uintmax_t limit;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        limit = diskLimit;
+    }
+
+    // Fichiers du dossier, les moins récemment utilisés en premier
+    struct CacheFile {
+        std::filesystem::path path;
+        std::filesystem::file_time_type used;
+        std::uintmax_t size;
+    };
+    std::vector<CacheFile> files;
+    std::uintmax_t total = 0;
+    std::error_code error;
+    for (const auto& item : std::filesystem::directory_iterator(std::filesystem::u8path(directory), error)) {
+        std::error_code itemError;
+        CacheFile file{item.path(), item.last_write_time(itemError), item.file_size(itemError)};
+        if (!itemError) {
+            total += file.size;
+            files.push_back(std::move(file));
+        }
+    }
+    std::sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b) {
+        return a.used < b.used;
+    });
+
+    for (const auto& file : files) {
+        if (total <= limit) {
+            break;
+        }
+        std::error_code ignored;
+        if (std::filesystem::remove(file.path, ignored)) {
+            total -= file.size;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (directory == diskDirectory) {
+        diskBytes = total;
+    }
+}
+
+void CalculationCache::apply(const Entry& entry, const std::vector<std::size_t>& order,
+                             NetworkCalculationParameters& networkParams)
+{
+    networkParams.loopLength = entry.loopLength;
+    for (std::size_t k = 0; k < order.size(); ++k) {
+        NetworkSegment& segment = networkParams.segments[order[k]];
+        segment.result = entry.segments[k].result;
+        segment.inletPressure = entry.segments[k].inletPressure;
+        segment.outletPressure = entry.segments[k].outletPressure;
+    }
+}
+
+} // namespace HydraulicCalc
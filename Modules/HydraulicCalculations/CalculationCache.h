@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "PipeCalculator.h"
+
+namespace HydraulicCalc {
+
+// Compteurs du cache de résultats
+struct CacheStatistics {
+    std::uint64_t memoryHits;    // Résultats trouvés en mémoire
+    std::uint64_t diskHits;      // Résultats relus depuis le disque
+    std::uint64_t misses;        // Calculs effectués
+    std::uint64_t evictions;     // Entrées retirées de la mémoire (plus anciennes en premier)
+    std::size_t entries;         // Entrées en mémoire
+    std::size_t bytes;           // Taille estimée des entrées en mémoire
+
+    CacheStatistics()
+        : memoryHits(0), diskHits(0), misses(0), evictions(0), entries(0), bytes(0) {}
+};
+
+// Cache des résultats de calcul, adressé par le contenu des données d'entrée
+//
+// La clé est la forme canonique des données qui déterminent le calcul : version du
+// calculateur, paramètres généraux, séries de tubes actives et débits unitaires du catalogue,
+// tronçons triés par identifiant (parent, longueur, dénivelé, retour, appareils triés).
+// Les noms et les résultats déjà présents n'en font pas partie, ni loopLength (calculée).
+// Une empreinte 64 bits de la clé adresse l'entrée ; la clé complète est conservée et
+// comparée, une collision d'empreinte ne renvoie donc jamais le résultat d'un autre réseau.
+//
+// Deux niveaux :
+//   - mémoire : LRU bornée en octets (setMemoryLimit) ;
+//   - disque (optionnel, setDiskDirectory) : un fichier par empreinte dans un sous-dossier
+//     propre à la version du calculateur, les dossiers des autres versions sont supprimés.
+//     Taille bornée (setDiskLimit), les fichiers les moins récemment utilisés partent d'abord.
+//
+// Le cache est partagé entre threads (mutex) ; les lectures et écritures disque ont lieu
+// hors verrou.
+class CalculationCache {
+public:
+    static constexpr std::size_t DefaultMemoryLimit = 64 * 1024 * 1024;       // Octets
+    static constexpr std::uintmax_t DefaultDiskLimit = 256 * 1024 * 1024;     // Octets
+
+    CalculationCache();
+
+    CalculationCache(const CalculationCache&) = delete;
+    CalculationCache& operator=(const CalculationCache&) = delete;
+
+    // Cache partagé de l'application
+    static CalculationCache& instance();
+
+    void setMemoryLimit(std::size_t bytes);
+    void setDiskLimit(std::uintmax_t bytes);
+
+    // Dossier du niveau disque (vide = désactivé) ; lève std::runtime_error s'il ne peut être créé
+    void setDiskDirectory(const std::string& directory);
+
+    // Résultats d'un calcul déjà effectué sur les mêmes données : copiés dans les tronçons
+    // (result, pressions) et dans loopLength, puis true ; false sinon (rien n'est modifié)
+    bool lookup(NetworkCalculationParameters& networkParams);
+
+    // Enregistre les résultats d'un réseau que l'on vient de calculer
+    void store(const NetworkCalculationParameters& networkParams);
+
+    // Vide la mémoire et le dossier de la version courante, remet les compteurs à zéro
+    void clear();
+
+    CacheStatistics statistics() const;
+
+private:
+    // Résultats d'un tronçon (dans l'ordre canonique des tronçons)
+    struct SegmentEntry {
+        PipeSegmentResult result;
+        double inletPressure;
+        double outletPressure;
+    };
+
+    struct Entry {
+        std::string key;                      // Forme canonique complète
+        double loopLength;
+        std::vector<SegmentEntry> segments;
+    };
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+    // Forme canonique et ordre canonique des tronçons (indices dans networkParams.segments)
+    static std::string canonicalKey(const NetworkCalculationParameters& networkParams,
+                                    std::vector<std::size_t>& order);
+    static std::uint64_t fingerprint(const std::string& key);
+    static std::size_t entrySize(const Entry& entry);
+
+    static std::string encodeEntry(const Entry& entry);
+    static EntryPtr decodeEntry(const std::string& data, const std::string& key);  // nul si autre clé
+
+    // Niveau mémoire (verrou tenu)
+    EntryPtr findInMemory(std::uint64_t hash, const std::string& key);
+    void insertInMemory(std::uint64_t hash, EntryPtr entry);
+    void evict();
+
+    // Niveau disque (hors verrou) : writeToDisk renvoie la taille du fichier écrit (0 si échec)
+    static std::string filePath(const std::string& directory, std::uint64_t hash);
+    static EntryPtr readFromDisk(const std::string& directory, std::uint64_t hash, const std::string& key);
+    static std::uintmax_t writeToDisk(const std::string& directory, std::uint64_t hash, const Entry& entry);
+    void trimDisk(const std::string& directory);
+
+    static void apply(const Entry& entry, const std::vector<std::size_t>& order,
+                      NetworkCalculationParameters& networkParams);
+
+    mutable std::mutex mutex;
+    std::list<std::pair<std::uint64_t, EntryPtr>> recent;   // Plus récemment utilisée en tête
+    std::unordered_map<std::uint64_t, std::list<std::pair<std::uint64_t, EntryPtr>>::iterator> entries;
+    std::size_t memoryLimit;
+    std::size_t memoryBytes;
+    std::uintmax_t diskLimit;
+    std::uintmax_t diskBytes;                 // Taille des fichiers du dossier (estimée depuis l'ouverture)
+    std::string diskDirectory;                // Sous-dossier de la version courante
+    CacheStatistics counters;
+};
+
+} // namespace HydraulicCalc
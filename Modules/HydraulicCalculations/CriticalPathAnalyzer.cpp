@@ -0,0 +1,98 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include "CriticalPathAnalyzer.h"
+#include "NetworkTree.h"
+#include <algorithm>
+
+namespace HydraulicCalc {
+
+CriticalPathResult CriticalPathAnalyzer::analyze(const NetworkCalculationParameters& networkParams,
+                                                 size_t worstCount) const {
+    CriticalPathResult result;
+    const auto& segments = networkParams.segments;
+    const size_t count = segments.size();
+    if (count == 0) {
+        return result;
+    }
+
+    // ÉTAPE 1: Arbre (parents, enfants, ordre préfixe)
+    const NetworkTree tree(segments);
+    const size_t noParent = NetworkTree::None;
+
+    // ÉTAPE 2: Parcours préfixe, cumuls de la source jusqu'à la sortie de chaque segment
+    const bool hotWater = (networkParams.networkType == NetworkType::HotWater ||
+                           networkParams.networkType == NetworkType::HotWaterWithLoop);
+    const bool looped = (networkParams.networkType == NetworkType::HotWaterWithLoop);
+
+    std::vector<double> pathLength(count, 0.0);
+    std::vector<double> pathDrop(count, 0.0);
+    std::vector<double> elevation(count, 0.0);
+    std::vector<double> volume(count, 0.0);
+
+    for (size_t i : tree.preOrder()) {
+        const NetworkSegment& segment = segments[i];
+        const size_t p = tree.parent(i);
+
+        double diameter = segment.result.actualDiameter / 1000.0;  // m
+        double segmentVolume = M_PI * diameter * diameter / 4.0 * segment.length * 1000.0;  // L
+
+        pathLength[i] = (p != noParent ? pathLength[p] : 0.0) + segment.length;
+        pathDrop[i] = (p != noParent ? pathDrop[p] : 0.0) + segment.result.pressureDrop;
+        elevation[i] = (p != noParent ? elevation[p] : 0.0) + segment.heightDifference;
+        volume[i] = (looped && segment.hasReturnLine) ? 0.0
+                  : (p != noParent ? volume[p] : 0.0) + segmentVolume;
+
+        for (const auto& fixture : segment.fixtures) {
+            FixturePathResult entry;
+            entry.segmentId = segment.id;
+            entry.type = fixture.type;
+            entry.quantity = fixture.quantity;
+            entry.pathLength = pathLength[i];
+            entry.pathPressureDrop = pathDrop[i];
+            entry.elevation = elevation[i];
+            entry.pressure = networkParams.supplyPressure - pathDrop[i] / 10.0;
+            entry.pressureMargin = entry.pressure - networkParams.requiredPressure;
+            if (hotWater) {
+                entry.hotWaterVolume = volume[i];
+                double unitFlowRate = fixture.unitFlowRate() / 60.0;  // L/s
+                entry.waitTime = (unitFlowRate > 0.0) ? volume[i] / unitFlowRate : 0.0;
+            }
+            if (entry.pressureMargin < 0.0) {
+                ++result.insufficientCount;
+            }
+            result.fixtures.push_back(entry);
+        }
+    }
+
+    if (result.fixtures.empty()) {
+        return result;
+    }
+
+    // ÉTAPE 3: Classement des N appareils les plus défavorisés (marge de pression croissante)
+    std::vector<size_t> order(result.fixtures.size());
+    for (size_t k = 0; k < order.size(); ++k) {
+        order[k] = k;
+    }
+    size_t ranked = std::min(std::max<size_t>(worstCount, 1), order.size());
+    std::partial_sort(order.begin(), order.begin() + ranked, order.end(),
+        [&result](size_t a, size_t b) {
+            return result.fixtures[a].pressureMargin < result.fixtures[b].pressureMargin;
+        });
+    result.worstFixtures.assign(order.begin(), order.begin() + ranked);
+
+    for (size_t k = 1; k < result.fixtures.size(); ++k) {
+        if (result.fixtures[k].waitTime > result.fixtures[result.longestWaitFixture].waitTime) {
+            result.longestWaitFixture = k;
+        }
+    }
+
+    // ÉTAPE 4: Chemin critique = remontée de l'appareil le plus défavorisé jusqu'à la source
+    for (size_t i = tree.find(result.critical().segmentId); i != noParent; i = tree.parent(i)) {
+        result.criticalPath.push_back(segments[i].id);
+    }
+    std::reverse(result.criticalPath.begin(), result.criticalPath.end());
+
+    return result;
+}
+
+} // namespace HydraulicCalc
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "PipeCalculator.h"
+
+namespace HydraulicCalc {
+
+// Situation d'un groupe d'appareils en bout de son chemin hydraulique
+struct FixturePathResult {
+    std::string segmentId;        // Tronçon desservant l'appareil (appareil en sortie de tronçon)
+    FixtureType type;
+    int quantity;
+    double pathLength;            // Longueur de canalisation depuis la source (m)
+    double pathPressureDrop;      // Pertes de charge cumulées, hauteur comprise (mCE)
+    double elevation;             // Dénivelé cumulé depuis la source (m)
+    double pressure;              // Pression disponible à l'appareil (bar)
+    double pressureMargin;        // Pression disponible - pression requise (bar)
+    double hotWaterVolume;        // Volume d'eau à tirer avant l'arrivée de l'eau chaude (L)
+    double waitTime;              // Temps d'attente de l'eau chaude au débit de l'appareil (s), 0 en eau froide
+
+    FixturePathResult()
+        : type(FixtureType::WashBasin), quantity(0)
+        , pathLength(0), pathPressureDrop(0), elevation(0)
+        , pressure(0), pressureMargin(0), hotWaterVolume(0), waitTime(0)
+    {}
+};
+
+// Résultat de l'analyse du chemin critique
+struct CriticalPathResult {
+    std::vector<FixturePathResult> fixtures;   // Tous les appareils, dans l'ordre de parcours du réseau
+    std::vector<size_t> worstFixtures;         // Indices dans fixtures, du plus défavorisé au moins défavorisé
+    std::vector<std::string> criticalPath;     // Tronçons de la source jusqu'à l'appareil le plus défavorisé
+    size_t longestWaitFixture;                 // Indice de l'appareil au temps d'attente le plus long
+    int insufficientCount;                     // Nombre d'appareils sous la pression requise
+
+    CriticalPathResult() : longestWaitFixture(0), insufficientCount(0) {}
+
+    bool empty() const { return fixtures.empty(); }
+    const FixturePathResult& critical() const { return fixtures[worstFixtures.front()]; }
+};
+
+// Analyse du chemin critique et de la desserte de chaque appareil
+//
+// Parcours préfixe unique du réseau calculé : pertes de charge, dénivelé, longueur et
+// volume d'eau non bouclé sont cumulés de la source à chaque tronçon (sommes préfixes),
+// d'où la pression et le temps d'attente de l'eau chaude à chaque appareil en O(n).
+// En bouclage, l'eau est chaude jusqu'en sortie des tronçons bouclés : seul le volume
+// des tronçons non bouclés compte pour l'attente.
+class CriticalPathAnalyzer {
+public:
+    // Temps d'attente de l'eau chaude au-delà duquel un puisage est signalé (s) - valeur usuelle
+    static constexpr double RecommendedWaitTime = 10.0;
+
+    CriticalPathResult analyze(const NetworkCalculationParameters& networkParams, size_t worstCount = 5) const;
+};
+
+} // namespace HydraulicCalc
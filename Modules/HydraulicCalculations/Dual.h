@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace HydraulicCalc {
+
+// Nombre dual pour la différentiation automatique en mode direct
+//
+// x = valeur + Σ εᵢ·dérivéeᵢ avec εᵢ·εⱼ = 0 : chaque opération propage la valeur et les N
+// dérivées partielles (règle de la chaîne), d'où les N dérivées d'un calcul en une seule
+// évaluation, pour un coût de l'ordre de (N + 1) fois le calcul en double.
+// Les comparaisons portent sur la valeur seule (choix de branche, ex. laminaire/turbulent).
+template <std::size_t N>
+struct Dual {
+    double value;
+    std::array<double, N> derivatives;
+
+    Dual(double v = 0.0) : value(v), derivatives{} {}
+
+    // Variable d'entrée : dérivée 1 par rapport à elle-même (indice de la variable)
+    static Dual variable(double v, std::size_t index) {
+        Dual result(v);
+        result.derivatives[index] = 1.0;
+        return result;
+    }
+
+    double derivative(std::size_t index) const { return derivatives[index]; }
+
+    // f(x) connaissant f(valeur) et f'(valeur)
+    Dual apply(double f, double df) const {
+        Dual result(f);
+        for (std::size_t i = 0; i < N; ++i) {
+            result.derivatives[i] = df * derivatives[i];
+        }
+        return result;
+    }
+
+    Dual& operator+=(const Dual& other) {
+        value += other.value;
+        for (std::size_t i = 0; i < N; ++i) derivatives[i] += other.derivatives[i];
+        return *this;
+    }
+    Dual& operator-=(const Dual& other) {
+        value -= other.value;
+        for (std::size_t i = 0; i < N; ++i) derivatives[i] -= other.derivatives[i];
+        return *this;
+    }
+    Dual& operator*=(const Dual& other) {
+        for (std::size_t i = 0; i < N; ++i) {
+            derivatives[i] = derivatives[i] * other.value + value * other.derivatives[i];
+        }
+        value *= other.value;
+        return *this;
+    }
+    Dual& operator/=(const Dual& other) {
+        const double inverse = 1.0 / other.value;
+        for (std::size_t i = 0; i < N; ++i) {
+            derivatives[i] = (derivatives[i] - value * inverse * other.derivatives[i]) * inverse;
+        }
+        value *= inverse;
+        return *this;
+    }
+
+    Dual operator-() const { return apply(-value, -1.0); }
+};
+
+template <std::size_t N> Dual<N> operator+(Dual<N> a, const Dual<N>& b) { return a += b; }
+template <std::size_t N> Dual<N> operator-(Dual<N> a, const Dual<N>& b) { return a -= b; }
+template <std::size_t N> Dual<N> operator*(Dual<N> a, const Dual<N>& b) { return a *= b; }
+template <std::size_t N> Dual<N> operator/(Dual<N> a, const Dual<N>& b) { return a /= b; }
+
+template <std::size_t N> Dual<N> operator+(Dual<N> a, double b) { a.value += b; return a; }
+template <std::size_t N> Dual<N> operator+(double a, Dual<N> b) { b.value += a; return b; }
+template <std::size_t N> Dual<N> operator-(Dual<N> a, double b) { a.value -= b; return a; }
+template <std::size_t N> Dual<N> operator-(double a, const Dual<N>& b) { return (-b) + a; }
+template <std::size_t N> Dual<N> operator*(const Dual<N>& a, double b) { return a.apply(a.value * b, b); }
+template <std::size_t N> Dual<N> operator*(double a, const Dual<N>& b) { return b.apply(a * b.value, a); }
+template <std::size_t N> Dual<N> operator/(const Dual<N>& a, double b) { return a.apply(a.value / b, 1.0 / b); }
+template <std::size_t N> Dual<N> operator/(double a, const Dual<N>& b) {
+    return b.apply(a / b.value, -a / (b.value * b.value));
+}
+
+template <std::size_t N> bool operator<(const Dual<N>& a, double b) { return a.value < b; }
+template <std::size_t N> bool operator>(const Dual<N>& a, double b) { return a.value > b; }
+
+// Fonctions usuelles (trouvées par ADL, à côté de leurs équivalents std:: pour les double)
+template <std::size_t N> Dual<N> sqrt(const Dual<N>& x) {
+    double root = std::sqrt(x.value);
+    return x.apply(root, 0.5 / root);
+}
+template <std::size_t N> Dual<N> log(const Dual<N>& x) { return x.apply(std::log(x.value), 1.0 / x.value); }
+template <std::size_t N> Dual<N> log10(const Dual<N>& x) {
+    return x.apply(std::log10(x.value), 1.0 / (x.value * std::log(10.0)));
+}
+template <std::size_t N> Dual<N> pow(const Dual<N>& x, double exponent) {
+    return x.apply(std::pow(x.value, exponent), exponent * std::pow(x.value, exponent - 1.0));
+}
+template <std::size_t N> Dual<N> abs(const Dual<N>& x) { return (x.value < 0.0) ? -x : x; }
+
+// Valeur d'un double ou d'un dual (pour les tests de convergence des kernels génériques)
+inline double valueOf(double x) { return x; }
+template <std::size_t N> double valueOf(const Dual<N>& x) { return x.value; }
+
+} // namespace HydraulicCalc
@@ -0,0 +1,142 @@
+#include "FixtureCatalogue.h"
+#include "PipeCalculator.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <locale>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace HydraulicCalc {
+
+namespace {
+
+std::string trim(const std::string& value) {
+    size_t start = value.find_first_not_of(" \t\r");
+    if (start == std::string::npos) return "";
+    size_t end = value.find_last_not_of(" \t\r");
+    return value.substr(start, end - start + 1);
+}
+
+std::string toLowerAscii(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](char c) { return std::tolower(c, std::locale::classic()); });
+    return value;
+}
+
+bool parseDecimal(std::string value, double& result) {
+    std::replace(value.begin(), value.end(), ',', '.');
+    std::istringstream stream(value);
+    stream.imbue(std::locale::classic());
+    stream >> result;
+    return !stream.fail() && stream.eof();
+}
+
+bool parseFixtureName(const std::string& name, FixtureType& type) {
+    const std::string wanted = toLowerAscii(name);
+    for (std::size_t i = 0; i < FixtureTypeCount; ++i) {
+        if (toLowerAscii(PipeCalculator::getFixtureName(static_cast<FixtureType>(i))) == wanted) {
+            type = static_cast<FixtureType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+FixtureCatalogue& FixtureCatalogue::instance() {
+    static FixtureCatalogue catalogue;
+    return catalogue;
+}
+
+void FixtureCatalogue::setFlowRate(FixtureType type, double flowRate) {
+    if (!(flowRate > 0.0)) {
+        throw std::runtime_error("Débit unitaire invalide : " + std::to_string(flowRate) + " L/min");
+    }
+    flowRates[static_cast<std::size_t>(type)] = flowRate;
+}
+
+std::vector<FixtureType> FixtureCatalogue::loadFromFile(const std::string& path) {
+    std::ifstream file(std::filesystem::u8path(path));
+    if (!file.is_open()) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier des débits d'appareils : " + path);
+    }
+
+    // ÉTAPE 1: Lecture et validation de toutes les lignes avant toute modification
+    std::vector<std::pair<FixtureType, double>> overrides;
+    std::string line;
+    int lineNumber = 0;
+    bool firstDataLine = true;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (lineNumber == 1 && line.size() >= 3 && line.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+            line.erase(0, 3);  // BOM UTF-8
+        }
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ';')) {
+            fields.push_back(trim(field));
+        }
+
+        // Ligne d'en-tête : uniquement la première ligne de données, reconnue à son libellé
+        const bool header = firstDataLine && toLowerAscii(fields[0]) == "appareil";
+        firstDataLine = false;
+        if (header) {
+            continue;
+        }
+
+        double flowRate = 0.0;
+        if (fields.size() != 2 || !parseDecimal(fields[1], flowRate)) {
+            throw std::runtime_error("Débits d'appareils, ligne " + std::to_string(lineNumber)
+                                     + " : format attendu Appareil;Débit (L/min)");
+        }
+
+        FixtureType type;
+        if (!parseFixtureName(fields[0], type)) {
+            throw std::runtime_error("Débits d'appareils, ligne " + std::to_string(lineNumber)
+                                     + " : appareil inconnu '" + fields[0] + "'");
+        }
+        if (!(flowRate > 0.0)) {
+            throw std::runtime_error("Débits d'appareils, ligne " + std::to_string(lineNumber)
+                                     + " : débit invalide " + fields[1] + " L/min");
+        }
+        overrides.emplace_back(type, flowRate);
+    }
+
+    // ÉTAPE 2: Application
+    std::vector<FixtureType> changed;
+    for (const auto& entry : overrides) {
+        setFlowRate(entry.first, entry.second);
+        if (std::find(changed.begin(), changed.end(), entry.first) == changed.end()) {
+            changed.push_back(entry.first);
+        }
+    }
+    return changed;
+}
+
+double FixtureCatalogue::totalFlowRate(const FixtureCounts& counts) const {
+    double total = 0.0;
+    for (std::size_t i = 0; i < FixtureTypeCount; ++i) {
+        total += counts[i] * flowRates[i];
+    }
+    return total;
+}
+
+int FixtureCatalogue::totalCount(const FixtureCounts& counts) {
+    int total = 0;
+    for (int count : counts) {
+        total += count;
+    }
+    return total;
+}
+
+} // namespace HydraulicCalc
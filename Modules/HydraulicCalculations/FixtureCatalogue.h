@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HydraulicCalc {
+
+// Types d'appareil sanitaire
+enum class FixtureType : std::uint8_t {
+    WashBasin,           // Lavabo
+    WashBasinCollective, // Lavabo collectif (par jet)
+    Sink,                // Évier
+    Shower,              // Douche
+    Bathtub,             // Baignoire
+    WC,                  // WC avec réservoir de chasse
+    WCFlushValve,        // WC avec robinet de chasse
+    Bidet,               // Bidet
+    WashingMachine,      // Lave-linge
+    Dishwasher,          // Lave-vaisselle
+    UrinalFlush,         // Urinoir avec robinet individuel
+    UrinalSiphonic,      // Urinoir à action siphonique
+    HandWashBasin,       // Lave-mains
+    UtilitySink,         // Bac à laver
+    WaterOutlet12,       // Poste d'eau robinet 1/2"
+    WaterOutlet34        // Poste d'eau robinet 3/4"
+};
+
+constexpr std::size_t FixtureTypeCount = 16;
+
+// Nombre d'appareils par type, indexé par FixtureType
+using FixtureCounts = std::array<int, FixtureTypeCount>;
+
+// Débits unitaires des appareils sanitaires, indexés par FixtureType
+//
+// Les valeurs normatives sont constantes à la compilation ; l'instance partagée en
+// part et peut être surchargée (débits fabricant, cahier des charges) entre deux
+// calculs. Un débit cumulé est le produit scalaire d'un vecteur de comptes par la table.
+//
+// Fichier de surcharges (séparateur ';', virgule ou point décimal, '#' = commentaire),
+// appareils désignés par leur nom (PipeCalculator::getFixtureName, casse ignorée) :
+//   Appareil;Débit (L/min)
+//   Douche;9,0
+// L'interface charge DefaultOverridesFileName depuis le dossier de l'application au démarrage.
+class FixtureCatalogue {
+public:
+    // Débits unitaires normatifs (Qmin de calcul) en L/min
+    static constexpr std::array<double, FixtureTypeCount> DefaultFlowRates = {{
+        12.0,   // Lavabo : 0.20 L/s
+        3.0,    // Lavabo collectif : 0.05 L/s (par jet)
+        12.0,   // Évier : 0.20 L/s
+        12.0,   // Douche : 0.20 L/s
+        20.0,   // Baignoire : 0.33 L/s = 19.8 L/min ≈ 20 L/min
+        7.2,    // WC avec réservoir : 0.12 L/s
+        90.0,   // WC avec robinet de chasse : 1.50 L/s
+        12.0,   // Bidet : 0.20 L/s
+        12.0,   // Lave-linge : 0.20 L/s
+        6.0,    // Lave-vaisselle : 0.10 L/s
+        9.0,    // Urinoir avec robinet individuel : 0.15 L/s
+        30.0,   // Urinoir à action siphonique : 0.50 L/s
+        6.0,    // Lave-mains : 0.10 L/s
+        20.0,   // Bac à laver : 0.33 L/s = 19.8 L/min ≈ 20 L/min
+        20.0,   // Poste d'eau 1/2" : 0.33 L/s = 19.8 L/min ≈ 20 L/min
+        25.2    // Poste d'eau 3/4" : 0.42 L/s
+    }};
+
+    static constexpr double defaultFlowRate(FixtureType type) {
+        return DefaultFlowRates[static_cast<std::size_t>(type)];
+    }
+
+    // Table partagée (valeurs normatives jusqu'à surcharge)
+    static FixtureCatalogue& instance();
+
+    double flowRate(FixtureType type) const { return flowRates[static_cast<std::size_t>(type)]; }
+    const std::array<double, FixtureTypeCount>& getFlowRates() const { return flowRates; }
+
+    // Surcharge du débit unitaire d'un type (L/min, strictement positif)
+    void setFlowRate(FixtureType type, double flowRate);
+    void resetToDefaults() { flowRates = DefaultFlowRates; }
+
+    // Fichier de surcharges lu au démarrage de l'interface
+    static constexpr const char* DefaultOverridesFileName = "debits_appareils.csv";
+
+    // Applique les surcharges d'un fichier (toutes ou aucune) et retourne les types modifiés ;
+    // lève std::runtime_error en cas d'erreur
+    std::vector<FixtureType> loadFromFile(const std::string& path);
+
+    // Débit brut Σ nᵢ·qᵢ (L/min), sans coefficient de simultanéité
+    double totalFlowRate(const FixtureCounts& counts) const;
+
+    // Nombre total d'appareils Σ nᵢ
+    static int totalCount(const FixtureCounts& counts);
+
+private:
+    FixtureCatalogue() : flowRates(DefaultFlowRates) {}
+
+    std::array<double, FixtureTypeCount> flowRates;
+};
+
+} // namespace HydraulicCalc
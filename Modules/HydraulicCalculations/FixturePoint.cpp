@@ -95,7 +95,7 @@ void FixturePoint::updateDisplay()
     QString tooltipText = QString("%1\nQté: %2\nDébit: %3 L/min")
         .arg(QString::fromStdString(HydraulicCalc::PipeCalculator::getFixtureName(fixtureType)))
         .arg(quantity)
-        .arg(fixture.flowRate * quantity, 0, 'f', 1);
+        .arg(fixture.unitFlowRate() * quantity, 0, 'f', 1);
     tooltipLabel->setPlainText(tooltipText);
     tooltipLabel->setPos(20, -20);
 }
@@ -0,0 +1,99 @@
+#include "FrictionFactor.h"
+#include "HydraulicKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace HydraulicCalc {
+
+double FrictionFactor::compute(double reynolds, double relativeRoughness, FrictionModel model) {
+    if (reynolds < LaminarLimit) {
+        // Écoulement laminaire (Poiseuille)
+        return 64.0 / reynolds;
+    }
+
+    switch (model) {
+        case FrictionModel::SwameeJain:
+            return swameeJain(reynolds, relativeRoughness);
+        case FrictionModel::ColebrookWhite:
+            return colebrookWhite(reynolds, relativeRoughness);
+        case FrictionModel::Table:
+            return fromTable(reynolds, relativeRoughness);
+    }
+    return swameeJain(reynolds, relativeRoughness);
+}
+
+double FrictionFactor::swameeJain(double reynolds, double relativeRoughness) {
+    return Kernels::swameeJain(reynolds, relativeRoughness);
+}
+
+double FrictionFactor::colebrookWhite(double reynolds, double relativeRoughness, int* iterations) {
+    return Kernels::colebrookWhite(reynolds, relativeRoughness, iterations);
+}
+
+namespace {
+
+// Coordonnée « log2 linéarisé » : x = m·2^e avec m ∈ [1, 2[ → e + (m − 1)
+double linearizedLog2(double x) {
+    int exponent;
+    double mantissa = std::frexp(x, &exponent);  // mantissa ∈ [0.5, 1[
+    return (exponent - 1) + (2.0 * mantissa - 1.0);
+}
+
+// Réciproque de linearizedLog2
+double linearizedExp2(double coordinate) {
+    double exponent = std::floor(coordinate);
+    return std::ldexp(1.0 + (coordinate - exponent), static_cast<int>(exponent));
+}
+
+} // namespace
+
+FrictionFactor::Table::Table() {
+    reynoldsCount = (MaxReynoldsExponent - MinReynoldsExponent) * ReynoldsPerOctave + 1;
+    roughnessCount = (MaxRoughnessExponent - MinRoughnessExponent) * RoughnessPerOctave + 1;
+    values.resize(static_cast<size_t>(reynoldsCount) * roughnessCount);
+
+    for (int i = 0; i < reynoldsCount; ++i) {
+        double reynolds = linearizedExp2(MinReynoldsExponent + static_cast<double>(i) / ReynoldsPerOctave);
+        for (int j = 0; j < roughnessCount; ++j) {
+            double roughness = linearizedExp2(MinRoughnessExponent + static_cast<double>(j) / RoughnessPerOctave);
+            values[static_cast<size_t>(i) * roughnessCount + j] = colebrookWhite(reynolds, roughness);
+        }
+    }
+}
+
+const FrictionFactor::Table& FrictionFactor::table() {
+    static const Table frictionTable;
+    return frictionTable;
+}
+
+double FrictionFactor::fromTable(double reynolds, double relativeRoughness) {
+    const Table& t = table();
+
+    // Coordonnées dans la grille (bornées aux limites de la table)
+    double u = (linearizedLog2(reynolds) - Table::MinReynoldsExponent) * Table::ReynoldsPerOctave;
+    double v = (linearizedLog2(std::max(relativeRoughness, 1e-12)) - Table::MinRoughnessExponent) * Table::RoughnessPerOctave;
+    u = std::min(std::max(u, 0.0), static_cast<double>(t.reynoldsCount - 1));
+    v = std::min(std::max(v, 0.0), static_cast<double>(t.roughnessCount - 1));
+
+    int i = std::min(static_cast<int>(u), t.reynoldsCount - 2);
+    int j = std::min(static_cast<int>(v), t.roughnessCount - 2);
+    double fu = u - i;
+    double fv = v - j;
+
+    const double* row0 = &t.values[static_cast<size_t>(i) * t.roughnessCount + j];
+    const double* row1 = row0 + t.roughnessCount;
+    double low = row0[0] + fv * (row0[1] - row0[0]);
+    double high = row1[0] + fv * (row1[1] - row1[0]);
+    return low + fu * (high - low);
+}
+
+std::string FrictionFactor::getModelName(FrictionModel model) {
+    switch (model) {
+        case FrictionModel::SwameeJain: return "Swamee-Jain (approximation de Colebrook-White)";
+        case FrictionModel::ColebrookWhite: return "Colebrook-White (résolution exacte)";
+        case FrictionModel::Table: return "Table λ(Re, ε/D) (interpolation de Colebrook-White)";
+    }
+    return "Inconnu";
+}
+
+} // namespace HydraulicCalc
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace HydraulicCalc {
+
+// Méthode de calcul du coefficient de perte de charge λ en régime turbulent
+enum class FrictionModel {
+    SwameeJain,          // Approximation explicite de Swamee-Jain (par défaut)
+    ColebrookWhite,      // Résolution exacte de Colebrook-White (notes de calcul de vérification)
+    Table                // Table λ(Re, ε/D) précalculée, interpolation bilinéaire (calculs de masse)
+};
+
+constexpr std::size_t FrictionModelCount = 3;  // Nombre de méthodes de calcul de λ
+
+// Coefficient de perte de charge λ (Darcy)
+// En laminaire (Re < 2300), λ = 64/Re quelle que soit la méthode.
+class FrictionFactor {
+public:
+    static constexpr double LaminarLimit = 2300.0;
+
+    // λ selon la méthode choisie (relativeRoughness = ε/D, sans dimension)
+    static double compute(double reynolds, double relativeRoughness, FrictionModel model);
+
+    // Approximation de Swamee-Jain
+    static double swameeJain(double reynolds, double relativeRoughness);
+
+    // Colebrook-White : 1/√λ = -2·log10(ε/(3.7·D) + 2.51/(Re·√λ))
+    // Newton sur x = 1/√λ, initialisé par Swamee-Jain (2 à 3 itérations en pratique)
+    static double colebrookWhite(double reynolds, double relativeRoughness, int* iterations = nullptr);
+
+    // Lecture dans la table précalculée (Colebrook-White aux nœuds)
+    static double fromTable(double reynolds, double relativeRoughness);
+
+    static std::string getModelName(FrictionModel model);
+
+private:
+    // Table λ(Re, ε/D), construite au premier appel
+    // Axes en « log2 linéarisé » : x = m·2^e (m ∈ [1, 2[) → e + (m − 1), obtenu par std::frexp
+    // sans logarithme ; la table est construite sur les mêmes coordonnées.
+    struct Table {
+        static constexpr int MinReynoldsExponent = 10;    // Re = 2^10 ≈ 1 000 (sous la limite laminaire)
+        static constexpr int MaxReynoldsExponent = 27;    // Re = 2^27 ≈ 1.3·10⁸
+        static constexpr int ReynoldsPerOctave = 8;
+        static constexpr int MinRoughnessExponent = -20;  // ε/D = 2^-20 ≈ 10⁻⁶ (tube hydrauliquement lisse)
+        static constexpr int MaxRoughnessExponent = -3;   // ε/D = 2^-3 = 0.125
+        static constexpr int RoughnessPerOctave = 4;
+
+        int reynoldsCount;
+        int roughnessCount;
+        std::vector<double> values;  // [iRe * roughnessCount + iRough]
+
+        Table();
+    };
+    static const Table& table();
+};
+
+} // namespace HydraulicCalc
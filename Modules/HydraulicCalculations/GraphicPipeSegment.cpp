@@ -300,12 +300,13 @@ void GraphicPipeSegment::updateResultsDisplay(const HydraulicCalc::NetworkSegmen
 
     resultsLabel->setPlainText(resultsText);
 
-    // Couleur selon les alertes
-    if (result.velocity > 2.0 || result.velocity < 0.3) {
+    // Couleur selon les diagnostics, texte détaillé en infobulle
+    if (!result.diagnostics.empty()) {
         resultsLabel->setDefaultTextColor(QColor("#cc0000"));  // Rouge vif si problème
     } else {
         resultsLabel->setDefaultTextColor(QColor("#006600"));  // Vert foncé si OK
     }
+    resultsLabel->setToolTip(QString::fromStdString(result.diagnostics.formatRecommendation()));
 
     updatePipeVisual(segmentData);
     updateLabels(segmentData);
@@ -1,4 +1,8 @@
 #include "HydraulicCalculationsWindow.h"
+#include "WaterHammerSolver.h"
+#include "PipeCatalogue.h"
+#include "NetworkReduction.h"
+#include "CalculationCache.h"
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QInputDialog>
@@ -11,8 +15,14 @@
 #include <QPalette>
 #include <QApplication>
 #include <QKeyEvent>
+#include <QShortcut>
+#include <QStandardPaths>
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <memory>
 
 HydraulicCalculationsWindow::HydraulicCalculationsWindow(QWidget *parent)
     : QDialog(parent)
@@ -21,9 +31,11 @@ HydraulicCalculationsWindow::HydraulicCalculationsWindow(QWidget *parent)
     , leftPanelLayout(nullptr)
     , leftScrollArea(nullptr)
     , schemaView(nullptr)
+    , hasCombinedResults(false)
     , currentSelectedSegment(nullptr)
     , currentSelectedFixture(nullptr)
     , hasCalculated(false)
+    , restoringHistory(false)
 {
     // Configurer une palette globale pour les dialogues
     QPalette dialogPalette;
@@ -43,9 +55,53 @@ HydraulicCalculationsWindow::HydraulicCalculationsWindow(QWidget *parent)
     setupUi();
     applyStyle();
 
+    // Cache des résultats partagé entre les fenêtres : un réseau déjà calculé (projet rouvert,
+    // paramètre rétabli) n'est pas recalculé. Niveau disque dans le dossier de cache de
+    // l'utilisateur, facultatif : sans dossier utilisable, le cache reste en mémoire.
+    HydraulicCalc::CalculationCache& resultCache = HydraulicCalc::CalculationCache::instance();
+    const QString cacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cacheDirectory.isEmpty()) {
+        try {
+            resultCache.setDiskDirectory((cacheDirectory + "/calculs").toStdString());
+        } catch (const std::exception&) {
+            // Dossier non créé : cache en mémoire seulement
+        }
+    }
+    calculator.setResultCache(&resultCache);
+
+    // Débits unitaires surchargés (débits fabricant, cahier des charges) : fichier facultatif
+    // déposé à côté de l'exécutable. La clé du cache inclut les débits, rien n'est à invalider.
+    const QString fixtureOverridesPath = QCoreApplication::applicationDirPath() + "/"
+        + QString::fromUtf8(HydraulicCalc::FixtureCatalogue::DefaultOverridesFileName);
+    if (QFileInfo::exists(fixtureOverridesPath)) {
+        HydraulicCalc::FixtureCatalogue& fixtureCatalogue = HydraulicCalc::FixtureCatalogue::instance();
+        fixtureCatalogue.resetToDefaults();
+        try {
+            fixtureCatalogue.loadFromFile(fixtureOverridesPath.toStdString());
+        } catch (const std::exception& e) {
+            QMessageBox::warning(this, "Débits des appareils",
+                QString("Le fichier %1 est ignoré :\n%2")
+                    .arg(fixtureOverridesPath, QString::fromUtf8(e.what())));
+        }
+    }
+
     // Connexions
     connect(networkTypeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &HydraulicCalculationsWindow::onNetworkTypeChanged);
+    connect(combinedCalculationCheck, &QCheckBox::toggled, [this]() {
+        loopParametersGroup->setVisible(networkTypeCombo->currentIndex() == 2 || combinedCalculationCheck->isChecked());
+    });
+
+    // Paramètres de calcul (hors type de réseau affiché) : résultats combinés périmés
+    for (QComboBox* combo : { materialCombo, frictionModelCombo }) {
+        connect(combo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+                this, &HydraulicCalculationsWindow::onCalculationInputChanged);
+    }
+    for (QDoubleSpinBox* spin : { supplyPressureSpin, requiredPressureSpin, waterTempSpin, ambientTempSpin, insulationSpin }) {
+        connect(spin, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+                this, &HydraulicCalculationsWindow::onCalculationInputChanged);
+    }
+    connect(seriesReductionCheck, &QCheckBox::toggled, this, &HydraulicCalculationsWindow::onCalculationInputChanged);
 
     // Connexions des outils
     connect(selectToolButton, &QToolButton::clicked, this, &HydraulicCalculationsWindow::onSelectModeActivated);
@@ -65,9 +121,20 @@ HydraulicCalculationsWindow::HydraulicCalculationsWindow(QWidget *parent)
     connect(editButton, &QPushButton::clicked, this, &HydraulicCalculationsWindow::onEditSelectedSegment);
     connect(deleteButton, &QPushButton::clicked, this, &HydraulicCalculationsWindow::onDeleteSelectedSegment);
 
+    // Historique : boutons et raccourcis Ctrl+Z / Ctrl+Y
+    connect(undoButton, &QPushButton::clicked, this, &HydraulicCalculationsWindow::onUndo);
+    connect(redoButton, &QPushButton::clicked, this, &HydraulicCalculationsWindow::onRedo);
+    connect(new QShortcut(QKeySequence::Undo, this), &QShortcut::activated, this, &HydraulicCalculationsWindow::onUndo);
+    connect(new QShortcut(QKeySequence::Redo, this), &QShortcut::activated, this, &HydraulicCalculationsWindow::onRedo);
+
     // Connexions des actions
+    connect(openProjectButton, &QPushButton::clicked, this, &HydraulicCalculationsWindow::onOpenProject);
+    connect(saveProjectButton, &QPushButton::clicked, this, &HydraulicCalculationsWindow::onSaveProject);
+    connect(new QShortcut(QKeySequence::Save, this), &QShortcut::activated, this, &HydraulicCalculationsWindow::onSaveProject);
     connect(calculateButton, &QPushButton::clicked, this, &HydraulicCalculationsWindow::onCalculate);
     connect(exportButton, &QPushButton::clicked, this, &HydraulicCalculationsWindow::onExportPDF);
+    connect(waterHammerButton, &QPushButton::clicked, this, &HydraulicCalculationsWindow::onWaterHammerAnalysis);
+    connect(pipeCatalogueButton, &QPushButton::clicked, this, &HydraulicCalculationsWindow::onLoadPipeCatalogue);
     connect(resetViewButton, &QPushButton::clicked, this, &HydraulicCalculationsWindow::onResetView);
     connect(clearButton, &QPushButton::clicked, this, &HydraulicCalculationsWindow::onClear);
     connect(closeButton, &QPushButton::clicked, this, &QDialog::accept);
@@ -175,6 +242,21 @@ void HydraulicCalculationsWindow::createParametersPanel()
     materialCombo->addItem("Acier galvanisé");
     paramsLayout->addRow(materialLabel, materialCombo);
 
+    pipeCatalogueButton = new QPushButton("Catalogue de tubes...");
+    pipeCatalogueButton->setObjectName("secondaryButton");
+    pipeCatalogueButton->setToolTip("Charger des séries de tubes fabricant (CSV : Série;Matériau;Rugosité;DN;D int)");
+    paramsLayout->addRow(QString(), pipeCatalogueButton);
+
+    QLabel *frictionLabel = new QLabel("Calcul de λ");
+    frictionLabel->setObjectName("formLabel");
+    frictionModelCombo = new QComboBox();
+    frictionModelCombo->setObjectName("modernCombo");
+    frictionModelCombo->addItem("Swamee-Jain");
+    frictionModelCombo->addItem("Colebrook-White exact");
+    frictionModelCombo->addItem("Table λ(Re, ε/D)");
+    frictionModelCombo->setToolTip("Colebrook-White exact pour les notes de vérification, table pour les calculs de masse");
+    paramsLayout->addRow(frictionLabel, frictionModelCombo);
+
     QLabel *supplyLabel = new QLabel("Pression alimentation");
     supplyLabel->setObjectName("formLabel");
     supplyPressureSpin = new QDoubleSpinBox();
@@ -197,6 +279,18 @@ void HydraulicCalculationsWindow::createParametersPanel()
     requiredPressureSpin->installEventFilter(wheelFilter);  // Désactiver molette
     paramsLayout->addRow(requiredLabel, requiredPressureSpin);
 
+    seriesReductionCheck = new QCheckBox("Fusionner les tronçons en série");
+    seriesReductionCheck->setChecked(false);
+    seriesReductionCheck->setToolTip("Calcule les chaînes de tronçons sans appareil comme un tronçon unique "
+                                     "(plus rapide sur les grands réseaux, températures de bouclage interpolées)");
+    paramsLayout->addRow(seriesReductionCheck);
+
+    combinedCalculationCheck = new QCheckBox("Calculer EF, ECS et bouclage ensemble");
+    combinedCalculationCheck->setChecked(false);
+    combinedCalculationCheck->setToolTip("Dimensionne les trois réseaux en un seul calcul ; le choix du type de réseau "
+                                         "affiche ensuite les résultats correspondants sans recalcul");
+    paramsLayout->addRow(combinedCalculationCheck);
+
     leftPanelLayout->addWidget(parametersGroup);
 
     // Paramètres bouclage ECS - Style carte moderne
@@ -265,6 +359,23 @@ void HydraulicCalculationsWindow::createParametersPanel()
     deleteButton->setMinimumHeight(36);
     editLayout->addWidget(deleteButton);
 
+    QHBoxLayout *historyLayout = new QHBoxLayout();
+    historyLayout->setSpacing(8);
+
+    undoButton = new QPushButton("Annuler");
+    undoButton->setObjectName("secondaryButton");
+    undoButton->setEnabled(false);
+    undoButton->setMinimumHeight(36);
+    historyLayout->addWidget(undoButton);
+
+    redoButton = new QPushButton("Rétablir");
+    redoButton->setObjectName("secondaryButton");
+    redoButton->setEnabled(false);
+    redoButton->setMinimumHeight(36);
+    historyLayout->addWidget(redoButton);
+
+    editLayout->addLayout(historyLayout);
+
     leftPanelLayout->addWidget(editGroup);
 
     // Boutons d'action - Style moderne sans groupbox
@@ -282,6 +393,21 @@ void HydraulicCalculationsWindow::createParametersPanel()
     );
     leftPanelLayout->addWidget(actionsLabel);
 
+    QHBoxLayout *projectLayout = new QHBoxLayout();
+    projectLayout->setSpacing(8);
+
+    openProjectButton = new QPushButton("Ouvrir");
+    openProjectButton->setObjectName("secondaryButton");
+    openProjectButton->setMinimumHeight(36);
+    projectLayout->addWidget(openProjectButton);
+
+    saveProjectButton = new QPushButton("Enregistrer");
+    saveProjectButton->setObjectName("secondaryButton");
+    saveProjectButton->setMinimumHeight(36);
+    projectLayout->addWidget(saveProjectButton);
+
+    leftPanelLayout->addLayout(projectLayout);
+
     calculateButton = new QPushButton("Calculer");
     calculateButton->setObjectName("primaryButton");
     calculateButton->setMinimumHeight(44);
@@ -293,6 +419,12 @@ void HydraulicCalculationsWindow::createParametersPanel()
     exportButton->setMinimumHeight(36);
     leftPanelLayout->addWidget(exportButton);
 
+    waterHammerButton = new QPushButton("Coup de bélier");
+    waterHammerButton->setObjectName("secondaryButton");
+    waterHammerButton->setMinimumHeight(36);
+    waterHammerButton->setToolTip("Surpressions à la fermeture des robinets de chasse et électrovannes");
+    leftPanelLayout->addWidget(waterHammerButton);
+
     resetViewButton = new QPushButton("Réinitialiser vue");
     resetViewButton->setObjectName("secondaryButton");
     resetViewButton->setMinimumHeight(36);
@@ -697,11 +829,385 @@ const HydraulicCalc::NetworkSegment* HydraulicCalculationsWindow::findSegmentByI
     return nullptr;
 }
 
+GraphicPipeSegment* HydraulicCalculationsWindow::findGraphicSegment(const std::string& id)
+{
+    for (auto* graphicSegment : schemaView->getSegments()) {
+        if (graphicSegment && graphicSegment->getSegmentId() == id) {
+            return graphicSegment;
+        }
+    }
+    return nullptr;
+}
+
+GraphicPipeSegment* HydraulicCalculationsWindow::findFixtureOwner(FixturePoint* fixture)
+{
+    for (auto* graphicSegment : schemaView->getSegments()) {
+        const auto& fixturePoints = graphicSegment->getFixturePoints();
+        if (std::find(fixturePoints.begin(), fixturePoints.end(), fixture) != fixturePoints.end()) {
+            return graphicSegment;
+        }
+    }
+    return nullptr;
+}
+
+// ===== HISTORIQUE =====
+
+std::shared_ptr<const HydraulicCalc::SegmentSnapshot> HydraulicCalculationsWindow::captureSegment(const std::string& id)
+{
+    const HydraulicCalc::NetworkSegment* segmentData = findSegmentById(id);
+    GraphicPipeSegment* graphicSegment = findGraphicSegment(id);
+    if (!segmentData || !graphicSegment) {
+        return nullptr;
+    }
+
+    auto snapshot = std::make_shared<HydraulicCalc::SegmentSnapshot>();
+    snapshot->segment = *segmentData;
+    snapshot->start = HydraulicCalc::SchemaPoint(graphicSegment->getStartPoint().x(), graphicSegment->getStartPoint().y());
+    snapshot->end = HydraulicCalc::SchemaPoint(graphicSegment->getEndPoint().x(), graphicSegment->getEndPoint().y());
+
+    // Les appareils du schéma font foi (les données ne sont synchronisées qu'au calcul)
+    snapshot->segment.fixtures.clear();
+    for (auto* fixturePoint : graphicSegment->getFixturePoints()) {
+        if (!fixturePoint) continue;
+        snapshot->segment.fixtures.push_back(fixturePoint->toFixture());
+        QPointF position = fixturePoint->getPositionOnSegment();
+        snapshot->fixturePositions.push_back(HydraulicCalc::SchemaPoint(position.x(), position.y()));
+    }
+    return snapshot;
+}
+
+void HydraulicCalculationsWindow::recordEdit(const std::vector<std::string>& segmentIds, const QString& label)
+{
+    if (restoringHistory) return;
+
+    // Seules les entrées des tronçons touchés sont recopiées, le reste est partagé
+    HydraulicCalc::NetworkState state = history.current();
+    for (const auto& id : segmentIds) {
+        auto snapshot = captureSegment(id);
+        state.segments = snapshot ? state.segments.set(id, snapshot) : state.segments.erase(id);
+    }
+    state.calculation.reset();
+
+    history.record(state, label.toStdString());
+    updateHistoryButtons();
+
+    if (autosave) {
+        autosave->record(history.current(), projectParameters(), segmentIds);
+    }
+}
+
+void HydraulicCalculationsWindow::recordCalculation()
+{
+    // Les résultats changent sur tous les tronçons : l'état courant est remplacé, sans nouvelle étape
+    HydraulicCalc::NetworkState state = history.current();
+    for (const auto& segment : networkSegments) {
+        auto snapshot = captureSegment(segment.id);
+        if (snapshot) {
+            state.segments = state.segments.set(segment.id, snapshot);
+        }
+    }
+
+    auto calculation = std::make_shared<HydraulicCalc::CalculationSnapshot>();
+    calculation->loopBalancing = loopBalancing;
+    calculation->criticalPath = criticalPath;
+    calculation->sensitivity = sensitivity;
+    calculation->hasCombinedResults = hasCombinedResults;
+    if (hasCombinedResults) {
+        calculation->combinedResults = combinedResults;
+        calculation->combinedCriticalPaths = combinedCriticalPaths;
+        calculation->combinedSensitivities = combinedSensitivities;
+    }
+    state.calculation = calculation;
+
+    history.amend(state);
+    if (autosave) {
+        autosave->update(history.current(), projectParameters());
+    }
+}
+
+// ===== PROJET =====
+
+HydraulicCalc::NetworkCalculationParameters HydraulicCalculationsWindow::projectParameters() const
+{
+    HydraulicCalc::NetworkCalculationParameters parameters;
+    parameters.networkType = static_cast<HydraulicCalc::NetworkType>(networkTypeCombo->currentIndex());
+    parameters.material = static_cast<HydraulicCalc::PipeMaterial>(materialCombo->currentIndex());
+    parameters.frictionModel = static_cast<HydraulicCalc::FrictionModel>(frictionModelCombo->currentIndex());
+    parameters.supplyPressure = supplyPressureSpin->value();
+    parameters.requiredPressure = requiredPressureSpin->value();
+    parameters.waterTemperature = waterTempSpin->value();
+    parameters.ambientTemperature = ambientTempSpin->value();
+    parameters.insulationThickness = insulationSpin->value();
+    return parameters;
+}
+
+void HydraulicCalculationsWindow::applyProjectParameters(const HydraulicCalc::NetworkCalculationParameters& parameters)
+{
+    networkTypeCombo->setCurrentIndex(static_cast<int>(parameters.networkType));
+    materialCombo->setCurrentIndex(static_cast<int>(parameters.material));
+    frictionModelCombo->setCurrentIndex(static_cast<int>(parameters.frictionModel));
+    supplyPressureSpin->setValue(parameters.supplyPressure);
+    requiredPressureSpin->setValue(parameters.requiredPressure);
+    waterTempSpin->setValue(parameters.waterTemperature);
+    ambientTempSpin->setValue(parameters.ambientTemperature);
+    insulationSpin->setValue(parameters.insulationThickness);
+}
+
+void HydraulicCalculationsWindow::onSaveProject()
+{
+    QString fileName = projectPath;
+    if (fileName.isEmpty()) {
+        fileName = QFileDialog::getSaveFileName(this, "Enregistrer le projet", "", "Projet hydraulique (*.tchp)");
+        if (fileName.isEmpty()) return;
+        if (!fileName.endsWith(".tchp", Qt::CaseInsensitive)) {
+            fileName += ".tchp";
+        }
+    }
+
+    try {
+        // Nouveau fichier : nouveau journal ; sinon le journal courant est intégré au projet
+        if (!autosave || fileName != projectPath) {
+            autosave.reset();
+            autosave = std::make_unique<HydraulicCalc::ProjectAutosave>(fileName.toStdString(), 0);
+            projectPath = fileName;
+        }
+        autosave->update(history.current(), projectParameters());
+        autosave->save();
+
+        QMessageBox::information(this, "Projet enregistré",
+            "Le projet a été enregistré :\n" + projectPath +
+            "\n\nLes modifications suivantes seront enregistrées automatiquement.");
+    }
+    catch (const std::exception& e) {
+        QMessageBox::critical(this, "Erreur d'enregistrement",
+                            QString("L'enregistrement du projet a échoué :\n\n%1").arg(e.what()));
+    }
+}
+
+void HydraulicCalculationsWindow::onOpenProject()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "Ouvrir un projet", "", "Projet hydraulique (*.tchp)");
+    if (fileName.isEmpty()) return;
+
+    // Modifications en attente du projet courant écrites avant lecture (le fichier peut être le même)
+    autosave.reset();
+    projectPath.clear();
+
+    try {
+        size_t replayedEdits = 0;
+        HydraulicCalc::ProjectData project = HydraulicCalc::ProjectAutosave::load(fileName.toStdString(), &replayedEdits);
+
+        // ÉTAPE 1: Schéma courant abandonné
+        schemaView->clearAllSegments();
+        networkSegments.clear();
+        history.clear();
+        currentSelectedSegment = nullptr;
+        currentSelectedFixture = nullptr;
+        editButton->setEnabled(false);
+        deleteButton->setEnabled(false);
+        hasCombinedResults = false;
+        loopBalancing = HydraulicCalc::LoopBalancingResult();
+
+        applyProjectParameters(project.parameters);
+
+        // ÉTAPE 2: Données puis schéma, dans l'ordre du fichier
+        restoringHistory = true;
+        networkSegments.reserve(project.segments.size());
+        for (const auto& snapshot : project.segments) {
+            networkSegments.push_back(snapshot.segment);
+        }
+        HydraulicCalc::NetworkState state;
+        for (auto& snapshot : project.segments) {
+            buildSegmentGraphics(snapshot, project.hasResults);
+            std::string id = snapshot.segment.id;
+            state.segments = state.segments.set(id, std::make_shared<const HydraulicCalc::SegmentSnapshot>(std::move(snapshot)));
+        }
+        restoringHistory = false;
+
+        // ÉTAPE 3: Résultats enregistrés : chemin critique et sensibilités recalculés (coût d'un parcours)
+        hasCalculated = project.hasResults;
+        if (hasCalculated) {
+            HydraulicCalc::NetworkCalculationParameters calculated = projectParameters();
+            calculated.segments = networkSegments;
+            criticalPath = HydraulicCalc::CriticalPathAnalyzer().analyze(calculated);
+            sensitivity = HydraulicCalc::SensitivityAnalyzer().analyze(calculated,
+                criticalPath.empty() ? std::string() : criticalPath.critical().segmentId);
+
+            // Réglages des robinets d'équilibrage non enregistrés : recalculés sur les résultats lus
+            if (calculated.networkType == HydraulicCalc::NetworkType::HotWaterWithLoop) {
+                try {
+                    balanceLoop(calculated);
+                } catch (const std::exception&) {
+                    loopBalancing = HydraulicCalc::LoopBalancingResult();
+                }
+            }
+
+            auto calculation = std::make_shared<HydraulicCalc::CalculationSnapshot>();
+            calculation->criticalPath = criticalPath;
+            calculation->sensitivity = sensitivity;
+            calculation->loopBalancing = loopBalancing;
+            state.calculation = calculation;
+        }
+        exportButton->setEnabled(hasCalculated);
+
+        history.amend(state);
+        updateHistoryButtons();
+
+        projectPath = fileName;
+        autosave = std::make_unique<HydraulicCalc::ProjectAutosave>(fileName.toStdString(), project.journalSequence);
+
+        // Journal non vide : la session précédente s'est arrêtée brutalement (une fermeture normale
+        // l'intègre au projet). Les modifications récupérées sont intégrées tout de suite.
+        if (replayedEdits > 0) {
+            QString recovered = QString("%1 modification(s) non enregistrée(s) de la session précédente ont été récupérées.")
+                                    .arg(static_cast<qulonglong>(replayedEdits));
+            try {
+                autosave->update(history.current(), projectParameters());
+                autosave->save();
+            } catch (const std::exception& e) {
+                recovered += QString("\n\nElles n'ont pas pu être intégrées au projet :\n%1").arg(e.what());
+            }
+            QMessageBox::information(this, "Projet récupéré", recovered);
+        }
+    }
+    catch (const std::exception& e) {
+        restoringHistory = false;
+        QMessageBox::critical(this, "Erreur d'ouverture",
+                            QString("L'ouverture du projet a échoué :\n\n%1").arg(e.what()));
+    }
+}
+
+void HydraulicCalculationsWindow::restoreState(const HydraulicCalc::NetworkState& from, const HydraulicCalc::NetworkState& to)
+{
+    restoringHistory = true;
+
+    currentSelectedSegment = nullptr;
+    currentSelectedFixture = nullptr;
+    editButton->setEnabled(false);
+    deleteButton->setEnabled(false);
+
+    // Seuls les tronçons dont l'entrée diffère entre les deux états sont reconstruits
+    std::vector<std::shared_ptr<const HydraulicCalc::SegmentSnapshot>> rebuilt;
+    std::vector<std::string> changedIds;
+    from.segments.diff(to.segments, [&](const std::string& id,
+                                        const std::shared_ptr<const HydraulicCalc::SegmentSnapshot>&,
+                                        const std::shared_ptr<const HydraulicCalc::SegmentSnapshot>& after) {
+        changedIds.push_back(id);
+        if (GraphicPipeSegment* graphicSegment = findGraphicSegment(id)) {
+            schemaView->removeSegment(graphicSegment);
+        }
+
+        auto it = std::find_if(networkSegments.begin(), networkSegments.end(),
+                               [&id](const HydraulicCalc::NetworkSegment& segment) { return segment.id == id; });
+        if (!after) {
+            if (it != networkSegments.end()) {
+                networkSegments.erase(it);
+            }
+            return;
+        }
+        if (it != networkSegments.end()) {
+            *it = after->segment;
+        } else {
+            networkSegments.push_back(after->segment);
+        }
+        rebuilt.push_back(after);
+    });
+
+    for (const auto& snapshot : rebuilt) {
+        buildSegmentGraphics(*snapshot, to.calculated());
+    }
+
+    // Résultats globaux de l'état restauré : aucun recalcul
+    hasCalculated = to.calculated();
+    if (to.calculation) {
+        loopBalancing = to.calculation->loopBalancing;
+        criticalPath = to.calculation->criticalPath;
+        sensitivity = to.calculation->sensitivity;
+        hasCombinedResults = to.calculation->hasCombinedResults;
+        if (hasCombinedResults) {
+            combinedResults = to.calculation->combinedResults;
+            combinedCriticalPaths = to.calculation->combinedCriticalPaths;
+            combinedSensitivities = to.calculation->combinedSensitivities;
+        }
+    }
+    exportButton->setEnabled(hasCalculated);
+
+    // Annuler / rétablir est une modification comme une autre pour le journal du projet
+    if (autosave && !changedIds.empty()) {
+        autosave->record(to, projectParameters(), changedIds);
+    }
+
+    restoringHistory = false;
+    updateHistoryButtons();
+}
+
+GraphicPipeSegment* HydraulicCalculationsWindow::buildSegmentGraphics(const HydraulicCalc::SegmentSnapshot& snapshot, bool withResults)
+{
+    HydraulicCalc::NetworkSegment* segmentData = findSegmentById(snapshot.segment.id);
+    GraphicPipeSegment* graphicSegment = schemaView->addSegment(segmentData,
+        QPointF(snapshot.start.x, snapshot.start.y), QPointF(snapshot.end.x, snapshot.end.y));
+    if (!graphicSegment) return nullptr;
+
+    for (size_t i = 0; i < snapshot.segment.fixtures.size() && i < snapshot.fixturePositions.size(); ++i) {
+        const auto& fixture = snapshot.segment.fixtures[i];
+        FixturePoint* fixturePoint = new FixturePoint(fixture.type, fixture.quantity);
+        fixturePoint->setPositionOnSegment(QPointF(snapshot.fixturePositions[i].x, snapshot.fixturePositions[i].y));
+        schemaView->getScene()->addItem(fixturePoint);
+        graphicSegment->addFixturePoint(fixturePoint);
+    }
+
+    graphicSegment->updateDisplay(segmentData);
+    if (withResults) {
+        graphicSegment->updateResultsDisplay(segmentData);
+    }
+    return graphicSegment;
+}
+
+void HydraulicCalculationsWindow::updateHistoryButtons()
+{
+    undoButton->setEnabled(history.canUndo());
+    redoButton->setEnabled(history.canRedo());
+    undoButton->setToolTip(history.canUndo() ? "Annuler : " + QString::fromStdString(history.undoLabel()) : QString());
+    redoButton->setToolTip(history.canRedo() ? "Rétablir : " + QString::fromStdString(history.redoLabel()) : QString());
+}
+
+void HydraulicCalculationsWindow::onUndo()
+{
+    if (!history.canUndo()) return;
+    HydraulicCalc::NetworkState from = history.current();
+    restoreState(from, history.undo());
+}
+
+void HydraulicCalculationsWindow::onRedo()
+{
+    if (!history.canRedo()) return;
+    HydraulicCalc::NetworkState from = history.current();
+    restoreState(from, history.redo());
+}
+
 // ===== SLOTS =====
 
 void HydraulicCalculationsWindow::onNetworkTypeChanged(int index)
 {
-    loopParametersGroup->setVisible(index == 2); // ECS avec bouclage
+    // ECS avec bouclage, ou calcul combiné (qui comprend le réseau bouclé)
+    loopParametersGroup->setVisible(index == 2 || combinedCalculationCheck->isChecked());
+
+    // Calcul combiné à jour : afficher les résultats du réseau choisi sans recalculer
+    if (hasCalculated && hasCombinedResults && index >= 0) {
+        criticalPath = combinedCriticalPaths[static_cast<size_t>(index)];
+        sensitivity = combinedSensitivities[static_cast<size_t>(index)];
+        applyNetworkResults(combinedResults.networks[static_cast<size_t>(index)]);
+        schemaView->updateSegmentResults([this](const std::string& id) {
+            return this->findSegmentById(id);
+        });
+    }
+}
+
+void HydraulicCalculationsWindow::onCalculationInputChanged()
+{
+    // Résultats combinés obtenus avec d'autres paramètres : plus réaffichés au changement de réseau
+    hasCombinedResults = false;
+    combinedResults = HydraulicCalc::MultiNetworkResult();
 }
 
 void HydraulicCalculationsWindow::onSelectModeActivated()
@@ -791,6 +1297,7 @@ void HydraulicCalculationsWindow::onSegmentDrawingComplete(const QPointF& start,
                 graphicSegment->updateDisplay(segData);
             }
         }
+        recordEdit({newSegment.id}, "Ajout de tronçon");
 
         // Retourner en mode sélection
         onSelectModeActivated();
@@ -819,6 +1326,8 @@ void HydraulicCalculationsWindow::onAddFixtureModeActivated(HydraulicCalc::Fixtu
 
 void HydraulicCalculationsWindow::onSegmentAdded(GraphicPipeSegment* segment)
 {
+    if (restoringHistory) return;
+
     hasCalculated = false;
     exportButton->setEnabled(false);
 }
@@ -833,6 +1342,9 @@ void HydraulicCalculationsWindow::onSegmentSelected(GraphicPipeSegment* segment)
 
 void HydraulicCalculationsWindow::onSegmentRemoved(GraphicPipeSegment* segment)
 {
+    // Restauration de l'historique : les données sont mises à jour par restoreState()
+    if (restoringHistory) return;
+
     // Retirer des données par ID au lieu de comparer les pointeurs
     std::string segmentId = segment->getSegmentId();
     for (auto it = networkSegments.begin(); it != networkSegments.end(); ++it) {
@@ -847,6 +1359,7 @@ void HydraulicCalculationsWindow::onSegmentRemoved(GraphicPipeSegment* segment)
     deleteButton->setEnabled(false);
     hasCalculated = false;
     exportButton->setEnabled(false);
+    recordEdit({segmentId}, "Suppression de tronçon");
 }
 
 void HydraulicCalculationsWindow::onEditSelectedSegment()
@@ -888,6 +1401,7 @@ void HydraulicCalculationsWindow::onEditSelectedSegment()
             }
             hasCalculated = false;
             exportButton->setEnabled(false);
+            recordEdit({segmentCopy.id}, "Modification de tronçon");
         }
     }
 }
@@ -912,6 +1426,7 @@ void HydraulicCalculationsWindow::onFixtureAdded(FixturePoint* fixture, GraphicP
 {
     hasCalculated = false;
     exportButton->setEnabled(false);
+    recordEdit({segment->getSegmentId()}, "Ajout d'appareil");
 }
 
 void HydraulicCalculationsWindow::onFixtureSelected(FixturePoint* fixture)
@@ -922,13 +1437,16 @@ void HydraulicCalculationsWindow::onFixtureSelected(FixturePoint* fixture)
     deleteButton->setEnabled(true);
 }
 
-void HydraulicCalculationsWindow::onFixtureRemoved(FixturePoint* fixture)
+void HydraulicCalculationsWindow::onFixtureRemoved(FixturePoint* fixture, GraphicPipeSegment* segment)
 {
     currentSelectedFixture = nullptr;
     editButton->setEnabled(false);
     deleteButton->setEnabled(false);
     hasCalculated = false;
     exportButton->setEnabled(false);
+    if (segment) {
+        recordEdit({segment->getSegmentId()}, "Suppression d'appareil");
+    }
 }
 
 void HydraulicCalculationsWindow::onEditSelectedFixture()
@@ -942,6 +1460,9 @@ void HydraulicCalculationsWindow::onEditSelectedFixture()
         currentSelectedFixture->updateDisplay();
         hasCalculated = false;
         exportButton->setEnabled(false);
+        if (GraphicPipeSegment* owner = findFixtureOwner(currentSelectedFixture)) {
+            recordEdit({owner->getSegmentId()}, "Modification d'appareil");
+        }
     }
 }
 
@@ -953,6 +1474,7 @@ void HydraulicCalculationsWindow::onDeleteSelectedFixture()
     }
 
     // Supprimer la fixture
+    GraphicPipeSegment* owner = findFixtureOwner(currentSelectedFixture);
     for (auto* segment : schemaView->getSegments()) {
         segment->removeFixturePoint(currentSelectedFixture);
     }
@@ -962,6 +1484,9 @@ void HydraulicCalculationsWindow::onDeleteSelectedFixture()
     currentSelectedFixture = nullptr;
     editButton->setEnabled(false);
     deleteButton->setEnabled(false);
+    if (owner) {
+        recordEdit({owner->getSegmentId()}, "Suppression d'appareil");
+    }
 }
 
 void HydraulicCalculationsWindow::onCalculate()
@@ -986,8 +1511,12 @@ void HydraulicCalculationsWindow::onCalculate()
         hasCalculated = true;
         exportButton->setEnabled(true);
 
+        // Résultats enregistrés dans l'état courant : annuler puis rétablir les restitue sans recalcul
+        recordCalculation();
+
         QMessageBox::information(this, "Calcul terminé",
-                               "Les résultats sont affichés sur le schéma.");
+                               "Les résultats sont affichés sur le schéma." + criticalPathSummary() +
+                               sensitivitySummary());
     }
     catch (const std::exception& e) {
         // Afficher le message d'erreur exact sans ajouter de texte générique
@@ -1012,6 +1541,7 @@ void HydraulicCalculationsWindow::performCalculations()
         HydraulicCalc::NetworkCalculationParameters networkParams;
         networkParams.networkType = static_cast<HydraulicCalc::NetworkType>(networkTypeCombo->currentIndex());
         networkParams.material = static_cast<HydraulicCalc::PipeMaterial>(materialCombo->currentIndex());
+        networkParams.frictionModel = static_cast<HydraulicCalc::FrictionModel>(frictionModelCombo->currentIndex());
         networkParams.supplyPressure = supplyPressureSpin->value();
         networkParams.requiredPressure = requiredPressureSpin->value();
 
@@ -1071,7 +1601,13 @@ void HydraulicCalculationsWindow::performCalculations()
             }
         }
 
-        // Paramètres bouclage si nécessaire
+        // Paramètres bouclage si nécessaire (calcul combiné : le réseau bouclé en fait partie)
+        const bool combined = combinedCalculationCheck->isChecked();
+        if (combined) {
+            networkParams.waterTemperature = waterTempSpin->value();
+            networkParams.ambientTemperature = ambientTempSpin->value();
+            networkParams.insulationThickness = insulationSpin->value();
+        }
         if (networkTypeCombo->currentIndex() == 2) {
             // loopLength est auto-calculée dans calculateNetwork() comme somme des longueurs de segments
             networkParams.waterTemperature = waterTempSpin->value();
@@ -1089,22 +1625,75 @@ void HydraulicCalculationsWindow::performCalculations()
             }
         }
 
-        // Calcul avec protection
-        calculator.calculateNetwork(networkParams);
-
-        // Copier les résultats dans les segments existants par ID
-        // NE PAS remplacer le vecteur ! Les segments graphiques ont des pointeurs vers ces segments
-        for (const auto& calculatedSeg : networkParams.segments) {
-            for (auto& seg : networkSegments) {
-                if (seg.id == calculatedSeg.id) {
-                    // Copier uniquement les résultats du calcul (pas tout le segment)
-                    seg.result = calculatedSeg.result;
-                    seg.inletPressure = calculatedSeg.inletPressure;
-                    seg.outletPressure = calculatedSeg.outletPressure;
-                    break;
+        // Réseau effectivement calculé : l'original, ou sa version réduite si des chaînes en série
+        // peuvent être fusionnées (les résultats sont ensuite reportés sur les tronçons d'origine)
+        std::unique_ptr<HydraulicCalc::NetworkReduction> reduction;
+        if (seriesReductionCheck->isChecked()) {
+            reduction = std::make_unique<HydraulicCalc::NetworkReduction>(networkParams);
+            if (!reduction->reducesNetwork()) {
+                reduction.reset();
+            }
+        }
+        HydraulicCalc::NetworkCalculationParameters& solvedParams =
+            reduction ? reduction->reducedParameters() : networkParams;
+
+        if (combined) {
+            // Calcul combiné : les trois types de réseau en un passage, conservés pour basculer
+            // de l'un à l'autre sans recalcul (voir onNetworkTypeChanged)
+            combinedResults = calculator.calculateAllNetworks(solvedParams);
+            balanceLoop(combinedResults.get(HydraulicCalc::NetworkType::HotWaterWithLoop));
+
+            for (size_t type = 0; type < HydraulicCalc::NetworkTypeCount; ++type) {
+                auto& network = combinedResults.networks[type];
+                if (reduction) {
+                    HydraulicCalc::NetworkCalculationParameters expanded = networkParams;
+                    expanded.networkType = network.networkType;
+                    for (auto& seg : expanded.segments) {
+                        seg.hasReturnLine = (network.networkType == HydraulicCalc::NetworkType::HotWaterWithLoop);
+                    }
+                    reduction->expand(network, expanded);
+                    network = std::move(expanded);
                 }
+                combinedCriticalPaths[type] = HydraulicCalc::CriticalPathAnalyzer().analyze(network);
+                combinedSensitivities[type] = HydraulicCalc::SensitivityAnalyzer().analyze(network,
+                    combinedCriticalPaths[type].empty() ? std::string() : combinedCriticalPaths[type].critical().segmentId);
+            }
+            if (reduction) {
+                reduction->expand(loopBalancing);
             }
+            hasCombinedResults = true;
+
+            const size_t selected = static_cast<size_t>(networkTypeCombo->currentIndex());
+            criticalPath = combinedCriticalPaths[selected];
+            sensitivity = combinedSensitivities[selected];
+            applyNetworkResults(combinedResults.networks[selected]);
+            return;
+        }
+        hasCombinedResults = false;
+
+        // Calcul avec protection
+        calculator.calculateNetwork(solvedParams);
+
+        // Équilibrage du bouclage : le résultat précédent sert de point de départ
+        if (solvedParams.networkType == HydraulicCalc::NetworkType::HotWaterWithLoop) {
+            balanceLoop(solvedParams);
+        } else {
+            loopBalancing = HydraulicCalc::LoopBalancingResult();
         }
+
+        if (reduction) {
+            reduction->expand(networkParams);
+            reduction->expand(loopBalancing);
+        }
+
+        // Chemin critique et temps d'attente aux appareils (sur les résultats déjà calculés)
+        criticalPath = HydraulicCalc::CriticalPathAnalyzer().analyze(networkParams);
+
+        // Sensibilités de la pression à l'appareil le plus défavorisé (même point terminal)
+        sensitivity = HydraulicCalc::SensitivityAnalyzer().analyze(networkParams,
+            criticalPath.empty() ? std::string() : criticalPath.critical().segmentId);
+
+        applyNetworkResults(networkParams);
     }
     catch (const std::bad_alloc& e) {
         throw std::runtime_error("Erreur d'allocation mémoire lors du calcul. Vérifiez que les données sont correctes.");
@@ -1117,6 +1706,108 @@ void HydraulicCalculationsWindow::performCalculations()
     }
 }
 
+void HydraulicCalculationsWindow::balanceLoop(const HydraulicCalc::NetworkCalculationParameters& loopNetwork)
+{
+    // Le résultat précédent sert de point de départ
+    // (vannes repérées par l'identifiant des feuilles, conservé par la réduction en série)
+    loopBalancing = loopBalancer.balance(loopNetwork, HydraulicCalc::LoopBalancingOptions(),
+                                         loopBalancing.empty() ? nullptr : &loopBalancing);
+}
+
+void HydraulicCalculationsWindow::applyNetworkResults(const HydraulicCalc::NetworkCalculationParameters& calculated)
+{
+    // Copier les résultats dans les segments existants par ID
+    // NE PAS remplacer le vecteur ! Les segments graphiques ont des pointeurs vers ces segments
+    for (const auto& calculatedSeg : calculated.segments) {
+        for (auto& seg : networkSegments) {
+            if (seg.id == calculatedSeg.id) {
+                // Copier uniquement les résultats du calcul (pas tout le segment)
+                seg.result = calculatedSeg.result;
+                seg.inletPressure = calculatedSeg.inletPressure;
+                seg.outletPressure = calculatedSeg.outletPressure;
+                break;
+            }
+        }
+    }
+}
+
+QString HydraulicCalculationsWindow::criticalPathSummary() const
+{
+    if (criticalPath.empty()) {
+        return QString();
+    }
+
+    const auto& worst = criticalPath.critical();
+    const auto* segment = findSegmentById(worst.segmentId);
+    QString summary = QString("\n\nAppareil le plus défavorisé : %1 (%2), %3 bar disponibles (marge %4 bar).")
+        .arg(QString::fromStdString(HydraulicCalc::PipeCalculator::getFixtureName(worst.type)))
+        .arg(QString::fromStdString(segment ? segment->name : worst.segmentId))
+        .arg(worst.pressure, 0, 'f', 2)
+        .arg(worst.pressureMargin, 0, 'f', 2);
+
+    if (criticalPath.insufficientCount > 0) {
+        summary += QString("\n⚠️ %1 appareil(s) sous la pression requise.").arg(criticalPath.insufficientCount);
+    }
+
+    if (networkTypeCombo->currentIndex() != 0) {
+        const auto& longest = criticalPath.fixtures[criticalPath.longestWaitFixture];
+        summary += QString("\nAttente ECS la plus longue : %1 s (%2 L à tirer).")
+            .arg(longest.waitTime, 0, 'f', 1)
+            .arg(longest.hotWaterVolume, 0, 'f', 2);
+    }
+    return summary;
+}
+
+QString HydraulicCalculationsWindow::describeDesignChange(const HydraulicCalc::DesignChange& change) const
+{
+    const auto* segment = findSegmentById(change.segmentId);
+    QString name = QString::fromStdString(segment ? segment->name : change.segmentId);
+
+    switch (change.kind) {
+        case HydraulicCalc::DesignChangeKind::LargerDiameter: {
+            int nextDiameter = 0;
+            for (const auto& entry : sensitivity.segments) {
+                if (entry.segmentId == change.segmentId) {
+                    nextDiameter = entry.nextNominalDiameter;
+                    break;
+                }
+            }
+            return QString("%1 : passer en DN%2 (+%3 bar)").arg(name).arg(nextDiameter).arg(change.gain, 0, 'f', 2);
+        }
+        case HydraulicCalc::DesignChangeKind::ShorterLength:
+            return QString("%1 : raccourcir de %2 m (+%3 bar)").arg(name).arg(change.step, 0, 'f', 1).arg(change.gain, 0, 'f', 2);
+        case HydraulicCalc::DesignChangeKind::LowerHeight:
+            return QString("%1 : réduire la montée de %2 m (+%3 bar)").arg(name).arg(change.step, 0, 'f', 1).arg(change.gain, 0, 'f', 2);
+        case HydraulicCalc::DesignChangeKind::ThickerInsulation:
+            return QString("%1 : +%2 mm d'isolant (+%3 °C au retour)").arg(name).arg(change.step, 0, 'f', 0).arg(change.gain, 0, 'f', 2);
+    }
+    return name;
+}
+
+QString HydraulicCalculationsWindow::sensitivitySummary() const
+{
+    // Leviers proposés seulement quand un critère n'est pas tenu
+    const int shown = 3;
+    QString summary;
+
+    if (criticalPath.insufficientCount > 0 && !sensitivity.pressureChanges.empty()) {
+        summary += "\n\nModifications les plus efficaces sur la pression (estimation au premier ordre) :";
+        for (int i = 0; i < shown && i < static_cast<int>(sensitivity.pressureChanges.size()); ++i) {
+            summary += "\n• " + describeDesignChange(sensitivity.pressureChanges[static_cast<size_t>(i)]);
+        }
+    }
+
+    const double minReturnTemperature = waterTempSpin->value() - HydraulicCalc::PipeCalculator::LoopTemperatureDrop;
+    if (networkTypeCombo->currentIndex() == 2 && !sensitivity.temperatureChanges.empty()
+        && sensitivity.returnTemperature < minReturnTemperature) {
+        summary += "\n\nIsolation la plus efficace sur la température de retour :";
+        for (int i = 0; i < shown && i < static_cast<int>(sensitivity.temperatureChanges.size()); ++i) {
+            summary += "\n• " + describeDesignChange(sensitivity.temperatureChanges[static_cast<size_t>(i)]);
+        }
+    }
+    return summary;
+}
+
 void HydraulicCalculationsWindow::updateNetworkSegmentsData()
 {
     // Mettre à jour les fixtures de chaque segment à partir des FixturePoint graphiques
@@ -1199,6 +1890,109 @@ void HydraulicCalculationsWindow::onExportPDF()
         "Le schéma a été exporté:\n" + fileName);
 }
 
+void HydraulicCalculationsWindow::onLoadPipeCatalogue()
+{
+    QString fileName = QFileDialog::getOpenFileName(this,
+        "Charger un catalogue de tubes", "", "Catalogue CSV (*.csv *.txt)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    try {
+        auto names = HydraulicCalc::PipeCatalogue::instance().loadFromFile(fileName.toStdString());
+
+        QStringList loaded;
+        for (const auto& name : names) {
+            loaded << QString::fromStdString(name);
+        }
+        pipeCatalogueButton->setToolTip("Séries chargées : " + loaded.join(", "));
+
+        // Les DN retenus dépendent de la série : le calcul précédent n'est plus valable
+        hasCalculated = false;
+        onCalculationInputChanged();
+        QMessageBox::information(this, "Catalogue de tubes",
+            "Séries chargées (actives pour leur matériau) :\n" + loaded.join("\n"));
+    }
+    catch (const std::exception& e) {
+        QMessageBox::critical(this, "Erreur", QString("Erreur lors du chargement du catalogue : %1").arg(e.what()));
+    }
+}
+
+void HydraulicCalculationsWindow::onWaterHammerAnalysis()
+{
+    if (!hasCalculated) {
+        QMessageBox::warning(this, "Attention", "Effectuez d'abord un calcul avant l'analyse du coup de bélier.");
+        return;
+    }
+
+    // Le régime permanent calculé sert d'état initial
+    HydraulicCalc::NetworkCalculationParameters networkParams;
+    networkParams.networkType = static_cast<HydraulicCalc::NetworkType>(networkTypeCombo->currentIndex());
+    networkParams.material = static_cast<HydraulicCalc::PipeMaterial>(materialCombo->currentIndex());
+    networkParams.supplyPressure = supplyPressureSpin->value();
+    networkParams.requiredPressure = requiredPressureSpin->value();
+    networkParams.segments = networkSegments;
+
+    std::vector<HydraulicCalc::ValveClosureEvent> events =
+        HydraulicCalc::WaterHammerSolver::buildFastClosureEvents(networkParams);
+    if (events.empty()) {
+        QMessageBox::information(this, "Coup de bélier",
+            "Aucun appareil à fermeture rapide (robinet de chasse, électrovanne) sur le schéma.");
+        return;
+    }
+
+    HydraulicCalc::TransientResult transient;
+    try {
+        HydraulicCalc::WaterHammerSolver solver;
+        transient = solver.solve(networkParams, events);
+    }
+    catch (const std::exception& e) {
+        QMessageBox::critical(this, "Erreur de calcul",
+                            QString("L'analyse du coup de bélier a échoué :\n\n%1").arg(e.what()));
+        return;
+    }
+
+    // Classer les tronçons par pression maximale décroissante
+    std::vector<const HydraulicCalc::SegmentPressureEnvelope*> ranking;
+    for (const auto& envelope : transient.envelopes) {
+        ranking.push_back(&envelope);
+    }
+    std::sort(ranking.begin(), ranking.end(),
+        [](const HydraulicCalc::SegmentPressureEnvelope* a, const HydraulicCalc::SegmentPressureEnvelope* b) {
+            return a->maxPressure > b->maxPressure;
+        });
+
+    QString message = QString("Fermeture simultanée de %1 appareil(s) à fermeture rapide.\n\n").arg(events.size());
+    message += QString("Pression maximale : %1 bar\n").arg(transient.maxPressure, 0, 'f', 1);
+    message += QString("Pression minimale : %1 bar\n\n").arg(transient.minPressure, 0, 'f', 1);
+    message += "Tronçons les plus sollicités :\n";
+    for (size_t i = 0; i < ranking.size() && i < 5; ++i) {
+        const HydraulicCalc::NetworkSegment* segment = findSegmentById(ranking[i]->segmentId);
+        QString name = segment ? QString::fromStdString(segment->name) : QString::fromStdString(ranking[i]->segmentId);
+        message += QString("  • %1 : %2 bar max (+%3 bar), %4 bar min%5\n")
+            .arg(name)
+            .arg(ranking[i]->maxPressure, 0, 'f', 1)
+            .arg(ranking[i]->maxSurge, 0, 'f', 1)
+            .arg(ranking[i]->minPressure, 0, 'f', 1)
+            .arg(ranking[i]->cavitationRisk ? " - risque de cavitation" : "");
+    }
+    message += QString("\nSimulation : %1 s, pas %2 ms, %3 nœuds, %4 ms de calcul, célérités ajustées de %5 % au plus, Courant ≥ %6.")
+        .arg(transient.duration, 0, 'f', 2)
+        .arg(transient.timeStep * 1000.0, 0, 'f', 3)
+        .arg(transient.totalNodes)
+        .arg(transient.computeTimeMs, 0, 'f', 0)
+        .arg(transient.maxWaveSpeedAdjustment * 100.0, 0, 'f', 1)
+        .arg(transient.minCourant, 0, 'f', 2);
+
+    // PN10 : pression de service usuelle des réseaux sanitaires
+    if (transient.maxPressure > 10.0) {
+        message += "\n\n⚠️ La pression dépasse 10 bar : prévoir un anti-bélier ou des fermetures plus lentes.";
+        QMessageBox::warning(this, "Coup de bélier", message);
+    } else {
+        QMessageBox::information(this, "Coup de bélier", message);
+    }
+}
+
 QString HydraulicCalculationsWindow::generatePDFHtml()
 {
     QString html = "<html><head><style>"
@@ -1223,6 +2017,7 @@ QString HydraulicCalculationsWindow::generatePDFHtml()
     html += "<tr><th>Paramètre</th><th>Valeur</th></tr>";
     html += "<tr><td>Type de réseau</td><td>" + networkTypeCombo->currentText() + "</td></tr>";
     html += "<tr><td>Matériau</td><td>" + materialCombo->currentText() + "</td></tr>";
+    html += "<tr><td>Calcul de λ</td><td>" + frictionModelCombo->currentText() + "</td></tr>";
     html += "<tr><td>Pression d'alimentation</td><td>" + QString::number(supplyPressureSpin->value(), 'f', 1) + " bar</td></tr>";
     html += "<tr><td>Pression requise</td><td>" + QString::number(requiredPressureSpin->value(), 'f', 1) + " bar</td></tr>";
     html += "<tr><td>Nombre de tronçons</td><td>" + QString::number(networkSegments.size()) + "</td></tr>";
@@ -1247,6 +2042,133 @@ QString HydraulicCalculationsWindow::generatePDFHtml()
         html += "</table>";
     }
 
+    // Équilibrage du bouclage
+    if (networkTypeCombo->currentIndex() == 2 && !loopBalancing.empty()) {
+        html += "<h2>Équilibrage du bouclage</h2>";
+        html += "<table>";
+        html += "<tr><th>Paramètre</th><th>Valeur</th></tr>";
+        html += "<tr class='result'><td><strong>Débit circulateur</strong></td><td><strong>" +
+                QString::number(loopBalancing.pumpFlowRate * 60.0, 'f', 1) + " L/h = " +
+                QString::number(loopBalancing.pumpFlowRate * 0.06, 'f', 3) + " m³/h</strong></td></tr>";
+        html += "<tr class='result'><td><strong>Hauteur manométrique</strong></td><td><strong>" +
+                QString::number(loopBalancing.pumpHead, 'f', 2) + " mCE</strong></td></tr>";
+        html += "<tr><td>Température retour minimale obtenue</td><td>" +
+                QString::number(loopBalancing.minReturnTemperature, 'f', 2) + " °C (objectif ≥ " +
+                QString::number(loopBalancing.requiredReturnTemperature, 'f', 0) + " °C)</td></tr>";
+        const auto* critical = findSegmentById(loopBalancing.criticalSegmentId);
+        html += "<tr><td>Branche la plus défavorisée</td><td>" +
+                QString::fromStdString(critical ? critical->name : loopBalancing.criticalSegmentId) + "</td></tr>";
+        if (!loopBalancing.converged) {
+            html += "<tr style='background-color: #fff3cd;'><td colspan='2'><strong>⚠️ Attention:</strong> l'équilibrage n'a pas convergé en " +
+                    QString::number(loopBalancing.iterations) + " itérations</td></tr>";
+        }
+        if (loopBalancing.returnTemperatureLowered) {
+            html += "<tr style='background-color: #fff3cd;'><td colspan='2'><strong>⚠️ Attention:</strong> température de départ trop basse "
+                    "pour la consigne retour, équilibrage calculé pour un retour à " +
+                    QString::number(loopBalancing.requiredReturnTemperature, 'f', 0) + " °C</td></tr>";
+        }
+        if (loopBalancing.undersizedValveCount() > 0) {
+            html += "<tr style='background-color: #fff3cd;'><td colspan='2'><strong>⚠️ Attention:</strong> " +
+                    QString::number(loopBalancing.undersizedValveCount()) +
+                    " robinet(s) sous-dimensionné(s) (Kv > Kvs) : débit de la branche non atteint, prévoir un robinet plus gros</td></tr>";
+        }
+        html += "</table>";
+
+        html += "<table>";
+        html += "<tr><th>Branche</th><th>Débit (L/h)</th><th>ΔP circuit (mCE)</th><th>ΔP robinet (mCE)</th>"
+                "<th>Kv</th><th>Kvs</th><th>Préréglage</th><th>T retour (°C)</th></tr>";
+        for (const auto& valve : loopBalancing.valves) {
+            const auto* branch = findSegmentById(valve.segmentId);
+            html += "<tr><td>" + QString::fromStdString(branch ? branch->name : valve.segmentId) + "</td>"
+                    "<td>" + QString::number(valve.flowRate * 60.0, 'f', 1) + "</td>"
+                    "<td>" + QString::number(valve.pathPressureDrop, 'f', 2) + "</td>"
+                    "<td>" + QString::number(valve.valvePressureDrop, 'f', 2) + "</td>"
+                    "<td>" + QString::number(valve.kv, 'f', 3) + "</td>"
+                    "<td>" + QString::number(valve.kvs, 'f', 1) + "</td>"
+                    "<td>" + QString::number(valve.presetting * 100.0, 'f', 0) + " %" +
+                    (valve.undersized ? " ⚠️ sous-dimensionné" : "") + "</td>"
+                    "<td>" + QString::number(valve.returnTemperature, 'f', 1) + "</td></tr>";
+        }
+        html += "</table>";
+    }
+
+    // Chemin critique et appareils les plus défavorisés
+    if (!criticalPath.empty()) {
+        html += "<h2>Chemin critique</h2>";
+        QStringList pathNames;
+        for (const auto& id : criticalPath.criticalPath) {
+            const auto* segment = findSegmentById(id);
+            pathNames << QString::fromStdString(segment ? segment->name : id);
+        }
+        html += "<p>" + pathNames.join(" → ") + "</p>";
+        if (criticalPath.insufficientCount > 0) {
+            html += "<p style='background-color: #fff3cd;'><strong>⚠️ " + QString::number(criticalPath.insufficientCount) +
+                    " appareil(s) sous la pression requise</strong></p>";
+        }
+
+        const bool hotWater = networkTypeCombo->currentIndex() != 0;
+        html += "<table>";
+        html += "<tr><th>Appareil</th><th>Tronçon</th><th>Longueur (m)</th><th>Pertes cumulées (mCE)</th>"
+                "<th>Pression (bar)</th><th>Marge (bar)</th>";
+        if (hotWater) {
+            html += "<th>Volume (L)</th><th>Attente ECS (s)</th>";
+        }
+        html += "</tr>";
+        for (size_t index : criticalPath.worstFixtures) {
+            const auto& fixture = criticalPath.fixtures[index];
+            const auto* segment = findSegmentById(fixture.segmentId);
+            QString rowStyle = (fixture.pressureMargin < 0.0) ? " style='background-color: #fff3cd;'" : "";
+            html += "<tr" + rowStyle + "><td>" + QString::fromStdString(HydraulicCalc::PipeCalculator::getFixtureName(fixture.type)) +
+                    " ×" + QString::number(fixture.quantity) + "</td>"
+                    "<td>" + QString::fromStdString(segment ? segment->name : fixture.segmentId) + "</td>"
+                    "<td>" + QString::number(fixture.pathLength, 'f', 1) + "</td>"
+                    "<td>" + QString::number(fixture.pathPressureDrop, 'f', 2) + "</td>"
+                    "<td>" + QString::number(fixture.pressure, 'f', 2) + "</td>"
+                    "<td>" + QString::number(fixture.pressureMargin, 'f', 2) + "</td>";
+            if (hotWater) {
+                html += "<td>" + QString::number(fixture.hotWaterVolume, 'f', 2) + "</td>"
+                        "<td>" + QString::number(fixture.waitTime, 'f', 1) + "</td>";
+            }
+            html += "</tr>";
+        }
+        html += "</table>";
+
+        if (hotWater) {
+            const auto& longest = criticalPath.fixtures[criticalPath.longestWaitFixture];
+            const auto* segment = findSegmentById(longest.segmentId);
+            html += "<p>Attente ECS la plus longue : " +
+                    QString::fromStdString(HydraulicCalc::PipeCalculator::getFixtureName(longest.type)) + " (" +
+                    QString::fromStdString(segment ? segment->name : longest.segmentId) + "), " +
+                    QString::number(longest.waitTime, 'f', 1) + " s pour " +
+                    QString::number(longest.hotWaterVolume, 'f', 2) + " L" +
+                    (longest.waitTime > HydraulicCalc::CriticalPathAnalyzer::RecommendedWaitTime
+                        ? QString(" (au-delà de %1 s)").arg(HydraulicCalc::CriticalPathAnalyzer::RecommendedWaitTime, 0, 'f', 0)
+                        : QString()) + "</p>";
+        }
+    }
+
+    // Sensibilités : modifications classées par effet estimé
+    if (!sensitivity.pressureChanges.empty() || !sensitivity.temperatureChanges.empty()) {
+        html += "<h2>Leviers d'amélioration</h2>";
+        html += "<p>Estimation au premier ordre (dérivées au point calculé, débits et DN des autres tronçons inchangés).</p>";
+        if (!sensitivity.pressureChanges.empty()) {
+            html += "<table><tr><th>Pression au point le plus défavorisé (" +
+                    QString::number(sensitivity.terminalPressure, 'f', 2) + " bar)</th></tr>";
+            for (const auto& change : sensitivity.pressureChanges) {
+                html += "<tr><td>" + describeDesignChange(change) + "</td></tr>";
+            }
+            html += "</table>";
+        }
+        if (networkTypeCombo->currentIndex() == 2 && !sensitivity.temperatureChanges.empty()) {
+            html += "<table><tr><th>Température de retour (" +
+                    QString::number(sensitivity.returnTemperature, 'f', 1) + " °C)</th></tr>";
+            for (const auto& change : sensitivity.temperatureChanges) {
+                html += "<tr><td>" + describeDesignChange(change) + "</td></tr>";
+            }
+            html += "</table>";
+        }
+    }
+
     // Résultats par segment
     for (const auto& segment : networkSegments) {
         html += "<h2>Tronçon: " + QString::fromStdString(segment.name) + "</h2>";
@@ -1270,7 +2192,7 @@ QString HydraulicCalculationsWindow::generatePDFHtml()
                 html += "<tr>";
                 html += "<td>" + QString::fromStdString(HydraulicCalc::PipeCalculator::getFixtureName(fixture.type)) + "</td>";
                 html += "<td>" + QString::number(fixture.quantity) + "</td>";
-                html += "<td>" + QString::number(fixture.flowRate * 0.06, 'f', 2) + "</td>";
+                html += "<td>" + QString::number(fixture.unitFlowRate() * 0.06, 'f', 2) + "</td>";
                 html += "</tr>";
             }
             html += "</table>";
@@ -1348,7 +2270,8 @@ QString HydraulicCalculationsWindow::generatePDFHtml()
         html += "<tr><td>Coefficient de friction (λ)</td><td>" +
                 QString::number(segment.result.details.lambda, 'f', 4) + "</td></tr>";
         html += "<tr><td>Formule utilisée</td><td>" +
-                QString(segment.result.details.isLaminar ? "Poiseuille: λ = 64/Re" : "Swamee-Jain (approximation de Colebrook-White)") + "</td></tr>";
+                (segment.result.details.isLaminar ? QString("Poiseuille: λ = 64/Re")
+                    : QString::fromStdString(HydraulicCalc::FrictionFactor::getModelName(segment.result.details.frictionModel))) + "</td></tr>";
         html += "<tr><td>Perte linéaire (Darcy-Weisbach)</td><td>" +
                 QString::number(segment.result.details.linearPressureDrop, 'f', 3) + " mCE</td></tr>";
         html += "<tr><td>Perte singulière (20% de linéaire)</td><td>" +
@@ -1451,7 +2374,7 @@ QString HydraulicCalculationsWindow::generatePDFHtml()
             html += "</table>";
         }
 
-        html += "<p><strong>Recommandations:</strong> " + QString::fromStdString(segment.result.recommendation) + "</p>";
+        html += "<p><strong>Recommandations:</strong> " + QString::fromStdString(segment.result.diagnostics.formatRecommendation()) + "</p>";
     }
 
     html += "<div class='info'>";
@@ -1470,6 +2393,11 @@ void HydraulicCalculationsWindow::onClear()
         QMessageBox::Yes | QMessageBox::No);
 
     if (reply == QMessageBox::Yes) {
+        std::vector<std::string> clearedIds;
+        for (const auto& segment : networkSegments) {
+            clearedIds.push_back(segment.id);
+        }
+
         schemaView->clearAllSegments();
         networkSegments.clear();
         currentSelectedSegment = nullptr;
@@ -1478,6 +2406,7 @@ void HydraulicCalculationsWindow::onClear()
         exportButton->setEnabled(false);
         editButton->setEnabled(false);
         deleteButton->setEnabled(false);
+        recordEdit(clearedIds, "Effacement du schéma");
     }
 }
 
@@ -8,13 +8,21 @@
 #include <QLabel>
 #include <QComboBox>
 #include <QDoubleSpinBox>
+#include <QCheckBox>
 #include <QPushButton>
 #include <QToolButton>
 #include <QButtonGroup>
 #include <QScrollArea>
 #include <QEvent>
+#include <array>
+#include <memory>
 #include <vector>
 #include "PipeCalculator.h"
+#include "LoopBalancer.h"
+#include "CriticalPathAnalyzer.h"
+#include "SensitivityAnalyzer.h"
+#include "NetworkHistory.h"
+#include "ProjectAutosave.h"
 #include "HydraulicSchemaView.h"
 #include "GraphicPipeSegment.h"
 #include "FixturePoint.h"
@@ -51,6 +59,8 @@ protected:
 private slots:
     // Changements de paramètres
     void onNetworkTypeChanged(int index);
+    void onCalculationInputChanged();
+    void onLoadPipeCatalogue();
 
     // Modes d'interaction
     void onSelectModeActivated();
@@ -68,16 +78,25 @@ private slots:
     // Gestion des fixtures
     void onFixtureAdded(FixturePoint* fixture, GraphicPipeSegment* segment);
     void onFixtureSelected(FixturePoint* fixture);
-    void onFixtureRemoved(FixturePoint* fixture);
+    void onFixtureRemoved(FixturePoint* fixture, GraphicPipeSegment* segment);
     void onEditSelectedFixture();
     void onDeleteSelectedFixture();
 
+    // Historique
+    void onUndo();
+    void onRedo();
+
     // Actions principales
     void onCalculate();
     void onExportPDF();
+    void onWaterHammerAnalysis();
     void onClear();
     void onResetView();
 
+    // Projet
+    void onOpenProject();
+    void onSaveProject();
+
 private:
     void setupUi();
     void applyStyle();
@@ -92,14 +111,33 @@ private:
 
     // Calculs
     void performCalculations();
+    void balanceLoop(const HydraulicCalc::NetworkCalculationParameters& loopNetwork);
+    void applyNetworkResults(const HydraulicCalc::NetworkCalculationParameters& calculated);
     void updateNetworkSegmentsData();
 
     // Helpers pour rechercher les segments par ID (évite les pointeurs invalides)
     HydraulicCalc::NetworkSegment* findSegmentById(const std::string& id);
     const HydraulicCalc::NetworkSegment* findSegmentById(const std::string& id) const;
+    GraphicPipeSegment* findGraphicSegment(const std::string& id);
+    GraphicPipeSegment* findFixtureOwner(FixturePoint* fixture);
+
+    // Historique annuler / rétablir
+    std::shared_ptr<const HydraulicCalc::SegmentSnapshot> captureSegment(const std::string& id);
+    void recordEdit(const std::vector<std::string>& segmentIds, const QString& label);
+    void recordCalculation();
+    void restoreState(const HydraulicCalc::NetworkState& from, const HydraulicCalc::NetworkState& to);
+    void updateHistoryButtons();
+    GraphicPipeSegment* buildSegmentGraphics(const HydraulicCalc::SegmentSnapshot& snapshot, bool withResults);
+
+    // Projet
+    HydraulicCalc::NetworkCalculationParameters projectParameters() const;
+    void applyProjectParameters(const HydraulicCalc::NetworkCalculationParameters& parameters);
 
     // Export
     QString generatePDFHtml();
+    QString criticalPathSummary() const;
+    QString sensitivitySummary() const;
+    QString describeDesignChange(const HydraulicCalc::DesignChange& change) const;
 
     // Layout principal
     QHBoxLayout *mainLayout;
@@ -116,8 +154,12 @@ private:
     QGroupBox *parametersGroup;
     QComboBox *networkTypeCombo;
     QComboBox *materialCombo;
+    QPushButton *pipeCatalogueButton;
+    QComboBox *frictionModelCombo;
     QDoubleSpinBox *supplyPressureSpin;
     QDoubleSpinBox *requiredPressureSpin;
+    QCheckBox *seriesReductionCheck;
+    QCheckBox *combinedCalculationCheck;
 
     // Paramètres bouclage ECS
     QGroupBox *loopParametersGroup;
@@ -140,10 +182,15 @@ private:
     QGroupBox *editGroup;
     QPushButton *editButton;
     QPushButton *deleteButton;
+    QPushButton *undoButton;
+    QPushButton *redoButton;
 
     // Boutons d'action
+    QPushButton *openProjectButton;
+    QPushButton *saveProjectButton;
     QPushButton *calculateButton;
     QPushButton *exportButton;
+    QPushButton *waterHammerButton;
     QPushButton *resetViewButton;
     QPushButton *clearButton;
     QPushButton *closeButton;
@@ -151,12 +198,30 @@ private:
     // Données
     std::vector<HydraulicCalc::NetworkSegment> networkSegments;
     HydraulicCalc::PipeCalculator calculator;
+    HydraulicCalc::LoopBalancer loopBalancer;
+    HydraulicCalc::LoopBalancingResult loopBalancing;  // Réglages des robinets d'équilibrage (mode bouclage)
+    HydraulicCalc::CriticalPathResult criticalPath;    // Chemin critique et desserte des appareils
+    HydraulicCalc::SensitivityResult sensitivity;      // Dérivées au point terminal, leviers classés
+
+    // Calcul combiné : résultats des trois types de réseau, indexés par NetworkType
+    HydraulicCalc::MultiNetworkResult combinedResults;
+    std::array<HydraulicCalc::CriticalPathResult, HydraulicCalc::NetworkTypeCount> combinedCriticalPaths;
+    std::array<HydraulicCalc::SensitivityResult, HydraulicCalc::NetworkTypeCount> combinedSensitivities;
+    bool hasCombinedResults;
 
     // État
     GraphicPipeSegment* currentSelectedSegment;
     FixturePoint* currentSelectedFixture;
     bool hasCalculated;
 
+    // Historique : états à structure partagée (seuls les tronçons modifiés sont recopiés)
+    HydraulicCalc::NetworkHistory history;
+    bool restoringHistory;  // Restauration en cours : les signaux de la vue ne créent pas d'étape
+
+    // Projet enregistré : journal des modifications écrit en arrière-plan
+    QString projectPath;
+    std::unique_ptr<HydraulicCalc::ProjectAutosave> autosave;
+
     // Filtre pour bloquer la molette sur les spinbox
     SpinBoxWheelFilter* wheelFilter;
 };
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cmath>
+#include "Dual.h"
+
+namespace HydraulicCalc {
+
+// Formules élémentaires écrites une seule fois pour les double et les Dual<N>
+//
+// PipeCalculator, FrictionFactor et PipeCatalogue les appellent en double ; l'analyse de
+// sensibilité (SensitivityAnalyzer) les évalue en nombres duaux pour obtenir les dérivées
+// des mêmes formules. Les fonctions mathématiques sont appelées sans qualification pour
+// trouver std:: (double) ou les surcharges de Dual.h (ADL).
+namespace Kernels {
+
+constexpr double Pi = 3.14159265358979323846;
+constexpr double Gravity = 9.81;  // m/s²
+
+// Vitesse moyenne (m/s) d'un débit (L/min) dans un diamètre intérieur (mm) : V = Q / A
+template <class T>
+T velocity(const T& flowRate, const T& diameter) {
+    using std::pow;
+    T flowRateM3s = flowRate / 60000.0;          // L/min -> m³/s
+    T area = Pi * pow(diameter / 2000.0, 2.0);   // mm² -> m²
+    return flowRateM3s / area;
+}
+
+// Nombre de Reynolds Re = V·D/ν (vitesse m/s, diamètre mm, viscosité cinématique m²/s)
+template <class T>
+T reynolds(const T& velocity, const T& diameter, double kinematicViscosity) {
+    return (velocity * diameter / 1000.0) / kinematicViscosity;
+}
+
+// Approximation de Swamee-Jain (relativeRoughness = ε/D)
+template <class T>
+T swameeJain(const T& reynolds, const T& relativeRoughness) {
+    using std::log10;
+    using std::pow;
+    return 0.25 / pow(log10(relativeRoughness / 3.7 + 5.74 / pow(reynolds, 0.9)), 2.0);
+}
+
+// Colebrook-White : Newton sur x = 1/√λ, f(x) = x + 2·log10(a + b·x), a = ε/(3.7·D), b = 2.51/Re
+// En duaux, le point fixe de Newton donne aussi les dérivées de la solution implicite.
+template <class T>
+T colebrookWhite(const T& reynolds, const T& relativeRoughness, int* iterations = nullptr) {
+    using std::log;
+    using std::sqrt;
+    const T a = relativeRoughness / 3.7;
+    const T b = 2.51 / reynolds;
+    const double twoOverLn10 = 2.0 / std::log(10.0);
+
+    T x = 1.0 / sqrt(swameeJain(reynolds, relativeRoughness));
+    int count = 0;
+    for (; count < 20; ++count) {
+        T inner = a + b * x;
+        T f = x + twoOverLn10 * log(inner);
+        T df = 1.0 + twoOverLn10 * b / inner;
+        T step = f / df;
+        x -= step;
+        if (std::abs(valueOf(step)) < 1e-12 * valueOf(x)) {
+            ++count;
+            break;
+        }
+    }
+
+    if (iterations) {
+        *iterations = count;
+    }
+    return 1.0 / (x * x);
+}
+
+// Perte de charge linéaire de Darcy-Weisbach (mCE) : ΔP = λ · (L/D) · (ρV²/2)
+// (longueur m, diamètre mm, vitesse m/s, masse volumique kg/m³)
+template <class T>
+T darcyPressureDrop(const T& lambda, const T& length, const T& diameter, const T& velocity, double density) {
+    using std::pow;
+    T pressureDropPa = lambda * (length / (diameter / 1000.0)) * (density * pow(velocity, 2.0) / 2.0);
+    return pressureDropPa / (1000.0 * Gravity);  // Pa -> mCE
+}
+
+// Résistance thermique linéique de l'isolant (K/W par m) : R_isol = ln(r2/r1) / (2πλ)
+template <class T>
+T insulationResistance(const T& r1, const T& r2, double conductivity) {
+    using std::log;
+    return log(r2 / r1) / (2.0 * Pi * conductivity);
+}
+
+// Résistance thermique linéique d'échange extérieur (K/W par m) : R_ext = 1 / (h_ext × 2πr2)
+template <class T>
+T externalResistance(const T& r2, double exchangeCoefficient) {
+    return 1.0 / (exchangeCoefficient * 2.0 * Pi * r2);
+}
+
+} // namespace Kernels
+
+} // namespace HydraulicCalc
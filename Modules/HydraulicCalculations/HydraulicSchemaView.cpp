@@ -3,6 +3,7 @@
 #include <QKeyEvent>
 #include <QScrollBar>
 #include <QPainter>
+#include <algorithm>
 #include <cmath>
 
 HydraulicSchemaView::HydraulicSchemaView(QWidget* parent)
@@ -288,11 +289,16 @@ void HydraulicSchemaView::keyPressEvent(QKeyEvent* event)
         FixturePoint* selectedFixture = getSelectedFixture();
         if (selectedFixture) {
             // Retirer la fixture du segment parent
+            GraphicPipeSegment* owner = nullptr;
             for (auto* segment : segments) {
+                const auto& fixturePoints = segment->getFixturePoints();
+                if (std::find(fixturePoints.begin(), fixturePoints.end(), selectedFixture) != fixturePoints.end()) {
+                    owner = segment;
+                }
                 segment->removeFixturePoint(selectedFixture);
             }
             scene->removeItem(selectedFixture);
-            emit fixtureRemoved(selectedFixture);
+            emit fixtureRemoved(selectedFixture, owner);
             delete selectedFixture;
             return;
         }
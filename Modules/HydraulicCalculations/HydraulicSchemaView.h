@@ -61,7 +61,7 @@ signals:
     void segmentRemoved(GraphicPipeSegment* segment);
     void fixtureAdded(FixturePoint* fixture, GraphicPipeSegment* segment);
     void fixtureSelected(FixturePoint* fixture);
-    void fixtureRemoved(FixturePoint* fixture);
+    void fixtureRemoved(FixturePoint* fixture, GraphicPipeSegment* segment);
     void modeChanged(InteractionMode mode);
 
 protected:
@@ -0,0 +1,245 @@
+#include "LoopBalancer.h"
+#include "NetworkTree.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace HydraulicCalc {
+
+double LoopBalancer::getValveKvs(int returnNominalDiameter) {
+    // Robinets thermostatiques d'équilibrage usuels (DN15 / DN20 / DN25 / DN32)
+    if (returnNominalDiameter <= 16) return 1.6;
+    if (returnNominalDiameter <= 22) return 2.5;
+    if (returnNominalDiameter <= 28) return 4.0;
+    return 6.3;
+}
+
+LoopBalancingResult LoopBalancer::balance(const NetworkCalculationParameters& networkParams,
+                                          const LoopBalancingOptions& options,
+                                          const LoopBalancingResult* warmStart) {
+    LoopBalancingResult balancing;
+    const auto& segments = networkParams.segments;
+    const int segmentCount = static_cast<int>(segments.size());
+    balancing.circulationFlowRates.assign(segmentCount, 0.0);
+    balancing.returnTemperatures.assign(segmentCount, 0.0);
+    balancing.returnInletTemperatures.assign(segmentCount, 0.0);
+
+    if (networkParams.networkType != NetworkType::HotWaterWithLoop || segmentCount == 0) {
+        return balancing;
+    }
+
+    // Consigne retour : abaissée si le départ ne laisse pas minTemperatureDrop au-dessus d'elle
+    const double sourceTemp = networkParams.waterTemperature;
+    const double minDrop = std::max(0.1, options.minTemperatureDrop);
+    balancing.requiredReturnTemperature = options.minReturnTemperature;
+    if (sourceTemp - options.minReturnTemperature < minDrop) {
+        balancing.requiredReturnTemperature = sourceTemp - minDrop;
+        balancing.returnTemperatureLowered = true;
+    }
+    const double allowedDrop = sourceTemp - balancing.requiredReturnTemperature;
+
+    // ÉTAPE 1: Topologie du bouclage
+    // Un segment appartient au bouclage s'il a un retour et que son parent y appartient aussi
+    const NetworkTree tree(segments);
+    const std::vector<size_t>& order = tree.breadthFirstOrder();  // Ordre racines → feuilles
+    auto isRoot = [&tree](size_t s) { return tree.parent(s) == NetworkTree::None; };
+
+    std::vector<char> inLoop(segmentCount, 0);
+    for (size_t s : order) {
+        inLoop[s] = segments[s].hasReturnLine && (isRoot(s) || inLoop[tree.parent(s)]);
+    }
+
+    std::vector<char> isLoopLeaf(segmentCount, 0);
+    std::vector<size_t> loopLeaves;
+    for (size_t s : order) {
+        if (!inLoop[s]) continue;
+        const NetworkTree::Children children = tree.children(s);
+        bool hasLoopChild = std::any_of(children.begin(), children.end(),
+                                        [&](size_t c) { return inLoop[c] != 0; });
+        if (!hasLoopChild) {
+            isLoopLeaf[s] = 1;
+            loopLeaves.push_back(s);
+        }
+    }
+    if (loopLeaves.empty()) {
+        return balancing;
+    }
+
+    // Diamètres aller/retour figés par le dimensionnement (calculateNetwork)
+    std::vector<double> supplyDiameter(segmentCount, 0.0);
+    std::vector<double> returnDiameter(segmentCount, 0.0);
+    std::vector<int> returnNominal(segmentCount, 0);
+    for (int s = 0; s < segmentCount; ++s) {
+        const auto& result = segments[s].result;
+        supplyDiameter[s] = result.actualDiameter;
+        returnDiameter[s] = result.returnActualDiameter;
+        returnNominal[s] = result.returnNominalDiameter;
+        if (inLoop[s] && (supplyDiameter[s] <= 0.0 || returnDiameter[s] <= 0.0)) {
+            throw std::runtime_error("Le réseau doit être calculé avant l'équilibrage du bouclage (tronçon '" + segments[s].name + "')");
+        }
+    }
+
+    // ÉTAPE 2: Débits initiaux par branche terminale (résultat précédent, sinon formule DTU)
+    std::vector<double> leafFlow(segmentCount, 0.0);
+    std::unordered_map<std::string, double> previousFlows;
+    if (warmStart) {
+        for (const auto& valve : warmStart->valves) {
+            previousFlows[valve.segmentId] = valve.flowRate;
+        }
+    }
+    for (size_t leaf : loopLeaves) {
+        auto it = previousFlows.find(segments[leaf].id);
+        if (it != previousFlows.end() && it->second > 0.0) {
+            leafFlow[leaf] = it->second;
+        } else {
+            // Q (L/h) = P (W) / (1.16 × ΔT), pertes aller + retour de la branche
+            double losses = calculator.calculateHeatLoss(segments[leaf].length, supplyDiameter[leaf],
+                                                         networkParams.insulationThickness, sourceTemp,
+                                                         networkParams.ambientTemperature)
+                          + calculator.calculateHeatLoss(segments[leaf].length, returnDiameter[leaf],
+                                                         networkParams.insulationThickness, sourceTemp,
+                                                         networkParams.ambientTemperature);
+            leafFlow[leaf] = std::max(0.01, losses / (1.16 * allowedDrop) / 60.0);
+        }
+    }
+
+    // ÉTAPE 3: Point fixe débits ↔ températures
+    std::vector<double> flow(segmentCount, 0.0);
+    std::vector<double> supplyOutlet(segmentCount, 0.0);
+    std::vector<double> returnOutlet(segmentCount, 0.0);
+    std::vector<double> returnInlet(segmentCount, 0.0);
+    std::vector<double> pathRatio(segmentCount, 0.0);
+
+    const bool temperatureDependent = networkParams.temperatureDependentProperties;
+    auto temperatureDrop = [&](double heatLoss, double flowRate, double temperature) {
+        return PipeCalculator::calculateTemperatureDrop(
+            heatLoss, flowRate, PipeCalculator::getWaterState(temperature, temperatureDependent));
+    };
+
+    bool converged = false;
+    int iteration = 0;
+    for (; iteration < options.maxIterations && !converged; ++iteration) {
+        // Débits de circulation : somme des branches terminales en aval (feuilles → racines)
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            size_t s = *it;
+            if (!inLoop[s]) continue;
+            double q = isLoopLeaf[s] ? leafFlow[s] : 0.0;
+            for (size_t c : tree.children(s)) {
+                if (inLoop[c]) q += flow[c];
+            }
+            flow[s] = q;
+        }
+
+        // Températures aller (racines → feuilles), sans puisage
+        for (size_t s : order) {
+            if (!inLoop[s]) continue;
+            double inlet = isRoot(s) ? sourceTemp : supplyOutlet[tree.parent(s)];
+            double loss = calculator.calculateHeatLoss(segments[s].length, supplyDiameter[s],
+                                                       networkParams.insulationThickness, inlet,
+                                                       networkParams.ambientTemperature);
+            supplyOutlet[s] = inlet - temperatureDrop(loss, flow[s], inlet);
+        }
+
+        // Températures retour (feuilles → racines) avec mélange pondéré par les débits
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            size_t s = *it;
+            if (!inLoop[s]) continue;
+            double inlet = supplyOutlet[s];
+            if (!isLoopLeaf[s]) {
+                double weighted = 0.0;
+                double sumFlow = 0.0;
+                for (size_t c : tree.children(s)) {
+                    if (!inLoop[c]) continue;
+                    weighted += flow[c] * returnOutlet[c];
+                    sumFlow += flow[c];
+                }
+                if (sumFlow > 1e-9) inlet = weighted / sumFlow;
+            }
+            returnInlet[s] = inlet;
+            double loss = calculator.calculateHeatLoss(segments[s].length, returnDiameter[s],
+                                                       networkParams.insulationThickness, inlet,
+                                                       networkParams.ambientTemperature);
+            returnOutlet[s] = inlet - temperatureDrop(loss, flow[s], inlet);
+        }
+
+        // Rapport chute obtenue / chute admissible, maximum sur le chemin racine → nœud
+        for (size_t s : order) {
+            if (!inLoop[s]) continue;
+            double ratio = (sourceTemp - returnOutlet[s]) / allowedDrop;
+            pathRatio[s] = isRoot(s) ? ratio : std::max(ratio, pathRatio[tree.parent(s)]);
+        }
+
+        // Mise à jour multiplicative : la chute de température varie en 1/Q
+        converged = true;
+        for (size_t leaf : loopLeaves) {
+            double factor = std::max(0.2, std::min(5.0, pathRatio[leaf]));
+            if (std::abs(factor - 1.0) > options.tolerance) {
+                converged = false;
+            }
+            leafFlow[leaf] = std::max(1e-4, leafFlow[leaf] * factor);
+        }
+    }
+
+    balancing.iterations = iteration;
+    balancing.converged = converged;
+
+    // ÉTAPE 4: Pertes de charge aller + retour de chaque circuit et réglage des robinets
+    // (viscosité évaluée à la température de sortie de chaque conduite)
+    std::vector<double> pathLoss(segmentCount, 0.0);
+    for (size_t s : order) {
+        if (!inLoop[s]) continue;
+        double loss = calculator.calculatePressureDrop(flow[s], segments[s].length, supplyDiameter[s],
+                                                       networkParams.material,
+                                                       PipeCalculator::getWaterState(supplyOutlet[s], temperatureDependent),
+                                                       networkParams.frictionModel)
+                    + calculator.calculatePressureDrop(flow[s], segments[s].length, returnDiameter[s],
+                                                       networkParams.material,
+                                                       PipeCalculator::getWaterState(returnOutlet[s], temperatureDependent),
+                                                       networkParams.frictionModel);
+        pathLoss[s] = loss + (isRoot(s) ? 0.0 : pathLoss[tree.parent(s)]);
+    }
+
+    double maxPathLoss = 0.0;
+    for (size_t leaf : loopLeaves) {
+        if (pathLoss[leaf] >= maxPathLoss) {
+            maxPathLoss = pathLoss[leaf];
+            balancing.criticalSegmentId = segments[leaf].id;
+        }
+    }
+    balancing.pumpHead = maxPathLoss + options.minValvePressureDrop;
+
+    balancing.minReturnTemperature = sourceTemp;
+    for (int s = 0; s < segmentCount; ++s) {
+        if (!inLoop[s]) continue;
+        balancing.circulationFlowRates[s] = flow[s];
+        balancing.returnTemperatures[s] = returnOutlet[s];
+        balancing.returnInletTemperatures[s] = returnInlet[s];
+        balancing.minReturnTemperature = std::min(balancing.minReturnTemperature, returnOutlet[s]);
+        if (isRoot(s)) {
+            balancing.pumpFlowRate += flow[s];
+        }
+    }
+
+    for (size_t leaf : loopLeaves) {
+        BalancingValveSetting valve;
+        valve.segmentId = segments[leaf].id;
+        valve.flowRate = flow[leaf];
+        valve.pathPressureDrop = pathLoss[leaf];
+        valve.valvePressureDrop = balancing.pumpHead - pathLoss[leaf];
+        valve.returnTemperature = returnOutlet[leaf];
+
+        // Kv = Q (m³/h) / √Δp (bar)
+        double flowM3h = flow[leaf] * 60.0 / 1000.0;
+        double valveDropBar = valve.valvePressureDrop / 10.0;
+        valve.kv = (valveDropBar > 0.0) ? flowM3h / std::sqrt(valveDropBar) : 0.0;
+        valve.kvs = getValveKvs(returnNominal[leaf]);
+        valve.presetting = valve.kv / valve.kvs;
+        valve.undersized = valve.kv > valve.kvs;
+        balancing.valves.push_back(valve);
+    }
+
+    return balancing;
+}
+
+} // namespace HydraulicCalc
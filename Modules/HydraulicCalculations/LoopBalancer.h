@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "PipeCalculator.h"
+
+namespace HydraulicCalc {
+
+// Options de l'équilibrage du bouclage ECS
+struct LoopBalancingOptions {
+    double minReturnTemperature;  // Température minimale en tout nœud retour (°C) - DTU 60.11 : 55 °C
+    double minTemperatureDrop;    // Chute départ → retour minimale (K) : la consigne retour est abaissée
+                                  // à T départ - minTemperatureDrop si le départ est trop froid
+    double minValvePressureDrop;  // Perte de charge minimale d'un robinet d'équilibrage ouvert (mCE)
+    double tolerance;             // Tolérance relative de convergence sur les débits
+    int maxIterations;            // Nombre maximal d'itérations
+
+    LoopBalancingOptions()
+        : minReturnTemperature(55.0)
+        , minTemperatureDrop(PipeCalculator::LoopTemperatureDrop)
+        , minValvePressureDrop(0.3)
+        , tolerance(0.001)
+        , maxIterations(100)
+    {}
+};
+
+// Réglage d'un robinet d'équilibrage (en pied de chaque branche terminale du bouclage)
+struct BalancingValveSetting {
+    std::string segmentId;        // Segment terminal portant le robinet (sur le retour)
+    double flowRate;              // Débit de circulation de la branche (L/min)
+    double pathPressureDrop;      // Perte de charge aller + retour du circuit de la branche (mCE)
+    double valvePressureDrop;     // Perte de charge à créer par le robinet (mCE)
+    double kv;                    // Kv de réglage (m³/h sous 1 bar)
+    double kvs;                   // Kvs du robinet retenu (pleine ouverture)
+    double presetting;            // Préréglage = Kv / Kvs (> 1 : robinet sous-dimensionné)
+    double returnTemperature;     // Température en sortie retour de la branche (°C)
+    bool undersized;              // Kv > Kvs : même ouvert, le robinet ne laisse pas passer le débit de la branche
+
+    BalancingValveSetting()
+        : flowRate(0), pathPressureDrop(0), valvePressureDrop(0)
+        , kv(0), kvs(0), presetting(0), returnTemperature(0), undersized(false)
+    {}
+};
+
+// Résultat de l'équilibrage
+struct LoopBalancingResult {
+    std::vector<BalancingValveSetting> valves;      // Un réglage par branche terminale du bouclage
+    std::vector<double> circulationFlowRates;       // Débit de circulation par segment (L/min), ordre des segments
+    std::vector<double> returnTemperatures;         // Température sortie retour par segment (°C), 0 hors bouclage
+    std::vector<double> returnInletTemperatures;    // Température entrée retour par segment (°C), 0 hors bouclage
+    double pumpFlowRate;          // Débit du circulateur (L/min)
+    double pumpHead;              // Hauteur manométrique du circulateur (mCE)
+    double minReturnTemperature;  // Température retour la plus basse obtenue (°C)
+    double requiredReturnTemperature; // Consigne retour appliquée (°C)
+    bool returnTemperatureLowered;    // Consigne abaissée : départ trop froid pour minReturnTemperature
+    std::string criticalSegmentId;    // Branche hydrauliquement la plus défavorisée (robinet pleine ouverture)
+    int iterations;
+    bool converged;
+
+    LoopBalancingResult()
+        : pumpFlowRate(0), pumpHead(0), minReturnTemperature(0)
+        , requiredReturnTemperature(0), returnTemperatureLowered(false)
+        , iterations(0), converged(false)
+    {}
+
+    bool empty() const { return valves.empty(); }
+
+    // Nombre de robinets sous-dimensionnés (Kv > Kvs)
+    int undersizedValveCount() const {
+        int count = 0;
+        for (const auto& valve : valves) {
+            if (valve.undersized) ++count;
+        }
+        return count;
+    }
+};
+
+// Équilibrage thermique du bouclage ECS
+//
+// Calcule la répartition du débit de circulation entre les branches qui garantit
+// T ≥ minReturnTemperature en tout nœud retour avec le débit total minimal, puis
+// les réglages Kv des robinets d'équilibrage et le point de fonctionnement du circulateur.
+// Résolution non linéaire par point fixe (les pertes dépendent des températures, qui
+// dépendent des débits) ; un résultat précédent peut servir de point de départ.
+// Un départ trop froid pour la consigne abaisse celle-ci (returnTemperatureLowered) au lieu
+// de faire échouer le calcul du réseau.
+class LoopBalancer {
+public:
+    LoopBalancingResult balance(const NetworkCalculationParameters& networkParams,
+                                const LoopBalancingOptions& options = LoopBalancingOptions(),
+                                const LoopBalancingResult* warmStart = nullptr);
+
+    // Kvs d'un robinet d'équilibrage thermostatique selon le DN de la canalisation retour
+    static double getValveKvs(int returnNominalDiameter);
+
+private:
+    PipeCalculator calculator;
+};
+
+} // namespace HydraulicCalc
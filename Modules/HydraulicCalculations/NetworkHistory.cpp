@@ -0,0 +1,67 @@
+#include "NetworkHistory.h"
+
+namespace HydraulicCalc {
+
+NetworkHistory::NetworkHistory(std::size_t maxDepth)
+    : position(0)
+    , maxDepth(maxDepth)
+{
+    steps.push_back(Step());
+}
+
+void NetworkHistory::record(const NetworkState& state, const std::string& label)
+{
+    steps.erase(steps.begin() + static_cast<std::ptrdiff_t>(position + 1), steps.end());
+
+    Step step;
+    step.state = state;
+    step.label = label;
+    steps.push_back(step);
+    ++position;
+
+    // Profondeur limitée : oublier les étapes les plus anciennes
+    while (steps.size() > maxDepth + 1) {
+        steps.pop_front();
+        --position;
+    }
+}
+
+void NetworkHistory::amend(const NetworkState& state)
+{
+    steps[position].state = state;
+}
+
+std::string NetworkHistory::undoLabel() const
+{
+    return canUndo() ? steps[position].label : std::string();
+}
+
+std::string NetworkHistory::redoLabel() const
+{
+    return canRedo() ? steps[position + 1].label : std::string();
+}
+
+const NetworkState& NetworkHistory::undo()
+{
+    if (canUndo()) {
+        --position;
+    }
+    return current();
+}
+
+const NetworkState& NetworkHistory::redo()
+{
+    if (canRedo()) {
+        ++position;
+    }
+    return current();
+}
+
+void NetworkHistory::clear()
+{
+    steps.clear();
+    steps.push_back(Step());
+    position = 0;
+}
+
+} // namespace HydraulicCalc
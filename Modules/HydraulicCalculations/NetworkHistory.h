@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include "PipeCalculator.h"
+#include "LoopBalancer.h"
+#include "CriticalPathAnalyzer.h"
+#include "SensitivityAnalyzer.h"
+#include "PersistentMap.h"
+
+namespace HydraulicCalc {
+
+// Point du schéma (coordonnées de scène)
+struct SchemaPoint {
+    double x;
+    double y;
+
+    SchemaPoint(double px = 0.0, double py = 0.0) : x(px), y(py) {}
+};
+
+// Tronçon tel qu'enregistré dans l'historique : données (appareils et résultats compris)
+// et géométrie du schéma
+struct SegmentSnapshot {
+    NetworkSegment segment;
+    SchemaPoint start;
+    SchemaPoint end;
+    std::vector<SchemaPoint> fixturePositions;  // Même ordre que segment.fixtures
+};
+
+// Résultats globaux d'un calcul, partagés par tous les états qui en sont issus
+struct CalculationSnapshot {
+    LoopBalancingResult loopBalancing;
+    CriticalPathResult criticalPath;
+    SensitivityResult sensitivity;
+    MultiNetworkResult combinedResults;
+    std::array<CriticalPathResult, NetworkTypeCount> combinedCriticalPaths;
+    std::array<SensitivityResult, NetworkTypeCount> combinedSensitivities;
+    bool hasCombinedResults;
+
+    CalculationSnapshot() : hasCombinedResults(false) {}
+};
+
+// État complet du schéma à une étape de l'historique
+struct NetworkState {
+    PersistentMap<SegmentSnapshot> segments;                 // Par identifiant de tronçon
+    std::shared_ptr<const CalculationSnapshot> calculation;  // Nul : pas de résultats à jour
+
+    bool calculated() const { return calculation != nullptr; }
+};
+
+// Historique annuler / rétablir du schéma
+//
+// Les états partagent leur structure (PersistentMap) : une étape ne coûte que les tronçons
+// modifiés, et passer d'un état à l'autre ne touche que les tronçons dont l'entrée diffère
+// (PersistentMap::diff). Les résultats de calcul font partie des tronçons enregistrés :
+// revenir à un état calculé restitue ses résultats sans recalcul.
+class NetworkHistory {
+public:
+    static constexpr std::size_t DefaultDepth = 200;
+
+    explicit NetworkHistory(std::size_t maxDepth = DefaultDepth);
+
+    const NetworkState& current() const { return steps[position].state; }
+
+    // Nouvelle étape (efface les étapes annulées)
+    void record(const NetworkState& state, const std::string& label);
+
+    // Remplacement de l'état courant sans nouvelle étape (ex. résultats d'un calcul)
+    void amend(const NetworkState& state);
+
+    bool canUndo() const { return position > 0; }
+    bool canRedo() const { return position + 1 < steps.size(); }
+
+    // Libellé de l'étape qui serait annulée / rétablie (vide si aucune)
+    std::string undoLabel() const;
+    std::string redoLabel() const;
+
+    // Passage à l'état précédent / suivant (renvoie le nouvel état courant)
+    const NetworkState& undo();
+    const NetworkState& redo();
+
+    // Retour à un historique vide
+    void clear();
+
+private:
+    struct Step {
+        NetworkState state;
+        std::string label;    // Modification qui a produit cet état
+    };
+
+    std::deque<Step> steps;   // steps[0] : état initial
+    std::size_t position;
+    std::size_t maxDepth;
+};
+
+} // namespace HydraulicCalc
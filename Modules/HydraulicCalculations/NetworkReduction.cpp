@@ -0,0 +1,169 @@
+#include "NetworkReduction.h"
+#include "NetworkTree.h"
+#include <stdexcept>
+
+namespace HydraulicCalc {
+
+NetworkReduction::NetworkReduction(const NetworkCalculationParameters& original) {
+    const auto& segments = original.segments;
+    const size_t count = segments.size();
+
+    // Paramètres communs, sans les segments
+    reduced = original;
+    reduced.segments.clear();
+    parts.assign(count, Part{0, 0.0, 1.0, 0.0, true});
+
+    // ÉTAPE 1: Parent et enfants de chaque segment
+    const NetworkTree tree(segments);
+    const size_t none = NetworkTree::None;
+
+    // Chaque segment doit remonter à une racine (ou à un parent introuvable) : les membres
+    // d'une boucle de parents n'appartiendraient à aucune chaîne
+    std::vector<size_t> stack;
+    size_t reached = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (tree.parent(i) == none) {
+            stack.push_back(i);
+        }
+    }
+    while (!stack.empty()) {
+        size_t i = stack.back();
+        stack.pop_back();
+        ++reached;
+        for (size_t child : tree.children(i)) {
+            stack.push_back(child);
+        }
+    }
+    if (reached != count) {
+        throw std::runtime_error("Boucle circulaire détectée dans la hiérarchie des segments");
+    }
+
+    // Un segment se fusionne avec son enfant s'il ne dessert aucun appareil, n'a qu'un
+    // enfant et partage son régime de bouclage
+    auto onlyChild = [&](size_t i) { return *tree.children(i).begin(); };
+    auto mergesWithChild = [&](size_t i) {
+        return segments[i].fixtures.empty() && tree.children(i).size() == 1
+            && segments[onlyChild(i)].hasReturnLine == segments[i].hasReturnLine;
+    };
+
+    // ÉTAPE 2: Une chaîne par tête (segment dont le parent ne se fusionne pas avec lui)
+    std::vector<size_t> chain;
+    for (size_t head = 0; head < count; ++head) {
+        if (tree.parent(head) != none && mergesWithChild(tree.parent(head))) {
+            continue;
+        }
+
+        chain.clear();
+        size_t current = head;
+        chain.push_back(current);
+        while (mergesWithChild(current)) {
+            current = onlyChild(current);
+            chain.push_back(current);
+        }
+
+        NetworkSegment composite = segments[chain.back()];
+        composite.parentId = segments[head].parentId;
+        composite.length = 0.0;
+        composite.heightDifference = 0.0;
+        for (size_t i : chain) {
+            composite.length += segments[i].length;
+            composite.heightDifference += segments[i].heightDifference;
+        }
+
+        const size_t compositeIndex = reduced.segments.size();
+        double start = 0.0;
+        double heightBefore = 0.0;
+        for (size_t i : chain) {
+            double fraction = (composite.length > 0.0) ? segments[i].length / composite.length
+                                                       : 1.0 / static_cast<double>(chain.size());
+            parts[i] = Part{compositeIndex, start, fraction, heightBefore, chain.size() == 1};
+            start += fraction;
+            heightBefore += segments[i].heightDifference;
+        }
+        reduced.segments.push_back(std::move(composite));
+    }
+}
+
+void NetworkReduction::expand(const NetworkCalculationParameters& solved, NetworkCalculationParameters& original) const {
+    original.loopLength = solved.loopLength;
+    const double minReturnTemperature = solved.waterTemperature - PipeCalculator::LoopTemperatureDrop;
+
+    for (size_t i = 0; i < parts.size(); ++i) {
+        const Part& part = parts[i];
+        const NetworkSegment& composite = solved.segments[part.composite];
+        NetworkSegment& segment = original.segments[i];
+
+        segment.result = composite.result;
+        if (part.alone) {
+            segment.inletPressure = composite.inletPressure;
+            segment.outletPressure = composite.outletPressure;
+            continue;
+        }
+
+        // Pertes au prorata de la longueur, hauteur propre au tronçon
+        PipeSegmentResult& result = segment.result;
+        CalculationDetails& details = result.details;
+        const CalculationDetails& total = composite.result.details;
+        const double frictionDrop = total.linearPressureDrop + total.singularPressureDrop;
+
+        details.linearPressureDrop = total.linearPressureDrop * part.fraction;
+        details.singularPressureDrop = total.singularPressureDrop * part.fraction;
+        details.heightPressureDrop = segment.heightDifference;
+        result.pressureDrop = details.linearPressureDrop + details.singularPressureDrop + details.heightPressureDrop;
+
+        segment.inletPressure = composite.inletPressure - (frictionDrop * part.start + part.heightBefore) / 10.0;
+        segment.outletPressure = segment.inletPressure - result.pressureDrop / 10.0;
+
+        result.heatLoss = composite.result.heatLoss * part.fraction;
+        details.temperatureDrop = total.temperatureDrop * part.fraction;
+
+        // Températures interpolées : aller de l'amont vers l'aval, retour de l'aval vers l'amont
+        const double end = part.start + part.fraction;
+        const double supplyDrop = composite.result.inletTemperature - composite.result.outletTemperature;
+        result.inletTemperature = composite.result.inletTemperature - supplyDrop * part.start;
+        result.outletTemperature = composite.result.inletTemperature - supplyDrop * end;
+
+        const double returnDrop = composite.result.returnInletTemperature - composite.result.returnOutletTemperature;
+        result.returnInletTemperature = composite.result.returnOutletTemperature + returnDrop * end;
+        result.returnOutletTemperature = composite.result.returnOutletTemperature + returnDrop * part.start;
+        result.returnTemperature = result.returnOutletTemperature;
+
+        // Diagnostics du tronçon : pression en sortie propre, température retour sur la racine seule
+        result.diagnostics.setAvailablePressure(segment.outletPressure);
+        if (segment.outletPressure < solved.requiredPressure) {
+            result.diagnostics.set(DiagnosticCode::InsufficientPressure, segment.outletPressure, solved.requiredPressure);
+        } else {
+            result.diagnostics.remove(DiagnosticCode::InsufficientPressure);
+        }
+        if (!segment.parentId.empty()) {
+            result.diagnostics.remove(DiagnosticCode::LowReturnTemperature);
+        } else if (result.diagnostics.has(DiagnosticCode::LowReturnTemperature)) {
+            result.diagnostics.set(DiagnosticCode::LowReturnTemperature,
+                                   result.returnOutletTemperature, minReturnTemperature);
+        }
+    }
+}
+
+void NetworkReduction::expand(LoopBalancingResult& balancing) const {
+    if (balancing.circulationFlowRates.size() != reduced.segments.size()) {
+        return;
+    }
+
+    std::vector<double> flows(parts.size(), 0.0);
+    std::vector<double> returnOutlets(parts.size(), 0.0);
+    std::vector<double> returnInlets(parts.size(), 0.0);
+    for (size_t i = 0; i < parts.size(); ++i) {
+        const Part& part = parts[i];
+        double outlet = balancing.returnTemperatures[part.composite];
+        double inlet = balancing.returnInletTemperatures[part.composite];
+        flows[i] = balancing.circulationFlowRates[part.composite];
+        returnOutlets[i] = outlet + (inlet - outlet) * part.start;
+        returnInlets[i] = outlet + (inlet - outlet) * (part.start + part.fraction);
+    }
+
+    balancing.circulationFlowRates.swap(flows);
+    balancing.returnTemperatures.swap(returnOutlets);
+    balancing.returnInletTemperatures.swap(returnInlets);
+}
+
+} // namespace HydraulicCalc
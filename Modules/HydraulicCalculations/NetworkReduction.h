@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include "PipeCalculator.h"
+#include "LoopBalancer.h"
+
+namespace HydraulicCalc {
+
+// Réduction d'un réseau avant calcul : fusion des chaînes de tronçons en série
+//
+// Un tronçon sans appareil qui n'a qu'un seul enfant (même régime de bouclage) transporte
+// le même débit que cet enfant : la chaîne est remplacée par un tronçon composite de
+// longueur et de dénivelé cumulés, qui reçoit le même DN. Le composite garde l'identifiant,
+// les appareils et les enfants du dernier tronçon de la chaîne (les feuilles du bouclage
+// gardent donc leur identifiant) et le parent du premier.
+//
+// Après calcul du réseau réduit, expand() répartit les résultats sur les tronçons d'origine :
+// pertes de charge linéaires, singulières et thermiques au prorata des longueurs, hauteur
+// propre à chaque tronçon, températures interpolées le long de la chaîne.
+class NetworkReduction {
+public:
+    // Lève std::runtime_error si la hiérarchie des segments contient une boucle de parents
+    explicit NetworkReduction(const NetworkCalculationParameters& original);
+
+    // true si au moins une chaîne a été fusionnée
+    bool reducesNetwork() const { return reduced.segments.size() < parts.size(); }
+
+    // Réseau réduit, à calculer à la place du réseau d'origine
+    NetworkCalculationParameters& reducedParameters() { return reduced; }
+
+    size_t getOriginalCount() const { return parts.size(); }
+    size_t getReducedCount() const { return reduced.segments.size(); }
+
+    // Report des résultats du réseau réduit calculé sur les tronçons d'origine
+    void expand(NetworkCalculationParameters& original) const { expand(reduced, original); }
+
+    // Idem depuis une copie calculée du réseau réduit (ex. un réseau du calcul combiné)
+    void expand(const NetworkCalculationParameters& solved, NetworkCalculationParameters& original) const;
+
+    // Report des grandeurs par tronçon d'un équilibrage calculé sur le réseau réduit
+    void expand(LoopBalancingResult& balancing) const;
+
+private:
+    // Place d'un tronçon d'origine dans son composite (fractions de la longueur du composite)
+    struct Part {
+        size_t composite;     // Indice du composite dans le réseau réduit
+        double start;         // Fraction de longueur en amont du tronçon
+        double fraction;      // Fraction de longueur du tronçon
+        double heightBefore;  // Dénivelé cumulé des tronçons en amont dans la chaîne (m)
+        bool alone;           // Seul tronçon de sa chaîne : résultats du composite repris tels quels
+    };
+
+    NetworkCalculationParameters reduced;
+    std::vector<Part> parts;  // Un par tronçon d'origine, même ordre
+};
+
+} // namespace HydraulicCalc
@@ -0,0 +1,74 @@
+#include "NetworkTree.h"
+#include <utility>
+
+namespace HydraulicCalc {
+
+NetworkTree::NetworkTree(const std::vector<NetworkSegment>& segments) {
+    const size_t count = segments.size();
+
+    indexById.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        indexById.emplace(segments[i].id, i);
+    }
+
+    // ÉTAPE 1: Parents et nombre d'enfants, puis enfants en tableau compact
+    parents.assign(count, None);
+    childStart.assign(count + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        if (segments[i].parentId.empty()) {
+            rootIndices.push_back(i);
+            continue;
+        }
+        auto it = indexById.find(segments[i].parentId);
+        if (it != indexById.end()) {
+            parents[i] = it->second;
+            ++childStart[it->second + 1];
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        childStart[i + 1] += childStart[i];
+    }
+    childIndices.resize(childStart[count]);
+    std::vector<size_t> fill(childStart.begin(), childStart.end() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        if (parents[i] != None) {
+            childIndices[fill[parents[i]]++] = i;
+        }
+    }
+
+    // ÉTAPE 2: Parcours en profondeur depuis chaque racine, enfants dans l'ordre des segments
+    pre.reserve(count);
+    post.reserve(count);
+    std::vector<std::pair<size_t, size_t>> stack;  // (segment, prochain enfant à visiter)
+    for (size_t root : rootIndices) {
+        stack.emplace_back(root, childStart[root]);
+        pre.push_back(root);
+        while (!stack.empty()) {
+            auto& top = stack.back();
+            if (top.second < childStart[top.first + 1]) {
+                size_t child = childIndices[top.second++];
+                stack.emplace_back(child, childStart[child]);
+                pre.push_back(child);
+            } else {
+                post.push_back(top.first);
+                stack.pop_back();
+            }
+        }
+    }
+
+    // ÉTAPE 3: Parcours en largeur, enfants dans l'ordre des segments
+    levels.reserve(pre.size());
+    levels.assign(rootIndices.begin(), rootIndices.end());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        for (size_t child : children(levels[i])) {
+            levels.push_back(child);
+        }
+    }
+}
+
+size_t NetworkTree::find(const std::string& id) const {
+    auto it = indexById.find(id);
+    return (it != indexById.end()) ? it->second : None;
+}
+
+} // namespace HydraulicCalc
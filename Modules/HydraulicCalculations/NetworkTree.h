@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "PipeCalculator.h"
+
+namespace HydraulicCalc {
+
+// Arbre d'un réseau indexé une fois : parent, enfants en tableau compact et ordres de parcours
+//
+// Les segments sont repérés par leur indice dans le vecteur de segments, les enfants d'un
+// segment sont dans l'ordre des segments. Un segment dont le parent est introuvable n'est ni
+// racine ni enfant ; les segments d'une boucle de parents ont leur parent et leurs enfants,
+// mais aucune racine n'y mène. Dans les deux cas, ils n'apparaissent dans aucun parcours,
+// comme dans calculateNetwork qui ne les calcule jamais.
+class NetworkTree {
+public:
+    static constexpr size_t None = static_cast<size_t>(-1);
+
+    // Enfants d'un segment, pour les boucles for (size_t child : tree.children(i))
+    struct Children {
+        const size_t* first;
+        const size_t* last;
+        const size_t* begin() const { return first; }
+        const size_t* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+
+    explicit NetworkTree(const std::vector<NetworkSegment>& segments);
+
+    size_t size() const { return parents.size(); }
+
+    // Indice du segment d'identifiant id (le premier en cas de doublon), None si absent
+    size_t find(const std::string& id) const;
+
+    // Indice du parent, None pour une racine ou un parent introuvable
+    size_t parent(size_t i) const { return parents[i]; }
+
+    Children children(size_t i) const {
+        return Children{childIndices.data() + childStart[i], childIndices.data() + childStart[i + 1]};
+    }
+    bool isLeaf(size_t i) const { return childStart[i] == childStart[i + 1]; }
+
+    // Segments sans parent, dans l'ordre des segments
+    const std::vector<size_t>& roots() const { return rootIndices; }
+
+    // Parcours en profondeur depuis chaque racine : parents avant enfants (propagation vers
+    // les appareils), et enfants avant parents (cumuls vers la source)
+    const std::vector<size_t>& preOrder() const { return pre; }
+    const std::vector<size_t>& postOrder() const { return post; }
+
+    // Parcours en largeur : racines, puis leurs enfants, niveau par niveau (parents avant
+    // enfants, robinets et nœuds listés étage par étage)
+    const std::vector<size_t>& breadthFirstOrder() const { return levels; }
+
+private:
+    std::unordered_map<std::string, size_t> indexById;
+    std::vector<size_t> parents;
+    std::vector<size_t> childStart;    // Enfants de i : childIndices[childStart[i] .. childStart[i + 1]]
+    std::vector<size_t> childIndices;
+    std::vector<size_t> rootIndices;
+    std::vector<size_t> pre;
+    std::vector<size_t> post;
+    std::vector<size_t> levels;
+};
+
+} // namespace HydraulicCalc
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace HydraulicCalc {
+
+// Table associative persistante clé texte -> valeur partagée (HAMT : hash array mapped trie)
+//
+// Une modification renvoie une nouvelle table et ne recopie que le chemin de la racine à la clé
+// (au plus 13 nœuds de 32 emplacements) : tout le reste est partagé avec la table d'origine, qui
+// reste valide et inchangée. Les valeurs sont des std::shared_ptr<const V> ; deux versions qui
+// partagent une valeur partagent le même pointeur, ce qui permet de les comparer en
+// O(différences) en sautant les sous-arbres communs (diff).
+//
+// Hash : fonction de hachage des clés (remplaçable pour forcer les collisions dans les tests).
+template <class V, class Hash = std::hash<std::string>>
+class PersistentMap {
+public:
+    using ValuePtr = std::shared_ptr<const V>;
+
+    PersistentMap() : count(0) {}
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Valeur associée à la clé (nul si absente)
+    ValuePtr find(const std::string& key) const {
+        const std::size_t hash = hashOf(key);
+        const Node* node = root.get();
+        unsigned shift = 0;
+        while (node) {
+            if (shift >= HashBits) {
+                for (const auto& slot : node->slots) {
+                    if (slot.key == key) return slot.value;
+                }
+                return nullptr;
+            }
+            const std::uint32_t bit = bitFor(hash, shift);
+            if (!(node->bitmap & bit)) return nullptr;
+            const Slot& slot = node->slots[position(node->bitmap, bit)];
+            if (!slot.child) {
+                return (slot.key == key) ? slot.value : nullptr;
+            }
+            node = slot.child.get();
+            shift += Bits;
+        }
+        return nullptr;
+    }
+
+    // Nouvelle table où la clé est associée à la valeur
+    PersistentMap set(const std::string& key, ValuePtr value) const {
+        if (find(key) == value) {
+            return *this;
+        }
+        bool added = false;
+        Slot leaf{hashOf(key), key, std::move(value), nullptr};
+        NodePtr newRoot = insert(root, 0, leaf, added);
+        return PersistentMap(newRoot, count + (added ? 1 : 0));
+    }
+
+    // Nouvelle table sans la clé
+    PersistentMap erase(const std::string& key) const {
+        bool removed = false;
+        NodePtr newRoot = remove(root, 0, hashOf(key), key, removed);
+        return removed ? PersistentMap(newRoot, count - 1) : *this;
+    }
+
+    // f(clé, valeur) pour chaque entrée, ordre non spécifié
+    template <class F>
+    void forEach(F&& f) const {
+        std::vector<const Slot*> leaves;
+        collect(root.get(), leaves);
+        for (const Slot* leaf : leaves) {
+            f(leaf->key, *leaf->value);
+        }
+    }
+
+    // f(clé, avant, après) pour chaque clé dont la valeur diffère entre *this et other
+    // (avant nul : clé ajoutée ; après nul : clé supprimée)
+    template <class F>
+    void diff(const PersistentMap& other, F&& f) const {
+        diffNodes(root.get(), other.root.get(), 0, f);
+    }
+
+private:
+    static constexpr unsigned Bits = 5;
+    static constexpr unsigned HashBits = sizeof(std::size_t) * 8;  // Au-delà : nœud de collision
+
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Slot {
+        std::size_t hash;
+        std::string key;     // Feuille
+        ValuePtr value;      // Feuille
+        NodePtr child;       // Sous-nœud (feuille si nul)
+    };
+
+    struct Node {
+        std::uint32_t bitmap = 0;   // Emplacements occupés (nœud de collision : recherche linéaire)
+        std::vector<Slot> slots;    // Compactés dans l'ordre des bits
+    };
+
+    PersistentMap(NodePtr node, std::size_t size) : root(std::move(node)), count(size) {}
+
+    static std::size_t hashOf(const std::string& key) { return Hash()(key); }
+    static std::uint32_t bitFor(std::size_t hash, unsigned shift) {
+        return std::uint32_t(1) << ((hash >> shift) & 31u);
+    }
+    static std::size_t position(std::uint32_t bitmap, std::uint32_t bit) {
+        return std::bitset<32>(bitmap & (bit - 1)).count();
+    }
+
+    static NodePtr insert(const NodePtr& node, unsigned shift, const Slot& leaf, bool& added) {
+        if (!node) {
+            auto created = std::make_shared<Node>();
+            if (shift < HashBits) created->bitmap = bitFor(leaf.hash, shift);
+            created->slots.push_back(leaf);
+            added = true;
+            return created;
+        }
+
+        auto copy = std::make_shared<Node>(*node);
+        if (shift >= HashBits) {
+            for (auto& slot : copy->slots) {
+                if (slot.key == leaf.key) {
+                    slot.value = leaf.value;
+                    return copy;
+                }
+            }
+            copy->slots.push_back(leaf);
+            added = true;
+            return copy;
+        }
+
+        const std::uint32_t bit = bitFor(leaf.hash, shift);
+        const std::size_t pos = position(node->bitmap, bit);
+        if (!(node->bitmap & bit)) {
+            copy->slots.insert(copy->slots.begin() + static_cast<std::ptrdiff_t>(pos), leaf);
+            copy->bitmap |= bit;
+            added = true;
+            return copy;
+        }
+
+        Slot& slot = copy->slots[pos];
+        if (slot.child) {
+            slot.child = insert(slot.child, shift + Bits, leaf, added);
+        } else if (slot.key == leaf.key) {
+            slot.value = leaf.value;
+        } else {
+            // Deux clés au même emplacement : les descendre dans un sous-nœud
+            bool ignored = false;
+            NodePtr child = insert(nullptr, shift + Bits, slot, ignored);
+            child = insert(child, shift + Bits, leaf, added);
+            slot = Slot{0, std::string(), nullptr, child};
+        }
+        return copy;
+    }
+
+    static NodePtr remove(const NodePtr& node, unsigned shift, std::size_t hash,
+                          const std::string& key, bool& removed) {
+        if (!node) return node;
+
+        if (shift >= HashBits) {
+            for (std::size_t i = 0; i < node->slots.size(); ++i) {
+                if (node->slots[i].key == key) {
+                    auto copy = std::make_shared<Node>(*node);
+                    copy->slots.erase(copy->slots.begin() + static_cast<std::ptrdiff_t>(i));
+                    removed = true;
+                    return copy->slots.empty() ? nullptr : NodePtr(copy);
+                }
+            }
+            return node;
+        }
+
+        const std::uint32_t bit = bitFor(hash, shift);
+        if (!(node->bitmap & bit)) return node;
+        const std::size_t pos = position(node->bitmap, bit);
+        const Slot& slot = node->slots[pos];
+
+        NodePtr child;
+        if (slot.child) {
+            child = remove(slot.child, shift + Bits, hash, key, removed);
+        } else {
+            removed = (slot.key == key);
+        }
+        if (!removed) return node;
+
+        auto copy = std::make_shared<Node>(*node);
+        if (child) {
+            // Sous-nœud réduit à une feuille : la remonter à cet emplacement
+            if (child->slots.size() == 1 && !child->slots.front().child) {
+                copy->slots[pos] = child->slots.front();
+            } else {
+                copy->slots[pos].child = child;
+            }
+        } else {
+            copy->slots.erase(copy->slots.begin() + static_cast<std::ptrdiff_t>(pos));
+            copy->bitmap &= ~bit;
+        }
+        return copy->slots.empty() ? nullptr : NodePtr(copy);
+    }
+
+    static void collect(const Node* node, std::vector<const Slot*>& leaves) {
+        if (!node) return;
+        for (const auto& slot : node->slots) {
+            if (slot.child) {
+                collect(slot.child.get(), leaves);
+            } else {
+                leaves.push_back(&slot);
+            }
+        }
+    }
+
+    template <class F>
+    static void diffLeaves(const std::vector<const Slot*>& before, const std::vector<const Slot*>& after, F& f) {
+        // Listes courtes (un emplacement) : comparaison directe
+        std::vector<bool> matched(after.size(), false);
+        for (const Slot* a : before) {
+            bool found = false;
+            for (std::size_t i = 0; i < after.size(); ++i) {
+                if (after[i]->key == a->key) {
+                    matched[i] = true;
+                    found = true;
+                    if (after[i]->value != a->value) f(a->key, a->value, after[i]->value);
+                    break;
+                }
+            }
+            if (!found) f(a->key, a->value, ValuePtr());
+        }
+        for (std::size_t i = 0; i < after.size(); ++i) {
+            if (!matched[i]) f(after[i]->key, ValuePtr(), after[i]->value);
+        }
+    }
+
+    template <class F>
+    static void diffNodes(const Node* a, const Node* b, unsigned shift, F& f) {
+        if (a == b) return;  // Sous-arbre partagé : aucune différence
+
+        std::vector<const Slot*> before;
+        std::vector<const Slot*> after;
+        if (!a || !b || shift >= HashBits) {
+            collect(a, before);
+            collect(b, after);
+            diffLeaves(before, after, f);
+            return;
+        }
+
+        for (unsigned index = 0; index < 32; ++index) {
+            const std::uint32_t bit = std::uint32_t(1) << index;
+            const Slot* slotA = (a->bitmap & bit) ? &a->slots[position(a->bitmap, bit)] : nullptr;
+            const Slot* slotB = (b->bitmap & bit) ? &b->slots[position(b->bitmap, bit)] : nullptr;
+            if (!slotA && !slotB) continue;
+
+            if (slotA && slotB && slotA->child && slotB->child) {
+                diffNodes(slotA->child.get(), slotB->child.get(), shift + Bits, f);
+                continue;
+            }
+
+            before.clear();
+            after.clear();
+            if (slotA) {
+                if (slotA->child) collect(slotA->child.get(), before); else before.push_back(slotA);
+            }
+            if (slotB) {
+                if (slotB->child) collect(slotB->child.get(), after); else after.push_back(slotB);
+            }
+            diffLeaves(before, after, f);
+        }
+    }
+
+    NodePtr root;
+    std::size_t count;
+};
+
+} // namespace HydraulicCalc
@@ -1,67 +1,18 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 #include "PipeCalculator.h"
+#include "PipeCatalogue.h"
+#include "CalculationCache.h"
+#include "HydraulicKernels.h"
+#include "NetworkTree.h"
 #include <algorithm>
 #include <functional>
-#include <map>
+#include <unordered_map>
 
 namespace HydraulicCalc {
 
-// Initialisation des débits selon tableau normatif (Qmin de calcul)
-void Fixture::initializeFlowRate() {
-    switch (type) {
-        case FixtureType::WashBasin:
-            flowRate = 12.0; // 0.20 L/s = 12 L/min
-            break;
-        case FixtureType::WashBasinCollective:
-            flowRate = 3.0; // 0.05 L/s = 3 L/min (par jet)
-            break;
-        case FixtureType::Sink:
-            flowRate = 12.0; // 0.20 L/s = 12 L/min
-            break;
-        case FixtureType::Shower:
-            flowRate = 12.0; // 0.20 L/s = 12 L/min
-            break;
-        case FixtureType::Bathtub:
-            flowRate = 20.0; // 0.33 L/s = 19.8 L/min ≈ 20 L/min
-            break;
-        case FixtureType::WC:
-            flowRate = 7.2; // 0.12 L/s = 7.2 L/min (avec réservoir)
-            break;
-        case FixtureType::WCFlushValve:
-            flowRate = 90.0; // 1.50 L/s = 90 L/min (avec robinet de chasse)
-            break;
-        case FixtureType::Bidet:
-            flowRate = 12.0; // 0.20 L/s = 12 L/min
-            break;
-        case FixtureType::WashingMachine:
-            flowRate = 12.0; // 0.20 L/s = 12 L/min
-            break;
-        case FixtureType::Dishwasher:
-            flowRate = 6.0; // 0.10 L/s = 6 L/min
-            break;
-        case FixtureType::UrinalFlush:
-            flowRate = 9.0; // 0.15 L/s = 9 L/min (avec robinet individuel)
-            break;
-        case FixtureType::UrinalSiphonic:
-            flowRate = 30.0; // 0.50 L/s = 30 L/min (à action siphonique)
-            break;
-        case FixtureType::HandWashBasin:
-            flowRate = 6.0; // 0.10 L/s = 6 L/min
-            break;
-        case FixtureType::UtilitySink:
-            flowRate = 20.0; // 0.33 L/s = 19.8 L/min ≈ 20 L/min
-            break;
-        case FixtureType::WaterOutlet12:
-            flowRate = 20.0; // 0.33 L/s = 19.8 L/min ≈ 20 L/min (robinet 1/2")
-            break;
-        case FixtureType::WaterOutlet34:
-            flowRate = 25.2; // 0.42 L/s = 25.2 L/min (robinet 3/4")
-            break;
-    }
-}
-
-PipeCalculator::PipeCalculator() {
+PipeCalculator::PipeCalculator()
+    : resultCache(nullptr) {
 }
 
 PipeCalculator::~PipeCalculator() {
@@ -81,36 +32,62 @@ double PipeCalculator::getSimultaneityCoefficient(int numberOfFixtures) {
     return 0.8 / std::sqrt(static_cast<double>(numberOfFixtures - 1));
 }
 
-double PipeCalculator::calculateFlowRate(const std::vector<Fixture>& fixtures) {
-    double totalFlowRate = 0.0;
-    int totalFixtures = 0;
-
+void PipeCalculator::addFixtureCounts(const std::vector<Fixture>& fixtures, FixtureCounts& counts) {
     for (const auto& fixture : fixtures) {
-        totalFlowRate += fixture.flowRate * fixture.quantity;
-        totalFixtures += fixture.quantity;
+        counts[static_cast<size_t>(fixture.type)] += fixture.quantity;
     }
+}
 
-    // Application du coefficient de simultanéité
-    double simultaneityCoeff = getSimultaneityCoefficient(totalFixtures);
-    return totalFlowRate * simultaneityCoeff;
+double PipeCalculator::calculateFlowRate(const std::vector<Fixture>& fixtures) {
+    FixtureCounts counts{};
+    addFixtureCounts(fixtures, counts);
+
+    // Application du coefficient de simultanéité au débit brut Σ nᵢ·qᵢ
+    double simultaneityCoeff = getSimultaneityCoefficient(FixtureCatalogue::totalCount(counts));
+    return FixtureCatalogue::instance().totalFlowRate(counts) * simultaneityCoeff;
 }
 
 // Version avec détails pour le PDF
 double PipeCalculator::calculateFlowRateWithDetails(const std::vector<Fixture>& fixtures, CalculationDetails& details) {
-    details.totalFixtureFlowRate = 0.0;
-    details.totalFixtures = 0;
-
-    for (const auto& fixture : fixtures) {
-        details.totalFixtureFlowRate += fixture.flowRate * fixture.quantity;
-        details.totalFixtures += fixture.quantity;
-    }
+    FixtureCounts counts{};
+    addFixtureCounts(fixtures, counts);
+    details.totalFixtureFlowRate = FixtureCatalogue::instance().totalFlowRate(counts);
+    details.totalFixtures = FixtureCatalogue::totalCount(counts);
 
     // Application du coefficient de simultanéité
     details.simultaneityCoeff = getSimultaneityCoefficient(details.totalFixtures);
     return details.totalFixtureFlowRate * details.simultaneityCoeff;
 }
 
+// Clé : tout ce dont dépendent Re, λ et la perte linéaire (comparaison exacte, les réseaux
+// du calcul combiné faisant les mêmes calculs sur les mêmes valeurs)
+struct PipeCalculator::FrictionEvaluation {
+    bool valid = false;
+    double flowRate = 0.0;
+    double diameter = 0.0;
+    double roughness = 0.0;
+    double length = 0.0;
+    double kinematicViscosity = 0.0;
+    double density = 0.0;
+    FrictionModel frictionModel = FrictionModel::SwameeJain;
+
+    double reynolds = 0.0;
+    double relativeRoughness = 0.0;
+    bool isLaminar = false;
+    double lambda = 0.0;
+    double linearPressureDrop = 0.0;
+
+    bool matches(double q, double d, double eps, double l, const WaterState& water, FrictionModel model) const {
+        return valid && flowRate == q && diameter == d && roughness == eps && length == l
+            && kinematicViscosity == water.kinematicViscosity && density == water.density && frictionModel == model;
+    }
+};
+
 PipeSegmentResult PipeCalculator::calculate(const CalculationParameters& params) {
+    return calculate(params, nullptr);
+}
+
+PipeSegmentResult PipeCalculator::calculate(const CalculationParameters& params, FrictionEvaluation* shared) {
     PipeSegmentResult result;
 
     // Calcul du débit : utiliser overrideFlowRate si défini, sinon calculer depuis fixtures
@@ -126,7 +103,7 @@ PipeSegmentResult PipeCalculator::calculate(const CalculationParameters& params)
 
     // Sélection du diamètre optimal (vitesse max 2 m/s pour confort)
     // En tenant compte du DN minimal requis (par ex. DN max des enfants)
-    double maxVelocity = (params.networkType == NetworkType::HotWaterWithLoop) ? 1.5 : 2.0;
+    double maxVelocity = getMaxVelocity(params.networkType);
     result.nominalDiameter = selectOptimalDiameter(result.flowRate, params.material, maxVelocity, params.minDiameter);
     result.actualDiameter = getInternalDiameter(result.nominalDiameter, params.material);
 
@@ -134,21 +111,9 @@ PipeSegmentResult PipeCalculator::calculate(const CalculationParameters& params)
     result.details.crossSection = M_PI * std::pow(result.actualDiameter / 2000.0, 2);
     result.velocity = calculateVelocity(result.flowRate, result.actualDiameter);
 
-    // Calcul de la perte de charge avec détails
-    result.details.roughness = getRoughness(params.material);
-    result.details.heightPressureDrop = params.heightDifference;
-
-    result.details.linearPressureDrop = calculateLinearPressureDropWithDetails(
-        result.flowRate, result.actualDiameter, result.details.roughness,
-        params.length, result.details);
-
-    result.details.singularPressureDrop = calculateSingularPressureDrop(result.details.linearPressureDrop);
-
-    result.pressureDrop = result.details.linearPressureDrop +
-                         result.details.singularPressureDrop +
-                         result.details.heightPressureDrop;
-
     // Calcul des températures pour ECS (avec et sans bouclage)
+    // Effectué avant la perte de charge : la viscosité est évaluée à la température moyenne du segment
+    double fluidTemperature = WaterProperties::ColdWaterTemperature;
     if (params.networkType == NetworkType::HotWater || params.networkType == NetworkType::HotWaterWithLoop) {
         // Température d'entrée = température fournie en paramètre
         result.inletTemperature = params.waterTemperature;
@@ -160,18 +125,13 @@ PipeSegmentResult PipeCalculator::calculate(const CalculationParameters& params)
                                                        result.details);
 
         // Calcul de la chute de température due aux pertes thermiques
-        // ΔT = Pertes (W) / (Débit (L/min) × Chaleur spécifique (J/(kg·K)) × Densité (kg/L) / 60)
-        // Chaleur spécifique de l'eau = 4186 J/(kg·K), Densité ≈ 1 kg/L
-        if (result.flowRate > 0) {
-            double flowRateKgPerS = result.flowRate / 60.0;  // L/min → kg/s (densité ≈ 1 kg/L)
-            double specificHeat = 4186.0;  // J/(kg·K)
-            result.details.temperatureDrop = result.heatLoss / (flowRateKgPerS * specificHeat);
-            result.outletTemperature = result.inletTemperature - result.details.temperatureDrop;
-        } else {
-            // Si débit nul, température reste identique (pas de refroidissement)
-            result.details.temperatureDrop = 0.0;
-            result.outletTemperature = result.inletTemperature;
-        }
+        // ΔT = Pertes (W) / (Débit massique (kg/s) × Chaleur spécifique (J/(kg·K)))
+        // Si débit nul, température reste identique (pas de refroidissement)
+        WaterState inletWater = getWaterState(result.inletTemperature, params.temperatureDependentProperties);
+        result.details.temperatureDrop = calculateTemperatureDrop(result.heatLoss, result.flowRate, inletWater);
+        result.outletTemperature = result.inletTemperature - result.details.temperatureDrop;
+
+        fluidTemperature = (result.inletTemperature + result.outletTemperature) / 2.0;
     } else {
         // Pour eau froide, pas de calcul de température
         result.inletTemperature = 0.0;
@@ -180,34 +140,61 @@ PipeSegmentResult PipeCalculator::calculate(const CalculationParameters& params)
         result.details.temperatureDrop = 0.0;
     }
 
+    // Calcul de la perte de charge avec détails
+    result.details.roughness = getRoughness(params.material);
+    result.details.heightPressureDrop = params.heightDifference;
+
+    const WaterState fluid = getWaterState(fluidTemperature, params.temperatureDependentProperties);
+    if (shared && shared->matches(result.flowRate, result.actualDiameter, result.details.roughness,
+                                  params.length, fluid, params.frictionModel)) {
+        result.details.reynolds = shared->reynolds;
+        result.details.relativeRoughness = shared->relativeRoughness;
+        result.details.isLaminar = shared->isLaminar;
+        result.details.frictionModel = params.frictionModel;
+        result.details.lambda = shared->lambda;
+        result.details.linearPressureDrop = shared->linearPressureDrop;
+    } else {
+        result.details.linearPressureDrop = calculateLinearPressureDropWithDetails(
+            result.flowRate, result.actualDiameter, result.details.roughness,
+            params.length, fluid, params.frictionModel, result.details);
+        if (shared) {
+            shared->valid = true;
+            shared->flowRate = result.flowRate;
+            shared->diameter = result.actualDiameter;
+            shared->roughness = result.details.roughness;
+            shared->length = params.length;
+            shared->kinematicViscosity = fluid.kinematicViscosity;
+            shared->density = fluid.density;
+            shared->frictionModel = params.frictionModel;
+            shared->reynolds = result.details.reynolds;
+            shared->relativeRoughness = result.details.relativeRoughness;
+            shared->isLaminar = result.details.isLaminar;
+            shared->lambda = result.details.lambda;
+            shared->linearPressureDrop = result.details.linearPressureDrop;
+        }
+    }
+
+    result.details.singularPressureDrop = calculateSingularPressureDrop(result.details.linearPressureDrop);
+
+    result.pressureDrop = result.details.linearPressureDrop +
+                         result.details.singularPressureDrop +
+                         result.details.heightPressureDrop;
+
     // Vérification de la pression disponible
     double availablePressure = params.supplyPressure - (result.pressureDrop / 10.0);
 
-    // Génération de la recommandation
-    result.recommendation = "";
-
+    // Diagnostics (le texte n'est produit qu'à l'affichage)
     if (result.velocity > maxVelocity) {
-        result.recommendation += "⚠️ Vitesse élevée (" +
-            std::to_string(static_cast<int>(result.velocity * 100) / 100.0) +
-            " m/s). Risque de bruit. ";
+        result.diagnostics.set(DiagnosticCode::HighVelocity, result.velocity, maxVelocity);
     }
 
-    if (result.velocity < 0.3) {
-        result.recommendation += "⚠️ Vitesse faible (" +
-            std::to_string(static_cast<int>(result.velocity * 100) / 100.0) +
-            " m/s). Risque de stagnation. ";
+    if (result.velocity < StagnationVelocity) {
+        result.diagnostics.set(DiagnosticCode::LowVelocity, result.velocity, StagnationVelocity);
     }
 
+    result.diagnostics.setAvailablePressure(availablePressure);
     if (availablePressure < params.requiredPressure) {
-        result.recommendation += "❌ Pression insuffisante (" +
-            std::to_string(static_cast<int>(availablePressure * 10) / 10.0) +
-            " bar disponibles pour " +
-            std::to_string(static_cast<int>(params.requiredPressure * 10) / 10.0) +
-            " bar requis). ";
-    } else {
-        result.recommendation += "✓ Pression suffisante (" +
-            std::to_string(static_cast<int>(availablePressure * 10) / 10.0) +
-            " bar disponibles). ";
+        result.diagnostics.set(DiagnosticCode::InsufficientPressure, availablePressure, params.requiredPressure);
     }
 
     if (params.networkType == NetworkType::HotWaterWithLoop) {
@@ -217,10 +204,6 @@ PipeSegmentResult PipeCalculator::calculate(const CalculationParameters& params)
         // car le débit de retour doit être identique pour TOUTE la boucle
     }
 
-    if (result.recommendation.empty()) {
-        result.recommendation = "✓ Dimensionnement optimal";
-    }
-
     return result;
 }
 
@@ -232,214 +215,214 @@ PipeCalculator::ReturnDiameterResult PipeCalculator::selectReturnDiameter(
     result.adjustedFlowRate = thermalFlowRate;
     result.flowRateAdjusted = false;
 
-    // Obtenir tous les diamètres disponibles pour ce matériau
-    std::vector<int> diameters = getAvailableDiameters(material);
+    // La vitesse décroît avec le DN : le plus petit DN valide est le premier qui respecte vmax
+    const PipeSeries& series = PipeCatalogue::instance().getSeries(material);
+    int index = series.selectIndex(thermalFlowRate, maxVelocity);
 
-    if (diameters.empty()) {
-        // Cas dégénéré : aucun diamètre disponible
-        result.nominalDiameter = 10;
-        result.actualDiameter = getInternalDiameter(10, material);
-        result.velocity = calculateVelocity(thermalFlowRate, result.actualDiameter);
-        return result;
-    }
-
-    // Structure pour stocker les candidats
-    struct Candidate {
-        int dn;
-        double diameter;
-        double velocity;
-    };
-    std::vector<Candidate> validCandidates;
-
-    // Tester tous les DN et trouver ceux qui respectent les contraintes
-    for (int dn : diameters) {
-        double diameter = getInternalDiameter(dn, material);
-        double velocity = calculateVelocity(thermalFlowRate, diameter);
-
-        // Vérifier si ce DN respecte les contraintes de vitesse
-        if (velocity >= minVelocity && velocity <= maxVelocity) {
-            validCandidates.push_back({dn, diameter, velocity});
-        }
-    }
-
-    // CAS 1 : Au moins un DN respecte les contraintes
-    if (!validCandidates.empty()) {
-        // Prendre le plus petit DN (celui avec la vitesse la plus haute dans la plage)
-        auto minDN = std::min_element(validCandidates.begin(), validCandidates.end(),
-            [](const Candidate& a, const Candidate& b) { return a.dn < b.dn; });
-
-        result.nominalDiameter = minDN->dn;
-        result.actualDiameter = minDN->diameter;
-        result.velocity = minDN->velocity;
-        return result;
-    }
-
-    // CAS 2 : Aucun DN ne respecte les contraintes
-    // Vérifier si tous les DN donnent une vitesse trop faible (v < vmin)
-    bool allTooSlow = true;
-    for (int dn : diameters) {
-        double diameter = getInternalDiameter(dn, material);
-        double velocity = calculateVelocity(thermalFlowRate, diameter);
+    // CAS 1 : Le plus petit DN respectant vmax respecte aussi vmin
+    if (index >= 0) {
+        const PipeSize& size = series.sizes[index];
+        double velocity = calculateVelocity(thermalFlowRate, size.internalDiameter);
         if (velocity >= minVelocity) {
-            allTooSlow = false;
-            break;
+            result.nominalDiameter = size.nominalDiameter;
+            result.actualDiameter = size.internalDiameter;
+            result.velocity = velocity;
+            return result;
         }
     }
 
-    if (allTooSlow) {
+    // CAS 2 : Aucun DN ne respecte les contraintes
+    // Tous les DN donnent une vitesse trop faible si le plus petit d'entre eux est sous vmin
+    const PipeSize& smallest = series.sizes.front();
+    if (calculateVelocity(thermalFlowRate, smallest.internalDiameter) < minVelocity) {
         // Tous les DN donnent v < vmin : prendre le plus petit DN et augmenter le débit
-        int smallestDN = diameters.front();
-        double diameter = getInternalDiameter(smallestDN, material);
-
         // Calculer le débit nécessaire pour atteindre vmin
         // v = Q / (π D² / 4) => Q = v × π D² / 4
-        double requiredFlowRate = minVelocity * M_PI * std::pow(diameter / 2000.0, 2);
+        double requiredFlowRate = minVelocity * smallest.crossSection;
         requiredFlowRate *= 60000.0; // m³/s → L/min
 
-        result.nominalDiameter = smallestDN;
-        result.actualDiameter = diameter;
+        result.nominalDiameter = smallest.nominalDiameter;
+        result.actualDiameter = smallest.internalDiameter;
         result.adjustedFlowRate = requiredFlowRate;
         result.velocity = minVelocity;
         result.flowRateAdjusted = true;
         return result;
     }
 
-    // CAS 3 : Tous les DN donnent v > vmax : prendre le premier DN qui donne v ≤ vmax
-    // (normalement ne devrait pas arriver car selectOptimalDiameter gère déjà ce cas)
-    for (int dn : diameters) {
-        double diameter = getInternalDiameter(dn, material);
-        double velocity = calculateVelocity(thermalFlowRate, diameter);
+    // CAS 3 : Le premier DN qui donne v ≤ vmax (v < vmin, mais les plus petits dépassent vmax)
+    // Dernier recours : le plus gros DN disponible
+    const PipeSize& size = (index >= 0) ? series.sizes[index] : series.sizes.back();
+    result.nominalDiameter = size.nominalDiameter;
+    result.actualDiameter = size.internalDiameter;
+    result.velocity = calculateVelocity(thermalFlowRate, size.internalDiameter);
+    return result;
+}
+
+// Arbre du réseau construit une fois par calcul (les passes parcourent des indices au lieu
+// de rechercher les enfants par identifiant), et grandeurs indépendantes du type de réseau
+struct PipeCalculator::NetworkTopology : NetworkTree {
+    std::vector<FixtureCounts> servedFixtures;  // Appareils desservis par le segment et ses descendants
+    std::vector<double> flowRates;              // Débit de dimensionnement (L/min)
+    double totalLength;                         // Somme des longueurs de tous les segments (m)
 
-        if (velocity <= maxVelocity) {
-            result.nominalDiameter = dn;
-            result.actualDiameter = diameter;
-            result.velocity = velocity;
-            return result;
+    explicit NetworkTopology(const std::vector<NetworkSegment>& segments)
+        : NetworkTree(segments) {
+        const size_t count = segments.size();
+
+        totalLength = 0.0;
+        for (const auto& segment : segments) {
+            totalLength += segment.length;
         }
-    }
 
-    // Dernier recours : prendre le plus gros DN disponible
-    int largestDN = diameters.back();
-    result.nominalDiameter = largestDN;
-    result.actualDiameter = getInternalDiameter(largestDN, material);
-    result.velocity = calculateVelocity(thermalFlowRate, result.actualDiameter);
-    return result;
-}
+        // Appareils desservis et débits, cumulés des feuilles vers les racines
+        servedFixtures.assign(count, FixtureCounts{});
+        flowRates.assign(count, 0.0);
+        for (size_t i : postOrder()) {
+            PipeCalculator::addFixtureCounts(segments[i].fixtures, servedFixtures[i]);
+            if (isLeaf(i)) {
+                // Segment FEUILLE : débit des appareils avec coefficient de simultanéité
+                flowRates[i] = PipeCalculator::calculateFlowRate(segments[i].fixtures);
+                continue;
+            }
 
-void PipeCalculator::calculateNetwork(NetworkCalculationParameters& networkParams) {
-    // Calcul automatique de la longueur de boucle = somme des longueurs de tous les segments
-    double totalLoopLength = 0.0;
-    for (const auto& segment : networkParams.segments) {
-        totalLoopLength += segment.length;
-    }
-    networkParams.loopLength = totalLoopLength;  // Mise à jour automatique
-
-    // Fonction récursive pour collecter tous les appareils d'un segment et tous ses descendants
-    std::function<void(const NetworkSegment&, std::vector<Fixture>&)> collectAllFixtures;
-    collectAllFixtures = [&](const NetworkSegment& seg, std::vector<Fixture>& fixtures) {
-        // Ajouter les fixtures de ce segment
-        fixtures.insert(fixtures.end(), seg.fixtures.begin(), seg.fixtures.end());
-
-        // Ajouter récursivement les fixtures de tous les enfants
-        for (const auto& otherSegment : networkParams.segments) {
-            if (otherSegment.parentId == seg.id) {
-                collectAllFixtures(otherSegment, fixtures);
+            // Segment PARENT : somme des débits des enfants + appareils directs
+            for (size_t child : children(i)) {
+                for (size_t t = 0; t < FixtureTypeCount; ++t) {
+                    servedFixtures[i][t] += servedFixtures[child][t];
+                }
+                flowRates[i] += flowRates[child];
             }
-        }
-    };
-
-    // Fonction récursive pour calculer un segment BOTTOM-UP (enfants avant parents)
-    std::function<void(NetworkSegment&, double)> calculateSegmentRecursive;
-
-    calculateSegmentRecursive = [&](NetworkSegment& segment, double inletPressure) {
-        segment.inletPressure = inletPressure;
-
-        // ÉTAPE 1: Calculer d'abord TOUS les enfants (BOTTOM-UP)
-        // Collecter les références des enfants directs
-        std::vector<NetworkSegment*> children;
-        for (auto& childSegment : networkParams.segments) {
-            if (childSegment.parentId == segment.id) {
-                children.push_back(&childSegment);
-                // Calculer récursivement l'enfant AVANT le parent
-                // Note: On passe la pression d'entrée actuelle, elle sera mise à jour après
-                calculateSegmentRecursive(childSegment, inletPressure);
+            if (!segments[i].fixtures.empty()) {
+                flowRates[i] += PipeCalculator::calculateFlowRate(segments[i].fixtures);
             }
         }
+    }
+};
 
-        // ÉTAPE 2: Déterminer le débit du segment
-        double segmentFlowRate = 0.0;
+void PipeCalculator::calculateNetwork(NetworkCalculationParameters& networkParams) {
+    // Mêmes données déjà calculées : résultats repris du cache
+    if (resultCache && resultCache->lookup(networkParams)) {
+        return;
+    }
 
-        // Collecter TOUS les appareils desservis par ce segment (y compris enfants)
-        std::vector<Fixture> allServedFixtures;
-        collectAllFixtures(segment, allServedFixtures);
+    NetworkTopology topology(networkParams.segments);
 
-        // Calculer le nombre total d'appareils desservis
-        int totalServedFixtures = 0;
-        double totalServedFlowRate = 0.0;
-        for (const auto& fixture : allServedFixtures) {
-            totalServedFixtures += fixture.quantity;
-            totalServedFlowRate += fixture.flowRate * fixture.quantity;
-        }
+    // Calcul automatique de la longueur de boucle = somme des longueurs de tous les segments
+    networkParams.loopLength = topology.totalLength;
 
-        if (children.empty()) {
-            // Segment FEUILLE (sans enfants) : calculer depuis les fixtures avec coeff simultanéité
-            segmentFlowRate = calculateFlowRate(segment.fixtures);
-        } else {
-            // Segment PARENT (avec enfants) : somme des débits des enfants directs
-            // + les fixtures directes sur ce segment s'il y en a
-            for (const auto* child : children) {
-                segmentFlowRate += child->result.flowRate;
-            }
+    // PASSE 1: Dimensionnement BOTTOM-UP (enfants avant parents)
+    for (size_t index : topology.postOrder()) {
+        sizeSegment(networkParams, topology, index);
+    }
 
-            // Ajouter les fixtures directes de ce segment (si présentes)
-            if (!segment.fixtures.empty()) {
-                segmentFlowRate += calculateFlowRate(segment.fixtures);
-            }
+    solveNetwork(networkParams, topology);
+
+    if (resultCache) {
+        resultCache->store(networkParams);
+    }
+}
+
+MultiNetworkResult PipeCalculator::calculateAllNetworks(const NetworkCalculationParameters& base) {
+    NetworkTopology topology(base.segments);
+
+    MultiNetworkResult result;
+    for (size_t type = 0; type < NetworkTypeCount; ++type) {
+        NetworkCalculationParameters& network = result.networks[type];
+        network = base;
+        network.networkType = static_cast<NetworkType>(type);
+        network.loopLength = topology.totalLength;
+        for (auto& segment : network.segments) {
+            segment.hasReturnLine = (network.networkType == NetworkType::HotWaterWithLoop);
         }
+    }
 
-        // ÉTAPE 3: Déterminer le DN minimal requis = max des DN de tous les enfants directs
-        int minRequiredDiameter = 0;
-        for (const auto* child : children) {
-            if (child->result.nominalDiameter > minRequiredDiameter) {
-                minRequiredDiameter = child->result.nominalDiameter;
-            }
+    // Réseaux déjà calculés : résultats repris du cache, seuls les autres sont calculés
+    std::vector<NetworkCalculationParameters*> pending;
+    for (auto& network : result.networks) {
+        if (!resultCache || !resultCache->lookup(network)) {
+            pending.push_back(&network);
         }
+    }
+    if (pending.empty()) {
+        return result;
+    }
 
-        // ÉTAPE 4: Créer les paramètres de calcul pour ce segment
-        CalculationParameters params;
-        params.networkType = networkParams.networkType;
-        params.material = networkParams.material;
-        params.length = segment.length;
-        params.heightDifference = segment.heightDifference;
-        params.supplyPressure = inletPressure;
-        params.requiredPressure = networkParams.requiredPressure;
-        params.fixtures = segment.fixtures;  // Seulement les fixtures directes
-        params.minDiameter = minRequiredDiameter;  // DN minimal = max DN des enfants
-        params.overrideFlowRate = (!children.empty()) ? segmentFlowRate : 0.0;  // Forcer débit si parent
-        params.loopLength = networkParams.loopLength;
-        params.ambientTemperature = networkParams.ambientTemperature;
-        params.waterTemperature = networkParams.waterTemperature;
-        params.insulationThickness = networkParams.insulationThickness;
-
-        // ÉTAPE 5: Calculer ce segment (le DN sera correct maintenant)
-        segment.result = calculate(params);
-
-        // Mettre à jour les détails avec le nombre TOTAL d'appareils desservis (pour le PDF)
-        segment.result.details.totalFixtures = totalServedFixtures;
-        segment.result.details.totalFixtureFlowRate = totalServedFlowRate;
-        segment.result.details.simultaneityCoeff = getSimultaneityCoefficient(totalServedFixtures);
-
-        // ÉTAPE 6: Calculer la pression de sortie du parent
-        segment.outletPressure = segment.inletPressure - (segment.result.pressureDrop / 10.0);
+    // PASSE 1 commune : un seul parcours ascendant dimensionne les réseaux segment par segment,
+    // le frottement d'un segment étant évalué une fois pour les réseaux qui le partagent
+    for (size_t index : topology.postOrder()) {
+        FrictionEvaluation friction;
+        for (NetworkCalculationParameters* network : pending) {
+            sizeSegment(*network, topology, index, &friction);
+        }
+    }
+
+    for (NetworkCalculationParameters* network : pending) {
+        solveNetwork(*network, topology);
+        if (resultCache) {
+            resultCache->store(*network);
+        }
+    }
+    return result;
+}
 
-        // ÉTAPE 7: Mettre à jour la pression et température d'entrée de tous les enfants
-        // avec les valeurs de sortie correctes du parent
-        // IMPORTANT: Propagation RÉCURSIVE pour tous les descendants
+void PipeCalculator::sizeSegment(NetworkCalculationParameters& networkParams, const NetworkTopology& topology,
+                                 size_t index, FrictionEvaluation* shared) {
+    NetworkSegment& segment = networkParams.segments[index];
+    const bool isParent = !topology.isLeaf(index);
+
+    // ÉTAPE 1: DN minimal requis = max des DN de tous les enfants directs (déjà dimensionnés)
+    int minRequiredDiameter = 0;
+    for (size_t c : topology.children(index)) {
+        minRequiredDiameter = std::max(minRequiredDiameter, networkParams.segments[c].result.nominalDiameter);
+    }
+
+    // ÉTAPE 2: Paramètres de calcul du segment (débit des parents = somme des enfants + appareils directs)
+    CalculationParameters params;
+    params.networkType = networkParams.networkType;
+    params.material = networkParams.material;
+    params.length = segment.length;
+    params.heightDifference = segment.heightDifference;
+    params.supplyPressure = networkParams.supplyPressure;
+    params.requiredPressure = networkParams.requiredPressure;
+    params.fixtures = segment.fixtures;  // Seulement les fixtures directes
+    params.minDiameter = minRequiredDiameter;  // DN minimal = max DN des enfants
+    params.overrideFlowRate = isParent ? topology.flowRates[index] : 0.0;  // Forcer débit si parent
+    params.loopLength = networkParams.loopLength;
+    params.ambientTemperature = networkParams.ambientTemperature;
+    params.waterTemperature = networkParams.waterTemperature;
+    params.insulationThickness = networkParams.insulationThickness;
+    params.temperatureDependentProperties = networkParams.temperatureDependentProperties;
+    params.frictionModel = networkParams.frictionModel;
+
+    // ÉTAPE 3: Calculer ce segment (le DN sera correct maintenant)
+    segment.result = calculate(params, shared);
+
+    // Mettre à jour les détails avec le nombre TOTAL d'appareils desservis (pour le PDF)
+    const FixtureCounts& served = topology.servedFixtures[index];
+    int totalServedFixtures = FixtureCatalogue::totalCount(served);
+    segment.result.details.totalFixtures = totalServedFixtures;
+    segment.result.details.totalFixtureFlowRate = FixtureCatalogue::instance().totalFlowRate(served);
+    segment.result.details.simultaneityCoeff = getSimultaneityCoefficient(totalServedFixtures);
+
+    // Pressions provisoires : les pressions définitives sont propagées en PASSE 5
+    segment.inletPressure = networkParams.supplyPressure;
+    segment.outletPressure = segment.inletPressure - (segment.result.pressureDrop / 10.0);
+}
 
-        // Fonction récursive pour propager les températures à tous les descendants
-        std::function<void(NetworkSegment&, double)> propagateTemperatureRecursive;
-        propagateTemperatureRecursive = [&](NetworkSegment& seg, double inletTemp) {
-            // Mettre à jour la température d'entrée
+void PipeCalculator::solveNetwork(NetworkCalculationParameters& networkParams, const NetworkTopology& topology) {
+    auto& segments = networkParams.segments;
+    const bool hotWater = (networkParams.networkType == NetworkType::HotWater ||
+                           networkParams.networkType == NetworkType::HotWaterWithLoop);
+
+    // PASSE 1B: Pour ECS, propager les températures de la source vers les appareils :
+    // la température de sortie du parent devient la température d'entrée de chaque enfant
+    if (hotWater) {
+        for (size_t index : topology.preOrder()) {
+            if (topology.parent(index) == NetworkTree::None) {
+                continue;  // Racine : température d'entrée = température de production
+            }
+            NetworkSegment& seg = segments[index];
+            double inletTemp = segments[topology.parent(index)].result.outletTemperature;
             seg.result.inletTemperature = inletTemp;
 
             // Recalculer les pertes thermiques avec la bonne température
@@ -449,42 +432,11 @@ void PipeCalculator::calculateNetwork(NetworkCalculationParameters& networkParam
                                                                seg.result.details);
 
             // Recalculer la température de sortie
-            if (seg.result.flowRate > 0) {
-                double flowRateKgPerS = seg.result.flowRate / 60.0;
-                double specificHeat = 4186.0;
-                double temperatureDrop = seg.result.heatLoss / (flowRateKgPerS * specificHeat);
-                seg.result.outletTemperature = inletTemp - temperatureDrop;
-                seg.result.details.temperatureDrop = temperatureDrop;
-            } else {
-                seg.result.outletTemperature = inletTemp;
-                seg.result.details.temperatureDrop = 0.0;
-            }
-
-            // Propager RÉCURSIVEMENT aux enfants de ce segment
-            for (auto& potentialChild : networkParams.segments) {
-                if (potentialChild.parentId == seg.id) {
-                    propagateTemperatureRecursive(potentialChild, seg.result.outletTemperature);
-                }
-            }
-        };
-
-        // Appliquer la propagation à tous les enfants directs
-        for (auto* child : children) {
-            child->inletPressure = segment.outletPressure;
-
-            // Pour ECS: propager la température de sortie du parent vers l'entrée des enfants
-            if (networkParams.networkType == NetworkType::HotWater ||
-                networkParams.networkType == NetworkType::HotWaterWithLoop) {
-                double childInletTemp = segment.result.outletTemperature;
-                propagateTemperatureRecursive(*child, childInletTemp);
-            }
-        }
-    };
-
-    // Trouver et calculer tous les segments racines (sans parent)
-    for (auto& segment : networkParams.segments) {
-        if (segment.parentId.empty()) {
-            calculateSegmentRecursive(segment, networkParams.supplyPressure);
+            double temperatureDrop = calculateTemperatureDrop(
+                seg.result.heatLoss, seg.result.flowRate,
+                getWaterState(inletTemp, networkParams.temperatureDependentProperties));
+            seg.result.outletTemperature = inletTemp - temperatureDrop;
+            seg.result.details.temperatureDrop = temperatureDrop;
         }
     }
 
@@ -496,42 +448,76 @@ void PipeCalculator::calculateNetwork(NetworkCalculationParameters& networkParam
         // Les antennes (branches sans retour) ne participent PAS au calcul thermique de bouclage.
 
         // ΔT acceptable sur une boucle
-        const double deltaT = 5.0;  // °C
+        const double deltaT = LoopTemperatureDrop;  // °C
 
         // Vitesses min/max recommandées pour le retour
         const double minReturnVelocity = 0.2;  // m/s
         const double maxReturnVelocity = 0.5;  // m/s
 
-        // PASSE 3: Calcul récursif bottom-up des débits de retour et températures
-        // UNIQUEMENT pour les segments qui ont une ligne de retour (hasReturnLine = true)
-
-        std::function<void(NetworkSegment&)> calculateRetourRecursive;
-        calculateRetourRecursive = [&](NetworkSegment& segment) {
-            // D'abord, calculer récursivement tous les enfants
-            std::vector<NetworkSegment*> children;
-            for (auto& child : networkParams.segments) {
-                if (child.parentId == segment.id) {
-                    children.push_back(&child);
-                    calculateRetourRecursive(child);
+        // Enfants d'un segment qui ont un retour (les antennes ne participent pas au bouclage)
+        auto forEachReturnChild = [&](size_t index, auto&& visit) {
+            for (size_t c : topology.children(index)) {
+                NetworkSegment& child = segments[c];
+                if (child.hasReturnLine && child.result.hasReturn) {
+                    visit(child);
                 }
             }
+        };
 
-            // RÈGLE 1 : Vérifier si ce segment possède une ligne de retour
-            if (!segment.hasReturnLine) {
-                // ANTENNE : pas de retour, pas de calcul thermique de bouclage
-                segment.result.hasReturn = false;
-                segment.result.returnFlowRate = 0.0;
-                segment.result.returnNominalDiameter = 0;
-                segment.result.returnActualDiameter = 0.0;
-                segment.result.returnVelocity = 0.0;
-                segment.result.returnInletTemperature = 0.0;
-                segment.result.returnOutletTemperature = 0.0;
-                segment.result.returnTemperature = 0.0;
-                return;  // Ne pas calculer le retour pour ce segment
+        // Température d'entrée retour : sortie aller pour une feuille, MÉLANGE PONDÉRÉ par les débits
+        // des enfants avec retour pour un parent. Formule : T_mélange = (Q₁×T₁ + Q₂×T₂ + ...) / (Q₁ + Q₂ + ...)
+        auto mixReturnInletTemperature = [&](size_t index) {
+            NetworkSegment& segment = segments[index];
+            if (topology.isLeaf(index)) {
+                // Segment FEUILLE : l'eau passe de l'aller au retour
+                segment.result.returnInletTemperature = segment.result.outletTemperature;
+                return;
+            }
+
+            double sumWeightedTemp = 0.0;
+            double sumFlow = 0.0;
+            double sumTemp = 0.0;
+            int childrenWithReturn = 0;
+            forEachReturnChild(index, [&](NetworkSegment& child) {
+                sumWeightedTemp += child.result.returnFlowRate * child.result.returnOutletTemperature;
+                sumFlow += child.result.returnFlowRate;
+                sumTemp += child.result.returnOutletTemperature;
+                childrenWithReturn++;
+            });
+
+            if (sumFlow > 0.0001) {
+                segment.result.returnInletTemperature = sumWeightedTemp / sumFlow;
+            } else if (childrenWithReturn > 0) {
+                // Cas dégénéré : moyenne simple si débits nuls mais enfants avec retour
+                segment.result.returnInletTemperature = sumTemp / childrenWithReturn;
+            } else {
+                // Aucun enfant avec retour : utiliser la température de sortie aller
+                segment.result.returnInletTemperature = segment.result.outletTemperature;
             }
+        };
+
+        // Pertes thermiques dans le retour et température de sortie retour
+        // Formule : ΔT = Pertes (W) / (ρ × cp × Q_retour), soit ≈ Pertes / (1160 × Q (m³/h))
+        auto updateReturnOutletTemperature = [&](NetworkSegment& segment, double returnFlowRate) {
+            double returnHeatLoss = calculateHeatLoss(
+                segment.length, segment.result.returnActualDiameter,
+                networkParams.insulationThickness,
+                segment.result.returnInletTemperature, networkParams.ambientTemperature);
+
+            double temperatureDrop = calculateTemperatureDrop(
+                returnHeatLoss, returnFlowRate,
+                getWaterState(segment.result.returnInletTemperature, networkParams.temperatureDependentProperties));
 
-            // RÈGLE 2 : Ce segment a un retour, calculer le débit
-            if (children.empty()) {
+            segment.result.returnOutletTemperature = segment.result.returnInletTemperature - temperatureDrop;
+
+            // Compatibilité avec ancien champ
+            segment.result.returnTemperature = segment.result.returnOutletTemperature;
+        };
+
+        // Débit de retour (feuille : pertes aller, parent : somme des enfants avec retour) et DN retour
+        auto updateReturnFlowRate = [&](size_t index) {
+            NetworkSegment& segment = segments[index];
+            if (topology.isLeaf(index)) {
                 // Segment FEUILLE avec retour : calcul du débit basé sur les pertes locales
                 // Q_retour (L/h) = Pertes (W) / (1.16 × ΔT)
                 double returnFlowRateLh = segment.result.heatLoss / (1.16 * deltaT);
@@ -540,17 +526,13 @@ void PipeCalculator::calculateNetwork(NetworkCalculationParameters& networkParam
                 // Segment PARENT : somme UNIQUEMENT des débits de retour des enfants QUI ONT UN RETOUR
                 // RÈGLE 3 : Les antennes ne contribuent PAS au débit de retour du parent
                 double totalReturnFlow = 0.0;
-                for (const auto* child : children) {
-                    if (child->hasReturnLine && child->result.hasReturn) {
-                        totalReturnFlow += child->result.returnFlowRate;
-                    }
-                }
+                forEachReturnChild(index, [&](NetworkSegment& child) {
+                    totalReturnFlow += child.result.returnFlowRate;
+                });
                 segment.result.returnFlowRate = totalReturnFlow;
             }
 
-            // ÉTAPE 2 : Calculer le DN retour basé sur le débit thermique
-            // Utilisation de la nouvelle fonction qui trouve automatiquement le plus petit DN
-            // tout en respectant les contraintes 0.2 ≤ v ≤ 0.5 m/s
+            // DN retour : plus petit DN respectant les contraintes 0.2 ≤ v ≤ 0.5 m/s
             segment.result.hasReturn = true;
             auto returnResult = selectReturnDiameter(
                 segment.result.returnFlowRate, networkParams.material, minReturnVelocity, maxReturnVelocity);
@@ -563,77 +545,54 @@ void PipeCalculator::calculateNetwork(NetworkCalculationParameters& networkParam
             if (returnResult.flowRateAdjusted) {
                 segment.result.returnFlowRate = returnResult.adjustedFlowRate;
             }
+        };
 
-            // ÉTAPE 3 : Calculer la température d'entrée retour (returnInletTemperature)
-            if (children.empty()) {
-                // Segment FEUILLE : l'eau passe de l'aller au retour
-                segment.result.returnInletTemperature = segment.result.outletTemperature;
-            } else {
-                // Segment PARENT : MÉLANGE PONDÉRÉ par les débits
-                // RÈGLE 4 : Ne considérer QUE les enfants qui ont un retour pour le mélange
-                // Formule : T_mélange = (Q₁×T₁ + Q₂×T₂ + ...) / (Q₁ + Q₂ + ...)
-                double sumWeightedTemp = 0.0;
-                double sumFlow = 0.0;
-                int childrenWithReturn = 0;
-
-                for (const auto* child : children) {
-                    if (child->hasReturnLine && child->result.hasReturn) {
-                        sumWeightedTemp += child->result.returnFlowRate * child->result.returnOutletTemperature;
-                        sumFlow += child->result.returnFlowRate;
-                        childrenWithReturn++;
-                    }
-                }
+        // PASSE 3: Calcul récursif bottom-up des débits de retour et températures
+        std::function<void(size_t)> calculateRetourRecursive;
+        calculateRetourRecursive = [&](size_t index) {
+            NetworkSegment& segment = segments[index];
 
-                if (sumFlow > 0.0001) {
-                    segment.result.returnInletTemperature = sumWeightedTemp / sumFlow;
-                } else if (childrenWithReturn > 0) {
-                    // Cas dégénéré : moyenne simple si débits nuls mais enfants avec retour
-                    double sumTemp = 0.0;
-                    for (const auto* child : children) {
-                        if (child->hasReturnLine && child->result.hasReturn) {
-                            sumTemp += child->result.returnOutletTemperature;
-                        }
-                    }
-                    segment.result.returnInletTemperature = sumTemp / childrenWithReturn;
-                } else {
-                    // Aucun enfant avec retour : utiliser la température de sortie aller
-                    segment.result.returnInletTemperature = segment.result.outletTemperature;
-                }
+            // ÉTAPE 1 : Calculer d'abord tous les enfants (y compris les antennes, remises à zéro)
+            for (size_t c : topology.children(index)) {
+                calculateRetourRecursive(c);
             }
 
-            // ÉTAPE 4 : Calculer les pertes thermiques dans le retour
-            double returnHeatLoss = calculateHeatLoss(
-                segment.length, segment.result.returnActualDiameter,
-                networkParams.insulationThickness,
-                segment.result.returnInletTemperature, networkParams.ambientTemperature);
-
-            // ÉTAPE 5 : Calculer la température de sortie retour
-            // Formule : ΔT = Pertes (W) / (1160 × Q_retour (m³/h))
-            double returnFlowRateM3h = segment.result.returnFlowRate * 60.0 / 1000.0;  // L/min → m³/h
-            double temperatureDrop = 0.0;
-            if (returnFlowRateM3h > 0.0001) {
-                temperatureDrop = returnHeatLoss / (1160.0 * returnFlowRateM3h);
+            // RÈGLE 1 : Vérifier si ce segment possède une ligne de retour
+            if (!segment.hasReturnLine) {
+                // ANTENNE : pas de retour, pas de calcul thermique de bouclage
+                segment.result.hasReturn = false;
+                segment.result.returnFlowRate = 0.0;
+                segment.result.returnNominalDiameter = 0;
+                segment.result.returnActualDiameter = 0.0;
+                segment.result.returnVelocity = 0.0;
+                segment.result.returnInletTemperature = 0.0;
+                segment.result.returnOutletTemperature = 0.0;
+                segment.result.returnTemperature = 0.0;
+                return;  // Ne pas calculer le retour pour ce segment
             }
 
-            segment.result.returnOutletTemperature = segment.result.returnInletTemperature - temperatureDrop;
+            // ÉTAPE 2 : Débit et DN retour
+            updateReturnFlowRate(index);
 
-            // Compatibilité avec ancien champ
-            segment.result.returnTemperature = segment.result.returnOutletTemperature;
+            // ÉTAPE 3 : Température d'entrée retour (returnInletTemperature)
+            mixReturnInletTemperature(index);
+
+            // ÉTAPES 4 et 5 : Pertes thermiques et température de sortie retour
+            updateReturnOutletTemperature(segment, segment.result.returnFlowRate);
         };
 
         // Calculer les débits et DN de retour initiaux depuis les segments racines
-        for (auto& segment : networkParams.segments) {
-            if (segment.parentId.empty()) {
-                calculateRetourRecursive(segment);
-            }
+        for (size_t root : topology.roots()) {
+            calculateRetourRecursive(root);
         }
 
         // Déclarer les fonctions de recalcul (utilisées dans la boucle ET dans PASSE 4)
-        std::function<void(NetworkSegment&)> recalculateAllerTemperatures;
-        std::function<void(NetworkSegment&)> recalculateRetourTemperatures;
+        std::function<void(size_t)> recalculateAllerTemperatures;
+        std::function<void(size_t)> recalculateRetourTemperatures;
 
         // PASSE 3A: Recalcul des températures ALLER avec le débit de bouclage
-        recalculateAllerTemperatures = [&](NetworkSegment& segment) {
+        recalculateAllerTemperatures = [&](size_t index) {
+            NetworkSegment& segment = segments[index];
             // La température d'entrée a déjà été définie (source ou parent)
 
             // Recalculer les pertes thermiques ALLER avec détails
@@ -645,196 +604,93 @@ void PipeCalculator::calculateNetwork(NetworkCalculationParameters& networkParam
 
             // Calculer la chute de température ALLER avec le DÉBIT ALLER (flowRate)
             // PAS avec returnFlowRate ! L'aller transporte l'eau chaude consommée + bouclage
-            double temperatureDrop = 0.0;
-            if (segment.result.flowRate > 0.0001) {
-                double flowRateKgPerS = segment.result.flowRate / 60.0;  // L/min → kg/s
-                double specificHeat = 4186.0;  // J/(kg·K)
-                temperatureDrop = segment.result.heatLoss / (flowRateKgPerS * specificHeat);
-            }
+            double temperatureDrop = calculateTemperatureDrop(
+                segment.result.heatLoss, segment.result.flowRate,
+                getWaterState(segment.result.inletTemperature, networkParams.temperatureDependentProperties));
 
             segment.result.outletTemperature = segment.result.inletTemperature - temperatureDrop;
             segment.result.details.temperatureDrop = temperatureDrop;
 
             // Propager aux enfants
-            for (auto& child : networkParams.segments) {
-                if (child.parentId == segment.id) {
-                    // Température sortie parent = température entrée enfant
-                    child.result.inletTemperature = segment.result.outletTemperature;
-                    recalculateAllerTemperatures(child);
-                }
+            for (size_t c : topology.children(index)) {
+                // Température sortie parent = température entrée enfant
+                segments[c].result.inletTemperature = segment.result.outletTemperature;
+                recalculateAllerTemperatures(c);
             }
         };
 
         // PASSE 3B: Recalcul des températures RETOUR
-        recalculateRetourTemperatures = [&](NetworkSegment& segment) {
+        recalculateRetourTemperatures = [&](size_t index) {
+            NetworkSegment& segment = segments[index];
+
             // Si ce segment n'a pas de retour, ne rien faire
             if (!segment.hasReturnLine) {
                 return;
             }
 
             // D'abord, calculer récursivement tous les enfants
-            std::vector<NetworkSegment*> children;
-            for (auto& child : networkParams.segments) {
-                if (child.parentId == segment.id) {
-                    children.push_back(&child);
-                    recalculateRetourTemperatures(child);
-                }
+            for (size_t c : topology.children(index)) {
+                recalculateRetourTemperatures(c);
             }
 
-            // Calculer returnInletTemperature du segment actuel
-            if (children.empty()) {
-                // Segment FEUILLE : l'eau passe de l'aller au retour
-                segment.result.returnInletTemperature = segment.result.outletTemperature;
-            } else {
-                // Segment PARENT : MÉLANGE PONDÉRÉ par les débits
-                // RÈGLE : Ne considérer QUE les enfants qui ont un retour
-                double sumWeightedTemp = 0.0;
-                double sumFlow = 0.0;
-                int childrenWithReturn = 0;
-
-                for (const auto* child : children) {
-                    if (child->hasReturnLine && child->result.hasReturn) {
-                        sumWeightedTemp += child->result.returnFlowRate * child->result.returnOutletTemperature;
-                        sumFlow += child->result.returnFlowRate;
-                        childrenWithReturn++;
-                    }
-                }
+            mixReturnInletTemperature(index);
+            updateReturnOutletTemperature(segment, segment.result.returnFlowRate);
+        };
 
-                if (sumFlow > 0.0001) {
-                    segment.result.returnInletTemperature = sumWeightedTemp / sumFlow;
-                } else if (childrenWithReturn > 0) {
-                    double sumTemp = 0.0;
-                    for (const auto* child : children) {
-                        if (child->hasReturnLine && child->result.hasReturn) {
-                            sumTemp += child->result.returnOutletTemperature;
-                        }
-                    }
-                    segment.result.returnInletTemperature = sumTemp / childrenWithReturn;
-                } else {
-                    segment.result.returnInletTemperature = segment.result.outletTemperature;
-                }
+        // Recalcul des débits de retour basés sur les NOUVELLES pertes thermiques
+        std::function<void(size_t)> recalculateReturnFlows;
+        recalculateReturnFlows = [&](size_t index) {
+            // Si ce segment n'a pas de retour, ne rien faire
+            if (!segments[index].hasReturnLine) {
+                return;
             }
 
-            // Calculer les pertes thermiques dans le retour
-            double returnHeatLoss = calculateHeatLoss(
-                segment.length, segment.result.returnActualDiameter,
-                networkParams.insulationThickness,
-                segment.result.returnInletTemperature, networkParams.ambientTemperature);
-
-            // Calculer la température de sortie retour
-            double returnFlowRateM3h = segment.result.returnFlowRate * 60.0 / 1000.0;
-            double temperatureDrop = 0.0;
-            if (returnFlowRateM3h > 0.0001) {
-                temperatureDrop = returnHeatLoss / (1160.0 * returnFlowRateM3h);
+            // D'abord, calculer récursivement tous les enfants
+            for (size_t c : topology.children(index)) {
+                recalculateReturnFlows(c);
             }
 
-            segment.result.returnOutletTemperature = segment.result.returnInletTemperature - temperatureDrop;
-            segment.result.returnTemperature = segment.result.returnOutletTemperature;
+            updateReturnFlowRate(index);
         };
 
         // BOUCLE ITÉRATIVE pour converger pertes/débits/températures
         // Les pertes dépendent des températures, qui dépendent des débits, qui dépendent des pertes !
         const int maxIterations = 10;
         bool converged = false;
+        std::vector<double> oldReturnFlows(segments.size());
 
         for (int iteration = 0; iteration < maxIterations && !converged; iteration++) {
             // Sauvegarder les débits actuels pour vérifier la convergence
-            std::map<std::string, double> oldReturnFlows;
-            for (const auto& segment : networkParams.segments) {
-                oldReturnFlows[segment.id] = segment.result.returnFlowRate;
+            for (size_t i = 0; i < segments.size(); ++i) {
+                oldReturnFlows[i] = segments[i].result.returnFlowRate;
             }
 
             // Initialiser température source et calculer récursivement les températures ALLER
-            for (auto& segment : networkParams.segments) {
-                if (segment.parentId.empty()) {
-                    segment.result.inletTemperature = networkParams.waterTemperature;
-                    recalculateAllerTemperatures(segment);
-                }
+            for (size_t root : topology.roots()) {
+                segments[root].result.inletTemperature = networkParams.waterTemperature;
+                recalculateAllerTemperatures(root);
             }
 
-            // Recalculer les débits de retour basés sur les NOUVELLES pertes thermiques
-            // (qui ont été recalculées dans recalculateAllerTemperatures avec les bonnes températures)
-            std::function<void(NetworkSegment&)> recalculateReturnFlows;
-            recalculateReturnFlows = [&](NetworkSegment& segment) {
-                // Si ce segment n'a pas de retour, ne rien faire
-                if (!segment.hasReturnLine) {
-                    return;
-                }
-
-                // D'abord, calculer récursivement tous les enfants
-                std::vector<NetworkSegment*> children;
-                for (auto& child : networkParams.segments) {
-                    if (child.parentId == segment.id) {
-                        children.push_back(&child);
-                        recalculateReturnFlows(child);
-                    }
-                }
-
-                // Recalculer le débit de retour basé sur les pertes actualisées
-                if (children.empty()) {
-                    // Segment FEUILLE avec retour : calcul du débit basé sur les pertes actualisées
-                    // Q_retour (L/h) = Pertes (W) / (1.16 × ΔT)
-                    double returnFlowRateLh = segment.result.heatLoss / (1.16 * deltaT);
-                    segment.result.returnFlowRate = returnFlowRateLh / 60.0;  // L/h → L/min
-                } else {
-                    // Segment PARENT : somme UNIQUEMENT des débits de retour des enfants QUI ONT UN RETOUR
-                    double totalReturnFlow = 0.0;
-                    for (const auto* child : children) {
-                        if (child->hasReturnLine && child->result.hasReturn) {
-                            totalReturnFlow += child->result.returnFlowRate;
-                        }
-                    }
-                    segment.result.returnFlowRate = totalReturnFlow;
-                }
-
-                // Recalculer le DN retour basé sur le nouveau débit
-                auto returnResult = selectReturnDiameter(
-                    segment.result.returnFlowRate, networkParams.material, minReturnVelocity, maxReturnVelocity);
-
-                segment.result.returnNominalDiameter = returnResult.nominalDiameter;
-                segment.result.returnActualDiameter = returnResult.actualDiameter;
-                segment.result.returnVelocity = returnResult.velocity;
-
-                // Si le débit a été augmenté pour respecter vmin, mettre à jour le débit
-                if (returnResult.flowRateAdjusted) {
-                    segment.result.returnFlowRate = returnResult.adjustedFlowRate;
-                }
-            };
-
             // Recalculer les débits de retour depuis les segments racines
-            for (auto& segment : networkParams.segments) {
-                if (segment.parentId.empty()) {
-                    recalculateReturnFlows(segment);
-                }
+            // (pertes thermiques recalculées dans recalculateAllerTemperatures avec les bonnes températures)
+            for (size_t root : topology.roots()) {
+                recalculateReturnFlows(root);
             }
 
             // PASSE 3B: Recalculer les températures RETOUR avec les nouvelles températures ALLER
-            // Recalculer les températures retour depuis les segments racines
-            for (auto& segment : networkParams.segments) {
-                if (segment.parentId.empty()) {
-                    recalculateRetourTemperatures(segment);
-                }
+            for (size_t root : topology.roots()) {
+                recalculateRetourTemperatures(root);
             }
 
             // Vérifier la convergence : différence de débits < 1%
             converged = true;
-            double maxDiff = 0.0;
-            for (const auto& segment : networkParams.segments) {
-                double oldFlow = oldReturnFlows[segment.id];
-                double newFlow = segment.result.returnFlowRate;
-                if (oldFlow > 0.0001) {
-                    double diff = std::abs(newFlow - oldFlow) / oldFlow;
-                    maxDiff = std::max(maxDiff, diff);
-                    if (diff > 0.01) {  // 1% de tolérance
-                        converged = false;
-                    }
+            for (size_t i = 0; i < segments.size(); ++i) {
+                double oldFlow = oldReturnFlows[i];
+                double newFlow = segments[i].result.returnFlowRate;
+                if (oldFlow > 0.0001 && std::abs(newFlow - oldFlow) / oldFlow > 0.01) {  // 1% de tolérance
+                    converged = false;
                 }
             }
-
-            // Si convergé, sortir de la boucle
-            if (converged) {
-                break;
-            }
         }
 
         // PASSE 4: Ajuster les débits de retour pour respecter la contrainte de température
@@ -842,8 +698,10 @@ void PipeCalculator::calculateNetwork(NetworkCalculationParameters& networkParam
         double minReturnTemp = networkParams.waterTemperature - deltaT;  // Ex: 60°C - 5°C = 55°C
 
         // Fonction pour recalculer les températures avec un nouveau débit
-        std::function<void(NetworkSegment&, double)> recalculateTemperaturesWithFlow;
-        recalculateTemperaturesWithFlow = [&](NetworkSegment& segment, double newFlowRate) {
+        std::function<void(size_t, double)> recalculateTemperaturesWithFlow;
+        recalculateTemperaturesWithFlow = [&](size_t index, double newFlowRate) {
+            NetworkSegment& segment = segments[index];
+
             // Recalculer DN et vitesse avec le nouveau débit
             auto returnResult = selectReturnDiameter(
                 newFlowRate, networkParams.material, minReturnVelocity, maxReturnVelocity);
@@ -856,238 +714,216 @@ void PipeCalculator::calculateNetwork(NetworkCalculationParameters& networkParam
             segment.result.returnFlowRate = returnResult.flowRateAdjusted ?
                 returnResult.adjustedFlowRate : newFlowRate;
 
-            // Recalculer les pertes thermiques retour avec le nouveau DN
-            double returnHeatLoss = calculateHeatLoss(
-                segment.length, segment.result.returnActualDiameter,
-                networkParams.insulationThickness,
-                segment.result.returnInletTemperature, networkParams.ambientTemperature);
-
-            // Recalculer température de sortie retour
-            double returnFlowRateM3h = newFlowRate * 60.0 / 1000.0;
-            double temperatureDrop = 0.0;
-            if (returnFlowRateM3h > 0.0001) {
-                temperatureDrop = returnHeatLoss / (1160.0 * returnFlowRateM3h);
-            }
-
-            segment.result.returnOutletTemperature = segment.result.returnInletTemperature - temperatureDrop;
-            segment.result.returnTemperature = segment.result.returnOutletTemperature;
+            // Recalculer les pertes thermiques et la température de sortie retour avec le nouveau DN
+            updateReturnOutletTemperature(segment, newFlowRate);
 
             // Propager le nouveau débit aux enfants proportionnellement
             // RÈGLE : Propager uniquement aux enfants qui ont un retour
-            std::vector<NetworkSegment*> children;
+            std::vector<size_t> children;
             double oldTotalChildFlow = 0.0;
-            for (auto& child : networkParams.segments) {
-                if (child.parentId == segment.id && child.hasReturnLine && child.result.hasReturn) {
-                    children.push_back(&child);
+            for (size_t c : topology.children(index)) {
+                const NetworkSegment& child = segments[c];
+                if (child.hasReturnLine && child.result.hasReturn) {
+                    children.push_back(c);
                     oldTotalChildFlow += child.result.returnFlowRate;
                 }
             }
 
             if (!children.empty() && oldTotalChildFlow > 0.0001) {
                 // Distribuer le nouveau débit proportionnellement aux enfants QUI ONT UN RETOUR
-                for (auto* child : children) {
-                    double ratio = child->result.returnFlowRate / oldTotalChildFlow;
+                for (size_t child : children) {
+                    double ratio = segments[child].result.returnFlowRate / oldTotalChildFlow;
                     double childNewFlow = newFlowRate * ratio;
-                    recalculateTemperaturesWithFlow(*child, childNewFlow);
+                    recalculateTemperaturesWithFlow(child, childNewFlow);
                 }
 
                 // Recalculer le mélange pondéré avec les nouveaux débits
                 double sumWeightedTemp = 0.0;
                 double sumFlow = 0.0;
-                for (const auto* child : children) {
-                    sumWeightedTemp += child->result.returnFlowRate * child->result.returnOutletTemperature;
-                    sumFlow += child->result.returnFlowRate;
+                for (size_t child : children) {
+                    sumWeightedTemp += segments[child].result.returnFlowRate * segments[child].result.returnOutletTemperature;
+                    sumFlow += segments[child].result.returnFlowRate;
                 }
                 if (sumFlow > 0.0001) {
                     segment.result.returnInletTemperature = sumWeightedTemp / sumFlow;
                 }
 
                 // Recalculer la sortie retour du parent avec la nouvelle inlet
-                returnHeatLoss = calculateHeatLoss(
-                    segment.length, segment.result.returnActualDiameter,
-                    networkParams.insulationThickness,
-                    segment.result.returnInletTemperature, networkParams.ambientTemperature);
-
-                temperatureDrop = 0.0;
-                if (returnFlowRateM3h > 0.0001) {
-                    temperatureDrop = returnHeatLoss / (1160.0 * returnFlowRateM3h);
-                }
-                segment.result.returnOutletTemperature = segment.result.returnInletTemperature - temperatureDrop;
-                segment.result.returnTemperature = segment.result.returnOutletTemperature;
+                updateReturnOutletTemperature(segment, newFlowRate);
             }
 
             // Après avoir propagé les nouveaux débits, recalculer toutes les températures
             // ALLER (top-down) puis RETOUR (bottom-up) depuis ce segment
 
             // Recalculer températures ALLER avec nouveau débit
-            recalculateAllerTemperatures(segment);
+            recalculateAllerTemperatures(index);
 
             // Recalculer températures RETOUR avec nouvelles températures aller
-            recalculateRetourTemperatures(segment);
+            recalculateRetourTemperatures(index);
         };
 
         // Vérifier et ajuster chaque segment racine
-        for (auto& segment : networkParams.segments) {
-            if (segment.parentId.empty()) {
-                // Vérifier si la température finale respecte la contrainte
-                if (segment.result.returnOutletTemperature < minReturnTemp) {
-                    // Calculer le débit nécessaire pour atteindre exactement minReturnTemp
-                    // On fait plusieurs itérations si nécessaire
-                    const int maxIterations = 10;
-                    for (int i = 0; i < maxIterations; i++) {
-                        double currentTemp = segment.result.returnOutletTemperature;
-                        double tempDeficit = minReturnTemp - currentTemp;
-
-                        if (tempDeficit < 0.1) break;  // Tolérance de 0.1°C
-
-                        // Augmenter le débit de 20% à chaque itération
-                        double newFlowRate = segment.result.returnFlowRate * 1.2;
-                        recalculateTemperaturesWithFlow(segment, newFlowRate);
-                    }
+        for (size_t root : topology.roots()) {
+            // Vérifier si la température finale respecte la contrainte
+            if (segments[root].result.returnOutletTemperature < minReturnTemp) {
+                // Calculer le débit nécessaire pour atteindre exactement minReturnTemp
+                // On fait plusieurs itérations si nécessaire
+                const int maxIterations = 10;
+                for (int i = 0; i < maxIterations; i++) {
+                    double currentTemp = segments[root].result.returnOutletTemperature;
+                    double tempDeficit = minReturnTemp - currentTemp;
+
+                    if (tempDeficit < 0.1) break;  // Tolérance de 0.1°C
+
+                    // Augmenter le débit de 20% à chaque itération
+                    double newFlowRate = segments[root].result.returnFlowRate * 1.2;
+                    recalculateTemperaturesWithFlow(root, newFlowRate);
                 }
             }
         }
     }
+
+    // PASSE 5: Pertes de charge à la température finale de chaque segment, puis
+    // propagation des pressions de la source vers les appareils (parents avant enfants)
+    for (size_t index : topology.preOrder()) {
+        NetworkSegment& segment = segments[index];
+        if (hotWater && networkParams.temperatureDependentProperties && segment.result.actualDiameter > 0.0) {
+            double meanTemperature = (segment.result.inletTemperature + segment.result.outletTemperature) / 2.0;
+            auto& details = segment.result.details;
+            details.linearPressureDrop = calculateLinearPressureDropWithDetails(
+                segment.result.flowRate, segment.result.actualDiameter, details.roughness,
+                segment.length, WaterProperties::atTemperature(meanTemperature),
+                networkParams.frictionModel, details);
+            details.singularPressureDrop = calculateSingularPressureDrop(details.linearPressureDrop);
+            segment.result.pressureDrop = details.linearPressureDrop + details.singularPressureDrop +
+                                          details.heightPressureDrop;
+        }
+
+        const size_t parent = topology.parent(index);
+        segment.inletPressure = (parent == NetworkTree::None) ? networkParams.supplyPressure
+                                                                  : segments[parent].outletPressure;
+        segment.outletPressure = segment.inletPressure - (segment.result.pressureDrop / 10.0);
+    }
+
+    // PASSE 6: Diagnostics sur l'état final (pressions propagées, températures de retour)
+    const double minReturnTemperature = networkParams.waterTemperature - LoopTemperatureDrop;
+    for (auto& segment : segments) {
+        SegmentDiagnostics& diagnostics = segment.result.diagnostics;
+        diagnostics.setAvailablePressure(segment.outletPressure);
+        if (segment.outletPressure < networkParams.requiredPressure) {
+            diagnostics.set(DiagnosticCode::InsufficientPressure, segment.outletPressure, networkParams.requiredPressure);
+        } else {
+            diagnostics.remove(DiagnosticCode::InsufficientPressure);
+        }
+
+        // Tolérance de 0.1°C, comme l'ajustement des débits de la PASSE 4
+        if (networkParams.networkType == NetworkType::HotWaterWithLoop && segment.parentId.empty()
+            && segment.result.returnOutletTemperature < minReturnTemperature - 0.1) {
+            diagnostics.set(DiagnosticCode::LowReturnTemperature,
+                            segment.result.returnOutletTemperature, minReturnTemperature);
+        }
+    }
 }
 
 double PipeCalculator::calculateVelocity(double flowRate, double diameter) {
     // V = Q / A
     // Q en m³/s, A en m²
-    double flowRateM3s = flowRate / 60000.0; // L/min -> m³/s
-    double area = M_PI * std::pow(diameter / 2000.0, 2); // mm² -> m²
-    return flowRateM3s / area;
+    return Kernels::velocity(flowRate, diameter);
 }
 
-int PipeCalculator::selectOptimalDiameter(double flowRate, PipeMaterial material, double maxVelocity, int minDiameter) {
-    std::vector<int> diameters = getAvailableDiameters(material);
-
-    for (int dn : diameters) {
-        // Ignorer les diamètres plus petits que le minimum requis
-        if (dn < minDiameter) {
-            continue;
-        }
-
-        double internalDia = getInternalDiameter(dn, material);
-        double velocity = calculateVelocity(flowRate, internalDia);
+double PipeCalculator::getMaxVelocity(NetworkType networkType) {
+    return (networkType == NetworkType::HotWaterWithLoop) ? 1.5 : 2.0;
+}
 
-        if (velocity <= maxVelocity) {
-            return dn;
-        }
+int PipeCalculator::selectOptimalDiameter(double flowRate, PipeMaterial material, double maxVelocity, int minDiameter) {
+    // Plus petit DN ≥ minDiameter dont la vitesse respecte le maximum (recherche dichotomique)
+    const PipeSeries& series = PipeCatalogue::instance().getSeries(material);
+    int index = series.selectIndex(flowRate, maxVelocity, minDiameter);
+    if (index >= 0) {
+        return series.sizes[index].nominalDiameter;
     }
 
     // Si aucun diamètre ne convient, retourner le plus grand disponible
     // ou le minDiameter si tous les diamètres sont trop petits
-    if (minDiameter > 0 && diameters.back() < minDiameter) {
+    if (minDiameter > 0 && series.nominalDiameters.back() < minDiameter) {
         return minDiameter;
     }
-    return diameters.back();
+    return series.nominalDiameters.back();
 }
 
 double PipeCalculator::getInternalDiameter(int nominalDiameter, PipeMaterial material) {
-    // Diamètres intérieurs approximatifs en mm
-    switch (material) {
-        case PipeMaterial::Copper:
-            // Pour le cuivre, le DN correspond approximativement au diamètre extérieur
-            // Épaisseur de paroi typique: 1mm pour DN10-22, 1.5mm pour DN28+
-            if (nominalDiameter <= 22) return nominalDiameter - 2.0;
-            else return nominalDiameter - 3.0;
-
-        case PipeMaterial::PEX:
-        case PipeMaterial::Multilayer:
-            // Pour PER et multicouche, épaisseur de paroi variable
-            if (nominalDiameter <= 16) return nominalDiameter - 2.0;
-            else if (nominalDiameter <= 20) return nominalDiameter - 2.3;
-            else if (nominalDiameter <= 26) return nominalDiameter - 3.0;
-            else return nominalDiameter - 3.5;
-
-        case PipeMaterial::Steel:
-            // Acier galvanisé: diamètre intérieur nominal
-            return nominalDiameter * 0.85; // Approximation
-    }
-    return nominalDiameter;
+    // Diamètre intérieur de la série active, estimation par matériau pour un DN hors série
+    const PipeSize* size = PipeCatalogue::instance().getSeries(material).findSize(nominalDiameter);
+    return size ? size->internalDiameter : PipeCatalogue::estimateInternalDiameter(nominalDiameter, material);
 }
 
 double PipeCalculator::getRoughness(PipeMaterial material) {
     // Rugosité absolue en mm
-    switch (material) {
-        case PipeMaterial::Copper:
-            return 0.0015; // Cuivre lisse
-        case PipeMaterial::PEX:
-        case PipeMaterial::Multilayer:
-            return 0.007; // PER/Multicouche très lisse
-        case PipeMaterial::Steel:
-            return 0.15; // Acier galvanisé
-    }
-    return 0.01;
+    return PipeCatalogue::instance().getSeries(material).roughness;
 }
 
 double PipeCalculator::calculatePressureDrop(double flowRate, double length, double diameter,
-                                             PipeMaterial material, NetworkType networkType) {
+                                             PipeMaterial material, const WaterState& water,
+                                             FrictionModel frictionModel) {
     double roughness = getRoughness(material);
-    double linearDrop = calculateLinearPressureDrop(flowRate, diameter, roughness, length);
+    double linearDrop = calculateLinearPressureDrop(flowRate, diameter, roughness, length, water, frictionModel);
     double singularDrop = calculateSingularPressureDrop(linearDrop);
 
     return linearDrop + singularDrop;
 }
 
 double PipeCalculator::calculateLinearPressureDrop(double flowRate, double diameter,
-                                                   double roughness, double length) {
+                                                   double roughness, double length,
+                                                   const WaterState& water, FrictionModel frictionModel) {
     // Formule de Darcy-Weisbach simplifiée
     // ΔP = λ * (L/D) * (ρV²/2)
     // Converti en mCE (mètres de colonne d'eau)
 
     double velocity = calculateVelocity(flowRate, diameter);
-    double reynolds = (velocity * diameter / 1000.0) / 0.000001; // Re = VD/ν, ν≈10⁻⁶ m²/s pour l'eau
+    double reynolds = Kernels::reynolds(velocity, diameter, water.kinematicViscosity); // Re = VD/ν
 
-    // Calcul du coefficient de perte de charge λ (Colebrook-White simplifié)
-    double lambda;
-    double relativeroughness = roughness / diameter;
-
-    if (reynolds < 2300) {
-        // Écoulement laminaire
-        lambda = 64.0 / reynolds;
-    } else {
-        // Écoulement turbulent - Formule de Swamee-Jain (approximation de Colebrook)
-        double a = std::pow(roughness / (3.7 * diameter) + 5.74 / std::pow(reynolds, 0.9), 2);
-        lambda = 0.25 / std::pow(std::log10(roughness / (3.7 * diameter) + 5.74 / std::pow(reynolds, 0.9)), 2);
-    }
+    // Calcul du coefficient de perte de charge λ (laminaire : 64/Re, turbulent : selon la méthode)
+    double lambda = FrictionFactor::compute(reynolds, roughness / diameter, frictionModel);
 
     // Perte de charge en mCE
-    double pressureDropPa = lambda * (length / (diameter / 1000.0)) * (1000.0 * std::pow(velocity, 2) / 2.0);
-    double pressureDropMce = pressureDropPa / (1000.0 * 9.81); // Pa -> mCE
-
-    return pressureDropMce;
+    return Kernels::darcyPressureDrop(lambda, length, diameter, velocity, water.density);
 }
 
 // Version avec détails pour le PDF
 double PipeCalculator::calculateLinearPressureDropWithDetails(double flowRate, double diameter,
                                                                double roughness, double length,
+                                                               const WaterState& water, FrictionModel frictionModel,
                                                                CalculationDetails& details) {
     double velocity = calculateVelocity(flowRate, diameter);
-    details.reynolds = (velocity * diameter / 1000.0) / 0.000001; // Re = VD/ν, ν≈10⁻⁶ m²/s pour l'eau
+    details.reynolds = Kernels::reynolds(velocity, diameter, water.kinematicViscosity); // Re = VD/ν
     details.relativeRoughness = roughness / diameter;
-    details.isLaminar = (details.reynolds < 2300);
+    details.isLaminar = (details.reynolds < FrictionFactor::LaminarLimit);
+    details.frictionModel = frictionModel;
 
-    // Calcul du coefficient de perte de charge λ (Colebrook-White simplifié)
-    if (details.isLaminar) {
-        // Écoulement laminaire
-        details.lambda = 64.0 / details.reynolds;
-    } else {
-        // Écoulement turbulent - Formule de Swamee-Jain (approximation de Colebrook)
-        details.lambda = 0.25 / std::pow(std::log10(roughness / (3.7 * diameter) + 5.74 / std::pow(details.reynolds, 0.9)), 2);
-    }
+    // Calcul du coefficient de perte de charge λ (laminaire : 64/Re, turbulent : selon la méthode)
+    details.lambda = FrictionFactor::compute(details.reynolds, details.relativeRoughness, frictionModel);
 
     // Perte de charge en mCE
-    double pressureDropPa = details.lambda * (length / (diameter / 1000.0)) * (1000.0 * std::pow(velocity, 2) / 2.0);
-    double pressureDropMce = pressureDropPa / (1000.0 * 9.81); // Pa -> mCE
+    return Kernels::darcyPressureDrop(details.lambda, length, diameter, velocity, water.density);
+}
+
+double PipeCalculator::calculateTemperatureDrop(double heatLoss, double flowRate, const WaterState& water) {
+    // ΔT = P / (ṁ × cp), ṁ = Q × ρ
+    double massFlow = (flowRate / 60000.0) * water.density;  // L/min → m³/s → kg/s
+    if (massFlow <= 1e-6) {
+        return 0.0;
+    }
+    return heatLoss / (massFlow * water.specificHeat);
+}
 
-    return pressureDropMce;
+WaterState PipeCalculator::getWaterState(double temperature, bool temperatureDependent) {
+    return temperatureDependent ? WaterProperties::atTemperature(temperature) : WaterState();
 }
 
 double PipeCalculator::calculateSingularPressureDrop(double linearDrop) {
     // Estimation des pertes singulières à 20% des pertes linéaires
     // (coudes, vannes, raccords, etc.)
-    return linearDrop * 0.20;
+    return linearDrop * SingularLossRatio;
 }
 
 double PipeCalculator::calculateHeatLoss(double length, double diameter, double insulation,
@@ -1095,58 +931,20 @@ double PipeCalculator::calculateHeatLoss(double length, double diameter, double
     // Calcul des pertes thermiques basé sur les résistances thermiques
     // Formule : q = (T_eau - T_amb) / R_tot  (W/m)
     //           Q = q × L  (W total)
-    // où R_tot = R_isol + R_ext
-    //    R_isol = ln(r2/r1) / (2πλ)
-    //    R_ext = 1 / (h_ext × 2πr2)
+    // où R_tot = R_isol + R_ext (voir PipeCatalogue::computeInsulation)
 
     // NOTE: 'diameter' est le diamètre INTÉRIEUR du tube
-    // Pour les pertes thermiques, on doit utiliser le rayon EXTÉRIEUR
-
-    // Rayon intérieur du tube (m)
-    double r_int = (diameter / 1000.0) / 2.0;
-
-    // Estimer l'épaisseur de paroi (approximation pour cuivre/PER)
-    double wallThickness = (diameter <= 22.0) ? 0.001 : 0.0015;  // en mètres
-
-    // Rayon extérieur du tube métallique (avant isolation)
-    double r1 = r_int + wallThickness;
-
-    // Rayon extérieur avec isolation (m)
-    double r2 = r1 + (insulation / 1000.0);
-
-    // Conductivité thermique de l'isolation (W/m·K)
-    // Valeur typique pour mousse polyuréthane ou polystyrène expansé
-    const double lambda = 0.04;
-
-    // Coefficient d'échange convectif extérieur (W/m²·K)
-    // Valeur typique pour convection naturelle dans l'air
-    const double h_ext = 10.0;
-
-    // Résistance thermique de l'isolation (K/W par mètre linéaire)
-    // R_isol = ln(r2/r1) / (2πλ)
-    double R_isol = 0.0;
-    if (r2 > r1 && r1 > 0) {
-        R_isol = std::log(r2 / r1) / (2.0 * M_PI * lambda);
-    }
-
-    // Résistance thermique externe par convection (K/W par mètre linéaire)
-    // R_ext = 1 / (h_ext × 2πr2)
-    double R_ext = 0.0;
-    if (r2 > 0) {
-        R_ext = 1.0 / (h_ext * 2.0 * M_PI * r2);
-    }
-
-    // Résistance thermique totale (K/W par mètre linéaire)
-    double R_tot = R_isol + R_ext;
+    // Résistances précalculées pour les diamètres du catalogue, calcul direct sinon
+    const PipeInsulation* tabulated = PipeCatalogue::instance().findInsulation(diameter, insulation);
+    double R_tot = tabulated ? tabulated->totalResistance
+                             : PipeCatalogue::computeInsulation(diameter, insulation).totalResistance;
 
     // Perte thermique linéique (W/m)
     double temperatureDiff = waterTemp - ambientTemp;
     double q = (R_tot > 0) ? (temperatureDiff / R_tot) : 0.0;
 
     // Perte thermique totale (W)
-    double Q = q * length;
-
-    return Q;
+    return q * length;
 }
 
 // Version avec détails pour le PDF
@@ -1154,63 +952,24 @@ double PipeCalculator::calculateHeatLossWithDetails(double length, double diamet
                                                     double waterTemp, double ambientTemp,
                                                     CalculationDetails& details) {
     // NOTE: 'diameter' est le diamètre INTÉRIEUR du tube
-    // Pour les pertes thermiques, on doit utiliser le rayon EXTÉRIEUR
-
-    // Rayon intérieur du tube (m)
-    double r_int = (diameter / 1000.0) / 2.0;
-
-    // Estimer l'épaisseur de paroi (approximation pour cuivre/PER)
-    // Pour DN ≤ 22mm : ~1mm, pour DN > 22mm : ~1.5mm
-    double wallThickness = (diameter <= 22.0) ? 0.001 : 0.0015;  // en mètres
-
-    // Rayon extérieur du tube métallique (avant isolation)
-    details.r1 = r_int + wallThickness;
-
-    // Rayon extérieur avec isolation (m)
-    details.r2 = details.r1 + (insulation / 1000.0);
+    const PipeInsulation* tabulated = PipeCatalogue::instance().findInsulation(diameter, insulation);
+    PipeInsulation thermal = tabulated ? *tabulated : PipeCatalogue::computeInsulation(diameter, insulation);
 
-    // Conductivité thermique de l'isolation (W/m·K)
-    const double lambda = 0.04;
-
-    // Coefficient d'échange convectif extérieur (W/m²·K)
-    const double h_ext = 10.0;
-
-    // Résistance thermique de l'isolation (K/W par mètre linéaire)
-    details.thermalResistanceInsul = 0.0;
-    if (details.r2 > details.r1 && details.r1 > 0) {
-        details.thermalResistanceInsul = std::log(details.r2 / details.r1) / (2.0 * M_PI * lambda);
-    }
-
-    // Résistance thermique externe par convection (K/W par mètre linéaire)
-    details.thermalResistanceExt = 0.0;
-    if (details.r2 > 0) {
-        details.thermalResistanceExt = 1.0 / (h_ext * 2.0 * M_PI * details.r2);
-    }
-
-    // Résistance thermique totale (K/W par mètre linéaire)
-    double R_tot = details.thermalResistanceInsul + details.thermalResistanceExt;
+    details.r1 = PipeCatalogue::outerRadius(diameter);
+    details.r2 = thermal.r2;
+    details.thermalResistanceInsul = thermal.insulationResistance;
+    details.thermalResistanceExt = thermal.externalResistance;
 
     // Perte thermique linéique (W/m)
     double temperatureDiff = waterTemp - ambientTemp;
-    details.heatLossPerMeter = (R_tot > 0) ? (temperatureDiff / R_tot) : 0.0;
+    details.heatLossPerMeter = (thermal.totalResistance > 0) ? (temperatureDiff / thermal.totalResistance) : 0.0;
 
     // Perte thermique totale (W)
-    double Q = details.heatLossPerMeter * length;
-
-    return Q;
+    return details.heatLossPerMeter * length;
 }
 
-std::vector<int> PipeCalculator::getAvailableDiameters(PipeMaterial material) {
-    switch (material) {
-        case PipeMaterial::Copper:
-            return {10, 12, 14, 16, 18, 22, 28, 35, 42, 54, 64, 76};
-        case PipeMaterial::PEX:
-        case PipeMaterial::Multilayer:
-            return {12, 16, 20, 25, 32, 40, 50, 63};
-        case PipeMaterial::Steel:
-            return {15, 20, 26, 32, 40, 50, 65, 80, 100};
-    }
-    return {16, 20, 25, 32, 40, 50};
+const std::vector<int>& PipeCalculator::getAvailableDiameters(PipeMaterial material) {
+    return PipeCatalogue::instance().getSeries(material).nominalDiameters;
 }
 
 // Fonctions utilitaires pour les noms
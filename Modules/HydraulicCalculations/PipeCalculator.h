@@ -1,8 +1,14 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <cmath>
+#include "WaterProperties.h"
+#include "FrictionFactor.h"
+#include "FixtureCatalogue.h"
+#include "SegmentDiagnostics.h"
 
 namespace HydraulicCalc {
 
@@ -13,25 +19,7 @@ enum class NetworkType {
     HotWaterWithLoop     // Eau chaude avec bouclage
 };
 
-// Types d'appareil sanitaire
-enum class FixtureType {
-    WashBasin,           // Lavabo
-    WashBasinCollective, // Lavabo collectif (par jet)
-    Sink,                // Évier
-    Shower,              // Douche
-    Bathtub,             // Baignoire
-    WC,                  // WC avec réservoir de chasse
-    WCFlushValve,        // WC avec robinet de chasse
-    Bidet,               // Bidet
-    WashingMachine,      // Lave-linge
-    Dishwasher,          // Lave-vaisselle
-    UrinalFlush,         // Urinoir avec robinet individuel
-    UrinalSiphonic,      // Urinoir à action siphonique
-    HandWashBasin,       // Lave-mains
-    UtilitySink,         // Bac à laver
-    WaterOutlet12,       // Poste d'eau robinet 1/2"
-    WaterOutlet34        // Poste d'eau robinet 3/4"
-};
+constexpr std::size_t NetworkTypeCount = 3;  // Nombre de types de réseau
 
 // Matériau des tuyaux
 enum class PipeMaterial {
@@ -41,20 +29,18 @@ enum class PipeMaterial {
     Steel                // Acier galvanisé
 };
 
-// Structure pour un appareil sanitaire
+constexpr std::size_t PipeMaterialCount = 4;  // Nombre de matériaux
+
+// Appareils sanitaires d'un même type desservis par un tronçon
+// (le débit unitaire est lu dans FixtureCatalogue)
 struct Fixture {
     FixtureType type;
     int quantity;
-    double flowRate;     // Débit unitaire en L/min
-    double coefficient;  // Coefficient de simultanéité
 
     Fixture(FixtureType t, int qty)
-        : type(t), quantity(qty), flowRate(0.0), coefficient(1.0) {
-        initializeFlowRate();
-    }
+        : type(t), quantity(qty) {}
 
-private:
-    void initializeFlowRate();
+    double unitFlowRate() const { return FixtureCatalogue::instance().flowRate(type); }
 };
 
 // Détails de calcul intermédiaires pour le débogage (PDF détaillé)
@@ -71,6 +57,7 @@ struct CalculationDetails {
     double reynolds;                // Nombre de Reynolds
     bool isLaminar;                 // Écoulement laminaire (Re < 2300)
     double lambda;                  // Coefficient de friction (sans dimension)
+    FrictionModel frictionModel;    // Méthode de calcul de λ utilisée
     double roughness;               // Rugosité absolue du matériau (mm)
     double relativeRoughness;       // Rugosité relative (ε/D)
     double linearPressureDrop;      // Perte de charge linéaire (mCE)
@@ -88,6 +75,7 @@ struct CalculationDetails {
     CalculationDetails()
         : totalFixtureFlowRate(0), totalFixtures(0), simultaneityCoeff(0)
         , crossSection(0), reynolds(0), isLaminar(false), lambda(0)
+        , frictionModel(FrictionModel::SwameeJain)
         , roughness(0), relativeRoughness(0), linearPressureDrop(0)
         , singularPressureDrop(0), heightPressureDrop(0)
         , r1(0), r2(0), thermalResistanceInsul(0), thermalResistanceExt(0)
@@ -120,7 +108,7 @@ struct PipeSegmentResult {
     double returnInletTemperature;   // Température entrée retour en °C (vient des enfants)
     double returnOutletTemperature;  // Température sortie retour en °C (après pertes dans le retour)
 
-    std::string recommendation; // Recommandation
+    SegmentDiagnostics diagnostics; // Anomalies (texte via diagnostics.formatRecommendation())
 
     // Détails de calcul pour le débogage
     CalculationDetails details;
@@ -154,6 +142,12 @@ struct CalculationParameters {
     double waterTemperature;     // Température de l'eau en °C (température d'entrée du segment)
     double insulationThickness;  // Épaisseur d'isolation en mm
 
+    // Propriétés de l'eau (ν, ρ, cp) évaluées à la température du segment
+    // false = valeurs constantes historiques (ν = 10⁻⁶ m²/s, ρ = 1000 kg/m³, cp = 4186 J/(kg·K))
+    bool temperatureDependentProperties;
+
+    FrictionModel frictionModel; // Méthode de calcul du coefficient λ
+
     CalculationParameters()
         : networkType(NetworkType::ColdWater)
         , material(PipeMaterial::Copper)
@@ -167,6 +161,8 @@ struct CalculationParameters {
         , ambientTemperature(20.0)
         , waterTemperature(60.0)
         , insulationThickness(13.0)
+        , temperatureDependentProperties(true)
+        , frictionModel(FrictionModel::SwameeJain)
     {}
 };
 
@@ -207,6 +203,8 @@ struct NetworkCalculationParameters {
     double ambientTemperature;   // Température ambiante en °C
     double waterTemperature;     // Température de l'eau en °C
     double insulationThickness;  // Épaisseur d'isolation en mm
+    bool temperatureDependentProperties;  // Propriétés de l'eau selon la température (voir CalculationParameters)
+    FrictionModel frictionModel;          // Méthode de calcul du coefficient λ
 
     std::vector<NetworkSegment> segments; // Liste de tous les segments du réseau
 
@@ -219,24 +217,65 @@ struct NetworkCalculationParameters {
         , ambientTemperature(20.0)
         , waterTemperature(60.0)
         , insulationThickness(13.0)
+        , temperatureDependentProperties(true)
+        , frictionModel(FrictionModel::SwameeJain)
     {}
 };
 
+// Résultats des trois types de réseau calculés sur une même topologie (calcul combiné)
+struct MultiNetworkResult {
+    std::array<NetworkCalculationParameters, NetworkTypeCount> networks;  // Indexés par NetworkType
+
+    NetworkCalculationParameters& get(NetworkType type) { return networks[static_cast<std::size_t>(type)]; }
+    const NetworkCalculationParameters& get(NetworkType type) const { return networks[static_cast<std::size_t>(type)]; }
+};
+
+class CalculationCache;  // Défini dans CalculationCache.h
+
 // Classe principale de calcul
 class PipeCalculator {
 public:
     PipeCalculator();
     ~PipeCalculator();
 
+    // Version des résultats de calculateNetwork : à incrémenter à toute modification du calcul
+    // qui change ses résultats (les résultats mis en cache par une autre version sont ignorés)
+    static constexpr std::uint32_t Version = 1;
+
+    // Chute de température admise sur la boucle ECS (°C) : T_retour ≥ T_départ - ΔT
+    static constexpr double LoopTemperatureDrop = 5.0;
+
+    // Vitesse en dessous de laquelle un tronçon est signalé (risque de stagnation, m/s)
+    static constexpr double StagnationVelocity = 0.3;
+
+    // Pertes singulières (coudes, vannes, raccords) estimées en part des pertes linéaires
+    static constexpr double SingularLossRatio = 0.20;
+
+    // Vitesse maximale du DN retenu (m/s) : 1,5 en ECS bouclée, 2 sinon (confort acoustique)
+    static double getMaxVelocity(NetworkType networkType);
+
     // Calcul du dimensionnement d'un segment unique
     PipeSegmentResult calculate(const CalculationParameters& params);
 
     // Calcul du dimensionnement multi-segments
     void calculateNetwork(NetworkCalculationParameters& networkParams);
 
+    // Calcul combiné eau froide / ECS / ECS bouclée sur les segments de base :
+    // topologie et débits construits une fois, dimensionnement des trois réseaux dans un
+    // même parcours ascendant (hasReturnLine forcé selon le type, comme dans la fenêtre),
+    // Re et λ d'un segment évalués une fois pour les réseaux de même débit, DN et eau.
+    // Seuls les réseaux absents du cache sont calculés.
+    MultiNetworkResult calculateAllNetworks(const NetworkCalculationParameters& base);
+
+    // Cache des résultats de réseau consulté par calculateNetwork et calculateAllNetworks
+    // (nullptr = désactivé, par défaut)
+    void setResultCache(CalculationCache* cache) { resultCache = cache; }
+    CalculationCache* getResultCache() const { return resultCache; }
+
     // Méthodes utilitaires
     static double getSimultaneityCoefficient(int numberOfFixtures);
     static double calculateFlowRate(const std::vector<Fixture>& fixtures);
+    static void addFixtureCounts(const std::vector<Fixture>& fixtures, FixtureCounts& counts);
     static std::string getFixtureName(FixtureType type);
     static std::string getMaterialName(PipeMaterial material);
     static std::string getNetworkTypeName(NetworkType type);
@@ -252,32 +291,63 @@ public:
     ReturnDiameterResult selectReturnDiameter(double thermalFlowRate, PipeMaterial material,
                                               double minVelocity = 0.2, double maxVelocity = 0.5);
 
-private:
-    // Calculs internes
+    // Calculs élémentaires (utilisés aussi par les solveurs annexes : équilibrage, transitoires)
     double calculatePressureDrop(double flowRate, double length, double diameter,
-                                 PipeMaterial material, NetworkType networkType);
+                                 PipeMaterial material, const WaterState& water = WaterState(),
+                                 FrictionModel frictionModel = FrictionModel::SwameeJain);
     double calculateVelocity(double flowRate, double diameter);
-    int selectOptimalDiameter(double flowRate, PipeMaterial material,
-                              double maxVelocity = 2.0, int minDiameter = 0);
     double getInternalDiameter(int nominalDiameter, PipeMaterial material);
     double getRoughness(PipeMaterial material);
 
-    // Calcul de la perte de charge linéaire (formule de Colebrook-White simplifiée)
+    // Diamètres nominaux de la série active du matériau (voir PipeCatalogue)
+    const std::vector<int>& getAvailableDiameters(PipeMaterial material);
+
+    // Calcul des pertes thermiques pour le bouclage ECS
+    double calculateHeatLoss(double length, double diameter, double insulation,
+                            double waterTemp, double ambientTemp);
+
+    // Chute de température (°C) d'un débit (L/min) qui perd heatLoss (W)
+    static double calculateTemperatureDrop(double heatLoss, double flowRate, const WaterState& water);
+
+    // Propriétés de l'eau à la température donnée (valeurs constantes si temperatureDependent = false)
+    static WaterState getWaterState(double temperature, bool temperatureDependent);
+
+private:
+    // Arbre du réseau (enfants, ordres de parcours) et grandeurs indépendantes du type de réseau
+    struct NetworkTopology;
+
+    // Dernière évaluation du frottement d'un segment (Re, λ, perte linéaire), reprise par les
+    // autres réseaux du calcul combiné si débit, diamètre, longueur et eau sont identiques
+    struct FrictionEvaluation;
+
+    // Dimensionnement d'un segment ; shared (facultatif) partage l'évaluation du frottement
+    PipeSegmentResult calculate(const CalculationParameters& params, FrictionEvaluation* shared);
+
+    // PASSE 1 pour un segment : dimensionnement aller (enfants déjà dimensionnés)
+    void sizeSegment(NetworkCalculationParameters& networkParams, const NetworkTopology& topology, size_t index,
+                     FrictionEvaluation* shared = nullptr);
+
+    // PASSES 1B à 6 : températures, bouclage, pressions et diagnostics du réseau dimensionné
+    void solveNetwork(NetworkCalculationParameters& networkParams, const NetworkTopology& topology);
+
+    // Calculs internes
+    int selectOptimalDiameter(double flowRate, PipeMaterial material,
+                              double maxVelocity = 2.0, int minDiameter = 0);
+
+    // Calcul de la perte de charge linéaire (Darcy-Weisbach, λ selon frictionModel)
     double calculateLinearPressureDrop(double flowRate, double diameter,
-                                       double roughness, double length);
+                                       double roughness, double length,
+                                       const WaterState& water, FrictionModel frictionModel);
 
     // Version avec détails pour le PDF
     double calculateLinearPressureDropWithDetails(double flowRate, double diameter,
                                                    double roughness, double length,
+                                                   const WaterState& water, FrictionModel frictionModel,
                                                    CalculationDetails& details);
 
     // Calcul de la perte de charge singulière (estimée à 20% des pertes linéaires)
     double calculateSingularPressureDrop(double linearDrop);
 
-    // Calcul des pertes thermiques pour le bouclage ECS
-    double calculateHeatLoss(double length, double diameter, double insulation,
-                            double waterTemp, double ambientTemp);
-
     // Version avec détails pour le PDF
     double calculateHeatLossWithDetails(double length, double diameter, double insulation,
                                         double waterTemp, double ambientTemp,
@@ -286,8 +356,7 @@ private:
     // Version avec détails pour le PDF
     double calculateFlowRateWithDetails(const std::vector<Fixture>& fixtures, CalculationDetails& details);
 
-    // Diamètres nominaux disponibles par matériau
-    std::vector<int> getAvailableDiameters(PipeMaterial material);
+    CalculationCache* resultCache;
 };
 
 } // namespace HydraulicCalc
@@ -0,0 +1,318 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include "PipeCatalogue.h"
+#include "PipeCalculator.h"
+#include "HydraulicKernels.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <locale>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace HydraulicCalc {
+
+PipeSeries::PipeSeries()
+    : material(PipeMaterial::Copper), roughness(0.0)
+{}
+
+const PipeSize* PipeSeries::findSize(int nominalDiameter) const {
+    auto it = std::lower_bound(nominalDiameters.begin(), nominalDiameters.end(), nominalDiameter);
+    if (it == nominalDiameters.end() || *it != nominalDiameter) {
+        return nullptr;
+    }
+    return &sizes[static_cast<size_t>(it - nominalDiameters.begin())];
+}
+
+int PipeSeries::selectIndex(double flowRate, double maxVelocity, int minDiameter) const {
+    // v = Q / A décroît avec la section : le premier DN qui respecte vmax est un point de partition
+    size_t first = static_cast<size_t>(
+        std::lower_bound(nominalDiameters.begin(), nominalDiameters.end(), minDiameter) - nominalDiameters.begin());
+    const double flowRateM3s = flowRate / 60000.0; // L/min -> m³/s
+
+    auto it = std::partition_point(sizes.begin() + first, sizes.end(),
+        [flowRateM3s, maxVelocity](const PipeSize& size) {
+            return flowRateM3s / size.crossSection > maxVelocity;
+        });
+    return (it == sizes.end()) ? -1 : static_cast<int>(it - sizes.begin());
+}
+
+PipeCatalogue::PipeCatalogue()
+    : activeSeries(PipeMaterialCount, 0)
+{
+    struct BuiltinSeries {
+        const char* name;
+        PipeMaterial material;
+        double roughness;
+        std::vector<int> diameters;
+    };
+    const BuiltinSeries builtins[] = {
+        {"Cuivre", PipeMaterial::Copper, 0.0015, {10, 12, 14, 16, 18, 22, 28, 35, 42, 54, 64, 76}},
+        {"PER", PipeMaterial::PEX, 0.007, {12, 16, 20, 25, 32, 40, 50, 63}},
+        {"Multicouche", PipeMaterial::Multilayer, 0.007, {12, 16, 20, 25, 32, 40, 50, 63}},
+        {"Acier galvanisé", PipeMaterial::Steel, 0.15, {15, 20, 26, 32, 40, 50, 65, 80, 100}},
+    };
+
+    for (const auto& builtin : builtins) {
+        PipeSeries s;
+        s.name = builtin.name;
+        s.material = builtin.material;
+        s.roughness = builtin.roughness;
+        for (int dn : builtin.diameters) {
+            PipeSize size;
+            size.nominalDiameter = dn;
+            size.internalDiameter = estimateInternalDiameter(dn, builtin.material);
+            s.sizes.push_back(size);
+        }
+        activeSeries[static_cast<size_t>(builtin.material)] = addSeries(std::move(s));
+    }
+}
+
+PipeCatalogue& PipeCatalogue::instance() {
+    static PipeCatalogue catalogue;
+    return catalogue;
+}
+
+const PipeSeries& PipeCatalogue::getSeries(PipeMaterial material) const {
+    return series[activeSeries[static_cast<size_t>(material)]];
+}
+
+void PipeCatalogue::prepareSeries(PipeSeries& newSeries) {
+    if (newSeries.sizes.empty()) {
+        throw std::runtime_error("La série de tubes '" + newSeries.name + "' ne contient aucun diamètre");
+    }
+
+    std::sort(newSeries.sizes.begin(), newSeries.sizes.end(),
+              [](const PipeSize& a, const PipeSize& b) { return a.nominalDiameter < b.nominalDiameter; });
+
+    newSeries.nominalDiameters.clear();
+    for (size_t i = 0; i < newSeries.sizes.size(); ++i) {
+        PipeSize& size = newSeries.sizes[i];
+        if (size.internalDiameter <= 0.0) {
+            throw std::runtime_error("Diamètre intérieur invalide pour DN" + std::to_string(size.nominalDiameter)
+                                     + " dans la série '" + newSeries.name + "'");
+        }
+        if (i > 0 && (size.nominalDiameter == newSeries.sizes[i - 1].nominalDiameter
+                      || size.internalDiameter <= newSeries.sizes[i - 1].internalDiameter)) {
+            throw std::runtime_error("Les diamètres intérieurs de la série '" + newSeries.name
+                                     + "' doivent croître strictement avec le DN (DN"
+                                     + std::to_string(size.nominalDiameter) + ")");
+        }
+
+        // Grandeurs précalculées : section de passage et constantes thermiques par mm d'isolant
+        size.crossSection = M_PI * std::pow(size.internalDiameter / 2000.0, 2);
+        size.r1 = outerRadius(size.internalDiameter);
+        size.insulation.resize(MaxTabulatedInsulation + 1);
+        for (int thickness = 0; thickness <= MaxTabulatedInsulation; ++thickness) {
+            size.insulation[thickness] = computeInsulation(size.internalDiameter, thickness);
+        }
+        newSeries.nominalDiameters.push_back(size.nominalDiameter);
+    }
+}
+
+size_t PipeCatalogue::addSeries(PipeSeries newSeries) {
+    prepareSeries(newSeries);
+    series.push_back(std::move(newSeries));
+    rebuildDiameterIndex();
+    return series.size() - 1;
+}
+
+void PipeCatalogue::setActiveSeries(PipeMaterial material, size_t index) {
+    if (index >= series.size() || series[index].material != material) {
+        throw std::runtime_error("Série de tubes incompatible avec le matériau "
+                                 + PipeCalculator::getMaterialName(material));
+    }
+    activeSeries[static_cast<size_t>(material)] = index;
+}
+
+namespace {
+
+std::string trim(const std::string& value) {
+    size_t start = value.find_first_not_of(" \t\r");
+    if (start == std::string::npos) return "";
+    size_t end = value.find_last_not_of(" \t\r");
+    return value.substr(start, end - start + 1);
+}
+
+bool parseDecimal(std::string value, double& result) {
+    std::replace(value.begin(), value.end(), ',', '.');
+    std::istringstream stream(value);
+    stream.imbue(std::locale::classic());
+    stream >> result;
+    return !stream.fail() && stream.eof();
+}
+
+bool parseMaterialName(std::string name, PipeMaterial& material) {
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    if (name == "cuivre") material = PipeMaterial::Copper;
+    else if (name == "per") material = PipeMaterial::PEX;
+    else if (name == "multicouche") material = PipeMaterial::Multilayer;
+    else if (name == "acier") material = PipeMaterial::Steel;
+    else return false;
+    return true;
+}
+
+} // namespace
+
+std::vector<std::string> PipeCatalogue::loadFromFile(const std::string& path) {
+    std::ifstream file(std::filesystem::u8path(path));
+    if (!file.is_open()) {
+        throw std::runtime_error("Impossible d'ouvrir le catalogue de tubes : " + path);
+    }
+
+    // ÉTAPE 1: Lecture de toutes les lignes, regroupées par série (ordre d'apparition)
+    std::vector<PipeSeries> loaded;
+    std::map<std::string, size_t> indexByName;
+    std::string line;
+    int lineNumber = 0;
+    bool firstDataLine = true;
+
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (lineNumber == 1 && line.size() >= 3 && line.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+            line.erase(0, 3);  // BOM UTF-8
+        }
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, ';')) {
+            fields.push_back(trim(field));
+        }
+
+        // Ligne d'en-tête : uniquement la première ligne de données, reconnue à son libellé
+        std::string firstField = fields[0];
+        std::transform(firstField.begin(), firstField.end(), firstField.begin(), ::tolower);
+        const bool header = firstDataLine && (firstField == "série" || firstField == "serie");
+        firstDataLine = false;
+        if (header) {
+            continue;
+        }
+
+        double roughness = 0.0, dn = 0.0, internalDiameter = 0.0;
+        bool numeric = fields.size() == 5 && parseDecimal(fields[2], roughness)
+                       && parseDecimal(fields[3], dn) && parseDecimal(fields[4], internalDiameter);
+        if (!numeric) {
+            throw std::runtime_error("Catalogue de tubes, ligne " + std::to_string(lineNumber)
+                                     + " : format attendu Série;Matériau;Rugosité;DN;D int");
+        }
+
+        PipeMaterial material;
+        if (!parseMaterialName(fields[1], material)) {
+            throw std::runtime_error("Catalogue de tubes, ligne " + std::to_string(lineNumber)
+                                     + " : matériau inconnu '" + fields[1] + "' (cuivre, per, multicouche, acier)");
+        }
+
+        auto found = indexByName.find(fields[0]);
+        if (found == indexByName.end()) {
+            PipeSeries s;
+            s.name = fields[0];
+            s.material = material;
+            s.roughness = roughness;
+            found = indexByName.emplace(fields[0], loaded.size()).first;
+            loaded.push_back(std::move(s));
+        }
+
+        PipeSize size;
+        size.nominalDiameter = static_cast<int>(std::lround(dn));
+        size.internalDiameter = internalDiameter;
+        loaded[found->second].sizes.push_back(size);
+    }
+
+    if (loaded.empty()) {
+        throw std::runtime_error("Le catalogue de tubes ne contient aucune série : " + path);
+    }
+
+    // ÉTAPE 2: Validation de toutes les séries avant toute modification du catalogue
+    for (auto& s : loaded) {
+        prepareSeries(s);
+    }
+
+    // ÉTAPE 3: Ajout, chaque série devenant la série active de son matériau
+    std::vector<std::string> names;
+    for (auto& s : loaded) {
+        names.push_back(s.name);
+        activeSeries[static_cast<size_t>(s.material)] = series.size();
+        series.push_back(std::move(s));
+    }
+    rebuildDiameterIndex();
+    return names;
+}
+
+void PipeCatalogue::rebuildDiameterIndex() {
+    sizesByDiameter.clear();
+    for (const auto& s : series) {
+        for (const auto& size : s.sizes) {
+            sizesByDiameter.emplace_back(size.internalDiameter, &size);
+        }
+    }
+    std::sort(sizesByDiameter.begin(), sizesByDiameter.end(),
+              [](const std::pair<double, const PipeSize*>& a, const std::pair<double, const PipeSize*>& b) {
+                  return a.first < b.first;
+              });
+}
+
+const PipeInsulation* PipeCatalogue::findInsulation(double internalDiameter, double insulation) const {
+    if (insulation < 0.0 || insulation > MaxTabulatedInsulation || insulation != std::floor(insulation)) {
+        return nullptr;
+    }
+
+    auto it = std::lower_bound(sizesByDiameter.begin(), sizesByDiameter.end(), internalDiameter,
+        [](const std::pair<double, const PipeSize*>& entry, double value) { return entry.first < value; });
+    if (it == sizesByDiameter.end() || it->first != internalDiameter) {
+        return nullptr;
+    }
+    return &it->second->insulation[static_cast<size_t>(insulation)];
+}
+
+PipeInsulation PipeCatalogue::computeInsulation(double internalDiameter, double insulation) {
+    PipeInsulation result;
+    double r1 = outerRadius(internalDiameter);
+    result.r2 = r1 + (insulation / 1000.0);
+
+    if (result.r2 > r1 && r1 > 0) {
+        result.insulationResistance = Kernels::insulationResistance(r1, result.r2, InsulationConductivity);
+    }
+    if (result.r2 > 0) {
+        result.externalResistance = Kernels::externalResistance(result.r2, ExternalExchangeCoefficient);
+    }
+    result.totalResistance = result.insulationResistance + result.externalResistance;
+    return result;
+}
+
+double PipeCatalogue::outerRadius(double internalDiameter) {
+    // Épaisseur de paroi estimée (approximation pour cuivre/PER) : ~1mm jusqu'à 22mm, ~1.5mm au-delà
+    double wallThickness = (internalDiameter <= 22.0) ? 0.001 : 0.0015;  // en mètres
+    return (internalDiameter / 1000.0) / 2.0 + wallThickness;
+}
+
+double PipeCatalogue::estimateInternalDiameter(int nominalDiameter, PipeMaterial material) {
+    // Diamètres intérieurs approximatifs en mm
+    switch (material) {
+        case PipeMaterial::Copper:
+            // Pour le cuivre, le DN correspond approximativement au diamètre extérieur
+            // Épaisseur de paroi typique: 1mm pour DN10-22, 1.5mm pour DN28+
+            if (nominalDiameter <= 22) return nominalDiameter - 2.0;
+            else return nominalDiameter - 3.0;
+
+        case PipeMaterial::PEX:
+        case PipeMaterial::Multilayer:
+            // Pour PER et multicouche, épaisseur de paroi variable
+            if (nominalDiameter <= 16) return nominalDiameter - 2.0;
+            else if (nominalDiameter <= 20) return nominalDiameter - 2.3;
+            else if (nominalDiameter <= 26) return nominalDiameter - 3.0;
+            else return nominalDiameter - 3.5;
+
+        case PipeMaterial::Steel:
+            // Acier galvanisé: diamètre intérieur nominal
+            return nominalDiameter * 0.85; // Approximation
+    }
+    return nominalDiameter;
+}
+
+} // namespace HydraulicCalc
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace HydraulicCalc {
+
+enum class PipeMaterial;  // Défini dans PipeCalculator.h
+
+// Constantes thermiques d'un DN pour une épaisseur d'isolant donnée
+struct PipeInsulation {
+    double r2;                      // Rayon extérieur avec isolation (m)
+    double insulationResistance;    // R_isol = ln(r2/r1) / (2πλ) (K/W par m)
+    double externalResistance;      // R_ext = 1 / (h_ext × 2πr2) (K/W par m)
+    double totalResistance;         // R_isol + R_ext (K/W par m)
+
+    PipeInsulation() : r2(0), insulationResistance(0), externalResistance(0), totalResistance(0) {}
+};
+
+// Un diamètre d'une série de tubes, avec ses grandeurs précalculées
+struct PipeSize {
+    int nominalDiameter;            // DN (mm)
+    double internalDiameter;        // Diamètre intérieur (mm)
+    double crossSection;            // Section de passage (m²)
+    double r1;                      // Rayon extérieur du tube nu (m)
+    std::vector<PipeInsulation> insulation;  // Indexé par l'épaisseur d'isolant en mm (0..MaxTabulatedInsulation)
+
+    PipeSize() : nominalDiameter(0), internalDiameter(0), crossSection(0), r1(0) {}
+};
+
+// Série de tubes d'un fabricant (ou série générique d'un matériau)
+struct PipeSeries {
+    std::string name;
+    PipeMaterial material;          // Famille de matériau (vitesse des ondes, libellés)
+    double roughness;               // Rugosité absolue (mm)
+    std::vector<PipeSize> sizes;    // Triés par DN croissant (diamètres intérieurs croissants)
+    std::vector<int> nominalDiameters;  // DN des tailles, même ordre
+
+    PipeSeries();
+
+    // Taille de DN donné (recherche dichotomique), nullptr si absente de la série
+    const PipeSize* findSize(int nominalDiameter) const;
+
+    // Indice du plus petit DN ≥ minDiameter dont la vitesse reste ≤ maxVelocity
+    // (recherche dichotomique, sans allocation), -1 si aucun
+    int selectIndex(double flowRate, double maxVelocity, int minDiameter = 0) const;
+};
+
+// Catalogue des séries de tubes
+//
+// Les quatre premières séries sont les séries génériques des matériaux de PipeMaterial
+// (dans l'ordre de l'énumération) ; d'autres séries peuvent être chargées depuis un
+// fichier. Chaque matériau utilise une série active, modifiable au chargement.
+// Le catalogue se modifie entre deux calculs, jamais pendant.
+//
+// Format du fichier (séparateur ';', virgule ou point décimal, '#' = commentaire) :
+//   Série;Matériau;Rugosité (mm);DN;D int (mm)
+//   Geberit Mepla;multicouche;0,007;16;12
+class PipeCatalogue {
+public:
+    // Épaisseur d'isolant maximale tabulée (mm), au-delà : calcul direct
+    static constexpr int MaxTabulatedInsulation = 100;
+
+    // Conductivité de l'isolant (W/m·K) - mousse polyuréthane ou polystyrène expansé
+    static constexpr double InsulationConductivity = 0.04;
+
+    // Coefficient d'échange extérieur (W/m²·K) - convection naturelle dans l'air
+    static constexpr double ExternalExchangeCoefficient = 10.0;
+
+    static PipeCatalogue& instance();
+
+    // Série active du matériau
+    const PipeSeries& getSeries(PipeMaterial material) const;
+
+    const std::deque<PipeSeries>& getAllSeries() const { return series; }
+
+    // Ajoute une série (tailles triées et grandeurs précalculées), retourne son indice
+    size_t addSeries(PipeSeries newSeries);
+
+    void setActiveSeries(PipeMaterial material, size_t index);
+
+    // Charge les séries d'un fichier et les rend actives pour leur matériau.
+    // Retourne les noms des séries chargées ; lève std::runtime_error en cas d'erreur.
+    std::vector<std::string> loadFromFile(const std::string& path);
+
+    // Constantes thermiques tabulées pour un diamètre intérieur du catalogue et une
+    // épaisseur entière (mm) ; nullptr sinon
+    const PipeInsulation* findInsulation(double internalDiameter, double insulation) const;
+
+    // Calcul direct des constantes thermiques (diamètre intérieur et isolant en mm)
+    static PipeInsulation computeInsulation(double internalDiameter, double insulation);
+
+    // Rayon extérieur du tube nu (m), épaisseur de paroi estimée d'après le diamètre intérieur
+    static double outerRadius(double internalDiameter);
+
+    // Diamètre intérieur approximatif d'un DN hors catalogue (mm)
+    static double estimateInternalDiameter(int nominalDiameter, PipeMaterial material);
+
+private:
+    PipeCatalogue();
+    PipeCatalogue(const PipeCatalogue&) = delete;
+    PipeCatalogue& operator=(const PipeCatalogue&) = delete;
+
+    // Tri, validation et précalcul des grandeurs d'une série (lève std::runtime_error)
+    static void prepareSeries(PipeSeries& newSeries);
+    void rebuildDiameterIndex();
+
+    std::deque<PipeSeries> series;           // deque : les adresses restent valides à l'ajout
+    std::vector<size_t> activeSeries;        // Indice de la série active par matériau
+    std::vector<std::pair<double, const PipeSize*>> sizesByDiameter;  // Trié par diamètre intérieur
+};
+
+} // namespace HydraulicCalc
@@ -0,0 +1,375 @@
+#include "ProjectAutosave.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace HydraulicCalc {
+
+namespace {
+
+// Journal : "TCHJ", version (u16), réservé (u16), puis enregistrements
+//   taille (u32), somme de contrôle FNV-1a de la charge (u32), charge :
+//   séquence (u64), paramètres, tronçons écrits (u32 + enregistrements ProjectFormat),
+//   tronçons supprimés (u32 + identifiants)
+constexpr char JournalMagic[4] = {'T', 'C', 'H', 'J'};
+constexpr std::uint16_t JournalVersion = 1;
+constexpr std::size_t JournalHeaderSize = 8;
+constexpr std::size_t RecordHeaderSize = 8;
+
+std::uint32_t checksum(const char* data, std::size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+template <class T>
+void put(std::string& buffer, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    buffer.append(bytes, sizeof(T));
+}
+
+template <class T>
+T get(const char* data, std::size_t size, std::size_t& position) {
+    if (size - position < sizeof(T)) {
+        throw std::runtime_error("Journal tronqué");
+    }
+    T value;
+    std::memcpy(&value, data + position, sizeof(T));
+    position += sizeof(T);
+    return value;
+}
+
+std::string journalHeader() {
+    std::string header(JournalMagic, sizeof(JournalMagic));
+    put<std::uint16_t>(header, JournalVersion);
+    put<std::uint16_t>(header, 0);
+    return header;
+}
+
+// Ordre d'écriture stable : seg_2 avant seg_10
+bool segmentOrder(const SegmentSnapshot& a, const SegmentSnapshot& b) {
+    if (a.segment.id.size() != b.segment.id.size()) {
+        return a.segment.id.size() < b.segment.id.size();
+    }
+    return a.segment.id < b.segment.id;
+}
+
+} // namespace
+
+ProjectAutosave::ProjectAutosave(const std::string& path, std::uint64_t lastSequence)
+    : projectPath(path)
+    , stopping(false)
+    , busy(false)
+    , sequence(lastSequence)
+    , journalSize(0)
+    , latestSequence(lastSequence)
+    , uncompacted(false)
+{
+    worker = std::thread(&ProjectAutosave::run, this);
+}
+
+ProjectAutosave::~ProjectAutosave()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+std::string ProjectAutosave::journalPath(const std::string& path)
+{
+    return path + ".journal";
+}
+
+void ProjectAutosave::record(const NetworkState& state, const NetworkCalculationParameters& parameters,
+                             const std::vector<std::string>& segmentIds)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(Task{Task::Record, ++sequence, state, parameters, segmentIds});
+    }
+    wake.notify_one();
+}
+
+void ProjectAutosave::update(const NetworkState& state, const NetworkCalculationParameters& parameters)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(Task{Task::Update, sequence, state, parameters, std::vector<std::string>()});
+    }
+    wake.notify_one();
+}
+
+void ProjectAutosave::save()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    error.clear();
+    queue.push_back(Task{Task::Compact, sequence, NetworkState(), NetworkCalculationParameters(), std::vector<std::string>()});
+    wake.notify_one();
+    idle.wait(lock, [this]() { return queue.empty() && !busy; });
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+}
+
+std::string ProjectAutosave::lastError() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return error;
+}
+
+void ProjectAutosave::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            // Arrêt demandé, tout est écrit : fermeture normale, le journal est intégré au projet
+            // (en cas d'échec il reste en place et sera rejoué à la prochaine ouverture)
+            if (uncompacted) {
+                lock.unlock();
+                try {
+                    compact(latestState, latestParameters, latestSequence);
+                } catch (const std::exception&) {
+                }
+                lock.lock();
+            }
+            break;
+        }
+
+        std::deque<Task> batch;
+        batch.swap(queue);
+        busy = true;
+        lock.unlock();
+
+        std::string failure;
+        try {
+            bool compactRequested = false;
+            for (const auto& task : batch) {
+                if (task.kind == Task::Compact) {
+                    compactRequested = true;
+                    continue;
+                }
+                latestState = task.state;
+                latestParameters = task.parameters;
+                if (task.kind == Task::Record) {
+                    appendRecord(task);
+                    latestSequence = task.sequence;
+                    uncompacted = true;
+                }
+            }
+            if (journal.is_open()) {
+                journal.flush();
+            }
+
+            if (compactRequested || journalSize > CompactionThreshold) {
+                compact(latestState, latestParameters, latestSequence);
+            }
+        } catch (const std::exception& e) {
+            failure = e.what();
+        }
+
+        lock.lock();
+        if (!failure.empty()) {
+            error = failure;
+        }
+        busy = false;
+        if (queue.empty()) {
+            idle.notify_all();
+        }
+    }
+}
+
+void ProjectAutosave::appendRecord(const Task& task)
+{
+    const std::filesystem::path path = std::filesystem::u8path(journalPath(projectPath));
+    if (!journal.is_open()) {
+        std::error_code sizeError;
+        std::uintmax_t existing = std::filesystem::file_size(path, sizeError);
+        const bool valid = !sizeError && existing >= JournalHeaderSize;
+        journal.open(path, std::ios::binary | (valid ? std::ios::app : std::ios::trunc));
+        if (!journal) {
+            throw std::runtime_error("Impossible d'ouvrir le journal du projet : " + journalPath(projectPath));
+        }
+        if (!valid) {
+            const std::string header = journalHeader();
+            journal.write(header.data(), static_cast<std::streamsize>(header.size()));
+            existing = header.size();
+        }
+        journalSize = existing;
+    }
+
+    // Charge : séquence, paramètres, tronçons écrits puis supprimés
+    std::string payload;
+    put<std::uint64_t>(payload, task.sequence);
+    ProjectFormat::encodeParameters(payload, task.parameters);
+
+    std::vector<const std::string*> erased;
+    const std::size_t countPosition = payload.size();
+    put<std::uint32_t>(payload, 0);
+    std::uint32_t written = 0;
+    for (const auto& id : task.segmentIds) {
+        auto snapshot = task.state.segments.find(id);
+        if (snapshot) {
+            ProjectFormat::encodeSegment(payload, *snapshot, false);
+            ++written;
+        } else {
+            erased.push_back(&id);
+        }
+    }
+    std::memcpy(&payload[countPosition], &written, sizeof(written));
+
+    put<std::uint32_t>(payload, static_cast<std::uint32_t>(erased.size()));
+    for (const std::string* id : erased) {
+        put<std::uint32_t>(payload, static_cast<std::uint32_t>(id->size()));
+        payload.append(*id);
+    }
+
+    std::string record;
+    put<std::uint32_t>(record, static_cast<std::uint32_t>(payload.size()));
+    put<std::uint32_t>(record, checksum(payload.data(), payload.size()));
+    record.append(payload);
+
+    journal.write(record.data(), static_cast<std::streamsize>(record.size()));
+    if (!journal) {
+        throw std::runtime_error("Écriture du journal du projet interrompue");
+    }
+    journalSize += record.size();
+}
+
+void ProjectAutosave::compact(const NetworkState& state, const NetworkCalculationParameters& parameters,
+                              std::uint64_t lastSequence)
+{
+    // ÉTAPE 1: Projet complet à la séquence donnée
+    ProjectData project;
+    project.parameters = parameters;
+    project.hasResults = state.calculated();
+    project.journalSequence = lastSequence;
+    project.segments.reserve(state.segments.size());
+    state.segments.forEach([&project](const std::string&, const SegmentSnapshot& snapshot) {
+        project.segments.push_back(snapshot);
+    });
+    std::sort(project.segments.begin(), project.segments.end(), segmentOrder);
+
+    ProjectWriter::write(projectPath, project);
+
+    // ÉTAPE 2: Journal remis à zéro (tout ce qu'il contenait est dans le projet)
+    if (journal.is_open()) {
+        journal.close();
+    }
+    journal.clear();
+    journal.open(std::filesystem::u8path(journalPath(projectPath)), std::ios::binary | std::ios::trunc);
+    if (!journal) {
+        throw std::runtime_error("Impossible de réinitialiser le journal du projet : " + journalPath(projectPath));
+    }
+    const std::string header = journalHeader();
+    journal.write(header.data(), static_cast<std::streamsize>(header.size()));
+    journal.flush();
+    journalSize = header.size();
+    uncompacted = false;
+}
+
+ProjectData ProjectAutosave::load(const std::string& path, std::size_t* replayedEdits)
+{
+    ProjectData project = ProjectReader(path).readAll();
+    std::size_t replayed = 0;
+
+    std::ifstream in(std::filesystem::u8path(journalPath(path)), std::ios::binary);
+    std::string journalData;
+    if (in) {
+        journalData.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    if (journalData.size() >= JournalHeaderSize
+        && std::memcmp(journalData.data(), JournalMagic, sizeof(JournalMagic)) == 0) {
+        std::unordered_map<std::string, std::size_t> positions;
+        for (std::size_t i = 0; i < project.segments.size(); ++i) {
+            positions[project.segments[i].segment.id] = i;
+        }
+        std::vector<bool> removed(project.segments.size(), false);
+
+        const char* data = journalData.data();
+        const std::size_t size = journalData.size();
+        std::size_t position = JournalHeaderSize;
+        while (size - position >= RecordHeaderSize) {
+            std::size_t cursor = position;
+            const std::uint32_t payloadSize = get<std::uint32_t>(data, size, cursor);
+            const std::uint32_t expected = get<std::uint32_t>(data, size, cursor);
+            if (size - cursor < payloadSize || checksum(data + cursor, payloadSize) != expected) {
+                break;  // Enregistrement incomplet (arrêt pendant l'écriture) : fin du journal
+            }
+
+            const char* payload = data + cursor;
+            std::size_t offset = 0;
+            try {
+                const std::uint64_t recordSequence = get<std::uint64_t>(payload, payloadSize, offset);
+                if (recordSequence > project.journalSequence) {
+                    offset += ProjectFormat::decodeParameters(payload + offset, payloadSize - offset, project.parameters);
+
+                    const std::uint32_t written = get<std::uint32_t>(payload, payloadSize, offset);
+                    for (std::uint32_t i = 0; i < written; ++i) {
+                        SegmentSnapshot snapshot;
+                        offset += ProjectFormat::decodeSegment(payload + offset, payloadSize - offset, snapshot, false);
+                        auto it = positions.find(snapshot.segment.id);
+                        if (it != positions.end()) {
+                            project.segments[it->second] = std::move(snapshot);
+                            removed[it->second] = false;
+                        } else {
+                            positions[snapshot.segment.id] = project.segments.size();
+                            project.segments.push_back(std::move(snapshot));
+                            removed.push_back(false);
+                        }
+                    }
+
+                    const std::uint32_t erasedCount = get<std::uint32_t>(payload, payloadSize, offset);
+                    for (std::uint32_t i = 0; i < erasedCount; ++i) {
+                        const std::uint32_t length = get<std::uint32_t>(payload, payloadSize, offset);
+                        if (payloadSize - offset < length) {
+                            throw std::runtime_error("Journal tronqué");
+                        }
+                        auto it = positions.find(std::string(payload + offset, length));
+                        if (it != positions.end()) {
+                            removed[it->second] = true;
+                        }
+                        offset += length;
+                    }
+
+                    // Données modifiées après le calcul : résultats périmés
+                    project.journalSequence = recordSequence;
+                    project.hasResults = false;
+                    ++replayed;
+                }
+            } catch (const std::exception&) {
+                break;
+            }
+            position = cursor + payloadSize;
+        }
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < project.segments.size(); ++i) {
+            if (!removed[i]) {
+                if (kept != i) {
+                    project.segments[kept] = std::move(project.segments[i]);
+                }
+                ++kept;
+            }
+        }
+        project.segments.erase(project.segments.begin() + static_cast<std::ptrdiff_t>(kept), project.segments.end());
+    }
+
+    if (replayedEdits) {
+        *replayedEdits = replayed;
+    }
+    return project;
+}
+
+} // namespace HydraulicCalc
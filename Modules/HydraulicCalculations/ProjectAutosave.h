@@ -0,0 +1,98 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ProjectFile.h"
+#include "NetworkHistory.h"
+
+namespace HydraulicCalc {
+
+// Enregistrement automatique d'un projet : journal des modifications en ajout seul
+//
+// Chaque modification du schéma ajoute au journal (<projet>.journal) les tronçons touchés,
+// précédés des paramètres généraux. Le journal est compacté en arrière-plan : le projet
+// complet est réécrit (ProjectWriter) puis le journal repart à vide. La destruction (fermeture
+// normale) compacte le journal s'il contient des modifications : un journal non vide à
+// l'ouverture signale donc un arrêt brutal, et load() rejoue les modifications postérieures
+// au fichier (un enregistrement incomplet en fin de journal est ignoré).
+//
+// Le thread appelant ne fait que déposer l'état en file : les états partagent leur structure
+// (NetworkState), les encodages et écritures ont lieu sur le thread d'enregistrement.
+class ProjectAutosave {
+public:
+    static constexpr std::uint64_t CompactionThreshold = 4 * 1024 * 1024;  // Taille du journal (octets)
+
+    // lastSequence : dernière modification déjà présente dans le projet ou son journal
+    ProjectAutosave(const std::string& projectPath, std::uint64_t lastSequence);
+    ~ProjectAutosave();  // Écrit les modifications en attente, compacte le journal puis arrête le thread
+
+    ProjectAutosave(const ProjectAutosave&) = delete;
+    ProjectAutosave& operator=(const ProjectAutosave&) = delete;
+
+    // Modification du schéma (tronçons ajoutés, modifiés ou supprimés) : ne bloque pas
+    void record(const NetworkState& state, const NetworkCalculationParameters& parameters,
+                const std::vector<std::string>& segmentIds);
+
+    // Nouvel état sans modification des données (ex. résultats d'un calcul), repris à la
+    // prochaine compaction : ne bloque pas
+    void update(const NetworkState& state, const NetworkCalculationParameters& parameters);
+
+    // Réécriture complète du projet et remise à zéro du journal, en attendant la fin
+    // (std::runtime_error si l'écriture échoue)
+    void save();
+
+    // Dernière erreur d'écriture en arrière-plan (vide si aucune)
+    std::string lastError() const;
+
+    const std::string& getProjectPath() const { return projectPath; }
+
+    static std::string journalPath(const std::string& projectPath);
+
+    // Projet tel que laissé par la dernière session : fichier puis journal
+    // (replayedEdits : nombre de modifications rejouées depuis le journal)
+    static ProjectData load(const std::string& projectPath, std::size_t* replayedEdits = nullptr);
+
+private:
+    struct Task {
+        enum Kind { Record, Update, Compact } kind;
+        std::uint64_t sequence;
+        NetworkState state;
+        NetworkCalculationParameters parameters;
+        std::vector<std::string> segmentIds;
+    };
+
+    void run();
+    void appendRecord(const Task& task);
+    void compact(const NetworkState& state, const NetworkCalculationParameters& parameters,
+                 std::uint64_t sequence);
+
+    std::string projectPath;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;   // Tâche déposée ou arrêt demandé
+    std::condition_variable idle;   // File vide et thread inactif
+    std::deque<Task> queue;
+    bool stopping;
+    bool busy;
+    std::uint64_t sequence;         // Dernière séquence attribuée
+    std::string error;
+
+    // Thread d'enregistrement uniquement
+    std::ofstream journal;
+    std::uint64_t journalSize;
+    NetworkState latestState;
+    NetworkCalculationParameters latestParameters;
+    std::uint64_t latestSequence;
+    bool uncompacted;               // Modifications au journal depuis la dernière compaction
+
+    std::thread worker;
+};
+
+} // namespace HydraulicCalc
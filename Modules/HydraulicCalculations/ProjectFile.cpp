@@ -0,0 +1,512 @@
+#include "ProjectFile.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace HydraulicCalc {
+
+namespace {
+
+// ===== ÉCRITURE / LECTURE BINAIRE =====
+
+template <class T>
+void put(std::string& buffer, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    buffer.append(bytes, sizeof(T));
+}
+
+void putString(std::string& buffer, const std::string& text) {
+    put<std::uint32_t>(buffer, static_cast<std::uint32_t>(text.size()));
+    buffer.append(text);
+}
+
+// Lecture bornée d'un enregistrement : toute lecture hors limites est une corruption
+class Cursor {
+public:
+    Cursor(const char* data, std::size_t size) : data(data), size(size), position(0) {}
+
+    template <class T>
+    T get() {
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, data + position, sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+
+    std::string getString() {
+        const std::uint32_t length = get<std::uint32_t>();
+        require(length);
+        std::string text(data + position, length);
+        position += length;
+        return text;
+    }
+
+    void require(std::size_t bytes) const {
+        if (size - position < bytes) {
+            throw std::runtime_error("Fichier projet corrompu : enregistrement tronqué");
+        }
+    }
+
+    std::size_t remaining() const { return size - position; }
+    std::size_t consumed() const { return position; }
+
+private:
+    const char* data;
+    std::size_t size;
+    std::size_t position;
+};
+
+template <class Enum>
+Enum checkedEnum(std::uint8_t value, std::size_t count, const char* what) {
+    if (value >= count) {
+        throw std::runtime_error(std::string("Fichier projet corrompu : ") + what + " inconnu");
+    }
+    return static_cast<Enum>(value);
+}
+
+void encodeDetails(std::string& buffer, const CalculationDetails& details) {
+    put<double>(buffer, details.totalFixtureFlowRate);
+    put<std::int32_t>(buffer, details.totalFixtures);
+    put<double>(buffer, details.simultaneityCoeff);
+    put<double>(buffer, details.crossSection);
+    put<double>(buffer, details.reynolds);
+    put<std::uint8_t>(buffer, details.isLaminar ? 1 : 0);
+    put<double>(buffer, details.lambda);
+    put<std::uint8_t>(buffer, static_cast<std::uint8_t>(details.frictionModel));
+    put<double>(buffer, details.roughness);
+    put<double>(buffer, details.relativeRoughness);
+    put<double>(buffer, details.linearPressureDrop);
+    put<double>(buffer, details.singularPressureDrop);
+    put<double>(buffer, details.heightPressureDrop);
+    put<double>(buffer, details.r1);
+    put<double>(buffer, details.r2);
+    put<double>(buffer, details.thermalResistanceInsul);
+    put<double>(buffer, details.thermalResistanceExt);
+    put<double>(buffer, details.heatLossPerMeter);
+    put<double>(buffer, details.temperatureDrop);
+}
+
+void decodeDetails(Cursor& cursor, CalculationDetails& details) {
+    details.totalFixtureFlowRate = cursor.get<double>();
+    details.totalFixtures = cursor.get<std::int32_t>();
+    details.simultaneityCoeff = cursor.get<double>();
+    details.crossSection = cursor.get<double>();
+    details.reynolds = cursor.get<double>();
+    details.isLaminar = cursor.get<std::uint8_t>() != 0;
+    details.lambda = cursor.get<double>();
+    details.frictionModel = checkedEnum<FrictionModel>(cursor.get<std::uint8_t>(), FrictionModelCount, "modèle de frottement");
+    details.roughness = cursor.get<double>();
+    details.relativeRoughness = cursor.get<double>();
+    details.linearPressureDrop = cursor.get<double>();
+    details.singularPressureDrop = cursor.get<double>();
+    details.heightPressureDrop = cursor.get<double>();
+    details.r1 = cursor.get<double>();
+    details.r2 = cursor.get<double>();
+    details.thermalResistanceInsul = cursor.get<double>();
+    details.thermalResistanceExt = cursor.get<double>();
+    details.heatLossPerMeter = cursor.get<double>();
+    details.temperatureDrop = cursor.get<double>();
+}
+
+void encodeResults(std::string& buffer, const NetworkSegment& segment) {
+    const PipeSegmentResult& result = segment.result;
+    put<double>(buffer, result.flowRate);
+    put<double>(buffer, result.velocity);
+    put<double>(buffer, result.pressureDrop);
+    put<std::int32_t>(buffer, result.nominalDiameter);
+    put<double>(buffer, result.actualDiameter);
+    put<std::uint8_t>(buffer, result.hasReturn ? 1 : 0);
+    put<double>(buffer, result.returnFlowRate);
+    put<double>(buffer, result.returnVelocity);
+    put<std::int32_t>(buffer, result.returnNominalDiameter);
+    put<double>(buffer, result.returnActualDiameter);
+    put<double>(buffer, result.heatLoss);
+    put<double>(buffer, result.returnTemperature);
+    put<double>(buffer, result.inletTemperature);
+    put<double>(buffer, result.outletTemperature);
+    put<double>(buffer, result.returnInletTemperature);
+    put<double>(buffer, result.returnOutletTemperature);
+    put<double>(buffer, segment.inletPressure);
+    put<double>(buffer, segment.outletPressure);
+
+    put<double>(buffer, result.diagnostics.getAvailablePressure());
+    put<std::uint8_t>(buffer, static_cast<std::uint8_t>(result.diagnostics.end() - result.diagnostics.begin()));
+    for (const auto& diagnostic : result.diagnostics) {
+        put<std::uint8_t>(buffer, static_cast<std::uint8_t>(diagnostic.code));
+        put<double>(buffer, diagnostic.value);
+        put<double>(buffer, diagnostic.limit);
+    }
+
+    encodeDetails(buffer, result.details);
+}
+
+void decodeResults(Cursor& cursor, NetworkSegment& segment) {
+    PipeSegmentResult& result = segment.result;
+    result.flowRate = cursor.get<double>();
+    result.velocity = cursor.get<double>();
+    result.pressureDrop = cursor.get<double>();
+    result.nominalDiameter = cursor.get<std::int32_t>();
+    result.actualDiameter = cursor.get<double>();
+    result.hasReturn = cursor.get<std::uint8_t>() != 0;
+    result.returnFlowRate = cursor.get<double>();
+    result.returnVelocity = cursor.get<double>();
+    result.returnNominalDiameter = cursor.get<std::int32_t>();
+    result.returnActualDiameter = cursor.get<double>();
+    result.heatLoss = cursor.get<double>();
+    result.returnTemperature = cursor.get<double>();
+    result.inletTemperature = cursor.get<double>();
+    result.outletTemperature = cursor.get<double>();
+    result.returnInletTemperature = cursor.get<double>();
+    result.returnOutletTemperature = cursor.get<double>();
+    segment.inletPressure = cursor.get<double>();
+    segment.outletPressure = cursor.get<double>();
+
+    result.diagnostics.clear();
+    result.diagnostics.setAvailablePressure(cursor.get<double>());
+    const std::uint8_t diagnosticCount = cursor.get<std::uint8_t>();
+    for (std::uint8_t i = 0; i < diagnosticCount; ++i) {
+        DiagnosticCode code = checkedEnum<DiagnosticCode>(cursor.get<std::uint8_t>(), DiagnosticCodeCount, "diagnostic");
+        double value = cursor.get<double>();
+        double limit = cursor.get<double>();
+        result.diagnostics.set(code, value, limit);
+    }
+
+    decodeDetails(cursor, result.details);
+}
+
+} // namespace
+
+// ===== ENREGISTREMENTS =====
+
+namespace ProjectFormat {
+
+void encodeParameters(std::string& buffer, const NetworkCalculationParameters& parameters) {
+    put<std::uint8_t>(buffer, static_cast<std::uint8_t>(parameters.networkType));
+    put<std::uint8_t>(buffer, static_cast<std::uint8_t>(parameters.material));
+    put<std::uint8_t>(buffer, static_cast<std::uint8_t>(parameters.frictionModel));
+    put<std::uint8_t>(buffer, parameters.temperatureDependentProperties ? 1 : 0);
+    put<double>(buffer, parameters.supplyPressure);
+    put<double>(buffer, parameters.requiredPressure);
+    put<double>(buffer, parameters.loopLength);
+    put<double>(buffer, parameters.ambientTemperature);
+    put<double>(buffer, parameters.waterTemperature);
+    put<double>(buffer, parameters.insulationThickness);
+}
+
+std::size_t decodeParameters(const char* data, std::size_t size, NetworkCalculationParameters& parameters) {
+    Cursor cursor(data, size);
+    parameters.networkType = checkedEnum<NetworkType>(cursor.get<std::uint8_t>(), NetworkTypeCount, "type de réseau");
+    parameters.material = checkedEnum<PipeMaterial>(cursor.get<std::uint8_t>(), PipeMaterialCount, "matériau");
+    parameters.frictionModel = checkedEnum<FrictionModel>(cursor.get<std::uint8_t>(), FrictionModelCount, "modèle de frottement");
+    parameters.temperatureDependentProperties = cursor.get<std::uint8_t>() != 0;
+    parameters.supplyPressure = cursor.get<double>();
+    parameters.requiredPressure = cursor.get<double>();
+    parameters.loopLength = cursor.get<double>();
+    parameters.ambientTemperature = cursor.get<double>();
+    parameters.waterTemperature = cursor.get<double>();
+    parameters.insulationThickness = cursor.get<double>();
+    return cursor.consumed();
+}
+
+void encodeSegment(std::string& buffer, const SegmentSnapshot& snapshot, bool withResults) {
+    const std::size_t start = buffer.size();
+    put<std::uint32_t>(buffer, 0);  // Taille, complétée en fin d'enregistrement
+
+    const NetworkSegment& segment = snapshot.segment;
+    putString(buffer, segment.id);
+    putString(buffer, segment.name);
+    putString(buffer, segment.parentId);
+    put<double>(buffer, segment.length);
+    put<double>(buffer, segment.heightDifference);
+    put<std::uint8_t>(buffer, segment.hasReturnLine ? 1 : 0);
+    put<double>(buffer, snapshot.start.x);
+    put<double>(buffer, snapshot.start.y);
+    put<double>(buffer, snapshot.end.x);
+    put<double>(buffer, snapshot.end.y);
+
+    put<std::uint32_t>(buffer, static_cast<std::uint32_t>(segment.fixtures.size()));
+    for (std::size_t i = 0; i < segment.fixtures.size(); ++i) {
+        const SchemaPoint position = (i < snapshot.fixturePositions.size()) ? snapshot.fixturePositions[i] : snapshot.end;
+        put<std::uint8_t>(buffer, static_cast<std::uint8_t>(segment.fixtures[i].type));
+        put<std::int32_t>(buffer, segment.fixtures[i].quantity);
+        put<double>(buffer, position.x);
+        put<double>(buffer, position.y);
+    }
+
+    if (withResults) {
+        encodeResults(buffer, segment);
+    }
+
+    const std::uint32_t recordSize = static_cast<std::uint32_t>(buffer.size() - start);
+    std::memcpy(&buffer[start], &recordSize, sizeof(recordSize));
+}
+
+std::size_t decodeSegment(const char* data, std::size_t size, SegmentSnapshot& snapshot, bool withResults) {
+    Cursor header(data, size);
+    const std::uint32_t recordSize = header.get<std::uint32_t>();
+    if (recordSize < sizeof(std::uint32_t)) {
+        throw std::runtime_error("Fichier projet corrompu : taille d'enregistrement invalide");
+    }
+    header.require(recordSize - sizeof(std::uint32_t));
+
+    Cursor cursor(data + sizeof(std::uint32_t), recordSize - sizeof(std::uint32_t));
+    NetworkSegment& segment = snapshot.segment;
+    segment.id = cursor.getString();
+    segment.name = cursor.getString();
+    segment.parentId = cursor.getString();
+    segment.length = cursor.get<double>();
+    segment.heightDifference = cursor.get<double>();
+    segment.hasReturnLine = cursor.get<std::uint8_t>() != 0;
+    snapshot.start.x = cursor.get<double>();
+    snapshot.start.y = cursor.get<double>();
+    snapshot.end.x = cursor.get<double>();
+    snapshot.end.y = cursor.get<double>();
+
+    const std::uint32_t fixtureCount = cursor.get<std::uint32_t>();
+    cursor.require(static_cast<std::size_t>(fixtureCount) * (1 + 4 + 2 * 8));
+    segment.fixtures.clear();
+    segment.fixtures.reserve(fixtureCount);
+    snapshot.fixturePositions.clear();
+    snapshot.fixturePositions.reserve(fixtureCount);
+    for (std::uint32_t i = 0; i < fixtureCount; ++i) {
+        FixtureType type = checkedEnum<FixtureType>(cursor.get<std::uint8_t>(), FixtureTypeCount, "appareil");
+        int quantity = cursor.get<std::int32_t>();
+        double x = cursor.get<double>();
+        double y = cursor.get<double>();
+        segment.fixtures.push_back(Fixture(type, quantity));
+        snapshot.fixturePositions.push_back(SchemaPoint(x, y));
+    }
+
+    if (withResults) {
+        decodeResults(cursor, segment);
+    }
+    return recordSize;
+}
+
+} // namespace ProjectFormat
+
+// ===== ÉCRITURE =====
+
+void ProjectWriter::write(const std::string& path, const ProjectData& project)
+{
+    const std::size_t segmentCount = project.segments.size();
+    const std::uint16_t options = project.hasResults ? ProjectFormat::HasResults : 0;
+    const std::size_t indexOffset = ProjectFormat::HeaderSize + ProjectFormat::ParametersSize;
+
+    // ÉTAPE 1: Enregistrements des tronçons et index de leurs positions
+    std::string records;
+    std::vector<std::uint64_t> offsets;
+    offsets.reserve(segmentCount);
+    const std::size_t recordsOffset = indexOffset + segmentCount * sizeof(std::uint64_t);
+    for (const auto& snapshot : project.segments) {
+        offsets.push_back(recordsOffset + records.size());
+        ProjectFormat::encodeSegment(records, snapshot, project.hasResults);
+    }
+
+    // ÉTAPE 2: En-tête, paramètres, index
+    std::string buffer;
+    buffer.reserve(recordsOffset + records.size());
+    buffer.append(ProjectFormat::Magic, sizeof(ProjectFormat::Magic));
+    put<std::uint16_t>(buffer, ProjectFormat::Version);
+    put<std::uint16_t>(buffer, options);
+    put<std::uint32_t>(buffer, static_cast<std::uint32_t>(segmentCount));
+    put<std::uint32_t>(buffer, 0);
+    put<std::uint64_t>(buffer, project.journalSequence);
+    put<std::uint64_t>(buffer, static_cast<std::uint64_t>(recordsOffset + records.size()));
+    ProjectFormat::encodeParameters(buffer, project.parameters);
+    for (std::uint64_t offset : offsets) {
+        put<std::uint64_t>(buffer, offset);
+    }
+    buffer.append(records);
+
+    // ÉTAPE 3: Fichier temporaire puis remplacement
+    const std::filesystem::path target = std::filesystem::u8path(path);
+    std::filesystem::path temporary = target;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Impossible de créer le fichier projet : " + path);
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Écriture du fichier projet interrompue : " + path);
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, target, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        throw std::runtime_error("Impossible de remplacer le fichier projet : " + path);
+    }
+}
+
+// ===== LECTURE =====
+
+// Projection du fichier en lecture seule
+class ProjectReader::MappedFile {
+public:
+    explicit MappedFile(const std::string& path)
+        : view(nullptr), length(0)
+#ifdef _WIN32
+        , fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+#endif
+    {
+        const std::string openError = "Impossible d'ouvrir le fichier projet : " + path;
+#ifdef _WIN32
+        fileHandle = CreateFileW(std::filesystem::u8path(path).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                 nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error(openError);
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize)) {
+            CloseHandle(fileHandle);
+            throw std::runtime_error(openError);
+        }
+        length = static_cast<std::size_t>(fileSize.QuadPart);
+        if (length > 0) {
+            mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mappingHandle) {
+                view = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+            }
+            if (!view) {
+                if (mappingHandle) CloseHandle(mappingHandle);
+                CloseHandle(fileHandle);
+                throw std::runtime_error(openError);
+            }
+        }
+#else
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error(openError);
+        }
+        struct stat status;
+        if (::fstat(descriptor, &status) != 0) {
+            ::close(descriptor);
+            throw std::runtime_error(openError);
+        }
+        length = static_cast<std::size_t>(status.st_size);
+        if (length > 0) {
+            void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(descriptor);
+                throw std::runtime_error(openError);
+            }
+            view = static_cast<const char*>(mapping);
+        }
+        ::close(descriptor);  // La projection reste valide après fermeture
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (view) UnmapViewOfFile(view);
+        if (mappingHandle) CloseHandle(mappingHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+#else
+        if (view) ::munmap(const_cast<char*>(view), length);
+#endif
+    }
+
+    const char* data() const { return view; }
+    std::size_t size() const { return length; }
+
+private:
+    const char* view;
+    std::size_t length;
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#endif
+};
+
+ProjectReader::ProjectReader(const std::string& path)
+    : file(std::make_unique<MappedFile>(path))
+    , version(0)
+    , options(0)
+    , count(0)
+    , sequence(0)
+    , index(nullptr)
+    , recordsOffset(0)
+{
+    Cursor header(file->data(), file->size());
+    header.require(ProjectFormat::HeaderSize);
+    if (std::memcmp(file->data(), ProjectFormat::Magic, sizeof(ProjectFormat::Magic)) != 0) {
+        throw std::runtime_error("Ce fichier n'est pas un projet de calcul hydraulique : " + path);
+    }
+    header.get<std::uint32_t>();
+
+    version = header.get<std::uint16_t>();
+    if (version != ProjectFormat::Version) {
+        throw std::runtime_error("Format de projet non pris en charge (format " +
+                                 std::to_string(version) + ") : " + path);
+    }
+    options = header.get<std::uint16_t>();
+    count = header.get<std::uint32_t>();
+    header.get<std::uint32_t>();
+    sequence = header.get<std::uint64_t>();
+    const std::uint64_t expectedSize = header.get<std::uint64_t>();
+    if (expectedSize != file->size()) {
+        throw std::runtime_error("Fichier projet incomplet ou corrompu : " + path);
+    }
+
+    ProjectFormat::decodeParameters(file->data() + ProjectFormat::HeaderSize, file->size() - ProjectFormat::HeaderSize,
+                     networkParameters);
+
+    const std::size_t indexOffset = ProjectFormat::HeaderSize + ProjectFormat::ParametersSize;
+    if ((file->size() - indexOffset) / sizeof(std::uint64_t) < count) {
+        throw std::runtime_error("Fichier projet corrompu : index tronqué");
+    }
+    index = file->data() + indexOffset;
+    recordsOffset = indexOffset + count * sizeof(std::uint64_t);
+}
+
+ProjectReader::~ProjectReader() = default;
+
+SegmentSnapshot ProjectReader::segment(std::size_t i) const
+{
+    if (i >= count) {
+        throw std::runtime_error("Tronçon " + std::to_string(i) + " absent du projet");
+    }
+
+    std::uint64_t offset;
+    std::memcpy(&offset, index + i * sizeof(std::uint64_t), sizeof(offset));
+    if (offset < recordsOffset || offset >= file->size()) {
+        throw std::runtime_error("Fichier projet corrompu : position de tronçon invalide");
+    }
+
+    SegmentSnapshot snapshot;
+    ProjectFormat::decodeSegment(file->data() + offset, file->size() - static_cast<std::size_t>(offset),
+                                 snapshot, hasResults());
+    return snapshot;
+}
+
+ProjectData ProjectReader::readAll() const
+{
+    ProjectData project;
+    project.parameters = networkParameters;
+    project.hasResults = hasResults();
+    project.journalSequence = sequence;
+    project.segments.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        project.segments.push_back(segment(i));
+    }
+    return project;
+}
+
+} // namespace HydraulicCalc
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "PipeCalculator.h"
+#include "NetworkHistory.h"
+
+namespace HydraulicCalc {
+
+// Contenu d'un projet de calcul hydraulique
+struct ProjectData {
+    NetworkCalculationParameters parameters;   // Paramètres généraux (parameters.segments inutilisé)
+    std::vector<SegmentSnapshot> segments;     // Tronçons avec géométrie du schéma et appareils
+    bool hasResults;                           // Résultats de calcul enregistrés avec les tronçons
+    std::uint64_t journalSequence;             // Dernière modification du journal incluse
+
+    ProjectData() : hasResults(false), journalSequence(0) {}
+};
+
+// Format binaire des projets (.tchp), version 1
+//
+//   En-tête     "TCHP", version (u16), options (u16), nombre de tronçons (u32), réservé (u32),
+//               séquence du journal (u64), taille totale du fichier (u64)
+//   Paramètres  type de réseau, matériau, modèle de frottement, propriétés variables (4 × u8),
+//               pressions, longueur de boucle, températures, isolant (6 × f64)
+//   Index       position (u64) de chaque enregistrement de tronçon dans le fichier
+//   Tronçons    taille (u32), id / nom / parent (u32 + UTF-8), longueur, dénivelé, retour,
+//               extrémités sur le schéma, appareils (type, quantité, position),
+//               puis résultats si l'option HasResults est posée (avec les détails de calcul :
+//               Re, λ, pertes linéaires, thermique...)
+//
+// Les valeurs sont écrites dans l'ordre des octets de la machine (petit-boutiste sur les
+// plateformes de l'application). L'index donne un accès direct à chaque tronçon : le fichier
+// est projeté en mémoire et un tronçon n'est décodé qu'à la demande (ProjectReader::segment).
+namespace ProjectFormat {
+
+constexpr char Magic[4] = {'T', 'C', 'H', 'P'};
+constexpr std::uint16_t Version = 1;
+constexpr std::uint16_t HasResults = 0x0001;    // Option : résultats présents
+constexpr std::size_t HeaderSize = 32;
+constexpr std::size_t ParametersSize = 4 + 6 * 8;
+
+// Encodage d'un enregistrement (partagé avec le journal d'enregistrement automatique)
+void encodeParameters(std::string& buffer, const NetworkCalculationParameters& parameters);
+void encodeSegment(std::string& buffer, const SegmentSnapshot& snapshot, bool withResults);
+
+// Décodage : renvoie le nombre d'octets lus, std::runtime_error si l'enregistrement est invalide
+std::size_t decodeParameters(const char* data, std::size_t size, NetworkCalculationParameters& parameters);
+std::size_t decodeSegment(const char* data, std::size_t size, SegmentSnapshot& snapshot, bool withResults);
+
+} // namespace ProjectFormat
+
+// Écriture d'un projet complet
+class ProjectWriter {
+public:
+    // Fichier temporaire puis remplacement : un projet n'est jamais laissé à moitié écrit
+    static void write(const std::string& path, const ProjectData& project);
+};
+
+// Lecture paresseuse d'un projet projeté en mémoire
+class ProjectReader {
+public:
+    // Projette le fichier et vérifie l'en-tête (dont la version du format) et l'index
+    // (std::runtime_error sinon)
+    explicit ProjectReader(const std::string& path);
+    ~ProjectReader();
+
+    ProjectReader(const ProjectReader&) = delete;
+    ProjectReader& operator=(const ProjectReader&) = delete;
+
+    std::size_t segmentCount() const { return count; }
+    std::uint16_t formatVersion() const { return version; }
+    bool hasResults() const { return (options & ProjectFormat::HasResults) != 0; }
+    std::uint64_t journalSequence() const { return sequence; }
+    const NetworkCalculationParameters& parameters() const { return networkParameters; }
+
+    // Tronçon d'indice donné, décodé à la demande
+    SegmentSnapshot segment(std::size_t index) const;
+
+    // Projet complet
+    ProjectData readAll() const;
+
+private:
+    class MappedFile;
+
+    std::unique_ptr<MappedFile> file;
+    std::uint16_t version;
+    std::uint16_t options;
+    std::size_t count;
+    std::uint64_t sequence;
+    NetworkCalculationParameters networkParameters;
+    const char* index;   // Positions des tronçons (dans la projection)
+    std::size_t recordsOffset;   // Début des enregistrements de tronçons
+};
+
+} // namespace HydraulicCalc
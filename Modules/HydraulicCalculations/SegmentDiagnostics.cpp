@@ -0,0 +1,75 @@
+#include "SegmentDiagnostics.h"
+#include <iomanip>
+#include <sstream>
+
+namespace HydraulicCalc {
+
+void SegmentDiagnostics::set(DiagnosticCode code, double value, double limit) {
+    if (has(code)) {
+        for (std::uint8_t i = 0; i < count; ++i) {
+            if (entries[i].code == code) {
+                entries[i].value = value;
+                entries[i].limit = limit;
+                return;
+            }
+        }
+    }
+    entries[count++] = Diagnostic(code, value, limit);
+    mask |= bit(code);
+}
+
+void SegmentDiagnostics::remove(DiagnosticCode code) {
+    if (!has(code)) {
+        return;
+    }
+    std::uint8_t kept = 0;
+    for (std::uint8_t i = 0; i < count; ++i) {
+        if (entries[i].code != code) {
+            entries[kept++] = entries[i];
+        }
+    }
+    count = kept;
+    mask &= static_cast<std::uint8_t>(~bit(code));
+}
+
+std::string SegmentDiagnostics::describe(const Diagnostic& diagnostic) {
+    std::ostringstream text;
+    text << std::fixed;
+
+    switch (diagnostic.code) {
+        case DiagnosticCode::HighVelocity:
+            text << "⚠️ Vitesse élevée (" << std::setprecision(2) << diagnostic.value
+                 << " m/s pour " << diagnostic.limit << " m/s max). Risque de bruit.";
+            break;
+        case DiagnosticCode::LowVelocity:
+            text << "⚠️ Vitesse faible (" << std::setprecision(2) << diagnostic.value
+                 << " m/s). Risque de stagnation.";
+            break;
+        case DiagnosticCode::InsufficientPressure:
+            text << "❌ Pression insuffisante (" << std::setprecision(1) << diagnostic.value
+                 << " bar disponibles pour " << diagnostic.limit << " bar requis).";
+            break;
+        case DiagnosticCode::LowReturnTemperature:
+            text << "❌ Température de retour trop basse (" << std::setprecision(1) << diagnostic.value
+                 << " °C pour " << diagnostic.limit << " °C minimum).";
+            break;
+    }
+    return text.str();
+}
+
+std::string SegmentDiagnostics::formatRecommendation() const {
+    std::string text;
+    for (const auto& diagnostic : *this) {
+        text += describe(diagnostic) + " ";
+    }
+
+    if (!has(DiagnosticCode::InsufficientPressure)) {
+        std::ostringstream pressure;
+        pressure << std::fixed << std::setprecision(1)
+                 << "✓ Pression suffisante (" << availablePressure << " bar disponibles). ";
+        text += pressure.str();
+    }
+    return text;
+}
+
+} // namespace HydraulicCalc
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace HydraulicCalc {
+
+// Anomalies détectées sur un tronçon
+enum class DiagnosticCode : std::uint8_t {
+    HighVelocity,            // Vitesse > vitesse maximale (bruit)
+    LowVelocity,             // Vitesse < 0.3 m/s (stagnation)
+    InsufficientPressure,    // Pression disponible < pression requise
+    LowReturnTemperature     // Température de retour de boucle < T_départ - ΔT
+};
+
+constexpr std::size_t DiagnosticCodeCount = 4;
+
+// Une anomalie et ses valeurs numériques (unités selon le code :
+// m/s pour les vitesses, bar pour les pressions, °C pour les températures)
+struct Diagnostic {
+    DiagnosticCode code;
+    double value;            // Valeur constatée
+    double limit;            // Seuil non respecté
+
+    Diagnostic() : code(DiagnosticCode::HighVelocity), value(0), limit(0) {}
+    Diagnostic(DiagnosticCode c, double v, double l) : code(c), value(v), limit(l) {}
+};
+
+// Diagnostics d'un tronçon : au plus une entrée par code, stockage fixe sans allocation.
+// Le texte n'est produit qu'à l'affichage (formatRecommendation).
+class SegmentDiagnostics {
+public:
+    SegmentDiagnostics() : count(0), mask(0), availablePressure(0) {}
+
+    // Ajoute ou remplace l'anomalie de même code
+    void set(DiagnosticCode code, double value, double limit);
+    void remove(DiagnosticCode code);
+    void clear() { count = 0; mask = 0; }
+
+    bool has(DiagnosticCode code) const { return (mask & bit(code)) != 0; }
+    bool empty() const { return count == 0; }
+    std::uint8_t getMask() const { return mask; }
+
+    const Diagnostic* begin() const { return entries.data(); }
+    const Diagnostic* end() const { return entries.data() + count; }
+
+    // Pression disponible en sortie du tronçon (bar), rappelée quand elle est suffisante
+    double getAvailablePressure() const { return availablePressure; }
+    void setAvailablePressure(double pressure) { availablePressure = pressure; }
+
+    static std::uint8_t bit(DiagnosticCode code) { return static_cast<std::uint8_t>(1u << static_cast<unsigned>(code)); }
+
+    // Texte d'une anomalie
+    static std::string describe(const Diagnostic& diagnostic);
+
+    // Recommandations complètes du tronçon (rapport PDF, infobulles)
+    std::string formatRecommendation() const;
+
+private:
+    std::array<Diagnostic, DiagnosticCodeCount> entries;
+    std::uint8_t count;
+    std::uint8_t mask;
+    double availablePressure;
+};
+
+} // namespace HydraulicCalc
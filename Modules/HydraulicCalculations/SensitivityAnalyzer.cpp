@@ -0,0 +1,260 @@
+#include "SensitivityAnalyzer.h"
+#include "PipeCatalogue.h"
+#include "HydraulicKernels.h"
+#include "NetworkTree.h"
+#include <algorithm>
+
+namespace HydraulicCalc {
+
+namespace {
+
+// Variables dérivées : longueur, diamètre intérieur, épaisseur d'isolant
+using Dual3 = Dual<3>;
+constexpr size_t LengthVariable = 0;
+constexpr size_t DiameterVariable = 1;
+constexpr size_t InsulationVariable = 2;
+
+// λ en duaux, même aiguillage que FrictionFactor::compute (Table dérivée par Colebrook-White)
+Dual3 frictionFactor(const Dual3& reynolds, const Dual3& relativeRoughness, FrictionModel model) {
+    if (reynolds < FrictionFactor::LaminarLimit) {
+        return 64.0 / reynolds;
+    }
+    if (model == FrictionModel::SwameeJain) {
+        return Kernels::swameeJain(reynolds, relativeRoughness);
+    }
+    return Kernels::colebrookWhite(reynolds, relativeRoughness);
+}
+
+// Résistance thermique totale (K/W par m), comme PipeCatalogue::computeInsulation
+Dual3 totalResistance(const Dual3& diameter, const Dual3& insulation) {
+    // r1 = D/2 + épaisseur de paroi (constante par morceaux du diamètre)
+    double wall = PipeCatalogue::outerRadius(diameter.value) - diameter.value / 2000.0;
+    Dual3 r1 = diameter / 2000.0 + wall;
+    Dual3 r2 = r1 + insulation / 1000.0;
+
+    Dual3 resistance;
+    if (r2.value > r1.value && r1.value > 0) {
+        resistance += Kernels::insulationResistance(r1, r2, PipeCatalogue::InsulationConductivity);
+    }
+    if (r2.value > 0) {
+        resistance += Kernels::externalResistance(r2, PipeCatalogue::ExternalExchangeCoefficient);
+    }
+    return resistance;
+}
+
+// Chute de température (°C) d'un débit (L/min) qui perd heatLoss (W), comme calculateTemperatureDrop
+Dual3 temperatureDrop(const Dual3& heatLoss, double flowRate, const WaterState& water) {
+    double massFlow = (flowRate / 60000.0) * water.density;
+    if (massFlow <= 1e-6) {
+        return Dual3();
+    }
+    return heatLoss / (massFlow * water.specificHeat);
+}
+
+} // namespace
+
+SensitivityResult SensitivityAnalyzer::analyze(const NetworkCalculationParameters& networkParams,
+                                               const std::string& terminalSegmentId,
+                                               size_t maxChanges) const {
+    SensitivityResult result;
+    const auto& segments = networkParams.segments;
+    const size_t count = segments.size();
+    if (count == 0) {
+        return result;
+    }
+
+    // ÉTAPE 1: Arbre (parents, enfants, ordre préfixe)
+    const NetworkTree tree(segments);
+    const std::vector<size_t>& preOrder = tree.preOrder();
+    const size_t noParent = NetworkTree::None;
+
+    // ÉTAPE 2: Dérivées locales de chaque tronçon, une évaluation en Dual<3>
+    const bool hotWater = (networkParams.networkType == NetworkType::HotWater ||
+                           networkParams.networkType == NetworkType::HotWaterWithLoop);
+    const bool looped = (networkParams.networkType == NetworkType::HotWaterWithLoop);
+    const double dropFactor = 1.0 + PipeCalculator::SingularLossRatio;
+
+    std::vector<Dual3> pressureDrop(count);       // Pertes linéaires + singulières (mCE)
+    std::vector<Dual3> supplyTemperatureDrop(count);
+    std::vector<Dual3> returnTemperatureDrop(count);
+    for (size_t i : preOrder) {
+        const NetworkSegment& segment = segments[i];
+        const PipeSegmentResult& calculated = segment.result;
+        if (calculated.actualDiameter <= 0.0) {
+            continue;
+        }
+
+        Dual3 length = Dual3::variable(segment.length, LengthVariable);
+        Dual3 diameter = Dual3::variable(calculated.actualDiameter, DiameterVariable);
+        Dual3 insulation = Dual3::variable(networkParams.insulationThickness, InsulationVariable);
+
+        // Débit → vitesse → Reynolds → λ → Darcy, à la température retenue par le calcul (PASSE 5)
+        double fluidTemperature = hotWater ? (calculated.inletTemperature + calculated.outletTemperature) / 2.0
+                                           : WaterProperties::ColdWaterTemperature;
+        WaterState water = PipeCalculator::getWaterState(fluidTemperature, networkParams.temperatureDependentProperties);
+
+        Dual3 velocity = Kernels::velocity(Dual3(calculated.flowRate), diameter);
+        Dual3 reynolds = Kernels::reynolds(velocity, diameter, water.kinematicViscosity);
+        Dual3 lambda = frictionFactor(reynolds, calculated.details.roughness / diameter, networkParams.frictionModel);
+        pressureDrop[i] = dropFactor * Kernels::darcyPressureDrop(lambda, length, diameter, velocity, water.density);
+
+        if (!looped) {
+            continue;
+        }
+
+        // Pertes thermiques aller et retour → chutes de température
+        Dual3 supplyLoss = (calculated.inletTemperature - networkParams.ambientTemperature) * length
+                         / totalResistance(diameter, insulation);
+        supplyTemperatureDrop[i] = temperatureDrop(supplyLoss, calculated.flowRate,
+            PipeCalculator::getWaterState(calculated.inletTemperature, networkParams.temperatureDependentProperties));
+
+        if (calculated.hasReturn && calculated.returnActualDiameter > 0.0) {
+            Dual3 returnDiameter(calculated.returnActualDiameter);
+            Dual3 returnLoss = (calculated.returnInletTemperature - networkParams.ambientTemperature) * length
+                             / totalResistance(returnDiameter, insulation);
+            returnTemperatureDrop[i] = temperatureDrop(returnLoss, calculated.returnFlowRate,
+                PipeCalculator::getWaterState(calculated.returnInletTemperature, networkParams.temperatureDependentProperties));
+        }
+    }
+
+    // ÉTAPE 3: Point terminal et chemin depuis la source
+    size_t terminal = terminalSegmentId.empty() ? noParent : tree.find(terminalSegmentId);
+    if (terminal == noParent) {
+        // Tronçon d'appareils le plus défavorisé (à défaut, le plus défavorisé du réseau)
+        for (size_t i : preOrder) {
+            bool better = (terminal == noParent)
+                || (!segments[i].fixtures.empty() && segments[terminal].fixtures.empty())
+                || (segments[i].fixtures.empty() == segments[terminal].fixtures.empty()
+                    && segments[i].outletPressure < segments[terminal].outletPressure);
+            if (better) {
+                terminal = i;
+            }
+        }
+    }
+    if (terminal == noParent) {
+        return result;
+    }
+    result.terminalSegmentId = segments[terminal].id;
+    result.terminalPressure = segments[terminal].outletPressure;
+
+    result.segments.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.segments[i].segmentId = segments[i].id;
+    }
+
+    // Remontées vers la source bornées par le nombre de tronçons : une boucle de parents
+    // (schéma incohérent) ne fait pas tourner l'analyse indéfiniment
+    const PipeSeries& series = PipeCatalogue::instance().getSeries(networkParams.material);
+    size_t pathLength = 0;
+    for (size_t i = terminal; i != noParent && pathLength < count; i = tree.parent(i), ++pathLength) {
+        SegmentSensitivity& sensitivity = result.segments[i];
+        const PipeSegmentResult& calculated = segments[i].result;
+
+        // P_terminal = P_source - Σ (pertes + dénivelé) / 10 sur le chemin
+        sensitivity.onTerminalPath = true;
+        sensitivity.pressurePerLength = -pressureDrop[i].derivative(LengthVariable) / 10.0;
+        sensitivity.pressurePerHeight = -1.0 / 10.0;
+        sensitivity.pressurePerDiameter = -pressureDrop[i].derivative(DiameterVariable) / 10.0;
+
+        auto next = std::upper_bound(series.nominalDiameters.begin(), series.nominalDiameters.end(),
+                                     calculated.nominalDiameter);
+        if (next != series.nominalDiameters.end()) {
+            const PipeSize& larger = series.sizes[static_cast<size_t>(next - series.nominalDiameters.begin())];
+            double step = larger.internalDiameter - calculated.actualDiameter;
+            sensitivity.nextNominalDiameter = larger.nominalDiameter;
+            sensitivity.nextDiameterGain = sensitivity.pressurePerDiameter * step;
+            result.pressureChanges.emplace_back(segments[i].id, DesignChangeKind::LargerDiameter,
+                                                step, sensitivity.nextDiameterGain);
+        }
+
+        double lengthStep = std::min(LengthStep, segments[i].length);
+        result.pressureChanges.emplace_back(segments[i].id, DesignChangeKind::ShorterLength,
+                                            lengthStep, -sensitivity.pressurePerLength * lengthStep);
+
+        if (segments[i].heightDifference > 0.0) {
+            double heightStep = std::min(HeightStep, segments[i].heightDifference);
+            result.pressureChanges.emplace_back(segments[i].id, DesignChangeKind::LowerHeight,
+                                                heightStep, -sensitivity.pressurePerHeight * heightStep);
+        }
+    }
+
+    // ÉTAPE 4 (bouclage): Pondérations de la température de retour en chaufferie
+    //   mixing[i]   = part du débit de retour de la racine venant du retour du tronçon i
+    //                 (produit des coefficients de mélange de la racine jusqu'à i)
+    //   exposure[i] = effet d'une baisse de 1 °C en sortie aller du tronçon i sur le retour
+    //                 de la racine (somme des parts des feuilles du bouclage en aval)
+    if (looped) {
+        std::vector<double> mixing(count, 0.0);
+        for (size_t i : preOrder) {
+            if (tree.parent(i) == noParent) {
+                mixing[i] = segments[i].result.hasReturn ? 1.0 : 0.0;
+            }
+
+            double returnFlow = 0.0;
+            int returnChildren = 0;
+            for (size_t c : tree.children(i)) {
+                const NetworkSegment& child = segments[c];
+                if (child.hasReturnLine && child.result.hasReturn) {
+                    returnFlow += child.result.returnFlowRate;
+                    ++returnChildren;
+                }
+            }
+            for (size_t c : tree.children(i)) {
+                const NetworkSegment& child = segments[c];
+                if (child.hasReturnLine && child.result.hasReturn && mixing[i] > 0.0) {
+                    double share = (returnFlow > 0.0001) ? child.result.returnFlowRate / returnFlow
+                                                         : 1.0 / returnChildren;
+                    mixing[c] = mixing[i] * share;
+                }
+            }
+        }
+
+        std::vector<double> exposure(count, 0.0);
+        for (size_t k = preOrder.size(); k-- > 0;) {
+            size_t i = preOrder[k];
+            if (mixing[i] <= 0.0) {
+                continue;
+            }
+            double downstream = 0.0;
+            bool mixesChildren = false;
+            for (size_t c : tree.children(i)) {
+                if (mixing[c] > 0.0) {
+                    downstream += exposure[c];
+                    mixesChildren = true;
+                }
+            }
+            // Sans enfant bouclé, le retour part de la sortie aller du tronçon
+            exposure[i] = mixesChildren ? downstream : mixing[i];
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            double perInsulation = -(exposure[i] * supplyTemperatureDrop[i].derivative(InsulationVariable)
+                                   + mixing[i] * returnTemperatureDrop[i].derivative(InsulationVariable));
+            result.segments[i].returnTemperaturePerInsulation = perInsulation;
+            if (perInsulation > 0.0) {
+                result.temperatureChanges.emplace_back(segments[i].id, DesignChangeKind::ThickerInsulation,
+                                                       InsulationStep, perInsulation * InsulationStep);
+            }
+        }
+
+        size_t root = terminal;
+        for (size_t steps = 0; tree.parent(root) != noParent && steps < count; ++steps) {
+            root = tree.parent(root);
+        }
+        result.returnTemperature = segments[root].result.returnOutletTemperature;
+    }
+
+    // ÉTAPE 5: Classement des modifications les plus efficaces
+    auto rank = [maxChanges](std::vector<DesignChange>& changes) {
+        size_t kept = std::min(maxChanges, changes.size());
+        std::partial_sort(changes.begin(), changes.begin() + kept, changes.end(),
+            [](const DesignChange& a, const DesignChange& b) { return a.gain > b.gain; });
+        changes.erase(changes.begin() + kept, changes.end());
+    };
+    rank(result.pressureChanges);
+    rank(result.temperatureChanges);
+
+    return result;
+}
+
+} // namespace HydraulicCalc
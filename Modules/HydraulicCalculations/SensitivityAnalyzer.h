@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "PipeCalculator.h"
+
+namespace HydraulicCalc {
+
+// Dérivées d'un tronçon au point de fonctionnement calculé
+struct SegmentSensitivity {
+    std::string segmentId;
+    bool onTerminalPath;                    // Tronçon traversé pour alimenter le point terminal
+    double pressurePerLength;               // ∂P_terminal/∂L (bar/m)
+    double pressurePerHeight;               // ∂P_terminal/∂h (bar/m)
+    double pressurePerDiameter;             // ∂P_terminal/∂D intérieur (bar/mm)
+    int nextNominalDiameter;                // DN supérieur dans la série active (0 si aucun)
+    double nextDiameterGain;                // Gain de pression estimé au DN supérieur (bar, premier ordre)
+    double returnTemperaturePerInsulation;  // ∂T_retour/∂e isolant du tronçon (°C/mm), bouclage uniquement
+
+    SegmentSensitivity()
+        : onTerminalPath(false), pressurePerLength(0), pressurePerHeight(0), pressurePerDiameter(0)
+        , nextNominalDiameter(0), nextDiameterGain(0), returnTemperaturePerInsulation(0)
+    {}
+};
+
+// Modification de conception candidate
+enum class DesignChangeKind {
+    LargerDiameter,      // Passage au DN supérieur
+    ShorterLength,       // Raccourcissement du tracé
+    LowerHeight,         // Moindre élévation d'un tronçon montant
+    ThickerInsulation    // Isolant plus épais (bouclage)
+};
+
+struct DesignChange {
+    std::string segmentId;
+    DesignChangeKind kind;
+    double step;         // Ampleur : mm de diamètre intérieur, m, m ou mm d'isolant
+    double gain;         // Effet estimé : bar au point terminal, ou °C sur le retour
+
+    DesignChange(const std::string& id, DesignChangeKind k, double s, double g)
+        : segmentId(id), kind(k), step(s), gain(g) {}
+};
+
+// Résultat de l'analyse de sensibilité
+struct SensitivityResult {
+    std::string terminalSegmentId;              // Point terminal étudié (sortie de ce tronçon)
+    double terminalPressure;                    // Pression disponible au point terminal (bar)
+    double returnTemperature;                   // Température de retour en chaufferie (°C), bouclage
+    std::vector<SegmentSensitivity> segments;   // Même ordre que les segments du réseau
+    std::vector<DesignChange> pressureChanges;     // Par gain de pression décroissant
+    std::vector<DesignChange> temperatureChanges;  // Par gain de température décroissant
+
+    SensitivityResult() : terminalPressure(0), returnTemperature(0) {}
+
+    bool empty() const { return segments.empty(); }
+};
+
+// Analyse de sensibilité par différentiation automatique (mode direct)
+//
+// Sur un réseau déjà calculé, chaque tronçon est réévalué une fois en nombres duaux
+// (longueur, diamètre intérieur, isolant) à travers les mêmes formules que le calcul
+// (Kernels : vitesse → Reynolds → λ → Darcy, résistances thermiques), puis les dérivées
+// locales sont cumulées le long de l'arbre :
+//   - pression au point terminal : somme des dérivées des tronçons du chemin source → terminal ;
+//   - température de retour en chaufferie : chute aller pondérée par la part du débit de retour
+//     qui a traversé le tronçon, chute retour pondérée par les coefficients de mélange.
+// Débits, DN et températures sont figés au point calculé (effets du second ordre négligés).
+// Pour le modèle Table, λ est dérivé par Colebrook-White, que la table interpole.
+// Coût : une évaluation en Dual<3> par tronçon et deux parcours de l'arbre.
+class SensitivityAnalyzer {
+public:
+    // Ampleur des modifications candidates
+    static constexpr double LengthStep = 1.0;        // m
+    static constexpr double HeightStep = 1.0;        // m
+    static constexpr double InsulationStep = 10.0;   // mm
+
+    // terminalSegmentId vide : tronçon d'appareils à la plus faible pression de sortie
+    SensitivityResult analyze(const NetworkCalculationParameters& networkParams,
+                              const std::string& terminalSegmentId = std::string(),
+                              size_t maxChanges = 5) const;
+};
+
+} // namespace HydraulicCalc
@@ -0,0 +1,163 @@
+#include "SizingChartCommand.h"
+#include "SizingChartGenerator.h"
+#include "PipeCatalogue.h"
+#include "../PDFParser/XlsxWriter.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace HydraulicCalc {
+
+namespace {
+
+std::vector<std::string> splitList(const std::string& value, char separator) {
+    std::vector<std::string> items;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, separator)) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+double parseNumber(const std::string& value, const std::string& option) {
+    try {
+        size_t consumed = 0;
+        double number = std::stod(value, &consumed);
+        if (consumed == value.size()) return number;
+    } catch (...) {
+    }
+    throw std::runtime_error("Valeur numérique invalide pour " + option + " : '" + value + "'");
+}
+
+PipeMaterial parseMaterial(const std::string& name) {
+    if (name == "cuivre") return PipeMaterial::Copper;
+    if (name == "per") return PipeMaterial::PEX;
+    if (name == "multicouche") return PipeMaterial::Multilayer;
+    if (name == "acier") return PipeMaterial::Steel;
+    throw std::runtime_error("Matériau inconnu : '" + name + "' (cuivre, per, multicouche, acier)");
+}
+
+} // namespace
+
+std::vector<XlsxSheet> buildSizingChartSheets(const SizingChart& chart) {
+    std::vector<XlsxSheet> sheets;
+    const size_t flowCount = chart.flowRates.size();
+
+    for (const auto& block : chart.blocks) {
+        XlsxSheet sheet;
+        std::ostringstream name;
+        name << PipeCalculator::getMaterialName(block.material) << " " << block.temperature << " C";
+        sheet.name = name.str();
+
+        sheet.headers.push_back("Débit (L/min)");
+        for (int dn : block.nominalDiameters) {
+            sheet.headers.push_back("DN" + std::to_string(dn) + " (mCE)");
+        }
+        sheet.headers.push_back("DN retenu");
+
+        sheet.rows.reserve(flowCount);
+        for (size_t f = 0; f < flowCount; ++f) {
+            std::vector<double> row;
+            row.reserve(block.nominalDiameters.size() + 2);
+            row.push_back(chart.flowRates[f]);
+            for (size_t d = 0; d < block.nominalDiameters.size(); ++d) {
+                row.push_back(block.pressureDrop(d, f, flowCount));
+            }
+            row.push_back(block.selectedDiameters[f]);
+            sheet.rows.push_back(std::move(row));
+        }
+        sheets.push_back(std::move(sheet));
+    }
+    return sheets;
+}
+
+int runSizingChartCommand(const std::vector<std::string>& args) {
+    try {
+        if (args.size() < 2 || args[0] != "--abaque") {
+            throw std::runtime_error("Usage : --abaque <sortie.xlsx|sortie.csv> [options]");
+        }
+        const std::string outputPath = args[1];
+
+        SizingChartGrid grid;
+        grid.materials = {PipeMaterial::Copper, PipeMaterial::PEX, PipeMaterial::Multilayer, PipeMaterial::Steel};
+        grid.flowRates = SizingChartGrid::range(0.5, 300.0, 0.5);
+        grid.temperatures = {10.0, 60.0};
+
+        for (size_t i = 2; i < args.size(); i += 2) {
+            const std::string& option = args[i];
+            if (i + 1 >= args.size()) {
+                throw std::runtime_error("Valeur manquante pour l'option " + option);
+            }
+            const std::string& value = args[i + 1];
+
+            if (option == "--materiaux") {
+                grid.materials.clear();
+                for (const auto& name : splitList(value, ',')) {
+                    grid.materials.push_back(parseMaterial(name));
+                }
+            } else if (option == "--debits") {
+                auto bounds = splitList(value, ':');
+                if (bounds.size() != 3) {
+                    throw std::runtime_error("Format attendu pour --debits : min:max:pas");
+                }
+                grid.flowRates = SizingChartGrid::range(parseNumber(bounds[0], option),
+                                                        parseNumber(bounds[1], option),
+                                                        parseNumber(bounds[2], option));
+            } else if (option == "--temperatures") {
+                grid.temperatures.clear();
+                for (const auto& item : splitList(value, ',')) {
+                    grid.temperatures.push_back(parseNumber(item, option));
+                }
+            } else if (option == "--longueur") {
+                grid.length = parseNumber(value, option);
+            } else if (option == "--reseau") {
+                if (value == "ef") grid.networkType = NetworkType::ColdWater;
+                else if (value == "ecs") grid.networkType = NetworkType::HotWater;
+                else if (value == "bouclage") grid.networkType = NetworkType::HotWaterWithLoop;
+                else throw std::runtime_error("Type de réseau inconnu : '" + value + "' (ef, ecs, bouclage)");
+            } else if (option == "--lambda") {
+                if (value == "table") grid.frictionModel = FrictionModel::Table;
+                else if (value == "swamee") grid.frictionModel = FrictionModel::SwameeJain;
+                else if (value == "colebrook") grid.frictionModel = FrictionModel::ColebrookWhite;
+                else throw std::runtime_error("Méthode λ inconnue : '" + value + "' (table, swamee, colebrook)");
+            } else if (option == "--catalogue") {
+                for (const auto& name : PipeCatalogue::instance().loadFromFile(value)) {
+                    std::cout << "Série de tubes chargée : " << name << std::endl;
+                }
+            } else if (option == "--threads") {
+                grid.maxThreads = static_cast<int>(parseNumber(value, option));
+            } else {
+                throw std::runtime_error("Option inconnue : " + option);
+            }
+        }
+
+        SizingChartGenerator generator;
+        SizingChart chart = generator.generate(grid);
+        std::cout << "Abaques : " << chart.blocks.size() << " feuilles, " << chart.pointCount << " points calculés en "
+                  << chart.computeTimeMs << " ms (" << chart.threadsUsed << " threads)" << std::endl;
+
+        auto writeStart = std::chrono::steady_clock::now();
+        std::string extension = outputPath.size() >= 4 ? outputPath.substr(outputPath.size() - 4) : "";
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+        bool written = (extension == ".csv")
+            ? SizingChartGenerator::writeCsv(chart, outputPath)
+            : XlsxWriter::writeSheetsToXlsx(outputPath, buildSizingChartSheets(chart));
+        if (!written) {
+            throw std::runtime_error("Impossible d'écrire le fichier " + outputPath);
+        }
+
+        double writeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - writeStart).count();
+        std::cout << "Fichier écrit : " << outputPath << " (" << writeMs << " ms)" << std::endl;
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Erreur : " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+} // namespace HydraulicCalc
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "SizingChartGenerator.h"
+
+struct XlsxSheet;  // Défini dans PDFParser/XlsxWriter.h
+
+namespace HydraulicCalc {
+
+// Commande en ligne de génération d'abaques (sans interface graphique)
+//
+//   TCHub.exe --abaque <sortie.xlsx|sortie.csv> [options]
+//     --materiaux cuivre,per,multicouche,acier   (défaut : tous)
+//     --debits min:max:pas                       (L/min, défaut : 0.5:300:0.5)
+//     --temperatures 10,60                       (°C, défaut : 10,60)
+//     --longueur 1                               (m, défaut : 1 = pertes linéiques)
+//     --reseau ef|ecs|bouclage                   (défaut : ef)
+//     --lambda table|swamee|colebrook            (défaut : table)
+//     --threads N                                (défaut : nombre de cœurs)
+//     --catalogue series.csv                     (séries de tubes fabricant, voir PipeCatalogue)
+//
+// args commence par "--abaque". Retourne le code de sortie du processus.
+int runSizingChartCommand(const std::vector<std::string>& args);
+
+// Feuilles du classeur XLSX : une par (matériau, température), débits en lignes, pertes de
+// charge par DN en colonnes, puis le DN retenu
+std::vector<XlsxSheet> buildSizingChartSheets(const SizingChart& chart);
+
+} // namespace HydraulicCalc
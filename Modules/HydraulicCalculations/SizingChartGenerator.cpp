@@ -0,0 +1,190 @@
+#include "SizingChartGenerator.h"
+#include "PipeCatalogue.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+namespace HydraulicCalc {
+
+std::vector<double> SizingChartGrid::range(double min, double max, double step) {
+    std::vector<double> values;
+    if (step <= 0.0 || max < min) {
+        return values;
+    }
+    size_t count = static_cast<size_t>((max - min) / step + 1e-9) + 1;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        values.push_back(min + step * i);
+    }
+    return values;
+}
+
+SizingChart SizingChartGenerator::generate(const SizingChartGrid& grid) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (grid.flowRates.empty() || grid.materials.empty() || grid.temperatures.empty()) {
+        throw std::runtime_error("La grille de l'abaque doit contenir au moins un débit, un matériau et une température");
+    }
+    if (grid.length <= 0.0) {
+        throw std::runtime_error("La longueur de référence de l'abaque doit être positive");
+    }
+
+    SizingChart chart;
+    chart.flowRates = grid.flowRates;
+    chart.length = grid.length;
+    const size_t flowCount = grid.flowRates.size();
+
+    // ÉTAPE 1: Préparer les blocs (matériau, température) et la liste des lignes (bloc, DN)
+    PipeCalculator calculator;
+    struct RowTask {
+        size_t block;
+        size_t dnIndex;
+    };
+    std::vector<RowTask> tasks;
+
+    for (PipeMaterial material : grid.materials) {
+        std::vector<int> diameters = calculator.getAvailableDiameters(material);
+        for (double temperature : grid.temperatures) {
+            SizingChartBlock block;
+            block.material = material;
+            block.temperature = temperature;
+            block.nominalDiameters = diameters;
+            for (int dn : diameters) {
+                block.internalDiameters.push_back(calculator.getInternalDiameter(dn, material));
+            }
+            block.velocities.assign(diameters.size() * flowCount, 0.0);
+            block.pressureDrops.assign(diameters.size() * flowCount, 0.0);
+            block.selectedDiameters.assign(flowCount, diameters.empty() ? 0 : diameters.back());
+
+            for (size_t d = 0; d < diameters.size(); ++d) {
+                tasks.push_back({chart.blocks.size(), d});
+            }
+            chart.pointCount += diameters.size() * flowCount;
+            chart.blocks.push_back(std::move(block));
+        }
+    }
+
+    // ÉTAPE 2: Évaluation parallèle, une ligne (bloc, DN) à la fois
+    int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    int threadCount = (grid.maxThreads > 0) ? grid.maxThreads : std::max(1, hardwareThreads);
+    threadCount = std::max(1, std::min(threadCount, static_cast<int>(tasks.size())));
+    chart.threadsUsed = threadCount;
+
+    std::atomic<size_t> nextTask(0);
+    auto worker = [&]() {
+        PipeCalculator localCalculator;
+        for (size_t t = nextTask++; t < tasks.size(); t = nextTask++) {
+            SizingChartBlock& block = chart.blocks[tasks[t].block];
+            const size_t d = tasks[t].dnIndex;
+            const double diameter = block.internalDiameters[d];
+            const WaterState water = PipeCalculator::getWaterState(block.temperature, grid.temperatureDependentProperties);
+
+            double* velocities = &block.velocities[d * flowCount];
+            double* pressureDrops = &block.pressureDrops[d * flowCount];
+            for (size_t f = 0; f < flowCount; ++f) {
+                double flowRate = grid.flowRates[f];
+                velocities[f] = localCalculator.calculateVelocity(flowRate, diameter);
+                pressureDrops[f] = (flowRate > 0.0)
+                    ? localCalculator.calculatePressureDrop(flowRate, grid.length, diameter, block.material,
+                                                            water, grid.frictionModel)
+                    : 0.0;
+            }
+        }
+    };
+
+    if (threadCount == 1) {
+        worker();
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (int i = 0; i < threadCount; ++i) {
+            threads.emplace_back(worker);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // ÉTAPE 3: DN retenu par calculate() : même sélection dans la série active du matériau,
+    // le plus grand DN si aucun ne respecte la vitesse maximale
+    const double maxVelocity = PipeCalculator::getMaxVelocity(grid.networkType);
+    for (auto& block : chart.blocks) {
+        const PipeSeries& series = PipeCatalogue::instance().getSeries(block.material);
+        for (size_t f = 0; f < flowCount; ++f) {
+            int index = series.selectIndex(grid.flowRates[f], maxVelocity);
+            if (index >= 0) {
+                block.selectedDiameters[f] = series.sizes[index].nominalDiameter;
+            }
+        }
+    }
+
+    chart.computeTimeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    return chart;
+}
+
+bool SizingChartGenerator::writeCsv(const SizingChart& chart, const std::string& outputPath) {
+    std::ofstream file(std::filesystem::u8path(outputPath), std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // BOM UTF-8 pour qu'Excel reconnaisse les accents
+    file << "\xEF\xBB\xBF";
+    file << "Matériau;Température (°C);Débit (L/min);DN;D int (mm);Vitesse (m/s);Perte de charge (mCE);DN retenu\n";
+
+    const size_t flowCount = chart.flowRates.size();
+    std::string buffer;
+    buffer.reserve(1 << 20);
+    char line[256];
+
+    // Formatage par std::to_chars (sans locale ni allocation), point remplacé par une virgule
+    auto appendNumber = [](char*& cursor, char* end, double value, int precision) {
+        auto result = std::to_chars(cursor, end, value, std::chars_format::fixed, precision);
+        std::replace(cursor, result.ptr, '.', ',');
+        cursor = result.ptr;
+        *cursor++ = ';';
+    };
+
+    for (const auto& block : chart.blocks) {
+        const std::string materialName = PipeCalculator::getMaterialName(block.material);
+        for (size_t d = 0; d < block.nominalDiameters.size(); ++d) {
+            for (size_t f = 0; f < flowCount; ++f) {
+                char* cursor = line;
+                char* end = line + sizeof(line) - 8;
+                std::memcpy(cursor, materialName.data(), materialName.size());
+                cursor += materialName.size();
+                *cursor++ = ';';
+                appendNumber(cursor, end, block.temperature, 1);
+                appendNumber(cursor, end, chart.flowRates[f], 3);
+                cursor = std::to_chars(cursor, end, block.nominalDiameters[d]).ptr;
+                *cursor++ = ';';
+                appendNumber(cursor, end, block.internalDiameters[d], 2);
+                appendNumber(cursor, end, block.velocity(d, f, flowCount), 4);
+                appendNumber(cursor, end, block.pressureDrop(d, f, flowCount), 5);
+                if (block.selectedDiameters[f] == block.nominalDiameters[d]) {
+                    std::memcpy(cursor, "oui", 3);
+                    cursor += 3;
+                }
+                *cursor++ = '\n';
+                buffer.append(line, static_cast<size_t>(cursor - line));
+
+                if (buffer.size() > (1 << 20) - sizeof(line)) {
+                    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    buffer.clear();
+                }
+            }
+        }
+    }
+
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return file.good();
+}
+
+} // namespace HydraulicCalc
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "PipeCalculator.h"
+
+namespace HydraulicCalc {
+
+// Grille de paramètres d'un jeu d'abaques de dimensionnement
+struct SizingChartGrid {
+    std::vector<double> flowRates;           // Débits (L/min)
+    std::vector<PipeMaterial> materials;     // Matériaux
+    std::vector<double> temperatures;        // Températures de l'eau (°C)
+    double length;                           // Longueur de référence (m) - 1 = pertes linéiques
+    NetworkType networkType;                 // Type de réseau (vitesse maximale du DN retenu)
+    FrictionModel frictionModel;             // Méthode de calcul de λ (table par défaut : calcul de masse)
+    bool temperatureDependentProperties;     // Propriétés de l'eau selon la température
+    int maxThreads;                          // Nombre maximal de threads - 0 = nombre de cœurs
+
+    SizingChartGrid()
+        : length(1.0)
+        , networkType(NetworkType::ColdWater)
+        , frictionModel(FrictionModel::Table)
+        , temperatureDependentProperties(true)
+        , maxThreads(0)
+    {}
+
+    // Débits de min à max (inclus) par pas constant
+    static std::vector<double> range(double min, double max, double step);
+};
+
+// Abaque d'un couple (matériau, température) : une valeur par (DN, débit)
+struct SizingChartBlock {
+    PipeMaterial material;
+    double temperature;
+    std::vector<int> nominalDiameters;
+    std::vector<double> internalDiameters;   // mm
+    std::vector<double> velocities;          // m/s, [iDN * nombre de débits + iDébit]
+    std::vector<double> pressureDrops;       // mCE sur la longueur de référence (linéaire + singulière)
+    std::vector<int> selectedDiameters;      // DN retenu par PipeCalculator::calculate pour chaque débit
+
+    SizingChartBlock() : material(PipeMaterial::Copper), temperature(0) {}
+
+    double velocity(size_t dnIndex, size_t flowIndex, size_t flowCount) const { return velocities[dnIndex * flowCount + flowIndex]; }
+    double pressureDrop(size_t dnIndex, size_t flowIndex, size_t flowCount) const { return pressureDrops[dnIndex * flowCount + flowIndex]; }
+};
+
+// Jeu d'abaques complet
+struct SizingChart {
+    std::vector<double> flowRates;           // Axe des débits commun à tous les blocs (L/min)
+    double length;
+    std::vector<SizingChartBlock> blocks;    // Un bloc par (matériau, température), dans l'ordre de la grille
+    size_t pointCount;                       // Nombre total de points évalués
+    int threadsUsed;
+    double computeTimeMs;
+
+    SizingChart() : length(1.0), pointCount(0), threadsUsed(1), computeTimeMs(0) {}
+};
+
+// Générateur d'abaques de dimensionnement (débit × DN × matériau × température)
+//
+// Évalue sur toute la grille les mêmes noyaux que PipeCalculator::calculate (vitesse,
+// λ, pertes linéaires et singulières), le DN étant imposé par colonne ; le DN que
+// calculate() retiendrait est fourni pour chaque débit. Les lignes (bloc, DN) sont
+// réparties entre les threads ; chaque ligne est un parcours contigu des débits.
+class SizingChartGenerator {
+public:
+    SizingChart generate(const SizingChartGrid& grid);
+
+    // Export CSV « format long » (séparateur ';' et virgule décimale pour Excel FR)
+    static bool writeCsv(const SizingChart& chart, const std::string& outputPath);
+};
+
+} // namespace HydraulicCalc
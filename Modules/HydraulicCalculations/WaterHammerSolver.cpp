@@ -0,0 +1,537 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include "WaterHammerSolver.h"
+#include "NetworkTree.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace HydraulicCalc {
+
+namespace {
+
+const double GRAVITY = 9.81;            // m/s²
+const double WATER_BULK_MODULUS = 2.2e9; // Module de compressibilité de l'eau (Pa)
+const double WATER_DENSITY = 1000.0;     // kg/m³
+const double VAPOUR_PRESSURE_BAR = -0.98; // Tension de vapeur en pression relative (bar)
+
+// Barrière de synchronisation active entre les pas de temps
+// (un pas de temps dure quelques microsecondes : une attente bloquante coûterait plus cher que le calcul)
+class SpinBarrier {
+public:
+    explicit SpinBarrier(int count) : total(count), waiting(0), generation(0) {}
+
+    void arriveAndWait() {
+        int gen = generation.load(std::memory_order_acquire);
+        if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == total) {
+            waiting.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+        } else {
+            while (generation.load(std::memory_order_acquire) == gen) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    const int total;
+    std::atomic<int> waiting;
+    std::atomic<int> generation;
+};
+
+// Tronçon discrétisé : nœuds [first, first + reaches] dans les tableaux aplatis
+struct MocSegment {
+    int first;
+    int reaches;
+    double B;                    // Impédance caractéristique a/(gA) (s/m²)
+    double R;                    // Coefficient de frottement sur une caractéristique (a·dt) (s²/m⁵)
+    double courant;              // a·dt/dx : 1 = pied des caractéristiques sur un nœud
+    double headReservoir;        // Charge imposée en entrée (racines uniquement)
+    double steadyOutflow;        // Débit soutiré en sortie en régime permanent (m³/s)
+    bool isRoot;
+    std::vector<int> children;
+    std::vector<int> events;     // Indices des fermetures en sortie de ce tronçon
+};
+
+// Invariant de la caractéristique C+ arrivant au nœud k (pied entre k-1 et k)
+inline double characteristicPlus(const MocSegment& m, const double* H, const double* Q, int k) {
+    double h = H[k - 1];
+    double q = Q[k - 1];
+    if (m.courant < 1.0) {
+        h = H[k] + m.courant * (h - H[k]);
+        q = Q[k] + m.courant * (q - Q[k]);
+    }
+    return h + m.B * q - m.R * q * std::abs(q);
+}
+
+// Invariant de la caractéristique C- arrivant au nœud k (pied entre k et k+1)
+inline double characteristicMinus(const MocSegment& m, const double* H, const double* Q, int k) {
+    double h = H[k + 1];
+    double q = Q[k + 1];
+    if (m.courant < 1.0) {
+        h = H[k] + m.courant * (h - H[k]);
+        q = Q[k] + m.courant * (q - Q[k]);
+    }
+    return h - m.B * q + m.R * q * std::abs(q);
+}
+
+struct MocEvent {
+    double startTime;
+    double closureTime;
+    double flowReduction;        // Débit coupé en fin de fermeture (m³/s)
+};
+
+} // namespace
+
+double WaterHammerSolver::getWaveSpeed(PipeMaterial material, double internalDiameter, double wallThickness) {
+    // Formule de Korteweg : a = √(K/ρ) / √(1 + K·D / (E·e))
+    double youngModulus = 0.0;  // Module d'Young de la paroi (Pa)
+    switch (material) {
+        case PipeMaterial::Copper:     youngModulus = 120e9; break;
+        case PipeMaterial::PEX:        youngModulus = 0.8e9; break;
+        case PipeMaterial::Multilayer: youngModulus = 2.5e9; break;  // Âme aluminium + PE (valeur équivalente)
+        case PipeMaterial::Steel:      youngModulus = 200e9; break;
+    }
+
+    double soundSpeed = std::sqrt(WATER_BULK_MODULUS / WATER_DENSITY);
+    if (youngModulus <= 0.0 || wallThickness <= 0.0 || internalDiameter <= 0.0) {
+        return soundSpeed;
+    }
+    return soundSpeed / std::sqrt(1.0 + WATER_BULK_MODULUS * internalDiameter / (youngModulus * wallThickness));
+}
+
+double WaterHammerSolver::getWallThickness(int nominalDiameter, double internalDiameter) {
+    // Le DN correspond au diamètre extérieur pour cuivre/PER/multicouche,
+    // et l'acier est approximé par D_int = 0.85 × DN (voir getInternalDiameter)
+    double thickness = (nominalDiameter - internalDiameter) / 2.0;
+    return (thickness > 0.1) ? thickness : 1.0;
+}
+
+double WaterHammerSolver::getTypicalClosureTime(FixtureType type) {
+    switch (type) {
+        case FixtureType::WCFlushValve:
+            return 0.1;   // Robinet de chasse à fermeture rapide
+        case FixtureType::UrinalFlush:
+            return 0.2;   // Robinet de chasse d'urinoir
+        case FixtureType::WashingMachine:
+        case FixtureType::Dishwasher:
+            return 0.03;  // Électrovanne
+        default:
+            return 0.5;   // Mitigeur / robinet manuel
+    }
+}
+
+std::vector<ValveClosureEvent> WaterHammerSolver::buildFastClosureEvents(const NetworkCalculationParameters& networkParams) {
+    std::vector<ValveClosureEvent> events;
+    for (const auto& segment : networkParams.segments) {
+        for (const auto& fixture : segment.fixtures) {
+            if (fixture.type == FixtureType::WCFlushValve ||
+                fixture.type == FixtureType::UrinalFlush ||
+                fixture.type == FixtureType::WashingMachine ||
+                fixture.type == FixtureType::Dishwasher) {
+                events.emplace_back(segment.id, fixture.type, fixture.quantity, 0.0, 0.0);
+            }
+        }
+    }
+    return events;
+}
+
+TransientResult WaterHammerSolver::solve(const NetworkCalculationParameters& networkParams,
+                                         const std::vector<ValveClosureEvent>& events,
+                                         const TransientOptions& options) {
+    auto startClock = std::chrono::steady_clock::now();
+
+    TransientResult transient;
+    const auto& segments = networkParams.segments;
+    const int segmentCount = static_cast<int>(segments.size());
+    if (segmentCount == 0) {
+        return transient;
+    }
+
+    // ÉTAPE 1: Topologie (index parent/enfants) et ordre de parcours racines → feuilles
+    const NetworkTree tree(segments);
+    std::vector<MocSegment> moc(segmentCount);
+    for (int s = 0; s < segmentCount; ++s) {
+        const auto& seg = segments[s];
+        if (seg.result.actualDiameter <= 0.0) {
+            throw std::runtime_error("Le réseau doit être calculé avant l'analyse du coup de bélier (tronçon '" + seg.name + "')");
+        }
+        if (!seg.parentId.empty() && tree.find(seg.parentId) == NetworkTree::None) {
+            throw std::runtime_error("Le segment '" + seg.name + "' référence un parent inexistant '" + seg.parentId + "'");
+        }
+        moc[s].isRoot = seg.parentId.empty();
+        for (size_t child : tree.children(s)) {
+            moc[s].children.push_back(static_cast<int>(child));
+        }
+    }
+    const std::vector<size_t>& order = tree.breadthFirstOrder();
+    if (order.size() != segments.size()) {
+        throw std::runtime_error("Boucle circulaire détectée dans la hiérarchie des segments");
+    }
+
+    // ÉTAPE 2: Célérités et pas de temps (Courant = 1)
+    std::vector<double> waveSpeeds(segmentCount);
+    std::vector<double> travelTimes(segmentCount);
+    double minTravelTime = std::numeric_limits<double>::max();
+    for (int s = 0; s < segmentCount; ++s) {
+        const auto& result = segments[s].result;
+        double wall = getWallThickness(result.nominalDiameter, result.actualDiameter);
+        waveSpeeds[s] = getWaveSpeed(networkParams.material, result.actualDiameter, wall);
+        travelTimes[s] = std::max(0.1, segments[s].length) / waveSpeeds[s];
+        minTravelTime = std::min(minTravelTime, travelTimes[s]);
+    }
+
+    // Grille d'un tronçon pour le pas dt : nombre entier de mailles à maxWaveSpeedAdjustment
+    // près (célérité ajustée de T/(n·dt) - 1, et la surpression de Joukowsky ρ·a·ΔV d'autant),
+    // sinon célérité physique et n = ⌊T/dt⌋ mailles parcourues avec un Courant n·dt/T < 1
+    struct SegmentGrid {
+        int reaches;
+        double courant;
+        double adjustment;
+    };
+    const double maxAdjustment = options.maxWaveSpeedAdjustment;
+    auto gridFor = [&](int s, double step) {
+        SegmentGrid grid;
+        grid.reaches = std::max(1, static_cast<int>(std::lround(travelTimes[s] / step)));
+        grid.adjustment = travelTimes[s] / (grid.reaches * step) - 1.0;
+        grid.courant = 1.0;
+        if (std::abs(grid.adjustment) > maxAdjustment) {
+            grid.reaches = std::max(1, static_cast<int>(travelTimes[s] / step));
+            grid.courant = std::min(1.0, grid.reaches * step / travelTimes[s]);
+            grid.adjustment = 0.0;
+        }
+        return grid;
+    };
+    auto minCourantFor = [&](double step) {
+        double worst = 1.0;
+        for (int s = 0; s < segmentCount; ++s) {
+            worst = std::min(worst, gridFor(s, step).courant);
+        }
+        return worst;
+    };
+
+    double dt = options.timeStep;
+    if (dt <= 0.0) {
+        // Plus grand pas T_min/n (n mailles sur le tronçon le plus court) qui garde tous les
+        // tronçons interpolés au-dessus de minCourant ; à défaut, le meilleur pas ≥ minTimeStep.
+        // Un tronçon de m mailles ou plus a un Courant ≥ m/(m+1) : la recherche est courte.
+        dt = std::max(minTravelTime, options.minTimeStep);
+        double bestCourant = minCourantFor(dt);
+        for (int n = 2; n <= 1000 && bestCourant < options.minCourant; ++n) {
+            double candidate = minTravelTime / n;
+            if (candidate < options.minTimeStep) {
+                break;
+            }
+            double courant = minCourantFor(candidate);
+            if (courant > bestCourant) {
+                bestCourant = courant;
+                dt = candidate;
+            }
+        }
+    }
+
+    // ÉTAPE 3: Discrétisation et état initial (régime permanent)
+    // Les charges sont reconstruites depuis la pression d'alimentation (H = p + z) pour
+    // garantir la continuité aux jonctions quelle que soit la profondeur de l'arbre.
+    std::vector<double> inletHead(segmentCount, 0.0);
+    std::vector<double> inletElevation(segmentCount, 0.0);
+    std::vector<double> pathTravelTime(segmentCount, 0.0);
+    std::vector<double> frictionLosses(segmentCount, 0.0);
+    std::vector<double> waveSpeedAdjustments(segmentCount, 0.0);
+    int totalNodes = 0;
+
+    for (size_t index : order) {
+        const int s = static_cast<int>(index);
+        const auto& seg = segments[s];
+        auto& m = moc[s];
+        const SegmentGrid grid = gridFor(s, dt);
+        m.reaches = grid.reaches;
+        m.courant = grid.courant;
+        waveSpeedAdjustments[s] = grid.adjustment;
+        waveSpeeds[s] *= 1.0 + grid.adjustment;  // Ajustement de la célérité à la grille
+        m.first = totalNodes;
+        totalNodes += m.reaches + 1;
+
+        double area = M_PI * std::pow(seg.result.actualDiameter / 2000.0, 2);
+        m.B = waveSpeeds[s] / (GRAVITY * area);
+
+        // Pertes par frottement du régime permanent (mCE) : nulles sur un tronçon sans débit,
+        // dont la perte de charge n'est pas définie (feuille sans appareil)
+        double steadyFlow = seg.result.flowRate / 60000.0;  // L/min → m³/s
+        double frictionLoss = seg.result.pressureDrop - seg.result.details.heightPressureDrop;
+        if (steadyFlow <= 1e-9 || !std::isfinite(frictionLoss)) {
+            frictionLoss = 0.0;
+        }
+        frictionLosses[s] = frictionLoss;
+        m.R = (steadyFlow > 1e-9) ? frictionLoss * m.courant / (m.reaches * steadyFlow * steadyFlow) : 0.0;
+
+        double childFlow = 0.0;
+        for (int child : m.children) {
+            childFlow += segments[child].result.flowRate / 60000.0;
+        }
+        m.steadyOutflow = std::max(0.0, steadyFlow - childFlow);
+
+        if (m.isRoot) {
+            inletHead[s] = networkParams.supplyPressure * 10.0;  // bar → mCE
+            inletElevation[s] = 0.0;
+            m.headReservoir = inletHead[s];
+            pathTravelTime[s] = travelTimes[s];
+        }
+        for (int child : m.children) {
+            inletHead[child] = inletHead[s] - frictionLoss;
+            inletElevation[child] = inletElevation[s] + seg.heightDifference;
+            pathTravelTime[child] = pathTravelTime[s] + travelTimes[child];
+        }
+    }
+
+    // Tableaux aplatis (SoA) : double tampon pour H et Q, cote Z fixe
+    std::vector<double> headBuffers[2] = { std::vector<double>(totalNodes), std::vector<double>(totalNodes) };
+    std::vector<double> flowBuffers[2] = { std::vector<double>(totalNodes), std::vector<double>(totalNodes) };
+    std::vector<double> elevation(totalNodes);
+
+    for (int s = 0; s < segmentCount; ++s) {
+        const auto& seg = segments[s];
+        const auto& m = moc[s];
+        double steadyFlow = seg.result.flowRate / 60000.0;
+        for (int j = 0; j <= m.reaches; ++j) {
+            double fraction = static_cast<double>(j) / m.reaches;
+            headBuffers[0][m.first + j] = inletHead[s] - frictionLosses[s] * fraction;
+            flowBuffers[0][m.first + j] = steadyFlow;
+            elevation[m.first + j] = inletElevation[s] + seg.heightDifference * fraction;
+        }
+    }
+
+    // ÉTAPE 4: Événements de fermeture
+    std::vector<MocEvent> mocEvents;
+    double lastClosureEnd = 0.0;
+    for (const auto& event : events) {
+        const size_t index = tree.find(event.segmentId);
+        if (index == NetworkTree::None) {
+            throw std::runtime_error("Fermeture sur un tronçon inexistant '" + event.segmentId + "'");
+        }
+        auto& m = moc[index];
+        MocEvent mocEvent;
+        mocEvent.startTime = std::max(0.0, event.startTime);
+        mocEvent.closureTime = (event.closureTime > 0.0) ? event.closureTime : getTypicalClosureTime(event.fixtureType);
+        double unitFlow = FixtureCatalogue::instance().flowRate(event.fixtureType) / 60000.0;
+        mocEvent.flowReduction = std::min(unitFlow * std::max(1, event.quantity), m.steadyOutflow);
+        m.events.push_back(static_cast<int>(mocEvents.size()));
+        mocEvents.push_back(mocEvent);
+        lastClosureEnd = std::max(lastClosureEnd, mocEvent.startTime + mocEvent.closureTime);
+    }
+
+    double duration = options.duration;
+    if (duration <= 0.0) {
+        double maxPathTime = *std::max_element(pathTravelTime.begin(), pathTravelTime.end());
+        duration = std::max(0.2, lastClosureEnd + 3.0 * 4.0 * maxPathTime);
+    }
+    const int steps = std::max(1, static_cast<int>(std::ceil(duration / dt)));
+
+    // Enveloppes (max/min de la pression relative H - Z, en mCE), partant de l'état initial
+    std::vector<double> envelopeMax(segmentCount);
+    std::vector<double> envelopeMin(segmentCount);
+    for (int s = 0; s < segmentCount; ++s) {
+        int first = moc[s].first;
+        envelopeMax[s] = envelopeMin[s] = headBuffers[0][first] - elevation[first];
+    }
+
+    auto scanEnvelope = [&](int s, const double* head) {
+        const auto& m = moc[s];
+        const double* z = elevation.data();
+        double localMax = envelopeMax[s];
+        double localMin = envelopeMin[s];
+        for (int k = m.first; k <= m.first + m.reaches; ++k) {
+            double p = head[k] - z[k];
+            localMax = std::max(localMax, p);
+            localMin = std::min(localMin, p);
+        }
+        envelopeMax[s] = localMax;
+        envelopeMin[s] = localMin;
+    };
+
+    std::vector<double> initialMax(segmentCount);
+    for (int s = 0; s < segmentCount; ++s) {
+        scanEnvelope(s, headBuffers[0].data());
+        initialMax[s] = envelopeMax[s];
+    }
+
+    // Débit soutiré en sortie de tronçon à l'instant t
+    auto outflowAt = [&](const MocSegment& m, double t) {
+        double q = m.steadyOutflow;
+        for (int e : m.events) {
+            const auto& ev = mocEvents[e];
+            double closed = (t - ev.startTime) / ev.closureTime;
+            closed = std::min(1.0, std::max(0.0, closed));
+            q -= ev.flowReduction * closed;
+        }
+        return std::max(0.0, q);
+    };
+
+    // Mise à jour d'un tronçon : lit le tampon « old », écrit le tampon « new »
+    auto advanceSegment = [&](int s, int oldIdx, double t) {
+        const auto& m = moc[s];
+        const double* Ho = headBuffers[oldIdx].data();
+        const double* Qo = flowBuffers[oldIdx].data();
+        double* Hn = headBuffers[oldIdx ^ 1].data();
+        double* Qn = flowBuffers[oldIdx ^ 1].data();
+        const double B = m.B;
+        const double halfInvB = 0.5 / B;
+        const int first = m.first;
+        const int last = m.first + m.reaches;
+
+        // Nœuds intérieurs : boucle contiguë, sans branchement sur la grille exacte
+        if (m.courant == 1.0) {
+            const double R = m.R;
+            for (int k = first + 1; k < last; ++k) {
+                double qa = Qo[k - 1];
+                double qb = Qo[k + 1];
+                double cp = Ho[k - 1] + B * qa - R * qa * std::abs(qa);
+                double cm = Ho[k + 1] - B * qb + R * qb * std::abs(qb);
+                Hn[k] = 0.5 * (cp + cm);
+                Qn[k] = (cp - cm) * halfInvB;
+            }
+        } else {
+            for (int k = first + 1; k < last; ++k) {
+                double cp = characteristicPlus(m, Ho, Qo, k);
+                double cm = characteristicMinus(m, Ho, Qo, k);
+                Hn[k] = 0.5 * (cp + cm);
+                Qn[k] = (cp - cm) * halfInvB;
+            }
+        }
+
+        // Entrée d'un tronçon racine : réservoir à charge constante
+        if (m.isRoot) {
+            double cm = characteristicMinus(m, Ho, Qo, first);
+            Hn[first] = m.headReservoir;
+            Qn[first] = (m.headReservoir - cm) / B;
+        }
+
+        // Sortie : appareil (débit imposé) ou jonction avec les enfants
+        double cp = characteristicPlus(m, Ho, Qo, last);
+        double demand = outflowAt(m, t);
+
+        if (m.children.empty()) {
+            Qn[last] = demand;
+            Hn[last] = cp - B * demand;
+        } else {
+            // Charge commune : Qparent = Σ Qenfants + Qsoutiré
+            double numerator = cp / B - demand;
+            double sumInvB = 1.0 / B;
+            for (int child : m.children) {
+                const auto& c = moc[child];
+                numerator += characteristicMinus(c, Ho, Qo, c.first) / c.B;
+                sumInvB += 1.0 / c.B;
+            }
+            double junctionHead = numerator / sumInvB;
+            Hn[last] = junctionHead;
+            Qn[last] = (cp - junctionHead) / B;
+            for (int child : m.children) {
+                const auto& c = moc[child];
+                Hn[c.first] = junctionHead;
+                Qn[c.first] = (junctionHead - characteristicMinus(c, Ho, Qo, c.first)) / c.B;
+            }
+        }
+    };
+
+    // ÉTAPE 5: Répartition des tronçons entre threads (blocs contigus de charge équivalente)
+    int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    int threadCount = std::max(1, hardwareThreads);
+    if (options.maxThreads > 0) {
+        threadCount = std::min(threadCount, options.maxThreads);
+    }
+    threadCount = std::min(threadCount, std::max(1, totalNodes / 4096));  // Petits réseaux : un seul thread
+    threadCount = std::min(threadCount, segmentCount);
+
+    std::vector<int> chunkStart(threadCount + 1, segmentCount);
+    chunkStart[0] = 0;
+    {
+        int chunk = 1;
+        int accumulated = 0;
+        for (int s = 0; s < segmentCount && chunk < threadCount; ++s) {
+            accumulated += moc[s].reaches + 1;
+            if (accumulated >= static_cast<long long>(totalNodes) * chunk / threadCount) {
+                chunkStart[chunk++] = s + 1;
+            }
+        }
+    }
+
+    // ÉTAPE 6: Intégration temporelle
+    SpinBarrier barrier(threadCount);
+    auto worker = [&](int tid) {
+        for (int step = 0; step < steps; ++step) {
+            int oldIdx = step & 1;
+            double t = (step + 1) * dt;
+            for (int s = chunkStart[tid]; s < chunkStart[tid + 1]; ++s) {
+                if (step > 0) {
+                    scanEnvelope(s, headBuffers[oldIdx].data());
+                }
+                advanceSegment(s, oldIdx, t);
+            }
+            if (threadCount > 1) {
+                barrier.arriveAndWait();
+            }
+        }
+    };
+
+    if (threadCount == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount - 1);
+        for (int tid = 1; tid < threadCount; ++tid) {
+            threads.emplace_back(worker, tid);
+        }
+        worker(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    const double* finalHead = headBuffers[steps & 1].data();
+    for (int s = 0; s < segmentCount; ++s) {
+        scanEnvelope(s, finalHead);
+    }
+
+    // ÉTAPE 7: Résultats
+    transient.timeStep = dt;
+    transient.maxWaveSpeedAdjustment = 0.0;
+    transient.minCourant = 1.0;
+    transient.duration = steps * dt;
+    transient.steps = steps;
+    transient.totalNodes = totalNodes;
+    transient.threadsUsed = threadCount;
+    transient.maxPressure = -std::numeric_limits<double>::max();
+    transient.minPressure = std::numeric_limits<double>::max();
+    transient.envelopes.resize(segmentCount);
+
+    for (int s = 0; s < segmentCount; ++s) {
+        auto& envelope = transient.envelopes[s];
+        envelope.segmentId = segments[s].id;
+        envelope.waveSpeed = waveSpeeds[s];
+        envelope.waveSpeedAdjustment = waveSpeedAdjustments[s];
+        transient.maxWaveSpeedAdjustment = std::max(transient.maxWaveSpeedAdjustment, std::abs(waveSpeedAdjustments[s]));
+        envelope.reaches = moc[s].reaches;
+        envelope.courant = moc[s].courant;
+        transient.minCourant = std::min(transient.minCourant, moc[s].courant);
+        envelope.initialMaxPressure = initialMax[s] / 10.0;  // mCE → bar
+        envelope.maxPressure = envelopeMax[s] / 10.0;
+        envelope.minPressure = envelopeMin[s] / 10.0;
+        envelope.maxSurge = envelope.maxPressure - envelope.initialMaxPressure;
+        envelope.cavitationRisk = envelope.minPressure < VAPOUR_PRESSURE_BAR;
+
+        if (envelope.maxPressure > transient.maxPressure) {
+            transient.maxPressure = envelope.maxPressure;
+            transient.criticalSegmentId = envelope.segmentId;
+        }
+        transient.minPressure = std::min(transient.minPressure, envelope.minPressure);
+    }
+
+    transient.computeTimeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startClock).count();
+    return transient;
+}
+
+} // namespace HydraulicCalc
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "PipeCalculator.h"
+
+namespace HydraulicCalc {
+
+// Événement de fermeture d'un appareil (entrée de l'analyse transitoire)
+struct ValveClosureEvent {
+    std::string segmentId;       // Segment portant l'appareil (fermeture en sortie de segment)
+    FixtureType fixtureType;     // Type d'appareil qui se ferme
+    int quantity;                // Nombre d'appareils fermés simultanément
+    double startTime;            // Instant de début de fermeture (s)
+    double closureTime;          // Durée de fermeture (s) - 0 = valeur typique du type d'appareil
+
+    ValveClosureEvent(const std::string& segId = "", FixtureType type = FixtureType::WCFlushValve,
+                      int qty = 1, double start = 0.0, double duration = 0.0)
+        : segmentId(segId), fixtureType(type), quantity(qty)
+        , startTime(start), closureTime(duration)
+    {}
+};
+
+// Options de la simulation transitoire
+struct TransientOptions {
+    double timeStep;             // Pas de temps (s) - 0 = automatique (voir maxWaveSpeedAdjustment et minCourant)
+    double minTimeStep;          // Pas de temps minimal en mode automatique (s)
+    double maxWaveSpeedAdjustment; // Écart relatif maximal entre célérité de la grille et célérité physique
+    double minCourant;           // Nombre de Courant minimal des tronçons interpolés (mode automatique) - 1 = sans interpolation
+    double duration;             // Durée simulée (s) - 0 = automatique (fermetures + 3 périodes 4L/a)
+    int maxThreads;              // Nombre maximal de threads - 0 = nombre de cœurs
+
+    TransientOptions()
+        : timeStep(0.0)
+        , minTimeStep(1e-5)
+        , maxWaveSpeedAdjustment(0.02)
+        , minCourant(0.8)
+        , duration(0.0)
+        , maxThreads(0)
+    {}
+};
+
+// Enveloppe de pression d'un tronçon (sortie de l'analyse transitoire)
+struct SegmentPressureEnvelope {
+    std::string segmentId;
+    double waveSpeed;            // Célérité des ondes utilisée (m/s, après ajustement à la grille)
+    double waveSpeedAdjustment;  // Écart relatif avec la célérité physique (ex: -0.01 = -1 %), reporté sur la surpression
+    int reaches;                 // Nombre de mailles de calcul sur le tronçon
+    double courant;              // Nombre de Courant a·dt/dx (1 = grille exacte, < 1 = interpolation entre nœuds)
+    double initialMaxPressure;   // Pression statique maximale avant fermeture (bar)
+    double maxPressure;          // Pression maximale atteinte sur le tronçon (bar)
+    double minPressure;          // Pression minimale atteinte sur le tronçon (bar)
+    double maxSurge;             // Surpression maximale par rapport au régime permanent (bar)
+    bool cavitationRisk;         // Pression < tension de vapeur (risque de rupture de veine)
+
+    SegmentPressureEnvelope()
+        : waveSpeed(0), waveSpeedAdjustment(0), reaches(0), courant(1), initialMaxPressure(0)
+        , maxPressure(0), minPressure(0), maxSurge(0), cavitationRisk(false)
+    {}
+};
+
+// Résultat global de l'analyse transitoire
+struct TransientResult {
+    std::vector<SegmentPressureEnvelope> envelopes;  // Même ordre que NetworkCalculationParameters::segments
+    double timeStep;             // Pas de temps effectif (s)
+    double maxWaveSpeedAdjustment; // Plus grand écart relatif |célérité de la grille / célérité physique - 1|
+    double minCourant;           // Plus petit nombre de Courant des tronçons
+    double duration;             // Durée simulée (s)
+    int steps;                   // Nombre de pas de temps
+    int totalNodes;              // Nombre total de nœuds de calcul
+    int threadsUsed;             // Nombre de threads utilisés
+    double maxPressure;          // Pression maximale sur tout le réseau (bar)
+    double minPressure;          // Pression minimale sur tout le réseau (bar)
+    std::string criticalSegmentId;   // Tronçon où la pression maximale est atteinte
+    double computeTimeMs;        // Temps de calcul (ms)
+
+    TransientResult()
+        : timeStep(0), maxWaveSpeedAdjustment(0), minCourant(1), duration(0), steps(0), totalNodes(0), threadsUsed(1)
+        , maxPressure(0), minPressure(0), computeTimeMs(0)
+    {}
+};
+
+// Analyse du coup de bélier par la méthode des caractéristiques (MOC)
+//
+// Le réseau doit avoir été calculé au préalable par PipeCalculator::calculateNetwork :
+// le régime permanent (débits, diamètres, pressions) sert d'état initial.
+// Hypothèses : alimentation à charge constante aux racines, demandes imposées aux
+// appareils, frottement quasi-stationnaire calé sur les pertes du régime permanent.
+// La rupture de veine (cavitation) n'est pas modélisée, seulement signalée.
+//
+// Grille : chaque tronçon dont le temps de parcours L/a tombe sur un nombre entier de pas
+// à maxWaveSpeedAdjustment près est calculé sur la grille exacte (Courant 1, célérité
+// ajustée) ; les autres gardent leur célérité physique et interpolent le pied des
+// caractéristiques entre deux nœuds (Courant < 1, un peu de diffusion numérique).
+// Le pas automatique est le plus grand qui garde tous les tronçons interpolés au-dessus de
+// minCourant : le coût croît comme 1/dt², minCourant = 1 retrouve la grille exacte partout.
+class WaterHammerSolver {
+public:
+    // Simulation transitoire sur l'arbre des segments
+    TransientResult solve(const NetworkCalculationParameters& networkParams,
+                          const std::vector<ValveClosureEvent>& events,
+                          const TransientOptions& options = TransientOptions());
+
+    // Célérité des ondes (m/s) selon le matériau et la géométrie du tube (formule de Korteweg)
+    static double getWaveSpeed(PipeMaterial material, double internalDiameter, double wallThickness);
+
+    // Épaisseur de paroi (mm) cohérente avec PipeCalculator::getInternalDiameter
+    static double getWallThickness(int nominalDiameter, double internalDiameter);
+
+    // Durée de fermeture typique (s) selon le type d'appareil
+    static double getTypicalClosureTime(FixtureType type);
+
+    // Fermeture de tous les appareils à fermeture rapide du réseau (robinets de chasse, électrovannes)
+    static std::vector<ValveClosureEvent> buildFastClosureEvents(const NetworkCalculationParameters& networkParams);
+};
+
+} // namespace HydraulicCalc
@@ -0,0 +1,110 @@
+#include "WaterProperties.h"
+#include <algorithm>
+#include <cmath>
+
+namespace HydraulicCalc {
+
+namespace {
+
+// Valeurs de référence de l'eau à pression atmosphérique, tous les 5 °C de 5 à 90 °C
+const int ReferenceCount = 18;
+
+// Viscosité dynamique μ (mPa·s)
+const double ReferenceViscosity[ReferenceCount] = {
+    1.519, 1.306, 1.138, 1.002, 0.890, 0.797, 0.719, 0.653, 0.596,
+    0.547, 0.504, 0.467, 0.433, 0.404, 0.378, 0.355, 0.334, 0.315
+};
+
+// Masse volumique ρ (kg/m³)
+const double ReferenceDensity[ReferenceCount] = {
+    999.97, 999.70, 999.10, 998.21, 997.05, 995.65, 994.03, 992.22, 990.21,
+    988.04, 985.69, 983.20, 980.55, 977.76, 974.84, 971.79, 968.61, 965.31
+};
+
+// Chaleur spécifique cp (J/(kg·K))
+const double ReferenceSpecificHeat[ReferenceCount] = {
+    4205.0, 4195.0, 4189.0, 4184.0, 4181.0, 4180.0, 4179.0, 4179.0, 4180.0,
+    4181.0, 4183.0, 4185.0, 4187.0, 4190.0, 4193.0, 4197.0, 4201.0, 4205.0
+};
+
+// Conductivité thermique λ (W/(m·K))
+const double ReferenceConductivity[ReferenceCount] = {
+    0.571, 0.580, 0.589, 0.598, 0.607, 0.615, 0.623, 0.631, 0.637,
+    0.644, 0.649, 0.654, 0.659, 0.663, 0.667, 0.670, 0.673, 0.675
+};
+
+const double ReferenceStep = 5.0;  // °C
+
+// Interpolation cubique de Catmull-Rom entre les points de référence (construction de la table)
+double interpolateReference(const double* values, double position) {
+    int i = std::min(static_cast<int>(position), ReferenceCount - 2);
+    double t = position - i;
+
+    double p0 = values[std::max(i - 1, 0)];
+    double p1 = values[i];
+    double p2 = values[i + 1];
+    double p3 = values[std::min(i + 2, ReferenceCount - 1)];
+
+    // Tangentes (différences décentrées aux extrémités)
+    double m1 = (i > 0) ? (p2 - p0) / 2.0 : (p2 - p1);
+    double m2 = (i + 2 < ReferenceCount) ? (p3 - p1) / 2.0 : (p2 - p1);
+
+    double t2 = t * t;
+    double t3 = t2 * t;
+    return (2.0 * t3 - 3.0 * t2 + 1.0) * p1 + (t3 - 2.0 * t2 + t) * m1
+         + (-2.0 * t3 + 3.0 * t2) * p2 + (t3 - t2) * m2;
+}
+
+} // namespace
+
+const WaterProperties& WaterProperties::instance() {
+    static const WaterProperties properties;
+    return properties;
+}
+
+WaterProperties::WaterProperties() {
+    const int entries = static_cast<int>(std::lround((MaxTemperature - MinTemperature) / TableStep)) + 1;
+    table.resize(entries);
+
+    // La viscosité varie de façon quasi exponentielle : interpolation sur ln(μ)
+    double logViscosity[ReferenceCount];
+    for (int i = 0; i < ReferenceCount; ++i) {
+        logViscosity[i] = std::log(ReferenceViscosity[i]);
+    }
+
+    for (int k = 0; k < entries; ++k) {
+        double position = (k * TableStep) / ReferenceStep;
+        WaterState& state = table[k];
+        state.density = interpolateReference(ReferenceDensity, position);
+        state.specificHeat = interpolateReference(ReferenceSpecificHeat, position);
+        state.thermalConductivity = interpolateReference(ReferenceConductivity, position);
+
+        double dynamicViscosity = std::exp(interpolateReference(logViscosity, position)) * 1.0e-3;  // mPa·s → Pa·s
+        state.kinematicViscosity = dynamicViscosity / state.density;
+    }
+}
+
+WaterState WaterProperties::at(double temperature) const {
+    double position = (std::min(std::max(temperature, MinTemperature), MaxTemperature) - MinTemperature) / TableStep;
+    int i = std::min(static_cast<int>(position), static_cast<int>(table.size()) - 2);
+    double t = position - i;
+
+    const WaterState& a = table[i];
+    const WaterState& b = table[i + 1];
+
+    WaterState state;
+    state.kinematicViscosity = a.kinematicViscosity + t * (b.kinematicViscosity - a.kinematicViscosity);
+    state.density = a.density + t * (b.density - a.density);
+    state.specificHeat = a.specificHeat + t * (b.specificHeat - a.specificHeat);
+    state.thermalConductivity = a.thermalConductivity + t * (b.thermalConductivity - a.thermalConductivity);
+    return state;
+}
+
+double WaterProperties::kinematicViscosity(double temperature) const {
+    double position = (std::min(std::max(temperature, MinTemperature), MaxTemperature) - MinTemperature) / TableStep;
+    int i = std::min(static_cast<int>(position), static_cast<int>(table.size()) - 2);
+    double t = position - i;
+    return table[i].kinematicViscosity + t * (table[i + 1].kinematicViscosity - table[i].kinematicViscosity);
+}
+
+} // namespace HydraulicCalc
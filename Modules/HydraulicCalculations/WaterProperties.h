@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+
+namespace HydraulicCalc {
+
+// Propriétés physiques de l'eau à une température donnée
+// Le constructeur par défaut donne les valeurs constantes historiques du module
+// (ν = 10⁻⁶ m²/s, ρ = 1000 kg/m³, cp = 4186 J/(kg·K))
+struct WaterState {
+    double kinematicViscosity;   // Viscosité cinématique ν (m²/s)
+    double density;              // Masse volumique ρ (kg/m³)
+    double specificHeat;         // Chaleur spécifique cp (J/(kg·K))
+    double thermalConductivity;  // Conductivité thermique λ (W/(m·K))
+
+    WaterState()
+        : kinematicViscosity(1.0e-6)
+        , density(1000.0)
+        , specificHeat(4186.0)
+        , thermalConductivity(0.6)
+    {}
+};
+
+// Table des propriétés de l'eau entre 5 °C et 90 °C
+//
+// Construite une seule fois (pas de 0.1 °C) à partir des valeurs de référence tous
+// les 5 °C ; une requête est une simple interpolation linéaire entre deux entrées
+// voisines, sans fonction transcendante. Hors plage, la température est bornée.
+class WaterProperties {
+public:
+    static constexpr double MinTemperature = 5.0;     // °C
+    static constexpr double MaxTemperature = 90.0;    // °C
+    static constexpr double TableStep = 0.1;          // °C
+    static constexpr double ColdWaterTemperature = 10.0;  // Température de calcul de l'eau froide (°C)
+
+    // Table partagée (construite au premier appel)
+    static const WaterProperties& instance();
+
+    // Propriétés interpolées à la température donnée (°C)
+    WaterState at(double temperature) const;
+
+    // Raccourcis
+    static WaterState atTemperature(double temperature) { return instance().at(temperature); }
+    double kinematicViscosity(double temperature) const;
+
+private:
+    WaterProperties();
+
+    std::vector<WaterState> table;
+};
+
+} // namespace HydraulicCalc
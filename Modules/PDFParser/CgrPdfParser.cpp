@@ -1,243 +1,97 @@
 #include "CgrPdfParser.h"
-#include "PopplerPdfExtractor.h"
-#include <fstream>
-#include <sstream>
-#include <regex>
+#include "DebugLog.h"
+#include "FrenchNumber.h"
+#include "LineMatcher.h"
+#include "PdfTextStream.h"
+#include "TextScanner.h"
 #include <algorithm>
-#include <filesystem>
 #include <cctype>
-#include <windows.h>
 
-// ===== FONCTIONS HELPERS (définies avant extractText) =====
+// ===== FONCTIONS HELPERS =====
 
-// Fonction helper pour normaliser un nombre français avec espaces intercalés
-// Ex: "1 9 ,0 2" → 19.02
-//     "7 4 1 7 ,8 0" → 7417.80
-static double normalizeNumber(std::string str)
-{
-    // Enlever TOUS les espaces (y compris tabs, espaces insécables U+00A0)
-    str.erase(std::remove_if(str.begin(), str.end(),
-        [](unsigned char c) { return std::isspace(c) || c == '\xA0'; }),
-        str.end());
-
-    // Remplacer virgule par point
-    std::replace(str.begin(), str.end(), ',', '.');
-
-    try {
-        return std::stod(str);
-    }
-    catch (...) {
-        return 0.0;
-    }
-}
-
-// Fonction helper pour trim les espaces
-static std::string trim(const std::string& s)
-{
-    auto start = s.find_first_not_of(" \t\r\n");
-    auto end = s.find_last_not_of(" \t\r\n");
-    if (start == std::string::npos) return std::string();
-    return s.substr(start, end - start + 1);
-}
-
-// Post-traite le texte pour enlever les espaces intercalés (causés par -layout)
+// Post-traite une ligne pour enlever les espaces intercalés (causés par -layout)
 // Stratégie : les espaces multiples (2+) = vrais séparateurs de colonnes
 //             les espaces simples = faux espaces entre caractères
-static std::string removeInterleavedSpaces(const std::string& text)
+// Le résultat remplace le contenu de processed (tampon réutilisé d'une ligne à l'autre)
+static void removeInterleavedSpaces(std::string_view line, std::string& processed)
 {
-    std::string result;
-    result.reserve(text.length());
-
-    const std::string MARKER = "\x01\x02\x03";  // Marqueur temporaire
-
-    // Traiter ligne par ligne pour préserver les newlines
-    std::istringstream stream(text);
-    std::string line;
-    bool first = true;
+    processed.clear();
 
-    while (std::getline(stream, line))
+    size_t i = 0;
+    while (i < line.length())
     {
-        if (!first) result += '\n';
-        first = false;
+        if (line[i] == ' ')
+        {
+            size_t j = i;
+            while (j < line.length() && line[j] == ' ')
+                j++;
 
-        std::string processed;
+            // Espaces multiples = vrai séparateur, gardé visible sous forme de DEUX espaces
+            // Sinon on ignore (espace simple = faux espace)
+            if (j - i >= 2)
+                processed += "  ";
 
-        // 1. Remplacer les espaces multiples (2+) par le marqueur
-        size_t i = 0;
-        while (i < line.length())
-        {
-            if (line[i] == ' ')
-            {
-                size_t spaceCount = 0;
-                size_t j = i;
-                while (j < line.length() && line[j] == ' ')
-                {
-                    spaceCount++;
-                    j++;
-                }
-
-                if (spaceCount >= 2)
-                {
-                    // Espaces multiples = vrai séparateur
-                    processed += MARKER;
-                }
-                // Sinon on ignore (espace simple = faux espace)
-
-                i = j;
-            }
-            else
-            {
-                processed += line[i];
-                i++;
-            }
+            i = j;
         }
-
-        // 2. Remplacer le marqueur par DEUX espaces (pour garder la séparation visible)
-        size_t pos = 0;
-        while ((pos = processed.find(MARKER, pos)) != std::string::npos)
+        else
         {
-            processed.replace(pos, MARKER.length(), "  ");  // 2 espaces, pas 1
-            pos += 2;
+            processed += line[i];
+            i++;
         }
-
-        result += processed;
     }
-
-    return result;
 }
 
 // Fonction pour nettoyer une référence en enlevant les espaces intercalés
 // Ex: "R SA U 5 0" → "RSAU50"
-static std::string cleanReference(std::string str)
-{
-    str.erase(std::remove_if(str.begin(), str.end(),
-        [](unsigned char c) { return std::isspace(c); }),
-        str.end());
-    return str;
-}
-
-// ===== METHODES DE LA CLASSE =====
-
-std::string CgrPdfParser::extractText(const std::string& filePath)
+static std::string cleanReference(std::string_view str)
 {
-    // Utiliser PopplerPdfExtractor AVEC -layout pour avoir tout sur une ligne
-    // Puis on post-traitera pour enlever les espaces intercalés
-    std::string text = PopplerPdfExtractor::extractTextFromPdf(filePath, true);
-
-    // Post-traiter pour enlever les espaces intercalés
-    text = removeInterleavedSpaces(text);
-
-    OutputDebugStringA("[CGR] Post-traitement des espaces intercales effectue\n");
-
-    // Debug: sauvegarder le texte extrait après post-traitement
-    try
+    std::string cleaned;
+    cleaned.reserve(str.size());
+    for (char c : str)
     {
-        std::filesystem::path pdfPathObj(filePath);
-        std::filesystem::path debugPath = pdfPathObj.parent_path() / (pdfPathObj.stem().string() + "_cgr_extracted.txt");
-        std::ofstream debugFile(debugPath);
-        if (debugFile.is_open())
-        {
-            debugFile << text;
-            debugFile.close();
-            std::string debugMsg = "[CGR] Texte extrait sauvegardé dans: " + debugPath.string() + "\n";
-            OutputDebugStringA(debugMsg.c_str());
-        }
+        if (!TextScanner::isSpace(c))
+            cleaned += c;
     }
-    catch (...) {}
-
-    // Debug: afficher dans la console
-    OutputDebugStringA("=== DEBUG EXTRACTION PDF CGR ===\n");
-    std::string debug = "Poppler disponible: " + std::string(PopplerPdfExtractor::isPopplerAvailable() ? "OUI" : "NON") + "\n";
-    debug += "Texte extrait (" + std::to_string(text.length()) + " caractères):\n";
-    size_t previewLength = text.length() < 1500 ? text.length() : 1500;
-    debug += text.substr(0, previewLength) + "\n";
-    debug += "=== FIN DEBUG CGR ===\n";
-    OutputDebugStringA(debug.c_str());
-
-    return text;
+    return cleaned;
 }
 
-// Regex SIMPLE uniquement pour la fin de ligne CGR : Qte Prix € Total €
+// ===== METHODES DE LA CLASSE =====
+
+// Motif de la fin de ligne CGR : Qte Prix € Total €
 // Ex après post-traitement: " 390 19,02€ 7417,80€"  (plus d'espaces intercalés)
-static const std::regex RE_CGR_TAIL(
-    R"(\s(\d+)\s+([\d,]+)\s*€\s+([\d,]+)\s*€)",
-    std::regex::ECMAScript
-);
+static const CgrTailMatcher CGR_TAIL;
 
-// Parsing d'une ligne CGR sans gros regex (évite error_complexity)
-static bool parseLigneCGR(const std::string& lineIn, PdfLine& out)
+// Parsing d'une ligne CGR sans gros regex
+static bool parseLigneCGR(std::string_view line, PdfLine& out)
 {
-    std::string line = lineIn;
 
     // Filtrage rapide : doit contenir € (chaîne UTF-8, pas char) et virgule
     // Note : € en UTF-8 = 3 bytes (0xE2 0x82 0xAC)
     // Mais si lu comme Windows-1252, ça donne "â‚¬"
     bool hasComma = (line.find(',') != std::string::npos);
 
-    // DEBUG: Log des lignes avec virgule pour trouver les articles
-    static int debugCommaLineCount = 0;
-    if (hasComma && debugCommaLineCount < 10) {
-        std::string debugMsg = "[CGR DEBUG] Ligne avec virgule #" + std::to_string(debugCommaLineCount) + ": " +
-            line.substr(0, std::min<size_t>(150, line.length())) + "\n";
-        OutputDebugStringA(debugMsg.c_str());
-
-        // Afficher les bytes du symbole € si présent
-        size_t pos = line.find("\xE2\x82\xAC");
-        if (pos != std::string::npos) {
-            OutputDebugStringA("[CGR DEBUG] Trouve € (UTF-8) dans la ligne !\n");
-        }
-
-        // Chercher "â‚¬" (affichage Windows-1252 de € UTF-8)
-        if (line.find("â‚¬") != std::string::npos ||
-            line.find("\xC3\xA2\xE2\x80\x9A\xC2\xAC") != std::string::npos) {
-            OutputDebugStringA("[CGR DEBUG] Trouve sequence 'â‚¬' dans la ligne !\n");
-        }
-
-        debugCommaLineCount++;
-    }
-
     bool hasEuro = (line.find("\xE2\x82\xAC") != std::string::npos) ||  // € en UTF-8
                    (line.find("€") != std::string::npos);                // Essai direct
 
     if (!hasEuro || !hasComma)
         return false;
 
-    // On ne garde que la fin de la ligne pour le regex (évite error_complexity)
-    const size_t MAX_TAIL = 120;
-    size_t tailStart = 0;
-    std::string tail;
-
-    if (line.size() > MAX_TAIL) {
-        tailStart = line.size() - MAX_TAIL;
-        tail = line.substr(tailStart);
-    } else {
-        tail = line;
-    }
-
-    // 1) Extraction Qte / Prix / Total sur la queue avec petit regex
-    std::smatch m;
-    try {
-        if (!std::regex_search(tail, m, RE_CGR_TAIL)) {
-            return false; // pas une ligne article CGR
-        }
-    }
-    catch (const std::regex_error& e) {
-        std::string errorMsg = "[CGR] ERREUR regex tail: " + std::string(e.what()) + "\n";
-        OutputDebugStringA(errorMsg.c_str());
-        return false;
+    // 1) Extraction Qte / Prix / Total (le matcher lit la ligne une seule fois : plus besoin
+    //    de la tronquer comme avec std::regex)
+    LineMatch m;
+    if (!CGR_TAIL.search(line, m)) {
+        return false; // pas une ligne article CGR
     }
 
-    std::string qteStr = m[1].str();   // ex: "390"
-    std::string prixStr = m[2].str();  // ex: "1 9 ,0 2 "
-    std::string totalStr = m[3].str(); // ex: "7 4 1 7 ,8 0 "
+    const std::string_view qteStr = m[1];   // ex: "390"
+    const std::string_view prixStr = m[2];  // ex: "1 9 ,0 2 "
+    // Montant total dans m[3] (ex: "7 4 1 7 ,8 0 "), non utilisé
 
-    // Position du match dans la ligne complète
-    size_t matchOffsetInTail = static_cast<size_t>(m.position(0));
-    size_t headEnd = tailStart + matchOffsetInTail;
+    // Position du match dans la ligne
+    const size_t headEnd = static_cast<size_t>(m[0].data() - line.data());
 
     // 2) Partie gauche : index + ref + désignation
-    std::string head = line.substr(0, headEnd);
-    head = trim(head);
+    const std::string_view head = TextScanner::trim(line.substr(0, headEnd));
 
     // On saute les espaces + l'index numérique au début
     size_t p = 0;
@@ -257,28 +111,20 @@ static bool parseLigneCGR(const std::string& lineIn, PdfLine& out)
         }
     }
 
-    std::string refRaw = trim(head.substr(refStart, refEnd - refStart));
-    std::string desc = (refEnd < head.size()) ? trim(head.substr(refEnd)) : "";
+    const std::string_view refRaw = TextScanner::trim(head.substr(refStart, refEnd - refStart));
+    const std::string_view desc = (refEnd < head.size()) ? TextScanner::trim(head.substr(refEnd)) : std::string_view();
 
     // On "recolle" la référence (supprimer les espaces) : "R SA U 5 0" -> "RSAU50"
     std::string ref = cleanReference(refRaw);
 
     // 3) Conversion des nombres
     double qte = 0.0;
-    double prix = 0.0;
-    double total = 0.0;
-
-    try {
-        qte = std::stod(trim(qteStr));          // int simple (390)
-        prix = normalizeNumber(prixStr);        // "1 9 ,0 2" -> 19.02
-        total = normalizeNumber(totalStr);      // "7 4 1 7 ,8 0" -> 7417.80
-    }
-    catch (const std::exception& e) {
-        std::string errorMsg = "[CGR] ERREUR conversion nombre: " + std::string(e.what()) +
-            " | qte='" + qteStr + "' prix='" + prixStr + "' total='" + totalStr + "'\n";
-        OutputDebugStringA(errorMsg.c_str());
+    if (!FrenchNumber::parse(qteStr, qte)) {  // int simple (390)
+        if (debugLogEnabled())
+            debugLog("[CGR] ERREUR conversion nombre | qte='" + std::string(qteStr) + "'\n");
         return false;
     }
+    const double prix = FrenchNumber::parseOr(prixStr);  // "1 9 ,0 2" -> 19.02
 
     // 4) Remplissage de la struct
     out.reference = ref;
@@ -289,72 +135,49 @@ static bool parseLigneCGR(const std::string& lineIn, PdfLine& out)
     return true;
 }
 
-std::vector<PdfLine> CgrPdfParser::parseTextContent(const std::string& text)
+void CgrPdfParser::beginDocument()
 {
-    std::vector<PdfLine> lines;
-
-    OutputDebugStringA("=== DEBUT PARSING CGR ===\n");
-
-    // Vérifier si c'est un message d'erreur
-    if (text.find("ERREUR:") == 0)
-    {
-        OutputDebugStringA("[CGR] Texte contient ERREUR, abandon\n");
-        return lines;
-    }
+    debugLog("=== DEBUT PARSING CGR ===\n");
+    debugLog("[CGR] Parsing ligne par ligne avec approche simplifiee (sans gros regex)...\n");
 
-    if (text.empty())
-    {
-        OutputDebugStringA("[CGR] Texte vide, abandon\n");
-        return lines;
-    }
-
-    OutputDebugStringA("[CGR] Parsing ligne par ligne avec approche simplifiee (sans gros regex)...\n");
-
-    // Séparer le texte en lignes
-    std::istringstream stream(text);
-    std::string line;
-    std::vector<std::string> textLines;
-
-    while (std::getline(stream, line))
-    {
-        textLines.push_back(line);
-    }
-
-    std::string lineCountMsg = "[CGR] Nombre de lignes: " + std::to_string(textLines.size()) + "\n";
-    OutputDebugStringA(lineCountMsg.c_str());
+    extractedCount = 0;
+    lines.clear();
+}
 
-    int extractedCount = 0;
+void CgrPdfParser::parseLine(std::string_view line)
+{
+    // Texte extrait AVEC -layout pour avoir tout sur une ligne : enlever d'abord les espaces
+    // intercalés, ligne par ligne
+    PdfLine product;
 
-    // Parser chaque ligne avec la fonction simplifiée
-    for (size_t i = 0; i < textLines.size(); ++i)
+    removeInterleavedSpaces(line, processedLine);
+    if (parseLigneCGR(processedLine, product))
     {
-        PdfLine product;
-
-        if (parseLigneCGR(textLines[i], product))
-        {
-            lines.push_back(product);
-            extractedCount++;
+        lines.push_back(product);
+        extractedCount++;
 
-            std::string debugMsg = "[CGR] Ligne article #" + std::to_string(extractedCount) +
+        if (debugLogEnabled())
+            debugLog("[CGR] Ligne article #" + std::to_string(extractedCount) +
                 ": Ref=" + product.reference +
                 " | Desc=" + product.designation +
                 " | Qte=" + std::to_string(product.quantite) +
-                " | Prix=" + std::to_string(product.prixHT) + "\n";
-            OutputDebugStringA(debugMsg.c_str());
-        }
+                " | Prix=" + std::to_string(product.prixHT) + "\n");
     }
+}
 
+std::vector<PdfLine> CgrPdfParser::endDocument()
+{
     // Log final
     std::string finalMsg = "=== RESUME PARSING CGR ===\n";
     finalMsg += "Produits extraits : " + std::to_string(extractedCount) + "\n";
     finalMsg += "==============================\n";
-    OutputDebugStringA(finalMsg.c_str());
+    debugLog(finalMsg);
 
-    return lines;
+    return std::move(lines);
 }
 
 std::vector<PdfLine> CgrPdfParser::parse(const std::string& filePath)
 {
-    std::string text = extractText(filePath);
-    return parseTextContent(text);
+    // PopplerPdfExtractor AVEC -layout ; les espaces intercalés sont enlevés dans parseLine
+    return PdfTextStream::parseFile(*this, filePath, true, debugSuffix("_cgr_extracted.txt"), extractionThreads);
 }
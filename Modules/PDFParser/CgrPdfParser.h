@@ -7,8 +7,12 @@ public:
     std::vector<PdfLine> parse(const std::string& filePath) override;
     std::string getSupplierName() const override { return "CGR"; }
 
+    void beginDocument() override;
+    void parseLine(std::string_view line) override;
+    std::vector<PdfLine> endDocument() override;
+
 private:
-    // Méthodes privées pour le parsing spécifique CGR
-    std::string extractText(const std::string& filePath);
-    std::vector<PdfLine> parseTextContent(const std::string& text);
+    std::string processedLine;          // Ligne sans espaces intercalés (tampon réutilisé)
+    int extractedCount = 0;
+    std::vector<PdfLine> lines;
 };
@@ -0,0 +1,26 @@
+#include "DebugLog.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+void debugLog(const std::string& message)
+{
+#ifdef _WIN32
+    OutputDebugStringA(message.c_str());
+#else
+    (void)message;
+#endif
+}
+
+bool debugLogEnabled()
+{
+#ifdef _WIN32
+    return IsDebuggerPresent() != 0;
+#else
+    return false;
+#endif
+}
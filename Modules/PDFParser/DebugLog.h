@@ -0,0 +1,11 @@
+#pragma once
+#include <string>
+
+// Trace de débogage (fenêtre de sortie du débogueur sous Windows, sans effet ailleurs),
+// partagée par l'extraction, le cache, les parseurs, l'écriture des classeurs et les
+// conversions par lots
+void debugLog(const std::string& message);
+
+// Vrai lorsqu'un débogueur peut recevoir les traces : les messages construits ligne
+// par ligne dans les parseurs ne sont assemblés que dans ce cas
+bool debugLogEnabled();
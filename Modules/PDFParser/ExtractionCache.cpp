@@ -0,0 +1,489 @@
+#include "ExtractionCache.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Marque de fin d'une entrée (à changer si le format ou l'extraction changent : les anciennes
+// entrées ne sont alors plus reconnues et finissent évincées)
+static constexpr char ENTRY_MAGIC[8] = { 'T', 'C', 'H', 'U', 'B', 'T', 'X', '1' };
+
+// Fin d'une entrée : nombre de pages puis marque (la table des tailles les précède)
+static constexpr size_t TRAILER_SIZE = sizeof(std::uint64_t) + sizeof(ENTRY_MAGIC);
+
+static constexpr const char* ENTRY_EXTENSION = ".cache";
+static constexpr const char* TEMPORARY_EXTENSION = ".tmp";
+
+// Entrée temporaire abandonnée (processus arrêté pendant l'écriture) supprimée après ce délai
+static constexpr std::chrono::hours ABANDONED_TEMPORARY_AGE(24);
+
+static std::mutex configMutex;
+static std::string configuredDirectory;
+static std::uintmax_t configuredMaxBytes = ExtractionCache::DEFAULT_MAX_BYTES;
+
+// Une seule éviction à la fois dans le processus
+static std::mutex evictionMutex;
+
+// ===== FONCTIONS HELPERS =====
+
+static unsigned long currentProcessId()
+{
+#ifdef _WIN32
+    return static_cast<unsigned long>(GetCurrentProcessId());
+#else
+    return static_cast<unsigned long>(getpid());
+#endif
+}
+
+static std::filesystem::path defaultDirectory()
+{
+#ifdef _WIN32
+    if (const wchar_t* localAppData = _wgetenv(L"LOCALAPPDATA"))
+        return std::filesystem::path(localAppData) / L"TCHub" / L"PdfTextCache";
+#endif
+    std::error_code error;
+    const std::filesystem::path temporary = std::filesystem::temp_directory_path(error);
+    return (error ? std::filesystem::current_path() : temporary) / "TCHub_PdfTextCache";
+}
+
+static std::filesystem::path cacheDirectory()
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    return configuredDirectory.empty() ? defaultDirectory() : std::filesystem::u8path(configuredDirectory);
+}
+
+static std::filesystem::path entryPath(const std::string& key)
+{
+    return cacheDirectory() / (key + ENTRY_EXTENSION);
+}
+
+// Fichier projeté en mémoire, en lecture seule (contenu vide si le fichier est vide ou illisible)
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::filesystem::path& path)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                  NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            return;
+
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize))
+        {
+            opened = true;
+            if (fileSize.QuadPart > 0)
+            {
+                // La vue garde la projection ouverte : les handles peuvent être fermés tout de suite
+                HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+                if (mapping != NULL)
+                {
+                    view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                    CloseHandle(mapping);
+                }
+                if (view != nullptr)
+                    length = static_cast<size_t>(fileSize.QuadPart);
+                else
+                    opened = false;
+            }
+        }
+        CloseHandle(file);
+#else
+        const int file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            return;
+
+        struct stat status;
+        if (fstat(file, &status) == 0)
+        {
+            opened = true;
+            if (status.st_size > 0)
+            {
+                void* mapped = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+                if (mapped != MAP_FAILED)
+                {
+                    view = mapped;
+                    length = static_cast<size_t>(status.st_size);
+                }
+                else
+                {
+                    opened = false;
+                }
+            }
+        }
+        ::close(file);
+#endif
+    }
+
+    ~MappedFile()
+    {
+        if (view == nullptr)
+            return;
+#ifdef _WIN32
+        UnmapViewOfFile(view);
+#else
+        munmap(view, length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return opened; }
+    const char* data() const { return static_cast<const char*>(view); }
+    size_t size() const { return length; }
+
+private:
+    void* view = nullptr;
+    size_t length = 0;
+    bool opened = false;
+};
+
+// ----- Empreinte XXH64 (Yann Collet, domaine public) : plusieurs Go/s, 8 octets par pas -----
+
+static constexpr std::uint64_t PRIME64_1 = 0x9E3779B185EBCA87ull;
+static constexpr std::uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4Full;
+static constexpr std::uint64_t PRIME64_3 = 0x165667B19E3779F9ull;
+static constexpr std::uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ull;
+static constexpr std::uint64_t PRIME64_5 = 0x27D4EB2F165667C5ull;
+
+static std::uint64_t rotateLeft(std::uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static std::uint64_t read64(const char* p)
+{
+    std::uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static std::uint32_t read32(const char* p)
+{
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static std::uint64_t xxhRound(std::uint64_t accumulator, std::uint64_t input)
+{
+    accumulator += input * PRIME64_2;
+    accumulator = rotateLeft(accumulator, 31);
+    return accumulator * PRIME64_1;
+}
+
+static std::uint64_t xxhMergeRound(std::uint64_t accumulator, std::uint64_t value)
+{
+    accumulator ^= xxhRound(0, value);
+    return accumulator * PRIME64_1 + PRIME64_4;
+}
+
+static std::uint64_t xxh64(const char* data, size_t length)
+{
+    const char* p = data;
+    const char* const end = data + length;
+    std::uint64_t hash;
+
+    if (length >= 32)
+    {
+        std::uint64_t v1 = PRIME64_1 + PRIME64_2;
+        std::uint64_t v2 = PRIME64_2;
+        std::uint64_t v3 = 0;
+        std::uint64_t v4 = 0 - PRIME64_1;
+        const char* const limit = end - 32;
+        do
+        {
+            v1 = xxhRound(v1, read64(p));
+            v2 = xxhRound(v2, read64(p + 8));
+            v3 = xxhRound(v3, read64(p + 16));
+            v4 = xxhRound(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+        hash = xxhMergeRound(hash, v1);
+        hash = xxhMergeRound(hash, v2);
+        hash = xxhMergeRound(hash, v3);
+        hash = xxhMergeRound(hash, v4);
+    }
+    else
+    {
+        hash = PRIME64_5;
+    }
+
+    hash += static_cast<std::uint64_t>(length);
+
+    while (p + 8 <= end)
+    {
+        hash ^= xxhRound(0, read64(p));
+        hash = rotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+        p += 8;
+    }
+    if (p + 4 <= end)
+    {
+        hash ^= static_cast<std::uint64_t>(read32(p)) * PRIME64_1;
+        hash = rotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+    }
+    while (p < end)
+    {
+        hash ^= static_cast<std::uint64_t>(static_cast<unsigned char>(*p)) * PRIME64_5;
+        hash = rotateLeft(hash, 11) * PRIME64_1;
+        ++p;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// ===== METHODES DE LA CLASSE =====
+
+std::string ExtractionCache::directory()
+{
+    return cacheDirectory().u8string();
+}
+
+void ExtractionCache::setDirectory(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    configuredDirectory = path;
+}
+
+std::uintmax_t ExtractionCache::maxBytes()
+{
+    std::lock_guard<std::mutex> lock(configMutex);
+    return configuredMaxBytes;
+}
+
+void ExtractionCache::setMaxBytes(std::uintmax_t bytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(configMutex);
+        configuredMaxBytes = bytes;
+    }
+    if (bytes > 0)
+        evict();
+}
+
+std::string ExtractionCache::keyFor(const std::string& pdfPath, bool useLayout)
+{
+    if (maxBytes() == 0)
+        return std::string();
+
+    const MappedFile pdf(std::filesystem::u8path(pdfPath));
+    if (!pdf.isOpen() || pdf.size() == 0)
+        return std::string();
+
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(xxh64(pdf.data(), pdf.size())));
+    return std::string(hash) + "_" + std::to_string(pdf.size()) + (useLayout ? "_layout_" : "_raw_") +
+           PopplerPdfExtractor::extractorVersion();
+}
+
+bool ExtractionCache::deliver(const std::string& key, const PopplerPdfExtractor::PageCallback& onPage,
+                              bool& complete)
+{
+    if (key.empty())
+        return false;
+
+    const std::filesystem::path path = entryPath(key);
+    {
+        const MappedFile entry(path);
+        const size_t size = entry.size();
+        if (size < TRAILER_SIZE || std::memcmp(entry.data() + size - sizeof(ENTRY_MAGIC), ENTRY_MAGIC, sizeof(ENTRY_MAGIC)) != 0)
+            return false;
+
+        // Table des tailles de pages, juste avant la fin
+        const std::uint64_t pageCount = read64(entry.data() + size - TRAILER_SIZE);
+        if (pageCount == 0 || pageCount > (size - TRAILER_SIZE) / sizeof(std::uint64_t))
+            return false;
+        const size_t tableOffset = size - TRAILER_SIZE - static_cast<size_t>(pageCount) * sizeof(std::uint64_t);
+
+        std::uint64_t textSize = 0;
+        for (std::uint64_t i = 0; i < pageCount; ++i)
+            textSize += read64(entry.data() + tableOffset + i * sizeof(std::uint64_t));
+        if (textSize != tableOffset)
+            return false;
+
+        debugLog("[ExtractionCache] Texte repris du cache : " + key + " (" + std::to_string(pageCount) + " page(s))\n");
+
+        complete = true;
+        size_t offset = 0;
+        for (std::uint64_t i = 0; i < pageCount; ++i)
+        {
+            const size_t pageSize = static_cast<size_t>(read64(entry.data() + tableOffset + i * sizeof(std::uint64_t)));
+            std::string page(entry.data() + offset, pageSize);
+            offset += pageSize;
+            if (!onPage(page, static_cast<int>(i), static_cast<int>(pageCount)))
+            {
+                complete = false;
+                break;
+            }
+        }
+    }
+
+    // Entrée la plus récemment utilisée (projection refermée : la date peut être modifiée)
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+    return true;
+}
+
+void ExtractionCache::clear()
+{
+    std::lock_guard<std::mutex> lock(evictionMutex);
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory(), error))
+    {
+        std::error_code removeError;
+        if (entry.path().extension() == ENTRY_EXTENSION)
+            std::filesystem::remove(entry.path(), removeError);
+    }
+}
+
+void ExtractionCache::evict()
+{
+    struct Entry
+    {
+        std::filesystem::path path;
+        std::uintmax_t size;
+        std::filesystem::file_time_type lastUse;
+    };
+
+    const std::uintmax_t limit = maxBytes();
+    const auto now = std::filesystem::file_time_type::clock::now();
+
+    std::lock_guard<std::mutex> lock(evictionMutex);
+
+    std::vector<Entry> entries;
+    std::uintmax_t total = 0;
+    std::error_code error;
+    for (const auto& item : std::filesystem::directory_iterator(cacheDirectory(), error))
+    {
+        std::error_code itemError;
+        const std::filesystem::file_time_type lastUse = item.last_write_time(itemError);
+        if (itemError)
+            continue;
+
+        if (item.path().extension() == TEMPORARY_EXTENSION)
+        {
+            if (now - lastUse > ABANDONED_TEMPORARY_AGE)
+                std::filesystem::remove(item.path(), itemError);
+            continue;
+        }
+        if (item.path().extension() != ENTRY_EXTENSION)
+            continue;
+
+        const std::uintmax_t size = item.file_size(itemError);
+        if (itemError)
+            continue;
+        entries.push_back({ item.path(), size, lastUse });
+        total += size;
+    }
+
+    if (total <= limit)
+        return;
+
+    // Les moins récemment utilisées d'abord
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+
+    size_t removed = 0;
+    for (const Entry& entry : entries)
+    {
+        if (total <= limit)
+            break;
+        std::error_code removeError;
+        if (std::filesystem::remove(entry.path, removeError))
+        {
+            total -= entry.size;
+            ++removed;
+        }
+    }
+
+    debugLog("[ExtractionCache] " + std::to_string(removed) + " entree(s) evincee(s), " +
+             std::to_string(total) + " octets conserves\n");
+}
+
+ExtractionCache::Writer::Writer(const std::string& key)
+    : key(key)
+{
+    if (key.empty())
+        return;
+
+    static std::atomic<unsigned> counter(0);
+    const std::filesystem::path directory = cacheDirectory();
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    const std::filesystem::path path = directory / (key + "." + std::to_string(currentProcessId()) + "_" +
+                                                    std::to_string(counter++) + TEMPORARY_EXTENSION);
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (file.is_open())
+        temporaryPath = path.u8string();
+}
+
+ExtractionCache::Writer::~Writer()
+{
+    if (file.is_open())
+        file.close();
+    if (!temporaryPath.empty())
+    {
+        std::error_code error;
+        std::filesystem::remove(std::filesystem::u8path(temporaryPath), error);
+    }
+}
+
+void ExtractionCache::Writer::addPage(std::string_view page)
+{
+    if (!file.is_open())
+        return;
+    file.write(page.data(), static_cast<std::streamsize>(page.size()));
+    pageSizes.push_back(page.size());
+}
+
+void ExtractionCache::Writer::commit()
+{
+    if (!file.is_open() || pageSizes.empty())
+        return;
+
+    for (std::uint64_t pageSize : pageSizes)
+        file.write(reinterpret_cast<const char*>(&pageSize), sizeof(pageSize));
+    const std::uint64_t pageCount = pageSizes.size();
+    file.write(reinterpret_cast<const char*>(&pageCount), sizeof(pageCount));
+    file.write(ENTRY_MAGIC, sizeof(ENTRY_MAGIC));
+    file.close();
+    if (file.fail())
+        return;  // Disque plein... : le destructeur supprime le fichier temporaire
+
+    // Entrée visible seulement une fois complète (remplace une entrée identique écrite entre-temps)
+    std::error_code error;
+    std::filesystem::rename(std::filesystem::u8path(temporaryPath), entryPath(key), error);
+    if (error)
+        return;
+    temporaryPath.clear();
+
+    debugLog("[ExtractionCache] Texte mis en cache : " + key + " (" + std::to_string(pageCount) + " page(s))\n");
+    evict();
+}
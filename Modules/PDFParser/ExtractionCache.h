@@ -0,0 +1,75 @@
+#pragma once
+#include "PopplerPdfExtractor.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Cache disque du texte extrait des PDF (PopplerPdfExtractor::streamPages)
+//
+// Une nouvelle analyse du même PDF (autre fournisseur, nouvel export, lot relancé) reprend le
+// texte du cache au lieu de relancer l'extraction, l'étape la plus lente.
+//   - Clé : empreinte XXH64 du contenu du PDF (lu par projection en mémoire), taille du fichier,
+//     option useLayout et version de l'extraction (PopplerPdfExtractor::extractorVersion). Un PDF
+//     renommé ou déplacé est retrouvé ; un PDF modifié, ou extrait par une autre version de
+//     Poppler ou du code d'extraction, ne l'est plus (l'ancienne entrée finit évincée).
+//   - Une entrée par fichier, lue par projection en mémoire : pages mises bout à bout, puis la
+//     table des tailles de pages en fin de fichier (écrite au fil de l'extraction, sans garder
+//     le texte complet en mémoire).
+//   - Taille totale bornée : au-delà, les entrées les moins récemment utilisées sont supprimées
+//     (date de modification remise à jour à chaque lecture).
+// Utilisable depuis plusieurs threads et plusieurs processus : une entrée est écrite sous un nom
+// temporaire puis renommée une fois complète.
+class ExtractionCache
+{
+public:
+    static constexpr std::uintmax_t DEFAULT_MAX_BYTES = 256ull * 1024 * 1024;
+
+    // Dossier du cache (défaut : %LOCALAPPDATA%/TCHub/PdfTextCache, sinon dossier temporaire)
+    static std::string directory();
+    static void setDirectory(const std::string& path);
+
+    // Taille totale maximale (0 = cache désactivé)
+    static std::uintmax_t maxBytes();
+    static void setMaxBytes(std::uintmax_t bytes);
+
+    // Clé du PDF pour ces options, vide si le fichier est illisible ou le cache désactivé
+    static std::string keyFor(const std::string& pdfPath, bool useLayout);
+
+    // Remet les pages de l'entrée à onPage, dans l'ordre. Retourne false si l'entrée est absente
+    // ou invalide (rien n'a alors été remis) ; sinon complete indique si toutes les pages ont été
+    // acceptées (false si onPage a annulé).
+    static bool deliver(const std::string& key, const PopplerPdfExtractor::PageCallback& onPage,
+                        bool& complete);
+
+    // Supprime toutes les entrées
+    static void clear();
+
+    // Entrée écrite page par page pendant l'extraction ; abandonnée si commit() n'est pas appelé
+    // (extraction annulée ou en échec). Sans effet si la clé est vide.
+    class Writer
+    {
+    public:
+        explicit Writer(const std::string& key);
+        ~Writer();
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        void addPage(std::string_view page);
+
+        // Termine l'entrée, la rend visible et applique la limite de taille
+        void commit();
+
+    private:
+        std::string key;
+        std::string temporaryPath;
+        std::ofstream file;
+        std::vector<std::uint64_t> pageSizes;
+    };
+
+private:
+    // Supprime les entrées les moins récemment utilisées jusqu'à repasser sous maxBytes()
+    static void evict();
+};
@@ -1,14 +1,30 @@
 #pragma once
 #include "IPdfParser.h"
+#include "LineMatcher.h"
 
 class FischerPdfParser : public IPdfParser
 {
 public:
+    FischerPdfParser();
+
     std::vector<PdfLine> parse(const std::string& filePath) override;
     std::string getSupplierName() const override { return "Fischer"; }
 
+    void beginDocument() override;
+    void parseLine(std::string_view line) override;
+    std::vector<PdfLine> endDocument() override;
+
 private:
-    // Méthodes privées pour le parsing spécifique Fischer
-    std::string extractText(const std::string& filePath);
-    std::vector<PdfLine> parseTextContent(const std::string& text);
+    // Motifs des 3 lignes d'un bloc, construits une fois par parseur (voir le constructeur)
+    FischerLine1Matcher line1Matcher;
+    FischerLine2Matcher line2Matcher;
+    DecimalMatcher line3Matcher;
+
+    // State machine à 3 états pour parser les blocs de 3 lignes (conservée d'une page à l'autre)
+    enum class State { WAITING_LINE1, WAITING_LINE2, WAITING_LINE3 };
+    State state = State::WAITING_LINE1;
+    PdfLine currentProduct;
+    int skipLinesCounter = 0;
+    int extractedCount = 0;
+    std::vector<PdfLine> lines;
 };
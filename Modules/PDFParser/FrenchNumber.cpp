@@ -0,0 +1,114 @@
+#include "FrenchNumber.h"
+#include "TextScanner.h"
+#include <charconv>
+#include <system_error>
+
+// Séquences UTF-8 de l'euro et des espaces insécables
+static constexpr std::string_view EURO = "\xE2\x82\xAC";
+static constexpr std::string_view NBSP = "\xC2\xA0";
+static constexpr std::string_view NARROW_NBSP = "\xE2\x80\xAF";
+
+// Longueur du séparateur de milliers en position i (0 si ce n'en est pas un)
+static size_t separatorLength(std::string_view text, size_t i)
+{
+    const char c = text[i];
+    if (c == ' ' || c == '\t')
+        return 1;
+    if (text.compare(i, NBSP.size(), NBSP) == 0)
+        return NBSP.size();
+    if (text.compare(i, NARROW_NBSP.size(), NARROW_NBSP) == 0)
+        return NARROW_NBSP.size();
+    if (c == '\xA0')
+        return 1;
+    return 0;
+}
+
+bool FrenchNumber::parse(std::string_view text, double& value)
+{
+    text = TextScanner::trim(text);
+
+    // Symbole € en fin, éventuellement séparé du nombre par des espaces
+    if (text.size() >= EURO.size() && text.compare(text.size() - EURO.size(), EURO.size(), EURO) == 0)
+    {
+        text.remove_suffix(EURO.size());
+        while (!text.empty())
+        {
+            if (text.back() == ' ' || text.back() == '\t' || text.back() == '\xA0')
+                text.remove_suffix(1);
+            else if (text.size() >= NARROW_NBSP.size() &&
+                     text.compare(text.size() - NARROW_NBSP.size(), NARROW_NBSP.size(), NARROW_NBSP) == 0)
+                text.remove_suffix(NARROW_NBSP.size());
+            else
+                break;
+        }
+    }
+
+    // Chiffres recopiés dans un tampon local, virgule remplacée par le point attendu par
+    // std::from_chars
+    char buffer[MAX_LENGTH];
+    size_t length = 0;
+    size_t i = 0;
+
+    if (i < text.size() && text[i] == '-')
+    {
+        buffer[length++] = '-';
+        ++i;
+        while (i < text.size() && separatorLength(text, i) > 0)
+            i += separatorLength(text, i);
+    }
+
+    const bool commaDecimal = text.find(',', i) != std::string_view::npos;
+    bool hasDigit = false;
+    bool hasDecimalPoint = false;
+
+    while (i < text.size())
+    {
+        const char c = text[i];
+        if (TextScanner::isDigit(c))
+        {
+            if (length == MAX_LENGTH)
+                return false;
+            buffer[length++] = c;
+            hasDigit = true;
+            ++i;
+        }
+        else if (c == ',' || (c == '.' && !commaDecimal))
+        {
+            if (hasDecimalPoint || length == MAX_LENGTH)
+                return false;
+            buffer[length++] = '.';
+            hasDecimalPoint = true;
+            ++i;
+        }
+        else if (c == '.' && !hasDecimalPoint)
+        {
+            ++i;  // Séparateur de milliers "1.234,56"
+        }
+        else if (const size_t separator = separatorLength(text, i))
+        {
+            i += separator;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (!hasDigit)
+        return false;
+
+    double result = 0.0;
+    const std::from_chars_result converted = std::from_chars(buffer, buffer + length, result);
+    if (converted.ec != std::errc() || converted.ptr != buffer + length)
+        return false;
+
+    value = result;
+    return true;
+}
+
+double FrenchNumber::parseOr(std::string_view text, double defaultValue)
+{
+    double value = defaultValue;
+    parse(text, value);
+    return value;
+}
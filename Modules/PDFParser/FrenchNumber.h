@@ -0,0 +1,26 @@
+#pragma once
+#include <string_view>
+
+// Lecture des nombres écrits au format français, sans allocation ni dépendance à la locale
+// (std::from_chars)
+//
+// Formes acceptées, espaces en début et fin ignorés :
+//   "1 234,56"      séparateurs de milliers : espace, tabulation, espace insécable (U+00A0,
+//                   U+202F en UTF-8, ou octet 0xA0 isolé), n'importe où dans le nombre
+//   "1.234,56"      s'il y a une virgule, elle est la marque décimale et les points séparent
+//                   les milliers
+//   "0.68"          sans virgule, le point est la marque décimale
+//   "-12,50"        signe moins en tête (éventuellement suivi d'espaces)
+//   "19,02 €"       symbole € (UTF-8) en fin, facultatif
+class FrenchNumber
+{
+public:
+    // Longueur maximale d'un nombre une fois les séparateurs retirés
+    static constexpr size_t MAX_LENGTH = 64;
+
+    // Retourne false si text n'est pas un nombre complet (value n'est alors pas modifiée)
+    static bool parse(std::string_view text, double& value);
+
+    // Valeur de text, ou defaultValue s'il n'est pas un nombre
+    static double parseOr(std::string_view text, double defaultValue = 0.0);
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 
 // Structure représentant une ligne de produit
@@ -23,4 +24,28 @@ public:
 
     // Retourne le nom du fournisseur
     virtual std::string getSupplierName() const = 0;
+
+    // Analyse incrémentale (PdfTextStream) : beginDocument(), puis chaque ligne du texte dans
+    // l'ordre, sans fin de ligne, puis endDocument() qui retourne les lignes extraites.
+    // La vue passée à parseLine n'est valable que pendant l'appel (elle pointe dans la page).
+    // Les lignes arrivent au fil de l'extraction : un article commencé en bas d'une page est
+    // complété par les lignes de la page suivante.
+    virtual void beginDocument() = 0;
+    virtual void parseLine(std::string_view line) = 0;
+    virtual std::vector<PdfLine> endDocument() = 0;
+
+    // Threads d'extraction utilisés par parse() (0 = un par cœur). La conversion par lots, qui
+    // traite déjà plusieurs fichiers en parallèle, en demande un seul par fichier.
+    void setExtractionThreads(unsigned count) { extractionThreads = count; }
+
+    // Copie du texte extrait écrite à côté du PDF (<nom>_<fournisseur>_extracted.txt) pour la
+    // mise au point des parseurs. La conversion par lots la désactive.
+    void setDebugDump(bool enabled) { debugDump = enabled; }
+
+protected:
+    // Suffixe du fichier de débogage à passer à PdfTextStream::parseFile (vide si désactivé)
+    std::string debugSuffix(const char* suffix) const { return debugDump ? suffix : ""; }
+
+    unsigned extractionThreads = 0;
+    bool debugDump = true;
 };
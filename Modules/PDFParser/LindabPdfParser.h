@@ -1,5 +1,6 @@
 #pragma once
 #include "IPdfParser.h"
+#include "LineMatcher.h"
 
 class LindabPdfParser : public IPdfParser
 {
@@ -7,8 +8,23 @@ public:
     std::vector<PdfLine> parse(const std::string& filePath) override;
     std::string getSupplierName() const override { return "Lindab"; }
 
+    void beginDocument() override;
+    void parseLine(std::string_view line) override;
+    std::vector<PdfLine> endDocument() override;
+
 private:
-    // Méthodes privées pour le parsing spécifique Lindab
-    std::string extractText(const std::string& filePath);
-    std::vector<PdfLine> parseTextContent(const std::string& text);
+    // Motifs reconnus :
+    //   headerMatcher : en-tête d'un article "1 224931 SR 200 3000 GALV"
+    //                   (<numéro ligne> <référence (6 chiffres)> <reste>)
+    //   pceMatcher    : données de la ligne PCE "10,00  PCE                 18,90                    188,99"
+    LindabHeaderMatcher headerMatcher;
+    LindabPceMatcher pceMatcher;
+
+    // État du parsing (conservé d'une page à l'autre)
+    std::vector<PdfLine> lines;
+    bool inProduct = false;
+    std::string currentRef;
+    std::string currentDesig;
+    int totalLineCount = 0;
+    int pceLineCount = 0;
 };
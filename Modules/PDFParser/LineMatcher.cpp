@@ -0,0 +1,453 @@
+#include "LineMatcher.h"
+#include "TextScanner.h"
+
+static constexpr size_t npos = std::string_view::npos;
+static constexpr std::string_view EURO = "\xE2\x82\xAC";
+
+// ===== FONCTIONS HELPERS =====
+// Lecture de gauche à droite : fin de la suite de caractères de la classe commençant en i
+
+static size_t skipSpaces(std::string_view s, size_t i)
+{
+    while (i < s.size() && TextScanner::isSpace(s[i]))
+        ++i;
+    return i;
+}
+
+static size_t skipNonSpaces(std::string_view s, size_t i)
+{
+    while (i < s.size() && !TextScanner::isSpace(s[i]))
+        ++i;
+    return i;
+}
+
+static size_t skipDigits(std::string_view s, size_t i)
+{
+    while (i < s.size() && TextScanner::isDigit(s[i]))
+        ++i;
+    return i;
+}
+
+// [\d,]
+static size_t skipDecimalCharacters(std::string_view s, size_t i)
+{
+    while (i < s.size() && (TextScanner::isDigit(s[i]) || s[i] == ','))
+        ++i;
+    return i;
+}
+
+static bool hasLiteralAt(std::string_view s, size_t i, std::string_view literal)
+{
+    return i <= s.size() && s.size() - i >= literal.size() && s.compare(i, literal.size(), literal) == 0;
+}
+
+// \b derrière un caractère de mot : le suivant n'en est pas un (\w = [A-Za-z0-9_])
+static bool wordEndsAt(std::string_view s, size_t i)
+{
+    return i == s.size() || !(TextScanner::isDigit(s[i]) || TextScanner::isAlpha(s[i]) || s[i] == '_');
+}
+
+// '.' reconnaît tout sauf les fins de ligne
+static bool hasLineTerminator(std::string_view s, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        if (s[i] == '\n' || s[i] == '\r')
+            return true;
+    }
+    return false;
+}
+
+// "\d+,\d{min,max}" commençant en i : fin ou npos
+static size_t matchDecimal(std::string_view s, size_t i, size_t minDecimals, size_t maxDecimals)
+{
+    const size_t comma = skipDigits(s, i);
+    if (comma == i || comma >= s.size() || s[comma] != ',')
+        return npos;
+
+    size_t end = comma + 1;
+    while (end < s.size() && end - comma - 1 < maxDecimals && TextScanner::isDigit(s[end]))
+        ++end;
+    return (end - comma - 1 >= minDecimals) ? end : npos;
+}
+
+// "-?\d+,\d{2}" commençant en i : fin ou npos
+static size_t matchSignedDecimal(std::string_view s, size_t i)
+{
+    if (i < s.size() && s[i] == '-')
+        ++i;
+    return matchDecimal(s, i, 2, 2);
+}
+
+// Lecture de droite à gauche : début de ce qui finit en end, ou npos (npos en entrée est propagé)
+
+// "\s+"
+static size_t matchSpacesBack(std::string_view s, size_t end)
+{
+    if (end == npos)
+        return npos;
+    size_t begin = end;
+    while (begin > 0 && TextScanner::isSpace(s[begin - 1]))
+        --begin;
+    return begin < end ? begin : npos;
+}
+
+static size_t matchLiteralBack(std::string_view s, size_t end, std::string_view literal)
+{
+    if (end == npos || end < literal.size() || s.compare(end - literal.size(), literal.size(), literal) != 0)
+        return npos;
+    return end - literal.size();
+}
+
+// "\d+,\d{decimals}"
+static size_t matchDecimalBack(std::string_view s, size_t end, size_t decimals)
+{
+    if (end == npos || end < decimals + 2)
+        return npos;
+
+    const size_t comma = end - decimals - 1;
+    for (size_t i = comma + 1; i < end; ++i)
+    {
+        if (!TextScanner::isDigit(s[i]))
+            return npos;
+    }
+    if (s[comma] != ',')
+        return npos;
+
+    size_t begin = comma;
+    while (begin > 0 && TextScanner::isDigit(s[begin - 1]))
+        --begin;
+    return begin < comma ? begin : npos;
+}
+
+// ===== LineMatch =====
+
+void LineMatch::clear()
+{
+    for (std::string_view& group : groups)
+        group = std::string_view();
+}
+
+// ===== MATCHERS =====
+
+DecimalMatcher::DecimalMatcher(size_t minDecimals, size_t maxDecimals)
+    : minDecimals(minDecimals),
+      maxDecimals(maxDecimals)
+{
+}
+
+bool DecimalMatcher::search(std::string_view text, LineMatch& match) const
+{
+    size_t i = 0;
+    while (i < text.size())
+    {
+        if (!TextScanner::isDigit(text[i]))
+        {
+            ++i;
+            continue;
+        }
+
+        // Le nombre commence au premier chiffre de la suite ; si elle n'est pas suivie de
+        // ",<décimales>", aucun de ses chiffres ne peut commencer une correspondance
+        const size_t end = matchDecimal(text, i, minDecimals, maxDecimals);
+        if (end != npos)
+        {
+            match.clear();
+            match.set(0, text, i, end);
+            match.set(1, text, i, end);
+            return true;
+        }
+        i = skipDigits(text, i);
+    }
+    return false;
+}
+
+bool LindabHeaderMatcher::search(std::string_view text, LineMatch& match) const
+{
+    const size_t numberStart = skipSpaces(text, 0);
+    const size_t numberEnd = skipDigits(text, numberStart);
+    if (numberEnd == numberStart)
+        return false;
+
+    const size_t refStart = skipSpaces(text, numberEnd);
+    if (refStart == numberEnd)
+        return false;
+
+    // Exactement 6 chiffres suivis d'une fin de mot
+    const size_t refEnd = skipDigits(text, refStart);
+    if (refEnd - refStart != 6 || !wordEndsAt(text, refEnd))
+        return false;
+
+    match.clear();
+    match.set(0, text, 0, refEnd);
+    match.set(1, text, numberStart, numberEnd);
+    match.set(2, text, refStart, refEnd);
+    return true;
+}
+
+bool LindabPceMatcher::search(std::string_view text, LineMatch& match) const
+{
+    size_t i = 0;
+    while (i < text.size())
+    {
+        if (!TextScanner::isDigit(text[i]))
+        {
+            ++i;
+            continue;
+        }
+
+        // Un signe moins juste avant la suite de chiffres fait partie de la quantité
+        const size_t start = (i > 0 && text[i - 1] == '-') ? i - 1 : i;
+
+        const size_t qtyEnd = matchSignedDecimal(text, start);
+        if (qtyEnd != npos)
+        {
+            const size_t unit = skipSpaces(text, qtyEnd);
+            const size_t priceStart = skipSpaces(text, unit + 3);
+            if (hasLiteralAt(text, unit, "PCE") && priceStart > unit + 3)
+            {
+                const size_t priceEnd = matchSignedDecimal(text, priceStart);
+                const size_t amountStart = (priceEnd != npos) ? skipSpaces(text, priceEnd) : npos;
+                const size_t amountEnd = (amountStart != npos && amountStart > priceEnd)
+                    ? matchSignedDecimal(text, amountStart) : npos;
+                if (amountEnd != npos)
+                {
+                    match.clear();
+                    match.set(0, text, start, amountEnd);
+                    match.set(1, text, start, qtyEnd);
+                    match.set(2, text, priceStart, priceEnd);
+                    match.set(3, text, amountStart, amountEnd);
+                    return true;
+                }
+            }
+        }
+        i = skipDigits(text, i);
+    }
+    return false;
+}
+
+// "\s+(\d+)\s+(BTE|PCE)\b" commençant en i : fin ou npos
+static size_t matchFischerUnit(std::string_view s, size_t i, size_t& qtyStart, size_t& qtyEnd, size_t& unitStart)
+{
+    qtyStart = skipSpaces(s, i);
+    if (qtyStart == i)
+        return npos;
+    qtyEnd = skipDigits(s, qtyStart);
+    if (qtyEnd == qtyStart)
+        return npos;
+    unitStart = skipSpaces(s, qtyEnd);
+    if (unitStart == qtyEnd)
+        return npos;
+    if (!hasLiteralAt(s, unitStart, "BTE") && !hasLiteralAt(s, unitStart, "PCE"))
+        return npos;
+    return wordEndsAt(s, unitStart + 3) ? unitStart + 3 : npos;
+}
+
+bool FischerLine1Matcher::search(std::string_view text, LineMatch& match) const
+{
+    const size_t positionStart = skipSpaces(text, 0);
+    const size_t positionEnd = skipDigits(text, positionStart);
+    if (positionEnd == positionStart)
+        return false;
+
+    const size_t designationStart = skipSpaces(text, positionEnd);
+    if (designationStart == positionEnd)
+        return false;
+
+    size_t qtyStart = 0;
+    size_t qtyEnd = 0;
+    size_t unitStart = 0;
+
+    // (.+?) : désignation la plus courte (sans fin de ligne) suivie de la quantité et de l'unité
+    for (size_t q = designationStart + 1; q < text.size(); ++q)
+    {
+        if (text[q - 1] == '\n' || text[q - 1] == '\r')
+            break;
+
+        const size_t end = matchFischerUnit(text, q, qtyStart, qtyEnd, unitStart);
+        if (end != npos)
+        {
+            match.clear();
+            match.set(0, text, 0, end);
+            match.set(1, text, designationStart, q);
+            match.set(2, text, qtyStart, qtyEnd);
+            match.set(3, text, unitStart, end);
+            return true;
+        }
+    }
+
+    // Sinon la désignation peut commencer dans les espaces qui suivent la position, quand le
+    // premier mot est déjà la quantité ("10   6 BTE") : un caractère d'espace suivi du reste
+    const size_t end = matchFischerUnit(text, designationStart - 1, qtyStart, qtyEnd, unitStart);
+    if (end == npos || designationStart < positionEnd + 3)
+        return false;
+
+    for (size_t start = designationStart - 2; start > positionEnd; --start)
+    {
+        if (text[start] != '\n' && text[start] != '\r')
+        {
+            match.clear();
+            match.set(0, text, 0, end);
+            match.set(1, text, start, start + 1);
+            match.set(2, text, qtyStart, qtyEnd);
+            match.set(3, text, unitStart, end);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FischerLine2Matcher::search(std::string_view text, LineMatch& match) const
+{
+    const size_t eanStart = skipSpaces(text, 0);
+    const size_t eanEnd = skipDigits(text, eanStart);
+    if (eanEnd - eanStart < 10)
+        return false;
+
+    const size_t refStart = skipSpaces(text, eanEnd);
+    if (refStart == eanEnd)
+        return false;
+
+    const size_t refEnd = skipDigits(text, refStart);
+    if (refEnd - refStart < 5 || !wordEndsAt(text, refEnd))
+        return false;
+
+    match.clear();
+    match.set(0, text, 0, refEnd);
+    match.set(1, text, refStart, refEnd);
+    return true;
+}
+
+PiecLineMatcher::PiecLineMatcher(Kind kind)
+    : kind(kind)
+{
+}
+
+bool PiecLineMatcher::search(std::string_view text, LineMatch& match) const
+{
+    // Fin de ligne lue de droite à gauche : sa forme ne permet qu'un seul découpage
+    size_t k = text.size();
+    while (k > 0 && TextScanner::isSpace(text[k - 1]))
+        --k;
+
+    size_t totalStart = npos;
+    size_t totalEnd = npos;
+    size_t priceStart = npos;
+    size_t priceEnd = npos;
+
+    if (kind == Kind::PRICED)
+    {
+        totalEnd = k;
+        totalStart = matchDecimalBack(text, k, 2);
+        k = matchLiteralBack(text, matchSpacesBack(text, totalStart), "PIEC");
+        priceEnd = matchSpacesBack(text, k);
+        priceStart = matchDecimalBack(text, priceEnd, 2);
+        k = matchSpacesBack(text, priceStart);
+    }
+    else
+    {
+        k = matchLiteralBack(text, k, "Gratuit");
+        k = matchSpacesBack(text, matchLiteralBack(text, matchSpacesBack(text, k), "PIEC"));
+    }
+
+    const size_t qtyEnd = matchSpacesBack(text, matchLiteralBack(text, k, "PIEC"));
+    const size_t qtyStart = matchDecimalBack(text, qtyEnd, 3);
+    const size_t gapStart = matchSpacesBack(text, qtyStart);
+    if (gapStart == npos)
+        return false;
+
+    match.clear();
+
+    // Début de ligne "(?:(\S+)\s+)?(.*?)" : le premier mot est la référence s'il est suivi
+    // d'espaces, la désignation s'arrête aux espaces qui précèdent la quantité
+    bool found = false;
+    const size_t refEnd = skipNonSpaces(text, 0);
+    if (refEnd > 0)
+    {
+        const size_t designationStart = skipSpaces(text, refEnd);
+        if (designationStart < qtyStart)
+        {
+            if (!hasLineTerminator(text, designationStart, gapStart))
+            {
+                match.set(1, text, 0, refEnd);
+                match.set(2, text, designationStart, gapStart);
+                found = true;
+            }
+        }
+        else if (designationStart >= refEnd + 2)
+        {
+            // Pas de désignation : le dernier espace avant la quantité lui reste
+            match.set(1, text, 0, refEnd);
+            match.set(2, text, designationStart - 1, designationStart - 1);
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        if (hasLineTerminator(text, 0, gapStart))
+            return false;
+        match.set(2, text, 0, gapStart);
+    }
+
+    match.set(0, text, 0, text.size());
+    match.set(3, text, qtyStart, qtyEnd);
+    if (kind == Kind::PRICED)
+    {
+        match.set(4, text, priceStart, priceEnd);
+        match.set(5, text, totalStart, totalEnd);
+    }
+    return true;
+}
+
+bool CgrTailMatcher::search(std::string_view text, LineMatch& match) const
+{
+    for (size_t p = 0; p + 1 < text.size(); ++p)
+    {
+        // Un espace puis la quantité
+        if (!TextScanner::isSpace(text[p]) || !TextScanner::isDigit(text[p + 1]))
+            continue;
+
+        const size_t qtyEnd = skipDigits(text, p + 1);
+        const size_t priceStart = skipSpaces(text, qtyEnd);
+        const size_t priceEnd = skipDecimalCharacters(text, priceStart);
+        if (priceStart == qtyEnd || priceEnd == priceStart)
+            continue;
+
+        size_t k = skipSpaces(text, priceEnd);
+        if (!hasLiteralAt(text, k, EURO))
+            continue;
+        k += EURO.size();
+
+        const size_t totalStart = skipSpaces(text, k);
+        const size_t totalEnd = skipDecimalCharacters(text, totalStart);
+        if (totalStart == k || totalEnd == totalStart)
+            continue;
+
+        k = skipSpaces(text, totalEnd);
+        if (!hasLiteralAt(text, k, EURO))
+            continue;
+
+        match.clear();
+        match.set(0, text, p, k + EURO.size());
+        match.set(1, text, p + 1, qtyEnd);
+        match.set(2, text, priceStart, priceEnd);
+        match.set(3, text, totalStart, totalEnd);
+        return true;
+    }
+    return false;
+}
+
+bool RexelRefMatcher::search(std::string_view text, LineMatch& match) const
+{
+    for (size_t i = text.find("NDX"); i != npos; i = text.find("NDX", i + 1))
+    {
+        const size_t end = skipDigits(text, i + 3);
+        if (end > i + 3)
+        {
+            match.clear();
+            match.set(0, text, i, end);
+            return true;
+        }
+    }
+    return false;
+}
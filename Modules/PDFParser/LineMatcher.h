@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+// Motifs des lignes fournisseurs, reconnus par des automates écrits à la main à la place de
+// std::regex (lent, sujet aux retours arrière et à error_complexity sur les longues lignes).
+// Chaque matcher lit la ligne une seule fois, sans allocation, et donne exactement les mêmes
+// captures que l'expression régulière qu'il remplace (rappelée au-dessus de chaque classe).
+// Les matchers sont construits une fois par parseur et utilisables depuis plusieurs threads.
+
+// Captures d'une correspondance : vues sur le texte analysé (à ne pas libérer avant d'avoir
+// fini de les utiliser). Le groupe 0 est la correspondance complète.
+class LineMatch
+{
+public:
+    static constexpr size_t MAX_GROUPS = 6;
+
+    std::string_view operator[](size_t group) const { return groups[group]; }
+
+    // Faux si le groupe n'a pas participé à la correspondance (groupe optionnel)
+    bool matched(size_t group) const { return groups[group].data() != nullptr; }
+
+    void clear();
+    void set(size_t group, std::string_view text, size_t begin, size_t end)
+    {
+        groups[group] = text.substr(begin, end - begin);
+    }
+
+private:
+    std::string_view groups[MAX_GROUPS];
+};
+
+// Interface commune : première correspondance dans text, comme std::regex_search (les motifs
+// ancrés en début et fin de ligne ne reconnaissent que la ligne entière, comme std::regex_match)
+class LineMatcher
+{
+public:
+    virtual ~LineMatcher() = default;
+
+    virtual bool search(std::string_view text, LineMatch& match) const = 0;
+
+    bool contains(std::string_view text) const
+    {
+        LineMatch match;
+        return search(text, match);
+    }
+};
+
+// Nombre décimal "\d+,\d{min,max}" (groupe 1)
+// Fischer, ligne 3 : (\d+,\d{2})\s*(?:€|EUR)?   (le symbole facultatif ne change rien au groupe 1)
+// Rexel, prix :      (\d+,\d{2,4})
+class DecimalMatcher : public LineMatcher
+{
+public:
+    DecimalMatcher(size_t minDecimals, size_t maxDecimals);
+
+    bool search(std::string_view text, LineMatch& match) const override;
+
+private:
+    size_t minDecimals;
+    size_t maxDecimals;
+};
+
+// Lindab, en-tête d'article : ^\s*(\d+)\s+(\d{6})\b
+class LindabHeaderMatcher : public LineMatcher
+{
+public:
+    bool search(std::string_view text, LineMatch& match) const override;
+};
+
+// Lindab, ligne PCE : (-?\d+,\d{2})\s*PCE\s+(-?\d+,\d{2})\s+(-?\d+,\d{2})
+class LindabPceMatcher : public LineMatcher
+{
+public:
+    bool search(std::string_view text, LineMatch& match) const override;
+};
+
+// Fischer, ligne 1 : ^\s*\d+\s+(.+?)\s+(\d+)\s+(BTE|PCE)\b
+class FischerLine1Matcher : public LineMatcher
+{
+public:
+    bool search(std::string_view text, LineMatch& match) const override;
+};
+
+// Fischer, ligne 2 : ^\s*\d{10,}\s+(\d{5,})\b
+class FischerLine2Matcher : public LineMatcher
+{
+public:
+    bool search(std::string_view text, LineMatch& match) const override;
+};
+
+// Siehr et Pompac, ligne article entière :
+//   PRICED : ^(?:(\S+)\s+)?(.*?)\s+(\d+,\d{3})\s+PIEC\s+(\d+,\d{2})\s+PIEC\s+(\d+,\d{2})\s*$
+//   FREE :   ^(?:(\S+)\s+)?(.*?)\s+(\d+,\d{3})\s+PIEC\s+PIEC\s+Gratuit\s*$
+class PiecLineMatcher : public LineMatcher
+{
+public:
+    enum class Kind { PRICED, FREE };
+
+    explicit PiecLineMatcher(Kind kind);
+
+    bool search(std::string_view text, LineMatch& match) const override;
+
+private:
+    Kind kind;
+};
+
+// CGR, fin de ligne article : \s(\d+)\s+([\d,]+)\s*€\s+([\d,]+)\s*€
+class CgrTailMatcher : public LineMatcher
+{
+public:
+    bool search(std::string_view text, LineMatch& match) const override;
+};
+
+// Rexel, référence article : NDX\d+
+class RexelRefMatcher : public LineMatcher
+{
+public:
+    bool search(std::string_view text, LineMatch& match) const override;
+};
@@ -0,0 +1,96 @@
+#include "MultiPatternScanner.h"
+#include <queue>
+#include <stdexcept>
+
+// Transition absente de l'arbre des mots (avant build)
+static constexpr uint32_t NO_STATE = UINT32_MAX;
+
+size_t MultiPatternScanner::addState()
+{
+    const size_t state = outputs.size();
+    transitions.resize(transitions.size() + ALPHABET_SIZE, NO_STATE);
+    outputs.emplace_back();
+    return state;
+}
+
+size_t MultiPatternScanner::add(std::string_view pattern)
+{
+    if (built)
+        throw std::runtime_error("MultiPatternScanner : ajout d'un mot après build()");
+    if (pattern.empty())
+        throw std::runtime_error("MultiPatternScanner : mot vide");
+
+    if (outputs.empty())
+        addState();  // ROOT
+
+    size_t state = ROOT;
+    for (char c : pattern)
+    {
+        const size_t slot = state * ALPHABET_SIZE + static_cast<unsigned char>(TextScanner::toLowerAscii(c));
+        if (transitions[slot] == NO_STATE)
+        {
+            const size_t child = addState();
+            transitions[slot] = static_cast<uint32_t>(child);
+        }
+        state = transitions[slot];
+    }
+
+    const size_t id = patternLengths.size();
+    patternLengths.push_back(pattern.size());
+    outputs[state].push_back(id);
+    return id;
+}
+
+void MultiPatternScanner::build()
+{
+    if (built)
+        return;
+    built = true;
+
+    if (outputs.empty())
+        addState();
+
+    // Parcours en largeur : le lien d'échec d'un état (plus long suffixe qui est aussi un début
+    // de mot) est toujours moins profond, donc déjà complété quand on arrive sur l'état
+    std::vector<size_t> failure(outputs.size(), ROOT);
+    std::queue<size_t> pending;
+
+    for (size_t c = 0; c < ALPHABET_SIZE; ++c)
+    {
+        uint32_t& target = transitions[ROOT * ALPHABET_SIZE + c];
+        if (target == NO_STATE)
+        {
+            target = ROOT;
+        }
+        else
+        {
+            failure[target] = ROOT;
+            pending.push(target);
+        }
+    }
+
+    while (!pending.empty())
+    {
+        const size_t state = pending.front();
+        pending.pop();
+
+        // Les mots reconnus par le lien d'échec finissent aussi ici
+        const std::vector<size_t>& inherited = outputs[failure[state]];
+        outputs[state].insert(outputs[state].end(), inherited.begin(), inherited.end());
+
+        for (size_t c = 0; c < ALPHABET_SIZE; ++c)
+        {
+            uint32_t& target = transitions[state * ALPHABET_SIZE + c];
+            const uint32_t fallback = transitions[failure[state] * ALPHABET_SIZE + c];
+            if (target == NO_STATE)
+            {
+                target = fallback;
+            }
+            else
+            {
+                failure[target] = fallback;
+                pending.push(target);
+            }
+        }
+    }
+}
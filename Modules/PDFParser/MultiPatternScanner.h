@@ -0,0 +1,57 @@
+#pragma once
+#include "TextScanner.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Recherche simultanée de plusieurs mots dans un texte en un seul passage (automate
+// d'Aho–Corasick) : chaque octet du texte est lu une fois, quel que soit le nombre de mots.
+// Les lettres ASCII sont comparées sans tenir compte de la casse (octets UTF-8 tels quels).
+//
+//   MultiPatternScanner scanner;
+//   const size_t id = scanner.add("PIEC");
+//   scanner.build();
+//   size_t state = MultiPatternScanner::ROOT;
+//   for (size_t i = 0; i < text.size(); ++i)
+//   {
+//       state = scanner.next(state, text[i]);
+//       for (size_t found : scanner.matches(state))  // mots finissant en i
+//           ...
+//   }
+//
+// Une fois construit, l'automate est en lecture seule et utilisable depuis plusieurs threads.
+class MultiPatternScanner
+{
+public:
+    static constexpr size_t ROOT = 0;
+
+    // Ajoute un mot (non vide) avant build() ; retourne son numéro (0, 1, 2...)
+    size_t add(std::string_view pattern);
+
+    // Calcule les transitions : après l'appel, plus aucun mot ne peut être ajouté
+    void build();
+
+    // État suivant après le caractère c
+    size_t next(size_t state, char c) const
+    {
+        return transitions[state * ALPHABET_SIZE + static_cast<unsigned char>(TextScanner::toLowerAscii(c))];
+    }
+
+    // Numéros des mots qui finissent sur le dernier caractère lu pour arriver dans state
+    const std::vector<size_t>& matches(size_t state) const { return outputs[state]; }
+
+    size_t patternLength(size_t pattern) const { return patternLengths[pattern]; }
+    size_t patternCount() const { return patternLengths.size(); }
+
+private:
+    static constexpr size_t ALPHABET_SIZE = 256;
+
+    size_t addState();
+
+    // Table complète (états × octets) : arbre des mots pendant les ajouts, puis automate
+    std::vector<uint32_t> transitions;
+    std::vector<std::vector<size_t>> outputs;
+    std::vector<size_t> patternLengths;
+    bool built = false;
+};
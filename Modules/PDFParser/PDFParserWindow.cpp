@@ -9,14 +9,20 @@
 #include <QFileInfo>
 #include <QApplication>
 #include <QScreen>
+#include <QSignalBlocker>
 #include <QTime>
+#include <QtConcurrent/QtConcurrent>
 
 PDFParserWindow::PDFParserWindow(QWidget *parent)
-    : QDialog(parent)
+    : QDialog(parent),
+      batchCancel(false)
 {
     setupUi();
     applyModernStyle();
 
+    connect(&batchWatcher, &QFutureWatcher<BatchSummary>::finished, this, &PDFParserWindow::onBatchFinished);
+    connect(&detectionWatcher, &QFutureWatcher<SupplierDetection>::finished, this, &PDFParserWindow::onDetectionFinished);
+
     // Centrer la fenêtre
     QScreen *screen = QApplication::primaryScreen();
     QRect screenGeometry = screen->geometry();
@@ -27,6 +33,10 @@ PDFParserWindow::PDFParserWindow(QWidget *parent)
 
 PDFParserWindow::~PDFParserWindow()
 {
+    // Lot en cours : plus aucun fichier n'est commencé, ceux en cours se terminent
+    batchCancel = true;
+    batchWatcher.waitForFinished();
+    detectionWatcher.waitForFinished();
 }
 
 void PDFParserWindow::setupUi()
@@ -139,7 +149,14 @@ void PDFParserWindow::setupUi()
     );
     connect(parseButton, &QPushButton::clicked, this, &PDFParserWindow::onParseClicked);
 
+    batchButton = new QPushButton("📁 Convertir un dossier", this);
+    batchButton->setFixedSize(200, 45);
+    batchButton->setCursor(Qt::PointingHandCursor);
+    batchButton->setToolTip("Convertit tous les PDF d'un dossier, fournisseur reconnu automatiquement");
+    connect(batchButton, &QPushButton::clicked, this, &PDFParserWindow::onBatchClicked);
+
     actionLayout->addWidget(parseButton);
+    actionLayout->addWidget(batchButton);
     actionLayout->addStretch();
 
     mainLayout->addLayout(actionLayout);
@@ -329,7 +346,58 @@ void PDFParserWindow::onBrowseClicked()
     {
         filePathEdit->setText(fileName);
         updateStatus("Fichier sélectionné : " + QFileInfo(fileName).fileName());
+        detectSupplier(fileName);
+    }
+}
+
+void PDFParserWindow::detectSupplier(const QString &filePath)
+{
+    // Signatures de la première page, lue sur un thread de fond (extraction d'un gros PDF ou
+    // lancement de pdftotext) : l'interface reste disponible pendant la détection
+    detectionPath = filePath;
+    updateStatus("🔍 Détection du fournisseur...");
+    const std::string path = filePath.toStdString();
+    detectionWatcher.setFuture(QtConcurrent::run([path]()
+    {
+        return ParserFactory::detectSupplierFromFile(path);
+    }));
+}
+
+void PDFParserWindow::onDetectionFinished()
+{
+    // Un autre fichier a été choisi entre-temps : résultat périmé
+    if (detectionPath != filePathEdit->text())
+        return;
+
+    SupplierDetection detection;
+    try
+    {
+        detection = detectionWatcher.result();
+    }
+    catch (const std::exception&)
+    {
+        detection = SupplierDetection();
+    }
+
+    // Le fournisseur reconnu est présélectionné, le choix reste modifiable dans la liste
+    if (!detection.found)
+    {
+        updateStatus("🔍 Fournisseur non reconnu, sélectionnez-le dans la liste");
+        return;
+    }
+
+    const QString name = QString::fromStdString(ParserFactory::supplierName(detection.supplier));
+    const int index = supplierCombo->findText(name);
+    if (index < 0)
+        return;
+
+    {
+        const QSignalBlocker blocker(supplierCombo);
+        supplierCombo->setCurrentIndex(index);
     }
+    updateStatus(QString("🔍 Fournisseur détecté : %1 (confiance %2 %)")
+                 .arg(name)
+                 .arg(qRound(detection.confidence * 100)));
 }
 
 void PDFParserWindow::onSupplierChanged(int index)
@@ -345,6 +413,128 @@ void PDFParserWindow::onParseClicked()
     parsePdfFile();
 }
 
+void PDFParserWindow::onBatchClicked()
+{
+    QString directory = QFileDialog::getExistingDirectory(this, "Sélectionner le dossier des PDF");
+    if (directory.isEmpty())
+        return;
+
+    std::vector<std::string> pdfPaths;
+    try
+    {
+        pdfPaths = PdfBatchConverter::listInputs(directory.toStdString());
+    }
+    catch (const std::exception& e)
+    {
+        updateStatus(QString("❌ %1").arg(e.what()), true);
+        return;
+    }
+
+    if (pdfPaths.empty())
+    {
+        QMessageBox::warning(this, "Erreur", "Aucun fichier PDF dans ce dossier");
+        updateStatus("❌ Erreur : Aucun fichier PDF dans le dossier", true);
+        return;
+    }
+
+    parseButton->setEnabled(false);
+    browseButton->setEnabled(false);
+    batchButton->setEnabled(false);
+    progressBar->setVisible(true);
+    progressBar->setRange(0, static_cast<int>(pdfPaths.size()));
+    progressBar->setValue(0);
+
+    updateStatus(QString("🔄 Conversion de %1 fichiers PDF (fournisseur reconnu automatiquement)...")
+                 .arg(pdfPaths.size()));
+
+    // Les classeurs sont écrits à côté des PDF ; chaque fichier terminé est affiché depuis le
+    // thread de l'interface
+    batchCancel = false;
+    batchWatcher.setFuture(QtConcurrent::run([this, pdfPaths]()
+    {
+        PdfBatchConverter::Options options;
+        options.cancel = &batchCancel;
+        return PdfBatchConverter::run(pdfPaths, options,
+            [this](const BatchFileResult& result, size_t done, size_t total)
+            {
+                QMetaObject::invokeMethod(this, [this, result, done, total]()
+                {
+                    onBatchFileDone(result, done, total);
+                }, Qt::QueuedConnection);
+            });
+    }));
+}
+
+void PDFParserWindow::onBatchFileDone(const BatchFileResult &result, size_t done, size_t total)
+{
+    const QString fileName = QFileInfo(QString::fromStdString(result.pdfPath)).fileName();
+    if (result.success)
+    {
+        updateStatus(QString("✅ [%1/%2] %3 : %4, %5 lignes")
+                     .arg(done).arg(total)
+                     .arg(fileName)
+                     .arg(QString::fromStdString(result.supplier))
+                     .arg(result.lineCount));
+    }
+    else
+    {
+        updateStatus(QString("❌ [%1/%2] %3 : %4")
+                     .arg(done).arg(total)
+                     .arg(fileName)
+                     .arg(QString::fromStdString(result.error)), true);
+    }
+    progressBar->setValue(static_cast<int>(done));
+}
+
+void PDFParserWindow::onBatchFinished()
+{
+    BatchSummary summary;
+    try
+    {
+        summary = batchWatcher.result();
+    }
+    catch (const std::exception& e)
+    {
+        updateStatus(QString("❌ %1").arg(e.what()), true);
+    }
+
+    parseButton->setEnabled(true);
+    browseButton->setEnabled(true);
+    batchButton->setEnabled(true);
+    progressBar->setVisible(false);
+    progressBar->setRange(0, 100);
+
+    const QString report = QString("%1 convertis, %2 échecs sur %3 fichiers en %4 s (%5 fichiers/s, %6 lignes/s)")
+                           .arg(summary.succeeded)
+                           .arg(summary.failures.size())
+                           .arg(summary.fileCount)
+                           .arg(summary.seconds, 0, 'f', 1)
+                           .arg(summary.filesPerSecond(), 0, 'f', 2)
+                           .arg(summary.linesPerSecond(), 0, 'f', 0);
+    updateStatus("🎉 Lot terminé : " + report, !summary.failures.empty());
+
+    if (summary.failures.empty())
+    {
+        QMessageBox::information(this, "Succès", "Lot terminé\n\n" + report);
+        return;
+    }
+
+    QString failures;
+    for (const BatchFileResult& failure : summary.failures)
+    {
+        failures += QFileInfo(QString::fromStdString(failure.pdfPath)).fileName() + " : " +
+                    QString::fromStdString(failure.error) + "\n";
+    }
+
+    QMessageBox msgBox(this);
+    msgBox.setIcon(QMessageBox::Warning);
+    msgBox.setWindowTitle("Lot terminé avec des échecs");
+    msgBox.setText(report);
+    msgBox.setDetailedText(failures);
+    msgBox.setStandardButtons(QMessageBox::Ok);
+    msgBox.exec();
+}
+
 void PDFParserWindow::parsePdfFile()
 {
     // Vérifier qu'un fichier est sélectionné
@@ -8,6 +8,9 @@
 #include <QTextEdit>
 #include <QProgressBar>
 #include <QGroupBox>
+#include <QFutureWatcher>
+#include "PdfBatchConverter.h"
+#include <atomic>
 
 class PDFParserWindow : public QDialog
 {
@@ -21,18 +24,24 @@ private slots:
     void onBrowseClicked();
     void onParseClicked();
     void onSupplierChanged(int index);
+    void onBatchClicked();
+    void onBatchFinished();
+    void onDetectionFinished();
 
 private:
     void setupUi();
     void applyModernStyle();
     void updateStatus(const QString &message, bool isError = false);
     void parsePdfFile();
+    void detectSupplier(const QString &filePath);
+    void onBatchFileDone(const BatchFileResult &result, size_t done, size_t total);
 
     // Widgets
     QComboBox *supplierCombo;
     QLineEdit *filePathEdit;
     QPushButton *browseButton;
     QPushButton *parseButton;
+    QPushButton *batchButton;
     QPushButton *closeButton;
     QTextEdit *statusText;
     QProgressBar *progressBar;
@@ -40,4 +49,12 @@ private:
     QLabel *fileLabel;
     QGroupBox *configGroup;
     QGroupBox *resultGroup;
+
+    // Détection du fournisseur du fichier choisi (thread de fond)
+    QFutureWatcher<SupplierDetection> detectionWatcher;
+    QString detectionPath;
+
+    // Conversion par lots (thread de fond)
+    QFutureWatcher<BatchSummary> batchWatcher;
+    std::atomic<bool> batchCancel;
 };
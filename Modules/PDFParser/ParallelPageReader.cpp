@@ -0,0 +1,139 @@
+#include "ParallelPageReader.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+unsigned ParallelPageReader::effectiveThreadCount(int pageCount, unsigned threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<unsigned>(std::max(1, std::min(static_cast<int>(threadCount), pageCount)));
+}
+
+ParallelPageReader::Result ParallelPageReader::read(int pageCount, unsigned threadCount, const ReaderFactory& makeReader,
+                                                    const PopplerPdfExtractor::PageCallback& onPage, bool& delivered)
+{
+    delivered = false;
+    if (pageCount <= 0)
+        return Result::NoText;
+
+    threadCount = effectiveThreadCount(pageCount, threadCount);
+    const int window = static_cast<int>(LOOK_AHEAD_PER_THREAD * threadCount);
+
+    // Chaque page a son propre tampon, rempli par un seul thread puis marqué prêt
+    std::vector<std::string> pages(static_cast<size_t>(pageCount));
+    std::vector<char> ready(static_cast<size_t>(pageCount), 0);
+    std::mutex mutex;
+    std::condition_variable changed;
+    int nextPage = 0;
+    int nextDelivery = 0;
+    int activeWorkers = static_cast<int>(threadCount);
+    bool stopped = false;
+    bool failed = false;
+
+    auto worker = [&](unsigned threadIndex)
+    {
+        try
+        {
+            const PageReader readPage = makeReader(threadIndex);
+            for (;;)
+            {
+                int i;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&] { return stopped || nextPage >= pageCount || nextPage < nextDelivery + window; });
+                    if (stopped || nextPage >= pageCount)
+                        break;
+                    i = nextPage++;
+                }
+
+                std::string text = readPage(i);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                pages[static_cast<size_t>(i)] = std::move(text);
+                ready[static_cast<size_t>(i)] = 1;
+                changed.notify_all();
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            failed = true;
+            stopped = true;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        --activeWorkers;
+        changed.notify_all();
+    };
+
+    // Arrête et attend les threads à chaque sortie (fin normale, annulation, exception de onPage
+    // ou de la création d'un thread) : un std::thread encore joignable détruit appelle
+    // std::terminate
+    struct ThreadsGuard
+    {
+        std::vector<std::thread> threads;
+        std::mutex& mutex;
+        std::condition_variable& changed;
+        bool& stopped;
+
+        ~ThreadsGuard()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopped = true;
+                changed.notify_all();
+            }
+            for (auto& thread : threads)
+            {
+                if (thread.joinable())
+                    thread.join();
+            }
+        }
+    };
+
+    bool cancelled = false;
+    size_t total = 0;
+    {
+        ThreadsGuard guard{ {}, mutex, changed, stopped };
+        guard.threads.reserve(threadCount);
+        for (unsigned t = 0; t < threadCount; ++t)
+            guard.threads.emplace_back(worker, t);
+
+        // Pages vides du début retenues jusqu'à la première page avec du texte
+        int heldFrom = 0;
+        for (int i = 0; i < pageCount && !cancelled; ++i)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&] { return ready[static_cast<size_t>(i)] || failed || activeWorkers == 0; });
+                if (failed || !ready[static_cast<size_t>(i)])
+                    break;
+            }
+
+            // Tampon lu hors verrou : aucun thread ne réécrit une page déjà prête
+            total += pages[static_cast<size_t>(i)].size() > 1 ? pages[static_cast<size_t>(i)].size() - 1 : 0;
+            if (total > 0)
+            {
+                for (; heldFrom <= i && !cancelled; ++heldFrom)
+                {
+                    delivered = true;
+                    cancelled = !onPage(pages[static_cast<size_t>(heldFrom)], heldFrom, pageCount);
+                    std::string().swap(pages[static_cast<size_t>(heldFrom)]);  // Libérée dès qu'elle est remise
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            nextDelivery = i + 1;
+            changed.notify_all();
+        }
+    }
+
+    if (failed)
+        return Result::Failed;
+    if (cancelled)
+        return Result::Cancelled;
+    return total > 0 ? Result::Complete : Result::NoText;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "PopplerPdfExtractor.h"
+#include <functional>
+#include <string>
+
+// Extraction des pages d'un document par plusieurs threads, remises dans l'ordre
+// (PopplerPdfExtractor::readWithPoppler, sans dépendance à Poppler)
+//
+//   - Chaque thread prend la prochaine page libre : pages disjointes, charge équilibrée même si
+//     certaines pages sont plus lourdes.
+//   - Pages remises à onPage dans l'ordre du document, sur le thread appelant, dès qu'elles
+//     sont prêtes ; LOOK_AHEAD_PER_THREAD pages par thread extraites d'avance au plus (mémoire
+//     bornée si onPage est plus lent que l'extraction).
+//   - Les pages vides du début (texte réduit à la fin de ligne) sont retenues : si aucune page
+//     n'a de texte, rien n'est remis et l'appelant peut essayer une autre méthode.
+//   - Les threads sont arrêtés et attendus à chaque sortie, y compris si onPage lève une
+//     exception (transmise à l'appelant).
+class ParallelPageReader
+{
+public:
+    static constexpr int LOOK_AHEAD_PER_THREAD = 4;
+
+    // Texte d'une page, terminé par une fin de ligne. Une exception arrête l'extraction.
+    using PageReader = std::function<std::string(int pageIndex)>;
+
+    // Prépare un thread d'extraction (ouvre son propre document, par exemple), appelée une fois
+    // sur chaque thread avant sa première page. Une exception arrête l'extraction.
+    using ReaderFactory = std::function<PageReader(unsigned threadIndex)>;
+
+    enum class Result
+    {
+        Complete,   // Toutes les pages remises, avec du texte
+        NoText,     // Aucune page n'a de texte : rien n'a été remis
+        Cancelled,  // onPage a retourné false
+        Failed      // Exception d'un thread d'extraction
+    };
+
+    // threadCount : 0 = un par cœur, jamais plus que de pages
+    // delivered indique si des pages ont été remises à onPage
+    static Result read(int pageCount, unsigned threadCount, const ReaderFactory& makeReader,
+                       const PopplerPdfExtractor::PageCallback& onPage, bool& delivered);
+
+    // Threads réellement utilisés pour pageCount pages
+    static unsigned effectiveThreadCount(int pageCount, unsigned threadCount);
+};
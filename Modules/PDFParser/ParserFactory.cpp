@@ -5,8 +5,129 @@
 #include "PompacPdfParser.h"
 #include "CgrPdfParser.h"
 #include "RexelPdfParser.h"
+#include "LineMatcher.h"
+#include "MultiPatternScanner.h"
+#include "PopplerPdfExtractor.h"
+#include "TextScanner.h"
 #include <algorithm>
 
+// ===== SIGNATURES DES FOURNISSEURS =====
+
+// Nombre de fournisseurs (Supplier::Rexel doit rester le dernier de l'énumération)
+static constexpr size_t SUPPLIER_COUNT = static_cast<size_t>(Supplier::Rexel) + 1;
+
+// Seul le début de la première page est lu (texte complet avec pdftotext ou le fichier .txt)
+static constexpr size_t MAX_SCAN_LENGTH = 64 * 1024;
+
+// Occurrences comptées au plus par signature : une page remplie de lignes "PCE" ne doit pas
+// l'emporter sur le nom du fournisseur en en-tête
+static constexpr int MAX_HITS = 5;
+
+// Seuils de la détection : avance du meilleur fournisseur sur le suivant (points) et part de
+// ses points dans le total
+static constexpr int MIN_SCORE = 4;
+static constexpr double MIN_CONFIDENCE = 0.6;
+
+// Contexte exigé autour du mot
+enum class Boundary
+{
+    ANYWHERE,
+    WORD,               // Ni lettre ni chiffre juste avant et juste après
+    FOLLOWED_BY_DIGIT   // Suivi d'un chiffre (NDX\d+)
+};
+
+// Ensemble de fournisseurs (un bit par fournisseur)
+static constexpr unsigned bit(Supplier supplier)
+{
+    return 1u << static_cast<unsigned>(supplier);
+}
+
+struct Signature
+{
+    unsigned suppliers;     // Fournisseurs crédités des points (plusieurs pour un mot commun)
+    std::string_view pattern;
+    Boundary boundary;
+    int points;
+};
+
+// Mots reconnus sans tenir compte de la casse (lettres accentuées en UTF-8, minuscules)
+//
+// Un mot commun à plusieurs fournisseurs (PCE chez Lindab et Fischer, PIEC et Ecopart chez
+// Siehr et Pompac) est déclaré une seule fois : ses points vont à chacun d'eux mais ne comptent
+// qu'une fois dans le total, et ne les départagent pas. Siehr et Pompac ont la même mise en
+// page : sans le nom du fournisseur en en-tête, seules les lignes d'articles gratuits (propres
+// à Pompac, POMPAC_FREE_LINE_POINTS) les distinguent, et un devis Siehr sans en-tête reste
+// non reconnu (choix du fournisseur laissé à l'utilisateur).
+static const Signature SIGNATURES[] =
+{
+    { bit(Supplier::Lindab), "lindab", Boundary::WORD, 10 },
+    { bit(Supplier::Lindab), "date de r\xC3\xA9" "ception", Boundary::ANYWHERE, 3 },
+    { bit(Supplier::Lindab), "date de reception", Boundary::ANYWHERE, 3 },
+    { bit(Supplier::Lindab) | bit(Supplier::Fischer), "PCE", Boundary::WORD, 1 },
+
+    { bit(Supplier::Fischer), "fischer", Boundary::WORD, 10 },
+    { bit(Supplier::Fischer), "co-contribution", Boundary::ANYWHERE, 2 },  // Éco-/éco-
+    { bit(Supplier::Fischer), "BTE", Boundary::WORD, 2 },
+
+    { bit(Supplier::Siehr), "siehr", Boundary::WORD, 10 },
+    { bit(Supplier::Pompac), "pompac", Boundary::WORD, 10 },
+    { bit(Supplier::Siehr) | bit(Supplier::Pompac), "PIEC", Boundary::WORD, 1 },
+    { bit(Supplier::Siehr) | bit(Supplier::Pompac), "ecopart.", Boundary::ANYWHERE, 1 },
+
+    { bit(Supplier::CGR), "cgr", Boundary::WORD, 10 },
+    { bit(Supplier::CGR), "c g r", Boundary::WORD, 10 },  // Texte espacé
+    { bit(Supplier::CGR), "\xE2\x82\xAC", Boundary::ANYWHERE, 1 },  // €
+
+    { bit(Supplier::Rexel), "rexel", Boundary::WORD, 10 },
+    { bit(Supplier::Rexel), "NDX", Boundary::FOLLOWED_BY_DIGIT, 3 },
+    { bit(Supplier::Rexel), "r\xC3\xA9" "f\xC3\xA9rence / d\xC3\xA9signation", Boundary::ANYWHERE, 3 },
+    { bit(Supplier::Rexel), "r\xC3\xA9" "f\xC3\xA9rence / designation", Boundary::ANYWHERE, 3 },
+    { bit(Supplier::Rexel), "reference / designation", Boundary::ANYWHERE, 3 },
+    { bit(Supplier::Rexel), "nc = nous consulter", Boundary::ANYWHERE, 2 },
+};
+
+static constexpr size_t SIGNATURE_COUNT = sizeof(SIGNATURES) / sizeof(SIGNATURES[0]);
+
+// Formes de lignes (début de ligne seulement, lu par les matchers des parseurs)
+static constexpr int LINDAB_HEADER_POINTS = 2;      // "1   224931   ..." : code Lindab à 6 chiffres
+static constexpr int FISCHER_EAN_POINTS = 3;        // "4048962230956   534135 ..." : EAN + référence
+static constexpr int POMPAC_FREE_LINE_POINTS = 2;   // "T28971  ...  1,000 PIEC  PIEC  Gratuit"
+
+// Automate des mots de SIGNATURES (numéro du mot = indice de la signature), construit une fois
+static const MultiPatternScanner& signatureScanner()
+{
+    static const MultiPatternScanner scanner = []
+    {
+        MultiPatternScanner built;
+        for (const Signature& signature : SIGNATURES)
+            built.add(signature.pattern);
+        built.build();
+        return built;
+    }();
+    return scanner;
+}
+
+static bool isWordCharacter(char c)
+{
+    return TextScanner::isAlpha(c) || TextScanner::isDigit(c);
+}
+
+static bool boundaryMatches(std::string_view text, size_t begin, size_t end, Boundary boundary)
+{
+    switch (boundary)
+    {
+    case Boundary::WORD:
+        return (begin == 0 || !isWordCharacter(text[begin - 1])) &&
+               (end == text.size() || !isWordCharacter(text[end]));
+
+    case Boundary::FOLLOWED_BY_DIGIT:
+        return end < text.size() && TextScanner::isDigit(text[end]);
+
+    default:
+        return true;
+    }
+}
+
 std::unique_ptr<IPdfParser> ParserFactory::createParser(Supplier supplier)
 {
     switch (supplier)
@@ -77,3 +198,117 @@ Supplier ParserFactory::supplierFromString(const std::string& name)
     // Par défaut, retourner Lindab
     return Supplier::Lindab;
 }
+
+std::string ParserFactory::supplierName(Supplier supplier)
+{
+    switch (supplier)
+    {
+    case Supplier::Lindab:
+        return "Lindab";
+    case Supplier::Fischer:
+        return "Fischer";
+    case Supplier::Siehr:
+        return "Siehr";
+    case Supplier::Pompac:
+        return "Pompac";
+    case Supplier::CGR:
+        return "CGR";
+    case Supplier::Rexel:
+        return "Rexel";
+    default:
+        return "";
+    }
+}
+
+SupplierDetection ParserFactory::detectSupplier(std::string_view firstPage)
+{
+    static const LindabHeaderMatcher lindabHeader;
+    static const FischerLine2Matcher fischerEan;
+    static const PiecLineMatcher pompacFreeLine(PiecLineMatcher::Kind::FREE);
+
+    const MultiPatternScanner& scanner = signatureScanner();
+    const size_t length = std::min(firstPage.size(), MAX_SCAN_LENGTH);
+
+    int hits[SIGNATURE_COUNT] = {};
+    int lindabHeaders = 0;
+    int fischerEans = 0;
+    int pompacFreeLines = 0;
+
+    // Un seul passage : chaque caractère fait avancer l'automate des mots, chaque fin de ligne
+    // fait essayer les deux formes de ligne sur son début
+    size_t state = MultiPatternScanner::ROOT;
+    size_t lineStart = 0;
+    for (size_t i = 0; i <= length; ++i)
+    {
+        if (i == length || firstPage[i] == '\n')
+        {
+            const std::string_view line = firstPage.substr(lineStart, i - lineStart);
+            if (lindabHeaders < MAX_HITS && lindabHeader.contains(line))
+                ++lindabHeaders;
+            if (fischerEans < MAX_HITS && fischerEan.contains(line))
+                ++fischerEans;
+            if (pompacFreeLines < MAX_HITS && pompacFreeLine.contains(line))
+                ++pompacFreeLines;
+            lineStart = i + 1;
+            if (i == length)
+                break;
+        }
+
+        state = scanner.next(state, firstPage[i]);
+        for (size_t found : scanner.matches(state))
+        {
+            const size_t end = i + 1;
+            if (hits[found] < MAX_HITS &&
+                boundaryMatches(firstPage, end - scanner.patternLength(found), end, SIGNATURES[found].boundary))
+                ++hits[found];
+        }
+    }
+
+    // Points de chaque fournisseur ; total : chaque indice compté une fois, même commun
+    int scores[SUPPLIER_COUNT] = {};
+    int total = 0;
+    for (size_t s = 0; s < SIGNATURE_COUNT; ++s)
+    {
+        const int points = hits[s] * SIGNATURES[s].points;
+        total += points;
+        for (size_t supplier = 0; supplier < SUPPLIER_COUNT; ++supplier)
+        {
+            if (SIGNATURES[s].suppliers & (1u << supplier))
+                scores[supplier] += points;
+        }
+    }
+    scores[static_cast<size_t>(Supplier::Lindab)] += lindabHeaders * LINDAB_HEADER_POINTS;
+    scores[static_cast<size_t>(Supplier::Fischer)] += fischerEans * FISCHER_EAN_POINTS;
+    scores[static_cast<size_t>(Supplier::Pompac)] += pompacFreeLines * POMPAC_FREE_LINE_POINTS;
+    total += lindabHeaders * LINDAB_HEADER_POINTS + fischerEans * FISCHER_EAN_POINTS
+           + pompacFreeLines * POMPAC_FREE_LINE_POINTS;
+
+    SupplierDetection detection;
+    int runnerUp = 0;
+    for (size_t s = 0; s < SUPPLIER_COUNT; ++s)
+    {
+        if (scores[s] > detection.score)
+        {
+            runnerUp = detection.score;
+            detection.score = scores[s];
+            detection.supplier = static_cast<Supplier>(s);
+        }
+        else if (scores[s] > runnerUp)
+        {
+            runnerUp = scores[s];
+        }
+    }
+
+    // Les indices communs ne départagent pas : l'avance sur le suivant vient des seuls indices
+    // propres au fournisseur retenu (égalité Siehr/Pompac sans en-tête : non reconnu)
+    if (total > 0)
+        detection.confidence = static_cast<double>(detection.score) / total;
+    detection.found = detection.score - runnerUp >= MIN_SCORE && detection.confidence >= MIN_CONFIDENCE;
+    return detection;
+}
+
+SupplierDetection ParserFactory::detectSupplierFromFile(const std::string& filePath)
+{
+    // Une seule page est utile (pdftotext compris)
+    return detectSupplier(PopplerPdfExtractor::extractFirstPage(filePath, true));
+}
@@ -2,6 +2,7 @@
 #include "IPdfParser.h"
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // Énumération des fournisseurs supportés
@@ -19,6 +20,15 @@ enum class Supplier
     // etc.
 };
 
+// Résultat de la détection automatique du fournisseur
+struct SupplierDetection
+{
+    bool found = false;             // Faux sans signature suffisante, ou si deux fournisseurs restent proches
+    Supplier supplier = Supplier::Lindab;
+    int score = 0;                  // Points du fournisseur retenu
+    double confidence = 0.0;        // Part de ses points dans le total (0 à 1)
+};
+
 // Factory pour créer les parseurs appropriés
 class ParserFactory
 {
@@ -31,4 +41,14 @@ public:
 
     // Convertir un nom de fournisseur en enum
     static Supplier supplierFromString(const std::string& name);
+
+    // Nom affiché d'un fournisseur (celui de getSupportedSuppliers)
+    static std::string supplierName(Supplier supplier);
+
+    // Reconnaît le fournisseur d'après les signatures de la première page (en-têtes, références
+    // NDX..., codes Lindab à 6 chiffres, titres de colonnes), en un seul passage sur le texte
+    static SupplierDetection detectSupplier(std::string_view firstPage);
+
+    // Extrait la première page du PDF (seule) puis appelle detectSupplier
+    static SupplierDetection detectSupplierFromFile(const std::string& filePath);
 };
@@ -0,0 +1,122 @@
+#include "PdfBatchCommand.h"
+#include "PdfBatchConverter.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+static unsigned parseThreadCount(const std::string& value)
+{
+    try
+    {
+        size_t consumed = 0;
+        const int count = std::stoi(value, &consumed);
+        if (consumed == value.size() && count > 0)
+            return static_cast<unsigned>(count);
+    }
+    catch (...)
+    {
+    }
+    throw std::runtime_error("Nombre de threads invalide : '" + value + "'");
+}
+
+// Nom de fournisseur exact (supplierFromString retombe sur Lindab pour un nom inconnu)
+static Supplier parseSupplier(const std::string& value)
+{
+    std::string lowerValue = value;
+    std::transform(lowerValue.begin(), lowerValue.end(), lowerValue.begin(), ::tolower);
+
+    for (const std::string& name : ParserFactory::getSupportedSuppliers())
+    {
+        std::string lowerName = name;
+        std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+        if (lowerName == lowerValue)
+            return ParserFactory::supplierFromString(name);
+    }
+    throw std::runtime_error("Fournisseur inconnu : '" + value + "'");
+}
+
+static std::string fileNameOf(const std::string& path)
+{
+    return std::filesystem::u8path(path).filename().u8string();
+}
+
+int runPdfBatchCommand(const std::vector<std::string>& args)
+{
+    try
+    {
+        if (args.size() < 2 || args[0] != "--pdf-lot")
+            throw std::runtime_error("Usage : --pdf-lot <dossier|motif> [--fournisseur auto|nom] [--sortie dossier] [--threads N]");
+
+        PdfBatchConverter::Options options;
+        for (size_t i = 2; i < args.size(); i += 2)
+        {
+            const std::string& option = args[i];
+            if (i + 1 >= args.size())
+                throw std::runtime_error("Valeur manquante pour l'option " + option);
+            const std::string& value = args[i + 1];
+
+            if (option == "--fournisseur")
+            {
+                options.autoDetect = (value == "auto");
+                if (!options.autoDetect)
+                    options.supplier = parseSupplier(value);
+            }
+            else if (option == "--sortie")
+            {
+                options.outputDirectory = value;
+            }
+            else if (option == "--threads")
+            {
+                options.workerCount = parseThreadCount(value);
+            }
+            else
+            {
+                throw std::runtime_error("Option inconnue : " + option);
+            }
+        }
+
+        const std::vector<std::string> pdfPaths = PdfBatchConverter::listInputs(args[1]);
+        if (pdfPaths.empty())
+            throw std::runtime_error("Aucun fichier PDF trouvé : " + args[1]);
+
+        std::cout << "Lot : " << pdfPaths.size() << " fichiers PDF" << std::endl;
+
+        const BatchSummary summary = PdfBatchConverter::run(pdfPaths, options,
+            [](const BatchFileResult& result, size_t done, size_t total)
+            {
+                char progress[32];
+                std::snprintf(progress, sizeof(progress), "[%zu/%zu] ", done, total);
+                char timing[32];
+                std::snprintf(timing, sizeof(timing), " (%.2f s)", result.seconds);
+
+                if (result.success)
+                {
+                    std::cout << progress << "OK     " << fileNameOf(result.pdfPath) << " : " << result.supplier
+                              << ", " << result.lineCount << " lignes -> " << result.outputPath << timing << std::endl;
+                }
+                else
+                {
+                    std::cout << progress << "ECHEC  " << fileNameOf(result.pdfPath) << " : " << result.error
+                              << timing << std::endl;
+                }
+            });
+
+        char rates[96];
+        std::snprintf(rates, sizeof(rates), "%.1f s (%.2f fichiers/s, %.0f lignes/s)",
+                      summary.seconds, summary.filesPerSecond(), summary.linesPerSecond());
+        std::cout << "Bilan : " << summary.succeeded << " convertis, " << summary.failures.size() << " échecs sur "
+                  << summary.fileCount << " fichiers, " << summary.lineCount << " lignes en " << rates << std::endl;
+
+        for (const BatchFileResult& failure : summary.failures)
+            std::cerr << "Échec : " << failure.pdfPath << " : " << failure.error << std::endl;
+
+        return summary.failures.empty() ? 0 : 2;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Erreur : " << e.what() << std::endl;
+        return 1;
+    }
+}
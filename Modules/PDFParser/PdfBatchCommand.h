@@ -0,0 +1,16 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Commande en ligne de conversion d'un lot de PDF fournisseurs (sans interface graphique)
+//
+//   TCHub.exe --pdf-lot <dossier|motif> [options]
+//     <dossier|motif>                  dossier (ses .pdf) ou motif "C:/Devis/2025-*.pdf"
+//     --fournisseur auto|lindab|...    (défaut : auto = reconnu sur la première page)
+//     --sortie dossier                 (défaut : à côté de chaque PDF)
+//     --threads N                      (threads d'analyse, défaut : nombre de cœurs)
+//
+// Une ligne par fichier terminé, puis le bilan (débit et échecs).
+// args commence par "--pdf-lot". Retourne le code de sortie du processus : 0 si tout est
+// converti, 2 si des fichiers ont échoué, 1 en cas d'erreur de la commande.
+int runPdfBatchCommand(const std::vector<std::string>& args);
@@ -0,0 +1,391 @@
+#include "PdfBatchConverter.h"
+#include "DebugLog.h"
+#include "TextScanner.h"
+#include "XlsxWriter.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+// ===== FONCTIONS HELPERS =====
+
+// File d'attente de capacité fixe entre deux étages : push attend qu'une place se libère et
+// retourne false si la file est fermée, pop attend un élément et retourne false une fois la
+// file fermée et vide
+template <typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+    bool push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return items.size() < capacity || closed; });
+        if (closed)
+            return false;
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    bool pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return !items.empty() || closed; });
+        if (items.empty())
+            return false;
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    // Plus rien ne sera ajouté : les consommateurs finissent la file puis s'arrêtent, les
+    // producteurs en attente d'une place sont libérés
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+private:
+    const size_t capacity;
+    std::deque<T> items;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    bool closed = false;
+};
+
+// Fichier analysé, en attente d'écriture
+struct ParsedFile
+{
+    BatchFileResult result;
+    std::vector<PdfLine> lines;
+    std::chrono::steady_clock::time_point start;
+};
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Motif de nom de fichier avec * et ?, sans tenir compte de la casse (noms de fichiers Windows)
+static bool matchesWildcard(std::string_view name, std::string_view pattern)
+{
+    size_t n = 0;
+    size_t p = 0;
+    size_t starPattern = std::string_view::npos;
+    size_t starName = 0;
+
+    while (n < name.size())
+    {
+        if (p < pattern.size() && pattern[p] == '*')
+        {
+            starPattern = p++;
+            starName = n;
+        }
+        else if (p < pattern.size() &&
+                 (pattern[p] == '?' || TextScanner::toLowerAscii(pattern[p]) == TextScanner::toLowerAscii(name[n])))
+        {
+            ++p;
+            ++n;
+        }
+        else if (starPattern != std::string_view::npos)
+        {
+            // L'étoile précédente absorbe un caractère de plus
+            p = starPattern + 1;
+            n = ++starName;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    while (p < pattern.size() && pattern[p] == '*')
+        ++p;
+    return p == pattern.size();
+}
+
+// Analyse d'un fichier (étage 1) ; les erreurs sont rendues dans result.error
+static ParsedFile parseOne(const std::string& pdfPath, const PdfBatchConverter::Options& options)
+{
+    ParsedFile parsed;
+    parsed.start = std::chrono::steady_clock::now();
+    parsed.result.pdfPath = pdfPath;
+
+    try
+    {
+        Supplier supplier = options.supplier;
+        if (options.autoDetect)
+        {
+            const SupplierDetection detection = ParserFactory::detectSupplierFromFile(pdfPath);
+            if (!detection.found)
+                throw std::runtime_error("Fournisseur non reconnu sur la première page");
+            supplier = detection.supplier;
+        }
+        parsed.result.supplier = ParserFactory::supplierName(supplier);
+
+        auto parser = ParserFactory::createParser(supplier);
+        if (!parser)
+            throw std::runtime_error("Parseur non disponible");
+
+        parser->setExtractionThreads(1);
+        parser->setDebugDump(false);  // Pas de fichier _extracted.txt à côté de chaque PDF du lot
+        parsed.lines = parser->parse(pdfPath);
+        if (parsed.lines.empty())
+            throw std::runtime_error("Aucune ligne de produit trouvée");
+    }
+    catch (const std::exception& e)
+    {
+        parsed.lines.clear();
+        parsed.result.error = e.what();
+    }
+    catch (...)
+    {
+        parsed.lines.clear();
+        parsed.result.error = "Erreur inconnue";
+    }
+    return parsed;
+}
+
+// Écriture du classeur d'un fichier analysé (étage 2)
+static void writeOne(ParsedFile& parsed, const PdfBatchConverter::Options& options)
+{
+    BatchFileResult& result = parsed.result;
+    if (!result.error.empty())
+        return;
+
+    try
+    {
+        const std::string outputPath = PdfBatchConverter::outputPathFor(result.pdfPath, options.outputDirectory);
+        if (!XlsxWriter::writeToXlsx(outputPath, parsed.lines))
+        {
+            result.error = "Impossible d'écrire le fichier " + outputPath;
+            return;
+        }
+
+        // XlsxWriter se replie sur SpreadsheetML (.xml) s'il ne peut pas compresser
+        std::filesystem::path written = std::filesystem::u8path(outputPath);
+        if (!std::filesystem::exists(written) && std::filesystem::exists(std::filesystem::path(written).replace_extension(".xml")))
+            written.replace_extension(".xml");
+
+        result.outputPath = written.u8string();
+        result.lineCount = parsed.lines.size();
+        result.success = true;
+    }
+    catch (const std::exception& e)
+    {
+        result.error = e.what();
+    }
+}
+
+// ===== METHODES DE LA CLASSE =====
+
+std::vector<std::string> PdfBatchConverter::listInputs(const std::string& directoryOrPattern)
+{
+    namespace fs = std::filesystem;
+
+    const fs::path input = fs::u8path(directoryOrPattern);
+    fs::path directory = input;
+    std::string pattern = "*.pdf";
+
+    const std::string fileName = input.filename().u8string();
+    if (fileName.find_first_of("*?") != std::string::npos)
+    {
+        directory = input.parent_path();
+        pattern = fileName;
+        if (directory.empty())
+            directory = ".";
+    }
+    else if (fs::is_regular_file(input))
+    {
+        return { directoryOrPattern };
+    }
+
+    std::error_code error;
+    if (!fs::is_directory(directory, error))
+        throw std::runtime_error("Dossier introuvable : " + directory.u8string());
+
+    std::vector<std::string> paths;
+    for (const fs::directory_entry& entry : fs::directory_iterator(directory, error))
+    {
+        if (entry.is_regular_file(error) && matchesWildcard(entry.path().filename().u8string(), pattern))
+            paths.push_back(entry.path().u8string());
+    }
+
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+std::string PdfBatchConverter::outputPathFor(const std::string& pdfPath, const std::string& outputDirectory)
+{
+    const std::filesystem::path pdf = std::filesystem::u8path(pdfPath);
+    const std::filesystem::path directory = outputDirectory.empty() ? pdf.parent_path()
+                                                                    : std::filesystem::u8path(outputDirectory);
+    return (directory / (pdf.stem().u8string() + ".xlsx")).u8string();
+}
+
+BatchSummary PdfBatchConverter::run(const std::vector<std::string>& pdfPaths, const Options& options,
+                                    const FileCallback& onFile)
+{
+    const auto start = std::chrono::steady_clock::now();
+    BatchSummary summary;
+    summary.fileCount = pdfPaths.size();
+    if (pdfPaths.empty())
+        return summary;
+
+    if (!options.outputDirectory.empty())
+    {
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::u8path(options.outputDirectory), error);
+        if (error)
+            throw std::runtime_error("Impossible de créer le dossier de sortie : " + options.outputDirectory);
+    }
+
+    unsigned workerCount = options.workerCount;
+    if (workerCount == 0)
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    workerCount = static_cast<unsigned>(std::min<size_t>(workerCount, pdfPaths.size()));
+
+    const unsigned writerCount = options.writerCount > 0 ? options.writerCount : std::max(1u, workerCount / 4);
+    const size_t capacity = options.queueCapacity > 0 ? options.queueCapacity : 2 * static_cast<size_t>(workerCount);
+
+    debugLog("[PdfBatch] " + std::to_string(pdfPaths.size()) + " fichiers, " +
+             std::to_string(workerCount) + " threads d'analyse, " + std::to_string(writerCount) +
+             " d'écriture, file de " + std::to_string(capacity) + "\n");
+
+    BoundedQueue<ParsedFile> parsedFiles(capacity);
+    std::atomic<size_t> nextFile(0);
+    std::mutex reportMutex;
+    size_t done = 0;
+    std::exception_ptr failure;  // Première exception d'un thread, relancée après l'arrêt du lot
+
+    // Exception d'un étage : file fermée, les autres threads s'arrêtent
+    auto fail = [&]
+    {
+        {
+            std::lock_guard<std::mutex> lock(reportMutex);
+            if (!failure)
+                failure = std::current_exception();
+        }
+        parsedFiles.close();
+    };
+
+    auto isCancelled = [&options]
+    {
+        return options.cancel != nullptr && options.cancel->load();
+    };
+
+    // Étage 2 : écriture, puis bilan et rappel sous verrou (un seul rappel à la fois)
+    auto writer = [&]
+    {
+        try
+        {
+            ParsedFile parsed;
+            while (parsedFiles.pop(parsed))
+            {
+                writeOne(parsed, options);
+                parsed.lines = std::vector<PdfLine>();  // Libérée avant d'attendre le suivant
+                parsed.result.seconds = secondsSince(parsed.start);
+
+                std::lock_guard<std::mutex> lock(reportMutex);
+                ++done;
+                if (parsed.result.success)
+                {
+                    ++summary.succeeded;
+                    summary.lineCount += parsed.result.lineCount;
+                }
+                else
+                {
+                    debugLog("[PdfBatch] ECHEC " + parsed.result.pdfPath + " : " + parsed.result.error + "\n");
+                    summary.failures.push_back(parsed.result);
+                }
+
+                if (onFile)
+                {
+                    try
+                    {
+                        onFile(parsed.result, done, pdfPaths.size());
+                    }
+                    catch (...) {}
+                }
+            }
+        }
+        catch (...)
+        {
+            fail();
+        }
+    };
+
+    // Étage 1 : chaque thread prend le fichier suivant tant que le lot n'est pas annulé
+    auto worker = [&]
+    {
+        try
+        {
+            while (!isCancelled())
+            {
+                const size_t index = nextFile++;
+                if (index >= pdfPaths.size() || !parsedFiles.push(parseOne(pdfPaths[index], options)))
+                    break;
+            }
+        }
+        catch (...)
+        {
+            fail();
+        }
+    };
+
+    // Ferme la file et attend les threads à chaque sortie (fin normale ou exception à la
+    // création d'un thread) : un std::thread encore joignable détruit appelle std::terminate
+    struct ThreadsGuard
+    {
+        std::vector<std::thread> threads;
+        BoundedQueue<ParsedFile>& queue;
+
+        ~ThreadsGuard()
+        {
+            queue.close();
+            for (auto& thread : threads)
+            {
+                if (thread.joinable())
+                    thread.join();
+            }
+        }
+    };
+
+    {
+        ThreadsGuard writers{ {}, parsedFiles };
+        writers.threads.reserve(writerCount);
+        for (unsigned i = 0; i < writerCount; ++i)
+            writers.threads.emplace_back(writer);
+
+        // Analyse terminée avant la fermeture de la file : les écrivains la vident puis s'arrêtent
+        ThreadsGuard workers{ {}, parsedFiles };
+        workers.threads.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i)
+            workers.threads.emplace_back(worker);
+        for (std::thread& thread : workers.threads)
+            thread.join();
+    }
+
+    if (failure)
+        std::rethrow_exception(failure);
+
+    summary.cancelled = done < pdfPaths.size();
+    summary.seconds = secondsSince(start);
+
+    debugLog("[PdfBatch] Terminé : " + std::to_string(summary.succeeded) + " réussis, " +
+             std::to_string(summary.failures.size()) + " échecs en " +
+             std::to_string(summary.seconds) + " s\n");
+    return summary;
+}
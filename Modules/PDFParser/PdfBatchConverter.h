@@ -0,0 +1,74 @@
+#pragma once
+#include "ParserFactory.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Résultat de la conversion d'un PDF
+struct BatchFileResult
+{
+    std::string pdfPath;
+    std::string outputPath;     // Classeur écrit (.xlsx, ou .xml en repli), vide en cas d'échec
+    std::string supplier;       // Fournisseur utilisé (vide s'il n'a pas été reconnu)
+    size_t lineCount = 0;
+    double seconds = 0.0;       // Extraction, analyse et écriture
+    bool success = false;
+    std::string error;          // Cause de l'échec
+};
+
+// Bilan d'un lot
+struct BatchSummary
+{
+    size_t fileCount = 0;
+    size_t succeeded = 0;
+    size_t lineCount = 0;
+    double seconds = 0.0;                   // Durée totale du lot
+    bool cancelled = false;
+    std::vector<BatchFileResult> failures;  // Seuls les échecs sont conservés
+
+    double filesPerSecond() const { return seconds > 0.0 ? (succeeded + failures.size()) / seconds : 0.0; }
+    double linesPerSecond() const { return seconds > 0.0 ? lineCount / seconds : 0.0; }
+};
+
+// Conversion d'un lot de PDF fournisseurs en classeurs XLSX
+//
+// Chaîne à deux étages reliés par une file bornée :
+//   1. workerCount threads : détection du fournisseur, extraction et analyse d'un fichier
+//      (un seul thread d'extraction par fichier, le parallélisme est entre les fichiers)
+//   2. writerCount threads : écriture des classeurs
+// Quand la file est pleine, les analyses attendent les écritures : la mémoire occupée dépend du
+// nombre de threads et de la capacité de la file, jamais du nombre de fichiers du lot.
+class PdfBatchConverter
+{
+public:
+    struct Options
+    {
+        bool autoDetect = true;                 // Fournisseur reconnu sur la première page
+        Supplier supplier = Supplier::Lindab;   // Fournisseur imposé si autoDetect est faux
+        std::string outputDirectory;            // Vide = classeur à côté de chaque PDF
+        unsigned workerCount = 0;               // 0 = un par cœur
+        unsigned writerCount = 0;               // 0 = un pour quatre threads d'analyse
+        size_t queueCapacity = 0;               // 0 = deux résultats par thread d'analyse
+        const std::atomic<bool>* cancel = nullptr;  // Mis à vrai : plus aucun fichier n'est commencé
+    };
+
+    // Appelé pour chaque fichier terminé (done fichiers sur total), depuis un thread d'écriture,
+    // jamais deux fois en même temps
+    using FileCallback = std::function<void(const BatchFileResult& result, size_t done, size_t total)>;
+
+    // PDF désignés par un dossier (ses fichiers .pdf, sans les sous-dossiers), un motif dont le
+    // nom de fichier contient * ou ? ("C:/Devis/2025-*.pdf") ou un seul fichier, triés par nom
+    // Lève std::runtime_error si le dossier n'existe pas
+    static std::vector<std::string> listInputs(const std::string& directoryOrPattern);
+
+    // Les erreurs d'un fichier sont rendues dans BatchSummary::failures ; une exception hors
+    // fichier (création d'un thread, mémoire) arrête le lot et est relancée une fois tous les
+    // threads attendus
+    static BatchSummary run(const std::vector<std::string>& pdfPaths, const Options& options,
+                            const FileCallback& onFile = FileCallback());
+
+    // Classeur produit pour un PDF : <dossier de sortie ou du PDF>/<nom du PDF>.xlsx
+    static std::string outputPathFor(const std::string& pdfPath, const std::string& outputDirectory);
+};
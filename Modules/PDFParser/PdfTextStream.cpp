@@ -0,0 +1,155 @@
+#include "PdfTextStream.h"
+#include "DebugLog.h"
+#include "PopplerPdfExtractor.h"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+
+// Taille du début de texte affiché dans les traces
+static const size_t PREVIEW_LENGTH = 1500;
+
+PdfTextStream::PdfTextStream(IPdfParser& parser)
+    : parser(parser),
+      tag("[" + parser.getSupplierName() + "]"),
+      textSize(0),
+      lineCount(0),
+      failed(false)
+{
+    parser.beginDocument();
+}
+
+std::vector<PdfLine> PdfTextStream::parseFile(IPdfParser& parser, const std::string& filePath,
+                                              bool useLayout, const std::string& debugSuffix,
+                                              unsigned threadCount)
+{
+    PdfTextStream stream(parser);
+
+    // Debug: sauvegarder le texte extrait au fil de l'eau
+    if (!debugSuffix.empty())
+    {
+        try
+        {
+            std::filesystem::path pdfPathObj = std::filesystem::u8path(filePath);
+            std::filesystem::path debugPath = pdfPathObj.parent_path() / (pdfPathObj.stem().u8string() + debugSuffix);
+            stream.debugFile.open(debugPath);
+            if (stream.debugFile.is_open())
+            {
+                std::string debugMsg = stream.tag + " Texte extrait sauvegardé dans: " + debugPath.u8string() + "\n";
+                debugLog(debugMsg);
+            }
+        }
+        catch (...) {}
+    }
+
+    // Chaque page est analysée sur ce thread pendant que les suivantes sont extraites
+    const bool complete = PopplerPdfExtractor::streamPages(filePath, useLayout,
+        [&stream](std::string& page, int, int)
+        {
+            stream.feed(page.data(), page.size());
+            return true;
+        },
+        threadCount);
+
+    if (!complete && stream.textSize > 0)
+        debugLog(stream.tag + " ATTENTION: extraction interrompue, texte incomplet\n");
+
+    return stream.finish();
+}
+
+std::vector<PdfLine> PdfTextStream::parseText(IPdfParser& parser, const std::string& text)
+{
+    PdfTextStream stream(parser);
+    stream.feed(text.data(), text.size());
+    return stream.finish();
+}
+
+std::vector<PdfLine> PdfTextStream::parseChunks(IPdfParser& parser, const std::vector<std::string>& chunks)
+{
+    PdfTextStream stream(parser);
+    for (const std::string& chunk : chunks)
+        stream.feed(chunk.data(), chunk.size());
+    return stream.finish();
+}
+
+void PdfTextStream::feed(const char* data, size_t size)
+{
+    if (size == 0)
+        return;
+
+    if (debugFile.is_open())
+        debugFile.write(data, static_cast<std::streamsize>(size));
+    if (preview.size() < PREVIEW_LENGTH)
+        preview.append(data, std::min(size, PREVIEW_LENGTH - preview.size()));
+    textSize += size;
+
+    if (failed)
+        return;
+
+    // Lignes complètes du morceau ; la dernière, sans fin de ligne, attend le morceau suivant
+    const char* end = data + size;
+    const char* start = data;
+    for (const char* newline; (newline = static_cast<const char*>(std::memchr(start, '\n', static_cast<size_t>(end - start)))) != nullptr; start = newline + 1)
+    {
+        if (partial.empty())
+        {
+            deliver(std::string_view(start, static_cast<size_t>(newline - start)));
+        }
+        else
+        {
+            partial.append(start, static_cast<size_t>(newline - start));
+            deliver(partial);
+            partial.clear();
+        }
+        if (failed)
+            return;
+    }
+    partial.append(start, static_cast<size_t>(end - start));
+}
+
+void PdfTextStream::deliver(std::string_view line)
+{
+    ++lineCount;
+    try
+    {
+        parser.parseLine(line);
+    }
+    catch (const std::exception& e)
+    {
+        std::string errorMsg = tag + " EXCEPTION: " + std::string(e.what()) + "\n";
+        debugLog(errorMsg);
+        failed = true;
+    }
+    catch (...)
+    {
+        debugLog(tag + " EXCEPTION INCONNUE\n");
+        failed = true;
+    }
+}
+
+std::vector<PdfLine> PdfTextStream::finish()
+{
+    // Dernière ligne sans fin de ligne
+    if (!partial.empty() && !failed)
+    {
+        std::string last;
+        last.swap(partial);
+        deliver(last);
+    }
+
+    if (textSize == 0)
+        debugLog(tag + " Texte vide, abandon\n");
+
+    // Debug: afficher dans la console
+    std::string debug = "=== DEBUG EXTRACTION PDF " + tag + " ===\n";
+    debug += "Poppler disponible: " + std::string(PopplerPdfExtractor::isPopplerAvailable() ? "OUI" : "NON") + "\n";
+    debug += "Texte extrait (" + std::to_string(textSize) + " caractères, " + std::to_string(lineCount) + " lignes analysées):\n";
+    debug += preview + "\n";
+    debug += "=== FIN DEBUG " + tag + " ===\n";
+    debugLog(debug);
+
+    if (debugFile.is_open())
+        debugFile.close();
+
+    return parser.endDocument();
+}
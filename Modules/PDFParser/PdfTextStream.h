@@ -0,0 +1,48 @@
+#pragma once
+#include "IPdfParser.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Transmet le texte d'un PDF ligne par ligne à un parseur (IPdfParser::parseLine)
+//
+// parseFile analyse chaque page dès qu'elle est extraite (PopplerPdfExtractor::streamPages) :
+// l'analyse d'une page a lieu pendant l'extraction des suivantes et seules quelques pages sont
+// en mémoire, jamais le texte complet. Les lignes sont celles que donnerait std::getline sur
+// le texte complet : une ligne à cheval sur deux morceaux est recollée. Les autres lignes sont
+// transmises sans copie (vues sur la page).
+class PdfTextStream
+{
+public:
+    // Extrait et analyse un PDF
+    // debugSuffix : le texte extrait est aussi écrit à côté du PDF dans <nom><debugSuffix>
+    //               (vide = pas de fichier de débogage)
+    // threadCount : threads d'extraction (0 = un par cœur, voir PopplerPdfExtractor)
+    static std::vector<PdfLine> parseFile(IPdfParser& parser, const std::string& filePath,
+                                          bool useLayout, const std::string& debugSuffix,
+                                          unsigned threadCount = 0);
+
+    // Analyse un texte déjà extrait
+    static std::vector<PdfLine> parseText(IPdfParser& parser, const std::string& text);
+
+    // Analyse un texte déjà extrait, reçu en plusieurs morceaux (pages) comme dans parseFile
+    static std::vector<PdfLine> parseChunks(IPdfParser& parser, const std::vector<std::string>& chunks);
+
+private:
+    explicit PdfTextStream(IPdfParser& parser);
+
+    // Morceau de texte suivant (page ou texte complet)
+    void feed(const char* data, size_t size);
+    std::vector<PdfLine> finish();
+
+    void deliver(std::string_view line);
+
+    IPdfParser& parser;
+    std::string tag;            // "[Fournisseur]" pour les traces
+    std::string partial;        // Début de ligne en attente de la fin du morceau suivant
+    std::string preview;        // Début du texte pour les traces
+    std::ofstream debugFile;
+    size_t textSize;
+    size_t lineCount;
+    bool failed;                // Exception du parseur : la suite est ignorée
+};
@@ -1,283 +1,185 @@
 #include "PompacPdfParser.h"
-#include "PopplerPdfExtractor.h"
-#include <fstream>
-#include <sstream>
-#include <regex>
-#include <algorithm>
-#include <filesystem>
-#include <windows.h>
-
-std::string PompacPdfParser::extractText(const std::string& filePath)
+#include "DebugLog.h"
+#include "FrenchNumber.h"
+#include "PdfTextStream.h"
+#include "TextScanner.h"
+
+// Parser ligne par ligne adapté à la structure Pompac (quasi-identique à Siehr)
+// Format observé :
+//   Ligne normale : "T30139  RAD. ALU KLASS. SIMPLE 22 500 1200 2196W  1,000 PIEC  257,64 PIEC  257,64"
+//   Ligne gratuite : "T28971  RAD. PIANO UNI 6 22 900 900 1880W  1,000 PIEC  PIEC  Gratuit"
+//
+// Motif pour article normal (avec prix)
+// Groupe 1 : Référence (optionnelle)
+// Groupe 2 : Désignation (première partie)
+// Groupe 3 : Quantité (format X,XXX)
+// Groupe 4 : Prix unitaire (format XX,XX ou XXX,XX)
+// Groupe 5 : Montant total (format XX,XX ou XXX,XX)
+//
+// Motif pour article GRATUIT
+// Groupe 1 : Référence (optionnelle)
+// Groupe 2 : Désignation
+// Groupe 3 : Quantité (format X,XXX)
+PompacPdfParser::PompacPdfParser()
+    : normalMatcher(PiecLineMatcher::Kind::PRICED),
+      gratuitMatcher(PiecLineMatcher::Kind::FREE)
 {
-    // Utiliser PopplerPdfExtractor
-    std::string text = PopplerPdfExtractor::extractTextFromPdf(filePath);
-
-    // Debug: sauvegarder le texte extrait
-    try
-    {
-        std::filesystem::path pdfPathObj(filePath);
-        std::filesystem::path debugPath = pdfPathObj.parent_path() / (pdfPathObj.stem().string() + "_pompac_extracted.txt");
-        std::ofstream debugFile(debugPath);
-        if (debugFile.is_open())
-        {
-            debugFile << text;
-            debugFile.close();
-            std::string debugMsg = "[Pompac] Texte extrait sauvegardé dans: " + debugPath.string() + "\n";
-            OutputDebugStringA(debugMsg.c_str());
-        }
-    }
-    catch (...) {}
-
-    // Debug: afficher dans la console
-    OutputDebugStringA("=== DEBUG EXTRACTION PDF POMPAC ===\n");
-    std::string debug = "Poppler disponible: " + std::string(PopplerPdfExtractor::isPopplerAvailable() ? "OUI" : "NON") + "\n";
-    debug += "Texte extrait (" + std::to_string(text.length()) + " caractères):\n";
-    size_t previewLength = text.length() < 1500 ? text.length() : 1500;
-    debug += text.substr(0, previewLength) + "\n";
-    debug += "=== FIN DEBUG POMPAC ===\n";
-    OutputDebugStringA(debug.c_str());
-
-    return text;
 }
 
-// Fonction helper pour parser un nombre au format français (virgule décimale)
-static double parseFrenchNumber(const std::string& str)
+void PompacPdfParser::beginDocument()
 {
-    std::string cleaned = str;
-    // Supprimer les espaces
-    cleaned.erase(std::remove(cleaned.begin(), cleaned.end(), ' '), cleaned.end());
-    // Remplacer virgule par point
-    std::replace(cleaned.begin(), cleaned.end(), ',', '.');
-    try {
-        return std::stod(cleaned);
-    }
-    catch (...) {
-        return 0.0;
-    }
+    debugLog("=== DEBUT PARSING POMPAC ===\n");
+
+    hasPending = false;
+    pendingProduct = PdfLine();
+    extractedCount = 0;
+    lines.clear();
 }
 
-// Fonction helper pour trim les espaces
-static std::string trim(const std::string& s)
+void PompacPdfParser::flushPending()
 {
-    auto start = s.find_first_not_of(" \t\r\n");
-    auto end = s.find_last_not_of(" \t\r\n");
-    if (start == std::string::npos) return std::string();
-    return s.substr(start, end - start + 1);
+    if (!hasPending)
+        return;
+    hasPending = false;
+
+    // Ajouter le produit à la liste
+    lines.push_back(pendingProduct);
+    extractedCount++;
+
+    if (debugLogEnabled())
+        debugLog("Pompac produit #" + std::to_string(extractedCount) + ": " +
+            pendingProduct.reference + " | " + pendingProduct.designation + " | " +
+            std::to_string(pendingProduct.quantite) + " | " + std::to_string(pendingProduct.prixHT) + "\n");
 }
 
-std::vector<PdfLine> PompacPdfParser::parseTextContent(const std::string& text)
+void PompacPdfParser::parseLine(std::string_view line)
 {
-    std::vector<PdfLine> lines;
-
-    OutputDebugStringA("=== DEBUT PARSING POMPAC ===\n");
+    const std::string_view currentLine = TextScanner::trim(line);
 
-    // Vérifier si c'est un message d'erreur
-    if (text.find("ERREUR:") == 0)
+    // Ligne suivant un article : compléter la désignation ?
+    if (hasPending)
     {
-        OutputDebugStringA("[Pompac] Texte contient ERREUR, abandon\n");
-        return lines;
+        // Vérifier si c'est une ligne descriptive complémentaire
+        bool isExtraDesc =
+            !currentLine.empty() &&
+            !TextScanner::startsWith(currentLine, "Ecopart.") &&
+            !TextScanner::startsWith(currentLine, "PU") &&
+            !TextScanner::contains(currentLine, "PIEC");
+
+        if (isExtraDesc)
+        {
+            pendingProduct.designation += ' ';
+            pendingProduct.designation += currentLine;
+
+            if (debugLogEnabled())
+                debugLog("[Pompac] Ligne complementaire ajoutee: " + std::string(currentLine) + "\n");
+
+            flushPending();
+            return;  // Cette ligne appartient à l'article
+        }
+        flushPending();
     }
 
-    if (text.empty())
+    // Pré-filtre rapide : sauter les lignes qui ne peuvent pas être des produits
+    // Une ligne produit Pompac contient toujours "PIEC"
+    if (!TextScanner::contains(currentLine, "PIEC"))
     {
-        OutputDebugStringA("[Pompac] Texte vide, abandon\n");
-        return lines;
+        return; // Ligne ignorée
     }
 
-    // Parser ligne par ligne adapté à la structure Pompac (quasi-identique à Siehr)
-    // Format observé :
-    //   Ligne normale : "T30139  RAD. ALU KLASS. SIMPLE 22 500 1200 2196W  1,000 PIEC  257,64 PIEC  257,64"
-    //   Ligne gratuite : "T28971  RAD. PIANO UNI 6 22 900 900 1880W  1,000 PIEC  PIEC  Gratuit"
-
-    int extractedCount = 0;
+    LineMatch match;
+    bool isFree = false;
 
-    try
+    // Tester d'abord le motif normal, puis gratuit
+    if (normalMatcher.search(currentLine, match))
     {
-        OutputDebugStringA("[Pompac] Creation des regex (normal + gratuit)...\n");
-
-        // Regex pour article normal (avec prix)
-        // Groupe 1 : Référence (optionnelle)
-        // Groupe 2 : Désignation (première partie)
-        // Groupe 3 : Quantité (format X,XXX)
-        // Groupe 4 : Prix unitaire (format XX,XX ou XXX,XX)
-        // Groupe 5 : Montant total (format XX,XX ou XXX,XX)
-        std::regex normalRegex(
-            R"(^(?:(\S+)\s+)?(.*?)\s+(\d+,\d{3})\s+PIEC\s+(\d+,\d{2})\s+PIEC\s+(\d+,\d{2})\s*$)",
-            std::regex::ECMAScript
-        );
-
-        // Regex pour article GRATUIT
-        // Groupe 1 : Référence (optionnelle)
-        // Groupe 2 : Désignation
-        // Groupe 3 : Quantité (format X,XXX)
-        std::regex gratuitRegex(
-            R"(^(?:(\S+)\s+)?(.*?)\s+(\d+,\d{3})\s+PIEC\s+PIEC\s+Gratuit\s*$)",
-            std::regex::ECMAScript
-        );
-
-        OutputDebugStringA("[Pompac] Regex crees, debut parsing ligne par ligne...\n");
-
-        // Séparer le texte en lignes
-        std::istringstream stream(text);
-        std::string line;
-        std::vector<std::string> textLines;
-
-        while (std::getline(stream, line))
-        {
-            textLines.push_back(line);
-        }
+        isFree = false;
+        if (debugLogEnabled())
+            debugLog("[Pompac] Article normal detecte\n");
+    }
+    else if (gratuitMatcher.search(currentLine, match))
+    {
+        isFree = true;
+        if (debugLogEnabled())
+            debugLog("[Pompac] Article GRATUIT detecte\n");
+    }
+    else
+    {
+        return; // Pas une ligne d'article
+    }
 
-        std::string lineCountMsg = "[Pompac] Nombre de lignes: " + std::to_string(textLines.size()) + "\n";
-        OutputDebugStringA(lineCountMsg.c_str());
+    PdfLine product;
 
-        // Fonction lambda pour vérifier si une chaîne contient des chiffres
-        auto hasDigit = [](const std::string& s) {
-            return std::any_of(s.begin(), s.end(),
-                [](unsigned char c) { return std::isdigit(c); });
-        };
+    // Extraire les captures communes
+    std::string rawRef(match[1]);
+    std::string desc(TextScanner::trim(match[2]));
+    const std::string_view qteStr = match[3];
 
-        // Parser chaque ligne
-        for (size_t i = 0; i < textLines.size(); ++i)
+    // Filtrer les références : si pas de chiffre, c'est partie de la désignation
+    if (!rawRef.empty() && TextScanner::hasDigit(rawRef))
+    {
+        // Cas normal : vraie référence type T30139, T07321...
+        product.reference = rawRef;
+    }
+    else
+    {
+        // Pas de vraie ref -> le premier mot fait partie de la désignation
+        if (!rawRef.empty())
         {
-            std::string currentLine = trim(textLines[i]);
-
-            // Pré-filtre rapide : sauter les lignes qui ne peuvent pas être des produits
-            // Une ligne produit Pompac contient toujours "PIEC"
-            if (currentLine.find("PIEC") == std::string::npos)
-            {
-                continue; // Ligne ignorée, pas besoin de regex coûteux
-            }
-
-            std::smatch match;
-            bool isFree = false;
-
-            // Tester d'abord le regex normal, puis gratuit
-            if (std::regex_match(currentLine, match, normalRegex))
-            {
-                isFree = false;
-                OutputDebugStringA("[Pompac] Article normal detecte\n");
-            }
-            else if (std::regex_match(currentLine, match, gratuitRegex))
-            {
-                isFree = true;
-                OutputDebugStringA("[Pompac] Article GRATUIT detecte\n");
-            }
-            else
-            {
-                continue; // Pas une ligne d'article
-            }
-
-            PdfLine product;
-
-            // Extraire les captures communes
-            std::string rawRef = match[1].matched ? match[1].str() : "";
-            std::string desc = trim(match[2].str());
-            std::string qteStr = match[3].str();
-
-            // Filtrer les références : si pas de chiffre, c'est partie de la désignation
-            if (!rawRef.empty() && hasDigit(rawRef))
-            {
-                // Cas normal : vraie référence type T30139, T07321...
-                product.reference = rawRef;
-            }
-            else
-            {
-                // Pas de vraie ref -> le premier mot fait partie de la désignation
-                if (!rawRef.empty())
-                {
-                    if (!desc.empty())
-                        desc = rawRef + " " + desc;
-                    else
-                        desc = rawRef;
-                }
-                product.reference = "VIDE";
-
-                OutputDebugStringA("[Pompac] Reference vide detectee (pas de chiffre dans le premier mot)\n");
-            }
-
-            // Désignation
-            product.designation = desc;
-
-            // Quantité
-            product.quantite = parseFrenchNumber(qteStr);
-
-            // Prix unitaire
-            if (!isFree)
-            {
-                // Article normal : récupérer le prix du groupe 4
-                std::string prixStr = match[4].str();
-                product.prixHT = parseFrenchNumber(prixStr);
-            }
+            if (!desc.empty())
+                desc = rawRef + " " + desc;
             else
-            {
-                // Article GRATUIT : prix = 0.00
-                product.prixHT = 0.0;
-            }
-
-            std::string debugMsg = "[Pompac] Ligne article trouvee: Ref=" + product.reference +
-                " | Qte=" + std::to_string(product.quantite) +
-                " | Prix=" + std::to_string(product.prixHT) +
-                (isFree ? " (GRATUIT)" : "") + "\n";
-            OutputDebugStringA(debugMsg.c_str());
-
-            // Regarder la ligne suivante pour compléter la désignation
-            if (i + 1 < textLines.size())
-            {
-                std::string nextLine = trim(textLines[i + 1]);
-
-                // Vérifier si c'est une ligne descriptive complémentaire
-                bool isExtraDesc =
-                    !nextLine.empty() &&
-                    nextLine.find("Ecopart.") != 0 &&
-                    nextLine.find("PU") != 0 &&
-                    nextLine.find("PIEC") == std::string::npos;
+                desc = rawRef;
+        }
+        product.reference = "VIDE";
 
-                if (isExtraDesc)
-                {
-                    product.designation += " " + nextLine;
-                    ++i; // Sauter cette ligne car elle appartient à cet article
+        if (debugLogEnabled())
+            debugLog("[Pompac] Reference vide detectee (pas de chiffre dans le premier mot)\n");
+    }
 
-                    std::string debugExtra = "[Pompac] Ligne complementaire ajoutee: " + nextLine + "\n";
-                    OutputDebugStringA(debugExtra.c_str());
-                }
-            }
+    // Désignation
+    product.designation = desc;
 
-            // Ajouter le produit à la liste
-            lines.push_back(product);
-            extractedCount++;
+    // Quantité
+    product.quantite = FrenchNumber::parseOr(qteStr);
 
-            std::string productMsg = "Pompac produit #" + std::to_string(extractedCount) + ": " +
-                product.reference + " | " + product.designation + " | " +
-                std::to_string(product.quantite) + " | " + std::to_string(product.prixHT) + "\n";
-            OutputDebugStringA(productMsg.c_str());
-        }
-    }
-    catch (const std::regex_error& e)
+    // Prix unitaire
+    if (!isFree)
     {
-        std::string errorMsg = "[Pompac] ERREUR REGEX: " + std::string(e.what()) + "\n";
-        OutputDebugStringA(errorMsg.c_str());
+        // Article normal : récupérer le prix du groupe 4
+        product.prixHT = FrenchNumber::parseOr(match[4]);
     }
-    catch (const std::exception& e)
+    else
     {
-        std::string errorMsg = "[Pompac] EXCEPTION: " + std::string(e.what()) + "\n";
-        OutputDebugStringA(errorMsg.c_str());
-    }
-    catch (...)
-    {
-        OutputDebugStringA("[Pompac] EXCEPTION INCONNUE\n");
+        // Article GRATUIT : prix = 0.00
+        product.prixHT = 0.0;
     }
 
+    if (debugLogEnabled())
+        debugLog("[Pompac] Ligne article trouvee: Ref=" + product.reference +
+            " | Qte=" + std::to_string(product.quantite) +
+            " | Prix=" + std::to_string(product.prixHT) +
+            (isFree ? " (GRATUIT)" : "") + "\n");
+
+    // En attente de la ligne suivante pour compléter la désignation
+    pendingProduct = std::move(product);
+    hasPending = true;
+}
+
+std::vector<PdfLine> PompacPdfParser::endDocument()
+{
+    flushPending();
+
     // Log final
     std::string finalMsg = "=== RESUME PARSING POMPAC ===\n";
     finalMsg += "Produits extraits : " + std::to_string(extractedCount) + "\n";
     finalMsg += "==============================\n";
-    OutputDebugStringA(finalMsg.c_str());
+    debugLog(finalMsg);
 
-    return lines;
+    return std::move(lines);
 }
 
 std::vector<PdfLine> PompacPdfParser::parse(const std::string& filePath)
 {
-    std::string text = extractText(filePath);
-    return parseTextContent(text);
+    return PdfTextStream::parseFile(*this, filePath, true, debugSuffix("_siehr_extracted.txt"), extractionThreads);
 }
@@ -1,14 +1,32 @@
 #pragma once
 #include "IPdfParser.h"
+#include "LineMatcher.h"
 
 class PompacPdfParser : public IPdfParser
 {
 public:
+    PompacPdfParser();
+
     std::vector<PdfLine> parse(const std::string& filePath) override;
     std::string getSupplierName() const override { return "Pompac"; }
 
+    void beginDocument() override;
+    void parseLine(std::string_view line) override;
+    std::vector<PdfLine> endDocument() override;
+
 private:
-    // Méthodes privées pour le parsing spécifique Pompac
-    std::string extractText(const std::string& filePath);
-    std::vector<PdfLine> parseTextContent(const std::string& text);
+    // Ajoute l'article en attente de sa ligne complémentaire
+    void flushPending();
+
+    // Motifs des lignes article (normal + gratuit), construits une fois par parseur
+    // (voir le constructeur)
+    PiecLineMatcher normalMatcher;
+    PiecLineMatcher gratuitMatcher;
+
+    // Article trouvé, en attente de la ligne suivante (désignation complémentaire éventuelle,
+    // éventuellement en haut de la page suivante)
+    bool hasPending = false;
+    PdfLine pendingProduct;
+    int extractedCount = 0;
+    std::vector<PdfLine> lines;
 };
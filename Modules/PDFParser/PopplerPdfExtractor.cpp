@@ -1,61 +1,350 @@
 #include "PopplerPdfExtractor.h"
+#include "DebugLog.h"
+#include "ExtractionCache.h"
+#include "ParallelPageReader.h"
+#include <algorithm>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
 #include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+// Définir USE_POPPLER si Poppler est disponible
+// Pour l'instant, on détecte à la compilation
+#ifdef USE_POPPLER
+#include <poppler/cpp/poppler-document.h>
+#include <poppler/cpp/poppler-page.h>
+#include <poppler/cpp/poppler-page-renderer.h>
+#include <poppler/cpp/poppler-version.h>
+#endif
 
-// Fonction helper pour exécuter une commande sans afficher de fenêtre
-static int executeCommandSilent(const std::string& command)
+// Taille initiale du tampon de sortie de pdftotext : le texte d'un PDF est en général
+// plus court que le fichier lui-même
+static size_t initialOutputCapacity(const std::string& pdfPath)
 {
-    STARTUPINFOA si;
-    PROCESS_INFORMATION pi;
+    const size_t minimum = 64 * 1024;
+    const size_t maximum = 64 * 1024 * 1024;
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(std::filesystem::u8path(pdfPath), error);
+    if (error)
+        return minimum;
+    return static_cast<size_t>(std::clamp<std::uintmax_t>(size, minimum, maximum));
+}
+
+// Bloc lu à chaque appel sur le tube de pdftotext
+static constexpr size_t readChunkSize = 64 * 1024;
+
+#ifdef _WIN32
+
+// Argument de ligne de commande Windows entre guillemets (règles de CommandLineToArgvW)
+static std::wstring quoteArgument(const std::wstring& argument)
+{
+    std::wstring quoted = L"\"";
+    size_t backslashes = 0;
+    for (wchar_t c : argument)
+    {
+        if (c == L'\\')
+        {
+            ++backslashes;
+            continue;
+        }
+        if (c == L'"')
+            quoted.append(backslashes * 2 + 1, L'\\');
+        else
+            quoted.append(backslashes, L'\\');
+        backslashes = 0;
+        quoted += c;
+    }
+    quoted.append(backslashes * 2, L'\\');
+    quoted += L'"';
+    return quoted;
+}
+
+// Exécute un programme sans fenêtre et lit sa sortie standard dans output
+// Seuls les handles du tube et de NUL sont hérités : deux extractions simultanées
+// ne se partagent jamais leurs tubes. Retourne le code de sortie, -1 si échec.
+static int runAndCapture(const std::filesystem::path& program, const std::vector<std::wstring>& arguments,
+                         std::string& output)
+{
+    std::wstring commandLine = quoteArgument(program.wstring());
+    for (const auto& argument : arguments)
+        commandLine += L" " + quoteArgument(argument);
+
+    SECURITY_ATTRIBUTES sa;
+    ZeroMemory(&sa, sizeof(sa));
+    sa.nLength = sizeof(sa);
+    sa.bInheritHandle = TRUE;
+
+    HANDLE readPipe = NULL;
+    HANDLE writePipe = NULL;
+    if (!CreatePipe(&readPipe, &writePipe, &sa, 0))
+        return -1;
+    SetHandleInformation(readPipe, HANDLE_FLAG_INHERIT, 0);
+
+    HANDLE nul = CreateFileW(L"NUL", GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                             &sa, OPEN_EXISTING, 0, NULL);
+
+    // Liste explicite des handles hérités
+    HANDLE inherited[2] = { writePipe, nul };
+    SIZE_T attributeSize = 0;
+    InitializeProcThreadAttributeList(NULL, 1, 0, &attributeSize);
+    std::vector<char> attributeBuffer(attributeSize);
+    auto attributes = reinterpret_cast<LPPROC_THREAD_ATTRIBUTE_LIST>(attributeBuffer.data());
+    bool attributesReady = InitializeProcThreadAttributeList(attributes, 1, 0, &attributeSize) &&
+        UpdateProcThreadAttribute(attributes, 0, PROC_THREAD_ATTRIBUTE_HANDLE_LIST, inherited,
+                                  (nul != INVALID_HANDLE_VALUE ? 2 : 1) * sizeof(HANDLE), NULL, NULL);
+
+    STARTUPINFOEXW si;
     ZeroMemory(&si, sizeof(si));
-    si.cb = sizeof(si);
-    si.dwFlags = STARTF_USESHOWWINDOW;
-    si.wShowWindow = SW_HIDE;  // Cacher la fenêtre
+    si.StartupInfo.cb = sizeof(si);
+    si.StartupInfo.dwFlags = STARTF_USESTDHANDLES | STARTF_USESHOWWINDOW;
+    si.StartupInfo.wShowWindow = SW_HIDE;  // Cacher la fenêtre
+    si.StartupInfo.hStdInput = nul;
+    si.StartupInfo.hStdOutput = writePipe;
+    si.StartupInfo.hStdError = nul;
+    si.lpAttributeList = attributesReady ? attributes : NULL;
+
+    PROCESS_INFORMATION pi;
     ZeroMemory(&pi, sizeof(pi));
 
-    // Créer une copie modifiable de la commande
-    std::string cmdCopy = command;
-
-    // Créer le processus
-    if (!CreateProcessA(
-        NULL,                   // Nom de l'application
-        &cmdCopy[0],           // Ligne de commande (modifiable)
-        NULL,                   // Attributs de sécurité du processus
-        NULL,                   // Attributs de sécurité du thread
-        FALSE,                  // Héritage des handles
-        CREATE_NO_WINDOW,       // Drapeaux de création (pas de fenêtre)
-        NULL,                   // Environnement
-        NULL,                   // Répertoire courant
-        &si,                    // Informations de démarrage
-        &pi))                   // Informations du processus
+    BOOL created = attributesReady && CreateProcessW(
+        program.wstring().c_str(),  // Programme (pas de recherche dans le PATH ni de cmd.exe)
+        &commandLine[0],            // Ligne de commande (modifiable)
+        NULL,                       // Attributs de sécurité du processus
+        NULL,                       // Attributs de sécurité du thread
+        TRUE,                       // Héritage des handles de la liste
+        CREATE_NO_WINDOW | EXTENDED_STARTUPINFO_PRESENT,
+        NULL,                       // Environnement
+        NULL,                       // Répertoire courant
+        &si.StartupInfo,
+        &pi);
+
+    if (attributesReady)
+        DeleteProcThreadAttributeList(attributes);
+
+    // Le processus fils garde sa copie : fermer la nôtre pour recevoir la fin du tube
+    CloseHandle(writePipe);
+    if (nul != INVALID_HANDLE_VALUE)
+        CloseHandle(nul);
+
+    if (!created)
     {
-        return -1;  // Échec
+        CloseHandle(readPipe);
+        return -1;
     }
 
-    // Attendre que le processus se termine
-    WaitForSingleObject(pi.hProcess, INFINITE);
+    // Lecture directe dans le tampon par blocs fixes : seuls les octets ajoutés depuis le
+    // bloc précédent sont initialisés, la capacité réservée par l'appelant évite les copies
+    size_t used = output.size();
+    while (true)
+    {
+        output.resize(used + readChunkSize);
+        DWORD read = 0;
+        if (!ReadFile(readPipe, &output[used], static_cast<DWORD>(readChunkSize), &read, NULL) || read == 0)
+            break;
+        used += read;
+    }
+    output.resize(used);
+    CloseHandle(readPipe);
 
-    // Récupérer le code de sortie
+    WaitForSingleObject(pi.hProcess, INFINITE);
     DWORD exitCode = 0;
     GetExitCodeProcess(pi.hProcess, &exitCode);
-
-    // Fermer les handles
     CloseHandle(pi.hProcess);
     CloseHandle(pi.hThread);
 
     return static_cast<int>(exitCode);
 }
 
-// Définir USE_POPPLER si Poppler est disponible
-// Pour l'instant, on détecte à la compilation
+#else
+
+// Exécute un programme et lit sa sortie standard dans output (erreurs vers /dev/null)
+// Retourne le code de sortie, -1 si échec.
+static int runAndCapture(const std::filesystem::path& program, const std::vector<std::string>& arguments,
+                         std::string& output)
+{
+    int fds[2];
+#ifdef __linux__
+    if (pipe2(fds, O_CLOEXEC) != 0)
+        return -1;
+#else
+    if (pipe(fds) != 0)
+        return -1;
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+#endif
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+
+    const std::string programPath = program.string();
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(programPath.c_str()));
+    for (const auto& argument : arguments)
+        argv.push_back(const_cast<char*>(argument.c_str()));
+    argv.push_back(nullptr);
+
+    pid_t pid = 0;
+    const int spawned = posix_spawn(&pid, programPath.c_str(), &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+
+    if (spawned != 0)
+    {
+        close(fds[0]);
+        return -1;
+    }
+
+    // Lecture directe dans le tampon par blocs fixes : seuls les octets ajoutés depuis le
+    // bloc précédent sont initialisés, la capacité réservée par l'appelant évite les copies
+    size_t used = output.size();
+    while (true)
+    {
+        output.resize(used + readChunkSize);
+        const ssize_t read = ::read(fds[0], &output[used], readChunkSize);
+        if (read < 0 && errno == EINTR)
+            continue;
+        if (read <= 0)
+            break;
+        used += static_cast<size_t>(read);
+    }
+    output.resize(used);
+    close(fds[0]);
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR)
+    {
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+#endif
+
+// Dossier de l'exécutable TCHub
+static std::filesystem::path executableDirectory()
+{
+#ifdef _WIN32
+    std::vector<wchar_t> buffer(MAX_PATH);
+    while (true)
+    {
+        DWORD length = GetModuleFileNameW(NULL, buffer.data(), static_cast<DWORD>(buffer.size()));
+        if (length == 0)
+            return std::filesystem::path();
+        if (length < buffer.size())
+            return std::filesystem::path(std::wstring(buffer.data(), length)).parent_path();
+        buffer.resize(buffer.size() * 2);
+    }
+#else
+    std::error_code error;
+    std::filesystem::path self = std::filesystem::read_symlink("/proc/self/exe", error);
+    return error ? std::filesystem::path() : self.parent_path();
+#endif
+}
+
+// Chemin imposé par setPdfToTextPath (vide : recherche habituelle)
+static std::mutex pdfToTextOverrideMutex;
+static std::string pdfToTextOverride;
+
+void PopplerPdfExtractor::setPdfToTextPath(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(pdfToTextOverrideMutex);
+    pdfToTextOverride = path;
+}
+
+std::string PopplerPdfExtractor::pdfToTextPath()
+{
+    {
+        std::lock_guard<std::mutex> lock(pdfToTextOverrideMutex);
+        if (!pdfToTextOverride.empty())
+            return pdfToTextOverride;
+    }
+
+    // Recherche faite une seule fois (initialisation d'une variable statique : sûre entre threads)
+    static const std::string resolved = []() -> std::string
+    {
+#ifdef _WIN32
+        const char* executableName = "pdftotext.exe";
+        const char pathSeparator = ';';
+#else
+        const char* executableName = "pdftotext";
+        const char pathSeparator = ':';
+#endif
+        std::vector<std::filesystem::path> candidates;
+
+        // Dossier de l'exécutable TCHub, puis dossier courant
+        std::filesystem::path exeDir = executableDirectory();
+        if (!exeDir.empty())
+            candidates.push_back(exeDir / executableName);
+        candidates.push_back(std::filesystem::current_path() / executableName);
+
+        // Dossiers du PATH
+        if (const char* pathVariable = std::getenv("PATH"))
+        {
+            std::istringstream entries(pathVariable);
+            std::string entry;
+            while (std::getline(entries, entry, pathSeparator))
+            {
+                if (!entry.empty())
+                    candidates.push_back(std::filesystem::path(entry) / executableName);
+            }
+        }
+
+#ifdef _WIN32
+        // Emplacements d'installation habituels (vcpkg, Poppler for Windows)
+        candidates.push_back("C:\\Dev\\vcpkg\\installed\\x64-windows\\tools\\poppler\\pdftotext.exe");
+        candidates.push_back("C:\\Dev\\vcpkg\\installed\\x64-windows\\bin\\pdftotext.exe");
+        candidates.push_back("C:\\poppler-utils\\pdftotext.exe");
+#endif
+
+        for (const auto& candidate : candidates)
+        {
+            std::error_code error;
+            if (std::filesystem::is_regular_file(candidate, error))
+            {
+                debugLog("[PopplerExtractor] pdftotext trouve: " + candidate.u8string() + "\n");
+                return candidate.u8string();
+            }
+        }
+
+        debugLog("[PopplerExtractor] pdftotext introuvable\n");
+        return std::string();
+    }();
+    return resolved;
+}
+
+const std::string& PopplerPdfExtractor::extractorVersion()
+{
+    static const std::string version = []()
+    {
+        std::string text = "t" + std::to_string(TEXT_FORMAT_VERSION);
 #ifdef USE_POPPLER
-#include <poppler/cpp/poppler-document.h>
-#include <poppler/cpp/poppler-page.h>
-#include <poppler/cpp/poppler-page-renderer.h>
+        text += "-poppler" + poppler::version_string();
 #endif
+        return text;
+    }();
+    return version;
+}
 
 bool PopplerPdfExtractor::isPopplerAvailable()
 {
@@ -66,216 +355,361 @@ bool PopplerPdfExtractor::isPopplerAvailable()
 #endif
 }
 
-std::string PopplerPdfExtractor::readWithPoppler(const std::string& pdfPath)
+bool PopplerPdfExtractor::readWithPoppler(const std::string& pdfPath, bool useLayout, unsigned threadCount,
+                                          const PageCallback& onPage, bool& delivered)
 {
+    delivered = false;
 #ifdef USE_POPPLER
     try
     {
-        // Normaliser le chemin (convertir backslashes en forward slashes)
-        std::string normalizedPath = pdfPath;
-        std::replace(normalizedPath.begin(), normalizedPath.end(), '\\', '/');
-
-        std::string debugMsg = "[Poppler API] Tentative de chargement: " + normalizedPath + "\n";
-        OutputDebugStringA(debugMsg.c_str());
+        // Contenu du PDF lu une fois, partagé par les documents de tous les threads
+        // (chemin UTF-8 ouvert via std::filesystem : accents corrects sous Windows)
+        std::vector<char> bytes;
+        {
+            std::ifstream file(std::filesystem::u8path(pdfPath), std::ios::binary);
+            if (!file)
+            {
+                debugLog("[Poppler API] ERREUR: Fichier illisible\n");
+                return false;
+            }
+            bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        const int byteCount = static_cast<int>(bytes.size());
 
-        // Charger le document PDF
-        std::unique_ptr<poppler::document> doc(poppler::document::load_from_file(normalizedPath));
+        // Charger le document PDF (repris par le premier thread d'extraction)
+        std::unique_ptr<poppler::document> doc(poppler::document::load_from_raw_data(bytes.data(), byteCount));
 
         if (!doc)
         {
-            OutputDebugStringA("[Poppler API] ERREUR: Document NULL - fichier introuvable ou invalide\n");
-            return "";
+            debugLog("[Poppler API] ERREUR: Document NULL - fichier invalide\n");
+            return false;
         }
 
         if (doc->is_locked())
         {
-            OutputDebugStringA("[Poppler API] ERREUR: Document verrouille (crypte)\n");
-            return "";
+            debugLog("[Poppler API] ERREUR: Document verrouille (crypte)\n");
+            return false;
         }
 
-        std::stringstream result;
+        // Disposition physique (colonnes alignées comme pdftotext -layout) ou ordre de lecture
+        const poppler::page::text_layout_enum layout = useLayout
+            ? poppler::page::physical_layout
+            : poppler::page::non_raw_non_physical_layout;
 
-        // Extraire le texte de chaque page
-        int pages = doc->pages();
-        debugMsg = "[Poppler API] Document charge: " + std::to_string(pages) + " page(s)\n";
-        OutputDebugStringA(debugMsg.c_str());
+        const int pageCount = doc->pages();
+        threadCount = ParallelPageReader::effectiveThreadCount(pageCount, threadCount);
 
-        for (int i = 0; i < pages; ++i)
+        debugLog("[Poppler API] Document charge: " + std::to_string(pageCount) + " page(s), " +
+                 std::to_string(threadCount) + " thread(s)\n");
+
+        // Chaque thread ouvre son propre document (poppler::document n'est pas partageable entre
+        // threads) ; le premier reprend le document déjà chargé
+        std::shared_ptr<poppler::document> firstDocument(std::move(doc));
+        const ParallelPageReader::ReaderFactory makeReader = [&](unsigned threadIndex) -> ParallelPageReader::PageReader
         {
-            std::unique_ptr<poppler::page> page(doc->create_page(i));
-            if (!page)
+            std::shared_ptr<poppler::document> document;
+            if (threadIndex == 0)
+                document = std::move(firstDocument);
+            if (!document)
             {
-                debugMsg = "[Poppler API] ERREUR: Impossible de creer la page " + std::to_string(i + 1) + "\n";
-                OutputDebugStringA(debugMsg.c_str());
-                continue;
+                document.reset(poppler::document::load_from_raw_data(bytes.data(), byteCount));
+                if (!document)
+                    throw std::runtime_error("Document NULL");
             }
 
-            // Méthode 1 : Essayer d'extraire avec le layout préservé
-            poppler::rectf pageRect(0, 0, page->page_rect().width(), page->page_rect().height());
-            poppler::ustring text = page->text(pageRect);
-
-            // Utiliser UTF-8 pour préserver tous les caractères Unicode (accents, espaces insécables, etc.)
-            poppler::byte_array utf8_data = text.to_utf8();
-            std::string pageText(utf8_data.begin(), utf8_data.end());
-
-            // Si le texte extrait est vide, essayer la méthode simple
-            if (pageText.empty())
+            return [document, layout](int i)
             {
-                text = page->text();
-                utf8_data = text.to_utf8();
-                pageText = std::string(utf8_data.begin(), utf8_data.end());
-            }
-
-            debugMsg = "[Poppler API] Page " + std::to_string(i + 1) + ": " +
-                std::to_string(pageText.length()) + " caracteres extraits\n";
-            OutputDebugStringA(debugMsg.c_str());
+                std::string text;
+                std::unique_ptr<poppler::page> page(document->create_page(i));
+                if (page)
+                {
+                    // Page entière avec la disposition demandée, en UTF-8 pour préserver tous
+                    // les caractères Unicode (accents, espaces insécables, etc.)
+                    poppler::rectf pageRect(0, 0, page->page_rect().width(), page->page_rect().height());
+                    poppler::byte_array utf8_data = page->text(pageRect, layout).to_utf8();
+
+                    // Si le texte extrait est vide, essayer la méthode simple
+                    if (utf8_data.empty())
+                        utf8_data = page->text().to_utf8();
+
+                    text.reserve(utf8_data.size() + 1);
+                    text.assign(utf8_data.begin(), utf8_data.end());
+                    text += '\n';  // Fin de ligne après chaque page, comme l'extraction d'un bloc
+                }
+                else
+                {
+                    debugLog("[Poppler API] ERREUR: Impossible de creer la page " + std::to_string(i + 1) + "\n");
+                }
+                return text;
+            };
+        };
 
-            result << pageText << "\n";
+        switch (ParallelPageReader::read(pageCount, threadCount, makeReader, onPage, delivered))
+        {
+        case ParallelPageReader::Result::Complete:
+            return true;
+        case ParallelPageReader::Result::Failed:
+            debugLog("[Poppler API] EXCEPTION dans un thread d'extraction\n");
+            return false;
+        case ParallelPageReader::Result::Cancelled:
+            debugLog("[Poppler API] Extraction annulee\n");
+            return false;
+        case ParallelPageReader::Result::NoText:
+            break;
         }
-
-        std::string extracted = result.str();
-
-        debugMsg = "[Poppler API] Total extrait: " + std::to_string(extracted.length()) + " caracteres\n";
-        OutputDebugStringA(debugMsg.c_str());
-
-        return extracted;
+        debugLog("[Poppler API] Aucun texte extrait\n");
+        return false;
     }
     catch (const std::exception& e)
     {
         std::string errorMsg = "[Poppler API] EXCEPTION: ";
         errorMsg += e.what();
         errorMsg += "\n";
-        OutputDebugStringA(errorMsg.c_str());
-        return "";
+        debugLog(errorMsg);
+        return false;
     }
     catch (...)
     {
-        OutputDebugStringA("[Poppler API] EXCEPTION INCONNUE\n");
-        return "";
+        debugLog("[Poppler API] EXCEPTION INCONNUE\n");
+        return false;
     }
 #else
     // Poppler non disponible
-    return "";
+    (void)pdfPath;
+    (void)useLayout;
+    (void)threadCount;
+    (void)onPage;
+    return false;
 #endif
 }
 
-std::string PopplerPdfExtractor::extractTextFromPdf(const std::string& pdfPath, bool useLayout)
+std::string PopplerPdfExtractor::readWithPdfToText(const std::string& pdfPath, bool useLayout, int lastPage)
 {
-    if (!std::filesystem::exists(pdfPath))
-    {
-        OutputDebugStringA("[PopplerExtractor] ERREUR: Fichier PDF introuvable\n");
+    const std::string tool = pdfToTextPath();
+    if (tool.empty())
         return "";
+
+    // Option -layout + -fixed avec espacement large pour mieux séparer les colonnes
+    // Option -enc UTF-8 pour forcer l'encodage UTF-8 (important pour les symboles €, accents, etc.)
+    // Fichier de sortie "-" : le texte est écrit sur la sortie standard
+#ifdef _WIN32
+    std::vector<std::wstring> arguments;
+    if (useLayout)
+    {
+        arguments.push_back(L"-layout");
+        arguments.push_back(L"-fixed");
+        arguments.push_back(L"10");
+    }
+    arguments.push_back(L"-enc");
+    arguments.push_back(L"UTF-8");
+    arguments.push_back(L"-eol");
+    arguments.push_back(L"unix");
+    if (lastPage > 0)
+    {
+        arguments.push_back(L"-l");
+        arguments.push_back(std::to_wstring(lastPage));
     }
+    arguments.push_back(std::filesystem::u8path(pdfPath).wstring());
+    arguments.push_back(L"-");
+#else
+    std::vector<std::string> arguments;
+    if (useLayout)
+    {
+        arguments.push_back("-layout");
+        arguments.push_back("-fixed");
+        arguments.push_back("10");
+    }
+    arguments.push_back("-enc");
+    arguments.push_back("UTF-8");
+    arguments.push_back("-eol");
+    arguments.push_back("unix");
+    if (lastPage > 0)
+    {
+        arguments.push_back("-l");
+        arguments.push_back(std::to_string(lastPage));
+    }
+    arguments.push_back(pdfPath);
+    arguments.push_back("-");
+#endif
 
-    OutputDebugStringA("=== DEBUT EXTRACTION PDF ===\n");
-    std::string debugMsg = "[PopplerExtractor] Fichier: " + pdfPath + "\n";
-    OutputDebugStringA(debugMsg.c_str());
+    std::string text;
+    text.reserve(initialOutputCapacity(pdfPath));
+    const int exitCode = runAndCapture(std::filesystem::u8path(tool), arguments, text);
 
-    std::string layoutMsg = "[PopplerExtractor] Option layout: " + std::string(useLayout ? "OUI" : "NON") + "\n";
-    OutputDebugStringA(layoutMsg.c_str());
+    std::string debugMsg = "[PopplerExtractor] pdftotext code retour: " + std::to_string(exitCode) +
+        ", " + std::to_string(text.length()) + " caracteres\n";
+    debugLog(debugMsg);
 
-    // MÉTHODE 1 : Essayer pdftotext (utilitaire en ligne de commande de Poppler)
-    // C'est souvent plus robuste que l'API C++ pour certains PDFs
-    OutputDebugStringA("[PopplerExtractor] === METHODE 1: pdftotext (ligne de commande) ===\n");
+    if (exitCode != 0)
+        return "";
 
-    std::string tempTxt = std::filesystem::path(pdfPath).replace_extension(".poppler_temp.txt").string();
-    debugMsg = "[PopplerExtractor] Fichier temp: " + tempTxt + "\n";
-    OutputDebugStringA(debugMsg.c_str());
+    // Fins de ligne déjà "\n" (-eol unix, sortie standard en binaire dans pdftotext)
+    return text;
+}
 
-    // Essayer plusieurs emplacements pour pdftotext
-    std::vector<std::string> pdftotext_paths = {
-        "pdftotext",  // Dans le PATH (si ajouté)
-        "C:\\Dev\\vcpkg\\installed\\x64-windows\\tools\\poppler\\pdftotext.exe",
-        "C:\\Dev\\vcpkg\\installed\\x64-windows\\bin\\pdftotext.exe",
-        ".\\pdftotext.exe",  // Dans le dossier de l'exécutable TCHub
-        "C:\\poppler-utils\\pdftotext.exe"  // Emplacement alternatif
-    };
+bool PopplerPdfExtractor::streamPages(const std::string& pdfPath, bool useLayout,
+                                      const PageCallback& onPage, unsigned threadCount)
+{
+    std::error_code existsError;
+    if (!std::filesystem::exists(std::filesystem::u8path(pdfPath), existsError))
+    {
+        debugLog("[PopplerExtractor] ERREUR: Fichier PDF introuvable\n");
+        return false;
+    }
+
+    debugLog("=== DEBUT EXTRACTION PDF ===\n");
+    debugLog("[PopplerExtractor] Fichier: " + pdfPath + "\n");
+    debugLog("[PopplerExtractor] Option layout: " + std::string(useLayout ? "OUI" : "NON") + "\n");
+
+    // Texte déjà extrait de ce contenu avec ces options : aucune extraction
+    const std::string cacheKey = ExtractionCache::keyFor(pdfPath, useLayout);
+    bool cachedComplete = false;
+    if (ExtractionCache::deliver(cacheKey, onPage, cachedComplete))
+        return cachedComplete;
 
-    for (const auto& pdftotext_path : pdftotext_paths)
+    // Les pages sont écrites dans le cache au fil de l'extraction, avant d'être remises (onPage
+    // peut déplacer leur contenu) ; l'entrée n'est gardée que si l'extraction est complète
+    ExtractionCache::Writer cacheWriter(cacheKey);
+
+    // MÉTHODE 1 : API Poppler C++ dans le processus (ni processus externe ni fichier),
+    // pages réparties entre plusieurs threads
+    debugLog("[PopplerExtractor] === METHODE 1: API Poppler C++ ===\n");
+    if (isPopplerAvailable())
     {
-        debugMsg = "[PopplerExtractor] Test: " + pdftotext_path + "\n";
-        OutputDebugStringA(debugMsg.c_str());
+        const PageCallback cachingOnPage = [&cacheWriter, &onPage](std::string& page, int pageIndex, int pageCount)
+        {
+            cacheWriter.addPage(page);
+            return onPage(page, pageIndex, pageCount);
+        };
 
-        // Utiliser cmd.exe /c pour que les guillemets et redirections soient correctement interprétés
-        // Option -layout + -fixed avec espacement large pour mieux séparer les colonnes
-        // Option -enc UTF-8 pour forcer l'encodage UTF-8 (important pour les symboles €, accents, etc.)
-        std::string layoutOption = useLayout ? "-layout -fixed 10 " : "";
-        std::string command = "cmd.exe /c \"\"" + pdftotext_path + "\" " + layoutOption + "-enc UTF-8 \"" + pdfPath + "\" \"" + tempTxt + "\" 2>nul\"";
+        bool delivered = false;
+        if (readWithPoppler(pdfPath, useLayout, threadCount, cachingOnPage, delivered))
+        {
+            debugLog("[PopplerExtractor] ✓ SUCCESS avec API Poppler C++\n");
+            cacheWriter.commit();
+            return true;
+        }
+        if (delivered)
+            return false;  // Annulée ou interrompue : des pages ont déjà été remises
+    }
+    else
+    {
+        debugLog("[PopplerExtractor] API Poppler C++ non disponible\n");
+    }
 
-        debugMsg = "[PopplerExtractor] Commande: " + command + "\n";
-        OutputDebugStringA(debugMsg.c_str());
+    // MÉTHODES 2 et 3 : texte complet en une seule « page »
+    // Le fichier .txt saisi à la main n'est pas mis en cache (il peut être corrigé à tout moment)
+    bool cacheable = false;
+    std::string text = readWithFallbacks(pdfPath, useLayout, cacheable);
+    if (text.empty())
+        return false;
+    if (cacheable)
+    {
+        cacheWriter.addPage(text);
+        cacheWriter.commit();
+    }
+    return onPage(text, 0, 1);
+}
 
-        // Exécuter pdftotext sans afficher de fenêtre
-        int exitCode = executeCommandSilent(command);
+std::string PopplerPdfExtractor::extractFirstPage(const std::string& pdfPath, bool useLayout)
+{
+    std::error_code existsError;
+    if (!std::filesystem::exists(std::filesystem::u8path(pdfPath), existsError))
+        return "";
 
-        debugMsg = "[PopplerExtractor] Code retour: " + std::to_string(exitCode) + "\n";
-        OutputDebugStringA(debugMsg.c_str());
+    std::string firstPage;
+    const PageCallback keepFirstPage = [&firstPage](std::string& page, int, int)
+    {
+        firstPage = std::move(page);
+        return false;
+    };
 
-        bool tempExists = std::filesystem::exists(tempTxt);
-        debugMsg = "[PopplerExtractor] Fichier temp existe: " + std::string(tempExists ? "OUI" : "NON") + "\n";
-        OutputDebugStringA(debugMsg.c_str());
+    // Texte complet déjà en cache, sinon API Poppler sur un seul thread, arrêtée après la page 1
+    bool complete = false;
+    bool delivered = ExtractionCache::deliver(ExtractionCache::keyFor(pdfPath, useLayout), keepFirstPage, complete);
+    if (!delivered && isPopplerAvailable())
+        readWithPoppler(pdfPath, useLayout, 1, keepFirstPage, delivered);
 
-        if (exitCode == 0 && tempExists)
-        {
-            std::ifstream file(tempTxt);
-            if (file.is_open())
-            {
-                std::stringstream buffer;
-                buffer << file.rdbuf();
-                std::string text = buffer.str();
-                file.close();
+    // pdftotext : première page seulement ; fichier .txt : texte complet
+    if (!delivered)
+    {
+        bool fromPdfToText = false;
+        firstPage = readWithFallbacks(pdfPath, useLayout, fromPdfToText, 1);
+    }
 
-                debugMsg = "[PopplerExtractor] Texte extrait: " + std::to_string(text.length()) + " caracteres\n";
-                OutputDebugStringA(debugMsg.c_str());
+    // Texte rendu d'un seul bloc (pdftotext, fichier .txt) : pages séparées par un saut de page
+    const size_t pageBreak = firstPage.find('\f');
+    if (pageBreak != std::string::npos)
+        firstPage.resize(pageBreak);
+    return firstPage;
+}
 
-                std::filesystem::remove(tempTxt);
+std::vector<std::string> PopplerPdfExtractor::extractPages(const std::string& pdfPath, bool useLayout,
+                                                          const ProgressCallback& progress, unsigned threadCount)
+{
+    std::vector<std::string> pages;
+    const bool complete = streamPages(pdfPath, useLayout,
+        [&pages, &progress](std::string& page, int pageIndex, int pageCount)
+        {
+            pages.push_back(std::move(page));
+            return !progress || progress(pageIndex + 1, pageCount);
+        },
+        threadCount);
+
+    if (!complete)
+        pages.clear();
+    return pages;
+}
 
-                if (!text.empty())
-                {
-                    std::string msg = "[PopplerExtractor] ✓ SUCCESS avec pdftotext (" + pdftotext_path + ")\n";
-                    OutputDebugStringA(msg.c_str());
-                    return text;
-                }
-                else
-                {
-                    OutputDebugStringA("[PopplerExtractor] Fichier temp vide\n");
-                }
-            }
-            else
-            {
-                OutputDebugStringA("[PopplerExtractor] Impossible d'ouvrir le fichier temp\n");
-            }
-        }
+std::string PopplerPdfExtractor::extractTextFromPdf(const std::string& pdfPath, bool useLayout,
+                                                    const ProgressCallback& progress, unsigned threadCount)
+{
+    std::vector<std::string> pages = extractPages(pdfPath, useLayout, progress, threadCount);
+    if (pages.size() == 1)
+        return std::move(pages.front());
+
+    // Pages mises bout à bout (chacune se termine déjà par une fin de ligne)
+    size_t total = 0;
+    for (const auto& page : pages)
+        total += page.size();
+
+    std::string text;
+    text.reserve(total);
+    for (auto& page : pages)
+    {
+        text += page;
+        std::string().swap(page);  // Libérée dès qu'elle est recopiée
     }
+    return text;
+}
 
-    OutputDebugStringA("[PopplerExtractor] === Toutes les tentatives pdftotext ont echoue ===\n");
+std::string PopplerPdfExtractor::readWithFallbacks(const std::string& pdfPath, bool useLayout, bool& fromPdfToText,
+                                                   int lastPage)
+{
+    fromPdfToText = false;
 
-    // MÉTHODE 2 : Essayer avec l'API Poppler C++
-    OutputDebugStringA("[PopplerExtractor] === METHODE 2: API Poppler C++ ===\n");
-    if (isPopplerAvailable())
+    // MÉTHODE 2 : pdftotext (utilitaire en ligne de commande de Poppler), lu par un tube
+    debugLog("[PopplerExtractor] === METHODE 2: pdftotext (ligne de commande) ===\n");
     {
-        std::string text = readWithPoppler(pdfPath);
+        std::string text = readWithPdfToText(pdfPath, useLayout, lastPage);
         if (!text.empty())
         {
-            OutputDebugStringA("[PopplerExtractor] ✓ SUCCESS avec API Poppler C++\n");
+            debugLog("[PopplerExtractor] ✓ SUCCESS avec pdftotext (" + pdfToTextPath() + ")\n");
+            fromPdfToText = true;
             return text;
         }
     }
-    else
-    {
-        OutputDebugStringA("[PopplerExtractor] API Poppler C++ non disponible\n");
-    }
 
     // MÉTHODE 3 : Fallback vers fichier .txt existant
-    OutputDebugStringA("[PopplerExtractor] === METHODE 3: Fichier .txt manuel (fallback) ===\n");
-    std::filesystem::path txtPath = std::filesystem::path(pdfPath).replace_extension(".txt");
+    debugLog("[PopplerExtractor] === METHODE 3: Fichier .txt manuel (fallback) ===\n");
+    std::filesystem::path txtPath = std::filesystem::u8path(pdfPath).replace_extension(".txt");
 
-    std::string debugMsg2 = "[PopplerExtractor] Recherche: " + txtPath.string() + "\n";
-    OutputDebugStringA(debugMsg2.c_str());
+    debugLog("[PopplerExtractor] Recherche: " + txtPath.u8string() + "\n");
 
-    if (std::filesystem::exists(txtPath))
+    std::error_code existsError;
+    if (std::filesystem::exists(txtPath, existsError))
     {
-        OutputDebugStringA("[PopplerExtractor] Fichier .txt trouve\n");
+        debugLog("[PopplerExtractor] Fichier .txt trouve\n");
         std::ifstream file(txtPath);
         if (file.is_open())
         {
@@ -284,16 +718,16 @@ std::string PopplerPdfExtractor::extractTextFromPdf(const std::string& pdfPath,
             std::string text = buffer.str();
             if (!text.empty())
             {
-                OutputDebugStringA("[PopplerExtractor] ✓ SUCCESS avec fichier .txt existant\n");
+                debugLog("[PopplerExtractor] ✓ SUCCESS avec fichier .txt existant\n");
                 return text;
             }
         }
     }
     else
     {
-        OutputDebugStringA("[PopplerExtractor] Fichier .txt introuvable\n");
+        debugLog("[PopplerExtractor] Fichier .txt introuvable\n");
     }
 
-    OutputDebugStringA("[PopplerExtractor] === ECHEC: Aucune methode n'a reussi ===\n");
+    debugLog("[PopplerExtractor] === ECHEC: Aucune methode n'a reussi ===\n");
     return "";
 }
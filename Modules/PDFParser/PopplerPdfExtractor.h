@@ -1,20 +1,85 @@
 #pragma once
+#include <functional>
 #include <string>
+#include <vector>
 
 // Classe pour extraire le texte d'un PDF avec Poppler
+//
+// Ordre des méthodes :
+//   1. API Poppler C++ dans le processus (si compilée avec USE_POPPLER), pages réparties
+//      entre plusieurs threads qui ouvrent chacun le document, remises dans l'ordre
+//   2. pdftotext, sortie lue par un tube (aucun fichier temporaire)
+//   3. Fichier .txt de même nom que le PDF (saisi à la main)
+// Le texte des méthodes 1 et 2 est mis en cache sur disque (ExtractionCache) : un PDF déjà
+// extrait avec les mêmes options n'est pas relu.
 class PopplerPdfExtractor
 {
 public:
+    // Avancement de l'extraction (pages terminées, nombre de pages), appelé depuis le thread
+    // appelant après chaque page. Retourner false annule l'extraction.
+    using ProgressCallback = std::function<bool(int pagesDone, int pageCount)>;
+
+    // Page extraite (texte terminé par une fin de ligne, le contenu peut être déplacé), son
+    // indice et le nombre de pages. Retourner false annule l'extraction.
+    using PageCallback = std::function<bool(std::string& page, int pageIndex, int pageCount)>;
+
     // Extrait le texte d'un PDF en utilisant Poppler
-    // Retourne le texte extrait ou une chaîne vide en cas d'erreur
-    // useLayout: si true, utilise l'option -layout de pdftotext (défaut: true)
+    // Retourne le texte extrait ou une chaîne vide en cas d'erreur ou d'annulation
+    // useLayout: si true, conserve la disposition en colonnes (mode physique de Poppler,
+    //            option -layout de pdftotext) (défaut: true)
     //            pour CGR, utiliser false car -layout cause des espaces intercalés
-    static std::string extractTextFromPdf(const std::string& pdfPath, bool useLayout = true);
+    // threadCount: threads d'extraction (0 = un par cœur, jamais plus que de pages)
+    static std::string extractTextFromPdf(const std::string& pdfPath, bool useLayout = true,
+                                          const ProgressCallback& progress = ProgressCallback(),
+                                          unsigned threadCount = 0);
+
+    // Texte page par page, dans l'ordre du document, chaque page terminée par une fin de ligne
+    // (vecteur vide en cas d'erreur ou d'annulation)
+    // Avec pdftotext ou le fichier .txt, tout le texte est rendu en une seule page
+    static std::vector<std::string> extractPages(const std::string& pdfPath, bool useLayout = true,
+                                                 const ProgressCallback& progress = ProgressCallback(),
+                                                 unsigned threadCount = 0);
+
+    // Remet les pages au fil de l'extraction, dans l'ordre du document et sur le thread appelant,
+    // pendant que les threads d'extraction préparent les suivantes (quelques pages d'avance au
+    // plus). Avec pdftotext ou le fichier .txt, tout le texte est remis en une seule page.
+    // Retourne false si rien n'a pu être lu, si l'extraction a été annulée ou interrompue.
+    static bool streamPages(const std::string& pdfPath, bool useLayout, const PageCallback& onPage,
+                            unsigned threadCount = 0);
+
+    // Texte de la première page seulement (détection du fournisseur), chaîne vide en cas d'erreur :
+    // extraction arrêtée après la première page, pdftotext limité à la page 1 (-l 1). Le
+    // texte partiel n'est pas mis en cache, un texte complet déjà en cache est réutilisé.
+    static std::string extractFirstPage(const std::string& pdfPath, bool useLayout = true);
+
+    // Version du texte produit, reprise dans la clé du cache (ExtractionCache) : numéro à
+    // incrémenter quand le texte extrait change (options, mise en page, nettoyage), suivi de la
+    // version de Poppler compilée. Un texte extrait par une autre version n'est pas réutilisé.
+    static constexpr int TEXT_FORMAT_VERSION = 1;
+    static const std::string& extractorVersion();
 
     // Vérifie si Poppler est disponible
     static bool isPopplerAvailable();
 
+    // Chemin de pdftotext, recherché une seule fois par processus (vide si introuvable)
+    static std::string pdfToTextPath();
+
+    // Remplace le pdftotext recherché (outil installé ailleurs, outil simulé des tests) ;
+    // chemin vide : retour à la recherche habituelle
+    static void setPdfToTextPath(const std::string& path);
+
 private:
-    // Charge et lit un PDF avec Poppler
-    static std::string readWithPoppler(const std::string& pdfPath);
+    // Charge et lit un PDF avec l'API Poppler, pages remises à onPage dans l'ordre
+    // Retourne false si le document est illisible, sans texte ou si l'extraction a été annulée ;
+    // delivered indique si des pages ont déjà été remises (pas de repli possible)
+    static bool readWithPoppler(const std::string& pdfPath, bool useLayout, unsigned threadCount,
+                                const PageCallback& onPage, bool& delivered);
+
+    // Méthodes 2 et 3 : texte complet ou chaîne vide (fromPdfToText : rendu par la méthode 2)
+    // lastPage : dernière page demandée à pdftotext (0 = toutes)
+    static std::string readWithFallbacks(const std::string& pdfPath, bool useLayout, bool& fromPdfToText,
+                                         int lastPage = 0);
+
+    // Exécute pdftotext et lit sa sortie standard (lastPage : option -l, 0 = toutes les pages)
+    static std::string readWithPdfToText(const std::string& pdfPath, bool useLayout, int lastPage = 0);
 };
@@ -1,14 +1,56 @@
 #pragma once
 #include "IPdfParser.h"
+#include "LineMatcher.h"
 
 class RexelPdfParser : public IPdfParser
 {
 public:
+    RexelPdfParser();
+
     std::vector<PdfLine> parse(const std::string& filePath) override;
     std::string getSupplierName() const override { return "Rexel"; }
 
+    void beginDocument() override;
+    void parseLine(std::string_view line) override;
+    std::vector<PdfLine> endDocument() override;
+
 private:
-    // Méthodes privées pour le parsing spécifique Rexel
-    std::string extractText(const std::string& filePath);
-    std::vector<PdfLine> parseTextContent(const std::string& text);
+    // Bloc d'un article : lignes de la référence NDX jusqu'à la suivante (exclue) ou jusqu'à
+    // la fin du tableau, éventuellement réparties sur plusieurs pages. Il est analysé en une
+    // passe, ligne par ligne puis mot par mot à mesure qu'il arrive (aucune ligne conservée) ;
+    // finishBlock ajoute l'article trouvé.
+    void startBlock(size_t index, std::string_view reference);
+    void addBlockLine(size_t index, std::string_view line);
+    void addBlockToken(std::string_view token);
+    void finishBlock();
+
+    // Motifs construits une fois par parseur : référence article, prix unitaire
+    RexelRefMatcher refMatcher;
+    DecimalMatcher priceMatcher;
+
+    // Zone du tableau : avant l'en-tête "Référence / Désignation", dedans, après "NC = ..."
+    enum class State { BEFORE_TABLE, IN_TABLE, AFTER_TABLE };
+    State state = State::BEFORE_TABLE;
+    size_t lineIndex = 0;
+    int extractedCount = 0;
+
+    // Bloc en cours. Mots : jusqu'au mot contenant la référence, puis jusqu'au mot "P"
+    // (entiers relevés pour la quantité de secours), puis après "P" (prix unitaire)
+    enum class BlockState { BEFORE_REF_TOKEN, BEFORE_P, AFTER_P };
+    bool inBlock = false;
+    size_t blockStart = 0;              // Indice de sa première ligne dans le texte
+    BlockState blockState = BlockState::BEFORE_REF_TOKEN;
+    PdfLine blockProduct;               // Référence et meilleure désignation trouvées
+    size_t bestDescLine = 0;
+    std::string blockPreview;           // Début du texte du bloc pour les traces
+    std::string lastDigits;             // Deux derniers entiers avant "P"
+    std::string prevDigits;
+    std::string lastTokenTail;          // Chiffres finaux (2 à 6) du dernier mot
+    std::string secondLastTokenTail;    // ... et de l'avant-dernier
+    bool lastTokenAllDigits = false;    // Dernier mot entièrement numérique
+    bool hasDelayQuantity = false;      // Quantité "<qté> <délai> j" trouvée
+    double delayQuantity = 0.0;
+    bool hasPrice = false;
+    double price = 0.0;
+    std::vector<PdfLine> lines;
 };
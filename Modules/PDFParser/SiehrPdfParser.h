@@ -1,14 +1,30 @@
 #pragma once
 #include "IPdfParser.h"
+#include "LineMatcher.h"
 
 class SiehrPdfParser : public IPdfParser
 {
 public:
+    SiehrPdfParser();
+
     std::vector<PdfLine> parse(const std::string& filePath) override;
     std::string getSupplierName() const override { return "Siehr"; }
 
+    void beginDocument() override;
+    void parseLine(std::string_view line) override;
+    std::vector<PdfLine> endDocument() override;
+
 private:
-    // Méthodes privées pour le parsing spécifique Siehr
-    std::string extractText(const std::string& filePath);
-    std::vector<PdfLine> parseTextContent(const std::string& text);
+    // Ajoute l'article en attente de sa ligne complémentaire
+    void flushPending();
+
+    // Motif de la ligne article, construit une fois par parseur (voir le constructeur)
+    PiecLineMatcher lineMatcher;
+
+    // Article trouvé, en attente de la ligne suivante (désignation complémentaire éventuelle,
+    // éventuellement en haut de la page suivante)
+    bool hasPending = false;
+    PdfLine pendingProduct;
+    int extractedCount = 0;
+    std::vector<PdfLine> lines;
 };
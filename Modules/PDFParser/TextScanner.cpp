@@ -0,0 +1,102 @@
+#include "TextScanner.h"
+#include <algorithm>
+
+std::string_view TextScanner::trim(std::string_view s, std::string_view characters)
+{
+    return trimRight(trimLeft(s, characters), characters);
+}
+
+std::string_view TextScanner::trimLeft(std::string_view s, std::string_view characters)
+{
+    const size_t start = s.find_first_not_of(characters);
+    if (start == std::string_view::npos)
+        return std::string_view();
+    return s.substr(start);
+}
+
+std::string_view TextScanner::trimRight(std::string_view s, std::string_view characters)
+{
+    const size_t end = s.find_last_not_of(characters);
+    if (end == std::string_view::npos)
+        return std::string_view();
+    return s.substr(0, end + 1);
+}
+
+size_t TextScanner::findIgnoreCase(std::string_view s, std::string_view needle)
+{
+    if (needle.empty())
+        return 0;
+    if (needle.size() > s.size())
+        return std::string_view::npos;
+
+    // Premier caractère cherché sous ses deux casses, puis comparaison du reste
+    const char lower = toLowerAscii(needle[0]);
+    const char upper = (lower >= 'a' && lower <= 'z') ? static_cast<char>(lower - 'a' + 'A') : lower;
+    const size_t last = s.size() - needle.size();
+    for (size_t i = 0; i <= last; ++i)
+    {
+        if (s[i] != lower && s[i] != upper)
+            continue;
+
+        size_t k = 1;
+        while (k < needle.size() && toLowerAscii(s[i + k]) == toLowerAscii(needle[k]))
+            ++k;
+        if (k == needle.size())
+            return i;
+    }
+    return std::string_view::npos;
+}
+
+bool TextScanner::hasDigit(std::string_view s)
+{
+    return std::any_of(s.begin(), s.end(), [](char c) { return isDigit(c); });
+}
+
+bool TextScanner::hasAlpha(std::string_view s)
+{
+    return std::any_of(s.begin(), s.end(), [](char c) { return isAlpha(c); });
+}
+
+bool TextScanner::allDigits(std::string_view s)
+{
+    return !s.empty() && std::all_of(s.begin(), s.end(), [](char c) { return isDigit(c); });
+}
+
+bool TextScanner::NextLine::operator()(std::string_view& rest, std::string_view& line) const
+{
+    if (rest.empty())
+        return false;
+
+    const size_t newline = rest.find('\n');
+    if (newline == std::string_view::npos)
+    {
+        line = rest;
+        rest = std::string_view();
+    }
+    else
+    {
+        line = rest.substr(0, newline);
+        rest.remove_prefix(newline + 1);
+    }
+    return true;
+}
+
+bool TextScanner::NextToken::operator()(std::string_view& rest, std::string_view& token) const
+{
+    size_t start = 0;
+    while (start < rest.size() && isSpace(rest[start]))
+        ++start;
+    if (start == rest.size())
+    {
+        rest = std::string_view();
+        return false;
+    }
+
+    size_t end = start;
+    while (end < rest.size() && !isSpace(rest[end]))
+        ++end;
+
+    token = rest.substr(start, end - start);
+    rest.remove_prefix(end);
+    return true;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+// Découpage du texte extrait sans copie ni allocation : toutes les fonctions travaillent sur
+// des std::string_view qui pointent dans le tampon d'origine (à ne pas libérer avant d'avoir
+// fini d'utiliser les vues).
+//
+//   for (std::string_view line : TextScanner::lines(text))        // comme std::getline
+//       for (std::string_view token : TextScanner::tokens(line))  // comme iss >> tok
+class TextScanner
+{
+public:
+    // Caractères enlevés par trim (ceux des anciens helpers trim des parseurs)
+    static constexpr std::string_view TRIM_CHARACTERS = " \t\r\n";
+
+    // Séparateurs de mots : ceux de std::isspace (locale "C"), comme l'extraction >> d'un flux
+    static bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
+
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    // Lettre ASCII (comme std::isalpha en locale "C")
+    static bool isAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+
+    static char toLowerAscii(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+    // Enlève les caractères donnés en début et/ou fin
+    static std::string_view trim(std::string_view s, std::string_view characters = TRIM_CHARACTERS);
+    static std::string_view trimLeft(std::string_view s, std::string_view characters = TRIM_CHARACTERS);
+    static std::string_view trimRight(std::string_view s, std::string_view characters = TRIM_CHARACTERS);
+
+    static bool startsWith(std::string_view s, std::string_view prefix)
+    {
+        return s.size() >= prefix.size() && s.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    static bool contains(std::string_view s, std::string_view needle)
+    {
+        return s.find(needle) != std::string_view::npos;
+    }
+
+    // Recherche sans tenir compte de la casse des lettres ASCII (les octets UTF-8 des lettres
+    // accentuées sont comparés tels quels, comme avec std::tolower en locale "C")
+    // Retourne la position ou std::string_view::npos
+    static size_t findIgnoreCase(std::string_view s, std::string_view needle);
+
+    static bool containsIgnoreCase(std::string_view s, std::string_view needle)
+    {
+        return findIgnoreCase(s, needle) != std::string_view::npos;
+    }
+
+    static bool hasDigit(std::string_view s);
+    static bool hasAlpha(std::string_view s);
+    static bool allDigits(std::string_view s);  // Non vide et uniquement des chiffres
+
+    // Suite de vues (lignes ou mots) parcourue par un itérateur avant
+    template <typename Next>
+    class Range
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view*;
+            using reference = const std::string_view&;
+
+            iterator() = default;
+            explicit iterator(std::string_view rest) : rest(rest), done(false) { ++*this; }
+
+            reference operator*() const { return current; }
+            pointer operator->() const { return &current; }
+            iterator& operator++() { done = !Next()(rest, current); return *this; }
+            bool operator==(const iterator& other) const { return done && other.done; }
+            bool operator!=(const iterator& other) const { return !(*this == other); }
+
+        private:
+            std::string_view rest;
+            std::string_view current;
+            bool done = true;
+        };
+
+        explicit Range(std::string_view text) : text(text) {}
+        iterator begin() const { return iterator(text); }
+        iterator end() const { return iterator(); }
+
+    private:
+        std::string_view text;
+    };
+
+    // Prochaine ligne de rest (sans '\n') ; false à la fin. Une fin de ligne finale ne donne pas
+    // de ligne vide supplémentaire (même découpage que std::getline).
+    struct NextLine
+    {
+        bool operator()(std::string_view& rest, std::string_view& line) const;
+    };
+
+    // Prochain mot de rest (suite de caractères sans espace) ; false s'il n'y en a plus
+    struct NextToken
+    {
+        bool operator()(std::string_view& rest, std::string_view& token) const;
+    };
+
+    static Range<NextLine> lines(std::string_view text) { return Range<NextLine>(text); }
+    static Range<NextToken> tokens(std::string_view text) { return Range<NextToken>(text); }
+};
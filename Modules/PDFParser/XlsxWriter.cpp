@@ -1,10 +1,14 @@
 #include "XlsxWriter.h"
+#include "DebugLog.h"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <cstdlib>
 #include <ctime>
+#include <string_view>
 #include <windows.h>
 
 // Inclure minizip si disponible
@@ -19,7 +23,7 @@ static bool createZipFromDirectory(const std::string& zipPath, const std::filesy
     zipFile zf = zipOpen(zipPath.c_str(), APPEND_STATUS_CREATE);
     if (zf == nullptr)
     {
-        OutputDebugStringA("[XlsxWriter] ERREUR: Impossible de créer le fichier ZIP\n");
+        debugLog("[XlsxWriter] ERREUR: Impossible de créer le fichier ZIP\n");
         return false;
     }
 
@@ -76,6 +80,16 @@ static bool createZipFromDirectory(const std::string& zipPath, const std::filesy
 }
 #endif
 
+// Dossier de travail propre à chaque appel : plusieurs classeurs peuvent être écrits en même
+// temps (conversion par lots), dans la même seconde et par plusieurs processus
+static std::filesystem::path uniqueTempDirectory(const std::string& prefix)
+{
+    static std::atomic<unsigned> counter(0);
+    return std::filesystem::temp_directory_path() /
+           (prefix + std::to_string(std::time(nullptr)) + "_" + std::to_string(GetCurrentProcessId()) +
+            "_" + std::to_string(counter++));
+}
+
 // Fonction helper pour exécuter une commande sans afficher de fenêtre
 static int executeCommandSilent(const std::string& command)
 {
@@ -120,6 +134,64 @@ static int executeCommandSilent(const std::string& command)
     return static_cast<int>(exitCode);
 }
 
+// Compresse le dossier de travail en fichier XLSX (minizip, sinon PowerShell)
+static bool zipDirectoryToXlsx(const std::filesystem::path& tempDir, const std::filesystem::path& absOutputPath)
+{
+    bool success = false;
+
+#ifdef USE_MINIZIP
+    // MÉTHODE 1 : Essayer minizip (natif C++, toujours fiable)
+    debugLog("[XlsxWriter] Tentative de création ZIP avec minizip...\n");
+    if (createZipFromDirectory(absOutputPath.string(), tempDir))
+    {
+        success = std::filesystem::exists(absOutputPath);
+        if (success)
+        {
+            debugLog("[XlsxWriter] Fichier XLSX créé avec succès via minizip\n");
+        }
+    }
+    else
+    {
+        debugLog("[XlsxWriter] ERREUR: minizip a échoué\n");
+    }
+#endif
+
+    // MÉTHODE 2 : Essayer PowerShell si minizip n'a pas marché
+    if (!success)
+    {
+        debugLog("[XlsxWriter] Tentative avec PowerShell...\n");
+
+        // Construire la commande PowerShell avec échappement correct
+        std::string tempDirStr = tempDir.string();
+        std::string outputPathStr = absOutputPath.string();
+
+        // Remplacer les backslashes par des forward slashes pour PowerShell
+        std::replace(tempDirStr.begin(), tempDirStr.end(), '\\', '/');
+        std::replace(outputPathStr.begin(), outputPathStr.end(), '\\', '/');
+
+        std::string powershellCmd = "powershell -NoProfile -ExecutionPolicy Bypass -Command \"Compress-Archive -Path '" +
+            tempDirStr + "/*' -DestinationPath '" +
+            outputPathStr + "' -Force\"";
+
+        debugLog("[XlsxWriter] Commande ZIP : " + powershellCmd + "\n");
+
+        // Exécuter PowerShell sans afficher de fenêtre
+        int result = executeCommandSilent(powershellCmd);
+
+        debugLog("[XlsxWriter] Résultat ZIP : " + std::to_string(result) + "\n");
+
+        // Vérifier si le fichier a bien été créé
+        success = (result == 0) && std::filesystem::exists(absOutputPath);
+
+        if (success)
+        {
+            debugLog("[XlsxWriter] Fichier XLSX créé avec succès via PowerShell\n");
+        }
+    }
+
+    return success;
+}
+
 std::string XlsxWriter::escapeXml(const std::string& str)
 {
     std::string result;
@@ -272,12 +344,12 @@ bool XlsxWriter::writeToXlsx(const std::string& outputPath, const std::vector<Pd
     {
         // Debug: log de démarrage
         std::string debugMsg = "[XlsxWriter] Début de génération XLSX : " + outputPath + "\n";
-        OutputDebugStringA(debugMsg.c_str());
+        debugLog(debugMsg);
 
         // Créer un dossier temporaire
-        std::filesystem::path tempDir = std::filesystem::temp_directory_path() / ("xlsx_" + std::to_string(std::time(nullptr)));
+        std::filesystem::path tempDir = uniqueTempDirectory("xlsx_");
 
-        OutputDebugStringA(("[XlsxWriter] Dossier temporaire : " + tempDir.string() + "\n").c_str());
+        debugLog("[XlsxWriter] Dossier temporaire : " + tempDir.string() + "\n");
 
         std::filesystem::create_directories(tempDir);
         std::filesystem::create_directories(tempDir / "_rels");
@@ -285,7 +357,7 @@ bool XlsxWriter::writeToXlsx(const std::string& outputPath, const std::vector<Pd
         std::filesystem::create_directories(tempDir / "xl" / "_rels");
         std::filesystem::create_directories(tempDir / "xl" / "worksheets");
 
-        OutputDebugStringA("[XlsxWriter] Dossiers créés\n");
+        debugLog("[XlsxWriter] Dossiers créés\n");
 
         // Écrire tous les fichiers XML
         auto writeFile = [](const std::filesystem::path& path, const std::string& content) {
@@ -298,107 +370,57 @@ bool XlsxWriter::writeToXlsx(const std::string& outputPath, const std::vector<Pd
 
         if (!writeFile(tempDir / "[Content_Types].xml", generateContentTypesXml()))
         {
-            OutputDebugStringA("[XlsxWriter] ERREUR: Échec écriture [Content_Types].xml\n");
+            debugLog("[XlsxWriter] ERREUR: Échec écriture [Content_Types].xml\n");
             return false;
         }
         if (!writeFile(tempDir / "_rels" / ".rels", generateRelsXml()))
         {
-            OutputDebugStringA("[XlsxWriter] ERREUR: Échec écriture _rels/.rels\n");
+            debugLog("[XlsxWriter] ERREUR: Échec écriture _rels/.rels\n");
             return false;
         }
         if (!writeFile(tempDir / "xl" / "workbook.xml", generateWorkbookXml()))
         {
-            OutputDebugStringA("[XlsxWriter] ERREUR: Échec écriture workbook.xml\n");
+            debugLog("[XlsxWriter] ERREUR: Échec écriture workbook.xml\n");
             return false;
         }
         if (!writeFile(tempDir / "xl" / "_rels" / "workbook.xml.rels", generateWorkbookRelsXml()))
         {
-            OutputDebugStringA("[XlsxWriter] ERREUR: Échec écriture workbook.xml.rels\n");
+            debugLog("[XlsxWriter] ERREUR: Échec écriture workbook.xml.rels\n");
             return false;
         }
         if (!writeFile(tempDir / "xl" / "styles.xml", generateStylesXml()))
         {
-            OutputDebugStringA("[XlsxWriter] ERREUR: Échec écriture styles.xml\n");
+            debugLog("[XlsxWriter] ERREUR: Échec écriture styles.xml\n");
             return false;
         }
         if (!writeFile(tempDir / "xl" / "sharedStrings.xml", generateSharedStringsXml(lines)))
         {
-            OutputDebugStringA("[XlsxWriter] ERREUR: Échec écriture sharedStrings.xml\n");
+            debugLog("[XlsxWriter] ERREUR: Échec écriture sharedStrings.xml\n");
             return false;
         }
         if (!writeFile(tempDir / "xl" / "worksheets" / "sheet1.xml", generateSheetXml(lines)))
         {
-            OutputDebugStringA("[XlsxWriter] ERREUR: Échec écriture sheet1.xml\n");
+            debugLog("[XlsxWriter] ERREUR: Échec écriture sheet1.xml\n");
             return false;
         }
 
-        OutputDebugStringA("[XlsxWriter] Tous les fichiers XML écrits\n");
+        debugLog("[XlsxWriter] Tous les fichiers XML écrits\n");
 
         // Créer le ZIP
-        std::filesystem::path absOutputPath = std::filesystem::absolute(outputPath);
+        std::filesystem::path absOutputPath = std::filesystem::absolute(std::filesystem::u8path(outputPath));
 
         // Supprimer le fichier de sortie s'il existe déjà
         if (std::filesystem::exists(absOutputPath))
         {
-            OutputDebugStringA("[XlsxWriter] Suppression du fichier existant\n");
+            debugLog("[XlsxWriter] Suppression du fichier existant\n");
             std::filesystem::remove(absOutputPath);
         }
 
-        bool success = false;
-
-#ifdef USE_MINIZIP
-        // MÉTHODE 1 : Essayer minizip (natif C++, toujours fiable)
-        OutputDebugStringA("[XlsxWriter] Tentative de création ZIP avec minizip...\n");
-        if (createZipFromDirectory(absOutputPath.string(), tempDir))
-        {
-            success = std::filesystem::exists(absOutputPath);
-            if (success)
-            {
-                OutputDebugStringA("[XlsxWriter] Fichier XLSX créé avec succès via minizip\n");
-            }
-        }
-        else
-        {
-            OutputDebugStringA("[XlsxWriter] ERREUR: minizip a échoué\n");
-        }
-#endif
-
-        // MÉTHODE 2 : Essayer PowerShell si minizip n'a pas marché
-        if (!success)
-        {
-            OutputDebugStringA("[XlsxWriter] Tentative avec PowerShell...\n");
-
-            // Construire la commande PowerShell avec échappement correct
-            std::string tempDirStr = tempDir.string();
-            std::string outputPathStr = absOutputPath.string();
-
-            // Remplacer les backslashes par des forward slashes pour PowerShell
-            std::replace(tempDirStr.begin(), tempDirStr.end(), '\\', '/');
-            std::replace(outputPathStr.begin(), outputPathStr.end(), '\\', '/');
-
-            std::string powershellCmd = "powershell -NoProfile -ExecutionPolicy Bypass -Command \"Compress-Archive -Path '" +
-                tempDirStr + "/*' -DestinationPath '" +
-                outputPathStr + "' -Force\"";
-
-            OutputDebugStringA(("[XlsxWriter] Commande ZIP : " + powershellCmd + "\n").c_str());
-
-            // Exécuter PowerShell sans afficher de fenêtre
-            int result = executeCommandSilent(powershellCmd);
-
-            OutputDebugStringA(("[XlsxWriter] Résultat ZIP : " + std::to_string(result) + "\n").c_str());
-
-            // Vérifier si le fichier a bien été créé
-            success = (result == 0) && std::filesystem::exists(absOutputPath);
-
-            if (success)
-            {
-                OutputDebugStringA("[XlsxWriter] Fichier XLSX créé avec succès via PowerShell\n");
-            }
-        }
+        bool success = zipDirectoryToXlsx(tempDir, absOutputPath);
 
         if (!success)
         {
-            OutputDebugStringA("[XlsxWriter] ERREUR: Fichier ZIP non créé, utilisation du fallback SpreadsheetML\n");
+            debugLog("[XlsxWriter] ERREUR: Fichier ZIP non créé, utilisation du fallback SpreadsheetML\n");
 
             // FALLBACK: Utiliser le format SpreadsheetML (Excel 2003)
             // Ce format est plus simple et ne nécessite pas de ZIP
@@ -415,32 +437,32 @@ bool XlsxWriter::writeToXlsx(const std::string& outputPath, const std::vector<Pd
                     file << xmlContent;
                     file.close();
                     success = true;
-                    OutputDebugStringA(("[XlsxWriter] Fallback SpreadsheetML réussi : " + xmlOutputPath.string() + "\n").c_str());
+                    debugLog("[XlsxWriter] Fallback SpreadsheetML réussi : " + xmlOutputPath.string() + "\n");
                 }
                 else
                 {
-                    OutputDebugStringA("[XlsxWriter] ERREUR: Impossible d'écrire le fichier de fallback\n");
+                    debugLog("[XlsxWriter] ERREUR: Impossible d'écrire le fichier de fallback\n");
                 }
             }
             catch (const std::exception& e)
             {
-                OutputDebugStringA(("[XlsxWriter] ERREUR fallback: " + std::string(e.what()) + "\n").c_str());
+                debugLog("[XlsxWriter] ERREUR fallback: " + std::string(e.what()) + "\n");
             }
         }
         else
         {
-            OutputDebugStringA("[XlsxWriter] Fichier ZIP créé avec succès\n");
+            debugLog("[XlsxWriter] Fichier ZIP créé avec succès\n");
         }
 
         // Nettoyer le dossier temporaire
         try
         {
             std::filesystem::remove_all(tempDir);
-            OutputDebugStringA("[XlsxWriter] Dossier temporaire supprimé\n");
+            debugLog("[XlsxWriter] Dossier temporaire supprimé\n");
         }
         catch (...)
         {
-            OutputDebugStringA("[XlsxWriter] ATTENTION: Échec suppression dossier temporaire\n");
+            debugLog("[XlsxWriter] ATTENTION: Échec suppression dossier temporaire\n");
         }
 
         return success;
@@ -448,12 +470,12 @@ bool XlsxWriter::writeToXlsx(const std::string& outputPath, const std::vector<Pd
     catch (const std::exception& e)
     {
         std::string errorMsg = "[XlsxWriter] EXCEPTION: " + std::string(e.what()) + "\n";
-        OutputDebugStringA(errorMsg.c_str());
+        debugLog(errorMsg);
         return false;
     }
     catch (...)
     {
-        OutputDebugStringA("[XlsxWriter] EXCEPTION inconnue\n");
+        debugLog("[XlsxWriter] EXCEPTION inconnue\n");
         return false;
     }
 }
@@ -511,3 +533,248 @@ std::string XlsxWriter::generateSpreadsheetML(const std::vector<PdfLine>& lines)
 
     return oss.str();
 }
+
+std::string XlsxWriter::columnName(size_t index)
+{
+    std::string name;
+    size_t n = index + 1;
+    while (n > 0)
+    {
+        name.insert(name.begin(), static_cast<char>('A' + (n - 1) % 26));
+        n = (n - 1) / 26;
+    }
+    return name;
+}
+
+// Limite Excel de la longueur d'un nom d'onglet (en unités UTF-16) et caractères interdits
+static constexpr size_t MAX_SHEET_NAME_LENGTH = 31;
+static constexpr std::string_view FORBIDDEN_SHEET_NAME_CHARACTERS = ":\\/?*[]";
+
+// Tronque un texte UTF-8 à maxUnits unités UTF-16, sans couper de caractère
+static std::string truncateUtf8(const std::string& text, size_t maxUnits)
+{
+    size_t units = 0;
+    size_t i = 0;
+    while (i < text.size())
+    {
+        const unsigned char lead = static_cast<unsigned char>(text[i]);
+        const size_t bytes = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : 4;
+        const size_t width = bytes == 4 ? 2 : 1;  // Hors plan de base : paire de substitution
+        if (units + width > maxUnits || i + bytes > text.size())
+            break;
+        units += width;
+        i += bytes;
+    }
+    return text.substr(0, i);
+}
+
+static std::string toLowerAsciiCopy(std::string text)
+{
+    for (char& c : text)
+    {
+        if (c >= 'A' && c <= 'Z')
+            c = static_cast<char>(c - 'A' + 'a');
+    }
+    return text;
+}
+
+std::vector<std::string> XlsxWriter::sheetNames(const std::vector<XlsxSheet>& sheets)
+{
+    std::vector<std::string> names;
+    std::vector<std::string> used;  // Noms déjà pris, en minuscules (Excel ignore la casse)
+    names.reserve(sheets.size());
+
+    for (size_t i = 0; i < sheets.size(); ++i)
+    {
+        std::string base = sheets[i].name;
+        for (char& c : base)
+        {
+            if (FORBIDDEN_SHEET_NAME_CHARACTERS.find(c) != std::string_view::npos)
+                c = '_';
+        }
+        // Une apostrophe ne peut ni commencer ni terminer le nom
+        while (!base.empty() && base.front() == '\'')
+            base.erase(base.begin());
+        while (!base.empty() && base.back() == '\'')
+            base.pop_back();
+        if (base.empty())
+            base = "Feuille" + std::to_string(i + 1);
+
+        std::string name = truncateUtf8(base, MAX_SHEET_NAME_LENGTH);
+        for (int suffix = 2; std::find(used.begin(), used.end(), toLowerAsciiCopy(name)) != used.end(); ++suffix)
+        {
+            const std::string tag = "~" + std::to_string(suffix);
+            name = truncateUtf8(base, MAX_SHEET_NAME_LENGTH - tag.size()) + tag;
+        }
+
+        used.push_back(toLowerAsciiCopy(name));
+        names.push_back(name);
+    }
+    return names;
+}
+
+std::string XlsxWriter::generateContentTypesXml(size_t sheetCount)
+{
+    std::ostringstream oss;
+    oss << R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Types xmlns="http://schemas.openxmlformats.org/package/2006/content-types">
+<Default Extension="rels" ContentType="application/vnd.openxmlformats-package.relationships+xml"/>
+<Default Extension="xml" ContentType="application/xml"/>
+<Override PartName="/xl/workbook.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml"/>
+)";
+    for (size_t i = 1; i <= sheetCount; ++i)
+    {
+        oss << "<Override PartName=\"/xl/worksheets/sheet" << i
+            << ".xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml\"/>\n";
+    }
+    oss << R"(<Override PartName="/xl/styles.xml" ContentType="application/vnd.openxmlformats-officedocument.spreadsheetml.styles+xml"/>
+</Types>)";
+    return oss.str();
+}
+
+std::string XlsxWriter::generateWorkbookXml(const std::vector<XlsxSheet>& sheets)
+{
+    std::ostringstream oss;
+    oss << R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<workbook xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main" xmlns:r="http://schemas.openxmlformats.org/officeDocument/2006/relationships">
+<sheets>
+)";
+    const std::vector<std::string> names = sheetNames(sheets);
+    for (size_t i = 0; i < sheets.size(); ++i)
+    {
+        oss << "<sheet name=\"" << escapeXml(names[i]) << "\" sheetId=\"" << (i + 1)
+            << "\" r:id=\"rId" << (i + 1) << "\"/>\n";
+    }
+    oss << R"(</sheets>
+</workbook>)";
+    return oss.str();
+}
+
+std::string XlsxWriter::generateWorkbookRelsXml(size_t sheetCount)
+{
+    std::ostringstream oss;
+    oss << R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<Relationships xmlns="http://schemas.openxmlformats.org/package/2006/relationships">
+)";
+    for (size_t i = 1; i <= sheetCount; ++i)
+    {
+        oss << "<Relationship Id=\"rId" << i
+            << "\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet\" Target=\"worksheets/sheet"
+            << i << ".xml\"/>\n";
+    }
+    oss << "<Relationship Id=\"rId" << (sheetCount + 1)
+        << R"(" Type="http://schemas.openxmlformats.org/officeDocument/2006/relationships/styles" Target="styles.xml"/>
+</Relationships>)";
+    return oss.str();
+}
+
+std::string XlsxWriter::generateSheetXml(const XlsxSheet& sheet)
+{
+    // Chaînes en ligne (inlineStr) : pas de sharedStrings.xml pour les en-têtes
+    std::ostringstream oss;
+    oss << R"(<?xml version="1.0" encoding="UTF-8" standalone="yes"?>
+<worksheet xmlns="http://schemas.openxmlformats.org/spreadsheetml/2006/main">
+<sheetData>
+)";
+
+    oss << "<row r=\"1\">\n";
+    for (size_t c = 0; c < sheet.headers.size(); ++c)
+    {
+        oss << "<c r=\"" << columnName(c) << "1\" s=\"1\" t=\"inlineStr\"><is><t>"
+            << escapeXml(sheet.headers[c]) << "</t></is></c>\n";
+    }
+    oss << "</row>\n";
+
+    oss << std::setprecision(10);
+    size_t rowIdx = 2;
+    for (const auto& row : sheet.rows)
+    {
+        oss << "<row r=\"" << rowIdx << "\">";
+        for (size_t c = 0; c < row.size(); ++c)
+        {
+            oss << "<c r=\"" << columnName(c) << rowIdx << "\"><v>" << row[c] << "</v></c>";
+        }
+        oss << "</row>\n";
+        rowIdx++;
+    }
+
+    oss << R"(</sheetData>
+</worksheet>)";
+    return oss.str();
+}
+
+bool XlsxWriter::writeSheetsToXlsx(const std::string& outputPath, const std::vector<XlsxSheet>& sheets)
+{
+    // Limite Excel : 1 048 576 lignes par feuille (en-tête compris)
+    if (sheets.empty())
+    {
+        return false;
+    }
+    for (const auto& sheet : sheets)
+    {
+        if (sheet.rows.size() + 1 > 1048576)
+        {
+            debugLog("[XlsxWriter] ERREUR: Trop de lignes dans la feuille " + sheet.name + "\n");
+            return false;
+        }
+    }
+
+    try
+    {
+        debugLog("[XlsxWriter] Début de génération XLSX multi-feuilles : " + outputPath + "\n");
+
+        std::filesystem::path tempDir = uniqueTempDirectory("xlsx_sheets_");
+        std::filesystem::create_directories(tempDir / "_rels");
+        std::filesystem::create_directories(tempDir / "xl" / "_rels");
+        std::filesystem::create_directories(tempDir / "xl" / "worksheets");
+
+        auto writeFile = [](const std::filesystem::path& path, const std::string& content) {
+            std::ofstream file(path, std::ios::binary);
+            if (!file.is_open()) return false;
+            file << content;
+            return file.good();
+        };
+
+        bool written = writeFile(tempDir / "[Content_Types].xml", generateContentTypesXml(sheets.size()))
+                    && writeFile(tempDir / "_rels" / ".rels", generateRelsXml())
+                    && writeFile(tempDir / "xl" / "workbook.xml", generateWorkbookXml(sheets))
+                    && writeFile(tempDir / "xl" / "_rels" / "workbook.xml.rels", generateWorkbookRelsXml(sheets.size()))
+                    && writeFile(tempDir / "xl" / "styles.xml", generateStylesXml());
+        for (size_t i = 0; written && i < sheets.size(); ++i)
+        {
+            written = writeFile(tempDir / "xl" / "worksheets" / ("sheet" + std::to_string(i + 1) + ".xml"),
+                                generateSheetXml(sheets[i]));
+        }
+
+        bool success = false;
+        if (written)
+        {
+            std::filesystem::path absOutputPath = std::filesystem::absolute(std::filesystem::u8path(outputPath));
+            if (std::filesystem::exists(absOutputPath))
+            {
+                std::filesystem::remove(absOutputPath);
+            }
+            success = zipDirectoryToXlsx(tempDir, absOutputPath);
+        }
+        else
+        {
+            debugLog("[XlsxWriter] ERREUR: Échec écriture des fichiers XML\n");
+        }
+
+        try
+        {
+            std::filesystem::remove_all(tempDir);
+        }
+        catch (...)
+        {
+            debugLog("[XlsxWriter] ATTENTION: Échec suppression dossier temporaire\n");
+        }
+
+        return success;
+    }
+    catch (const std::exception& e)
+    {
+        debugLog("[XlsxWriter] EXCEPTION: " + std::string(e.what()) + "\n");
+        return false;
+    }
+}
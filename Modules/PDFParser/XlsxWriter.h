@@ -3,6 +3,14 @@
 #include <string>
 #include <vector>
 
+// Feuille numérique générique (une ligne d'en-têtes puis des lignes de valeurs)
+struct XlsxSheet
+{
+    std::string name;                          // Nom de l'onglet (voir XlsxWriter::sheetNames)
+    std::vector<std::string> headers;          // En-têtes de colonnes
+    std::vector<std::vector<double>> rows;     // Valeurs, une entrée par ligne
+};
+
 // Classe pour écrire les données dans un vrai fichier XLSX (format Office Open XML)
 class XlsxWriter
 {
@@ -14,6 +22,18 @@ public:
         const std::vector<PdfLine>& lines
     );
 
+    // Écrit un classeur de plusieurs feuilles numériques (abaques, tableaux de résultats)
+    // Retourne true si succès, false si erreur
+    static bool writeSheetsToXlsx(
+        const std::string& outputPath,
+        const std::vector<XlsxSheet>& sheets
+    );
+
+    // Noms d'onglets acceptés par Excel, dans l'ordre des feuilles : caractères interdits
+    // (: \ / ? * [ ]) remplacés par '_', 31 caractères au plus, nom vide remplacé par
+    // "Feuille<n>", noms rendus uniques sans tenir compte de la casse ("Nom~2", "Nom~3"...)
+    static std::vector<std::string> sheetNames(const std::vector<XlsxSheet>& sheets);
+
 private:
     // Génère le contenu sheet1.xml (feuille de calcul principale)
     static std::string generateSheetXml(const std::vector<PdfLine>& lines);
@@ -39,6 +59,15 @@ private:
     // Génère un fichier SpreadsheetML (fallback si ZIP échoue)
     static std::string generateSpreadsheetML(const std::vector<PdfLine>& lines);
 
+    // Variantes multi-feuilles pour writeSheetsToXlsx
+    static std::string generateSheetXml(const XlsxSheet& sheet);
+    static std::string generateWorkbookXml(const std::vector<XlsxSheet>& sheets);
+    static std::string generateContentTypesXml(size_t sheetCount);
+    static std::string generateWorkbookRelsXml(size_t sheetCount);
+
+    // Nom de colonne Excel (0 → A, 25 → Z, 26 → AA)
+    static std::string columnName(size_t index);
+
     // Échappe les caractères spéciaux XML
     static std::string escapeXml(const std::string& str);
 };
@@ -0,0 +1,370 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/CalculationCache.h"
+#include "../../Modules/HydraulicCalculations/FixtureCatalogue.h"
+#include "../../Modules/HydraulicCalculations/PipeCatalogue.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    // Colonne et trois antennes, pression insuffisante aux appareils (diagnostics enregistrés) ;
+    // length modifie la colonne (réseaux distincts)
+    NetworkCalculationParameters cacheNetwork(double length = 12.0)
+    {
+        NetworkCalculationParameters params;
+        params.supplyPressure = 1.0;
+        NetworkSegment riser("colonne", "Colonne");
+        riser.length = length;
+        riser.heightDifference = 3.0;
+        params.segments.push_back(riser);
+
+        const FixtureType types[] = { FixtureType::Shower, FixtureType::Sink, FixtureType::WC };
+        for (int i = 0; i < 3; ++i)
+        {
+            NetworkSegment branch("antenne" + std::to_string(i), "Antenne " + std::to_string(i));
+            branch.parentId = "colonne";
+            branch.length = 4.0 + 3.0 * i;
+            branch.fixtures.push_back(Fixture(types[i], 1 + i));
+            branch.fixtures.push_back(Fixture(FixtureType::WashBasin, 1));
+            params.segments.push_back(branch);
+        }
+        return params;
+    }
+
+    // Dossier de cache temporaire, supprimé à la fin du test
+    struct TemporaryDirectory
+    {
+        std::filesystem::path path;
+
+        explicit TemporaryDirectory(const std::string& name)
+            : path(std::filesystem::temp_directory_path() / name)
+        {
+            std::filesystem::remove_all(path);
+        }
+        ~TemporaryDirectory()
+        {
+            std::error_code ignored;
+            std::filesystem::remove_all(path, ignored);
+        }
+        std::string string() const { return path.u8string(); }
+    };
+
+    std::vector<std::filesystem::path> cacheFiles(const std::filesystem::path& directory)
+    {
+        std::vector<std::filesystem::path> files;
+        std::error_code error;
+        for (const auto& item : std::filesystem::recursive_directory_iterator(directory, error))
+        {
+            if (item.path().extension() == ".tchc")
+                files.push_back(item.path());
+        }
+        return files;
+    }
+
+    std::string readFile(const std::filesystem::path& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const std::filesystem::path& path, const std::string& content)
+    {
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+    }
+
+    const NetworkSegment& segmentById(const NetworkCalculationParameters& params, const std::string& id)
+    {
+        for (const NetworkSegment& segment : params.segments)
+        {
+            if (segment.id == id)
+                return segment;
+        }
+        return params.segments.front();
+    }
+
+    // Série active du matériau rétablie à la fin du test (catalogue partagé)
+    struct ActiveSeriesGuard
+    {
+        PipeMaterial material;
+        size_t saved;
+
+        explicit ActiveSeriesGuard(PipeMaterial m) : material(m), saved(0)
+        {
+            const PipeCatalogue& catalogue = PipeCatalogue::instance();
+            for (size_t i = 0; i < catalogue.getAllSeries().size(); ++i)
+            {
+                if (&catalogue.getAllSeries()[i] == &catalogue.getSeries(material))
+                    saved = i;
+            }
+        }
+        ~ActiveSeriesGuard() { PipeCatalogue::instance().setActiveSeries(material, saved); }
+    };
+}
+
+// Ordre de saisie des tronçons et noms hors clé : même entrée, résultats reportés sur chaque
+// tronçon par identifiant ; compteurs mémoire
+TEST(CalculationCache_HitsAfterReorderingSegments)
+{
+    CalculationCache cache;
+    PipeCalculator calculator;
+    calculator.setResultCache(&cache);
+
+    NetworkCalculationParameters first = cacheNetwork();
+    calculator.calculateNetwork(first);
+    CacheStatistics stats = cache.statistics();
+    CHECK_EQUAL(stats.misses, std::uint64_t(1));
+    CHECK_EQUAL(stats.memoryHits, std::uint64_t(0));
+    CHECK_EQUAL(stats.entries, size_t(1));
+    CHECK(stats.bytes > 0);
+
+    NetworkCalculationParameters reordered = cacheNetwork();
+    std::reverse(reordered.segments.begin(), reordered.segments.end());
+    std::reverse(reordered.segments[0].fixtures.begin(), reordered.segments[0].fixtures.end());
+    reordered.segments[1].name = "Autre nom";
+    CHECK(cache.lookup(reordered));
+    CHECK_EQUAL(cache.statistics().memoryHits, std::uint64_t(1));
+
+    for (const NetworkSegment& segment : reordered.segments)
+    {
+        const NetworkSegment& expected = segmentById(first, segment.id);
+        CHECK_EQUAL(segment.result.nominalDiameter, expected.result.nominalDiameter);
+        CHECK_EQUAL(segment.result.flowRate, expected.result.flowRate);
+        CHECK_EQUAL(segment.inletPressure, expected.inletPressure);
+        CHECK_EQUAL(segment.outletPressure, expected.outletPressure);
+        CHECK_EQUAL(int(segment.result.diagnostics.getMask()), int(expected.result.diagnostics.getMask()));
+    }
+    CHECK_EQUAL(reordered.loopLength, first.loopLength);
+
+    // Même résultat qu'un calcul sans cache du réseau réordonné
+    NetworkCalculationParameters direct = cacheNetwork();
+    std::reverse(direct.segments.begin(), direct.segments.end());
+    PipeCalculator().calculateNetwork(direct);
+    for (size_t i = 0; i < direct.segments.size(); ++i)
+        CHECK_NEAR(reordered.segments[i].outletPressure, direct.segments[i].outletPressure, 1e-12);
+
+    cache.clear();
+    stats = cache.statistics();
+    CHECK_EQUAL(stats.memoryHits, std::uint64_t(0));
+    CHECK_EQUAL(stats.misses, std::uint64_t(0));
+    CHECK_EQUAL(stats.entries, size_t(0));
+    CHECK_EQUAL(stats.bytes, size_t(0));
+    CHECK(!cache.lookup(reordered));
+}
+
+// Données lues par le calcul hors des paramètres du réseau : débit unitaire d'un appareil,
+// série de tubes active ; une donnée du réseau modifiée (quantité d'appareils) aussi
+TEST(CalculationCache_MissesAfterCatalogueChanges)
+{
+    CalculationCache cache;
+    PipeCalculator calculator;
+    calculator.setResultCache(&cache);
+
+    NetworkCalculationParameters params = cacheNetwork();
+    calculator.calculateNetwork(params);
+    NetworkCalculationParameters again = cacheNetwork();
+    CHECK(cache.lookup(again));
+
+    // Débit unitaire de la douche
+    FixtureCatalogue& fixtures = FixtureCatalogue::instance();
+    const double showerFlowRate = fixtures.flowRate(FixtureType::Shower);
+    fixtures.setFlowRate(FixtureType::Shower, showerFlowRate + 3.0);
+    NetworkCalculationParameters changedFlow = cacheNetwork();
+    CHECK(!cache.lookup(changedFlow));
+    calculator.calculateNetwork(changedFlow);
+    CHECK(segmentById(changedFlow, "antenne0").result.flowRate > segmentById(params, "antenne0").result.flowRate);
+    fixtures.resetToDefaults();
+    NetworkCalculationParameters restored = cacheNetwork();
+    CHECK(cache.lookup(restored));
+    CHECK_EQUAL(segmentById(restored, "antenne0").result.flowRate, segmentById(params, "antenne0").result.flowRate);
+
+    // Série active du cuivre remplacée par une série fabricant
+    {
+        ActiveSeriesGuard guard(PipeMaterial::Copper);
+        const std::string path = "calculation_cache_series.csv";
+        writeFile(path, "Série;Matériau;Rugosité (mm);DN;D int (mm)\n"
+                        "Cuivre cache;cuivre;0,0015;12;10,2\nCuivre cache;cuivre;0,0015;16;14,2\n"
+                        "Cuivre cache;cuivre;0,0015;20;18,2\nCuivre cache;cuivre;0,0015;28;26,2\n"
+                        "Cuivre cache;cuivre;0,0015;40;38,2\n");
+        PipeCatalogue::instance().loadFromFile(path);
+        std::remove(path.c_str());
+
+        NetworkCalculationParameters otherSeries = cacheNetwork();
+        CHECK(!cache.lookup(otherSeries));
+    }
+    NetworkCalculationParameters defaultSeries = cacheNetwork();
+    CHECK(cache.lookup(defaultSeries));
+
+    NetworkCalculationParameters moreFixtures = cacheNetwork();
+    moreFixtures.segments[2].fixtures[0].quantity += 1;
+    CHECK(!cache.lookup(moreFixtures));
+
+    const CacheStatistics stats = cache.statistics();
+    CHECK_EQUAL(stats.memoryHits, std::uint64_t(3));
+    CHECK_EQUAL(stats.misses, std::uint64_t(5));  // 2 calculs + 3 recherches sans résultat
+    CHECK_EQUAL(stats.entries, size_t(2));
+}
+
+// Niveau disque : relu par un autre cache ; fichier tronqué, altéré ou d'une autre clé =
+// absent ; dossiers des autres versions supprimés à l'ouverture
+TEST(CalculationCache_DiskEntriesAndVersionFolders)
+{
+    TemporaryDirectory directory("tchub_calculation_cache_test");
+    std::filesystem::create_directories(directory.path / "v0");
+    writeFile(directory.path / "v0" / "0000000000000001.tchc", "ancienne version");
+    std::filesystem::create_directories(directory.path / ("v" + std::to_string(PipeCalculator::Version + 7)));
+    std::filesystem::create_directories(directory.path / "projets");
+
+    NetworkCalculationParameters params = cacheNetwork();
+    {
+        CalculationCache cache;
+        cache.setDiskDirectory(directory.string());
+        PipeCalculator calculator;
+        calculator.setResultCache(&cache);
+        calculator.calculateNetwork(params);
+    }
+
+    const std::filesystem::path current = directory.path / ("v" + std::to_string(PipeCalculator::Version));
+    CHECK(std::filesystem::is_directory(current));
+    CHECK(!std::filesystem::exists(directory.path / "v0"));
+    CHECK(!std::filesystem::exists(directory.path / ("v" + std::to_string(PipeCalculator::Version + 7))));
+    CHECK(std::filesystem::is_directory(directory.path / "projets"));  // Hors du cache : conservé
+
+    const std::vector<std::filesystem::path> files = cacheFiles(directory.path);
+    CHECK_EQUAL(files.size(), size_t(1));
+    if (files.size() != 1)
+        return;
+    const std::filesystem::path file = files.front();
+    CHECK(file.parent_path() == current);
+    const std::string content = readFile(file);
+
+    auto lookupFromDisk = [&]() {
+        CalculationCache cache;
+        cache.setDiskDirectory(directory.string());
+        NetworkCalculationParameters network = cacheNetwork();
+        const bool found = cache.lookup(network);
+        const CacheStatistics stats = cache.statistics();
+        CHECK_EQUAL(stats.diskHits + stats.misses, std::uint64_t(1));
+        CHECK_EQUAL(stats.diskHits, std::uint64_t(found ? 1 : 0));
+        CHECK_EQUAL(stats.entries, size_t(found ? 1 : 0));
+        return found;
+    };
+
+    // Relecture complète par un nouveau cache
+    {
+        CalculationCache cache;
+        cache.setDiskDirectory(directory.string());
+        NetworkCalculationParameters network = cacheNetwork();
+        CHECK(cache.lookup(network));
+        for (size_t i = 0; i < network.segments.size(); ++i)
+        {
+            CHECK_EQUAL(network.segments[i].outletPressure, params.segments[i].outletPressure);
+            CHECK_EQUAL(network.segments[i].result.details.lambda, params.segments[i].result.details.lambda);
+            CHECK_EQUAL(network.segments[i].result.diagnostics.formatRecommendation(),
+                        params.segments[i].result.diagnostics.formatRecommendation());
+        }
+        CHECK_EQUAL(cache.statistics().diskHits, std::uint64_t(1));
+        CHECK(cache.lookup(network));  // Remontée en mémoire
+        CHECK_EQUAL(cache.statistics().memoryHits, std::uint64_t(1));
+    }
+
+    // Fichiers tronqués à toutes les longueurs significatives
+    for (size_t length : { size_t(0), size_t(3), size_t(12), size_t(40), content.size() / 2, content.size() - 1 })
+    {
+        writeFile(file, content.substr(0, length));
+        CHECK(!lookupFromDisk());
+    }
+
+    // Octet altéré dans l'en-tête puis dans la clé
+    std::string corrupted = content;
+    corrupted[0] = 'X';
+    writeFile(file, corrupted);
+    CHECK(!lookupFromDisk());
+    corrupted = content;
+    corrupted[4] = static_cast<char>(corrupted[4] + 1);  // Version du format
+    writeFile(file, corrupted);
+    CHECK(!lookupFromDisk());
+    corrupted = content;
+    corrupted[30] = static_cast<char>(corrupted[30] ^ 0x5A);  // Octet de la clé
+    writeFile(file, corrupted);
+    CHECK(!lookupFromDisk());
+
+    // Corps : nombre de tronçons démesuré, code de diagnostic inconnu sur le premier tronçon
+    // (ordre canonique : "antenne0") ; en-tête 16 octets, clé, loopLength, nombre de tronçons
+    std::uint64_t keySize = 0;
+    std::memcpy(&keySize, content.data() + 8, sizeof(keySize));
+    const size_t countOffset = 16 + static_cast<size_t>(keySize) + 8;
+    corrupted = content;
+    std::memset(&corrupted[countOffset], 0xFF, 4);
+    writeFile(file, corrupted);
+    CHECK(!lookupFromDisk());
+
+    const size_t diagnosticOffset = countOffset + 4 + 137;  // Champs fixes avant les diagnostics
+    const SegmentDiagnostics& diagnostics = segmentById(params, "antenne0").result.diagnostics;
+    CHECK(!diagnostics.empty());
+    CHECK_EQUAL(int(static_cast<unsigned char>(content[diagnosticOffset])), int(diagnostics.end() - diagnostics.begin()));
+    corrupted = content;
+    corrupted[diagnosticOffset + 1] = static_cast<char>(DiagnosticCodeCount);
+    writeFile(file, corrupted);
+    CHECK(!lookupFromDisk());
+
+    writeFile(file, content);
+    CHECK(lookupFromDisk());
+}
+
+// Limite mémoire : entrées les moins récemment utilisées retirées d'abord, taille bornée
+TEST(CalculationCache_MemoryEvictionRespectsLimit)
+{
+    CalculationCache cache;
+    PipeCalculator calculator;
+    calculator.setResultCache(&cache);
+
+    NetworkCalculationParameters first = cacheNetwork(10.0);
+    calculator.calculateNetwork(first);
+    const size_t entryBytes = cache.statistics().bytes;
+    CHECK(entryBytes > 0);
+
+    // Place pour deux entrées
+    cache.setMemoryLimit(2 * entryBytes + entryBytes / 2);
+    NetworkCalculationParameters second = cacheNetwork(11.0);
+    calculator.calculateNetwork(second);
+    CHECK_EQUAL(cache.statistics().entries, size_t(2));
+
+    NetworkCalculationParameters firstAgain = cacheNetwork(10.0);
+    CHECK(cache.lookup(firstAgain));  // La première devient la plus récente
+
+    NetworkCalculationParameters third = cacheNetwork(12.0);
+    calculator.calculateNetwork(third);
+    CacheStatistics stats = cache.statistics();
+    CHECK_EQUAL(stats.entries, size_t(2));
+    CHECK_EQUAL(stats.evictions, std::uint64_t(1));
+    CHECK(stats.bytes <= 2 * entryBytes + entryBytes / 2);
+
+    NetworkCalculationParameters probe = cacheNetwork(11.0);
+    CHECK(!cache.lookup(probe));  // La deuxième, la moins récente, est partie
+    probe = cacheNetwork(10.0);
+    CHECK(cache.lookup(probe));
+    probe = cacheNetwork(12.0);
+    CHECK(cache.lookup(probe));
+
+    // Limite abaissée : retrait immédiat ; entrée plus grande que la limite jamais conservée
+    cache.setMemoryLimit(entryBytes);
+    stats = cache.statistics();
+    CHECK_EQUAL(stats.entries, size_t(1));
+    CHECK_EQUAL(stats.evictions, std::uint64_t(2));
+    CHECK(stats.bytes <= entryBytes);
+
+    cache.setMemoryLimit(entryBytes / 2);
+    CHECK_EQUAL(cache.statistics().entries, size_t(0));
+    CHECK_EQUAL(cache.statistics().bytes, size_t(0));
+    NetworkCalculationParameters tooLarge = cacheNetwork(13.0);
+    calculator.calculateNetwork(tooLarge);
+    CHECK_EQUAL(cache.statistics().entries, size_t(0));
+    CHECK(!cache.lookup(tooLarge));
+}
@@ -0,0 +1,169 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/CriticalPathAnalyzer.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    // Deux étages desservis par une même colonne ; les segments ne sont pas donnés dans
+    // l'ordre de parcours (cuisine1 après etage2). Colonne bouclée, pièces en antenne.
+    NetworkCalculationParameters twoStoreyNetwork(NetworkType type)
+    {
+        NetworkCalculationParameters params;
+        params.networkType = type;
+        params.supplyPressure = 1.8;
+        params.requiredPressure = 1.0;
+
+        auto add = [&params, type](const std::string& id, const std::string& parentId, double length, double height,
+                             bool looped, std::vector<Fixture> fixtures)
+        {
+            NetworkSegment segment(id, id);
+            segment.parentId = parentId;
+            segment.length = length;
+            segment.heightDifference = height;
+            segment.hasReturnLine = looped && type == NetworkType::HotWaterWithLoop;
+            segment.fixtures = std::move(fixtures);
+            params.segments.push_back(segment);
+        };
+        add("source", "", 10.0, 0.0, true, {});
+        add("etage1", "source", 3.0, 3.0, true, { Fixture(FixtureType::HandWashBasin, 1) });
+        add("sdb1", "etage1", 4.0, 0.0, false, { Fixture(FixtureType::Shower, 1), Fixture(FixtureType::WashBasin, 1) });
+        add("etage2", "etage1", 3.0, 3.0, true, {});
+        add("cuisine1", "etage1", 6.0, 0.0, false, { Fixture(FixtureType::Sink, 1) });
+        add("sdb2", "etage2", 8.0, 0.5, false, { Fixture(FixtureType::Bathtub, 1), Fixture(FixtureType::WashBasin, 2) });
+        add("wc2", "etage2", 2.0, 0.0, false, { Fixture(FixtureType::WC, 1) });
+        return params;
+    }
+
+    const NetworkSegment& segmentById(const NetworkCalculationParameters& params, const std::string& id)
+    {
+        for (const NetworkSegment& segment : params.segments)
+        {
+            if (segment.id == id)
+                return segment;
+        }
+        return params.segments.front();
+    }
+
+    // Volume intérieur d'un tronçon (L)
+    double segmentVolume(const NetworkSegment& segment)
+    {
+        const double diameter = segment.result.actualDiameter / 1000.0;
+        return M_PI * diameter * diameter / 4.0 * segment.length * 1000.0;
+    }
+}
+
+// Pression à chaque appareil = pression de sortie propagée de son tronçon ; appareils dans
+// l'ordre de parcours, N plus défavorisés par marge croissante, chemin critique source → appareil
+TEST(CriticalPath_FixturePressuresAndCriticalPath)
+{
+    NetworkCalculationParameters params = twoStoreyNetwork(NetworkType::ColdWater);
+    PipeCalculator calculator;
+    calculator.calculateNetwork(params);
+
+    CriticalPathAnalyzer analyzer;
+    const CriticalPathResult result = analyzer.analyze(params, 3);
+
+    CHECK_EQUAL(result.fixtures.size(), size_t(7));  // Un résultat par groupe d'appareils
+    int insufficient = 0;
+    std::vector<std::string> order;
+    for (const FixturePathResult& fixture : result.fixtures)
+    {
+        const NetworkSegment& segment = segmentById(params, fixture.segmentId);
+        CHECK_NEAR(fixture.pressure, segment.outletPressure, 1e-9);
+        CHECK_NEAR(fixture.pressureMargin, segment.outletPressure - params.requiredPressure, 1e-9);
+        CHECK_EQUAL(fixture.waitTime, 0.0);
+        CHECK_EQUAL(fixture.hotWaterVolume, 0.0);
+        if (fixture.pressureMargin < 0.0)
+            ++insufficient;
+        if (order.empty() || order.back() != fixture.segmentId)
+            order.push_back(fixture.segmentId);
+    }
+    CHECK(order == std::vector<std::string>({ "etage1", "sdb1", "sdb2", "wc2", "cuisine1" }));
+    CHECK_EQUAL(result.insufficientCount, insufficient);
+    CHECK(insufficient > 0);
+
+    // Cumuls : longueur et dénivelé depuis la source
+    const FixturePathResult& bath = result.fixtures[3];
+    CHECK_EQUAL(bath.segmentId, std::string("sdb2"));
+    CHECK_NEAR(bath.pathLength, 10.0 + 3.0 + 3.0 + 8.0, 1e-12);
+    CHECK_NEAR(bath.elevation, 0.0 + 3.0 + 3.0 + 0.5, 1e-12);
+    CHECK_NEAR(bath.pathPressureDrop, 10.0 * (params.supplyPressure - segmentById(params, "sdb2").outletPressure), 1e-9);
+
+    // N plus défavorisés : les N plus petites marges, dans l'ordre
+    std::vector<double> margins;
+    for (const FixturePathResult& fixture : result.fixtures)
+        margins.push_back(fixture.pressureMargin);
+    std::sort(margins.begin(), margins.end());
+    CHECK_EQUAL(result.worstFixtures.size(), size_t(3));
+    for (size_t k = 0; k < result.worstFixtures.size(); ++k)
+        CHECK_EQUAL(result.fixtures[result.worstFixtures[k]].pressureMargin, margins[k]);
+
+    // Appareil le plus défavorisé au deuxième étage, au bout de la plus longue antenne
+    CHECK_EQUAL(result.critical().segmentId, std::string("sdb2"));
+    CHECK(result.criticalPath == std::vector<std::string>({ "source", "etage1", "etage2", "sdb2" }));
+
+    // worstCount au-delà du nombre d'appareils : tous classés
+    CHECK_EQUAL(analyzer.analyze(params, 50).worstFixtures.size(), result.fixtures.size());
+}
+
+// Volume d'eau non chaude avant l'appareil : tout le chemin sans bouclage, seulement les
+// antennes après le dernier tronçon bouclé en bouclage (nul sur un tronçon bouclé)
+TEST(CriticalPath_HotWaterVolumeExcludesLoopedSegments)
+{
+    NetworkCalculationParameters hot = twoStoreyNetwork(NetworkType::HotWater);
+    NetworkCalculationParameters looped = twoStoreyNetwork(NetworkType::HotWaterWithLoop);
+    PipeCalculator calculator;
+    calculator.calculateNetwork(hot);
+    calculator.calculateNetwork(looped);
+
+    CriticalPathAnalyzer analyzer;
+    const CriticalPathResult hotResult = analyzer.analyze(hot);
+    const CriticalPathResult loopResult = analyzer.analyze(looped);
+    CHECK_EQUAL(hotResult.fixtures.size(), loopResult.fixtures.size());
+
+    const std::map<std::string, std::vector<std::string>> paths = {
+        { "etage1", { "source", "etage1" } },
+        { "sdb1", { "source", "etage1", "sdb1" } },
+        { "sdb2", { "source", "etage1", "etage2", "sdb2" } },
+        { "wc2", { "source", "etage1", "etage2", "wc2" } },
+        { "cuisine1", { "source", "etage1", "cuisine1" } },
+    };
+
+    for (size_t k = 0; k < std::min(hotResult.fixtures.size(), loopResult.fixtures.size()); ++k)
+    {
+        const FixturePathResult& withoutLoop = hotResult.fixtures[k];
+        const FixturePathResult& withLoop = loopResult.fixtures[k];
+        CHECK_EQUAL(withoutLoop.segmentId, withLoop.segmentId);
+        const std::vector<std::string>& path = paths.at(withoutLoop.segmentId);
+
+        double fullVolume = 0.0;
+        for (const std::string& id : path)
+            fullVolume += segmentVolume(segmentById(hot, id));
+        const NetworkSegment& own = segmentById(looped, withLoop.segmentId);
+        const double antennaVolume = own.hasReturnLine ? 0.0 : segmentVolume(own);
+
+        CHECK_NEAR(withoutLoop.hotWaterVolume, fullVolume, 1e-9);
+        CHECK_NEAR(withLoop.hotWaterVolume, antennaVolume, 1e-9);
+
+        const double unitFlowRate = FixtureCatalogue::instance().flowRate(withLoop.type) / 60.0;  // L/s
+        CHECK_NEAR(withoutLoop.waitTime, fullVolume / unitFlowRate, 1e-9);
+        CHECK_NEAR(withLoop.waitTime, antennaVolume / unitFlowRate, 1e-9);
+        CHECK(withLoop.waitTime < withoutLoop.waitTime);
+    }
+
+    // Attente la plus longue
+    size_t longest = 0;
+    for (size_t k = 1; k < hotResult.fixtures.size(); ++k)
+    {
+        if (hotResult.fixtures[k].waitTime > hotResult.fixtures[longest].waitTime)
+            longest = k;
+    }
+    CHECK_EQUAL(hotResult.longestWaitFixture, longest);
+}
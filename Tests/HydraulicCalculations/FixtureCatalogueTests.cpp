@@ -0,0 +1,81 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/FixtureCatalogue.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    // Fichier de surcharges temporaire, supprimé à la fin du test
+    struct TemporaryFile
+    {
+        std::string path;
+
+        explicit TemporaryFile(const std::string& content)
+            : path("fixture_catalogue_test_" + std::to_string(std::rand()) + ".csv")
+        {
+            std::ofstream(path, std::ios::binary) << content;
+        }
+        ~TemporaryFile() { std::remove(path.c_str()); }
+    };
+}
+
+TEST(FixtureCatalogue_LoadsOverridesByName)
+{
+    FixtureCatalogue& catalogue = FixtureCatalogue::instance();
+    catalogue.resetToDefaults();
+
+    TemporaryFile file("\xEF\xBB\xBF" "Appareil;Débit (L/min)\r\n"
+                       "# Débits fabricant\r\n"
+                       "Douche;9,0\r\n"
+                       "lavabo ; 4.5\r\n");
+    const auto overridden = catalogue.loadFromFile(file.path);
+
+    CHECK_EQUAL(overridden.size(), size_t(2));
+    CHECK_NEAR(catalogue.flowRate(FixtureType::Shower), 9.0, 1e-12);
+    CHECK_NEAR(catalogue.flowRate(FixtureType::WashBasin), 4.5, 1e-12);
+    CHECK_NEAR(catalogue.flowRate(FixtureType::Bathtub), FixtureCatalogue::defaultFlowRate(FixtureType::Bathtub), 1e-12);
+
+    catalogue.resetToDefaults();
+    CHECK_NEAR(catalogue.flowRate(FixtureType::Shower), FixtureCatalogue::defaultFlowRate(FixtureType::Shower), 1e-12);
+}
+
+// Une ligne invalide fait rejeter tout le fichier : aucune surcharge partielle
+TEST(FixtureCatalogue_RejectsInvalidFileWithoutPartialUpdate)
+{
+    FixtureCatalogue& catalogue = FixtureCatalogue::instance();
+    catalogue.resetToDefaults();
+
+    // La première ligne de données n'est prise pour un en-tête que si elle en porte le libellé
+    for (const char* content : { "Douche;9,0\nPiscine;12\n", "Douche;9,0\nLavabo;-1\n", "Douche;9,0\nLavabo\n",
+                                 "Douche;9,0x\nLavabo;4,5\n", "# Débits\nDouche;abc\n" })
+    {
+        TemporaryFile file(content);
+        bool thrown = false;
+        try
+        {
+            catalogue.loadFromFile(file.path);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        CHECK(thrown);
+        CHECK_NEAR(catalogue.flowRate(FixtureType::Shower), FixtureCatalogue::defaultFlowRate(FixtureType::Shower), 1e-12);
+    }
+
+    bool missingThrown = false;
+    try
+    {
+        catalogue.loadFromFile("introuvable/debits_appareils.csv");
+    }
+    catch (const std::runtime_error&)
+    {
+        missingThrown = true;
+    }
+    CHECK(missingThrown);
+}
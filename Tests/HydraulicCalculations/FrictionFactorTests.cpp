@@ -0,0 +1,107 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/FrictionFactor.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    // Points (Re, ε/D) tirés uniformément en log : 2300 < Re < 3·10⁷, 3·10⁻⁶ < ε/D < 3·10⁻²
+    struct FrictionPoints
+    {
+        std::vector<double> reynolds;
+        std::vector<double> roughness;
+    };
+
+    FrictionPoints randomPoints(int count)
+    {
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<double> logReynolds(std::log10(FrictionFactor::LaminarLimit), 7.5);
+        std::uniform_real_distribution<double> logRoughness(-5.5, -1.5);
+        FrictionPoints points;
+        for (int i = 0; i < count; ++i)
+        {
+            points.reynolds.push_back(std::pow(10.0, logReynolds(generator)));
+            points.roughness.push_back(std::pow(10.0, logRoughness(generator)));
+        }
+        return points;
+    }
+
+    double colebrookResidual(double reynolds, double roughness, double lambda)
+    {
+        const double x = 1.0 / std::sqrt(lambda);
+        return x + 2.0 * std::log10(roughness / 3.7 + 2.51 * x / reynolds);
+    }
+}
+
+TEST(FrictionFactor_ColebrookWhiteSolvesTheEquation)
+{
+    const FrictionPoints points = randomPoints(20000);
+    int maxIterations = 0;
+    for (size_t i = 0; i < points.reynolds.size(); ++i)
+    {
+        int iterations = 0;
+        const double lambda = FrictionFactor::colebrookWhite(points.reynolds[i], points.roughness[i], &iterations);
+        maxIterations = std::max(maxIterations, iterations);
+        CHECK(std::fabs(colebrookResidual(points.reynolds[i], points.roughness[i], lambda)) < 1e-10);
+    }
+    CHECK(maxIterations <= 4);
+}
+
+// Écart relatif maximal à Colebrook-White : table < 2·10⁻³, Swamee-Jain < 5·10⁻²
+TEST(FrictionFactor_ApproximationsStayCloseToColebrook)
+{
+    const FrictionPoints points = randomPoints(200000);
+    double swameeJainError = 0.0;
+    double tableError = 0.0;
+    for (size_t i = 0; i < points.reynolds.size(); ++i)
+    {
+        const double exact = FrictionFactor::colebrookWhite(points.reynolds[i], points.roughness[i]);
+        swameeJainError = std::max(swameeJainError, std::fabs(FrictionFactor::swameeJain(points.reynolds[i], points.roughness[i]) / exact - 1.0));
+        tableError = std::max(tableError, std::fabs(FrictionFactor::fromTable(points.reynolds[i], points.roughness[i]) / exact - 1.0));
+    }
+    CHECK(tableError < 2e-3);
+    CHECK(swameeJainError < 5e-2);
+}
+
+TEST(FrictionFactor_LaminarIsIndependentOfModel)
+{
+    for (FrictionModel model : { FrictionModel::SwameeJain, FrictionModel::ColebrookWhite, FrictionModel::Table })
+    {
+        CHECK_NEAR(FrictionFactor::compute(1000.0, 1e-3, model), 64.0 / 1000.0, 1e-15);
+        CHECK_NEAR(FrictionFactor::compute(2000.0, 1e-4, model), 64.0 / 2000.0, 1e-15);
+    }
+}
+
+// Précision et débit des trois méthodes sur 2 millions de points
+BENCHMARK(FrictionFactor_CompareModels)
+{
+    const FrictionPoints points = randomPoints(2000000);
+    FrictionFactor::fromTable(1e4, 1e-3);  // Construction de la table hors mesure
+
+    std::vector<double> exact(200000);
+    for (size_t i = 0; i < exact.size(); ++i)
+        exact[i] = FrictionFactor::colebrookWhite(points.reynolds[i], points.roughness[i]);
+
+    for (FrictionModel model : { FrictionModel::SwameeJain, FrictionModel::ColebrookWhite, FrictionModel::Table })
+    {
+        double maxError = 0.0;
+        for (size_t i = 0; i < exact.size(); ++i)
+            maxError = std::max(maxError, std::fabs(FrictionFactor::compute(points.reynolds[i], points.roughness[i], model) / exact[i] - 1.0));
+
+        volatile double sink = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < points.reynolds.size(); ++i)
+            sink = sink + FrictionFactor::compute(points.reynolds[i], points.roughness[i], model);
+        const double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                                 / points.reynolds.size();
+
+        std::cout << "  " << FrictionFactor::getModelName(model) << " : " << nanoseconds
+                  << " ns/appel, écart relatif max " << maxError << "\n";
+    }
+}
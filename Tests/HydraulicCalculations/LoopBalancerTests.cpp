@@ -0,0 +1,92 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/LoopBalancer.h"
+#include <cmath>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    // Colonne bouclée et quatre branches de longueurs croissantes, calculée par PipeCalculator
+    NetworkCalculationParameters loopNetwork(double waterTemperature, double branchLength = 10.0)
+    {
+        NetworkCalculationParameters params;
+        params.networkType = NetworkType::HotWaterWithLoop;
+        params.material = PipeMaterial::Copper;
+        params.supplyPressure = 3.0;
+        params.requiredPressure = 1.0;
+        params.waterTemperature = waterTemperature;
+        params.ambientTemperature = 20.0;
+        params.insulationThickness = 13.0;
+
+        NetworkSegment riser("colonne", "colonne");
+        riser.length = 20.0;
+        riser.hasReturnLine = true;
+        params.segments.push_back(riser);
+        for (int i = 0; i < 4; ++i)
+        {
+            NetworkSegment branch("branche" + std::to_string(i), "branche" + std::to_string(i));
+            branch.parentId = "colonne";
+            branch.length = branchLength + 15.0 * i;
+            branch.hasReturnLine = true;
+            branch.fixtures.push_back(Fixture(FixtureType::Shower, 2));
+            params.segments.push_back(branch);
+        }
+
+        PipeCalculator calculator;
+        calculator.calculateNetwork(params);
+        return params;
+    }
+}
+
+TEST(LoopBalancer_ReachesRequiredReturnTemperature)
+{
+    LoopBalancer balancer;
+    const LoopBalancingResult result = balancer.balance(loopNetwork(60.0));
+
+    CHECK(result.converged);
+    CHECK_EQUAL(result.valves.size(), size_t(4));
+    CHECK(!result.returnTemperatureLowered);
+    CHECK_NEAR(result.requiredReturnTemperature, 55.0, 1e-12);
+    CHECK(result.minReturnTemperature >= 55.0 - 0.1);
+    CHECK_EQUAL(result.undersizedValveCount(), 0);
+    for (const BalancingValveSetting& valve : result.valves)
+    {
+        CHECK(valve.presetting > 0.0 && valve.presetting <= 1.0);
+        CHECK_NEAR(valve.presetting, valve.kv / valve.kvs, 1e-12);
+    }
+}
+
+// Départ à 50 °C (plage de l'interface : 40 à 80 °C) : l'équilibrage abaisse la consigne
+// retour au lieu de faire échouer le calcul du réseau
+TEST(LoopBalancer_ColdSupplyLowersRequiredReturnTemperature)
+{
+    LoopBalancer balancer;
+    for (double supply : { 40.0, 50.0, 55.0 })
+    {
+        const LoopBalancingResult result = balancer.balance(loopNetwork(supply));
+        CHECK(result.returnTemperatureLowered);
+        CHECK_NEAR(result.requiredReturnTemperature, supply - PipeCalculator::LoopTemperatureDrop, 1e-12);
+        CHECK(!result.empty());
+        CHECK(result.converged);
+        CHECK(result.minReturnTemperature >= result.requiredReturnTemperature - 0.1);
+    }
+}
+
+// Robinet trop petit pour le débit de sa branche : le préréglage garde le rapport réel Kv/Kvs
+TEST(LoopBalancer_FlagsUndersizedValves)
+{
+    LoopBalancingOptions options;
+    options.minValvePressureDrop = 0.0005;  // Robinet quasi ouvert sur la branche défavorisée
+
+    LoopBalancer balancer;
+    const LoopBalancingResult result = balancer.balance(loopNetwork(60.0, 60.0), options);
+
+    CHECK(result.undersizedValveCount() > 0);
+    for (const BalancingValveSetting& valve : result.valves)
+    {
+        CHECK_NEAR(valve.presetting, valve.kv / valve.kvs, 1e-12);
+        CHECK_EQUAL(valve.undersized, valve.kv > valve.kvs);
+        if (valve.undersized)
+            CHECK(valve.presetting > 1.0);
+    }
+}
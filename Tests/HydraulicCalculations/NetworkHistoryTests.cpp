@@ -0,0 +1,126 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/NetworkHistory.h"
+#include <memory>
+#include <string>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    // État d'un seul tronçon "colonne" de longueur donnée
+    NetworkState stateWithLength(double length)
+    {
+        SegmentSnapshot snapshot;
+        snapshot.segment = NetworkSegment("colonne", "Colonne");
+        snapshot.segment.length = length;
+        NetworkState state;
+        state.segments = state.segments.set("colonne", std::make_shared<const SegmentSnapshot>(snapshot));
+        return state;
+    }
+
+    double lengthOf(const NetworkState& state)
+    {
+        const auto snapshot = state.segments.find("colonne");
+        return snapshot ? snapshot->segment.length : -1.0;
+    }
+}
+
+// Annuler puis rétablir parcourt les étapes dans l'ordre, avec leurs libellés
+TEST(NetworkHistory_UndoRedoOrder)
+{
+    NetworkHistory history;
+    CHECK(!history.canUndo());
+    CHECK(!history.canRedo());
+    CHECK(history.current().segments.empty());
+
+    history.record(stateWithLength(1.0), "Ajout");
+    history.record(stateWithLength(2.0), "Longueur 2 m");
+    history.record(stateWithLength(3.0), "Longueur 3 m");
+    CHECK_EQUAL(lengthOf(history.current()), 3.0);
+    CHECK_EQUAL(history.undoLabel(), std::string("Longueur 3 m"));
+    CHECK_EQUAL(history.redoLabel(), std::string());
+
+    CHECK_EQUAL(lengthOf(history.undo()), 2.0);
+    CHECK_EQUAL(history.undoLabel(), std::string("Longueur 2 m"));
+    CHECK_EQUAL(history.redoLabel(), std::string("Longueur 3 m"));
+    CHECK_EQUAL(lengthOf(history.undo()), 1.0);
+    CHECK(history.undo().segments.empty());
+    CHECK(!history.canUndo());
+    CHECK(history.undo().segments.empty());  // Sans effet au début
+
+    CHECK_EQUAL(history.redoLabel(), std::string("Ajout"));
+    CHECK_EQUAL(lengthOf(history.redo()), 1.0);
+    CHECK_EQUAL(lengthOf(history.redo()), 2.0);
+    CHECK_EQUAL(lengthOf(history.redo()), 3.0);
+    CHECK(!history.canRedo());
+    CHECK_EQUAL(lengthOf(history.redo()), 3.0);  // Sans effet à la fin
+}
+
+// Nouvelle étape après des annulations : les étapes annulées sont effacées
+TEST(NetworkHistory_RecordClearsRedo)
+{
+    NetworkHistory history;
+    history.record(stateWithLength(1.0), "Ajout");
+    history.record(stateWithLength(2.0), "Longueur 2 m");
+    history.record(stateWithLength(3.0), "Longueur 3 m");
+    history.undo();
+    history.undo();
+    CHECK(history.canRedo());
+
+    history.record(stateWithLength(5.0), "Longueur 5 m");
+    CHECK(!history.canRedo());
+    CHECK_EQUAL(history.redoLabel(), std::string());
+    CHECK_EQUAL(lengthOf(history.current()), 5.0);
+    CHECK_EQUAL(lengthOf(history.undo()), 1.0);
+    CHECK_EQUAL(lengthOf(history.redo()), 5.0);
+
+    history.clear();
+    CHECK(!history.canUndo());
+    CHECK(!history.canRedo());
+    CHECK(history.current().segments.empty());
+}
+
+// Profondeur maximale : les étapes les plus anciennes sont oubliées
+TEST(NetworkHistory_TrimsToMaxDepth)
+{
+    NetworkHistory history(3);
+    for (int i = 1; i <= 5; ++i)
+        history.record(stateWithLength(i), "Longueur " + std::to_string(i) + " m");
+
+    int undone = 0;
+    while (history.canUndo())
+    {
+        history.undo();
+        ++undone;
+    }
+    CHECK_EQUAL(undone, 3);
+    CHECK_EQUAL(lengthOf(history.current()), 2.0);  // État de la plus ancienne étape gardée
+    CHECK_EQUAL(history.redoLabel(), std::string("Longueur 3 m"));
+
+    while (history.canRedo())
+        history.redo();
+    CHECK_EQUAL(lengthOf(history.current()), 5.0);
+}
+
+// amend remplace l'état courant (résultats d'un calcul) sans créer d'étape
+TEST(NetworkHistory_AmendCreatesNoStep)
+{
+    NetworkHistory history;
+    history.record(stateWithLength(1.0), "Ajout");
+    history.record(stateWithLength(2.0), "Longueur 2 m");
+    CHECK(!history.current().calculated());
+
+    NetworkState calculated = stateWithLength(2.0);
+    calculated.calculation = std::make_shared<const CalculationSnapshot>();
+    history.amend(calculated);
+    CHECK(history.current().calculated());
+    CHECK(!history.canRedo());
+    CHECK_EQUAL(history.undoLabel(), std::string("Longueur 2 m"));
+
+    CHECK_EQUAL(lengthOf(history.undo()), 1.0);
+    CHECK(!history.current().calculated());
+    CHECK(history.redo().calculated());  // L'état rétabli garde ses résultats
+    CHECK_EQUAL(lengthOf(history.undo()), 1.0);
+    CHECK(history.undo().segments.empty());
+    CHECK(!history.canUndo());
+}
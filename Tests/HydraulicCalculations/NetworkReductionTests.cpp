@@ -0,0 +1,308 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/NetworkReduction.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    // Colonne source → col1 → col2 → palier sans appareil, puis deux antennes : A (appareils)
+    // et B sans appareil → B2. Chaînes fusionnées : source..palier et B..B2 (7 tronçons → 3)
+    NetworkCalculationParameters chainNetwork(NetworkType type)
+    {
+        NetworkCalculationParameters params;
+        params.networkType = type;
+        params.supplyPressure = 3.0;
+        params.requiredPressure = 1.0;
+
+        auto add = [&params, type](const std::string& id, const std::string& parentId, double length, double height,
+                                   std::vector<Fixture> fixtures)
+        {
+            NetworkSegment segment(id, id);
+            segment.parentId = parentId;
+            segment.length = length;
+            segment.heightDifference = height;
+            segment.hasReturnLine = (type == NetworkType::HotWaterWithLoop);
+            segment.fixtures = std::move(fixtures);
+            params.segments.push_back(segment);
+        };
+        add("source", "", 8.0, 0.0, {});
+        add("col1", "source", 3.0, 3.0, {});
+        add("col2", "col1", 3.0, 2.5, {});
+        add("palier", "col2", 4.0, 0.0, {});
+        add("A", "palier", 6.0, 0.0, { Fixture(FixtureType::Shower, 1), Fixture(FixtureType::WashBasin, 2) });
+        add("B", "palier", 2.0, -0.5, {});
+        add("B2", "B", 5.0, 0.0, { Fixture(FixtureType::Sink, 1), Fixture(FixtureType::WC, 1) });
+        return params;
+    }
+
+    // Composite de chaque tronçon d'origine dans le réseau réduit (par identifiant)
+    const char* const COMPOSITE_OF[] = { "palier", "palier", "palier", "palier", "A", "B2", "B2" };
+
+    const NetworkSegment& segmentById(const NetworkCalculationParameters& params, const std::string& id)
+    {
+        for (const NetworkSegment& segment : params.segments)
+        {
+            if (segment.id == id)
+                return segment;
+        }
+        return params.segments.front();
+    }
+
+    size_t indexById(const NetworkCalculationParameters& params, const std::string& id)
+    {
+        for (size_t i = 0; i < params.segments.size(); ++i)
+        {
+            if (params.segments[i].id == id)
+                return i;
+        }
+        return params.segments.size();
+    }
+}
+
+// Fusion : composites aux identifiants du dernier tronçon de chaque chaîne, parent du premier ;
+// longueurs, dénivelés et pertes de charge des tronçons d'une chaîne sommés = ceux du composite
+TEST(NetworkReduction_ChainSumsMatchComposite)
+{
+    NetworkCalculationParameters original = chainNetwork(NetworkType::ColdWater);
+    NetworkReduction reduction(original);
+
+    CHECK(reduction.reducesNetwork());
+    CHECK_EQUAL(reduction.getOriginalCount(), size_t(7));
+    CHECK_EQUAL(reduction.getReducedCount(), size_t(3));
+
+    NetworkCalculationParameters& reduced = reduction.reducedParameters();
+    CHECK_EQUAL(reduced.segments.size(), size_t(3));
+    CHECK_EQUAL(segmentById(reduced, "palier").parentId, std::string());
+    CHECK_EQUAL(segmentById(reduced, "A").parentId, std::string("palier"));
+    CHECK_EQUAL(segmentById(reduced, "B2").parentId, std::string("palier"));
+    CHECK_EQUAL(segmentById(reduced, "B2").fixtures.size(), size_t(2));
+
+    PipeCalculator calculator;
+    calculator.calculateNetwork(reduced);
+    reduction.expand(original);
+
+    for (const char* id : { "palier", "A", "B2" })
+    {
+        const NetworkSegment& composite = segmentById(reduced, id);
+        double length = 0.0, height = 0.0, linear = 0.0, singular = 0.0, drop = 0.0;
+        for (size_t i = 0; i < original.segments.size(); ++i)
+        {
+            if (COMPOSITE_OF[i] != std::string(id))
+                continue;
+            const NetworkSegment& segment = original.segments[i];
+            length += segment.length;
+            height += segment.heightDifference;
+            linear += segment.result.details.linearPressureDrop;
+            singular += segment.result.details.singularPressureDrop;
+            drop += segment.result.pressureDrop;
+            CHECK_EQUAL(segment.result.nominalDiameter, composite.result.nominalDiameter);
+            CHECK_NEAR(segment.result.flowRate, composite.result.flowRate, 1e-12);
+        }
+        CHECK_NEAR(length, composite.length, 1e-12);
+        CHECK_NEAR(height, composite.heightDifference, 1e-12);
+        CHECK_NEAR(linear, composite.result.details.linearPressureDrop, 1e-9);
+        CHECK_NEAR(singular, composite.result.details.singularPressureDrop, 1e-9);
+        CHECK_NEAR(drop, composite.result.pressureDrop, 1e-9);
+    }
+
+    // Pressions continues le long d'une chaîne : entrée du premier, sortie du dernier
+    CHECK_NEAR(segmentById(original, "source").inletPressure, segmentById(reduced, "palier").inletPressure, 1e-12);
+    CHECK_NEAR(segmentById(original, "palier").outletPressure, segmentById(reduced, "palier").outletPressure, 1e-9);
+    CHECK_NEAR(segmentById(original, "col1").outletPressure, segmentById(original, "col2").inletPressure, 1e-12);
+    CHECK_NEAR(segmentById(original, "B").outletPressure, segmentById(original, "B2").inletPressure, 1e-12);
+
+    // Sans chaîne : rien à fusionner
+    NetworkCalculationParameters unchained = chainNetwork(NetworkType::ColdWater);
+    unchained.segments[0].fixtures.push_back(Fixture(FixtureType::HandWashBasin, 1));
+    unchained.segments[1].fixtures.push_back(Fixture(FixtureType::HandWashBasin, 1));
+    unchained.segments[2].fixtures.push_back(Fixture(FixtureType::HandWashBasin, 1));
+    unchained.segments[5].fixtures.push_back(Fixture(FixtureType::HandWashBasin, 1));
+    NetworkReduction none(unchained);
+    CHECK(!none.reducesNetwork());
+    CHECK_EQUAL(none.getReducedCount(), none.getOriginalCount());
+}
+
+// Eau froide : réduire, calculer, reporter donne les mêmes DN et pressions que le calcul du
+// réseau d'origine (débits identiques le long d'une chaîne, pertes linéaires en longueur)
+TEST(NetworkReduction_ExpandMatchesUnreducedCalculation)
+{
+    NetworkCalculationParameters direct = chainNetwork(NetworkType::ColdWater);
+    NetworkCalculationParameters original = direct;
+
+    PipeCalculator calculator;
+    calculator.calculateNetwork(direct);
+
+    NetworkReduction reduction(original);
+    calculator.calculateNetwork(reduction.reducedParameters());
+    reduction.expand(original);
+
+    CHECK_EQUAL(original.segments.size(), direct.segments.size());
+    for (size_t i = 0; i < direct.segments.size(); ++i)
+    {
+        const NetworkSegment& expected = direct.segments[i];
+        const NetworkSegment& actual = original.segments[i];
+        CHECK_EQUAL(actual.id, expected.id);
+        CHECK_EQUAL(actual.result.nominalDiameter, expected.result.nominalDiameter);
+        CHECK_NEAR(actual.result.actualDiameter, expected.result.actualDiameter, 1e-12);
+        CHECK_NEAR(actual.result.flowRate, expected.result.flowRate, 1e-12);
+        CHECK_NEAR(actual.result.velocity, expected.result.velocity, 1e-12);
+        CHECK_NEAR(actual.result.pressureDrop, expected.result.pressureDrop, 1e-9);
+        CHECK_NEAR(actual.inletPressure, expected.inletPressure, 1e-9);
+        CHECK_NEAR(actual.outletPressure, expected.outletPressure, 1e-9);
+        CHECK_EQUAL(int(actual.result.diagnostics.has(DiagnosticCode::InsufficientPressure)),
+                    int(expected.result.diagnostics.has(DiagnosticCode::InsufficientPressure)));
+    }
+
+    // Copie calculée du réseau réduit (calcul combiné) : même report
+    NetworkCalculationParameters fromCopy = chainNetwork(NetworkType::ColdWater);
+    const NetworkCalculationParameters solved = reduction.reducedParameters();
+    reduction.expand(solved, fromCopy);
+    for (size_t i = 0; i < direct.segments.size(); ++i)
+        CHECK_NEAR(fromCopy.segments[i].outletPressure, original.segments[i].outletPressure, 1e-15);
+}
+
+// Équilibrage calculé sur le réseau réduit : tableaux par tronçon ramenés au réseau d'origine,
+// débit du composite sur chaque tronçon de la chaîne, températures retour continues
+TEST(NetworkReduction_ExpandsLoopBalancing)
+{
+    NetworkCalculationParameters original = chainNetwork(NetworkType::HotWaterWithLoop);
+    NetworkReduction reduction(original);
+    NetworkCalculationParameters& reduced = reduction.reducedParameters();
+    PipeCalculator calculator;
+    calculator.calculateNetwork(reduced);
+
+    LoopBalancer balancer;
+    const LoopBalancingResult solved = balancer.balance(reduced);
+    CHECK_EQUAL(solved.circulationFlowRates.size(), reduction.getReducedCount());
+    CHECK_EQUAL(solved.valves.size(), size_t(2));
+
+    LoopBalancingResult balancing = solved;
+    reduction.expand(balancing);
+    CHECK_EQUAL(balancing.circulationFlowRates.size(), reduction.getOriginalCount());
+    CHECK_EQUAL(balancing.returnTemperatures.size(), reduction.getOriginalCount());
+    CHECK_EQUAL(balancing.returnInletTemperatures.size(), reduction.getOriginalCount());
+
+    // Robinets et grandeurs globales inchangés (portés par les feuilles, qui gardent leur identifiant)
+    CHECK_EQUAL(balancing.valves.size(), solved.valves.size());
+    for (size_t k = 0; k < balancing.valves.size(); ++k)
+    {
+        CHECK_EQUAL(balancing.valves[k].segmentId, solved.valves[k].segmentId);
+        CHECK(indexById(original, balancing.valves[k].segmentId) < original.segments.size());
+    }
+    CHECK_EQUAL(balancing.pumpFlowRate, solved.pumpFlowRate);
+    CHECK_EQUAL(balancing.pumpHead, solved.pumpHead);
+
+    for (size_t i = 0; i < original.segments.size(); ++i)
+    {
+        const size_t composite = indexById(reduced, COMPOSITE_OF[i]);
+        CHECK_EQUAL(balancing.circulationFlowRates[i], solved.circulationFlowRates[composite]);
+        CHECK(balancing.returnInletTemperatures[i] >= balancing.returnTemperatures[i]);
+    }
+
+    // Extrémités de chaîne : entrée retour du dernier tronçon, sortie retour du premier
+    for (const auto& chain : { std::vector<std::string>({ "source", "col1", "col2", "palier" }),
+                               std::vector<std::string>({ "B", "B2" }) })
+    {
+        const size_t composite = indexById(reduced, chain.back());
+        CHECK_NEAR(balancing.returnTemperatures[indexById(original, chain.front())],
+                   solved.returnTemperatures[composite], 1e-12);
+        CHECK_NEAR(balancing.returnInletTemperatures[indexById(original, chain.back())],
+                   solved.returnInletTemperatures[composite], 1e-12);
+        for (size_t k = 1; k < chain.size(); ++k)
+        {
+            CHECK_NEAR(balancing.returnTemperatures[indexById(original, chain[k])],
+                       balancing.returnInletTemperatures[indexById(original, chain[k - 1])], 1e-12);
+        }
+    }
+
+    // Résultat déjà reporté (ou d'un autre réseau) : tailles incohérentes, laissé tel quel
+    LoopBalancingResult again = balancing;
+    reduction.expand(again);
+    CHECK(again.circulationFlowRates == balancing.circulationFlowRates);
+    CHECK(again.returnTemperatures == balancing.returnTemperatures);
+    CHECK(again.returnInletTemperatures == balancing.returnInletTemperatures);
+}
+
+// Tronçon de longueur nulle portant un dénivelé (colonne montante) fusionné avec une antenne :
+// chaque tronçon garde sa propre hauteur, l'antenne n'hérite pas de celle de la colonne
+TEST(NetworkReduction_ZeroLengthPartKeepsItsHeight)
+{
+    NetworkCalculationParameters direct;
+    direct.networkType = NetworkType::ColdWater;
+    direct.supplyPressure = 3.0;
+    direct.requiredPressure = 1.0;
+    NetworkSegment riser("colonne", "colonne");
+    riser.length = 0.0;
+    riser.heightDifference = 3.0;
+    NetworkSegment branch("A", "A");
+    branch.parentId = "colonne";
+    branch.length = 6.0;
+    branch.fixtures = { Fixture(FixtureType::Shower, 1), Fixture(FixtureType::WashBasin, 2) };
+    direct.segments = { riser, branch };
+    NetworkCalculationParameters original = direct;
+
+    PipeCalculator calculator;
+    calculator.calculateNetwork(direct);
+
+    NetworkReduction reduction(original);
+    CHECK_EQUAL(reduction.getReducedCount(), size_t(1));
+    calculator.calculateNetwork(reduction.reducedParameters());
+    reduction.expand(original);
+
+    const NetworkSegment& composite = reduction.reducedParameters().segments.front();
+    const NetworkSegment& expandedRiser = original.segments[0];
+    const NetworkSegment& expandedBranch = original.segments[1];
+    CHECK_NEAR(expandedRiser.result.pressureDrop, 3.0, 1e-12);
+    CHECK_NEAR(expandedBranch.result.details.heightPressureDrop, 0.0, 1e-12);
+    CHECK_NEAR(expandedBranch.result.pressureDrop,
+               composite.result.details.linearPressureDrop + composite.result.details.singularPressureDrop, 1e-9);
+    CHECK_NEAR(expandedRiser.outletPressure, expandedBranch.inletPressure, 1e-12);
+    CHECK_NEAR(expandedBranch.outletPressure, composite.outletPressure, 1e-9);
+    for (size_t i = 0; i < direct.segments.size(); ++i)
+    {
+        CHECK_NEAR(original.segments[i].result.pressureDrop, direct.segments[i].result.pressureDrop, 1e-9);
+        CHECK_NEAR(original.segments[i].outletPressure, direct.segments[i].outletPressure, 1e-9);
+    }
+}
+
+// Boucle de parents (schéma incohérent) : aucun tronçon de la boucle ne serait reporté, la
+// réduction est refusée
+TEST(NetworkReduction_ParentCycleThrows)
+{
+    NetworkCalculationParameters params = chainNetwork(NetworkType::ColdWater);
+    params.segments[0].parentId = "palier";  // source → col1 → col2 → palier → source
+
+    bool thrown = false;
+    try
+    {
+        NetworkReduction reduction(params);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    // Boucle isolée à côté d'un réseau valide : refusée aussi
+    NetworkCalculationParameters partial = chainNetwork(NetworkType::ColdWater);
+    NetworkSegment loopA("boucleA", "boucleA");
+    loopA.parentId = "boucleB";
+    NetworkSegment loopB("boucleB", "boucleB");
+    loopB.parentId = "boucleA";
+    partial.segments.push_back(loopA);
+    partial.segments.push_back(loopB);
+
+    bool partialThrown = false;
+    try
+    {
+        NetworkReduction reduction(partial);
+    }
+    catch (const std::runtime_error&)
+    {
+        partialThrown = true;
+    }
+    CHECK(partialThrown);
+}
@@ -0,0 +1,74 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/NetworkTree.h"
+#include <string>
+#include <vector>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    NetworkSegment segment(const std::string& id, const std::string& parentId)
+    {
+        NetworkSegment result(id, id);
+        result.parentId = parentId;
+        return result;
+    }
+
+    std::vector<std::string> ids(const std::vector<NetworkSegment>& segments, const std::vector<size_t>& order)
+    {
+        std::vector<std::string> result;
+        for (size_t i : order)
+            result.push_back(segments[i].id);
+        return result;
+    }
+}
+
+// source → col1 (a1, a2) et col2 (b1), segments dans le désordre des niveaux
+TEST(NetworkTree_TraversalOrders)
+{
+    const std::vector<NetworkSegment> segments = {
+        segment("source", ""), segment("col1", "source"), segment("a1", "col1"),
+        segment("col2", "source"), segment("a2", "col1"), segment("b1", "col2"),
+    };
+    const NetworkTree tree(segments);
+
+    CHECK_EQUAL(tree.size(), segments.size());
+    CHECK_EQUAL(tree.roots().size(), size_t(1));
+    CHECK_EQUAL(tree.find("col2"), size_t(3));
+    CHECK_EQUAL(tree.find("absent"), NetworkTree::None);
+    CHECK_EQUAL(tree.parent(0), NetworkTree::None);
+    CHECK_EQUAL(tree.parent(4), size_t(1));
+    CHECK_EQUAL(tree.children(1).size(), size_t(2));
+    CHECK(tree.isLeaf(2));
+    CHECK(!tree.isLeaf(3));
+
+    const std::vector<std::string> pre = { "source", "col1", "a1", "a2", "col2", "b1" };
+    const std::vector<std::string> post = { "a1", "a2", "col1", "b1", "col2", "source" };
+    const std::vector<std::string> breadth = { "source", "col1", "col2", "a1", "a2", "b1" };
+    CHECK(ids(segments, tree.preOrder()) == pre);
+    CHECK(ids(segments, tree.postOrder()) == post);
+    CHECK(ids(segments, tree.breadthFirstOrder()) == breadth);
+}
+
+// Parent introuvable ou boucle de parents : ni racine ni dans un parcours ; doublon :
+// le premier segment de l'identifiant
+TEST(NetworkTree_OrphansCyclesAndDuplicates)
+{
+    const std::vector<NetworkSegment> segments = {
+        segment("source", ""), segment("orphelin", "absent"), segment("enfantOrphelin", "orphelin"),
+        segment("boucleA", "boucleB"), segment("boucleB", "boucleA"), segment("double", "source"),
+        segment("double", "source"),
+    };
+    const NetworkTree tree(segments);
+
+    CHECK_EQUAL(tree.roots().size(), size_t(1));
+    CHECK_EQUAL(tree.parent(1), NetworkTree::None);
+    CHECK_EQUAL(tree.parent(2), size_t(1));
+    CHECK_EQUAL(tree.parent(3), size_t(4));
+    CHECK_EQUAL(tree.find("double"), size_t(5));
+
+    const std::vector<std::string> reachable = { "source", "double", "double" };
+    CHECK(ids(segments, tree.preOrder()) == reachable);
+    CHECK_EQUAL(tree.postOrder().size(), size_t(3));
+    CHECK(ids(segments, tree.breadthFirstOrder()) == reachable);
+}
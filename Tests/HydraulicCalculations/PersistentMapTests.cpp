@@ -0,0 +1,175 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/PersistentMap.h"
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    // 32 valeurs de hachage : les clés descendent jusqu'aux nœuds de collision
+    struct CollidingHash
+    {
+        std::size_t operator()(const std::string& key) const { return std::hash<std::string>()(key) & 0x1F; }
+    };
+
+    // 10 premiers bits consommés nuls : toutes les clés partagent le début du chemin
+    struct SharedPrefixHash
+    {
+        std::size_t operator()(const std::string& key) const { return std::hash<std::string>()(key) & ~std::size_t(0x3FF); }
+    };
+
+    using Reference = std::map<std::string, std::shared_ptr<const int>>;
+    using Change = std::tuple<std::string, const int*, const int*>;
+
+    template <class Map>
+    void checkSameContent(const Map& map, const Reference& reference, const std::vector<std::string>& keys)
+    {
+        CHECK_EQUAL(map.size(), reference.size());
+        CHECK_EQUAL(map.empty(), reference.empty());
+
+        int mismatches = 0;
+        for (const std::string& key : keys)
+        {
+            auto it = reference.find(key);
+            const auto expected = (it != reference.end()) ? it->second : nullptr;
+            if (map.find(key) != expected)
+                ++mismatches;
+        }
+        CHECK_EQUAL(mismatches, 0);
+
+        Reference visited;
+        map.forEach([&](const std::string& key, const int& value) {
+            auto it = reference.find(key);
+            if (it == reference.end() || &value != it->second.get() || !visited.emplace(key, it->second).second)
+                ++mismatches;
+        });
+        CHECK_EQUAL(mismatches, 0);
+        CHECK_EQUAL(visited.size(), reference.size());
+    }
+
+    // Différences attendues entre deux états de référence (pointeurs de valeur distincts)
+    std::map<std::string, Change> referenceDiff(const Reference& before, const Reference& after)
+    {
+        std::map<std::string, Change> changes;
+        for (const auto& entry : before)
+        {
+            auto it = after.find(entry.first);
+            const int* next = (it != after.end()) ? it->second.get() : nullptr;
+            if (next != entry.second.get())
+                changes[entry.first] = Change(entry.first, entry.second.get(), next);
+        }
+        for (const auto& entry : after)
+        {
+            if (!before.count(entry.first))
+                changes[entry.first] = Change(entry.first, nullptr, entry.second.get());
+        }
+        return changes;
+    }
+
+    // 20 000 ajouts, remplacements et suppressions aléatoires comparés à std::map ; les versions
+    // intermédiaires conservées restent inchangées et leur diff avec la version courante est exact
+    template <class Hash>
+    void checkAgainstStdMap(unsigned seed)
+    {
+        using Map = PersistentMap<int, Hash>;
+
+        std::mt19937 random(seed);
+        std::vector<std::string> keys;
+        for (int k = 0; k < 1500; ++k)
+            keys.push_back("tronçon " + std::to_string(k));
+        keys.push_back(std::string());  // Clé vide
+
+        Map map;
+        Reference reference;
+        std::vector<std::pair<Map, Reference>> versions = { { map, reference } };
+
+        for (int step = 1; step <= 20000; ++step)
+        {
+            const std::string& key = keys[random() % keys.size()];
+            if (random() % 5 < 3)
+            {
+                auto value = std::make_shared<const int>(step);
+                map = map.set(key, value);
+                reference[key] = value;
+            }
+            else
+            {
+                map = map.erase(key);
+                reference.erase(key);
+            }
+            if (map.size() != reference.size())
+            {
+                CHECK_EQUAL(map.size(), reference.size());
+                return;
+            }
+
+            // Même valeur : table inchangée
+            if (step % 97 == 0 && !reference.empty())
+            {
+                const auto& entry = *reference.begin();
+                CHECK_EQUAL(map.set(entry.first, entry.second).size(), map.size());
+                map.set(entry.first, entry.second).diff(map, [&](const std::string&, const typename Map::ValuePtr&,
+                                                                 const typename Map::ValuePtr&) { CHECK(false); });
+            }
+
+            if (step % 2000 == 0)
+            {
+                checkSameContent(map, reference, keys);
+                versions.emplace_back(map, reference);
+            }
+        }
+
+        // Versions conservées intactes, diff exact avec la version finale dans les deux sens
+        for (const auto& version : versions)
+        {
+            checkSameContent(version.first, version.second, keys);
+
+            std::map<std::string, Change> expected = referenceDiff(version.second, reference);
+            std::map<std::string, Change> actual;
+            int duplicates = 0;
+            version.first.diff(map, [&](const std::string& key, const typename Map::ValuePtr& before,
+                                        const typename Map::ValuePtr& after) {
+                if (!actual.emplace(key, Change(key, before.get(), after.get())).second)
+                    ++duplicates;
+            });
+            CHECK_EQUAL(duplicates, 0);
+            CHECK(actual == expected);
+
+            std::map<std::string, Change> reversed;
+            map.diff(version.first, [&](const std::string& key, const typename Map::ValuePtr& before,
+                                        const typename Map::ValuePtr& after) {
+                reversed.emplace(key, Change(key, before.get(), after.get()));
+            });
+            CHECK(reversed == referenceDiff(reference, version.second));
+        }
+
+        // Vidage complet
+        for (const std::string& key : keys)
+            map = map.erase(key);
+        CHECK(map.empty());
+        checkSameContent(map, Reference(), keys);
+    }
+}
+
+TEST(PersistentMap_MatchesStdMap)
+{
+    checkAgainstStdMap<std::hash<std::string>>(38);
+}
+
+// Nœuds de collision (hachage complet identique) : recherche, remplacement et suppression
+// linéaires, remontée d'une feuille restée seule
+TEST(PersistentMap_MatchesStdMapWithHashCollisions)
+{
+    checkAgainstStdMap<CollidingHash>(381);
+}
+
+// Préfixe de hachage commun : sous-nœuds créés puis réduits dès la racine
+TEST(PersistentMap_MatchesStdMapWithSharedHashPrefix)
+{
+    checkAgainstStdMap<SharedPrefixHash>(382);
+}
@@ -0,0 +1,239 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/PipeCalculator.h"
+#include "../../Modules/HydraulicCalculations/CalculationCache.h"
+#include <string>
+#include <vector>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    // Immeuble de trois étages : colonne bouclée, paliers avec appareils, antennes non bouclées
+    // de profondeurs différentes (une antenne en deux tronçons) ; segments donnés hors ordre
+    NetworkCalculationParameters mixedNetwork(bool temperatureDependent = true)
+    {
+        NetworkCalculationParameters params;
+        params.temperatureDependentProperties = temperatureDependent;
+        params.supplyPressure = 2.0;
+        params.requiredPressure = 1.0;
+        params.waterTemperature = 60.0;
+
+        auto add = [&params](const std::string& id, const std::string& parentId, double length, double height,
+                             bool looped, std::vector<Fixture> fixtures)
+        {
+            NetworkSegment segment(id, id);
+            segment.parentId = parentId;
+            segment.length = length;
+            segment.heightDifference = height;
+            segment.hasReturnLine = looped;
+            segment.fixtures = std::move(fixtures);
+            params.segments.push_back(segment);
+        };
+        add("colonne", "", 12.0, 0.0, true, {});
+        add("etage1", "colonne", 3.0, 3.0, true, { Fixture(FixtureType::Sink, 1) });
+        add("sdb1", "etage1", 5.0, 0.0, false, { Fixture(FixtureType::Shower, 1), Fixture(FixtureType::WashBasin, 1) });
+        add("etage3", "etage2", 3.0, 3.0, true, {});
+        add("etage2", "etage1", 3.0, 3.0, true, { Fixture(FixtureType::WC, 2) });
+        add("couloir3", "etage3", 4.0, 0.0, false, {});
+        add("sdb3", "couloir3", 6.0, 0.5, false, { Fixture(FixtureType::Bathtub, 1), Fixture(FixtureType::WashBasin, 2) });
+        add("cuisine3", "etage3", 7.0, 0.0, false, { Fixture(FixtureType::Sink, 1), Fixture(FixtureType::Dishwasher, 1) });
+        add("sdb2", "etage2", 4.0, 0.0, false, { Fixture(FixtureType::Shower, 2) });
+        return params;
+    }
+
+    // Même réseau calculé seul, avec hasReturnLine fixé selon le type comme le fait le calcul combiné
+    NetworkCalculationParameters separateNetwork(NetworkType type, bool temperatureDependent = true)
+    {
+        NetworkCalculationParameters params = mixedNetwork(temperatureDependent);
+        params.networkType = type;
+        for (NetworkSegment& segment : params.segments)
+            segment.hasReturnLine = (type == NetworkType::HotWaterWithLoop);
+        PipeCalculator calculator;
+        calculator.calculateNetwork(params);
+        return params;
+    }
+
+    void checkSameDetails(const CalculationDetails& actual, const CalculationDetails& expected)
+    {
+        CHECK_EQUAL(actual.totalFixtureFlowRate, expected.totalFixtureFlowRate);
+        CHECK_EQUAL(actual.totalFixtures, expected.totalFixtures);
+        CHECK_EQUAL(actual.simultaneityCoeff, expected.simultaneityCoeff);
+        CHECK_EQUAL(actual.crossSection, expected.crossSection);
+        CHECK_EQUAL(actual.reynolds, expected.reynolds);
+        CHECK_EQUAL(actual.isLaminar, expected.isLaminar);
+        CHECK_EQUAL(actual.lambda, expected.lambda);
+        CHECK(actual.frictionModel == expected.frictionModel);
+        CHECK_EQUAL(actual.roughness, expected.roughness);
+        CHECK_EQUAL(actual.relativeRoughness, expected.relativeRoughness);
+        CHECK_EQUAL(actual.linearPressureDrop, expected.linearPressureDrop);
+        CHECK_EQUAL(actual.singularPressureDrop, expected.singularPressureDrop);
+        CHECK_EQUAL(actual.heightPressureDrop, expected.heightPressureDrop);
+        CHECK_EQUAL(actual.r1, expected.r1);
+        CHECK_EQUAL(actual.r2, expected.r2);
+        CHECK_EQUAL(actual.thermalResistanceInsul, expected.thermalResistanceInsul);
+        CHECK_EQUAL(actual.thermalResistanceExt, expected.thermalResistanceExt);
+        CHECK_EQUAL(actual.heatLossPerMeter, expected.heatLossPerMeter);
+        CHECK_EQUAL(actual.temperatureDrop, expected.temperatureDrop);
+    }
+
+    void checkSameSegment(const NetworkSegment& actual, const NetworkSegment& expected)
+    {
+        const PipeSegmentResult& a = actual.result;
+        const PipeSegmentResult& e = expected.result;
+        CHECK_EQUAL(actual.id, expected.id);
+        CHECK_EQUAL(actual.hasReturnLine, expected.hasReturnLine);
+        CHECK_EQUAL(a.flowRate, e.flowRate);
+        CHECK_EQUAL(a.velocity, e.velocity);
+        CHECK_EQUAL(a.pressureDrop, e.pressureDrop);
+        CHECK_EQUAL(a.nominalDiameter, e.nominalDiameter);
+        CHECK_EQUAL(a.actualDiameter, e.actualDiameter);
+        CHECK_EQUAL(a.hasReturn, e.hasReturn);
+        CHECK_EQUAL(a.returnFlowRate, e.returnFlowRate);
+        CHECK_EQUAL(a.returnVelocity, e.returnVelocity);
+        CHECK_EQUAL(a.returnNominalDiameter, e.returnNominalDiameter);
+        CHECK_EQUAL(a.returnActualDiameter, e.returnActualDiameter);
+        CHECK_EQUAL(a.heatLoss, e.heatLoss);
+        CHECK_EQUAL(a.returnTemperature, e.returnTemperature);
+        CHECK_EQUAL(a.inletTemperature, e.inletTemperature);
+        CHECK_EQUAL(a.outletTemperature, e.outletTemperature);
+        CHECK_EQUAL(a.returnInletTemperature, e.returnInletTemperature);
+        CHECK_EQUAL(a.returnOutletTemperature, e.returnOutletTemperature);
+        CHECK_EQUAL(int(a.diagnostics.getMask()), int(e.diagnostics.getMask()));
+        CHECK_EQUAL(a.diagnostics.getAvailablePressure(), e.diagnostics.getAvailablePressure());
+        CHECK_EQUAL(a.diagnostics.formatRecommendation(), e.diagnostics.formatRecommendation());
+        checkSameDetails(a.details, e.details);
+        CHECK_EQUAL(actual.inletPressure, expected.inletPressure);
+        CHECK_EQUAL(actual.outletPressure, expected.outletPressure);
+    }
+
+    const NetworkSegment& segmentById(const NetworkCalculationParameters& params, const std::string& id)
+    {
+        for (const NetworkSegment& segment : params.segments)
+        {
+            if (segment.id == id)
+                return segment;
+        }
+        return params.segments.front();
+    }
+}
+
+// Calcul combiné = trois calculs séparés, au bit près : résultats de chaque tronçon (détails et
+// diagnostics compris), pressions propagées, longueur de boucle ; hasReturnLine du réseau de base
+// (bouclage partiel) remplacé selon le type. Propriétés de l'eau constantes : λ évalué une fois
+// pour les trois réseaux sur les tronçons de même DN.
+TEST(PipeCalculator_AllNetworksMatchSeparateCalculations)
+{
+    for (bool temperatureDependent : { true, false })
+    {
+        PipeCalculator calculator;
+        const MultiNetworkResult combined = calculator.calculateAllNetworks(mixedNetwork(temperatureDependent));
+
+        for (size_t type = 0; type < NetworkTypeCount; ++type)
+        {
+            const NetworkCalculationParameters& network = combined.networks[type];
+            const NetworkCalculationParameters expected = separateNetwork(static_cast<NetworkType>(type),
+                                                                          temperatureDependent);
+            CHECK(network.networkType == static_cast<NetworkType>(type));
+            CHECK_EQUAL(network.loopLength, expected.loopLength);
+            CHECK_EQUAL(network.segments.size(), expected.segments.size());
+            for (size_t i = 0; i < network.segments.size() && i < expected.segments.size(); ++i)
+                checkSameSegment(network.segments[i], expected.segments[i]);
+        }
+        CHECK_NEAR(combined.get(NetworkType::ColdWater).loopLength, 47.0, 1e-12);
+    }
+}
+
+// Un réseau déjà en cache : repris tel quel, seuls les deux autres sont calculés
+TEST(PipeCalculator_AllNetworksComputeOnlyCacheMisses)
+{
+    CalculationCache cache;
+    PipeCalculator calculator;
+    calculator.setResultCache(&cache);
+
+    NetworkCalculationParameters hot = mixedNetwork();
+    hot.networkType = NetworkType::HotWater;
+    for (NetworkSegment& segment : hot.segments)
+        segment.hasReturnLine = false;
+    calculator.calculateNetwork(hot);
+    CHECK_EQUAL(cache.statistics().misses, std::uint64_t(1));
+
+    const MultiNetworkResult combined = calculator.calculateAllNetworks(mixedNetwork());
+    CacheStatistics statistics = cache.statistics();
+    CHECK_EQUAL(statistics.memoryHits, std::uint64_t(1));
+    CHECK_EQUAL(statistics.misses, std::uint64_t(3));
+    CHECK_EQUAL(statistics.entries, size_t(3));
+    for (size_t type = 0; type < NetworkTypeCount; ++type)
+    {
+        const NetworkCalculationParameters& network = combined.networks[type];
+        const NetworkCalculationParameters expected = separateNetwork(static_cast<NetworkType>(type));
+        CHECK_EQUAL(network.segments.size(), expected.segments.size());
+        for (size_t i = 0; i < network.segments.size() && i < expected.segments.size(); ++i)
+            checkSameSegment(network.segments[i], expected.segments[i]);
+    }
+
+    calculator.calculateAllNetworks(mixedNetwork());
+    statistics = cache.statistics();
+    CHECK_EQUAL(statistics.memoryHits, std::uint64_t(4));
+    CHECK_EQUAL(statistics.misses, std::uint64_t(3));
+}
+
+// Valeurs de référence du calcul combiné (PASSE 5 : pressions propagées de la racine aux feuilles
+// avec les pertes recalculées à la température moyenne en ECS ; PASSE 6 : diagnostics)
+TEST(PipeCalculator_AllNetworksReferenceValues)
+{
+    PipeCalculator calculator;
+    const MultiNetworkResult combined = calculator.calculateAllNetworks(mixedNetwork());
+
+    for (const NetworkCalculationParameters& network : combined.networks)
+    {
+        for (const NetworkSegment& segment : network.segments)
+        {
+            // Pression d'entrée = pression de sortie du parent, sortie = entrée - pertes
+            const double parentOutlet = segment.parentId.empty() ? network.supplyPressure
+                                                                 : segmentById(network, segment.parentId).outletPressure;
+            CHECK_NEAR(segment.inletPressure, parentOutlet, 1e-12);
+            CHECK_NEAR(segment.outletPressure, segment.inletPressure - segment.result.pressureDrop / 10.0, 1e-12);
+            CHECK_EQUAL(segment.result.diagnostics.has(DiagnosticCode::InsufficientPressure),
+                        segment.outletPressure < network.requiredPressure);
+        }
+    }
+
+    const NetworkCalculationParameters& cold = combined.get(NetworkType::ColdWater);
+    const NetworkCalculationParameters& hot = combined.get(NetworkType::HotWater);
+    const NetworkCalculationParameters& looped = combined.get(NetworkType::HotWaterWithLoop);
+
+    // Eau froide : pertes à 10 °C ; DN des antennes du dernier étage
+    CHECK_EQUAL(segmentById(cold, "colonne").result.nominalDiameter, 42);
+    CHECK_EQUAL(segmentById(cold, "sdb3").result.nominalDiameter, 28);
+    CHECK_EQUAL(segmentById(cold, "cuisine3").result.nominalDiameter, 16);
+    CHECK_NEAR(segmentById(cold, "colonne").outletPressure, 1.861379808, 1e-6);
+    CHECK_NEAR(segmentById(cold, "etage2").outletPressure, 1.206638213, 1e-6);
+    CHECK_NEAR(segmentById(cold, "sdb3").inletPressure, 0.832609302, 1e-6);
+    CHECK_NEAR(segmentById(cold, "sdb3").outletPressure, 0.704577589, 1e-6);
+    CHECK_NEAR(segmentById(cold, "cuisine3").outletPressure, 0.584962443, 1e-6);
+
+    // ECS : eau plus fluide, pertes plus faibles à DN égaux
+    CHECK_NEAR(segmentById(hot, "colonne").outletPressure, 1.888712088, 1e-6);
+    CHECK_NEAR(segmentById(hot, "etage2").outletPressure, 1.244909144, 1e-6);
+    CHECK_NEAR(segmentById(hot, "sdb3").outletPressure, 0.774914099, 1e-6);
+    CHECK_NEAR(segmentById(hot, "cuisine3").outletPressure, 0.692306968, 1e-6);
+
+    // ECS bouclée : DN relevés sur la colonne et sur l'antenne de cuisine
+    CHECK_EQUAL(segmentById(looped, "colonne").result.nominalDiameter, 54);
+    CHECK_EQUAL(segmentById(looped, "cuisine3").result.nominalDiameter, 18);
+    CHECK_NEAR(segmentById(looped, "colonne").outletPressure, 1.969483768, 1e-6);
+    CHECK_NEAR(segmentById(looped, "etage2").outletPressure, 1.345874220, 1e-6);
+    CHECK_NEAR(segmentById(looped, "sdb3").outletPressure, 0.875876756, 1e-6);
+    CHECK_NEAR(segmentById(looped, "cuisine3").inletPressure, 1.028491544, 1e-6);
+    CHECK_NEAR(segmentById(looped, "cuisine3").outletPressure, 0.904770157, 1e-6);
+    CHECK_NEAR(segmentById(looped, "colonne").result.returnOutletTemperature, 57.926419218, 1e-6);
+    CHECK(!segmentById(looped, "colonne").result.diagnostics.has(DiagnosticCode::LowReturnTemperature));
+
+    // Pression insuffisante au dernier étage seulement, dans les trois réseaux
+    for (const NetworkCalculationParameters* network : { &cold, &hot, &looped })
+    {
+        CHECK(!segmentById(*network, "etage2").result.diagnostics.has(DiagnosticCode::InsufficientPressure));
+        CHECK(segmentById(*network, "sdb3").result.diagnostics.has(DiagnosticCode::InsufficientPressure));
+        CHECK(segmentById(*network, "cuisine3").result.diagnostics.has(DiagnosticCode::InsufficientPressure));
+    }
+}
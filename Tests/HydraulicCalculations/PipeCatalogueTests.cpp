@@ -0,0 +1,237 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/PipeCalculator.h"
+#include "../../Modules/HydraulicCalculations/PipeCatalogue.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    const PipeMaterial MATERIALS[] = { PipeMaterial::Copper, PipeMaterial::PEX, PipeMaterial::Multilayer, PipeMaterial::Steel };
+
+    // Catalogue temporaire, supprimé à la fin du test
+    struct TemporaryFile
+    {
+        std::string path;
+
+        explicit TemporaryFile(const std::string& content)
+            : path("pipe_catalogue_test_" + std::to_string(std::rand()) + ".csv")
+        {
+            std::ofstream(path, std::ios::binary) << content;
+        }
+        ~TemporaryFile() { std::remove(path.c_str()); }
+    };
+
+    // Indice de la série active du matériau dans getAllSeries()
+    size_t activeIndex(PipeMaterial material)
+    {
+        const PipeCatalogue& catalogue = PipeCatalogue::instance();
+        const PipeSeries* active = &catalogue.getSeries(material);
+        for (size_t i = 0; i < catalogue.getAllSeries().size(); ++i)
+        {
+            if (&catalogue.getAllSeries()[i] == active)
+                return i;
+        }
+        return static_cast<size_t>(-1);
+    }
+
+    // Le catalogue est partagé : les séries actives sont rétablies à la fin du test
+    struct ActiveSeriesGuard
+    {
+        size_t saved[PipeMaterialCount];
+
+        ActiveSeriesGuard()
+        {
+            for (PipeMaterial material : MATERIALS)
+                saved[static_cast<size_t>(material)] = activeIndex(material);
+        }
+        ~ActiveSeriesGuard()
+        {
+            for (PipeMaterial material : MATERIALS)
+                PipeCatalogue::instance().setActiveSeries(material, saved[static_cast<size_t>(material)]);
+        }
+    };
+
+    // Sélection d'origine : premier DN ≥ minDiameter dont la vitesse respecte le maximum
+    int linearSelect(const PipeSeries& series, double flowRate, double maxVelocity, int minDiameter)
+    {
+        PipeCalculator calculator;
+        for (size_t i = 0; i < series.sizes.size(); ++i)
+        {
+            if (series.sizes[i].nominalDiameter < minDiameter)
+                continue;
+            if (calculator.calculateVelocity(flowRate, series.sizes[i].internalDiameter) <= maxVelocity)
+                return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    bool loadThrows(const std::string& content)
+    {
+        TemporaryFile file(content);
+        try
+        {
+            PipeCatalogue::instance().loadFromFile(file.path);
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+}
+
+// Recherche dichotomique contre le parcours linéaire qu'elle remplace, sur les quatre séries
+// intégrées : débits de 0 à 3000 L/min, vitesses maximales et DN minimaux variés (DN de la
+// série, valeurs intermédiaires, au-delà du plus gros DN)
+TEST(PipeCatalogue_SelectIndexMatchesLinearScan)
+{
+    std::mt19937 random(31);
+    std::uniform_real_distribution<double> flowRates(0.0, 3000.0);
+    std::uniform_real_distribution<double> velocities(0.2, 3.0);
+
+    for (size_t s = 0; s < PipeMaterialCount; ++s)
+    {
+        const PipeSeries& series = PipeCatalogue::instance().getAllSeries()[s];
+        CHECK(series.material == MATERIALS[s]);
+
+        std::vector<int> minDiameters = { 0, 1, series.nominalDiameters.back() + 1 };
+        for (int dn : series.nominalDiameters)
+        {
+            minDiameters.push_back(dn);
+            minDiameters.push_back(dn + 1);
+        }
+
+        int mismatches = 0;
+        for (int i = 0; i < 20000; ++i)
+        {
+            const double flowRate = (i % 100 == 0) ? 0.0 : flowRates(random);
+            const double maxVelocity = velocities(random);
+            const int minDiameter = minDiameters[random() % minDiameters.size()];
+            const int expected = linearSelect(series, flowRate, maxVelocity, minDiameter);
+            if (series.selectIndex(flowRate, maxVelocity, minDiameter) != expected && ++mismatches <= 3)
+                CHECK_EQUAL(series.selectIndex(flowRate, maxVelocity, minDiameter), expected);
+        }
+        CHECK_EQUAL(mismatches, 0);
+
+        // Bornes : débit nul → premier DN admis, débit trop fort → aucun
+        CHECK_EQUAL(series.selectIndex(0.0, 2.0), 0);
+        CHECK_EQUAL(series.selectIndex(1e9, 2.0), -1);
+        CHECK_EQUAL(series.selectIndex(0.0, 2.0, series.nominalDiameters.back() + 1), -1);
+    }
+}
+
+// Fichier fabricant : BOM, en-tête, commentaires, virgule décimale, lignes dans le désordre ;
+// chaque série chargée devient la série active de son matériau
+TEST(PipeCatalogue_LoadsSeriesFromFile)
+{
+    ActiveSeriesGuard guard;
+    PipeCatalogue& catalogue = PipeCatalogue::instance();
+    const size_t seriesBefore = catalogue.getAllSeries().size();
+
+    TemporaryFile file("\xEF\xBB\xBF" "Série;Matériau;Rugosité (mm);DN;D int (mm)\r\n"
+                       "# Multicouche fabricant\r\n"
+                       "Test Mepla;Multicouche;0,007;20;16\r\n"
+                       "Test Mepla;multicouche;0,007;16;12\r\n"
+                       "\r\n"
+                       "Test Mepla ; MULTICOUCHE ; 0.007 ; 26 ; 20,5\r\n"
+                       "Test Inox;acier;0,015;22;19,6\r\n"
+                       "Test Inox;acier;0,015;28;25,6\r\n");
+    const std::vector<std::string> names = catalogue.loadFromFile(file.path);
+
+    CHECK_EQUAL(names.size(), size_t(2));
+    CHECK_EQUAL(names[0], std::string("Test Mepla"));
+    CHECK_EQUAL(names[1], std::string("Test Inox"));
+    CHECK_EQUAL(catalogue.getAllSeries().size(), seriesBefore + 2);
+
+    const PipeSeries& mepla = catalogue.getSeries(PipeMaterial::Multilayer);
+    CHECK_EQUAL(mepla.name, std::string("Test Mepla"));
+    CHECK_NEAR(mepla.roughness, 0.007, 1e-15);
+    CHECK(mepla.nominalDiameters == std::vector<int>({ 16, 20, 26 }));
+    CHECK(mepla.findSize(26) != nullptr);
+    CHECK_NEAR(mepla.findSize(26)->internalDiameter, 20.5, 1e-12);
+    CHECK(mepla.findSize(25) == nullptr);
+    CHECK_NEAR(mepla.sizes[0].crossSection, 3.14159265358979 * 0.006 * 0.006, 1e-12);
+
+    // Constantes thermiques tabulées pour les diamètres chargés
+    const PipeInsulation* insulation = catalogue.findInsulation(20.5, 13.0);
+    CHECK(insulation != nullptr);
+    if (insulation != nullptr)
+        CHECK_NEAR(insulation->totalResistance, PipeCatalogue::computeInsulation(20.5, 13.0).totalResistance, 1e-12);
+
+    CHECK_EQUAL(catalogue.getSeries(PipeMaterial::Steel).name, std::string("Test Inox"));
+    CHECK_EQUAL(catalogue.getSeries(PipeMaterial::Copper).name, std::string("Cuivre"));
+    CHECK_EQUAL(catalogue.getSeries(PipeMaterial::PEX).name, std::string("PER"));
+
+    // Le dimensionnement utilise la série active
+    PipeCalculator calculator;
+    CHECK(calculator.getAvailableDiameters(PipeMaterial::Multilayer) == std::vector<int>({ 16, 20, 26 }));
+
+    // Une série active incompatible avec le matériau est refusée
+    bool thrown = false;
+    try
+    {
+        catalogue.setActiveSeries(PipeMaterial::Copper, activeIndex(PipeMaterial::Steel));
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+}
+
+// Une ligne ou une série invalide fait rejeter tout le fichier : aucune série ajoutée,
+// séries actives inchangées
+TEST(PipeCatalogue_RejectsInvalidFileWithoutPartialUpdate)
+{
+    ActiveSeriesGuard guard;
+    PipeCatalogue& catalogue = PipeCatalogue::instance();
+    const size_t seriesBefore = catalogue.getAllSeries().size();
+    size_t activeBefore[PipeMaterialCount];
+    for (PipeMaterial material : MATERIALS)
+        activeBefore[static_cast<size_t>(material)] = activeIndex(material);
+
+    const char* const invalidFiles[] = {
+        // Matériau inconnu
+        "Série;Matériau;Rugosité;DN;D int\nTest;cuivre;0,0015;12;10\nTest Inox;inox;0,015;22;19,6\n",
+        // Diamètres intérieurs non croissants avec le DN (la première série est valide)
+        "Test Cu;cuivre;0,0015;12;10\nTest Cu;cuivre;0,0015;14;12\nTest PER;per;0,007;16;12\nTest PER;per;0,007;20;11,5\n",
+        // DN en double
+        "Test PER;per;0,007;16;12\nTest PER;per;0,007;16;12,5\n",
+        // Diamètre intérieur nul
+        "Test PER;per;0,007;16;0\n",
+        // Nombre de champs
+        "Test PER;per;0,007;16;12\nTest PER;per;0,007;20\n",
+        // Nombre illisible après la première ligne de données
+        "Test PER;per;0,007;16;12\nTest PER;per;0,007;20;15,x\n",
+        // Nombre illisible sur la première ligne de données (pas un en-tête)
+        "Test PER;per;0,007;16;12,x\nTest PER;per;0,007;20;15\n",
+        // En-tête seul
+        "\xEF\xBB\xBF" "Série;Matériau;Rugosité;DN;D int\n# vide\n",
+    };
+
+    for (const char* content : invalidFiles)
+    {
+        CHECK(loadThrows(content));
+        CHECK_EQUAL(catalogue.getAllSeries().size(), seriesBefore);
+        for (PipeMaterial material : MATERIALS)
+            CHECK_EQUAL(activeIndex(material), activeBefore[static_cast<size_t>(material)]);
+    }
+
+    bool missingThrown = false;
+    try
+    {
+        catalogue.loadFromFile("introuvable/catalogue_tubes.csv");
+    }
+    catch (const std::runtime_error&)
+    {
+        missingThrown = true;
+    }
+    CHECK(missingThrown);
+}
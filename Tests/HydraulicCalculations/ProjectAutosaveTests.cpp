@@ -0,0 +1,222 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/ProjectAutosave.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    NetworkState withSegment(const NetworkState& state, const std::string& id, double length)
+    {
+        SegmentSnapshot snapshot;
+        snapshot.segment = NetworkSegment(id, id);
+        snapshot.segment.length = length;
+        snapshot.end = SchemaPoint(length, 0.0);
+
+        NetworkState next = state;
+        next.segments = state.segments.set(id, std::make_shared<const SegmentSnapshot>(snapshot));
+        return next;
+    }
+
+    std::uintmax_t journalSize(const std::string& projectPath)
+    {
+        std::error_code error;
+        return std::filesystem::file_size(ProjectAutosave::journalPath(projectPath), error);
+    }
+
+    const SegmentSnapshot* findSegment(const ProjectData& project, const std::string& id)
+    {
+        for (const SegmentSnapshot& snapshot : project.segments)
+        {
+            if (snapshot.segment.id == id)
+                return &snapshot;
+        }
+        return nullptr;
+    }
+
+    void removeProject(const std::string& path)
+    {
+        std::remove(path.c_str());
+        std::remove(ProjectAutosave::journalPath(path).c_str());
+    }
+
+    // Arrêt brutal simulé : copie du projet et de son journal pendant la session, une fois
+    // les modifications attendues écrites au journal (la session se ferme ensuite normalement)
+    //   projet "crash" : colonne (10 m) et nourrice (2 m) à la séquence 0,
+    //   journal : 1. branche ajoutée (4 m)  2. branche à 6 m, nourrice supprimée
+    std::string crashedProject(const std::string& path)
+    {
+        const std::string crashPath = path + ".crash.tchp";
+        NetworkCalculationParameters parameters;
+        NetworkState state = withSegment(withSegment(NetworkState(), "colonne", 10.0), "nourrice", 2.0);
+        {
+            ProjectAutosave autosave(path, 0);
+            autosave.update(state, parameters);
+            autosave.save();
+
+            state = withSegment(state, "branche", 4.0);
+            autosave.record(state, parameters, { "branche" });
+            state = withSegment(state, "branche", 6.0);
+            state.segments = state.segments.erase("nourrice");
+            autosave.record(state, parameters, { "branche", "nourrice" });
+
+            std::size_t replayed = 0;
+            for (int attempt = 0; attempt < 500 && replayed < 2; ++attempt)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                ProjectAutosave::load(path, &replayed);
+            }
+            CHECK_EQUAL(replayed, size_t(2));
+
+            const auto overwrite = std::filesystem::copy_options::overwrite_existing;
+            std::filesystem::copy_file(path, crashPath, overwrite);
+            std::filesystem::copy_file(ProjectAutosave::journalPath(path), ProjectAutosave::journalPath(crashPath), overwrite);
+        }
+        removeProject(path);
+        return crashPath;
+    }
+}
+
+// Fermeture normale : le journal est intégré au projet, la réouverture ne rejoue rien
+// (le message de récupération n'apparaît qu'après un arrêt brutal)
+TEST(ProjectAutosave_CleanCloseCompactsJournal)
+{
+    const std::string path = "project_autosave_test.tchp";
+    NetworkCalculationParameters parameters;
+
+    NetworkState state = withSegment(NetworkState(), "colonne", 10.0);
+    {
+        ProjectAutosave autosave(path, 0);
+        autosave.update(state, parameters);
+        autosave.save();
+
+        state = withSegment(state, "branche", 4.0);
+        autosave.record(state, parameters, { "branche" });
+        state = withSegment(state, "branche", 6.0);
+        autosave.record(state, parameters, { "branche" });
+    }
+
+    CHECK(journalSize(path) <= 8);  // En-tête seul
+
+    std::size_t replayed = 99;
+    const ProjectData project = ProjectAutosave::load(path, &replayed);
+    CHECK_EQUAL(replayed, size_t(0));
+    CHECK_EQUAL(project.segments.size(), size_t(2));
+    CHECK_EQUAL(project.journalSequence, std::uint64_t(2));
+    for (const SegmentSnapshot& snapshot : project.segments)
+    {
+        if (snapshot.segment.id == "branche")
+            CHECK_NEAR(snapshot.segment.length, 6.0, 1e-12);
+    }
+
+    // Session sans modification : le projet n'est pas réécrit
+    {
+        ProjectAutosave autosave(path, project.journalSequence);
+    }
+    CHECK_EQUAL(ProjectAutosave::load(path, &replayed).segments.size(), size_t(2));
+    CHECK_EQUAL(replayed, size_t(0));
+
+    std::remove(path.c_str());
+    std::remove(ProjectAutosave::journalPath(path).c_str());
+}
+
+// Arrêt brutal : le journal non compacté est rejoué à l'ouverture, suppressions comprises
+TEST(ProjectAutosave_ReplaysJournalAfterCrash)
+{
+    const std::string path = crashedProject("project_autosave_crash.tchp");
+    CHECK(journalSize(path) > 8);
+
+    std::size_t replayed = 0;
+    const ProjectData project = ProjectAutosave::load(path, &replayed);
+    CHECK_EQUAL(replayed, size_t(2));
+    CHECK_EQUAL(project.journalSequence, std::uint64_t(2));
+    CHECK(!project.hasResults);
+    CHECK_EQUAL(project.segments.size(), size_t(2));
+    CHECK(findSegment(project, "nourrice") == nullptr);
+    const SegmentSnapshot* branche = findSegment(project, "branche");
+    CHECK(branche != nullptr);
+    if (branche)
+        CHECK_NEAR(branche->segment.length, 6.0, 1e-12);
+
+    // Reprise de la session : les modifications rejouées sont intégrées au projet à la fermeture
+    {
+        ProjectAutosave autosave(path, project.journalSequence);
+        NetworkState state;
+        for (const SegmentSnapshot& snapshot : project.segments)
+            state.segments = state.segments.set(snapshot.segment.id, std::make_shared<const SegmentSnapshot>(snapshot));
+        state = withSegment(state, "colonne", 12.0);
+        autosave.record(state, project.parameters, { "colonne" });
+    }
+    CHECK(journalSize(path) <= 8);
+    const ProjectData reopened = ProjectAutosave::load(path, &replayed);
+    CHECK_EQUAL(replayed, size_t(0));
+    CHECK_EQUAL(reopened.journalSequence, std::uint64_t(3));
+    CHECK_EQUAL(reopened.segments.size(), size_t(2));
+    const SegmentSnapshot* colonne = findSegment(reopened, "colonne");
+    CHECK(colonne != nullptr);
+    if (colonne)
+        CHECK_NEAR(colonne->segment.length, 12.0, 1e-12);
+
+    removeProject(path);
+}
+
+// Dernier enregistrement incomplet ou altéré (arrêt pendant l'écriture) : il est ignoré,
+// les modifications précédentes sont rejouées
+TEST(ProjectAutosave_IgnoresTornLastRecord)
+{
+    const std::string path = crashedProject("project_autosave_torn.tchp");
+    const std::filesystem::path journal = std::filesystem::u8path(ProjectAutosave::journalPath(path));
+    const std::uintmax_t fullSize = std::filesystem::file_size(journal);
+
+    std::string data;
+    {
+        std::ifstream in(journal, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    auto writeJournal = [&journal](const std::string& content)
+    {
+        std::ofstream out(journal, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+    };
+    auto checkFirstEditOnly = [&path]()
+    {
+        std::size_t replayed = 0;
+        const ProjectData project = ProjectAutosave::load(path, &replayed);
+        CHECK_EQUAL(replayed, size_t(1));
+        CHECK_EQUAL(project.journalSequence, std::uint64_t(1));
+        CHECK_EQUAL(project.segments.size(), size_t(3));
+        CHECK(findSegment(project, "nourrice") != nullptr);
+        const SegmentSnapshot* branche = findSegment(project, "branche");
+        CHECK(branche != nullptr);
+        if (branche)
+            CHECK_NEAR(branche->segment.length, 4.0, 1e-12);
+    };
+
+    // Coupure en cours d'écriture
+    writeJournal(data.substr(0, static_cast<size_t>(fullSize) - 5));
+    checkFirstEditOnly();
+
+    // Octet altéré dans la charge du dernier enregistrement : somme de contrôle fausse
+    std::string altered = data;
+    altered[altered.size() - 3] ^= 0x5A;
+    writeJournal(altered);
+    checkFirstEditOnly();
+
+    // Journal réduit à son en-tête, ou illisible : le projet seul
+    std::size_t replayed = 99;
+    writeJournal(data.substr(0, 8));
+    CHECK_EQUAL(ProjectAutosave::load(path, &replayed).segments.size(), size_t(2));
+    CHECK_EQUAL(replayed, size_t(0));
+    writeJournal("garbage");
+    CHECK_EQUAL(ProjectAutosave::load(path, &replayed).segments.size(), size_t(2));
+    CHECK_EQUAL(replayed, size_t(0));
+
+    removeProject(path);
+}
@@ -0,0 +1,315 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/ProjectFile.h"
+#include "../../Modules/HydraulicCalculations/SensitivityAnalyzer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    // Colonne bouclée de deux étages, calculée (résultats et détails non nuls)
+    NetworkCalculationParameters loopedNetwork()
+    {
+        NetworkCalculationParameters params;
+        params.networkType = NetworkType::HotWaterWithLoop;
+        params.frictionModel = FrictionModel::ColebrookWhite;
+        params.supplyPressure = 3.0;
+        params.waterTemperature = 60.0;
+
+        auto add = [&params](const std::string& id, const std::string& parentId, double length, double height,
+                             std::vector<Fixture> fixtures)
+        {
+            NetworkSegment segment(id, id);
+            segment.parentId = parentId;
+            segment.length = length;
+            segment.heightDifference = height;
+            segment.hasReturnLine = true;
+            segment.fixtures = std::move(fixtures);
+            params.segments.push_back(segment);
+        };
+        add("source", "", 15.0, 0.0, {});
+        add("etage1", "source", 3.0, 3.0, { Fixture(FixtureType::Sink, 1) });
+        add("sdb1", "etage1", 6.0, 0.0, { Fixture(FixtureType::Shower, 1), Fixture(FixtureType::WashBasin, 1) });
+        add("etage2", "etage1", 3.0, 3.0, {});
+        add("sdb2", "etage2", 9.0, 0.5, { Fixture(FixtureType::Bathtub, 1), Fixture(FixtureType::WashBasin, 2) });
+
+        PipeCalculator calculator;
+        calculator.calculateNetwork(params);
+        return params;
+    }
+
+    ProjectData projectOf(const NetworkCalculationParameters& params, bool withResults)
+    {
+        ProjectData project;
+        project.parameters = params;
+        project.parameters.segments.clear();
+        project.hasResults = withResults;
+        project.journalSequence = 7;
+        for (size_t i = 0; i < params.segments.size(); ++i)
+        {
+            SegmentSnapshot snapshot;
+            snapshot.segment = params.segments[i];
+            snapshot.start = SchemaPoint(double(i), 0.0);
+            snapshot.end = SchemaPoint(double(i), 10.0);
+            for (size_t f = 0; f < snapshot.segment.fixtures.size(); ++f)
+                snapshot.fixturePositions.push_back(SchemaPoint(double(i), double(f)));
+            project.segments.push_back(snapshot);
+        }
+        return project;
+    }
+
+    std::string readFile(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const std::string& path, const std::string& data)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    bool opens(const std::string& path)
+    {
+        try
+        {
+            ProjectReader(path).readAll();
+            return true;
+        }
+        catch (const std::runtime_error&)
+        {
+            return false;
+        }
+    }
+}
+
+// Projet calculé enregistré puis relu : tous les résultats reviennent, détails de calcul compris
+// (Re, λ, pertes linéaires et thermiques, utilisés par l'export PDF et l'analyse de sensibilité)
+TEST(ProjectFile_ResultsRoundTrip)
+{
+    const std::string path = "project_file_roundtrip.tchp";
+    const NetworkCalculationParameters params = loopedNetwork();
+    ProjectWriter::write(path, projectOf(params, true));
+
+    const ProjectReader reader(path);
+    CHECK_EQUAL(reader.formatVersion(), ProjectFormat::Version);
+    CHECK(reader.hasResults());
+    CHECK_EQUAL(reader.journalSequence(), std::uint64_t(7));
+    CHECK_EQUAL(reader.segmentCount(), params.segments.size());
+    CHECK(reader.parameters().networkType == NetworkType::HotWaterWithLoop);
+    CHECK(reader.parameters().frictionModel == FrictionModel::ColebrookWhite);
+
+    NetworkCalculationParameters reopened = reader.parameters();
+    for (size_t i = 0; i < reader.segmentCount(); ++i)
+    {
+        const SegmentSnapshot snapshot = reader.segment(i);
+        const NetworkSegment& saved = params.segments[i];
+        const NetworkSegment& loaded = snapshot.segment;
+        CHECK_EQUAL(loaded.id, saved.id);
+        CHECK_EQUAL(loaded.parentId, saved.parentId);
+        CHECK_EQUAL(loaded.fixtures.size(), saved.fixtures.size());
+        CHECK_EQUAL(snapshot.fixturePositions.size(), saved.fixtures.size());
+        CHECK_NEAR(snapshot.end.y, 10.0, 0.0);
+        CHECK_NEAR(loaded.inletPressure, saved.inletPressure, 0.0);
+        CHECK_NEAR(loaded.outletPressure, saved.outletPressure, 0.0);
+
+        const PipeSegmentResult& a = loaded.result;
+        const PipeSegmentResult& b = saved.result;
+        CHECK_NEAR(a.flowRate, b.flowRate, 0.0);
+        CHECK_NEAR(a.pressureDrop, b.pressureDrop, 0.0);
+        CHECK_EQUAL(a.nominalDiameter, b.nominalDiameter);
+        CHECK_EQUAL(a.returnNominalDiameter, b.returnNominalDiameter);
+        CHECK_NEAR(a.heatLoss, b.heatLoss, 0.0);
+        CHECK_NEAR(a.returnOutletTemperature, b.returnOutletTemperature, 0.0);
+        CHECK_EQUAL(a.diagnostics.formatRecommendation(), b.diagnostics.formatRecommendation());
+
+        CHECK(b.details.reynolds > 0.0);
+        CHECK_NEAR(a.details.reynolds, b.details.reynolds, 0.0);
+        CHECK_EQUAL(a.details.isLaminar, b.details.isLaminar);
+        CHECK_NEAR(a.details.lambda, b.details.lambda, 0.0);
+        CHECK(a.details.frictionModel == b.details.frictionModel);
+        CHECK_NEAR(a.details.roughness, b.details.roughness, 0.0);
+        CHECK_NEAR(a.details.linearPressureDrop, b.details.linearPressureDrop, 0.0);
+        CHECK_NEAR(a.details.singularPressureDrop, b.details.singularPressureDrop, 0.0);
+        CHECK_NEAR(a.details.heatLossPerMeter, b.details.heatLossPerMeter, 0.0);
+        CHECK_NEAR(a.details.temperatureDrop, b.details.temperatureDrop, 0.0);
+        reopened.segments.push_back(loaded);
+    }
+
+    // Sensibilités identiques avant enregistrement et après réouverture, sans recalcul
+    SensitivityAnalyzer analyzer;
+    const SensitivityResult before = analyzer.analyze(params, "sdb2");
+    const SensitivityResult after = analyzer.analyze(reopened, "sdb2");
+    CHECK_EQUAL(after.segments.size(), before.segments.size());
+    CHECK_NEAR(after.terminalPressure, before.terminalPressure, 0.0);
+    for (size_t i = 0; i < before.segments.size() && i < after.segments.size(); ++i)
+    {
+        CHECK_NEAR(after.segments[i].pressurePerLength, before.segments[i].pressurePerLength, 0.0);
+        CHECK_NEAR(after.segments[i].pressurePerDiameter, before.segments[i].pressurePerDiameter, 0.0);
+        CHECK_NEAR(after.segments[i].returnTemperaturePerInsulation, before.segments[i].returnTemperaturePerInsulation, 0.0);
+    }
+
+    std::remove(path.c_str());
+}
+
+// Projet sans résultats : les tronçons ne portent que la saisie
+TEST(ProjectFile_WithoutResults)
+{
+    const std::string path = "project_file_noresults.tchp";
+    const NetworkCalculationParameters params = loopedNetwork();
+    ProjectWriter::write(path, projectOf(params, false));
+
+    const ProjectData project = ProjectReader(path).readAll();
+    CHECK(!project.hasResults);
+    CHECK_EQUAL(project.segments.size(), params.segments.size());
+    for (const SegmentSnapshot& snapshot : project.segments)
+    {
+        CHECK_EQUAL(snapshot.segment.result.nominalDiameter, 0);
+        CHECK_NEAR(snapshot.segment.result.details.reynolds, 0.0, 0.0);
+    }
+
+    std::remove(path.c_str());
+}
+
+// En-tête altéré : le fichier est refusé à l'ouverture
+TEST(ProjectFile_RejectsCorruptHeader)
+{
+    const std::string path = "project_file_header.tchp";
+    const std::string corrupt = "project_file_header_corrupt.tchp";
+    ProjectWriter::write(path, projectOf(loopedNetwork(), true));
+    const std::string original = readFile(path);
+    CHECK(opens(path));
+
+    std::string data = original;
+    data[0] = 'X';  // Signature
+    writeFile(corrupt, data);
+    CHECK(!opens(corrupt));
+
+    // Version du format : seule la version courante est lue
+    for (std::uint16_t other : { std::uint16_t(ProjectFormat::Version - 1), std::uint16_t(ProjectFormat::Version + 1) })
+    {
+        data = original;
+        std::memcpy(&data[4], &other, sizeof(other));
+        writeFile(corrupt, data);
+        CHECK(!opens(corrupt));
+    }
+
+    data = original;
+    data[32] = char(NetworkTypeCount);  // Type de réseau inconnu
+    writeFile(corrupt, data);
+    CHECK(!opens(corrupt));
+
+    // Fichier tronqué ou allongé : la taille enregistrée ne correspond plus
+    writeFile(corrupt, original.substr(0, original.size() - 1));
+    CHECK(!opens(corrupt));
+    writeFile(corrupt, original + '\0');
+    CHECK(!opens(corrupt));
+    writeFile(corrupt, original.substr(0, 16));
+    CHECK(!opens(corrupt));
+    writeFile(corrupt, std::string());
+    CHECK(!opens(corrupt));
+
+    // Nombre de tronçons supérieur à l'index présent
+    data = original;
+    const std::uint32_t count = 1000000;
+    std::memcpy(&data[8], &count, sizeof(count));
+    writeFile(corrupt, data);
+    CHECK(!opens(corrupt));
+
+    std::remove(path.c_str());
+    std::remove(corrupt.c_str());
+}
+
+// Index ou enregistrement altéré : l'ouverture réussit (index lu à la demande) mais le
+// tronçon concerné est refusé au lieu d'être décodé n'importe où dans le fichier
+TEST(ProjectFile_RejectsCorruptIndex)
+{
+    const std::string path = "project_file_index.tchp";
+    const std::string corrupt = "project_file_index_corrupt.tchp";
+    ProjectWriter::write(path, projectOf(loopedNetwork(), true));
+    const std::string original = readFile(path);
+    const size_t indexOffset = ProjectFormat::HeaderSize + ProjectFormat::ParametersSize;
+
+    auto withOffset = [&](size_t entry, std::uint64_t offset)
+    {
+        std::string data = original;
+        std::memcpy(&data[indexOffset + entry * sizeof(std::uint64_t)], &offset, sizeof(offset));
+        return data;
+    };
+
+    for (std::uint64_t offset : { std::uint64_t(0), std::uint64_t(indexOffset), std::uint64_t(original.size()),
+                                  std::uint64_t(1) << 40 })
+    {
+        writeFile(corrupt, withOffset(2, offset));
+        const ProjectReader reader(corrupt);
+        bool rejected = false;
+        try
+        {
+            reader.segment(2);
+        }
+        catch (const std::runtime_error&)
+        {
+            rejected = true;
+        }
+        CHECK(rejected);
+        CHECK_EQUAL(reader.segment(1).segment.id, std::string("etage1"));
+    }
+
+    // Taille d'enregistrement hors du fichier ou trop petite
+    std::uint64_t last;
+    std::memcpy(&last, &original[indexOffset + 4 * sizeof(std::uint64_t)], sizeof(last));
+    for (std::uint32_t recordSize : { std::uint32_t(0), std::uint32_t(2), std::uint32_t(0xFFFFFF00u) })
+    {
+        std::string data = original;
+        std::memcpy(&data[static_cast<size_t>(last)], &recordSize, sizeof(recordSize));
+        writeFile(corrupt, data);
+        CHECK(!opens(corrupt));
+    }
+
+    std::remove(path.c_str());
+    std::remove(corrupt.c_str());
+}
+
+// Objectif : un projet de 20 000 tronçons s'ouvre en bien moins d'une seconde
+// (en-tête et index seuls à l'ouverture, lecture complète comprise ici)
+TEST(ProjectFile_Opens20kSegmentsUnderOneSecond)
+{
+    const std::string path = "project_file_20k.tchp";
+    const NetworkCalculationParameters params = loopedNetwork();
+    ProjectData project = projectOf(params, true);
+    const std::vector<SegmentSnapshot> pattern = project.segments;
+    project.segments.clear();
+    for (size_t i = 0; project.segments.size() < 20000; ++i)
+    {
+        SegmentSnapshot snapshot = pattern[i % pattern.size()];
+        snapshot.segment.id = "seg_" + std::to_string(i);
+        snapshot.segment.parentId = i == 0 ? std::string() : "seg_" + std::to_string((i - 1) / 2);
+        project.segments.push_back(snapshot);
+    }
+    ProjectWriter::write(path, project);
+
+    const auto start = std::chrono::steady_clock::now();
+    const ProjectReader reader(path);
+    const double openMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const ProjectData loaded = reader.readAll();
+    const double readMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    CHECK_EQUAL(loaded.segments.size(), size_t(20000));
+    CHECK_EQUAL(loaded.segments.back().segment.id, std::string("seg_19999"));
+    CHECK_NEAR(loaded.segments.back().segment.result.details.lambda,
+               pattern[19999 % pattern.size()].segment.result.details.lambda, 0.0);
+    CHECK(openMs < 1000.0);
+    CHECK(readMs < 1000.0);
+    std::cout << "  20 000 tronçons : ouverture " << openMs << " ms, lecture complète " << readMs << " ms\n";
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,122 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/PipeCalculator.h"
+#include "../../Modules/HydraulicCalculations/SegmentDiagnostics.h"
+#include <string>
+
+using namespace HydraulicCalc;
+
+// Texte de chaque code (arrondi à l'affichage : 2 décimales pour les vitesses, 1 sinon)
+TEST(SegmentDiagnostics_DescribesEachCode)
+{
+    CHECK_EQUAL(SegmentDiagnostics::describe(Diagnostic(DiagnosticCode::HighVelocity, 2.3456, 2.0)),
+                std::string("⚠️ Vitesse élevée (2.35 m/s pour 2.00 m/s max). Risque de bruit."));
+    CHECK_EQUAL(SegmentDiagnostics::describe(Diagnostic(DiagnosticCode::LowVelocity, 0.1234, 0.3)),
+                std::string("⚠️ Vitesse faible (0.12 m/s). Risque de stagnation."));
+    CHECK_EQUAL(SegmentDiagnostics::describe(Diagnostic(DiagnosticCode::InsufficientPressure, 0.84, 1.0)),
+                std::string("❌ Pression insuffisante (0.8 bar disponibles pour 1.0 bar requis)."));
+    CHECK_EQUAL(SegmentDiagnostics::describe(Diagnostic(DiagnosticCode::LowReturnTemperature, 52.26, 55.0)),
+                std::string("❌ Température de retour trop basse (52.3 °C pour 55.0 °C minimum)."));
+}
+
+// Recommandation complète : anomalies dans l'ordre d'ajout, puis rappel de la pression
+// disponible quand elle est suffisante
+TEST(SegmentDiagnostics_FormatsRecommendation)
+{
+    SegmentDiagnostics diagnostics;
+    CHECK(diagnostics.empty());
+    CHECK_EQUAL(int(diagnostics.getMask()), 0);
+    diagnostics.setAvailablePressure(2.46);
+    CHECK_EQUAL(diagnostics.formatRecommendation(), std::string("✓ Pression suffisante (2.5 bar disponibles). "));
+
+    diagnostics.set(DiagnosticCode::HighVelocity, 2.5, 2.0);
+    CHECK(diagnostics.has(DiagnosticCode::HighVelocity));
+    CHECK(!diagnostics.has(DiagnosticCode::LowVelocity));
+    CHECK_EQUAL(int(diagnostics.getMask()), int(SegmentDiagnostics::bit(DiagnosticCode::HighVelocity)));
+    CHECK_EQUAL(diagnostics.formatRecommendation(),
+                std::string("⚠️ Vitesse élevée (2.50 m/s pour 2.00 m/s max). Risque de bruit. "
+                            "✓ Pression suffisante (2.5 bar disponibles). "));
+
+    // Insuffisance de pression : plus de rappel de la pression disponible
+    diagnostics.set(DiagnosticCode::InsufficientPressure, 0.7, 1.0);
+    diagnostics.set(DiagnosticCode::LowReturnTemperature, 50.0, 55.0);
+    CHECK_EQUAL(diagnostics.formatRecommendation(),
+                std::string("⚠️ Vitesse élevée (2.50 m/s pour 2.00 m/s max). Risque de bruit. "
+                            "❌ Pression insuffisante (0.7 bar disponibles pour 1.0 bar requis). "
+                            "❌ Température de retour trop basse (50.0 °C pour 55.0 °C minimum). "));
+
+    // Même code : valeurs remplacées, une seule entrée
+    diagnostics.set(DiagnosticCode::InsufficientPressure, 0.4, 1.5);
+    int count = 0;
+    for (const Diagnostic& diagnostic : diagnostics)
+    {
+        ++count;
+        if (diagnostic.code == DiagnosticCode::InsufficientPressure)
+        {
+            CHECK_EQUAL(diagnostic.value, 0.4);
+            CHECK_EQUAL(diagnostic.limit, 1.5);
+        }
+    }
+    CHECK_EQUAL(count, 3);
+
+    diagnostics.remove(DiagnosticCode::InsufficientPressure);
+    diagnostics.remove(DiagnosticCode::LowVelocity);  // Absent : sans effet
+    CHECK_EQUAL(int(diagnostics.getMask()), int(SegmentDiagnostics::bit(DiagnosticCode::HighVelocity) |
+                                                SegmentDiagnostics::bit(DiagnosticCode::LowReturnTemperature)));
+    CHECK_EQUAL(diagnostics.formatRecommendation(),
+                std::string("⚠️ Vitesse élevée (2.50 m/s pour 2.00 m/s max). Risque de bruit. "
+                            "❌ Température de retour trop basse (50.0 °C pour 55.0 °C minimum). "
+                            "✓ Pression suffisante (2.5 bar disponibles). "));
+
+    diagnostics.clear();
+    CHECK(diagnostics.empty());
+    CHECK_EQUAL(int(diagnostics.getMask()), 0);
+}
+
+// Codes posés par le calcul de réseau : vitesse faible sur une petite antenne, pression
+// insuffisante en bout d'un réseau trop peu alimenté (avec la pression de sortie calculée)
+TEST(SegmentDiagnostics_SetByNetworkCalculation)
+{
+    NetworkCalculationParameters params;
+    params.supplyPressure = 1.1;
+    params.requiredPressure = 1.0;
+    NetworkSegment riser("colonne", "Colonne");
+    riser.length = 6.0;
+    riser.heightDifference = 3.0;
+    params.segments.push_back(riser);
+    NetworkSegment basin("lavabo", "Lavabo");
+    basin.parentId = "colonne";
+    basin.length = 2.0;
+    basin.fixtures.push_back(Fixture(FixtureType::HandWashBasin, 1));
+    params.segments.push_back(basin);
+
+    PipeCalculator calculator;
+    calculator.calculateNetwork(params);
+
+    const NetworkSegment& leaf = params.segments[1];
+    CHECK(leaf.outletPressure < params.requiredPressure);
+    CHECK(leaf.result.diagnostics.has(DiagnosticCode::InsufficientPressure));
+    for (const Diagnostic& diagnostic : leaf.result.diagnostics)
+    {
+        if (diagnostic.code == DiagnosticCode::InsufficientPressure)
+        {
+            CHECK_NEAR(diagnostic.value, leaf.outletPressure, 1e-12);
+            CHECK_EQUAL(diagnostic.limit, params.requiredPressure);
+        }
+    }
+    CHECK(leaf.result.diagnostics.formatRecommendation().find("❌ Pression insuffisante") != std::string::npos);
+    CHECK(leaf.result.diagnostics.formatRecommendation().find("✓ Pression suffisante") == std::string::npos);
+
+    if (leaf.result.velocity < PipeCalculator::StagnationVelocity)
+        CHECK(leaf.result.diagnostics.has(DiagnosticCode::LowVelocity));
+    else
+        CHECK(!leaf.result.diagnostics.has(DiagnosticCode::LowVelocity));
+
+    // Pression suffisante avec une alimentation normale
+    params.supplyPressure = 3.0;
+    calculator.calculateNetwork(params);
+    for (const NetworkSegment& segment : params.segments)
+    {
+        CHECK(!segment.result.diagnostics.has(DiagnosticCode::InsufficientPressure));
+        CHECK_NEAR(segment.result.diagnostics.getAvailablePressure(), segment.outletPressure, 1e-12);
+    }
+}
@@ -0,0 +1,246 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/SensitivityAnalyzer.h"
+#include "../../Modules/HydraulicCalculations/PipeCatalogue.h"
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    const FrictionModel MODELS[] = { FrictionModel::SwameeJain, FrictionModel::ColebrookWhite };
+
+    // Colonne de deux étages, antennes non bouclées ; terminal étudié : "sdb2"
+    NetworkCalculationParameters smallNetwork(NetworkType type, FrictionModel model)
+    {
+        NetworkCalculationParameters params;
+        params.networkType = type;
+        params.frictionModel = model;
+        params.supplyPressure = 3.0;
+        params.waterTemperature = 60.0;
+
+        auto add = [&params, type](const std::string& id, const std::string& parentId, double length, double height,
+                                   bool looped, std::vector<Fixture> fixtures)
+        {
+            NetworkSegment segment(id, id);
+            segment.parentId = parentId;
+            segment.length = length;
+            segment.heightDifference = height;
+            segment.hasReturnLine = looped && type == NetworkType::HotWaterWithLoop;
+            segment.fixtures = std::move(fixtures);
+            params.segments.push_back(segment);
+        };
+        add("source", "", 15.0, 0.0, true, {});
+        add("etage1", "source", 3.0, 3.0, true, {});
+        add("sdb1", "etage1", 6.0, 0.0, true, { Fixture(FixtureType::Shower, 1), Fixture(FixtureType::WashBasin, 1) });
+        add("etage2", "etage1", 3.0, 3.0, true, { Fixture(FixtureType::Sink, 1) });
+        add("sdb2", "etage2", 9.0, 0.5, true, { Fixture(FixtureType::Bathtub, 1), Fixture(FixtureType::WashBasin, 2) });
+        add("wc2", "etage2", 2.0, 0.0, false, { Fixture(FixtureType::WC, 1) });
+
+        PipeCalculator calculator;
+        calculator.calculateNetwork(params);
+        return params;
+    }
+
+    const size_t NoSegment = static_cast<size_t>(-1);
+
+    size_t indexOf(const NetworkCalculationParameters& params, const std::string& id)
+    {
+        for (size_t i = 0; i < params.segments.size(); ++i)
+        {
+            if (params.segments[i].id == id)
+                return i;
+        }
+        return NoSegment;
+    }
+
+    // Pression au point terminal après recalcul complet du réseau, longueur du tronçon i modifiée
+    double terminalPressureWithLength(NetworkCalculationParameters params, size_t i, double length)
+    {
+        params.segments[i].length = length;
+        PipeCalculator calculator;
+        calculator.calculateNetwork(params);
+        return params.segments[indexOf(params, "sdb2")].outletPressure;
+    }
+
+    // Pertes linéaires + singulières du tronçon (mCE) au diamètre intérieur donné, débit figé
+    double segmentPressureDrop(const NetworkCalculationParameters& params, const NetworkSegment& segment, double diameter)
+    {
+        PipeCalculator calculator;
+        return calculator.calculatePressureDrop(segment.result.flowRate, segment.length, diameter,
+                                                params.material,
+                                                PipeCalculator::getWaterState(WaterProperties::ColdWaterTemperature,
+                                                                              params.temperatureDependentProperties),
+                                                params.frictionModel);
+    }
+
+    // Chute de température (°C) sur un tronçon d'isolant propre, température d'entrée et débit figés
+    double frozenTemperatureDrop(const NetworkCalculationParameters& params, double length, double diameter,
+                                 double insulation, double inletTemperature, double flowRate)
+    {
+        double resistance = PipeCatalogue::computeInsulation(diameter, insulation).totalResistance;
+        double heatLoss = (inletTemperature - params.ambientTemperature) * length / resistance;
+        return PipeCalculator::calculateTemperatureDrop(
+            heatLoss, flowRate, PipeCalculator::getWaterState(inletTemperature, params.temperatureDependentProperties));
+    }
+
+    // Température de retour en chaufferie avec un isolant par tronçon, débits, DN et températures
+    // d'entrée des pertes figés au point calculé (modèle dérivé par SensitivityAnalyzer)
+    double frozenReturnTemperature(const NetworkCalculationParameters& params, const std::vector<double>& insulation)
+    {
+        // Réseaux de test : chaque parent précède ses enfants dans le vecteur de segments
+        const auto& segments = params.segments;
+        std::vector<double> supplyOutlet(segments.size(), 0.0);
+        std::vector<double> returnOutlet(segments.size(), 0.0);
+
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            const PipeSegmentResult& calculated = segments[i].result;
+            const size_t parent = indexOf(params, segments[i].parentId);
+            double inlet = (parent == NoSegment) ? calculated.inletTemperature : supplyOutlet[parent];
+            supplyOutlet[i] = inlet - frozenTemperatureDrop(params, segments[i].length, calculated.actualDiameter,
+                                                            insulation[i], calculated.inletTemperature,
+                                                            calculated.flowRate);
+        }
+        for (size_t i = segments.size(); i-- > 0;)
+        {
+            const PipeSegmentResult& calculated = segments[i].result;
+            double returnFlow = 0.0, weighted = 0.0;
+            int returnChildren = 0;
+            for (size_t c = 0; c < segments.size(); ++c)
+            {
+                if (segments[c].parentId == segments[i].id && segments[c].hasReturnLine && segments[c].result.hasReturn)
+                {
+                    returnFlow += segments[c].result.returnFlowRate;
+                    weighted += segments[c].result.returnFlowRate * returnOutlet[c];
+                    ++returnChildren;
+                }
+            }
+            double inlet = (returnChildren == 0) ? supplyOutlet[i] : weighted / returnFlow;
+            returnOutlet[i] = inlet;
+            if (calculated.hasReturn && calculated.returnActualDiameter > 0.0)
+            {
+                returnOutlet[i] -= frozenTemperatureDrop(params, segments[i].length, calculated.returnActualDiameter,
+                                                         insulation[i], calculated.returnInletTemperature,
+                                                         calculated.returnFlowRate);
+            }
+        }
+        return returnOutlet[0];
+    }
+}
+
+// ∂P/∂L par différences finies sur le réseau recalculé (pertes linéaires en longueur, DN
+// inchangés), ∂P/∂D par différences finies sur la perte de charge du tronçon au débit figé
+TEST(SensitivityAnalyzer_PressureDerivativesMatchFiniteDifferences)
+{
+    for (FrictionModel model : MODELS)
+    {
+        const NetworkCalculationParameters params = smallNetwork(NetworkType::ColdWater, model);
+        const SensitivityResult result = SensitivityAnalyzer().analyze(params, "sdb2");
+        CHECK_EQUAL(result.terminalSegmentId, std::string("sdb2"));
+        CHECK_EQUAL(result.segments.size(), params.segments.size());
+
+        const std::vector<std::string> path = { "source", "etage1", "etage2", "sdb2" };
+        for (size_t i = 0; i < params.segments.size() && i < result.segments.size(); ++i)
+        {
+            const NetworkSegment& segment = params.segments[i];
+            const SegmentSensitivity& sensitivity = result.segments[i];
+            bool onPath = false;
+            for (const std::string& id : path)
+                onPath = onPath || id == segment.id;
+            CHECK_EQUAL(sensitivity.onTerminalPath, onPath);
+
+            const double h = 1e-3;  // m
+            const double perLength = (terminalPressureWithLength(params, i, segment.length + h)
+                                    - terminalPressureWithLength(params, i, segment.length - h)) / (2.0 * h);
+            CHECK_NEAR(sensitivity.pressurePerLength, perLength, 1e-9);
+            if (!onPath)
+            {
+                CHECK_EQUAL(sensitivity.pressurePerDiameter, 0.0);
+                continue;
+            }
+            CHECK(sensitivity.pressurePerLength < 0.0);
+
+            // Modèle dérivé = perte de charge calculée du tronçon
+            const double diameter = segment.result.actualDiameter;
+            CHECK_NEAR(segmentPressureDrop(params, segment, diameter),
+                       segment.result.details.linearPressureDrop + segment.result.details.singularPressureDrop, 1e-9);
+
+            const double dh = 1e-4;  // mm
+            const double perDiameter = -(segmentPressureDrop(params, segment, diameter + dh)
+                                       - segmentPressureDrop(params, segment, diameter - dh)) / (2.0 * dh) / 10.0;
+            CHECK(sensitivity.pressurePerDiameter > 0.0);
+            CHECK_NEAR(sensitivity.pressurePerDiameter, perDiameter, 1e-5 * std::abs(perDiameter));
+        }
+    }
+}
+
+// ∂T_retour/∂e isolant par différences finies sur la température de retour en chaufferie,
+// débits et températures d'entrée des pertes figés ; nulle hors bouclage
+TEST(SensitivityAnalyzer_InsulationDerivativeMatchesFiniteDifferences)
+{
+    for (FrictionModel model : MODELS)
+    {
+        const NetworkCalculationParameters params = smallNetwork(NetworkType::HotWaterWithLoop, model);
+        const SensitivityResult result = SensitivityAnalyzer().analyze(params, "sdb2");
+        CHECK_EQUAL(result.segments.size(), params.segments.size());
+
+        const std::vector<double> insulation(params.segments.size(), params.insulationThickness);
+        CHECK_NEAR(frozenReturnTemperature(params, insulation),
+                   params.segments[indexOf(params, "source")].result.returnOutletTemperature, 1e-9);
+        CHECK_NEAR(result.returnTemperature, params.segments[indexOf(params, "source")].result.returnOutletTemperature, 1e-12);
+
+        for (size_t i = 0; i < params.segments.size() && i < result.segments.size(); ++i)
+        {
+            const double h = 1e-2;  // mm
+            std::vector<double> thicker = insulation;
+            std::vector<double> thinner = insulation;
+            thicker[i] += h;
+            thinner[i] -= h;
+            const double perInsulation = (frozenReturnTemperature(params, thicker)
+                                        - frozenReturnTemperature(params, thinner)) / (2.0 * h);
+
+            const double derivative = result.segments[i].returnTemperaturePerInsulation;
+            CHECK_NEAR(derivative, perInsulation, 1e-5 * std::abs(perInsulation) + 1e-12);
+            if (params.segments[i].id == "wc2")
+                CHECK_EQUAL(derivative, 0.0);  // Antenne non bouclée : sans effet sur le retour
+            else
+                CHECK(derivative > 0.0);
+        }
+    }
+}
+
+// Boucle de parents (schéma incohérent) : l'analyse se termine, le chemin s'arrête après
+// un tour de boucle
+TEST(SensitivityAnalyzer_ParentCycleTerminates)
+{
+    for (NetworkType type : { NetworkType::ColdWater, NetworkType::HotWaterWithLoop })
+    {
+        NetworkCalculationParameters params = smallNetwork(type, FrictionModel::SwameeJain);
+        NetworkSegment a("boucleA", "boucleA");
+        a.parentId = "boucleB";
+        a.length = 4.0;
+        a.hasReturnLine = type == NetworkType::HotWaterWithLoop;
+        a.fixtures = { Fixture(FixtureType::WashBasin, 1) };
+        NetworkSegment b("boucleB", "boucleB");
+        b.parentId = "boucleA";
+        b.length = 2.0;
+        b.hasReturnLine = a.hasReturnLine;
+        params.segments.push_back(a);
+        params.segments.push_back(b);
+
+        const SensitivityResult result = SensitivityAnalyzer().analyze(params, "boucleA");
+        CHECK_EQUAL(result.terminalSegmentId, std::string("boucleA"));
+        CHECK_EQUAL(result.segments.size(), params.segments.size());
+        if (result.segments.size() == params.segments.size())
+        {
+            CHECK(result.segments[indexOf(params, "boucleA")].onTerminalPath);
+            CHECK(result.segments[indexOf(params, "boucleB")].onTerminalPath);
+            CHECK(!result.segments[indexOf(params, "source")].onTerminalPath);
+        }
+
+        // Sans point terminal imposé, la boucle n'est jamais choisie
+        CHECK(SensitivityAnalyzer().analyze(params).terminalSegmentId.compare(0, 6, "boucle") != 0);
+    }
+}
@@ -0,0 +1,194 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/SizingChartCommand.h"
+#include "../../Modules/HydraulicCalculations/SizingChartGenerator.h"
+#include "../../Modules/HydraulicCalculations/WaterProperties.h"
+#include "../../Modules/PDFParser/XlsxWriter.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    const PipeMaterial MATERIALS[] = { PipeMaterial::Copper, PipeMaterial::PEX, PipeMaterial::Multilayer, PipeMaterial::Steel };
+
+    // Débits de quelques L/min au-delà du plus grand DN
+    const std::vector<double> FLOW_RATES = { 0.5, 4.0, 12.0, 27.5, 60.0, 150.0, 400.0, 2000.0 };
+
+    size_t indexOf(const std::vector<int>& diameters, int dn)
+    {
+        return static_cast<size_t>(std::find(diameters.begin(), diameters.end(), dn) - diameters.begin());
+    }
+
+    std::string readFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+}
+
+// DN retenu et perte de charge de l'abaque identiques à PipeCalculator::calculate pour un
+// tronçon de même débit, matériau et longueur (eau froide : même température de calcul)
+TEST(SizingChartGenerator_MatchesPipeCalculator)
+{
+    SizingChartGrid grid;
+    grid.flowRates = FLOW_RATES;
+    grid.materials.assign(std::begin(MATERIALS), std::end(MATERIALS));
+    grid.temperatures = { WaterProperties::ColdWaterTemperature };
+    grid.length = 12.0;
+
+    SizingChartGenerator generator;
+    const SizingChart chart = generator.generate(grid);
+    CHECK_EQUAL(chart.blocks.size(), grid.materials.size());
+
+    PipeCalculator calculator;
+    for (const SizingChartBlock& block : chart.blocks)
+    {
+        for (size_t f = 0; f < FLOW_RATES.size(); ++f)
+        {
+            CalculationParameters params;
+            params.networkType = grid.networkType;
+            params.material = block.material;
+            params.length = grid.length;
+            params.overrideFlowRate = FLOW_RATES[f];
+            params.frictionModel = grid.frictionModel;
+            const PipeSegmentResult expected = calculator.calculate(params);
+
+            CHECK_EQUAL(block.selectedDiameters[f], expected.nominalDiameter);
+            const size_t d = indexOf(block.nominalDiameters, expected.nominalDiameter);
+            CHECK(d < block.nominalDiameters.size());
+            if (d < block.nominalDiameters.size())
+            {
+                const size_t flowCount = FLOW_RATES.size();
+                CHECK_NEAR(block.velocity(d, f, flowCount), expected.velocity, 1e-12 * expected.velocity);
+                CHECK_NEAR(block.pressureDrop(d, f, flowCount), expected.pressureDrop, 1e-9 * expected.pressureDrop);
+            }
+        }
+    }
+}
+
+// ECS bouclée : même DN que calculate() avec la vitesse maximale réduite du bouclage
+TEST(SizingChartGenerator_LoopNetworkUsesCalculatorVelocityLimit)
+{
+    SizingChartGrid grid;
+    grid.flowRates = FLOW_RATES;
+    grid.materials.assign(std::begin(MATERIALS), std::end(MATERIALS));
+    grid.temperatures = { 60.0 };
+    grid.networkType = NetworkType::HotWaterWithLoop;
+
+    SizingChartGenerator generator;
+    const SizingChart chart = generator.generate(grid);
+
+    PipeCalculator calculator;
+    bool largerThanColdWater = false;
+    for (const SizingChartBlock& block : chart.blocks)
+    {
+        for (size_t f = 0; f < FLOW_RATES.size(); ++f)
+        {
+            CalculationParameters params;
+            params.networkType = NetworkType::HotWaterWithLoop;
+            params.material = block.material;
+            params.length = grid.length;
+            params.overrideFlowRate = FLOW_RATES[f];
+            CHECK_EQUAL(block.selectedDiameters[f], calculator.calculate(params).nominalDiameter);
+
+            params.networkType = NetworkType::ColdWater;
+            largerThanColdWater = largerThanColdWater ||
+                block.selectedDiameters[f] > calculator.calculate(params).nominalDiameter;
+        }
+    }
+    CHECK(largerThanColdWater);
+    CHECK_NEAR(PipeCalculator::getMaxVelocity(NetworkType::HotWaterWithLoop), 1.5, 0.0);
+    CHECK_NEAR(PipeCalculator::getMaxVelocity(NetworkType::ColdWater), 2.0, 0.0);
+}
+
+// Export CSV de la commande --abaque : une ligne par (DN, débit), DN retenu marqué une fois
+// par débit ; option inconnue : code de sortie 1
+TEST(SizingChartCommand_WritesCsv)
+{
+    namespace fs = std::filesystem;
+    const fs::path output = fs::temp_directory_path() / "tchub_abaque_test.csv";
+    fs::remove(output);
+
+    CHECK_EQUAL(runSizingChartCommand({ "--abaque", output.u8string(), "--materiaux", "cuivre,per",
+                                        "--debits", "1:10:1", "--temperatures", "10", "--threads", "2" }), 0);
+    const std::string csv = readFile(output);
+    CHECK(csv.compare(0, 3, "\xEF\xBB\xBF") == 0);
+
+    std::istringstream lines(csv.substr(3));
+    std::string line;
+    std::getline(lines, line);
+    CHECK_EQUAL(line, std::string("Matériau;Température (°C);Débit (L/min);DN;D int (mm);Vitesse (m/s);Perte de charge (mCE);DN retenu"));
+
+    PipeCalculator calculator;
+    const size_t expectedRows = 10 * (calculator.getAvailableDiameters(PipeMaterial::Copper).size() +
+                                      calculator.getAvailableDiameters(PipeMaterial::PEX).size());
+    size_t rows = 0;
+    size_t selected = 0;
+    while (std::getline(lines, line))
+    {
+        ++rows;
+        CHECK_EQUAL(std::count(line.begin(), line.end(), ';'), std::ptrdiff_t(7));
+        if (line.size() >= 4 && line.compare(line.size() - 4, 4, ";oui") == 0)
+            ++selected;
+    }
+    CHECK_EQUAL(rows, expectedRows);
+    CHECK_EQUAL(selected, size_t(2 * 10));
+
+    CHECK_EQUAL(runSizingChartCommand({ "--abaque", output.u8string(), "--inconnue", "1" }), 1);
+    CHECK_EQUAL(runSizingChartCommand({ "--abaque", output.u8string(), "--debits" }), 1);
+    fs::remove(output);
+}
+
+// Classeur de la commande --abaque : une feuille par (matériau, température), pertes de charge
+// par DN puis DN retenu
+TEST(SizingChartCommand_BuildsXlsxSheets)
+{
+    SizingChartGrid grid;
+    grid.flowRates = SizingChartGrid::range(2.0, 20.0, 2.0);
+    grid.materials = { PipeMaterial::Copper, PipeMaterial::Steel };
+    grid.temperatures = { 10.0, 60.0 };
+
+    SizingChartGenerator generator;
+    const SizingChart chart = generator.generate(grid);
+    const std::vector<XlsxSheet> sheets = buildSizingChartSheets(chart);
+
+    CHECK_EQUAL(sheets.size(), size_t(4));
+    for (size_t s = 0; s < sheets.size() && s < chart.blocks.size(); ++s)
+    {
+        const SizingChartBlock& block = chart.blocks[s];
+        const XlsxSheet& sheet = sheets[s];
+        CHECK_EQUAL(sheet.headers.size(), block.nominalDiameters.size() + 2);
+        CHECK_EQUAL(sheet.headers.front(), std::string("Débit (L/min)"));
+        CHECK_EQUAL(sheet.headers.back(), std::string("DN retenu"));
+        CHECK_EQUAL(sheet.rows.size(), grid.flowRates.size());
+        for (size_t f = 0; f < sheet.rows.size(); ++f)
+        {
+            const std::vector<double>& row = sheet.rows[f];
+            CHECK_EQUAL(row.front(), grid.flowRates[f]);
+            CHECK_EQUAL(row[1], block.pressureDrop(0, f, grid.flowRates.size()));
+            CHECK_EQUAL(row.back(), static_cast<double>(block.selectedDiameters[f]));
+        }
+    }
+    CHECK(sheets[0].name != sheets[1].name);
+
+#ifdef USE_MINIZIP
+    // Fichier .xlsx : archive ZIP avec une feuille XML par bloc
+    namespace fs = std::filesystem;
+    const fs::path output = fs::temp_directory_path() / "tchub_abaque_test.xlsx";
+    fs::remove(output);
+    CHECK_EQUAL(runSizingChartCommand({ "--abaque", output.u8string(), "--materiaux", "cuivre,acier",
+                                        "--debits", "2:20:2", "--temperatures", "10,60" }), 0);
+    const std::string xlsx = readFile(output);
+    CHECK(xlsx.compare(0, 2, "PK") == 0);
+    CHECK(xlsx.find("xl/worksheets/sheet4.xml") != std::string::npos);
+    fs::remove(output);
+#endif
+}
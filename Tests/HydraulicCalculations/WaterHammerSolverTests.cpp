@@ -0,0 +1,256 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/WaterHammerSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace HydraulicCalc;
+
+namespace
+{
+    NetworkSegment makeSegment(const std::string& id, const std::string& parentId, double length)
+    {
+        NetworkSegment segment(id, id);
+        segment.parentId = parentId;
+        segment.length = length;
+        return segment;
+    }
+
+    NetworkCalculationParameters coldWaterNetwork()
+    {
+        NetworkCalculationParameters params;
+        params.networkType = NetworkType::ColdWater;
+        params.material = PipeMaterial::Copper;
+        params.supplyPressure = 3.0;
+        return params;
+    }
+}
+
+// Fermeture instantanée en bout d'une conduite alimentée par un réservoir :
+// la surpression vaut ρ·a·ΔV (Joukowsky) avec la célérité physique du tube
+TEST(WaterHammer_SinglePipeMatchesJoukowsky)
+{
+    NetworkCalculationParameters params = coldWaterNetwork();
+    NetworkSegment pipe = makeSegment("conduite", "", 30.0);
+    pipe.fixtures.push_back(Fixture(FixtureType::WCFlushValve, 1));
+    params.segments.push_back(pipe);
+
+    PipeCalculator calculator;
+    calculator.calculateNetwork(params);
+    const PipeSegmentResult& steady = params.segments[0].result;
+
+    std::vector<ValveClosureEvent> events = WaterHammerSolver::buildFastClosureEvents(params);
+    CHECK_EQUAL(events.size(), size_t(1));
+    events[0].closureTime = 1e-4;  // Bien plus court que l'aller-retour 2L/a (≈ 0,05 s)
+
+    WaterHammerSolver solver;
+    const TransientResult transient = solver.solve(params, events);
+    CHECK_EQUAL(transient.envelopes.size(), size_t(1));
+    const SegmentPressureEnvelope& envelope = transient.envelopes[0];
+
+    const double wall = WaterHammerSolver::getWallThickness(steady.nominalDiameter, steady.actualDiameter);
+    const double physicalSpeed = WaterHammerSolver::getWaveSpeed(params.material, steady.actualDiameter, wall);
+    CHECK(std::fabs(envelope.waveSpeedAdjustment) <= TransientOptions().maxWaveSpeedAdjustment);
+    CHECK_NEAR(envelope.waveSpeed, physicalSpeed * (1.0 + envelope.waveSpeedAdjustment), 1e-6);
+
+    // Toute la vitesse est coupée : ΔV = V du régime permanent
+    const double joukowskyBar = 1000.0 * physicalSpeed * steady.velocity / 1e5;
+    const double outletPressure = params.segments[0].outletPressure;
+    CHECK_NEAR(envelope.maxPressure - outletPressure, joukowskyBar, 0.03 * joukowskyBar);
+
+    // Grille exacte (sans interpolation) : même surpression
+    TransientOptions exactGrid;
+    exactGrid.minCourant = 1.0;
+    const TransientResult exact = solver.solve(params, events, exactGrid);
+    CHECK_EQUAL(exact.envelopes.size(), size_t(1));
+    CHECK_NEAR(exact.minCourant, 1.0, 1e-9);
+    CHECK_NEAR(exact.envelopes[0].maxPressure - outletPressure, joukowskyBar, 0.03 * joukowskyBar);
+}
+
+// Célérités ajustées à la grille : quelques pour cent au plus, même avec des longueurs
+// qui ne tombent pas sur un nombre entier de mailles
+TEST(WaterHammer_GridKeepsWaveSpeedsClose)
+{
+    NetworkCalculationParameters params = coldWaterNetwork();
+    params.segments.push_back(makeSegment("colonne", "", 12.0));
+    NetworkSegment branch = makeSegment("branche", "colonne", 5.3);
+    branch.fixtures.push_back(Fixture(FixtureType::WCFlushValve, 1));
+    params.segments.push_back(branch);
+    NetworkSegment other = makeSegment("autre", "colonne", 2.2);
+    other.fixtures.push_back(Fixture(FixtureType::WashBasin, 1));
+    params.segments.push_back(other);
+
+    PipeCalculator calculator;
+    calculator.calculateNetwork(params);
+
+    WaterHammerSolver solver;
+    const TransientResult transient = solver.solve(params, WaterHammerSolver::buildFastClosureEvents(params));
+    const double tolerance = TransientOptions().maxWaveSpeedAdjustment;
+    CHECK(transient.maxWaveSpeedAdjustment <= tolerance);
+    for (size_t i = 0; i < params.segments.size(); ++i)
+    {
+        const PipeSegmentResult& steady = params.segments[i].result;
+        const double wall = WaterHammerSolver::getWallThickness(steady.nominalDiameter, steady.actualDiameter);
+        const double physicalSpeed = WaterHammerSolver::getWaveSpeed(params.material, steady.actualDiameter, wall);
+        const SegmentPressureEnvelope& envelope = transient.envelopes[i];
+        CHECK(std::fabs(envelope.waveSpeed / physicalSpeed - 1.0) <= tolerance);
+        CHECK_NEAR(envelope.waveSpeedAdjustment, envelope.waveSpeed / physicalSpeed - 1.0, 1e-12);
+        CHECK(std::fabs(envelope.waveSpeedAdjustment) <= transient.maxWaveSpeedAdjustment + 1e-12);
+    }
+}
+
+// Une feuille sans débit ni appareil ne doit ni propager de NaN ni laisser d'enveloppe vide
+TEST(WaterHammer_EmptyLeafKeepsFiniteEnvelopes)
+{
+    NetworkCalculationParameters params = coldWaterNetwork();
+    params.segments.push_back(makeSegment("colonne", "", 15.0));
+    NetworkSegment flush = makeSegment("wc", "colonne", 6.0);
+    flush.fixtures.push_back(Fixture(FixtureType::WCFlushValve, 1));
+    params.segments.push_back(flush);
+    params.segments.push_back(makeSegment("attente", "colonne", 4.0));
+
+    PipeCalculator calculator;
+    calculator.calculateNetwork(params);
+
+    WaterHammerSolver solver;
+    const std::vector<ValveClosureEvent> events = WaterHammerSolver::buildFastClosureEvents(params);
+    const TransientResult withLeaf = solver.solve(params, events);
+
+    CHECK(std::isfinite(withLeaf.maxPressure));
+    CHECK(std::isfinite(withLeaf.minPressure));
+    for (const SegmentPressureEnvelope& envelope : withLeaf.envelopes)
+    {
+        CHECK(std::isfinite(envelope.maxPressure));
+        CHECK(std::isfinite(envelope.minPressure));
+        CHECK(std::fabs(envelope.maxPressure) < 1e3);
+        CHECK(std::fabs(envelope.minPressure) < 1e3);
+        CHECK(envelope.maxPressure >= envelope.minPressure);
+    }
+
+    // La surpression au WC est du même ordre qu'en l'absence de la feuille vide
+    NetworkCalculationParameters withoutLeaf = params;
+    withoutLeaf.segments.pop_back();
+    const TransientResult reference = solver.solve(withoutLeaf, events);
+    CHECK(withLeaf.envelopes[1].maxSurge > 0.5 * reference.envelopes[1].maxSurge);
+    CHECK(withLeaf.maxPressure > 0.5 * reference.maxPressure);
+}
+
+namespace
+{
+    // Immeuble : colonne montante d'un tronçon par étage, palier vers chaque logement, puis
+    // cuisine (évier, lave-vaisselle), salle de bains (lavabo, douche), WC à robinet de chasse
+    // et lave-linge (1 + 6 × logements tronçons par étage)
+    NetworkCalculationParameters buildingNetwork(int floors, int dwellingsPerFloor)
+    {
+        NetworkCalculationParameters params = coldWaterNetwork();
+        params.supplyPressure = 4.0;
+        std::string below;
+        for (int floor = 0; floor < floors; ++floor)
+        {
+            const std::string riser = "colonne" + std::to_string(floor);
+            NetworkSegment riserSegment = makeSegment(riser, below, floor == 0 ? 8.0 : 2.9);
+            riserSegment.heightDifference = floor == 0 ? 1.0 : 2.9;
+            params.segments.push_back(riserSegment);
+            below = riser;
+
+            for (int dwelling = 0; dwelling < dwellingsPerFloor; ++dwelling)
+            {
+                const std::string prefix = "e" + std::to_string(floor) + "l" + std::to_string(dwelling) + "_";
+                const double offset = 0.37 * dwelling + 0.11 * floor;  // Longueurs toutes différentes
+                params.segments.push_back(makeSegment(prefix + "palier", riser, 4.5 + offset));
+
+                const struct
+                {
+                    const char* name;
+                    double length;
+                    FixtureType first;
+                    FixtureType second;
+                } rooms[] = {
+                    { "cuisine", 3.7, FixtureType::Sink, FixtureType::Dishwasher },
+                    { "sdb", 2.3, FixtureType::WashBasin, FixtureType::Shower },
+                    { "wc", 1.4, FixtureType::WCFlushValve, FixtureType::WCFlushValve },
+                    { "lavelinge", 2.9, FixtureType::WashingMachine, FixtureType::WashingMachine },
+                };
+                const std::string distribution = prefix + "nourrice";
+                params.segments.push_back(makeSegment(distribution, prefix + "palier", 0.8 + 0.5 * offset));
+                for (const auto& room : rooms)
+                {
+                    NetworkSegment segment = makeSegment(prefix + room.name, distribution, room.length + 0.5 * offset);
+                    segment.fixtures.push_back(Fixture(room.first, 1));
+                    if (room.second != room.first)
+                        segment.fixtures.push_back(Fixture(room.second, 1));
+                    params.segments.push_back(segment);
+                }
+            }
+        }
+        return params;
+    }
+}
+
+// Grille par défaut (tronçons interpolés) contre grille exacte fine (célérités à 0,5 % près,
+// sans interpolation) : mêmes pressions extrêmes à 10 % de la surpression près sur chaque
+// tronçon (l'ancienne grille exacte à 2 % s'écartait déjà de 7 % sur un lave-linge)
+TEST(WaterHammer_DefaultGridMatchesFineGrid)
+{
+    NetworkCalculationParameters params = buildingNetwork(2, 2);
+    PipeCalculator calculator;
+    calculator.calculateNetwork(params);
+    const std::vector<ValveClosureEvent> events = WaterHammerSolver::buildFastClosureEvents(params);
+
+    TransientOptions fine;
+    fine.maxWaveSpeedAdjustment = 0.005;
+    fine.minCourant = 1.0;
+    fine.minTimeStep = 1e-6;
+    WaterHammerSolver solver;
+    const TransientResult reference = solver.solve(params, events, fine);
+    const TransientResult transient = solver.solve(params, events);
+
+    CHECK_EQUAL(reference.minCourant, 1.0);
+    CHECK(transient.minCourant >= TransientOptions().minCourant);
+    CHECK(transient.minCourant < 1.0);
+    CHECK(transient.timeStep > 2.0 * reference.timeStep);
+    for (size_t i = 0; i < params.segments.size(); ++i)
+    {
+        const SegmentPressureEnvelope& expected = reference.envelopes[i];
+        const SegmentPressureEnvelope& actual = transient.envelopes[i];
+        CHECK(actual.courant >= TransientOptions().minCourant && actual.courant <= 1.0);
+        CHECK(actual.courant == 1.0 || actual.waveSpeedAdjustment == 0.0);
+        CHECK_NEAR(actual.maxPressure, expected.maxPressure, 0.10 * expected.maxSurge);
+        CHECK_NEAR(actual.minPressure, expected.minPressure, 0.10 * expected.maxSurge);
+    }
+}
+
+// Temps de calcul sur un seul cœur selon la taille de l'immeuble : options par défaut, puis
+// grille exacte partout (minCourant = 1, comportement précédent)
+BENCHMARK(WaterHammer_BuildingNetworks)
+{
+    const struct
+    {
+        int floors;
+        int dwellings;
+    } sizes[] = { { 2, 2 }, { 4, 3 }, { 8, 4 } };
+
+    for (const auto& size : sizes)
+    {
+        NetworkCalculationParameters params = buildingNetwork(size.floors, size.dwellings);
+        PipeCalculator calculator;
+        calculator.calculateNetwork(params);
+        const std::vector<ValveClosureEvent> events = WaterHammerSolver::buildFastClosureEvents(params);
+
+        for (double minCourant : { TransientOptions().minCourant, 1.0 })
+        {
+            TransientOptions options;
+            options.maxThreads = 1;
+            options.minCourant = minCourant;
+            WaterHammerSolver solver;
+            const TransientResult transient = solver.solve(params, events, options);
+
+            CHECK(std::isfinite(transient.maxPressure));
+            std::cout << "  " << params.segments.size() << " tronçons, Courant min " << minCourant << " : "
+                      << transient.computeTimeMs << " ms (pas " << transient.timeStep * 1e6 << " µs, "
+                      << transient.steps << " pas, " << transient.totalNodes << " nœuds, pression max "
+                      << transient.maxPressure << " bar)\n";
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#include "../TestFramework.h"
+#include "../../Modules/HydraulicCalculations/PipeCalculator.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using namespace HydraulicCalc;
+
+// Aux températures de référence (tous les 5 °C) la table redonne les valeurs d'origine
+TEST(WaterProperties_MatchesReferenceValues)
+{
+    const WaterState at10 = WaterProperties::atTemperature(10.0);
+    CHECK_NEAR(at10.density, 999.70, 1e-9);
+    CHECK_NEAR(at10.specificHeat, 4195.0, 1e-9);
+    CHECK_NEAR(at10.kinematicViscosity, 1.306e-3 / 999.70, 1e-12);
+
+    const WaterState at60 = WaterProperties::atTemperature(60.0);
+    CHECK_NEAR(at60.density, 983.20, 1e-9);
+    CHECK_NEAR(at60.thermalConductivity, 0.654, 1e-12);
+    CHECK_NEAR(at60.kinematicViscosity, 0.467e-3 / 983.20, 1e-12);
+
+    // Viscosité à 60 °C inférieure à la moitié de la constante historique (10⁻⁶ m²/s)
+    CHECK(at60.kinematicViscosity < 0.5 * WaterState().kinematicViscosity);
+}
+
+TEST(WaterProperties_IsMonotonicAndClamped)
+{
+    double previous = WaterProperties::atTemperature(WaterProperties::MinTemperature).kinematicViscosity;
+    for (double t = WaterProperties::MinTemperature + 0.05; t <= WaterProperties::MaxTemperature; t += 0.05)
+    {
+        const double viscosity = WaterProperties::instance().kinematicViscosity(t);
+        CHECK(viscosity < previous);
+        CHECK_NEAR(viscosity, WaterProperties::atTemperature(t).kinematicViscosity, 1e-18);
+        previous = viscosity;
+    }
+
+    CHECK_NEAR(WaterProperties::atTemperature(-10.0).density, WaterProperties::atTemperature(5.0).density, 0.0);
+    CHECK_NEAR(WaterProperties::atTemperature(120.0).density, WaterProperties::atTemperature(90.0).density, 0.0);
+}
+
+// Eau chaude : la perte de charge évaluée à la température du segment est plus faible
+TEST(WaterProperties_HotWaterPressureDropIsLower)
+{
+    PipeCalculator calculator;
+    const double constant = calculator.calculatePressureDrop(20.0, 10.0, 20.0, PipeMaterial::Copper,
+                                                             PipeCalculator::getWaterState(60.0, false));
+    const double accurate = calculator.calculatePressureDrop(20.0, 10.0, 20.0, PipeMaterial::Copper,
+                                                             PipeCalculator::getWaterState(60.0, true));
+    CHECK(accurate < constant);
+    CHECK(accurate > 0.7 * constant);
+}
+
+// Coût du mode précis : propriétés constantes ou lues dans la table à chaque appel
+BENCHMARK(WaterProperties_PressureDropCost)
+{
+    PipeCalculator calculator;
+    const int calls = 5000000;
+    double nanoseconds[2] = { 0.0, 0.0 };
+
+    for (int mode = 0; mode < 2; ++mode)
+    {
+        volatile double sink = 0.0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < calls; ++i)
+        {
+            const double temperature = 10.0 + (i % 800) * 0.1;
+            const WaterState water = PipeCalculator::getWaterState(temperature, mode == 1);
+            sink = sink + calculator.calculatePressureDrop(5.0 + (i % 50) * 0.3, 10.0, 20.0, PipeMaterial::Copper, water);
+        }
+        nanoseconds[mode] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+    }
+
+    std::cout << "  calculatePressureDrop : " << nanoseconds[0] << " ns/appel (constantes), "
+              << nanoseconds[1] << " ns/appel (table), surcoût "
+              << 100.0 * (nanoseconds[1] / nanoseconds[0] - 1.0) << " %\n";
+}
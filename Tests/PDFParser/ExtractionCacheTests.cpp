@@ -0,0 +1,287 @@
+#include "../TestFramework.h"
+#include "../../Modules/PDFParser/ExtractionCache.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    // Cache dans un dossier vide, propre au test ; remis par défaut à la destruction
+    class TestCacheDirectory
+    {
+    public:
+        explicit TestCacheDirectory(const std::string& name) : path(fs::temp_directory_path() / name)
+        {
+            fs::remove_all(path);
+            ExtractionCache::setDirectory(path.u8string());
+        }
+
+        ~TestCacheDirectory()
+        {
+            ExtractionCache::clear();
+            ExtractionCache::setDirectory(std::string());
+            ExtractionCache::setMaxBytes(ExtractionCache::DEFAULT_MAX_BYTES);
+            std::error_code error;
+            fs::remove_all(path, error);
+        }
+
+        fs::path entry(const std::string& key) const { return path / (key + ".cache"); }
+
+        const fs::path path;
+    };
+
+    void writeEntry(const std::string& key, const std::vector<std::string>& pages)
+    {
+        ExtractionCache::Writer writer(key);
+        for (const std::string& page : pages)
+            writer.addPage(page);
+        writer.commit();
+    }
+
+    // Texte remis par le cache (vide si l'entrée est refusée)
+    std::string delivered(const std::string& key, bool* found = nullptr)
+    {
+        std::string text;
+        bool complete = false;
+        const bool ok = ExtractionCache::deliver(key,
+            [&text](std::string& page, int, int)
+            {
+                text += page;
+                return true;
+            },
+            complete);
+        if (found)
+            *found = ok;
+        return text;
+    }
+
+    // PDF minimal d'une page par texte (table xref aux bons décalages)
+    std::string minimalPdf(const std::vector<std::string>& pageTexts)
+    {
+        const size_t pageCount = pageTexts.size();
+        std::vector<std::string> objects;
+        std::string kids;
+        for (size_t i = 0; i < pageCount; ++i)
+            kids += std::to_string(4 + 2 * i) + " 0 R ";
+        objects.push_back("<< /Type /Catalog /Pages 2 0 R >>");
+        objects.push_back("<< /Type /Pages /Kids [" + kids + "] /Count " + std::to_string(pageCount) + " >>");
+        objects.push_back("<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica >>");
+        for (size_t i = 0; i < pageCount; ++i)
+        {
+            const std::string content = "BT /F1 12 Tf 72 720 Td (" + pageTexts[i] + ") Tj ET";
+            objects.push_back("<< /Type /Page /Parent 2 0 R /MediaBox [0 0 612 792] /Resources << /Font << /F1 3 0 R >> >> /Contents " +
+                              std::to_string(5 + 2 * i) + " 0 R >>");
+            objects.push_back("<< /Length " + std::to_string(content.size()) + " >>\nstream\n" + content + "\nendstream");
+        }
+
+        std::string pdf = "%PDF-1.4\n";
+        std::vector<size_t> offsets;
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            offsets.push_back(pdf.size());
+            pdf += std::to_string(i + 1) + " 0 obj\n" + objects[i] + "\nendobj\n";
+        }
+        const size_t xref = pdf.size();
+        pdf += "xref\n0 " + std::to_string(objects.size() + 1) + "\n0000000000 65535 f \n";
+        for (size_t offset : offsets)
+        {
+            const std::string number = std::to_string(offset);
+            pdf += std::string(10 - number.size(), '0') + number + " 00000 n \n";
+        }
+        pdf += "trailer\n<< /Size " + std::to_string(objects.size() + 1) + " /Root 1 0 R >>\nstartxref\n" +
+               std::to_string(xref) + "\n%%EOF\n";
+        return pdf;
+    }
+}
+
+// Entrée écrite par une autre version de l'extraction (même PDF, même option) : ignorée
+TEST(ExtractionCache_IgnoresEntriesFromOtherExtractorVersions)
+{
+    const fs::path directory = fs::temp_directory_path() / "tchub_extraction_cache_test";
+    fs::remove_all(directory);
+    ExtractionCache::setDirectory(directory.u8string());
+
+    const std::string pdfPath = (fs::temp_directory_path() / "tchub_extraction_cache_test.pdf").u8string();
+    std::ofstream(fs::u8path(pdfPath), std::ios::binary) << "%PDF-1.4 contenu de test";
+
+    const std::string key = ExtractionCache::keyFor(pdfPath, true);
+    const std::string version = PopplerPdfExtractor::extractorVersion();
+    CHECK(key.size() > version.size() && key.compare(key.size() - version.size(), version.size(), version) == 0);
+
+    // Même PDF, clé d'une autre version
+    const std::string otherKey = key.substr(0, key.size() - version.size()) + "t0";
+    {
+        ExtractionCache::Writer writer(otherKey);
+        writer.addPage("texte de l'ancienne extraction\n");
+        writer.commit();
+    }
+
+    std::string delivered;
+    const PopplerPdfExtractor::PageCallback keepPage = [&delivered](std::string& page, int, int)
+    {
+        delivered += page;
+        return true;
+    };
+    bool complete = false;
+    CHECK(!ExtractionCache::deliver(key, keepPage, complete));
+    CHECK(delivered.empty());
+
+    {
+        ExtractionCache::Writer writer(key);
+        writer.addPage("texte courant\n");
+        writer.commit();
+    }
+    CHECK(ExtractionCache::deliver(key, keepPage, complete));
+    CHECK(complete);
+    CHECK_EQUAL(delivered, std::string("texte courant\n"));
+
+    ExtractionCache::clear();
+    ExtractionCache::setDirectory(std::string());
+    fs::remove_all(directory);
+    fs::remove(fs::u8path(pdfPath));
+}
+
+// Limite de taille : les entrées les moins récemment utilisées (lecture comprise) sont évincées
+TEST(ExtractionCache_EvictsLeastRecentlyUsed)
+{
+    const TestCacheDirectory cache("tchub_extraction_cache_lru_test");
+    const std::string page(1000, 'x');
+    writeEntry("lru_a", { page });
+    writeEntry("lru_b", { page });
+    writeEntry("lru_c", { page });
+
+    // a, b puis c écrites dans cet ordre ; a relue ensuite devient la plus récente
+    const auto now = fs::file_time_type::clock::now();
+    fs::last_write_time(cache.entry("lru_a"), now - std::chrono::hours(3));
+    fs::last_write_time(cache.entry("lru_b"), now - std::chrono::hours(2));
+    fs::last_write_time(cache.entry("lru_c"), now - std::chrono::hours(1));
+    CHECK_EQUAL(delivered("lru_a"), page);
+
+    const std::uintmax_t entrySize = fs::file_size(cache.entry("lru_a"));
+    ExtractionCache::setMaxBytes(2 * entrySize);
+
+    CHECK(fs::exists(cache.entry("lru_a")));
+    CHECK(!fs::exists(cache.entry("lru_b")));
+    CHECK(fs::exists(cache.entry("lru_c")));
+
+    // Limite atteinte par une nouvelle entrée : c, la moins récente, laisse la place
+    writeEntry("lru_d", { page });
+    CHECK(fs::exists(cache.entry("lru_a")));
+    CHECK(!fs::exists(cache.entry("lru_c")));
+    CHECK(fs::exists(cache.entry("lru_d")));
+}
+
+// Entrée tronquée ou abîmée : refusée, aucune page remise
+TEST(ExtractionCache_RejectsTruncatedAndCorruptEntries)
+{
+    const TestCacheDirectory cache("tchub_extraction_cache_corrupt_test");
+    const std::vector<std::string> pages = { "page 1\n", "page 2\n", "page 3\n" };
+
+    auto rewrite = [&cache](const std::string& key, auto change)
+    {
+        std::ifstream in(cache.entry(key), std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        change(bytes);
+        std::ofstream(cache.entry(key), std::ios::binary | std::ios::trunc) << bytes;
+    };
+
+    bool found = false;
+    writeEntry("intacte", pages);
+    CHECK_EQUAL(delivered("intacte", &found), std::string("page 1\npage 2\npage 3\n"));
+    CHECK(found);
+
+    // Fin manquante (écriture interrompue)
+    writeEntry("tronquee", pages);
+    rewrite("tronquee", [](std::string& bytes) { bytes.resize(bytes.size() - 5); });
+    CHECK_EQUAL(delivered("tronquee", &found), std::string());
+    CHECK(!found);
+
+    // Texte raccourci, fin intacte : les tailles de pages ne correspondent plus
+    writeEntry("texte_court", pages);
+    rewrite("texte_court", [](std::string& bytes) { bytes.erase(0, 3); });
+    CHECK_EQUAL(delivered("texte_court", &found), std::string());
+    CHECK(!found);
+
+    // Taille d'une page modifiée dans la table
+    writeEntry("table", pages);
+    rewrite("table", [](std::string& bytes) { bytes[bytes.size() - 16 - 3 * 8] ^= 0x40; });
+    CHECK_EQUAL(delivered("table", &found), std::string());
+    CHECK(!found);
+
+    // Nombre de pages impossible
+    writeEntry("pages", pages);
+    rewrite("pages", [](std::string& bytes) { bytes[bytes.size() - 16 + 7] = '\x7f'; });
+    CHECK_EQUAL(delivered("pages", &found), std::string());
+    CHECK(!found);
+
+    // Fichier vide ou étranger
+    std::ofstream(cache.entry("vide"), std::ios::binary);
+    CHECK_EQUAL(delivered("vide", &found), std::string());
+    CHECK(!found);
+    std::ofstream(cache.entry("etranger"), std::ios::binary) << "ceci n'est pas une entrée du cache";
+    CHECK_EQUAL(delivered("etranger", &found), std::string());
+    CHECK(!found);
+}
+
+// Extraction annulée (Writer sans commit, ou onPage qui refuse une page de l'API Poppler) :
+// aucune entrée, pas de fichier temporaire laissé
+TEST(ExtractionCache_CancelledExtractionIsNotCommitted)
+{
+    const TestCacheDirectory cache("tchub_extraction_cache_cancel_test");
+    {
+        ExtractionCache::Writer writer("abandonnee");
+        writer.addPage("page 1\n");
+    }
+    CHECK(!fs::exists(cache.entry("abandonnee")));
+
+    const fs::path pdfPath = fs::temp_directory_path() / "tchub_extraction_cache_cancel.pdf";
+    std::ofstream(pdfPath, std::ios::binary) << minimalPdf({ "Page un", "Page deux", "Page trois" });
+    PopplerPdfExtractor::setPdfToTextPath((fs::temp_directory_path() / "introuvable" / "pdftotext").u8string());
+
+    int pagesSeen = 0;
+    const bool complete = PopplerPdfExtractor::streamPages(pdfPath.u8string(), true,
+        [&pagesSeen](std::string&, int, int)
+        {
+            ++pagesSeen;
+            return false;
+        });
+    CHECK(!complete);
+    CHECK_EQUAL(pagesSeen, PopplerPdfExtractor::isPopplerAvailable() ? 1 : 0);
+
+    const std::string key = ExtractionCache::keyFor(pdfPath.u8string(), true);
+    bool found = true;
+    delivered(key, &found);
+    CHECK(!found);
+    CHECK(!fs::exists(cache.path) || fs::is_empty(cache.path));
+
+    PopplerPdfExtractor::setPdfToTextPath(std::string());
+    fs::remove(pdfPath);
+}
+
+// Texte en cache : remis sans extraction (ici aucune méthode d'extraction ne pourrait lire le
+// fichier : ni PDF valide, ni pdftotext, ni fichier .txt)
+TEST(ExtractionCache_HitSkipsExtraction)
+{
+    const TestCacheDirectory cache("tchub_extraction_cache_hit_test");
+    const fs::path pdfPath = fs::temp_directory_path() / "tchub_extraction_cache_hit.pdf";
+    std::ofstream(pdfPath, std::ios::binary) << "pas un PDF, seulement une clé de cache";
+    PopplerPdfExtractor::setPdfToTextPath((fs::temp_directory_path() / "introuvable" / "pdftotext").u8string());
+
+    CHECK_EQUAL(PopplerPdfExtractor::extractTextFromPdf(pdfPath.u8string()), std::string());
+
+    writeEntry(ExtractionCache::keyFor(pdfPath.u8string(), true), { "page du cache\n", "\fdeuxième page\n" });
+    CHECK_EQUAL(PopplerPdfExtractor::extractTextFromPdf(pdfPath.u8string()), std::string("page du cache\n\fdeuxième page\n"));
+    CHECK_EQUAL(PopplerPdfExtractor::extractPages(pdfPath.u8string()).size(), size_t(2));
+    CHECK_EQUAL(PopplerPdfExtractor::extractFirstPage(pdfPath.u8string()), std::string("page du cache\n"));
+
+    // Autre option de mise en page : autre clé, pas de texte en cache
+    CHECK_EQUAL(PopplerPdfExtractor::extractTextFromPdf(pdfPath.u8string(), false), std::string());
+
+    PopplerPdfExtractor::setPdfToTextPath(std::string());
+    fs::remove(pdfPath);
+}
@@ -0,0 +1,178 @@
+#include "../TestFramework.h"
+#include "../../Modules/PDFParser/FrenchNumber.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Séparateurs de milliers rencontrés dans les exports fournisseurs
+    const char* const SEPARATORS[] = { " ", "\xC2\xA0", "\xE2\x80\xAF", "." };
+
+    // Valeur aléatoire écrite au format français, et la même valeur au format C
+    struct FormattedValue
+    {
+        std::string french;
+        std::string c;
+    };
+
+    FormattedValue randomValue(std::mt19937_64& random)
+    {
+        const bool negative = random() % 4 == 0;
+        const int decimals = static_cast<int>(random() % 7);
+        std::uint64_t integerPart = random() % 1000000000000ull;
+        for (std::uint64_t magnitude = random() % 5; magnitude > 0; --magnitude)
+            integerPart /= 1000;  // Petits nombres aussi fréquents que les grands
+
+        std::string fraction;
+        for (int d = 0; d < decimals; ++d)
+            fraction += static_cast<char>('0' + random() % 10);
+
+        const std::string digits = std::to_string(integerPart);
+        const char* separator = SEPARATORS[random() % (sizeof(SEPARATORS) / sizeof(SEPARATORS[0]))];
+        const bool grouped = random() % 2 == 0;
+
+        FormattedValue value;
+        if (negative)
+            value.french = value.c = "-";
+        for (size_t i = 0; i < digits.size(); ++i)
+        {
+            if (grouped && i > 0 && (digits.size() - i) % 3 == 0)
+                value.french += separator;
+            value.french += digits[i];
+        }
+        value.c += digits;
+
+        if (!fraction.empty())
+        {
+            value.french += "," + fraction;
+            value.c += "." + fraction;
+        }
+        else if (std::strcmp(separator, ".") == 0 && grouped && digits.size() > 3)
+        {
+            value.french += ",0";  // Sans virgule, "1.234" se lirait 1,234
+            value.c += ".0";
+        }
+
+        if (random() % 3 == 0)
+            value.french += random() % 2 == 0 ? " \xE2\x82\xAC" : "\xE2\x82\xAC";
+        return value;
+    }
+
+    // Lecture utilisée par les parseurs avant FrenchNumber (copie, std::replace, std::stod)
+    double parseWithStod(const std::string& str)
+    {
+        std::string cleaned = str;
+        cleaned.erase(std::remove(cleaned.begin(), cleaned.end(), ' '), cleaned.end());
+        std::replace(cleaned.begin(), cleaned.end(), ',', '.');
+        try
+        {
+            return std::stod(cleaned);
+        }
+        catch (...)
+        {
+            return 0.0;
+        }
+    }
+}
+
+// Valeurs aléatoires (milliers groupés, espaces insécables, points, négatifs, €) : même double,
+// au bit près, que strtod sur l'écriture C
+TEST(FrenchNumber_RoundTripsRandomValues)
+{
+    std::mt19937_64 random(20261018);
+    int mismatches = 0;
+    for (int i = 0; i < 200000; ++i)
+    {
+        const FormattedValue value = randomValue(random);
+        const double expected = std::strtod(value.c.c_str(), nullptr);
+        double parsed = 0.0;
+        if (!FrenchNumber::parse(value.french, parsed) || std::memcmp(&parsed, &expected, sizeof(double)) != 0)
+        {
+            if (++mismatches <= 5)
+                CHECK_EQUAL(value.french, value.c);  // Affiche les premiers écarts
+        }
+    }
+    CHECK_EQUAL(mismatches, 0);
+}
+
+TEST(FrenchNumber_AcceptedForms)
+{
+    const struct
+    {
+        const char* text;
+        double expected;
+    } cases[] = {
+        { "1 234,56", 1234.56 },
+        { "1\xC2\xA0" "234,56", 1234.56 },
+        { "1\xE2\x80\xAF" "234,56", 1234.56 },
+        { "1\xA0" "234,56", 1234.56 },
+        { "1.234,56", 1234.56 },
+        { "1.234.567,5", 1234567.5 },
+        { "0.68", 0.68 },
+        { "-12,50", -12.5 },
+        { "- 12,50", -12.5 },
+        { "19,02 \xE2\x82\xAC", 19.02 },
+        { "  390  ", 390.0 },
+        { ",5", 0.5 },
+    };
+    for (const auto& c : cases)
+    {
+        double value = 0.0;
+        CHECK(FrenchNumber::parse(c.text, value));
+        CHECK_EQUAL(value, c.expected);
+    }
+}
+
+TEST(FrenchNumber_RejectsMalformedText)
+{
+    for (const char* text : { "", "   ", "-", "\xE2\x82\xAC", "abc", "1,2,3", "12,5x", "1.234.5", "1-2", "--3" })
+    {
+        double value = 42.0;
+        CHECK(!FrenchNumber::parse(text, value));
+        CHECK_EQUAL(value, 42.0);
+        CHECK_EQUAL(FrenchNumber::parseOr(text, -1.0), -1.0);
+    }
+
+    // Au-delà de MAX_LENGTH chiffres : refusé plutôt que tronqué
+    double value = 0.0;
+    CHECK(!FrenchNumber::parse(std::string(FrenchNumber::MAX_LENGTH + 1, '9'), value));
+}
+
+// Débit de lecture sur des montants "12 345,67" : ancienne lecture par std::stod contre FrenchNumber
+BENCHMARK(FrenchNumber_Throughput)
+{
+    std::mt19937_64 random(42);
+    std::vector<std::string> inputs;
+    inputs.reserve(1000000);
+    for (size_t i = 0; i < inputs.capacity(); ++i)
+    {
+        const std::uint64_t cents = random() % 10000000;
+        std::string text = std::to_string(cents / 100);
+        if (text.size() > 3)
+            text.insert(text.size() - 3, " ");
+        const std::uint64_t fraction = cents % 100;
+        text += (fraction < 10 ? ",0" : ",") + std::to_string(fraction);
+        inputs.push_back(text);
+    }
+
+    double nanoseconds[2] = { 0.0, 0.0 };
+    double sums[2] = { 0.0, 0.0 };
+    for (int method = 0; method < 2; ++method)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (const std::string& text : inputs)
+            sums[method] += method == 0 ? parseWithStod(text) : FrenchNumber::parseOr(text);
+        nanoseconds[method] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / inputs.size();
+    }
+
+    CHECK_EQUAL(sums[1], sums[0]);
+    std::cout << "  std::stod : " << nanoseconds[0] << " ns/nombre, FrenchNumber : " << nanoseconds[1]
+              << " ns/nombre (x" << nanoseconds[0] / nanoseconds[1] << ")\n";
+}
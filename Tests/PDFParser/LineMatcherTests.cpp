@@ -0,0 +1,244 @@
+#include "../TestFramework.h"
+#include "../../Modules/PDFParser/LineMatcher.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Matcher et expression régulière qu'il remplace (telle qu'écrite dans les parseurs avant
+    // LineMatcher)
+    struct MatcherCase
+    {
+        const char* name;
+        std::shared_ptr<LineMatcher> matcher;
+        std::regex pattern;
+        size_t firstComparedGroup;  // 1 si le groupe 0 de l'expression inclut un suffixe facultatif ignoré
+    };
+
+    std::vector<MatcherCase> matcherCases()
+    {
+        return {
+            { "DecimalMatcher(2, 2)", std::make_shared<DecimalMatcher>(2, 2),
+              std::regex(R"((\d+,\d{2})\s*(?:€|EUR)?)"), 1 },
+            { "DecimalMatcher(2, 4)", std::make_shared<DecimalMatcher>(2, 4),
+              std::regex(R"((\d+,\d{2,4}))"), 0 },
+            { "LindabHeaderMatcher", std::make_shared<LindabHeaderMatcher>(),
+              std::regex(R"(^\s*(\d+)\s+(\d{6})\b)"), 0 },
+            { "LindabPceMatcher", std::make_shared<LindabPceMatcher>(),
+              std::regex(R"((-?\d+,\d{2})\s*PCE\s+(-?\d+,\d{2})\s+(-?\d+,\d{2}))"), 0 },
+            { "FischerLine1Matcher", std::make_shared<FischerLine1Matcher>(),
+              std::regex(R"(^\s*\d+\s+(.+?)\s+(\d+)\s+(BTE|PCE)\b)"), 0 },
+            { "FischerLine2Matcher", std::make_shared<FischerLine2Matcher>(),
+              std::regex(R"(^\s*\d{10,}\s+(\d{5,})\b)"), 0 },
+            { "PiecLineMatcher(PRICED)", std::make_shared<PiecLineMatcher>(PiecLineMatcher::Kind::PRICED),
+              std::regex(R"(^(?:(\S+)\s+)?(.*?)\s+(\d+,\d{3})\s+PIEC\s+(\d+,\d{2})\s+PIEC\s+(\d+,\d{2})\s*$)"), 0 },
+            { "PiecLineMatcher(FREE)", std::make_shared<PiecLineMatcher>(PiecLineMatcher::Kind::FREE),
+              std::regex(R"(^(?:(\S+)\s+)?(.*?)\s+(\d+,\d{3})\s+PIEC\s+PIEC\s+Gratuit\s*$)"), 0 },
+            { "CgrTailMatcher", std::make_shared<CgrTailMatcher>(),
+              std::regex(R"(\s(\d+)\s+([\d,]+)\s*€\s+([\d,]+)\s*€)"), 0 },
+            { "RexelRefMatcher", std::make_shared<RexelRefMatcher>(),
+              std::regex(R"(NDX\d+)"), 0 },
+        };
+    }
+
+    // Écart entre le matcher et std::regex_search sur une ligne (vide si identiques)
+    std::string compare(const MatcherCase& c, const std::string& line)
+    {
+        LineMatch match;
+        const bool found = c.matcher->search(line, match);
+        std::cmatch expected;
+        const bool expectedFound = std::regex_search(line.data(), line.data() + line.size(), expected, c.pattern);
+
+        if (found != expectedFound)
+            return std::string(c.name) + (found ? " trouve" : " ne trouve pas") + " \"" + line + "\"";
+        if (!found)
+            return std::string();
+
+        for (size_t g = c.firstComparedGroup; g <= c.pattern.mark_count(); ++g)
+        {
+            const bool participated = expected[g].matched;
+            if (match.matched(g) != participated ||
+                (participated && (match[g].data() != line.data() + expected.position(g) ||
+                                  match[g].size() != static_cast<size_t>(expected.length(g)))))
+            {
+                return std::string(c.name) + " groupe " + std::to_string(g) + " \"" + std::string(match[g]) +
+                       "\" au lieu de \"" + expected[g].str() + "\" dans \"" + line + "\"";
+            }
+        }
+        return std::string();
+    }
+
+    // Ligne aléatoire faite des morceaux rencontrés dans les exports fournisseurs
+    std::string randomLine(std::mt19937& random)
+    {
+        static const char* const WORDS[] = {
+            "PCE", "PIEC", "BTE", "Gratuit", "EUR", "\xE2\x82\xAC", "NDX", "PCEX", "BTE2", "Vis",
+            "T\xC3\x8ATE", "-", ",", "x", "_", "j", "DN20", "\xC2\xA0" };
+        static const char* const SPACES[] = { " ", " ", "  ", "\t", "", "   " };
+
+        auto digits = [&random](size_t count)
+        {
+            std::string text;
+            for (size_t i = 0; i < count; ++i)
+                text += static_cast<char>('0' + random() % 10);
+            return text;
+        };
+
+        std::string line;
+        if (random() % 3 == 0)
+            line += SPACES[random() % 6];
+        const size_t tokens = 1 + random() % 10;
+        for (size_t t = 0; t < tokens; ++t)
+        {
+            if (t > 0)
+                line += SPACES[random() % 6];
+            switch (random() % 6)
+            {
+            case 0:
+                line += digits(1 + random() % 12);
+                break;
+            case 1:
+            case 2:
+                line += (random() % 5 == 0 ? "-" : "") + digits(1 + random() % 5) + "," + digits(random() % 6);
+                break;
+            case 3:
+                line += "NDX" + digits(random() % 8);
+                break;
+            default:
+                line += WORDS[random() % (sizeof(WORDS) / sizeof(WORDS[0]))];
+                break;
+            }
+        }
+
+        // Fin de ligne proche des motifs ancrés, avec des nombres de chiffres variables
+        auto decimal = [&](size_t decimals)
+        {
+            return digits(1 + random() % 3) + "," + digits(decimals + (random() % 4 == 0 ? 1 : 0));
+        };
+        switch (random() % 6)
+        {
+        case 0:
+            line += " " + decimal(3) + " PIEC " + decimal(2) + " PIEC " + decimal(2);
+            break;
+        case 1:
+            line += " " + decimal(3) + " PIEC PIEC Gratuit";
+            break;
+        case 2:
+            line += " " + digits(1 + random() % 3) + " " + decimal(2) + " \xE2\x82\xAC " + decimal(2) + " \xE2\x82\xAC";
+            break;
+        case 3:
+            line += " " + decimal(2) + " PCE " + decimal(2) + " " + decimal(2);
+            break;
+        default:
+            break;
+        }
+        if (random() % 4 == 0)
+            line += SPACES[random() % 6];
+        return line;
+    }
+}
+
+// Lignes typiques de chaque fournisseur et cas limites (\b, groupes facultatifs, espaces de fin)
+TEST(LineMatcher_MatchesRegexOnSupplierLines)
+{
+    const char* const lines[] = {
+        "1 224931 SR 200 3000 GALV",
+        "  12 224931",
+        "12 2249310",
+        "12 224931_",
+        "10,00  PCE                 18,90                    188,99",
+        "-1,00PCE -18,90 -18,90",
+        "10,00 PCE 18,90",
+        "1 Cheville SX 8 x 40 100 BTE",
+        "1 Cheville SX 8 x 40 100 PCEX",
+        "2 Vis  12  PCE",
+        "0123456789 12345",
+        "0123456789 1234",
+        "123456789 12345",
+        "ART-01 Coude cuivre 90° 12,000 PIEC 1,25 PIEC 15,00",
+        "Coude cuivre 12,000 PIEC 1,25 PIEC 15,00  ",
+        "ART-01 Coude 12,000 PIEC PIEC Gratuit",
+        "A 12,000 PIEC PIEC Gratuit",
+        " 12,000 PIEC 1,25 PIEC 15,00",
+        "Désignation 4 12,50 € 50,00 €",
+        "Désignation 4 12,50€ 50,00€",
+        "NDX12345678 Raccord",
+        "NDX Raccord",
+        "Prix 12,5 12,5678 12,56789 19,02 € 3,10 EUR",
+        "",
+    };
+
+    for (const MatcherCase& c : matcherCases())
+    {
+        for (const char* line : lines)
+        {
+            const std::string difference = compare(c, line);
+            CHECK_EQUAL(difference, std::string());
+        }
+    }
+}
+
+// Lignes aléatoires : même résultat et mêmes captures que std::regex pour chaque matcher
+TEST(LineMatcher_MatchesRegexOnRandomLines)
+{
+    std::mt19937 random(46);
+    std::vector<std::string> lines;
+    for (int i = 0; i < 20000; ++i)
+        lines.push_back(randomLine(random));
+
+    for (const MatcherCase& c : matcherCases())
+    {
+        int differences = 0;
+        for (const std::string& line : lines)
+        {
+            const std::string difference = compare(c, line);
+            if (!difference.empty() && ++differences <= 3)
+                CHECK_EQUAL(difference, std::string());  // Affiche les premiers écarts
+        }
+        CHECK_EQUAL(differences, 0);
+    }
+}
+
+// Temps de recherche par ligne, tous motifs confondus : std::regex contre les matchers
+BENCHMARK(LineMatcher_VersusRegex)
+{
+    std::mt19937 random(50000);
+    std::vector<std::string> lines;
+    for (int i = 0; i < 50000; ++i)
+        lines.push_back(randomLine(random));
+
+    const std::vector<MatcherCase> cases = matcherCases();
+    double nanoseconds[2] = { 0.0, 0.0 };
+    size_t found[2] = { 0, 0 };
+    for (int method = 0; method < 2; ++method)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (const MatcherCase& c : cases)
+        {
+            for (const std::string& line : lines)
+            {
+                if (method == 0)
+                {
+                    std::cmatch match;
+                    found[method] += std::regex_search(line.data(), line.data() + line.size(), match, c.pattern);
+                }
+                else
+                {
+                    LineMatch match;
+                    found[method] += c.matcher->search(line, match);
+                }
+            }
+        }
+        nanoseconds[method] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                              (lines.size() * cases.size());
+    }
+
+    CHECK_EQUAL(found[1], found[0]);
+    std::cout << "  std::regex : " << nanoseconds[0] << " ns/ligne, LineMatcher : " << nanoseconds[1]
+              << " ns/ligne (x" << nanoseconds[0] / nanoseconds[1] << ")\n";
+}
@@ -0,0 +1,263 @@
+#include "../TestFramework.h"
+#include "../../Modules/PDFParser/ParallelPageReader.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Page dont l'extraction prend un temps variable : les threads finissent dans le désordre
+    ParallelPageReader::ReaderFactory slowPages(std::atomic<int>* pagesRead = nullptr)
+    {
+        return [pagesRead](unsigned) -> ParallelPageReader::PageReader
+        {
+            return [pagesRead](int i)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds((i * 7919) % 5 * 200));
+                if (pagesRead)
+                    ++*pagesRead;
+                return "page " + std::to_string(i) + "\n";
+            };
+        };
+    }
+
+    // Travail de calcul d'une page (mesure de la répartition entre cœurs)
+    std::string computePage(int i)
+    {
+        std::uint64_t hash = 1469598103934665603ull + static_cast<std::uint64_t>(i);
+        for (int k = 0; k < 400000; ++k)
+            hash = (hash ^ static_cast<std::uint64_t>(k)) * 1099511628211ull;
+        return std::to_string(hash) + "\n";
+    }
+}
+
+// Pages remises une fois chacune, dans l'ordre du document, quel que soit l'ordre de fin des threads
+TEST(ParallelPageReader_DeliversPagesInOrder)
+{
+    for (unsigned threads : { 1u, 3u, 8u })
+    {
+        std::vector<int> indices;
+        std::string text;
+        bool delivered = false;
+        const ParallelPageReader::Result result = ParallelPageReader::read(40, threads, slowPages(),
+            [&](std::string& page, int pageIndex, int pageCount)
+            {
+                CHECK_EQUAL(pageCount, 40);
+                indices.push_back(pageIndex);
+                text += page;
+                return true;
+            },
+            delivered);
+
+        CHECK(result == ParallelPageReader::Result::Complete);
+        CHECK(delivered);
+        CHECK_EQUAL(indices.size(), size_t(40));
+        for (size_t i = 0; i < indices.size(); ++i)
+            CHECK_EQUAL(indices[i], static_cast<int>(i));
+
+        std::string expected;
+        for (int i = 0; i < 40; ++i)
+            expected += "page " + std::to_string(i) + "\n";
+        CHECK(text == expected);
+    }
+
+    CHECK_EQUAL(ParallelPageReader::effectiveThreadCount(3, 8), 3u);
+    CHECK_EQUAL(ParallelPageReader::effectiveThreadCount(0, 8), 1u);
+    CHECK(ParallelPageReader::effectiveThreadCount(100, 0) >= 1u);
+}
+
+// Consommateur lent : jamais plus de LOOK_AHEAD_PER_THREAD pages par thread extraites d'avance
+TEST(ParallelPageReader_BoundsLookAhead)
+{
+    const unsigned threads = 2;
+    const int window = static_cast<int>(ParallelPageReader::LOOK_AHEAD_PER_THREAD * threads);
+    std::atomic<int> accepted(0);
+    std::atomic<int> maxAhead(0);
+    const ParallelPageReader::ReaderFactory makeReader = [&](unsigned) -> ParallelPageReader::PageReader
+    {
+        return [&](int i)
+        {
+            const int ahead = i - accepted.load();
+            int previous = maxAhead.load();
+            while (ahead > previous && !maxAhead.compare_exchange_weak(previous, ahead))
+            {
+            }
+            return "page\n";
+        };
+    };
+
+    bool delivered = false;
+    const ParallelPageReader::Result result = ParallelPageReader::read(60, threads, makeReader,
+        [&](std::string&, int, int)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++accepted;
+            return true;
+        },
+        delivered);
+
+    CHECK(result == ParallelPageReader::Result::Complete);
+    CHECK_EQUAL(accepted.load(), 60);
+    CHECK(maxAhead.load() < window);
+    CHECK(maxAhead.load() > 0);
+}
+
+// Annulation par onPage : aucune page remise ensuite, les threads s'arrêtent sans tout extraire
+TEST(ParallelPageReader_CancelStopsExtraction)
+{
+    const unsigned threads = 4;
+    std::atomic<int> pagesRead(0);
+    int calls = 0;
+    bool delivered = false;
+    const ParallelPageReader::Result result = ParallelPageReader::read(500, threads, slowPages(&pagesRead),
+        [&](std::string&, int pageIndex, int)
+        {
+            ++calls;
+            return pageIndex < 5;
+        },
+        delivered);
+
+    CHECK(result == ParallelPageReader::Result::Cancelled);
+    CHECK(delivered);
+    CHECK_EQUAL(calls, 6);
+    CHECK(pagesRead.load() <= 6 + static_cast<int>(ParallelPageReader::LOOK_AHEAD_PER_THREAD * threads + threads));
+}
+
+// Pages vides du début retenues jusqu'à la première page avec du texte ; aucune page avec du
+// texte : rien n'est remis
+TEST(ParallelPageReader_HoldsBackLeadingEmptyPages)
+{
+    std::atomic<bool> textPageRead(false);
+    const ParallelPageReader::ReaderFactory makeReader = [&](unsigned) -> ParallelPageReader::PageReader
+    {
+        return [&](int i) -> std::string
+        {
+            if (i < 3)
+                return "\n";
+            textPageRead = true;
+            return "texte\n";
+        };
+    };
+
+    std::vector<int> indices;
+    bool heldBack = true;
+    bool delivered = false;
+    ParallelPageReader::Result result = ParallelPageReader::read(5, 2, makeReader,
+        [&](std::string&, int pageIndex, int)
+        {
+            heldBack = heldBack && textPageRead;
+            indices.push_back(pageIndex);
+            return true;
+        },
+        delivered);
+
+    CHECK(result == ParallelPageReader::Result::Complete);
+    CHECK(heldBack);
+    CHECK((indices == std::vector<int>{ 0, 1, 2, 3, 4 }));
+
+    int calls = 0;
+    const ParallelPageReader::ReaderFactory emptyPages = [](unsigned) -> ParallelPageReader::PageReader
+    {
+        return [](int) { return std::string("\n"); };
+    };
+    result = ParallelPageReader::read(6, 3, emptyPages, [&](std::string&, int, int) { ++calls; return true; }, delivered);
+    CHECK(result == ParallelPageReader::Result::NoText);
+    CHECK(!delivered);
+    CHECK_EQUAL(calls, 0);
+}
+
+// Exception d'un thread d'extraction : échec signalé ; exception de onPage : threads arrêtés et
+// attendus, exception transmise à l'appelant (pas de std::terminate)
+TEST(ParallelPageReader_ExceptionsStopAllThreads)
+{
+    bool delivered = false;
+    const auto acceptAll = [](std::string&, int, int) { return true; };
+
+    const ParallelPageReader::ReaderFactory failingPage = [](unsigned) -> ParallelPageReader::PageReader
+    {
+        return [](int i) -> std::string
+        {
+            if (i == 7)
+                throw std::runtime_error("page illisible");
+            return "page\n";
+        };
+    };
+    CHECK(ParallelPageReader::read(50, 4, failingPage, acceptAll, delivered) == ParallelPageReader::Result::Failed);
+
+    const ParallelPageReader::ReaderFactory failingThread = [](unsigned threadIndex) -> ParallelPageReader::PageReader
+    {
+        if (threadIndex == 1)
+            throw std::runtime_error("document illisible");
+        return [](int) { return std::string("page\n"); };
+    };
+    CHECK(ParallelPageReader::read(50, 4, failingThread, acceptAll, delivered) == ParallelPageReader::Result::Failed);
+
+    std::atomic<int> pagesRead(0);
+    bool thrown = false;
+    try
+    {
+        ParallelPageReader::read(500, 4, slowPages(&pagesRead),
+            [](std::string&, int pageIndex, int) -> bool
+            {
+                if (pageIndex == 2)
+                    throw std::runtime_error("consommateur en échec");
+                return true;
+            },
+            delivered);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+    CHECK(delivered);
+    CHECK(pagesRead.load() < 500);
+}
+
+// Répartition entre cœurs : 1, 2, 4... threads jusqu'au nombre de cœurs, pages de calcul pur
+BENCHMARK(ParallelPageReader_ScalingPerCore)
+{
+    const int pageCount = 256;
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < cores; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(cores);
+
+    const ParallelPageReader::ReaderFactory makeReader = [](unsigned) -> ParallelPageReader::PageReader
+    {
+        return computePage;
+    };
+
+    std::string reference;
+    double singleThreadMs = 0.0;
+    for (unsigned threads : threadCounts)
+    {
+        std::string text;
+        bool delivered = false;
+        const auto start = std::chrono::steady_clock::now();
+        const ParallelPageReader::Result result = ParallelPageReader::read(pageCount, threads, makeReader,
+            [&text](std::string& page, int, int)
+            {
+                text += page;
+                return true;
+            },
+            delivered);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        CHECK(result == ParallelPageReader::Result::Complete);
+        if (threads == 1)
+        {
+            reference = text;
+            singleThreadMs = ms;
+        }
+        CHECK(text == reference);
+        std::cout << "  " << threads << " thread(s) : " << ms << " ms (x" << singleThreadMs / ms << ")\n";
+    }
+}
@@ -0,0 +1,139 @@
+#include "../TestFramework.h"
+#include "../../Modules/PDFParser/ParserFactory.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    std::string readFixture(const std::string& name)
+    {
+        const std::filesystem::path path = std::filesystem::path(__FILE__).parent_path() / "Fixtures" / name;
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // Premières pages d'après les formats relevés dans les parseurs ; header = en-tête société
+    std::string lindabPage(bool header)
+    {
+        return std::string(header ? "LINDAB France - Confirmation de commande\n" : "Confirmation de commande\n")
+            + "Pos   Article            Désignation\n"
+              "1         224931             SR               200 3000 GALV\n"
+              "          Conduit circulaire\n"
+              "10,00  PCE                                             18,90                    188,99\n"
+              "Date de réception                  14/11/2025\n"
+              "2         224950             SR               250 3000 GALV\n"
+              "4,00  PCE                                             24,10                    96,40\n"
+              "Date de réception                  14/11/2025\n";
+    }
+
+    std::string fischerPage(bool header)
+    {
+        return std::string(header ? "fischer France SAS\n" : "Bon de livraison\n")
+            + "10         Collier FRSR 20-25 M8/M10 -100/bte           6   BTE    0,01    1   BTE    145,14\n"
+              "4048962230956               534135                      Éco-contribution    0,01    0,06\n"
+              "Total éco-contribution comprise                         22,99    137,94\n"
+              "20         Cheville SX 8 -100/bte           2   BTE    0,01    1   BTE    12,40\n"
+              "4048962014204               070008                      Éco-contribution    0,01    0,02\n";
+    }
+
+    std::string siehrPage(bool header)
+    {
+        return std::string(header ? "SIEHR - Devis n° 45121\n" : "Devis n° 45121\n")
+            + "SB2050  AS  PAROI FIXE LINEAIRE  600 HT 2000        DIVERA                2,000 PIEC    174,00 PIEC        348,00\n"
+              "Ecopart. 0,50\n"
+              "SB2051  AS  PAROI PIVOTANTE 900        DIVERA                1,000 PIEC    212,00 PIEC        212,00\n"
+              "Ecopart. 0,50\n";
+    }
+
+    std::string pompacPage(bool header, bool freeLines)
+    {
+        std::string page = header ? "POMPAC - Accusé de réception\n" : "Accusé de réception\n";
+        page += "T30139  RAD. ALU KLASS. SIMPLE 22 500 1200 2196W  1,000 PIEC  257,64 PIEC  257,64\n"
+                "Ecopart. 1,20\n"
+                "T30140  RAD. ALU KLASS. SIMPLE 22 600 1000 1830W  2,000 PIEC  231,10 PIEC  462,20\n";
+        if (freeLines)
+        {
+            page += "T28971  RAD. PIANO UNI 6 22 900 900 1880W  1,000 PIEC  PIEC  Gratuit\n"
+                    "T28972  RAD. PIANO UNI 6 22 900 600 1250W  1,000 PIEC  PIEC  Gratuit\n";
+        }
+        return page;
+    }
+
+    std::string cgrPage()
+    {
+        return "C G R   Distribution\n"
+               "R SA U 5 0   Raccord union 50   2   12,50 €   25,00 €\n"
+               "R SA U 6 3   Raccord union 63   1   18,20 €   18,20 €\n";
+    }
+
+    void checkDetected(const std::string& page, Supplier expected)
+    {
+        const SupplierDetection detection = ParserFactory::detectSupplier(page);
+        CHECK(detection.found);
+        CHECK_EQUAL(ParserFactory::supplierName(detection.supplier), ParserFactory::supplierName(expected));
+        CHECK(detection.confidence >= 0.6);
+        CHECK(detection.confidence <= 1.0);
+    }
+}
+
+TEST(ParserFactory_DetectsEachSupplierOnSamplePage)
+{
+    checkDetected(lindabPage(true), Supplier::Lindab);
+    checkDetected(fischerPage(true), Supplier::Fischer);
+    checkDetected(siehrPage(true), Supplier::Siehr);
+    checkDetected(pompacPage(true, false), Supplier::Pompac);
+    checkDetected(pompacPage(true, true), Supplier::Pompac);
+    checkDetected(cgrPage(), Supplier::CGR);
+
+    const std::string rexel = readFixture("rexel_devis.txt");
+    CHECK(!rexel.empty());
+    checkDetected(rexel.substr(0, rexel.find('\f')), Supplier::Rexel);
+
+    // Mots communs (PIEC, Ecopart.) comptés une fois dans le total : le nom en en-tête suffit
+    const SupplierDetection siehr = ParserFactory::detectSupplier(siehrPage(true));
+    CHECK_EQUAL(siehr.confidence, 1.0);
+}
+
+// Sans nom de fournisseur : formes de lignes et mots propres au fournisseur
+TEST(ParserFactory_DetectsWithoutCompanyHeader)
+{
+    checkDetected(lindabPage(false), Supplier::Lindab);
+    checkDetected(fischerPage(false), Supplier::Fischer);
+    checkDetected(pompacPage(false, true), Supplier::Pompac);  // Articles gratuits : Pompac seul
+
+    // Siehr et Pompac ont la même mise en page : à égalité, rien n'est reconnu
+    for (const std::string& page : { siehrPage(false), pompacPage(false, false) })
+    {
+        const SupplierDetection detection = ParserFactory::detectSupplier(page);
+        CHECK(!detection.found);
+        CHECK(detection.score > 0);
+    }
+
+    // Un devis Siehr ne devient pas Pompac pour un mot "gratuit" hors ligne d'article
+    const SupplierDetection siehr = ParserFactory::detectSupplier(siehrPage(false) + "Livraison gratuite, transport gratuit\n");
+    CHECK(!siehr.found);
+}
+
+// Texte vide ou sans signature ; mots entiers seulement, casse ignorée
+TEST(ParserFactory_IgnoresTextWithoutSignatures)
+{
+    SupplierDetection detection = ParserFactory::detectSupplier("");
+    CHECK(!detection.found);
+    CHECK_EQUAL(detection.score, 0);
+    CHECK_EQUAL(detection.confidence, 0.0);
+
+    detection = ParserFactory::detectSupplier("Facture\nMerci de votre confiance\n");
+    CHECK(!detection.found);
+    CHECK_EQUAL(detection.score, 0);
+
+    detection = ParserFactory::detectSupplier("lindabs rexelle NDX pompacs PCES\n");
+    CHECK(!detection.found);
+    CHECK_EQUAL(detection.score, 0);
+
+    checkDetected("Commande Rexel", Supplier::Rexel);
+    checkDetected("commande rEXEL\r\n", Supplier::Rexel);
+}
@@ -0,0 +1,204 @@
+#include "../TestFramework.h"
+#include "../../Modules/PDFParser/PdfBatchConverter.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    fs::path emptyDirectory(const std::string& name)
+    {
+        const fs::path directory = fs::temp_directory_path() / name;
+        fs::remove_all(directory);
+        fs::create_directories(directory);
+        return directory;
+    }
+
+    // Devis Rexel convertible : PDF factice et son texte dans le fichier .txt de secours
+    std::string writeRexelQuote(const fs::path& directory, const std::string& stem)
+    {
+        static const std::string text = []()
+        {
+            std::ifstream fixture(fs::path(__FILE__).parent_path() / "Fixtures" / "rexel_devis.txt", std::ios::binary);
+            std::ostringstream content;
+            content << fixture.rdbuf();
+            return content.str();
+        }();
+        std::ofstream(directory / (stem + ".pdf"), std::ios::binary) << "pas un PDF " << stem;
+        std::ofstream(directory / (stem + ".txt"), std::ios::binary) << text;
+        return (directory / (stem + ".pdf")).u8string();
+    }
+
+    std::vector<std::string> fileNames(const std::vector<std::string>& paths)
+    {
+        std::vector<std::string> names;
+        for (const std::string& path : paths)
+            names.push_back(fs::u8path(path).filename().u8string());
+        return names;
+    }
+}
+
+// Lot d'un devis Rexel (texte lu dans le fichier .txt de secours) : classeur écrit, sans le
+// fichier de débogage _rexel_extracted.txt qu'une analyse depuis l'interface laisse à côté du PDF
+TEST(PdfBatchConverter_WritesNoDebugDump)
+{
+    const fs::path directory = fs::temp_directory_path() / "tchub_batch_test";
+    fs::remove_all(directory);
+    fs::create_directories(directory);
+
+    std::ifstream fixture(fs::path(__FILE__).parent_path() / "Fixtures" / "rexel_devis.txt", std::ios::binary);
+    std::ostringstream text;
+    text << fixture.rdbuf();
+    std::ofstream(directory / "devis.pdf", std::ios::binary) << "pas un PDF";
+    std::ofstream(directory / "devis.txt", std::ios::binary) << text.str();
+
+    const BatchSummary summary = PdfBatchConverter::run({ (directory / "devis.pdf").u8string() }, PdfBatchConverter::Options());
+
+    CHECK_EQUAL(summary.succeeded, size_t(1));
+    CHECK(summary.lineCount > 0);
+    CHECK(!fs::exists(directory / "devis_rexel_extracted.txt"));
+
+    fs::remove_all(directory);
+}
+
+// Dossier : ses .pdf (casse ignorée) sans les sous-dossiers ; motif avec * et ? ; fichier seul ;
+// dossier absent : exception
+TEST(PdfBatchConverter_ListInputsMatchesWildcards)
+{
+    const fs::path directory = emptyDirectory("tchub_batch_list_test");
+    for (const char* name : { "2025-01.pdf", "2025-02.PDF", "2025-10.pdf", "2024-12.pdf", "notes.txt", "2025-03.pdf.bak" })
+        std::ofstream(directory / name) << "x";
+    fs::create_directories(directory / "archive");
+    std::ofstream(directory / "archive" / "2025-04.pdf") << "x";
+
+    using Names = std::vector<std::string>;
+    CHECK((fileNames(PdfBatchConverter::listInputs(directory.u8string())) ==
+           Names{ "2024-12.pdf", "2025-01.pdf", "2025-02.PDF", "2025-10.pdf" }));
+    CHECK((fileNames(PdfBatchConverter::listInputs((directory / "2025-*.pdf").u8string())) ==
+           Names{ "2025-01.pdf", "2025-02.PDF", "2025-10.pdf" }));
+    CHECK((fileNames(PdfBatchConverter::listInputs((directory / "2025-0?.pdf").u8string())) ==
+           Names{ "2025-01.pdf", "2025-02.PDF" }));
+    CHECK((fileNames(PdfBatchConverter::listInputs((directory / "*-1*").u8string())) ==
+           Names{ "2024-12.pdf", "2025-10.pdf" }));
+    CHECK((fileNames(PdfBatchConverter::listInputs((directory / "2025-?.pdf").u8string())) == Names{}));
+    CHECK((fileNames(PdfBatchConverter::listInputs((directory / "notes.txt").u8string())) == Names{ "notes.txt" }));
+
+    bool thrown = false;
+    try
+    {
+        PdfBatchConverter::listInputs((directory / "absent" / "*.pdf").u8string());
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    fs::remove_all(directory);
+}
+
+// Fichier en échec : compté et rapporté avec sa cause, les autres fichiers sont convertis
+TEST(PdfBatchConverter_ReportsFailuresPerFile)
+{
+    const fs::path directory = emptyDirectory("tchub_batch_failure_test");
+    const std::string good = writeRexelQuote(directory, "devis");
+    const std::string unknown = (directory / "inconnu.pdf").u8string();
+    std::ofstream(fs::u8path(unknown)) << "pas un PDF";
+    const std::string missing = (directory / "absent.pdf").u8string();
+
+    std::vector<std::string> reported;
+    const BatchSummary summary = PdfBatchConverter::run({ good, unknown, missing }, PdfBatchConverter::Options(),
+        [&reported](const BatchFileResult& result, size_t done, size_t total)
+        {
+            CHECK_EQUAL(done, reported.size() + 1);
+            CHECK_EQUAL(total, size_t(3));
+            CHECK_EQUAL(result.success, result.error.empty());
+            reported.push_back(result.pdfPath);
+        });
+
+    CHECK_EQUAL(summary.fileCount, size_t(3));
+    CHECK_EQUAL(summary.succeeded, size_t(1));
+    CHECK_EQUAL(summary.failures.size(), size_t(2));
+    CHECK_EQUAL(reported.size(), size_t(3));
+    CHECK(!summary.cancelled);
+    for (const BatchFileResult& failure : summary.failures)
+    {
+        CHECK(failure.pdfPath == unknown || failure.pdfPath == missing);
+        CHECK(!failure.success);
+        CHECK(!failure.error.empty());
+        CHECK(failure.outputPath.empty());
+    }
+
+    fs::remove_all(directory);
+}
+
+// Annulation : lot annulé d'avance, rien n'est commencé ; annulé après le premier fichier, les
+// fichiers restants ne sont pas commencés
+TEST(PdfBatchConverter_CancelStopsBatch)
+{
+    const fs::path directory = emptyDirectory("tchub_batch_cancel_test");
+    std::vector<std::string> paths;
+    for (int i = 0; i < 20; ++i)
+        paths.push_back(writeRexelQuote(directory, "devis" + std::to_string(i)));
+
+    std::atomic<bool> cancel(true);
+    PdfBatchConverter::Options options;
+    options.cancel = &cancel;
+    size_t calls = 0;
+    BatchSummary summary = PdfBatchConverter::run(paths, options, [&calls](const BatchFileResult&, size_t, size_t) { ++calls; });
+    CHECK(summary.cancelled);
+    CHECK_EQUAL(summary.succeeded, size_t(0));
+    CHECK_EQUAL(calls, size_t(0));
+
+    cancel = false;
+    options.workerCount = 1;
+    options.writerCount = 1;
+    options.queueCapacity = 1;
+    summary = PdfBatchConverter::run(paths, options, [&cancel](const BatchFileResult&, size_t, size_t) { cancel = true; });
+    CHECK(summary.cancelled);
+    CHECK(summary.succeeded >= 1);
+    CHECK(summary.succeeded < paths.size());
+    CHECK(summary.failures.empty());
+
+    fs::remove_all(directory);
+}
+
+// File bornée plus petite que le lot : les analyses attendent les écritures, tous les fichiers
+// sont convertis une fois
+TEST(PdfBatchConverter_BoundedQueueSmallerThanBatch)
+{
+    const fs::path directory = emptyDirectory("tchub_batch_queue_test");
+    const fs::path output = directory / "classeurs";
+    std::vector<std::string> paths;
+    for (int i = 0; i < 12; ++i)
+        paths.push_back(writeRexelQuote(directory, "devis" + std::to_string(i)));
+
+    PdfBatchConverter::Options options;
+    options.outputDirectory = output.u8string();
+    options.workerCount = 4;
+    options.writerCount = 1;
+    options.queueCapacity = 1;
+
+    std::vector<std::string> written;
+    const BatchSummary summary = PdfBatchConverter::run(paths, options,
+        [&written](const BatchFileResult& result, size_t, size_t) { written.push_back(result.outputPath); });
+
+    CHECK_EQUAL(summary.succeeded, paths.size());
+    CHECK(!summary.cancelled);
+    CHECK_EQUAL(written.size(), paths.size());
+    for (const std::string& path : written)
+        CHECK(fs::exists(fs::u8path(path)));
+
+    size_t outputFiles = 0;
+    for (const auto& entry : fs::directory_iterator(output))
+        outputFiles += entry.is_regular_file() ? 1 : 0;
+    CHECK_EQUAL(outputFiles, paths.size());
+
+    fs::remove_all(directory);
+}
@@ -0,0 +1,120 @@
+#include "../TestFramework.h"
+#include "../../Modules/PDFParser/PdfTextStream.h"
+#include "../../Modules/PDFParser/RexelPdfParser.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::string readFixture(const std::string& name)
+    {
+        const std::filesystem::path path = std::filesystem::path(__FILE__).parent_path() / "Fixtures" / name;
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // Parseur qui conserve les lignes reçues
+    class RecordingParser : public IPdfParser
+    {
+    public:
+        std::vector<std::string> lines;
+        int documents = 0;
+
+        std::vector<PdfLine> parse(const std::string&) override { return {}; }
+        std::string getSupplierName() const override { return "Test"; }
+        void beginDocument() override { lines.clear(); }
+        void parseLine(std::string_view line) override { lines.emplace_back(line); }
+        std::vector<PdfLine> endDocument() override
+        {
+            ++documents;
+            return {};
+        }
+    };
+
+    std::vector<std::string> getlineSplit(const std::string& text)
+    {
+        std::vector<std::string> lines;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line))
+            lines.push_back(line);
+        return lines;
+    }
+
+    // Morceaux de 0 à maxSize octets (morceaux vides compris)
+    std::vector<std::string> randomChunks(const std::string& text, std::mt19937& random, size_t maxSize)
+    {
+        std::vector<std::string> chunks;
+        for (size_t position = 0; position < text.size();)
+        {
+            const size_t size = std::min<size_t>(random() % (maxSize + 1), text.size() - position);
+            chunks.push_back(text.substr(position, size));
+            position += size;
+        }
+        return chunks;
+    }
+
+    std::vector<std::string> streamedLines(const std::vector<std::string>& chunks)
+    {
+        RecordingParser parser;
+        PdfTextStream::parseChunks(parser, chunks);
+        CHECK_EQUAL(parser.documents, 1);
+        return parser.lines;
+    }
+}
+
+// Lignes transmises = std::getline sur le texte complet, quel que soit le découpage : lignes à
+// cheval sur plusieurs morceaux, lignes vides, \r conservé, dernière ligne sans fin de ligne
+TEST(PdfTextStream_ChunkedLinesMatchGetline)
+{
+    const std::string fixture = readFixture("rexel_devis.txt");
+    CHECK(!fixture.empty());
+
+    const std::vector<std::string> texts = {
+        fixture,
+        fixture.substr(0, fixture.size() - 1),                       // Sans fin de ligne finale
+        "\n\nligne\r\n\r\n" + fixture + "\n\nfin sans retour\r",
+        "\n",
+        "une seule ligne",
+    };
+
+    std::mt19937 random(43);
+    for (const std::string& text : texts)
+    {
+        const std::vector<std::string> expected = getlineSplit(text);
+        CHECK(streamedLines({ text }) == expected);
+
+        std::vector<std::string> bytes;
+        for (char c : text)
+            bytes.emplace_back(1, c);
+        CHECK(streamedLines(bytes) == expected);
+
+        for (int round = 0; round < 50; ++round)
+        {
+            const size_t maxSize = (round % 2 == 0) ? 8 : 200;
+            CHECK(streamedLines(randomChunks(text, random, maxSize)) == expected);
+        }
+    }
+
+    // Parseur réel : mêmes articles qu'en un seul morceau
+    RexelPdfParser whole;
+    const std::vector<PdfLine> expected = PdfTextStream::parseText(whole, fixture);
+    CHECK(!expected.empty());
+    for (int round = 0; round < 20; ++round)
+    {
+        RexelPdfParser parser;
+        const std::vector<PdfLine> actual = PdfTextStream::parseChunks(parser, randomChunks(fixture, random, 64));
+        CHECK_EQUAL(actual.size(), expected.size());
+        for (size_t i = 0; i < std::min(actual.size(), expected.size()); ++i)
+        {
+            CHECK_EQUAL(actual[i].reference, expected[i].reference);
+            CHECK_EQUAL(actual[i].montantHT, expected[i].montantHT);
+        }
+    }
+}
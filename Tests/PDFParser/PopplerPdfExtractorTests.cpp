@@ -0,0 +1,111 @@
+#include "../TestFramework.h"
+#include "../../Modules/PDFParser/ExtractionCache.h"
+#include "../../Modules/PDFParser/PopplerPdfExtractor.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Première page seulement : le texte rendu d'un bloc (ici le fichier .txt de secours, comme
+// pdftotext) est coupé au premier saut de page
+TEST(PopplerPdfExtractor_FirstPageStopsAtPageBreak)
+{
+    const std::string pdfPath = "poppler_first_page_test.pdf";
+    const std::string txtPath = "poppler_first_page_test.txt";
+    std::ofstream(pdfPath, std::ios::binary) << "pas un PDF";
+    std::ofstream(txtPath, std::ios::binary) << "REXEL FRANCE\nNDX10234567\n\fPage 2\nNDX20458812\n";
+
+    CHECK_EQUAL(PopplerPdfExtractor::extractFirstPage(pdfPath), std::string("REXEL FRANCE\nNDX10234567\n"));
+    CHECK_EQUAL(PopplerPdfExtractor::extractFirstPage("introuvable.pdf"), std::string());
+
+    std::remove(pdfPath.c_str());
+    std::remove(txtPath.c_str());
+}
+
+namespace
+{
+    // Texte rendu par le pdftotext simulé pour un PDF : lignes numérotées jusqu'à size octets
+    std::string fakePdfToTextOutput(const std::string& name, size_t size)
+    {
+        std::string text;
+        text.reserve(size);
+        for (int line = 0; text.size() < size; ++line)
+            text += name + " ligne " + std::to_string(line) + "\n";
+        text.resize(size);
+        return text;
+    }
+}
+
+// pdftotext simulé : le « PDF » (avant-dernier argument, le dernier est "-") contient le code de
+// sortie et la taille du texte à écrire sur la sortie standard
+HELPER_PROCESS(FakePdfToText)
+{
+    if (argc < 3)
+        return 99;
+    const std::filesystem::path pdfPath = std::filesystem::u8path(argv[argc - 2]);
+    int exitCode = 0;
+    size_t size = 0;
+    std::ifstream(pdfPath) >> exitCode >> size;
+
+    const std::string text = fakePdfToTextOutput(pdfPath.stem().u8string(), size);
+    std::fwrite(text.data(), 1, text.size(), stdout);
+    std::fflush(stdout);
+    return exitCode;
+}
+
+// Sortie de pdftotext lue par un tube : extractions simultanées complètes et distinctes, texte
+// partiel rejeté si pdftotext échoue, aucun fichier écrit à côté des PDF
+TEST(PopplerPdfExtractor_PdfToTextPipeCapture)
+{
+    namespace fs = std::filesystem;
+    const fs::path folder = "poppler_pipe_test";
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+    ExtractionCache::setMaxBytes(0);  // Chaque extraction lance pdftotext
+
+    const size_t textSize = 5 * 1024 * 1024 + 123;
+    const int extractions = 8;
+    for (int i = 0; i < extractions; ++i)
+        std::ofstream(folder / ("facture" + std::to_string(i) + ".pdf")) << "0 " << textSize;
+    std::ofstream(folder / "echec.pdf") << "3 " << 1000;
+
+    PopplerPdfExtractor::setPdfToTextPath(TestFramework::executablePath());
+    TestFramework::setEnvironment(TestFramework::HELPER_ENVIRONMENT, "FakePdfToText");
+
+    std::vector<std::string> texts(extractions);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < extractions; ++i)
+    {
+        threads.emplace_back([&texts, &folder, i]()
+        {
+            texts[i] = PopplerPdfExtractor::extractTextFromPdf((folder / ("facture" + std::to_string(i) + ".pdf")).u8string());
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    const std::string failed = PopplerPdfExtractor::extractTextFromPdf((folder / "echec.pdf").u8string());
+
+    TestFramework::setEnvironment(TestFramework::HELPER_ENVIRONMENT, std::string());
+    PopplerPdfExtractor::setPdfToTextPath(std::string());
+
+    for (int i = 0; i < extractions; ++i)
+    {
+        CHECK_EQUAL(texts[i].size(), textSize);
+        CHECK(texts[i] == fakePdfToTextOutput("facture" + std::to_string(i), textSize));
+    }
+    CHECK(failed.empty());
+
+    // Seulement les PDF : pas de .poppler_temp.txt ni d'autre fichier de sortie
+    size_t fileCount = 0;
+    for (const auto& entry : fs::directory_iterator(folder))
+    {
+        ++fileCount;
+        CHECK_EQUAL(entry.path().extension().u8string(), std::string(".pdf"));
+    }
+    CHECK_EQUAL(fileCount, size_t(extractions + 1));
+
+    ExtractionCache::setMaxBytes(ExtractionCache::DEFAULT_MAX_BYTES);
+    fs::remove_all(folder);
+}
@@ -0,0 +1,117 @@
+#include "../TestFramework.h"
+#include "../../Modules/PDFParser/PdfTextStream.h"
+#include "../../Modules/PDFParser/RexelPdfParser.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::string readFixture(const std::string& name)
+    {
+        const std::filesystem::path path = std::filesystem::path(__FILE__).parent_path() / "Fixtures" / name;
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // Lignes attendues "référence;désignation;quantité;prix;montant" (nombres en %.17g)
+    std::vector<PdfLine> readExpected(const std::string& name)
+    {
+        std::vector<PdfLine> lines;
+        std::istringstream content(readFixture(name));
+        std::string row;
+        while (std::getline(content, row))
+        {
+            std::vector<std::string> fields;
+            std::istringstream fieldStream(row);
+            std::string field;
+            while (std::getline(fieldStream, field, ';'))
+                fields.push_back(field);
+            if (fields.size() != 5)
+                continue;
+
+            PdfLine line;
+            line.reference = fields[0];
+            line.designation = fields[1];
+            line.quantite = std::strtod(fields[2].c_str(), nullptr);
+            line.prixHT = std::strtod(fields[3].c_str(), nullptr);
+            line.montantHT = std::strtod(fields[4].c_str(), nullptr);
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    void checkSameLines(const std::vector<PdfLine>& actual, const std::vector<PdfLine>& expected)
+    {
+        CHECK_EQUAL(actual.size(), expected.size());
+        for (size_t i = 0; i < std::min(actual.size(), expected.size()); ++i)
+        {
+            CHECK_EQUAL(actual[i].reference, expected[i].reference);
+            CHECK_EQUAL(actual[i].designation, expected[i].designation);
+            CHECK_EQUAL(actual[i].quantite, expected[i].quantite);
+            CHECK_EQUAL(actual[i].prixHT, expected[i].prixHT);
+            CHECK_EQUAL(actual[i].montantHT, expected[i].montantHT);
+        }
+    }
+}
+
+// Devis Rexel (texte -layout, deux pages) : mêmes articles, au bit près, que le parseur
+// d'origine (deux passes sur le texte complet et std::regex), dont la sortie est
+// rexel_devis_expected.csv. Le document couvre les cas limites de ce parseur : désignation
+// sur plusieurs lignes ou sur la page suivante, quantité sans délai ou en deux mots,
+// "1 000", prix à 1 ou 5 décimales, article sans prix, sans quantité, après "NC = ...".
+TEST(RexelPdfParser_MatchesOriginalParserOnFixture)
+{
+    const std::string text = readFixture("rexel_devis.txt");
+    CHECK(!text.empty());
+
+    RexelPdfParser parser;
+    checkSameLines(PdfTextStream::parseText(parser, text), readExpected("rexel_devis_expected.csv"));
+
+    // Parseur réutilisé : l'état du document précédent ne déborde pas sur le suivant
+    checkSameLines(PdfTextStream::parseText(parser, text), readExpected("rexel_devis_expected.csv"));
+}
+
+// Document Rexel de 50 000 lignes (blocs du devis répétés avec des références distinctes)
+BENCHMARK(RexelPdfParser_50kLines)
+{
+    const std::string fixture = readFixture("rexel_devis.txt");
+    const size_t tableStart = fixture.find('\n', fixture.find("Référence / Désignation")) + 1;
+    const size_t tableEnd = fixture.find("\f");
+    const std::string blocks = fixture.substr(tableStart, tableEnd - tableStart);
+    const size_t blockLines = static_cast<size_t>(std::count(blocks.begin(), blocks.end(), '\n'));
+
+    std::string text = fixture.substr(0, tableStart);
+    size_t lineCount = static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+    for (int copy = 0; lineCount < 50000; ++copy)
+    {
+        std::string page = blocks;
+        for (size_t at = page.find("NDX"); at != std::string::npos; at = page.find("NDX", at + 3))
+            page.replace(at + 3, 2, std::to_string(10 + copy % 90));
+        text += page;
+        lineCount += blockLines;
+    }
+    text += "     NC = nous consulter\n";
+
+    RexelPdfParser parser;
+    double best = 1e30;
+    size_t products = 0;
+    for (int run = 0; run < 5; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        products = PdfTextStream::parseText(parser, text).size();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    CHECK(products > 0);
+    std::cout << "  " << lineCount << " lignes, " << products << " articles : " << best << " ms (meilleur de 5), "
+              << lineCount / best * 1000.0 << " lignes/s\n";
+}
@@ -0,0 +1,253 @@
+#include "../TestFramework.h"
+#include "../../Modules/PDFParser/TextScanner.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::string readFixture(const std::string& name)
+    {
+        const std::filesystem::path path = std::filesystem::path(__FILE__).parent_path() / "Fixtures" / name;
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // Texte aléatoire : lettres, chiffres, tous les séparateurs de isspace, octets UTF-8 de "é"
+    std::string randomText(std::mt19937& random, size_t maxLength)
+    {
+        static const char alphabet[] = { 'a', 'B', '7', ',', ' ', ' ', '\t', '\n', '\n', '\r', '\v', '\f',
+                                         '\xC3', '\xA9' };
+        std::string text(random() % (maxLength + 1), ' ');
+        for (char& c : text)
+            c = alphabet[random() % sizeof(alphabet)];
+        return text;
+    }
+
+    std::vector<std::string> getlineSplit(const std::string& text)
+    {
+        std::vector<std::string> lines;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line))
+            lines.push_back(line);
+        return lines;
+    }
+
+    std::vector<std::string> extractionSplit(const std::string& text)
+    {
+        std::vector<std::string> tokens;
+        std::istringstream stream(text);
+        std::string token;
+        while (stream >> token)
+            tokens.push_back(token);
+        return tokens;
+    }
+
+    template <typename Range>
+    std::vector<std::string> collect(const Range& range)
+    {
+        std::vector<std::string> items;
+        for (std::string_view item : range)
+            items.emplace_back(item);
+        return items;
+    }
+
+    // Référence : les deux textes en minuscules ASCII, puis std::string::find
+    size_t lowerFind(std::string s, std::string needle)
+    {
+        std::transform(s.begin(), s.end(), s.begin(), TextScanner::toLowerAscii);
+        std::transform(needle.begin(), needle.end(), needle.begin(), TextScanner::toLowerAscii);
+        return s.find(needle);
+    }
+
+    // Helper trim des parseurs avant TextScanner
+    std::string oldTrim(const std::string& s)
+    {
+        size_t start = s.find_first_not_of(" \t\r\n");
+        if (start == std::string::npos)
+            return "";
+        size_t end = s.find_last_not_of(" \t\r\n");
+        return s.substr(start, end - start + 1);
+    }
+}
+
+// Découpage en lignes identique à std::getline : \r conservé, lignes vides, dernière ligne
+// sans fin de ligne, pas de ligne vide après une fin de ligne finale
+TEST(TextScanner_LinesMatchGetline)
+{
+    CHECK(collect(TextScanner::lines("")).empty());
+    CHECK(collect(TextScanner::lines("\n")) == std::vector<std::string>{ "" });
+    CHECK(collect(TextScanner::lines("a\r\nb")) == (std::vector<std::string>{ "a\r", "b" }));
+    CHECK(collect(TextScanner::lines("a\n\n")) == (std::vector<std::string>{ "a", "" }));
+
+    std::mt19937 random(44);
+    int mismatches = 0;
+    for (int round = 0; round < 5000; ++round)
+    {
+        const std::string text = randomText(random, 40);
+        if (collect(TextScanner::lines(text)) != getlineSplit(text))
+            ++mismatches;
+    }
+    CHECK_EQUAL(mismatches, 0);
+
+    const std::string fixture = readFixture("rexel_devis.txt");
+    CHECK(collect(TextScanner::lines(fixture)) == getlineSplit(fixture));
+    const std::string unterminated = fixture.substr(0, fixture.size() - 1);
+    CHECK(collect(TextScanner::lines(unterminated)) == getlineSplit(unterminated));
+}
+
+// Découpage en mots identique à iss >> tok : séparateurs \v \f \r compris, octets UTF-8 dans
+// les mots, texte fait uniquement de séparateurs
+TEST(TextScanner_TokensMatchStreamExtraction)
+{
+    CHECK(collect(TextScanner::tokens("")).empty());
+    CHECK(collect(TextScanner::tokens(" \t\r\n\v\f")).empty());
+    CHECK(collect(TextScanner::tokens("\vRéf.\f12,50\r")) == (std::vector<std::string>{ "Réf.", "12,50" }));
+
+    std::mt19937 random(440);
+    int mismatches = 0;
+    for (int round = 0; round < 5000; ++round)
+    {
+        const std::string text = randomText(random, 40);
+        if (collect(TextScanner::tokens(text)) != extractionSplit(text))
+            ++mismatches;
+    }
+    CHECK_EQUAL(mismatches, 0);
+
+    const std::string fixture = readFixture("rexel_devis.txt");
+    for (std::string_view line : TextScanner::lines(fixture))
+        CHECK(collect(TextScanner::tokens(line)) == extractionSplit(std::string(line)));
+}
+
+// Aiguille vide, plus longue que le texte, en fin de texte ; lettres accentuées comparées
+// octet par octet (seules les lettres ASCII changent de casse)
+TEST(TextScanner_FindIgnoreCaseEdgeCases)
+{
+    const size_t npos = std::string_view::npos;
+    CHECK_EQUAL(TextScanner::findIgnoreCase("", ""), size_t(0));
+    CHECK_EQUAL(TextScanner::findIgnoreCase("Devis", ""), size_t(0));
+    CHECK_EQUAL(TextScanner::findIgnoreCase("", "a"), npos);
+    CHECK_EQUAL(TextScanner::findIgnoreCase("PIE", "piec"), npos);
+    CHECK_EQUAL(TextScanner::findIgnoreCase("12 PIEC", "piec"), size_t(3));
+    CHECK_EQUAL(TextScanner::findIgnoreCase("Ecopart ECOPART", "ecoPART"), size_t(0));
+    CHECK_EQUAL(TextScanner::findIgnoreCase("[1] x", "[1]"), size_t(0));
+
+    CHECK_EQUAL(TextScanner::findIgnoreCase("Désignation", "DéSIGNATION"), size_t(0));
+    CHECK_EQUAL(TextScanner::findIgnoreCase("Désignation", "DÉSIGNATION"), npos);  // É ≠ é en octets
+    CHECK_EQUAL(TextScanner::findIgnoreCase("Qté livrée", "QTÉ"), npos);
+    CHECK_EQUAL(TextScanner::findIgnoreCase("Prix unitaire €", "€"), size_t(14));
+    CHECK(TextScanner::containsIgnoreCase("TOTAL HT", "total ht"));
+    CHECK(!TextScanner::containsIgnoreCase("TOTAL H", "total ht"));
+
+    std::mt19937 random(4400);
+    int mismatches = 0;
+    for (int round = 0; round < 20000; ++round)
+    {
+        const std::string s = randomText(random, 30);
+        std::string needle = randomText(random, 3);
+        if (!s.empty() && random() % 2 == 0)
+        {
+            const size_t start = random() % s.size();
+            needle = s.substr(start, random() % 4);
+            for (char& c : needle)
+                c = (random() % 2 == 0 && c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+        }
+        if (TextScanner::findIgnoreCase(s, needle) != lowerFind(s, needle))
+            ++mismatches;
+    }
+    CHECK_EQUAL(mismatches, 0);
+}
+
+// trim : texte vide ou uniquement de séparateurs → vue vide ; octets UTF-8 conservés ;
+// caractères personnalisés ; vue dans le tampon d'origine
+TEST(TextScanner_TrimEdgeCases)
+{
+    CHECK(TextScanner::trim("").empty());
+    CHECK(TextScanner::trim(" \t\r\n \n").empty());
+    CHECK(TextScanner::trimLeft("\r\n\t ").empty());
+    CHECK(TextScanner::trimRight("\r\n\t ").empty());
+    CHECK(TextScanner::trim("\v\f", " ").size() == 2);  // \v et \f hors TRIM_CHARACTERS
+
+    CHECK_EQUAL(std::string(TextScanner::trim("  é  ")), std::string("é"));
+    CHECK_EQUAL(std::string(TextScanner::trim("\xC3\xA9\t")), std::string("\xC3\xA9"));
+    CHECK_EQUAL(std::string(TextScanner::trimLeft("\t Réf ")), std::string("Réf "));
+    CHECK_EQUAL(std::string(TextScanner::trimRight("\t Réf \r")), std::string("\t Réf"));
+    CHECK_EQUAL(std::string(TextScanner::trim("--12,50--", "-")), std::string("12,50"));
+    CHECK(TextScanner::trim("abc", "").size() == 3);
+
+    const std::string text = "  désignation\r";
+    const std::string_view trimmed = TextScanner::trim(text);
+    CHECK(trimmed.data() == text.data() + 2);
+
+    std::mt19937 random(44000);
+    int mismatches = 0;
+    for (int round = 0; round < 5000; ++round)
+    {
+        const std::string s = randomText(random, 20);
+        if (std::string(TextScanner::trim(s)) != oldTrim(s))
+            ++mismatches;
+    }
+    CHECK_EQUAL(mismatches, 0);
+}
+
+// Découpage lignes + mots + trim d'un devis de 200 000 lignes : ancienne version (getline,
+// istringstream, trim par copie) puis TextScanner
+BENCHMARK(TextScanner_200kLines)
+{
+    const std::string fixture = readFixture("rexel_devis.txt");
+    const size_t fixtureLines = static_cast<size_t>(std::count(fixture.begin(), fixture.end(), '\n'));
+    std::string text;
+    size_t lineCount = 0;
+    for (; lineCount < 200000; lineCount += fixtureLines)
+        text += fixture;
+
+    auto best = [](auto&& run) {
+        double bestMs = 1e30;
+        for (int attempt = 0; attempt < 5; ++attempt)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            run();
+            bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return bestMs;
+    };
+
+    size_t before = 0;
+    const double beforeMs = best([&]() {
+        before = 0;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            const std::string trimmed = oldTrim(line);
+            std::istringstream words(trimmed);
+            std::string token;
+            while (words >> token)
+                before += token.size();
+        }
+    });
+
+    size_t after = 0;
+    const double afterMs = best([&]() {
+        after = 0;
+        for (std::string_view line : TextScanner::lines(text))
+        {
+            for (std::string_view token : TextScanner::tokens(TextScanner::trim(line)))
+                after += token.size();
+        }
+    });
+
+    CHECK_EQUAL(after, before);
+    std::cout << "  " << lineCount << " lignes : avant " << beforeMs << " ms (" << lineCount / beforeMs * 1000.0
+              << " lignes/s), TextScanner " << afterMs << " ms (" << lineCount / afterMs * 1000.0
+              << " lignes/s), meilleur de 5\n";
+}
@@ -0,0 +1,70 @@
+#include "../TestFramework.h"
+#include "../../Modules/PDFParser/XlsxWriter.h"
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+    std::vector<XlsxSheet> sheetsNamed(const std::vector<std::string>& names)
+    {
+        std::vector<XlsxSheet> sheets(names.size());
+        for (size_t i = 0; i < names.size(); ++i)
+            sheets[i].name = names[i];
+        return sheets;
+    }
+
+    std::string lower(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return text;
+    }
+}
+
+// Deux noms longs identiques sur leurs 31 premiers caractères : onglets distincts ("~2")
+TEST(XlsxWriter_TruncatedSheetNamesAreUnique)
+{
+    const std::vector<std::string> names = XlsxWriter::sheetNames(sheetsNamed({
+        "Abaque cuivre eau chaude sanitaire 60 °C",
+        "Abaque cuivre eau chaude sanitaire 55 °C",
+        "Abaque cuivre eau chaude sanitaire 50 °C",
+        "Court" }));
+
+    CHECK_EQUAL(names.size(), size_t(4));
+    CHECK_EQUAL(names[0], std::string("Abaque cuivre eau chaude sanita"));
+    CHECK_EQUAL(names[1], std::string("Abaque cuivre eau chaude sani~2"));
+    CHECK_EQUAL(names[2], std::string("Abaque cuivre eau chaude sani~3"));
+    CHECK_EQUAL(names[3], std::string("Court"));
+    for (const std::string& name : names)
+        CHECK(name.size() <= 31);
+}
+
+// Excel ignore la casse ; caractères interdits, noms vides et apostrophes en bordure corrigés
+TEST(XlsxWriter_SheetNamesFollowExcelRules)
+{
+    const std::vector<std::string> names = XlsxWriter::sheetNames(sheetsNamed({
+        "Résultats", "RÉSULTATS", "résultats", "DN [mm] : 12/14 ?", "", "'Cité'", "Feuille5" }));
+
+    CHECK_EQUAL(names[0], std::string("Résultats"));
+    CHECK_EQUAL(names[1], std::string("RÉSULTATS"));      // É ≠ é en ASCII : nom gardé
+    CHECK_EQUAL(names[2], std::string("résultats~2"));
+    CHECK_EQUAL(names[3], std::string("DN _mm_ _ 12_14 _"));
+    CHECK_EQUAL(names[4], std::string("Feuille5"));
+    CHECK_EQUAL(names[5], std::string("Cité"));
+    CHECK_EQUAL(names[6], std::string("Feuille5~2"));
+
+    std::vector<std::string> folded;
+    for (const std::string& name : names)
+        folded.push_back(lower(name));
+    std::sort(folded.begin(), folded.end());
+    CHECK(std::adjacent_find(folded.begin(), folded.end()) == folded.end());
+}
+
+// 31 caractères comptés en caractères, pas en octets : un accent n'est jamais coupé en deux
+TEST(XlsxWriter_SheetNameTruncationKeepsUtf8Valid)
+{
+    const std::string accented = "ééééééééééééééééééééééééééééééééééé";  // 35 × 'é' (2 octets chacun)
+    const std::vector<std::string> names = XlsxWriter::sheetNames(sheetsNamed({ accented, accented }));
+
+    CHECK_EQUAL(names[0].size(), size_t(62));       // 31 caractères
+    CHECK_EQUAL(names[1], accented.substr(0, 58) + "~2");
+}
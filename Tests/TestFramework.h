@@ -0,0 +1,114 @@
+#pragma once
+#include <cmath>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Mini framework des tests de TCHubTests (sans dépendance externe)
+//
+//   TEST(Nom) { CHECK(condition); CHECK_NEAR(valeur, attendu, tolérance); }
+//   BENCHMARK(Nom) { ... }   // exécuté seulement avec --bench
+//   HELPER_PROCESS(Nom) { ... return code; }   // programme externe simulé (voir plus bas)
+//
+// Un CHECK en échec note l'erreur (fichier, ligne, valeurs) et le test continue.
+//
+// Programme externe simulé : un test passe executablePath() à la place de l'outil et pose la
+// variable d'environnement HELPER_ENVIRONMENT=Nom ; TCHubTests, lancé avec cette variable,
+// exécute HELPER_PROCESS(Nom) avec ses arguments et rend son code de sortie.
+namespace TestFramework
+{
+    struct TestCase
+    {
+        std::string name;
+        std::function<void()> body;
+        bool isBenchmark;
+    };
+
+    struct HelperProcess
+    {
+        std::string name;
+        std::function<int(int argc, char* argv[])> body;
+    };
+
+    constexpr const char* HELPER_ENVIRONMENT = "TCHUB_TEST_HELPER";
+
+    std::vector<TestCase>& registry();
+    std::vector<HelperProcess>& helperRegistry();
+    void reportFailure(const char* file, int line, const std::string& message);
+
+    // Chemin absolu de TCHubTests (UTF-8)
+    std::string executablePath();
+
+    // Pose une variable d'environnement du processus, héritée par les processus lancés ensuite
+    // (valeur vide : variable supprimée)
+    void setEnvironment(const std::string& name, const std::string& value);
+
+    struct Registrar
+    {
+        Registrar(const char* name, std::function<void()> body, bool isBenchmark)
+        {
+            registry().push_back({ name, std::move(body), isBenchmark });
+        }
+    };
+
+    struct HelperRegistrar
+    {
+        HelperRegistrar(const char* name, std::function<int(int, char*[])> body)
+        {
+            helperRegistry().push_back({ name, std::move(body) });
+        }
+    };
+
+    template <typename A, typename B>
+    std::string describe(const char* expression, const A& actual, const B& expected)
+    {
+        std::ostringstream message;
+        message.precision(17);
+        message << expression << " : obtenu " << actual << ", attendu " << expected;
+        return message.str();
+    }
+}
+
+#define TEST_CONCAT_INNER(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_INNER(a, b)
+
+#define TEST_REGISTER(name, isBenchmark)                                                        \
+    static void TEST_CONCAT(testBody_, name)();                                                 \
+    static TestFramework::Registrar TEST_CONCAT(testRegistrar_, name)(#name, TEST_CONCAT(testBody_, name), isBenchmark); \
+    static void TEST_CONCAT(testBody_, name)()
+
+#define TEST(name) TEST_REGISTER(name, false)
+#define BENCHMARK(name) TEST_REGISTER(name, true)
+
+#define HELPER_PROCESS(name)                                                                    \
+    static int TEST_CONCAT(helperBody_, name)(int argc, char* argv[]);                          \
+    static TestFramework::HelperRegistrar TEST_CONCAT(helperRegistrar_, name)(#name, TEST_CONCAT(helperBody_, name)); \
+    static int TEST_CONCAT(helperBody_, name)(int argc, char* argv[])
+
+#define CHECK(condition)                                                                        \
+    do                                                                                          \
+    {                                                                                           \
+        if (!(condition))                                                                       \
+            TestFramework::reportFailure(__FILE__, __LINE__, #condition);                       \
+    } while (0)
+
+#define CHECK_EQUAL(actual, expected)                                                           \
+    do                                                                                          \
+    {                                                                                           \
+        const auto& checkActual_ = (actual);                                                    \
+        const auto& checkExpected_ = (expected);                                                \
+        if (!(checkActual_ == checkExpected_))                                                  \
+            TestFramework::reportFailure(__FILE__, __LINE__,                                    \
+                TestFramework::describe(#actual, checkActual_, checkExpected_));                \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                                                 \
+    do                                                                                          \
+    {                                                                                           \
+        const double checkActual_ = (actual);                                                   \
+        const double checkExpected_ = (expected);                                               \
+        if (!(std::fabs(checkActual_ - checkExpected_) <= (tolerance)))                         \
+            TestFramework::reportFailure(__FILE__, __LINE__,                                    \
+                TestFramework::describe(#actual, checkActual_, checkExpected_));                \
+    } while (0)
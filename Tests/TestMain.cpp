@@ -0,0 +1,133 @@
+#include "TestFramework.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+// Exécutable de tests : TCHubTests [--bench] [filtre]
+//   sans argument : tous les tests, code de retour 1 si l'un d'eux échoue
+//   --bench       : les mesures de performance (BENCHMARK) au lieu des tests
+//   filtre        : seuls les tests dont le nom contient ce texte
+// Avec la variable TCHUB_TEST_HELPER=Nom : programme externe simulé HELPER_PROCESS(Nom)
+
+namespace TestFramework
+{
+    static int failureCount = 0;
+
+    std::vector<TestCase>& registry()
+    {
+        static std::vector<TestCase> cases;
+        return cases;
+    }
+
+    std::vector<HelperProcess>& helperRegistry()
+    {
+        static std::vector<HelperProcess> helpers;
+        return helpers;
+    }
+
+    void reportFailure(const char* file, int line, const std::string& message)
+    {
+        ++failureCount;
+        std::cerr << "  ECHEC " << file << ":" << line << " : " << message << "\n";
+    }
+
+    std::string executablePath()
+    {
+#ifdef _WIN32
+        std::vector<wchar_t> buffer(MAX_PATH);
+        while (true)
+        {
+            DWORD length = GetModuleFileNameW(NULL, buffer.data(), static_cast<DWORD>(buffer.size()));
+            if (length == 0)
+                return std::string();
+            if (length < buffer.size())
+                return std::filesystem::path(std::wstring(buffer.data(), length)).u8string();
+            buffer.resize(buffer.size() * 2);
+        }
+#else
+        std::error_code error;
+        const std::filesystem::path self = std::filesystem::read_symlink("/proc/self/exe", error);
+        return error ? std::string() : self.u8string();
+#endif
+    }
+
+    void setEnvironment(const std::string& name, const std::string& value)
+    {
+#ifdef _WIN32
+        _putenv_s(name.c_str(), value.c_str());
+#else
+        if (value.empty())
+            unsetenv(name.c_str());
+        else
+            setenv(name.c_str(), value.c_str(), 1);
+#endif
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (const char* helperName = std::getenv(TestFramework::HELPER_ENVIRONMENT))
+    {
+        for (const TestFramework::HelperProcess& helper : TestFramework::helperRegistry())
+        {
+            if (helper.name == helperName)
+                return helper.body(argc, argv);
+        }
+        std::cerr << "Programme simulé inconnu : " << helperName << "\n";
+        return 2;
+    }
+
+    bool benchmarks = false;
+    std::string filter;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--bench") == 0)
+            benchmarks = true;
+        else
+            filter = argv[i];
+    }
+
+    int run = 0;
+    int failedTests = 0;
+    for (const TestFramework::TestCase& test : TestFramework::registry())
+    {
+        if (test.isBenchmark != benchmarks || test.name.find(filter) == std::string::npos)
+            continue;
+
+        ++run;
+        const int failuresBefore = TestFramework::failureCount;
+        const auto start = std::chrono::steady_clock::now();
+        std::cout << "[ " << test.name << " ]\n";
+        try
+        {
+            test.body();
+        }
+        catch (const std::exception& e)
+        {
+            TestFramework::reportFailure(__FILE__, __LINE__, std::string("exception : ") + e.what());
+        }
+        catch (...)
+        {
+            TestFramework::reportFailure(__FILE__, __LINE__, "exception inconnue");
+        }
+
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        const bool passed = TestFramework::failureCount == failuresBefore;
+        if (!passed)
+            ++failedTests;
+        std::cout << (passed ? "  OK" : "  ECHOUE") << " (" << ms << " ms)\n";
+    }
+
+    std::cout << "\n" << run - failedTests << "/" << run << (benchmarks ? " mesures" : " tests") << " réussis\n";
+    return failedTests == 0 ? 0 : 1;
+}
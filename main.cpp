@@ -1,10 +1,71 @@
 #include "MainWindow.h"
 #include "UpdateChecker.h"
 #include "UpdateDialog.h"
+#include "Modules/HydraulicCalculations/SizingChartCommand.h"
+#include "Modules/PDFParser/PdfBatchCommand.h"
 #include <QApplication>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <windows.h>
+#include <shellapi.h>
+
+// Arguments de la ligne de commande en UTF-8 (argv est dans la page de code ANSI : un chemin
+// avec des caractères hors de cette page y serait perdu). Le premier est le programme.
+static std::vector<std::string> utf8Arguments()
+{
+    std::vector<std::string> arguments;
+    int count = 0;
+    LPWSTR* wideArguments = CommandLineToArgvW(GetCommandLineW(), &count);
+    if (wideArguments == nullptr)
+        return arguments;
+
+    for (int i = 0; i < count; ++i)
+    {
+        const int size = WideCharToMultiByte(CP_UTF8, 0, wideArguments[i], -1, nullptr, 0, nullptr, nullptr);
+        std::string argument(size > 0 ? size - 1 : 0, '\0');
+        if (size > 1)
+            WideCharToMultiByte(CP_UTF8, 0, wideArguments[i], -1, &argument[0], size, nullptr, nullptr);
+        arguments.push_back(argument);
+    }
+    LocalFree(wideArguments);
+    return arguments;
+}
+
+// Application fenêtrée (SubSystem Windows) : sans console attachée, std::cout et std::cerr ne
+// mènent nulle part. Les modes ligne de commande écrivent dans la console qui les a lancés.
+static void attachParentConsole()
+{
+    if (!AttachConsole(ATTACH_PARENT_PROCESS))
+        return;
+
+    FILE* stream = nullptr;
+    freopen_s(&stream, "CONOUT$", "w", stdout);
+    freopen_s(&stream, "CONOUT$", "w", stderr);
+    std::cout.clear();
+    std::cerr.clear();
+    SetConsoleOutputCP(CP_UTF8);  // Messages en UTF-8 (accents, chemins)
+}
 
 int main(int argc, char *argv[])
 {
+    // Modes ligne de commande, sans interface graphique :
+    //   --abaque  : génération d'abaques
+    //   --pdf-lot : conversion d'un lot de PDF fournisseurs
+    if (argc > 1 && (std::string(argv[1]) == "--abaque" || std::string(argv[1]) == "--pdf-lot"))
+    {
+        attachParentConsole();
+        const std::vector<std::string> arguments = utf8Arguments();
+        if (arguments.size() < 2)
+            return 1;
+
+        const std::vector<std::string> commandArguments(arguments.begin() + 1, arguments.end());
+        if (commandArguments[0] == "--abaque")
+            return HydraulicCalc::runSizingChartCommand(commandArguments);
+        return runPdfBatchCommand(commandArguments);
+    }
+
     QApplication app(argc, argv);
 
     // Configuration de l'application